@@ -0,0 +1,176 @@
+/*
+ * BenchUtil.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "BenchUtil.h"
+
+using namespace opencog::bench;
+
+static std::atomic<size_t> num_allocs(0);
+
+void* operator new(std::size_t size)
+{
+    num_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+size_t opencog::bench::allocations()
+{
+    return num_allocs.load(std::memory_order_relaxed);
+}
+
+double opencog::bench::percentile(std::vector<double>& v, double p)
+{
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    size_t i = std::min(v.size() - 1, size_t(p * v.size()));
+    return v[i];
+}
+
+size_t opencog::bench::proc_status_kb(const char* field)
+{
+    FILE* f = fopen("/proc/self/status", "r");
+    if (not f) return 0;
+
+    char line[256];
+    size_t kb = 0;
+    size_t len = strlen(field);
+    while (fgets(line, sizeof(line), f))
+        if (0 == strncmp(line, field, len))
+        {
+            kb = strtoul(line + len, nullptr, 10);
+            break;
+        }
+    fclose(f);
+    return kb;
+}
+
+Report::Report(const std::string& suite, const std::string& items) :
+    _suite(suite), _items(items)
+{
+}
+
+void Report::param(const std::string& key, double value)
+{
+    _params.push_back({key, value});
+}
+
+const Result& Report::run(const std::string& name, size_t calls,
+                          const std::function<size_t(size_t)>& f,
+                          bool warm_up)
+{
+    calls = std::max(calls, (size_t) 1);
+    if (warm_up) f(0);
+
+    std::vector<double> latencies;
+    latencies.reserve(calls);
+
+    size_t items = 0;
+    size_t allocs = allocations();
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < calls; i++)
+    {
+        Clock::time_point t = Clock::now();
+        items += f(i);
+        std::chrono::duration<double, std::micro> d = Clock::now() - t;
+        latencies.push_back(d.count());
+    }
+    std::chrono::duration<double, std::nano> total = Clock::now() - start;
+    // The latencies were reserved, so keeping them allocated nothing.
+    allocs = allocations() - allocs;
+
+    add(Result{name, calls, total.count() / calls, (double) allocs / calls,
+               (double) items / calls, percentile(latencies, 0.5),
+               percentile(latencies, 0.99)});
+    return _results.back();
+}
+
+void Report::add(const Result& r)
+{
+    _results.push_back(r);
+}
+
+// Names are made by the benchmarks themselves; only quotes and
+// backslashes need escaping.
+static std::string quoted(const std::string& s)
+{
+    std::string q("\"");
+    for (char c : s)
+    {
+        if ('"' == c or '\\' == c) q += '\\';
+        q += c;
+    }
+    return q + "\"";
+}
+
+void Report::print(bool json) const
+{
+    if (json)
+    {
+        printf("{\"suite\": %s, \"items\": %s, \"params\": {",
+               quoted(_suite).c_str(), quoted(_items).c_str());
+        for (size_t i = 0; i < _params.size(); i++)
+            printf("%s%s: %g", i ? ", " : "",
+                   quoted(_params[i].first).c_str(), _params[i].second);
+        printf("}, \"results\": [");
+        for (size_t i = 0; i < _results.size(); i++)
+        {
+            const Result& r = _results[i];
+            printf("%s{\"name\": %s, \"calls\": %zu, \"ns_per_call\": %.0f, "
+                   "\"allocs_per_call\": %.1f, \"items_per_call\": %.1f, "
+                   "\"p50_us\": %.1f, \"p99_us\": %.1f}",
+                   i ? ", " : "", quoted(r.name).c_str(), r.calls,
+                   r.ns_per_call, r.allocs_per_call, r.items_per_call,
+                   r.p50_us, r.p99_us);
+        }
+        printf("]}\n");
+        return;
+    }
+
+    printf("%s:", _suite.c_str());
+    for (size_t i = 0; i < _params.size(); i++)
+        printf("%s %s %g", i ? "," : "", _params[i].first.c_str(),
+               _params[i].second);
+    printf("\n%-32s %8s %14s %12s %12s %10s %10s\n", "name", "calls",
+           "ns/call", "allocs/call", (_items + "/call").c_str(),
+           "p50 (us)", "p99 (us)");
+    for (const Result& r : _results)
+        printf("%-32s %8zu %14.0f %12.1f %12.1f %10.1f %10.1f\n",
+               r.name.c_str(), r.calls, r.ns_per_call, r.allocs_per_call,
+               r.items_per_call, r.p50_us, r.p99_us);
+}
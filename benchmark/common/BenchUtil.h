@@ -0,0 +1,106 @@
+/*
+ * BenchUtil.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_BENCH_UTIL_H
+#define _OPENCOG_BENCH_UTIL_H
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace opencog
+{
+namespace bench
+{
+
+/**
+ * What the benchmarks have in common: counting allocations, timing
+ * a call repeatedly, and printing the results as a table, or as JSON
+ * that run_benchmarks.py can merge and compare against a baseline.
+ *
+ * Linking with bench-util replaces the global operator new, so that
+ * every allocation of the program is counted; only the difference
+ * over the calls being timed is reported.
+ */
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double> Seconds;
+
+/// The no. of allocations made so far by the whole program.
+size_t allocations();
+
+/// The p-th fraction, e.g. 0.99, of the values; sorts them.
+double percentile(std::vector<double>&, double p);
+
+/// A line of /proc/self/status, e.g. "VmHWM:", in kB; 0 if unknown.
+size_t proc_status_kb(const char* field);
+
+struct Result
+{
+    std::string name;
+    size_t calls;
+    double ns_per_call;
+    double allocs_per_call;
+    double items_per_call;   // atoms found, made, etc.; the suite says
+    double p50_us;
+    double p99_us;
+};
+
+class Report
+{
+public:
+    /// @param suite  the name of the suite, e.g. "openpsi"
+    /// @param items  what items_per_call counts, for the table heading
+    Report(const std::string& suite, const std::string& items);
+
+    /// Describe how the fixture was made, e.g. ("rules", 1000).
+    void param(const std::string& key, double value);
+
+    /**
+     * Call f(i), for i from 0 to calls - 1, each timed on its own,
+     * after calling f(0) once untimed, to warm up caches, unless the
+     * first calls are the ones to time. f returns the no. of items it
+     * found or made, which also keeps the calls from being optimized
+     * away.
+     */
+    const Result& run(const std::string& name, size_t calls,
+                      const std::function<size_t(size_t)>& f,
+                      bool warm_up = true);
+
+    void add(const Result&);
+
+    const std::vector<Result>& results() const { return _results; }
+
+    /// As a table, or as a line of JSON.
+    void print(bool json) const;
+
+private:
+    std::string _suite;
+    std::string _items;
+    std::vector<std::pair<std::string, double>> _params;
+    std::vector<Result> _results;
+};
+
+}} // namespace opencog::bench
+
+#endif // _OPENCOG_BENCH_UTIL_H
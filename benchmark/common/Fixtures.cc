@@ -0,0 +1,165 @@
+/*
+ * Fixtures.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <random>
+
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/guile/SchemeEval.h>
+#include <opencog/nlp/types/atom_types.h>
+
+#include "Fixtures.h"
+
+using namespace opencog;
+using namespace opencog::bench;
+
+static const char* nouns[] = {
+    "cat", "dog", "man", "woman", "child", "ball", "book", "car",
+    "house", "tree", "bird", "fish", "table", "door", "city", "river",
+    "letter", "song", "apple", "horse",
+};
+
+// The form written, and the lemma
+static const char* verbs[][2] = {
+    {"sees", "see"}, {"likes", "like"}, {"finds", "find"},
+    {"eats", "eat"}, {"throws", "throw"}, {"reads", "read"},
+    {"wants", "want"}, {"takes", "take"}, {"makes", "make"},
+    {"hears", "hear"},
+};
+
+#define COUNT(a) (sizeof(a) / sizeof(a[0]))
+
+// The k-th of n is drawn with a chance proportional to 1/(k+1)
+static std::discrete_distribution<size_t> zipf(size_t n)
+{
+    std::vector<double> w;
+    for (size_t k = 0; k < n; k++) w.push_back(1.0 / (k + 1));
+    return std::discrete_distribution<size_t>(w.begin(), w.end());
+}
+
+std::vector<Sentence> opencog::bench::make_sentences(size_t n, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::discrete_distribution<size_t> noun = zipf(COUNT(nouns));
+    std::discrete_distribution<size_t> verb = zipf(COUNT(verbs));
+
+    std::vector<Sentence> sentences;
+    for (size_t i = 0; i < n; i++)
+    {
+        const char* subj = nouns[noun(rng)];
+        const char* const* v = verbs[verb(rng)];
+        const char* obj = nouns[noun(rng)];
+
+        Sentence s;
+        s.words = {"the", subj, v[0], "the", obj, "."};
+        s.lemmas = {"the", subj, v[1], "the", obj, "."};
+        s.pos = {"det", "noun", "verb", "det", "noun", "punctuation"};
+        s.text = std::string("the ") + subj + " " + v[0] + " the " + obj + " .";
+        sentences.push_back(s);
+    }
+    return sentences;
+}
+
+static bool has_senses(const std::string& pos)
+{
+    return "noun" == pos or "verb" == pos;
+}
+
+Handle opencog::bench::add_relex_document(AtomSpace& as,
+                                          const std::string& name,
+                                          const std::vector<Sentence>& sentences,
+                                          size_t senses)
+{
+    Handle doc = as.add_node(DOCUMENT_NODE, std::string(name));
+    Handle subj = as.add_node(DEFINED_LINGUISTIC_RELATIONSHIP_NODE, "_subj");
+    Handle obj = as.add_node(DEFINED_LINGUISTIC_RELATIONSHIP_NODE, "_obj");
+
+    HandleSeq sentence_nodes;
+    for (size_t i = 0; i < sentences.size(); i++)
+    {
+        const Sentence& s = sentences[i];
+        std::string id = name + "-" + std::to_string(i);
+
+        Handle sent = as.add_node(SENTENCE_NODE, "sentence@" + id);
+        Handle parse = as.add_node(PARSE_NODE, "sentence@" + id + "_parse_0");
+        parse->setTruthValue(SimpleTruthValue::createTV(1.0, 0.9));
+        as.add_link(PARSE_LINK, parse, sent);
+        sentence_nodes.push_back(sent);
+
+        HandleSeq insts;
+        for (size_t j = 0; j < s.words.size(); j++)
+        {
+            Handle inst = as.add_node(WORD_INSTANCE_NODE,
+                s.words[j] + "@" + id + "-" + std::to_string(j));
+            Handle lemma = as.add_node(WORD_NODE, std::string(s.lemmas[j]));
+            Handle pos = as.add_node(DEFINED_LINGUISTIC_CONCEPT_NODE,
+                                     std::string(s.pos[j]));
+            as.add_link(REFERENCE_LINK, inst,
+                        as.add_node(WORD_NODE, std::string(s.words[j])));
+            as.add_link(LEMMA_LINK, inst, lemma);
+            as.add_link(PART_OF_SPEECH_LINK, inst, pos);
+            insts.push_back(inst);
+
+            if (not has_senses(s.pos[j])) continue;
+            for (size_t k = 0; k < senses; k++)
+            {
+                Handle sense = as.add_node(WORD_SENSE_NODE,
+                    s.lemmas[j] + "%" + std::to_string(k));
+                as.add_link(WORD_SENSE_LINK, lemma, sense);
+                as.add_link(PART_OF_SPEECH_LINK, sense, pos);
+            }
+        }
+        as.add_link(REFERENCE_LINK, parse, as.add_link(LIST_LINK, insts));
+
+        // the NOUN VERBs the NOUN .
+        as.add_link(EVALUATION_LINK, subj,
+                    as.add_link(LIST_LINK, insts[2], insts[1]));
+        as.add_link(EVALUATION_LINK, obj,
+                    as.add_link(LIST_LINK, insts[2], insts[4]));
+    }
+    as.add_link(REFERENCE_LINK, doc, as.add_link(LIST_LINK, sentence_nodes));
+    return doc;
+}
+
+std::vector<std::string>
+opencog::bench::sense_names(const std::vector<Sentence>& sentences,
+                            size_t senses)
+{
+    std::vector<std::string> names;
+    for (const Sentence& s : sentences)
+        for (size_t j = 0; j < s.lemmas.size(); j++)
+        {
+            if (not has_senses(s.pos[j])) continue;
+            for (size_t k = 0; k < senses; k++)
+                names.push_back(s.lemmas[j] + "%" + std::to_string(k));
+        }
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    return names;
+}
+
+bool opencog::bench::load_scm(AtomSpace& as, const std::string& path)
+{
+    SchemeEval ev(&as);
+    ev.eval("(use-modules (opencog) (opencog nlp))");
+    ev.eval("(load \"" + path + "\")");
+    return not ev.eval_error();
+}
@@ -0,0 +1,86 @@
+/*
+ * Fixtures.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_BENCH_FIXTURES_H
+#define _OPENCOG_BENCH_FIXTURES_H
+
+#include <string>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+namespace bench
+{
+
+/**
+ * Synthetic corpora shared by the benchmarks, so that the suites see
+ * the same sentences, whether as text, for the parser, or as RelEx
+ * atoms, for the subsystems working on parses.
+ *
+ * The sentences are "the NOUN VERBs the NOUN .", with the words drawn
+ * from a Zipf distribution over a small list of common English words,
+ * so that Link Grammar parses them, and so that some are much more
+ * frequent than others, as in real text. The same seed gives the same
+ * sentences.
+ */
+struct Sentence
+{
+    std::string text;
+    std::vector<std::string> words;     // as written
+    std::vector<std::string> lemmas;
+    std::vector<std::string> pos;       // "det", "noun", "verb", ...
+};
+
+std::vector<Sentence> make_sentences(size_t n, unsigned seed);
+
+/**
+ * Add the sentences as a document parsed by RelEx, with one parse each:
+ *
+ *    (ReferenceLink (DocumentNode name) (ListLink (SentenceNode ...) ...))
+ *    (ParseLink (ParseNode ...) (SentenceNode ...))
+ *    (ReferenceLink (ParseNode ...) (ListLink (WordInstanceNode ...) ...))
+ *    (ReferenceLink (WordInstanceNode ...) (WordNode word))
+ *    (LemmaLink (WordInstanceNode ...) (WordNode lemma))
+ *    (PartOfSpeechLink (WordInstanceNode ...) (DefinedLinguisticConceptNode pos))
+ *    (EvaluationLink (DefinedLinguisticRelationshipNode "_subj") (ListLink verb noun))
+ *    (EvaluationLink (DefinedLinguisticRelationshipNode "_obj") (ListLink verb noun))
+ *
+ * With senses > 0, each lemma of a noun or a verb gets that many
+ * WordSenseNodes, named "lemma%k", with their part of speech, as the
+ * WordNet import gives them.
+ *
+ * @return the DocumentNode
+ */
+Handle add_relex_document(AtomSpace&, const std::string& name,
+                          const std::vector<Sentence>&, size_t senses);
+
+/// The names of the WordSenseNodes add_relex_document() makes.
+std::vector<std::string> sense_names(const std::vector<Sentence>&,
+                                     size_t senses);
+
+/// Load a scheme file of atoms, e.g. a test fixture; false on error.
+bool load_scm(AtomSpace&, const std::string& path);
+
+}} // namespace opencog::bench
+
+#endif // _OPENCOG_BENCH_FIXTURES_H
@@ -0,0 +1,389 @@
+/*
+ * FuzzyBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/guile/SchemeEval.h>
+#include <opencog/nlp/fuzzy/DocFrequency.h>
+#include <opencog/nlp/fuzzy/Fuzzy.h>
+#include <opencog/nlp/fuzzy/FuzzyMatchBasic.h>
+#include <opencog/nlp/fuzzy/MinHashIndex.h>
+#include <opencog/nlp/types/atom_types.h>
+
+#include "BenchUtil.h"
+
+using namespace opencog;
+using namespace opencog::nlp;
+
+/**
+ * Time the fuzzy matchers on a corpus of R2L-like sentences.
+ *
+ * Usage: fuzzy-bench [--sentences N] [--vocabulary V] [--load FILE]
+ *                    [--queries Q] [--af-fraction F] [--index]
+ *                    [--seed S] [--json]
+ *
+ * The corpus is either generated, with N sentences of the form "subject
+ * verb object" drawn from a Zipf distribution over V words, or loaded
+ * from a scheme file of parsed sentences, e.g. the output of nlp-parse.
+ * Q of its SetLinks are used as the queries.  For the af_only runs, the
+ * fraction F of the SetLinks is put in the attentional focus.  --index
+ * adds a run with a MinHashIndex of the SetLinks.
+ */
+
+typedef std::chrono::steady_clock Clock;
+
+// Count the trees proposed to try_match(), i.e. the candidates visited.
+template<typename Matcher>
+class Counting : public Matcher
+{
+public:
+    template<typename... Args>
+    Counting(Args&&... args) : Matcher(std::forward<Args>(args)...) {}
+
+    size_t visited = 0;
+
+protected:
+    virtual bool try_match(const Handle& h)
+    {
+        visited++;
+        return Matcher::try_match(h);
+    }
+};
+
+// A line of /proc/self/status, in kB
+static size_t proc_status_kb(const char* field)
+{
+    std::ifstream in("/proc/self/status");
+    std::string line;
+    size_t len = strlen(field);
+    while (std::getline(in, line))
+        if (line.compare(0, len, field) == 0)
+            return atol(line.c_str() + len + 1);
+    return 0;
+}
+
+static size_t growth(size_t from, size_t to)
+{
+    return (to > from) ? to - from : 0;
+}
+
+// Add a sentence, its parse and R2L-like output, in the form the fuzzy
+// matcher looks for.
+static Handle add_sentence(AtomSpace& as, size_t id,
+                           const std::vector<std::string>& words)
+{
+    std::string sid = std::to_string(id);
+    Handle sent = as.add_node(SENTENCE_NODE, "sentence@" + sid);
+    Handle parse = as.add_node(PARSE_NODE, "sentence@" + sid + "_parse_0");
+    as.add_link(PARSE_LINK, parse, sent);
+
+    HandleSeq insts;
+    HandleSeq clauses;
+    for (size_t i = 0; i < words.size(); i++)
+    {
+        const std::string& w = words[i];
+        std::string inst = w + "@" + sid + "-" + std::to_string(i);
+
+        Handle wi = as.add_node(WORD_INSTANCE_NODE, inst);
+        as.add_link(WORD_INSTANCE_LINK, wi, parse);
+        as.add_link(LEMMA_LINK, wi, as.add_node(WORD_NODE, w));
+
+        // The second word is the verb
+        Type t = (i == 1) ? PREDICATE_NODE : CONCEPT_NODE;
+        Handle c = as.add_node(t, inst);
+        as.add_link(REFERENCE_LINK, c, wi);
+        clauses.push_back(as.add_link((i == 1) ? IMPLICATION_LINK :
+                                      INHERITANCE_LINK, c, as.add_node(t, w)));
+        insts.push_back(c);
+    }
+
+    HandleSeq args(insts.begin(), insts.end());
+    args.erase(args.begin() + 1);
+    clauses.push_back(as.add_link(EVALUATION_LINK, insts[1],
+                                  as.add_link(LIST_LINK, std::move(args))));
+
+    return as.add_link(SET_LINK, std::move(clauses));
+}
+
+static void generate(AtomSpace& as, size_t n_sents, size_t vocab,
+                     std::mt19937& rng)
+{
+    std::vector<double> zipf;
+    for (size_t i = 1; i <= vocab; i++)
+        zipf.push_back(1.0 / i);
+    std::discrete_distribution<size_t> pick(zipf.begin(), zipf.end());
+
+    for (size_t s = 0; s < n_sents; s++)
+    {
+        std::vector<std::string> words;
+        for (int i = 0; i < 3; i++)
+            words.push_back("w" + std::to_string(pick(rng)));
+        add_sentence(as, s, words);
+    }
+}
+
+struct Result
+{
+    std::string mode;
+    size_t calls;
+    double mean_visited;
+    double allocs_per_call;
+    double p50_us;
+    double p99_us;
+    double max_us;
+};
+
+static double percentile(std::vector<double>& v, double p)
+{
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    size_t i = std::min(v.size() - 1, size_t(p * v.size()));
+    return v[i];
+}
+
+static Result summarize(const std::string& mode, std::vector<double>& lat,
+                        size_t visited, size_t allocs)
+{
+    Result r;
+    r.mode = mode;
+    r.calls = lat.size();
+    r.mean_visited = lat.empty() ? 0 : (double) visited / lat.size();
+    r.allocs_per_call = lat.empty() ? 0 : (double) allocs / lat.size();
+    r.p50_us = percentile(lat, 0.5);
+    r.p99_us = percentile(lat, 0.99);
+    r.max_us = lat.empty() ? 0 : lat.back();
+    return r;
+}
+
+static double elapsed_us(Clock::time_point start)
+{
+    std::chrono::duration<double, std::micro> d = Clock::now() - start;
+    return d.count();
+}
+
+// nlp-fuzzy-match, or cog-fuzzy-match if basic is set
+static Result run_match(AtomSpace& as, const std::string& mode,
+                        const HandleSeq& queries, bool basic, bool af_only)
+{
+    std::vector<double> lat;
+    lat.reserve(queries.size());
+    size_t visited = 0;
+    size_t allocs = bench::allocations();
+
+    for (const Handle& q : queries)
+    {
+        Clock::time_point start = Clock::now();
+        if (basic)
+        {
+            Counting<FuzzyMatchBasic> fpm;
+            fpm.perform_search(q);
+            visited += fpm.visited;
+        }
+        else
+        {
+            Counting<Fuzzy> fpm(&as, SET_LINK, HandleSeq(), af_only);
+            fpm.perform_search(q);
+            visited += fpm.visited;
+        }
+        lat.push_back(elapsed_us(start));
+    }
+
+    return summarize(mode, lat, visited, bench::allocations() - allocs);
+}
+
+// nlp-fuzzy-compare of each query with the next one
+static Result run_compare(AtomSpace& as, const HandleSeq& queries)
+{
+    std::vector<double> lat;
+    lat.reserve(queries.size());
+    size_t allocs = bench::allocations();
+
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+        Clock::time_point start = Clock::now();
+        Fuzzy fpm(&as);
+        fpm.fuzzy_compare(queries[i], queries[(i + 1) % queries.size()]);
+        lat.push_back(elapsed_us(start));
+    }
+
+    return summarize("compare", lat, 0, bench::allocations() - allocs);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n_sents = 10000;
+    size_t vocab = 2000;
+    size_t n_queries = 100;
+    double af_fraction = 0.01;
+    unsigned seed = 42;
+    bool use_index = false;
+    bool json = false;
+    std::string load;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--sentences") and i + 1 < argc)
+            n_sents = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--vocabulary") and i + 1 < argc)
+            vocab = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--load") and i + 1 < argc)
+            load = argv[++i];
+        else if (0 == strcmp(argv[i], "--queries") and i + 1 < argc)
+            n_queries = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--af-fraction") and i + 1 < argc)
+            af_fraction = atof(argv[++i]);
+        else if (0 == strcmp(argv[i], "--seed") and i + 1 < argc)
+            seed = atoi(argv[++i]);
+        else if (0 == strcmp(argv[i], "--index"))
+            use_index = true;
+        else if (0 == strcmp(argv[i], "--json"))
+            json = true;
+        else
+        {
+            fprintf(stderr, "Usage: %s [--sentences N] [--vocabulary V] "
+                    "[--load FILE] [--queries Q] [--af-fraction F] "
+                    "[--index] [--seed S] [--json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::mt19937 rng(seed);
+    size_t rss_before = proc_status_kb("VmRSS:");
+
+    AtomSpace as;
+    if (load.empty())
+        generate(as, n_sents, vocab, rng);
+    else
+    {
+        SchemeEval ev(&as);
+        ev.eval("(use-modules (opencog) (opencog nlp))");
+        ev.eval("(load \"" + load + "\")");
+        if (ev.eval_error())
+        {
+            fprintf(stderr, "Failed to load %s\n", load.c_str());
+            return 1;
+        }
+    }
+
+    size_t rss_corpus = proc_status_kb("VmRSS:");
+
+    HandleSeq roots;
+    as.get_handles_by_type(std::back_inserter(roots), SET_LINK);
+    if (roots.empty())
+    {
+        fprintf(stderr, "No SetLinks to match\n");
+        return 1;
+    }
+
+    HandleSeq queries;
+    std::uniform_int_distribution<size_t> any(0, roots.size() - 1);
+    for (size_t i = 0; i < n_queries; i++)
+        queries.push_back(roots[any(rng)]);
+
+    // Put some of the SetLinks, and everything in them, in the AF
+    AttentionBank& bank = attentionbank(&as);
+    std::bernoulli_distribution in_af(af_fraction);
+    for (const Handle& r : roots)
+    {
+        if (not in_af(rng)) continue;
+
+        HandleSeq todo({r});
+        while (not todo.empty())
+        {
+            Handle h = todo.back();
+            todo.pop_back();
+            bank.set_sti(h, 1000);
+            if (h->is_link())
+                for (const Handle& o : h->getOutgoingSet())
+                    todo.push_back(o);
+        }
+    }
+
+    HandleSeq af;
+    bank.get_handle_set_in_attentional_focus(std::back_inserter(af));
+
+    // Untimed, to get the document frequencies counted
+    DocFrequency::instance(&as).num_sentences();
+
+    std::vector<Result> results;
+    results.push_back(run_match(as, "basic", queries, true, false));
+    results.push_back(run_match(as, "fuzzy", queries, false, false));
+    results.push_back(run_match(as, "fuzzy-af", queries, false, true));
+    if (use_index)
+    {
+        MinHashIndex::instance(&as, SET_LINK).size();
+        results.push_back(run_match(as, "fuzzy-index", queries, false, false));
+    }
+    results.push_back(run_compare(as, queries));
+
+    size_t rss_after = proc_status_kb("VmRSS:");
+    size_t peak = proc_status_kb("VmHWM:");
+
+    size_t sentences = as.get_num_atoms_of_type(SENTENCE_NODE);
+    size_t atoms = as.get_size();
+
+    if (json)
+    {
+        printf("{\"sentences\": %zu, \"atoms\": %zu, \"af_size\": %zu, "
+               "\"corpus_kb\": %zu, \"search_kb\": %zu, \"peak_kb\": %zu, "
+               "\"results\": [", sentences, atoms, af.size(),
+               growth(rss_before, rss_corpus), growth(rss_corpus, rss_after),
+               peak);
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const Result& r = results[i];
+            printf("%s{\"mode\": \"%s\", \"calls\": %zu, "
+                   "\"mean_visited\": %.1f, \"allocs_per_call\": %.1f, "
+                   "\"p50_us\": %.1f, \"p99_us\": %.1f, \"max_us\": %.1f}",
+                   i ? ", " : "", r.mode.c_str(), r.calls, r.mean_visited,
+                   r.allocs_per_call, r.p50_us, r.p99_us, r.max_us);
+        }
+        printf("]}\n");
+    }
+    else
+    {
+        printf("sentences: %zu, atoms: %zu, af size: %zu\n",
+               sentences, atoms, af.size());
+        printf("memory: corpus %zu kB, searches %zu kB, peak %zu kB\n",
+               growth(rss_before, rss_corpus), growth(rss_corpus, rss_after),
+               peak);
+        printf("%-12s %8s %12s %12s %12s %12s %12s\n", "mode", "calls",
+               "visited", "allocs/call", "p50 (us)", "p99 (us)", "max (us)");
+        for (const Result& r : results)
+            printf("%-12s %8zu %12.1f %12.1f %12.1f %12.1f %12.1f\n",
+                   r.mode.c_str(), r.calls, r.mean_visited,
+                   r.allocs_per_call, r.p50_us, r.p99_us, r.max_us);
+    }
+
+    MinHashIndex::release(&as);
+    DocFrequency::release(&as);
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * LGBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/nlp/lg-dict/LGDictNode.h>
+#include <opencog/nlp/lg-parse/LGParseLink.h>
+#include <opencog/nlp/types/atom_types.h>
+
+#include "BenchUtil.h"
+#include "Fixtures.h"
+
+using namespace opencog;
+using namespace opencog::bench;
+
+/**
+ * Time the Link Grammar dictionary lookups and parses, on sentences of
+ * the shared synthetic corpus.
+ *
+ * Usage: lg-bench [--dict NAME] [--sentences S] [--linkages L]
+ *                 [--seed R] [--json]
+ *
+ * The entries of the words are looked up once each with the entry
+ * memo of the LgDictNode off, and then again with it on. The sentences
+ * are parsed with the batch and the interactive policies, keeping L
+ * linkages each; then the parser and the placing of the parses in the
+ * atomspace are timed apart; last, they are parsed again with a parse
+ * cache, warmed by a first round.
+ */
+
+int main(int argc, char* argv[])
+{
+    const char* dict_name = "en";
+    size_t n_sentences = 200;
+    int linkages = 4;
+    unsigned seed = 42;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--dict") and i + 1 < argc)
+            dict_name = argv[++i];
+        else if (0 == strcmp(argv[i], "--sentences") and i + 1 < argc)
+            n_sentences = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--linkages") and i + 1 < argc)
+            linkages = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--seed") and i + 1 < argc)
+            seed = atoi(argv[++i]);
+        else if (0 == strcmp(argv[i], "--json"))
+            json = true;
+        else
+        {
+            fprintf(stderr, "Usage: %s [--dict NAME] [--sentences S] "
+                    "[--linkages L] [--seed R] [--json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<Sentence> sentences = make_sentences(n_sentences, seed);
+    std::set<std::string> vocabulary;
+    for (const Sentence& s : sentences)
+        vocabulary.insert(s.words.begin(), s.words.end());
+    std::vector<std::string> words(vocabulary.begin(), vocabulary.end());
+
+    AtomSpace as;
+    Clock::time_point start = Clock::now();
+    Handle dict = as.add_node(LG_DICT_NODE, dict_name);
+    LgDictNodePtr ldn(LgDictNodeCast(dict));
+    if (nullptr == ldn or nullptr == ldn->get_dictionary())
+    {
+        fprintf(stderr, "Could not open the dictionary \"%s\"\n", dict_name);
+        return 1;
+    }
+    Seconds setup = Clock::now() - start;
+
+    Report report("lg", "atoms");
+    report.param("sentences", n_sentences);
+    report.param("words", words.size());
+    report.param("linkages", linkages);
+    report.param("setup_s", setup.count());
+
+    ldn->set_entry_cache(0);
+    report.run("get_dict_entry/uncached", words.size(), [&](size_t w)
+    {
+        return ldn->get_dict_entry(words[w]).size();
+    });
+    ldn->set_entry_cache(LgDictNode::DEFAULT_ENTRY_CACHE);
+    report.run("get_dict_entry/cached", words.size(), [&](size_t w)
+    {
+        return ldn->get_dict_entry(words[w]).size();
+    });
+
+    Parse_Options opts = LGParseLink::create_parse_options();
+    const LGParsePolicy& batch = LGParsePolicy::find("batch");
+    const LGParsePolicy& interactive = LGParsePolicy::find("interactive");
+    auto parse = [&](size_t i, const LGParsePolicy& policy, bool minimal)
+    {
+        size_t before = as.get_size();
+        LGParseLink::parse(sentences[i].text, dict, opts, policy,
+                           linkages, minimal, &as);
+        return (size_t) (as.get_size() - before);
+    };
+
+    report.run("parse/batch", n_sentences,
+        [&](size_t i) { return parse(i, batch, false); });
+    report.run("parse/interactive", n_sentences,
+        [&](size_t i) { return parse(i, interactive, false); });
+    report.run("parse/minimal", n_sentences,
+        [&](size_t i) { return parse(i, batch, true); });
+
+    // The two halves of a parse
+    std::vector<LGParsedSentencePtr> parsed(n_sentences);
+    report.run("find_parses", n_sentences, [&](size_t i)
+    {
+        LGParseTelemetry tlm;
+        parsed[i] = LGParseLink::find_parses(sentences[i].text, dict, opts,
+                                             batch, linkages, false, tlm);
+        return (size_t) tlm.num_found;
+    });
+    report.run("place_parses", n_sentences, [&](size_t i)
+    {
+        LGParseTelemetry tlm;
+        size_t before = as.get_size();
+        LGParseLink::place_parses(parsed[i], *ldn, false, &as, tlm);
+        return (size_t) (as.get_size() - before);
+    });
+
+    // The corpus repeats itself, as the words are drawn from a small
+    // vocabulary, so some of the first round come from the cache too.
+    ldn->set_parse_cache(4 * n_sentences);
+    report.run("parse/cache first", n_sentences,
+        [&](size_t i) { return parse(i, batch, false); }, false);
+    report.run("parse/cache again", n_sentences,
+        [&](size_t i) { return parse(i, batch, false); });
+    ldn->set_parse_cache(0);
+
+    parse_options_delete(opts);
+    report.print(json);
+    return 0;
+}
@@ -0,0 +1,276 @@
+/*
+ * LojbanBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/nlp/lojban/LojbanModule.h>
+
+#include "BenchUtil.h"
+
+using namespace opencog;
+using namespace opencog::nlp;
+
+/**
+ * Time the Lojban parser, to tell whether Lojban input can be parsed
+ * on the interactive path.
+ *
+ * Usage: lojban-bench [--corpus FILE] [--rounds R] [--bulk-lines N]
+ *                     [--threads T] [--json]
+ *
+ * The sentences, a few built-in ones or those of the corpus, a line
+ * each, are parsed R times each with lojban_parse, reporting the time
+ * and the no. of atoms added per sentence; then all at once with
+ * lojban_parse_batch. Parsing the empty string gives the cost of the
+ * call into Haskell itself. Last, a file of N lines of the sentences
+ * is loaded with load-lojban-bulk on 1, 2, 4, ... up to T threads,
+ * reporting the lines per second.
+ */
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double> Seconds;
+
+static const char* builtin_sentences[] = {
+    "mi jimpe ti",
+    "do klama le zarci",
+    "mi prami do",
+    "ti mlatu",
+    "le gerku cu batci le mlatu",
+    "mi citka lo plise",
+    "mi djica lo nu do klama",
+    "la .alis. cu tavla mi",
+    nullptr
+};
+
+struct Result
+{
+    std::string name;
+    size_t calls;
+    double us_per_call;
+    double allocs_per_call;
+    double atoms_per_call;
+};
+
+int main(int argc, char* argv[])
+{
+    const char* corpus = nullptr;
+    size_t rounds = 5;
+    size_t bulk_lines = 2000;
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    bool json = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--corpus") and i + 1 < argc)
+            corpus = argv[++i];
+        else if (0 == strcmp(argv[i], "--rounds") and i + 1 < argc)
+            rounds = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--bulk-lines") and i + 1 < argc)
+            bulk_lines = std::max(0, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--threads") and i + 1 < argc)
+            max_threads = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--json"))
+            json = true;
+        else
+        {
+            fprintf(stderr, "Usage: %s [--corpus FILE] [--rounds R] "
+                    "[--bulk-lines N] [--threads T] [--json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<std::string> sentences;
+    if (corpus)
+    {
+        std::ifstream file(corpus);
+        std::string line;
+        while (std::getline(file, line))
+            if (not line.empty()) sentences.push_back(line);
+    }
+    else
+    {
+        for (int i = 0; builtin_sentences[i]; i++)
+            sentences.push_back(builtin_sentences[i]);
+    }
+    if (sentences.empty())
+    {
+        fprintf(stderr, "No sentences to parse\n");
+        return 1;
+    }
+
+    // The module loads the word lists for the bulk load; the calls
+    // timed directly get their own copy.
+    Clock::time_point start = Clock::now();
+    server(CogServer::createInstance);
+    AtomSpace& as = cogserver().getAtomSpace();
+    LojbanModule* lm = new LojbanModule(cogserver());
+    HsStablePtr wordlist = lojban_init();
+    Seconds setup = Clock::now() - start;
+    std::vector<Result> results;
+    size_t failed = 0;
+
+    // The call into Haskell, with next to nothing to parse.
+    {
+        size_t calls = 100 * rounds;
+        size_t allocs = bench::allocations();
+        start = Clock::now();
+        for (size_t i = 0; i < calls; i++)
+            lojban_parse(&as, wordlist, "");
+        Seconds t = Clock::now() - start;
+        allocs = bench::allocations() - allocs;
+        results.push_back({"ffi (empty string)", calls,
+                           1e6 * t.count() / calls, (double) allocs / calls,
+                           0.0});
+    }
+
+    // A sentence at a time
+    {
+        size_t before = as.get_size();
+        size_t allocs = bench::allocations();
+        start = Clock::now();
+        for (size_t r = 0; r < rounds; r++)
+            for (const std::string& s : sentences)
+            {
+                Handle* hptr = lojban_parse(&as, wordlist, s.c_str());
+                if (0 == r and (!hptr or (*hptr) == Handle::UNDEFINED))
+                    failed++;
+            }
+        Seconds t = Clock::now() - start;
+        allocs = bench::allocations() - allocs;
+        size_t calls = rounds * sentences.size();
+        results.push_back({"lojban_parse", calls, 1e6 * t.count() / calls,
+                           (double) allocs / calls,
+                           double(as.get_size() - before) / calls});
+    }
+
+    // All of them in one call
+    {
+        std::vector<const char*> texts;
+        for (const std::string& s : sentences)
+            texts.push_back(s.c_str());
+        std::vector<Handle*> parsed(sentences.size());
+
+        size_t before = as.get_size();
+        size_t allocs = bench::allocations();
+        start = Clock::now();
+        for (size_t r = 0; r < rounds; r++)
+            lojban_parse_batch(&as, wordlist, texts.size(), texts.data(),
+                               parsed.data());
+        Seconds t = Clock::now() - start;
+        allocs = bench::allocations() - allocs;
+        size_t calls = rounds * sentences.size();
+        results.push_back({"lojban_parse_batch", calls,
+                           1e6 * t.count() / calls, (double) allocs / calls,
+                           double(as.get_size() - before) / calls});
+    }
+    lojban_exit(wordlist);
+
+    // The bulk load, from a file of the sentences over and over
+    struct BulkResult
+    {
+        size_t threads;
+        size_t lines;
+        double seconds;
+    };
+    std::vector<BulkResult> bulk;
+    if (0 < bulk_lines)
+    {
+        char path[] = "/tmp/lojban-bench-XXXXXX";
+        int fd = mkstemp(path);
+        if (0 > fd)
+        {
+            perror("mkstemp");
+            return 1;
+        }
+        close(fd);
+        {
+            std::ofstream file(path);
+            for (size_t i = 0; i < bulk_lines; i++)
+                file << sentences[i % sentences.size()] << "\n";
+        }
+
+        for (size_t n = 1; ; n = std::min(2 * n, max_threads))
+        {
+            as.clear();
+            LojbanModule::LoadStats ls = lm->load_lojban_bulk(path, n);
+            bulk.push_back({n, ls.lines, ls.seconds});
+            if (n == max_threads) break;
+        }
+        unlink(path);
+    }
+
+    if (json)
+    {
+        printf("{\"sentences\": %zu, \"failed\": %zu, \"setup_s\": %.2f, "
+               "\"results\": [", sentences.size(), failed, setup.count());
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const Result& r = results[i];
+            printf("%s{\"name\": \"%s\", \"calls\": %zu, "
+                   "\"us_per_call\": %.1f, \"allocs_per_call\": %.1f, "
+                   "\"atoms_per_call\": %.1f}",
+                   i ? ", " : "", r.name.c_str(), r.calls, r.us_per_call,
+                   r.allocs_per_call, r.atoms_per_call);
+        }
+        printf("], \"bulk\": [");
+        for (size_t i = 0; i < bulk.size(); i++)
+        {
+            const BulkResult& b = bulk[i];
+            printf("%s{\"threads\": %zu, \"lines\": %zu, \"seconds\": %.3f, "
+                   "\"lines_per_s\": %.1f}", i ? ", " : "", b.threads,
+                   b.lines, b.seconds, b.lines / std::max(b.seconds, 1e-9));
+        }
+        printf("]}\n");
+    }
+    else
+    {
+        printf("sentences: %zu, failed: %zu, setup %.2f s\n",
+               sentences.size(), failed, setup.count());
+        printf("%-24s %8s %14s %12s %12s\n", "call", "calls", "us/sentence",
+               "allocs/sent.", "atoms/sent.");
+        for (const Result& r : results)
+            printf("%-24s %8zu %14.1f %12.1f %12.1f\n", r.name.c_str(),
+                   r.calls, r.us_per_call, r.allocs_per_call,
+                   r.atoms_per_call);
+
+        if (not bulk.empty())
+        {
+            printf("\n%-24s %8s %14s %12s\n", "load-lojban-bulk", "lines",
+                   "seconds", "lines/s");
+            for (const BulkResult& b : bulk)
+                printf("%-24zu %8zu %14.3f %12.1f\n", b.threads, b.lines,
+                       b.seconds, b.lines / std::max(b.seconds, 1e-9));
+        }
+    }
+
+    delete lm;
+    return 0;
+}
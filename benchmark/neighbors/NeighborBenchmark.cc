@@ -0,0 +1,306 @@
+/*
+ * NeighborBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/neighbors/ForeachChaseLink.h>
+#include <opencog/neighbors/GetPredicates.h>
+#include <opencog/neighbors/Neighbors.h>
+#include <opencog/neighbors/PredicateIndex.h>
+
+#include "BenchUtil.h"
+
+using namespace opencog;
+
+/**
+ * Time the neighbor and link-chasing helpers on hub nodes with a large
+ * incoming set.
+ *
+ * Usage: neighbor-bench [--fan-in N] [--hubs H] [--noise R]
+ *                       [--predicates P] [--calls C] [--json]
+ *
+ * Each of the H hubs is in N InheritanceLinks, half with the hub first
+ * and half with it second, in N/10 EvaluationLinks of P predicates, and
+ * in R*N MemberLinks that none of the helpers asked for follow, so that
+ * looking at the whole incoming set shows.  Each helper is called C
+ * times on each hub; the time and the no. of allocations per call are
+ * reported.
+ */
+
+typedef std::chrono::steady_clock Clock;
+
+struct Result
+{
+    std::string name;
+    size_t calls;
+    double ns_per_call;
+    double allocs_per_call;
+    double atoms_per_call;
+};
+
+// Call f on each hub, the given no. of times; f returns the no. of
+// atoms it found, which is kept so the calls can't be optimized away.
+static Result run(const std::string& name, const HandleSeq& hubs,
+                  size_t calls, const std::function<size_t(const Handle&)>& f)
+{
+    // Once untimed, to let the scratch spaces grow
+    for (const Handle& h : hubs) f(h);
+
+    size_t found = 0;
+    size_t allocs = bench::allocations();
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < calls; i++)
+        for (const Handle& h : hubs)
+            found += f(h);
+    std::chrono::duration<double, std::nano> d = Clock::now() - start;
+    allocs = bench::allocations() - allocs;
+
+    size_t n = calls * hubs.size();
+    return Result{name, n, d.count() / n, (double) allocs / n,
+                  (double) found / n};
+}
+
+// For the member-function form of the link-chasing helpers
+struct Counter
+{
+    size_t count = 0;
+    bool see(const Handle&) { count++; return false; }
+};
+
+int main(int argc, char* argv[])
+{
+    size_t fan_in = 100000;
+    size_t n_hubs = 4;
+    double noise = 1.0;
+    size_t n_preds = 100;
+    size_t calls = 20;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--fan-in") and i + 1 < argc)
+            fan_in = std::max(2, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--hubs") and i + 1 < argc)
+            n_hubs = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--noise") and i + 1 < argc)
+            noise = std::max(0.0, atof(argv[++i]));
+        else if (0 == strcmp(argv[i], "--predicates") and i + 1 < argc)
+            n_preds = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--calls") and i + 1 < argc)
+            calls = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--json"))
+            json = true;
+        else
+        {
+            fprintf(stderr, "Usage: %s [--fan-in N] [--hubs H] [--noise R] "
+                    "[--predicates P] [--calls C] [--json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    AtomSpace as;
+    HandleSeq hubs;
+    HandleSeq preds;
+    for (size_t p = 0; p < n_preds; p++)
+        preds.push_back(as.add_node(PREDICATE_NODE, "pred-" + std::to_string(p)));
+
+    Clock::time_point start = Clock::now();
+    for (size_t k = 0; k < n_hubs; k++)
+    {
+        std::string hk = std::to_string(k);
+        Handle hub = as.add_node(CONCEPT_NODE, "hub-" + hk);
+        hubs.push_back(hub);
+
+        for (size_t i = 0; i < fan_in; i++)
+        {
+            Handle leaf = as.add_node(CONCEPT_NODE,
+                                      "leaf-" + hk + "-" + std::to_string(i));
+            if (i % 2)
+                as.add_link(INHERITANCE_LINK, hub, leaf);
+            else
+                as.add_link(INHERITANCE_LINK, leaf, hub);
+
+            if (i % 10 == 0)
+                as.add_link(EVALUATION_LINK, preds[i / 10 % n_preds],
+                            as.add_link(LIST_LINK, hub, leaf));
+        }
+
+        size_t n_noise = noise * fan_in;
+        for (size_t i = 0; i < n_noise; i++)
+            as.add_link(MEMBER_LINK, hub,
+                        as.add_node(CONCEPT_NODE, "set-" + hk + "-" +
+                                    std::to_string(i)));
+    }
+    std::chrono::duration<double> setup = Clock::now() - start;
+
+    std::vector<Result> results;
+
+    results.push_back(run("get_target_neighbors", hubs, calls,
+        [](const Handle& h)
+        { return get_target_neighbors(h, INHERITANCE_LINK).size(); }));
+    results.push_back(run("get_source_neighbors", hubs, calls,
+        [](const Handle& h)
+        { return get_source_neighbors(h, INHERITANCE_LINK).size(); }));
+    results.push_back(run("get_all_neighbors", hubs, calls,
+        [](const Handle& h)
+        { return get_all_neighbors(h, INHERITANCE_LINK).size(); }));
+    results.push_back(run("get_target_neighbors/subtypes", hubs, calls,
+        [](const Handle& h)
+        { return get_target_neighbors(h, ORDERED_LINK, true).size(); }));
+
+    HandleSeq buffer;
+    results.push_back(run("get_target_neighbors/iterator", hubs, calls,
+        [&](const Handle& h)
+        {
+            buffer.clear();
+            get_target_neighbors(std::back_inserter(buffer), h,
+                                 INHERITANCE_LINK, false);
+            return buffer.size();
+        }));
+    results.push_back(run("foreach_target_neighbor", hubs, calls,
+        [](const Handle& h)
+        {
+            size_t n = 0;
+            foreach_target_neighbor(h, INHERITANCE_LINK,
+                [&](const Handle&) { n++; return false; });
+            return n;
+        }));
+    results.push_back(run("first_target_neighbor", hubs, calls,
+        [](const Handle& h)
+        {
+            return (size_t) (Handle::UNDEFINED !=
+                             first_target_neighbor(h, INHERITANCE_LINK));
+        }));
+
+    // One call for all the hubs at once
+    NeighborBatch batch;
+    results.push_back(run("get_target_neighbors_batch", {hubs[0]}, calls,
+        [&](const Handle&)
+        {
+            batch = get_target_neighbors_batch(hubs, INHERITANCE_LINK);
+            return batch.neighbors.size();
+        }));
+
+    // Far fewer calls, as each one sees every leaf and their links
+    size_t few = std::max((size_t) 1, calls / 10);
+    results.push_back(run("get_distant_neighbors/1", hubs, few,
+        [](const Handle& h) { return get_distant_neighbors(h, 1).size(); }));
+    results.push_back(run("get_distant_neighbors/2", hubs, 1,
+        [](const Handle& h) { return get_distant_neighbors(h, 2).size(); }));
+    results.push_back(run("get_neighbors_by_distance/2", hubs, 1,
+        [](const Handle& h)
+        {
+            size_t n = 0;
+            for (const HandleSeq& level :
+                 get_neighbors_by_distance(h, 2, {INHERITANCE_LINK}))
+                n += level.size();
+            return n;
+        }));
+
+    results.push_back(run("get_predicates", hubs, calls,
+        [](const Handle& h) { return get_predicates(h).size(); }));
+    results.push_back(run("get_predicates_for", hubs, calls,
+        [&](const Handle& h) { return get_predicates_for(h, preds[0]).size(); }));
+    PredicateIndex::enable(&as);
+    results.push_back(run("get_predicates/index", hubs, calls,
+        [](const Handle& h) { return get_predicates(h).size(); }));
+    results.push_back(run("get_predicates_for/index", hubs, calls,
+        [&](const Handle& h) { return get_predicates_for(h, preds[0]).size(); }));
+    PredicateIndex::release(&as);
+
+    results.push_back(run("foreach_binary_link/method", hubs, calls,
+        [](const Handle& h)
+        {
+            Counter c;
+            foreach_binary_link(h, INHERITANCE_LINK, &Counter::see, &c);
+            return c.count;
+        }));
+    results.push_back(run("foreach_binary_link", hubs, calls,
+        [](const Handle& h)
+        {
+            size_t n = 0;
+            foreach_binary_link(h, INHERITANCE_LINK,
+                [&](const Handle&) { n++; return false; });
+            return n;
+        }));
+    results.push_back(run("foreach_reverse_binary_link", hubs, calls,
+        [](const Handle& h)
+        {
+            size_t n = 0;
+            foreach_reverse_binary_link(h, INHERITANCE_LINK,
+                [&](const Handle&, const Handle&) { n++; return false; });
+            return n;
+        }));
+    results.push_back(run("foreach_unordered_binary_link", hubs, calls,
+        [](const Handle& h)
+        {
+            size_t n = 0;
+            foreach_unordered_binary_link(h, INHERITANCE_LINK,
+                [&](const Handle&) { n++; return false; });
+            return n;
+        }));
+    results.push_back(run("foreach_link", hubs, calls,
+        [](const Handle& h)
+        {
+            size_t n = 0;
+            foreach_link(h, INHERITANCE_LINK, 1, 0,
+                [&](const Handle&) { n++; return false; });
+            return n;
+        }));
+
+    if (json)
+    {
+        printf("{\"hubs\": %zu, \"fan_in\": %zu, \"atoms\": %zu, "
+               "\"setup_s\": %.2f, \"results\": [", n_hubs, fan_in,
+               (size_t) as.get_size(), setup.count());
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const Result& r = results[i];
+            printf("%s{\"name\": \"%s\", \"calls\": %zu, "
+                   "\"ns_per_call\": %.0f, \"allocs_per_call\": %.1f, "
+                   "\"atoms_per_call\": %.1f}",
+                   i ? ", " : "", r.name.c_str(), r.calls, r.ns_per_call,
+                   r.allocs_per_call, r.atoms_per_call);
+        }
+        printf("]}\n");
+    }
+    else
+    {
+        printf("hubs: %zu, fan-in: %zu, atoms: %zu, setup %.2f s\n",
+               n_hubs, fan_in, (size_t) as.get_size(), setup.count());
+        printf("%-32s %8s %14s %12s %12s\n", "helper", "calls",
+               "ns/call", "allocs/call", "atoms/call");
+        for (const Result& r : results)
+            printf("%-32s %8zu %14.0f %12.1f %12.1f\n", r.name.c_str(),
+                   r.calls, r.ns_per_call, r.allocs_per_call,
+                   r.atoms_per_call);
+    }
+
+    return 0;
+}
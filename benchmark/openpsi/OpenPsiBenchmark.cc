@@ -0,0 +1,244 @@
+/*
+ * OpenPsiBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/openpsi/OpenPsiImplicator.h>
+#include <opencog/openpsi/OpenPsiRules.h>
+#include <opencog/openpsi/OpenPsiSelector.h>
+
+#include "BenchUtil.h"
+#include "Fixtures.h"
+
+using namespace opencog;
+using namespace opencog::bench;
+
+/**
+ * Time the psi-rule index, the checking of contexts and the selection
+ * of rules, on a synthetic set of rules.
+ *
+ * Usage: openpsi-bench [--rules N] [--kinds K] [--instances I]
+ *                      [--sentences S] [--seed R] [--json]
+ *
+ * Rule r has the context
+ *
+ *    (Inheritance (Variable "$x") (Concept "kind-<r % K>"))
+ *    (Evaluation (Predicate "pred-<r % 7>") (List (Variable "$x")))
+ *    (Evaluation (Predicate "heard") (List (Word w)))
+ *
+ * so that the first two clauses, a component shared by the rules with
+ * the same kind and predicate, are only searched once for all of them.
+ * The atomspace has I instances of each kind, with some of the
+ * predicates.  The words, and the inputs given to the rule lookups,
+ * come from the S sentences of the shared synthetic corpus.
+ */
+
+#define NUM_PREDICATES 7
+
+int main(int argc, char* argv[])
+{
+    size_t n_rules = 2000;
+    size_t n_kinds = 50;
+    size_t n_instances = 20;
+    size_t n_sentences = 200;
+    unsigned seed = 42;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--rules") and i + 1 < argc)
+            n_rules = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--kinds") and i + 1 < argc)
+            n_kinds = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--instances") and i + 1 < argc)
+            n_instances = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--sentences") and i + 1 < argc)
+            n_sentences = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--seed") and i + 1 < argc)
+            seed = atoi(argv[++i]);
+        else if (0 == strcmp(argv[i], "--json"))
+            json = true;
+        else
+        {
+            fprintf(stderr, "Usage: %s [--rules N] [--kinds K] "
+                    "[--instances I] [--sentences S] [--seed R] [--json]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<Sentence> sentences = make_sentences(n_sentences, seed);
+    std::vector<std::string> vocabulary;
+    for (const Sentence& s : sentences)
+        for (size_t j = 0; j < s.lemmas.size(); j++)
+            if ("noun" == s.pos[j]) vocabulary.push_back(s.lemmas[j]);
+    std::sort(vocabulary.begin(), vocabulary.end());
+    vocabulary.erase(std::unique(vocabulary.begin(), vocabulary.end()),
+                     vocabulary.end());
+
+    AtomSpace as;
+    Handle x = as.add_node(VARIABLE_NODE, "$x");
+    Handle heard = as.add_node(PREDICATE_NODE, "heard");
+    HandleSeq kinds, preds;
+    for (size_t k = 0; k < n_kinds; k++)
+        kinds.push_back(as.add_node(CONCEPT_NODE, "kind-" + std::to_string(k)));
+    for (size_t p = 0; p < NUM_PREDICATES; p++)
+        preds.push_back(as.add_node(PREDICATE_NODE, "pred-" + std::to_string(p)));
+
+    // The instances of a kind have every other predicate, so that only
+    // some of the contexts are satisfiable.
+    for (size_t k = 0; k < n_kinds; k++)
+        for (size_t i = 0; i < n_instances; i++)
+        {
+            Handle inst = as.add_node(CONCEPT_NODE,
+                "inst-" + std::to_string(k) + "-" + std::to_string(i));
+            as.add_link(INHERITANCE_LINK, inst, kinds[k]);
+            for (size_t p = k % 2; p < NUM_PREDICATES; p += 2)
+                as.add_link(EVALUATION_LINK, preds[p],
+                            as.add_link(LIST_LINK, inst));
+        }
+
+    // Only the first half of the words have been heard.
+    HandleSeq words;
+    for (size_t w = 0; w < vocabulary.size(); w++)
+    {
+        words.push_back(as.add_node(WORD_NODE, std::string(vocabulary[w])));
+        if (2 * w < vocabulary.size())
+            as.add_link(EVALUATION_LINK, heard,
+                        as.add_link(LIST_LINK, words[w]));
+    }
+
+    std::vector<HandleSeq> inputs;
+    for (const Sentence& s : sentences)
+    {
+        HandleSeq input;
+        for (const std::string& l : s.lemmas)
+            input.push_back(as.add_node(WORD_NODE, std::string(l)));
+        inputs.push_back(input);
+    }
+
+    OpenPsiRules& opr = openpsi_cache(&as);
+    OpenPsiImplicator& opi = openpsi_implicator(&as);
+    OpenPsiSelector& ops = openpsi_selector(&as);
+
+    Report report("openpsi", "rules");
+    report.param("rules", n_rules);
+    report.param("kinds", n_kinds);
+    report.param("instances", n_instances);
+    report.param("sentences", n_sentences);
+
+    HandleSeq rules(n_rules);
+    report.run("add_rule", n_rules, [&](size_t r)
+    {
+        Handle word = words[r % words.size()];
+        HandleSeq context = {
+            as.add_link(INHERITANCE_LINK, x, kinds[r % n_kinds]),
+            as.add_link(EVALUATION_LINK, preds[r % NUM_PREDICATES],
+                        as.add_link(LIST_LINK, x)),
+            as.add_link(EVALUATION_LINK, heard, as.add_link(LIST_LINK, word)),
+        };
+        Handle action = as.add_node(CONCEPT_NODE, "action-" + std::to_string(r));
+        Handle goal = as.add_node(CONCEPT_NODE,
+                                  "goal-" + std::to_string(r % 10));
+        rules[r] = opr.add_rule(context, action, goal,
+                                SimpleTruthValue::createTV(0.5 + (r % 5) / 10.0, 1.0));
+        opr.add_rule_terms(rules[r], {word});
+        return (size_t) 1;
+    }, false);
+
+    report.run("is_rule", n_rules, [&](size_t r)
+    {
+        return (size_t) opr.is_rule(rules[r]);
+    });
+    report.run("get_components", n_rules, [&](size_t r)
+    {
+        return opr.get_components(rules[r]).size();
+    });
+
+    // The first check of each rule searches the components not yet
+    // searched for another rule; checking again finds the atomspace
+    // unchanged, and returns the last result.
+    size_t satisfied = 0;
+    report.run("check_satisfiability/first", n_rules, [&](size_t r)
+    {
+        bool sat = 0.5 < opi.check_satisfiability(rules[r], opr)->get_mean();
+        satisfied += sat;
+        return (size_t) sat;
+    }, false);
+    report.param("satisfied", satisfied);
+    report.run("check_satisfiability/again", n_rules, [&](size_t r)
+    {
+        return (size_t) (0.5 < opi.check_satisfiability(rules[r], opr)->get_mean());
+    });
+
+    // A new instance of the kind of each rule, before checking it,
+    // makes the results of its component stale.
+    report.run("check_satisfiability/changed", n_rules, [&](size_t r)
+    {
+        Handle inst = as.add_node(CONCEPT_NODE, "new-" + std::to_string(r));
+        as.add_link(INHERITANCE_LINK, inst, kinds[r % n_kinds]);
+        return (size_t) (0.5 < opi.check_satisfiability(rules[r], opr)->get_mean());
+    });
+
+    report.run("check_satisfiability/all", 10, [&](size_t)
+    {
+        size_t n = 0;
+        for (const TruthValuePtr& tv : opi.check_satisfiability(rules, opr))
+            n += 0.5 < tv->get_mean();
+        return n;
+    });
+
+    report.run("get_triggered_rules", inputs.size(), [&](size_t i)
+    {
+        return opr.get_triggered_rules(inputs[i]).size();
+    });
+    report.run("get_rules_by_terms", inputs.size(), [&](size_t i)
+    {
+        return opr.get_rules_by_terms(inputs[i], 0).size();
+    });
+
+    OpenPsiSelector::Weights weights = {1.0, 1.0, 0.0, 0.0};
+    std::vector<double> w;
+    report.run("weigh", 10, [&](size_t)
+    {
+        w = ops.weigh(rules, weights, opr, opi);
+        return (size_t) std::count_if(w.begin(), w.end(),
+                                      [](double d) { return 0 < d; });
+    });
+    report.run("sample", 1000, [&](size_t)
+    {
+        return (size_t) (Handle::UNDEFINED != ops.sample(rules, w));
+    });
+
+    report.print(json);
+
+    openpsi_selector_release(&as);
+    openpsi_implicator_release(&as);
+    openpsi_cache_release(&as);
+    return 0;
+}
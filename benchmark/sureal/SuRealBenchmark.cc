@@ -0,0 +1,308 @@
+/*
+ * SuRealBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/guile/SchemeEval.h>
+#include <opencog/nlp/sureal/SuRealCache.h>
+#include <opencog/nlp/sureal/SuRealIndex.h>
+#include <opencog/nlp/types/atom_types.h>
+
+#include "BenchUtil.h"
+
+using namespace opencog;
+using namespace opencog::nlp;
+
+/**
+ * Time sureal-match and cached-sureal-match on the R2L fixtures of the
+ * SuReal unit test.
+ *
+ * Usage: sureal-bench [--fixtures DIR] [--copies N] [--iterations M]
+ *                     [--threads T] [--json]
+ *
+ * --copies loads each fixture N times, renaming the instances of every
+ * copy, so that there are N times as many sentences to search through.
+ * Each of the T threads runs every query M times.
+ */
+
+static const char* fixtures[] =
+{
+    "r2l-atomspace1.scm",
+    "r2l-atomspace2.scm",
+    "r2l-atomspace3.scm",
+    "r2l-atomspace4.scm",
+    "r2l-atomspace5.scm",
+    "r2l-atomspace6.scm",
+    "r2l-atomspace7.scm",
+};
+
+// The queries of SuRealUTest, and the WordNodes they need.
+static const char* words =
+    "(WordNode \"she\") (WordNode \"eats\") (WordNode \"green\")"
+    "(WordNode \"loves\") (WordNode \"apple\") (WordNode \"it\")"
+    "(WordNode \"jumps\")";
+
+static const char* queries[] =
+{
+    "(SetLink (EvaluationLink (PredicateNode \"eats\")"
+    " (ListLink (ConceptNode \"she\"))))",
+
+    "(SetLink (EvaluationLink (PredicateNode \"loves\")"
+    " (ListLink (ConceptNode \"cat\") (ConceptNode \"dog\")))"
+    " (InheritanceLink (ConceptNode \"cat\") (ConceptNode \"green\")))",
+
+    "(SetLink (EvaluationLink (PredicateNode \"walked\")"
+    " (ListLink (ConceptNode \"she\")))"
+    " (EvaluationLink (PredicateNode \"ran\")"
+    " (ListLink (ConceptNode \"he\"))))",
+
+    "(SetLink (EvaluationLink (PredicateNode \"ate\")"
+    " (ListLink (ConceptNode \"he\") (ConceptNode \"apple\"))))",
+
+    "(SetLink (EvaluationLink (PredicateNode \"jumps\")"
+    " (ListLink (ConceptNode \"it\"))))",
+
+    "(SetLink (EvaluationLink (PredicateNode \"eat\")"
+    " (ListLink (ConceptNode \"he\")))"
+    " (InheritanceLink (PredicateNode \"eat\")"
+    " (DefinedLinguisticConceptNode \"past\"))"
+    " (EvaluationLink (PredicateNode \"drink\")"
+    " (ListLink (ConceptNode \"she\")))"
+    " (InheritanceLink (PredicateNode \"drink\")"
+    " (DefinedLinguisticConceptNode \"present\")))",
+};
+
+static void use_modules(SchemeEval& ev)
+{
+    ev.eval("(setlocale LC_CTYPE \"\")");
+    ev.eval("(use-modules (opencog) (opencog nlp) (opencog nlp lg-dict)"
+            " (opencog nlp relex2logic) (opencog nlp sureal))");
+    ev.clear_pending();
+}
+
+// Load a fixture; for copy > 0, every "@" is made unique to the copy,
+// which gives new instances of the same words in new sentences.
+static bool load_fixture(SchemeEval& ev, const std::string& path, int copy)
+{
+    if (copy == 0)
+    {
+        ev.eval("(load \"" + path + "\")");
+        return not ev.eval_error();
+    }
+
+    std::ifstream in(path);
+    if (not in) return false;
+
+    std::stringstream ss;
+    ss << in.rdbuf();
+    std::string text = ss.str();
+
+    std::string tag = "@bench" + std::to_string(copy) + "-";
+    std::string scaled;
+    for (char c : text)
+    {
+        if (c == '@') scaled += tag;
+        else scaled += c;
+    }
+
+    char tmp[] = "/tmp/sureal-bench-XXXXXX";
+    int fd = mkstemp(tmp);
+    if (fd < 0) return false;
+    close(fd);
+
+    std::ofstream(tmp) << scaled;
+    ev.eval(std::string("(load \"") + tmp + "\")");
+    bool ok = not ev.eval_error();
+    unlink(tmp);
+    return ok;
+}
+
+typedef std::chrono::steady_clock Clock;
+
+struct Result
+{
+    const char* mode;
+    size_t matches;
+    double seconds;
+    double allocs_per_match;
+    double p50_us;
+    double p99_us;
+};
+
+static double percentile(std::vector<double>& v, double p)
+{
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    size_t i = std::min(v.size() - 1, size_t(p * v.size()));
+    return v[i];
+}
+
+// Run every query `iterations` times from `threads` threads, each with
+// its own evaluator.
+static Result run(AtomSpace& as, const char* mode, const std::string& fn,
+                  int iterations, int threads)
+{
+    std::vector<std::vector<double>> latencies(threads);
+
+    auto worker = [&](int t)
+    {
+        SchemeEval ev(&as);
+        use_modules(ev);
+
+        for (int i = 0; i < iterations; i++)
+        {
+            for (const char* q : queries)
+            {
+                Clock::time_point start = Clock::now();
+                ev.eval("(" + fn + " " + q + ")");
+                std::chrono::duration<double, std::micro> d = Clock::now() - start;
+                latencies[t].push_back(d.count());
+            }
+        }
+    };
+
+    size_t allocs = bench::allocations();
+    Clock::time_point start = Clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++)
+        pool.push_back(std::thread(worker, t));
+    for (auto& th : pool)
+        th.join();
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    allocs = bench::allocations() - allocs;
+
+    std::vector<double> all;
+    for (auto& l : latencies)
+        all.insert(all.end(), l.begin(), l.end());
+
+    Result r;
+    r.mode = mode;
+    r.matches = all.size();
+    r.seconds = elapsed.count();
+    // Including those of starting the threads and their evaluators
+    r.allocs_per_match = all.empty() ? 0 : (double) allocs / all.size();
+    r.p50_us = percentile(all, 0.5);
+    r.p99_us = percentile(all, 0.99);
+    return r;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string dir = PROJECT_SOURCE_DIR "/tests/nlp/sureal";
+    int copies = 1;
+    int iterations = 20;
+    int threads = 1;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--fixtures") and i + 1 < argc)
+            dir = argv[++i];
+        else if (0 == strcmp(argv[i], "--copies") and i + 1 < argc)
+            copies = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--iterations") and i + 1 < argc)
+            iterations = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--threads") and i + 1 < argc)
+            threads = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--json"))
+            json = true;
+        else
+        {
+            fprintf(stderr, "Usage: %s [--fixtures DIR] [--copies N] "
+                    "[--iterations M] [--threads T] [--json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    AtomSpace as;
+    SchemeEval ev(&as);
+    use_modules(ev);
+
+    for (int c = 0; c < copies; c++)
+    {
+        for (const char* f : fixtures)
+        {
+            if (not load_fixture(ev, dir + "/" + f, c))
+            {
+                fprintf(stderr, "Failed to load %s/%s\n", dir.c_str(), f);
+                return 1;
+            }
+        }
+    }
+    ev.eval(words);
+    ev.clear_pending();
+
+    // one untimed pass, to get the LG dictionary entries loaded
+    run(as, "warmup", "sureal-match", 1, 1);
+
+    std::vector<Result> results;
+    results.push_back(run(as, "uncached", "sureal-match", iterations, threads));
+    SuRealCache::instance(&as).reset();
+    results.push_back(run(as, "cached", "cached-sureal-match", iterations, threads));
+
+    size_t sentences = as.get_num_atoms_of_type(SENTENCE_NODE);
+
+    if (json)
+    {
+        printf("{\"sentences\": %zu, \"copies\": %d, \"iterations\": %d, "
+               "\"threads\": %d, \"results\": [", sentences, copies,
+               iterations, threads);
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const Result& r = results[i];
+            printf("%s{\"mode\": \"%s\", \"matches\": %zu, \"seconds\": %.6f, "
+                   "\"matches_per_sec\": %.2f, \"allocs_per_match\": %.1f, "
+                   "\"p50_us\": %.1f, \"p99_us\": %.1f}",
+                   i ? ", " : "", r.mode, r.matches, r.seconds,
+                   r.matches / r.seconds, r.allocs_per_match, r.p50_us,
+                   r.p99_us);
+        }
+        printf("]}\n");
+    }
+    else
+    {
+        printf("sentences: %zu, copies: %d, iterations: %d, threads: %d\n",
+               sentences, copies, iterations, threads);
+        printf("%-10s %10s %14s %12s %12s %12s\n", "mode", "matches",
+               "matches/sec", "allocs/match", "p50 (us)", "p99 (us)");
+        for (const Result& r : results)
+            printf("%-10s %10zu %14.2f %12.1f %12.1f %12.1f\n", r.mode,
+                   r.matches, r.matches / r.seconds, r.allocs_per_match,
+                   r.p50_us, r.p99_us);
+    }
+
+    SuRealIndex::release(&as);
+    SuRealCache::release(&as);
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * SuRealCacheBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/atom_types/atom_types.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/nlp/sureal/SuRealCache.h>
+
+using namespace opencog;
+using namespace opencog::nlp;
+
+/**
+ * Compare the latency of a SuRealCache grounding hit against the
+ * string-serialized keys that the cache used to build on every lookup.
+ *
+ * Usage: sureal-cache-benchmark [groundings] [lookups]
+ */
+
+// The key format used before the grounding cache was hashed.
+static std::string legacy_atom_key(const Handle& h)
+{
+    std::string answer = nameserver().getTypeName(h->get_type());
+    if (h->is_node()) {
+        answer += ":";
+        answer += h->get_name();
+    } else {
+        answer += "(";
+        for (const Handle& o : h->getOutgoingSet()) {
+            answer += legacy_atom_key(o);
+            answer += ",";
+        }
+        answer += ")";
+    }
+    return answer;
+}
+
+static std::string legacy_map_key(const HandleMap& m)
+{
+    std::string answer;
+    for (const auto& kv : m) {
+        answer += legacy_atom_key(kv.first);
+        answer += "-";
+        answer += legacy_atom_key(kv.second);
+        answer += "#";
+    }
+    return answer;
+}
+
+// Build a grounding shaped like the ones SuRealPMCB::grounding gets:
+// a couple of word variables, and the clause they appear in.
+static void make_grounding(AtomSpace& as, size_t i,
+                           HandleMap& var_soln, HandleMap& pred_soln)
+{
+    std::string n = std::to_string(i);
+
+    Handle pat_pred = as.add_node(PREDICATE_NODE, "eats");
+    Handle pat_subj = as.add_node(CONCEPT_NODE, "she");
+    Handle pat_obj = as.add_node(CONCEPT_NODE, "apple");
+    Handle soln_pred = as.add_node(PREDICATE_NODE, "eats@" + n);
+    Handle soln_subj = as.add_node(CONCEPT_NODE, "she@" + n);
+    Handle soln_obj = as.add_node(CONCEPT_NODE, "apple@" + n);
+
+    Handle pat_clause = as.add_link(EVALUATION_LINK, HandleSeq({pat_pred,
+        as.add_link(LIST_LINK, HandleSeq({pat_subj, pat_obj}))}));
+    Handle soln_clause = as.add_link(EVALUATION_LINK, HandleSeq({soln_pred,
+        as.add_link(LIST_LINK, HandleSeq({soln_subj, soln_obj}))}));
+
+    var_soln[pat_pred] = soln_pred;
+    var_soln[pat_subj] = soln_subj;
+    var_soln[pat_obj] = soln_obj;
+    pred_soln[pat_clause] = soln_clause;
+}
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsed_ns(Clock::time_point start, size_t count)
+{
+    std::chrono::duration<double, std::nano> d = Clock::now() - start;
+    return d.count() / count;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n_groundings = (argc > 1) ? std::atol(argv[1]) : 1000;
+    size_t n_lookups = (argc > 2) ? std::atol(argv[2]) : 1000000;
+
+    AtomSpace as;
+    std::vector<HandleMap> var_solns(n_groundings);
+    std::vector<HandleMap> pred_solns(n_groundings);
+    for (size_t i = 0; i < n_groundings; i++)
+        make_grounding(as, i, var_solns[i], pred_solns[i]);
+
+    // Fill both caches with the same entries.
+    SuRealCache& cache = SuRealCache::instance(&as);
+
+    std::unordered_map<std::string,
+                       std::unordered_map<std::string, bool>> legacy;
+    for (size_t i = 0; i < n_groundings; i++) {
+        cache.add_grounding_match(var_solns[i], pred_solns[i], true);
+        legacy[legacy_map_key(var_solns[i])]
+              [legacy_map_key(pred_solns[i])] = true;
+    }
+
+    size_t hits = 0;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < n_lookups; i++) {
+        size_t j = i % n_groundings;
+        std::string key1 = legacy_map_key(var_solns[j]);
+        auto it = legacy.find(key1);
+        if (it != legacy.end() and
+            it->second.count(legacy_map_key(pred_solns[j])) > 0)
+            hits++;
+    }
+    double legacy_ns = elapsed_ns(start, n_lookups);
+
+    start = Clock::now();
+    for (size_t i = 0; i < n_lookups; i++) {
+        size_t j = i % n_groundings;
+        if (cache.grounding_match(var_solns[j], pred_solns[j]) == 1)
+            hits++;
+    }
+    double hashed_ns = elapsed_ns(start, n_lookups);
+
+    printf("groundings: %zu, lookups: %zu, hits: %zu\n",
+           n_groundings, n_lookups, hits);
+    printf("string keys:  %10.1f ns/hit\n", legacy_ns);
+    printf("hashed keys:  %10.1f ns/hit\n", hashed_ns);
+    printf("speedup:      %10.2fx\n", legacy_ns / hashed_ns);
+
+    SuRealCache::release(&as);
+    return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * WSDBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/nlp/types/atom_types.h>
+#include <opencog/nlp/wsd/Mihalcea.h>
+#include <opencog/nlp/wsd/SenseSimilarityTable.h>
+#include <opencog/util/Config.h>
+
+#include "BenchUtil.h"
+#include "Fixtures.h"
+
+using namespace opencog;
+using namespace opencog::bench;
+
+/**
+ * Time the Mihalcea word-sense disambiguation, and the sense
+ * similarity lookups it makes, on documents of the shared synthetic
+ * corpus, or on a document loaded from a file.
+ *
+ * Usage: wsd-bench [--sentences S] [--senses K] [--documents D]
+ *                  [--load FILE] [--seed R] [--json]
+ *
+ * Each of the D documents has S sentences; each noun and verb lemma has
+ * K senses. The similarity of every pair of senses is put in a sense
+ * similarity table, in a temporary file, which the WSD then uses, as
+ * with SENSE_SIMILARITY_TABLE. A file given with --load holds a parsed
+ * document, with its word senses, e.g. the output of the nlp pipeline;
+ * it is processed instead of the synthetic documents, with whatever
+ * SENSE_SIMILARITY_TABLE the configuration names.
+ */
+
+int main(int argc, char* argv[])
+{
+    size_t n_sentences = 50;
+    size_t n_senses = 4;
+    size_t n_docs = 5;
+    const char* load = nullptr;
+    unsigned seed = 42;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--sentences") and i + 1 < argc)
+            n_sentences = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--senses") and i + 1 < argc)
+            n_senses = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--documents") and i + 1 < argc)
+            n_docs = std::max(1, atoi(argv[++i]));
+        else if (0 == strcmp(argv[i], "--load") and i + 1 < argc)
+            load = argv[++i];
+        else if (0 == strcmp(argv[i], "--seed") and i + 1 < argc)
+            seed = atoi(argv[++i]);
+        else if (0 == strcmp(argv[i], "--json"))
+            json = true;
+        else
+        {
+            fprintf(stderr, "Usage: %s [--sentences S] [--senses K] "
+                    "[--documents D] [--load FILE] [--seed R] [--json]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    AtomSpace as;
+    Report report("wsd", "atoms");
+    HandleSeq docs;
+    char table_path[] = "/tmp/wsd-bench-XXXXXX";
+    bool have_table = false;
+
+    if (load)
+    {
+        if (not load_scm(as, load))
+        {
+            fprintf(stderr, "Could not load %s\n", load);
+            return 1;
+        }
+        as.get_handles_by_type(std::back_inserter(docs), DOCUMENT_NODE);
+    }
+    else
+    {
+        std::vector<std::vector<Sentence>> texts;
+        for (size_t d = 0; d < n_docs; d++)
+            texts.push_back(make_sentences(n_sentences, seed + d));
+
+        std::vector<Sentence> all;
+        for (const std::vector<Sentence>& t : texts)
+            all.insert(all.end(), t.begin(), t.end());
+        std::vector<std::string> senses = sense_names(all, n_senses);
+
+        // Made up, but reproducible, similarities, in the ranges of
+        // the raw WordNet measures.
+        int fd = mkstemp(table_path);
+        if (0 > fd)
+        {
+            perror("mkstemp");
+            return 1;
+        }
+        close(fd);
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        size_t a = 0, b = 1;
+        size_t pairs = SenseSimilarityTable::write(
+            [&](SenseSimilarityTable::Record& r)
+            {
+                if (b == senses.size())
+                {
+                    a++;
+                    b = a + 1;
+                }
+                if (b >= senses.size()) return false;
+                r.sense_a = senses[a];
+                r.sense_b = senses[b++];
+                r.jcn = 0.3 * unit(rng);
+                r.lch = 0.5 + 3.1 * unit(rng);
+                r.lesk = 50 * unit(rng);
+                return true;
+            }, table_path);
+        config().set("SENSE_SIMILARITY_TABLE", table_path);
+        have_table = true;
+
+        for (size_t d = 0; d < n_docs; d++)
+            docs.push_back(add_relex_document(as,
+                "bench-doc-" + std::to_string(d), texts[d], n_senses));
+
+        report.param("sentences", n_sentences);
+        report.param("senses", n_senses);
+        report.param("pairs", pairs);
+    }
+    if (docs.empty())
+    {
+        fprintf(stderr, "No documents to process\n");
+        return 1;
+    }
+    report.param("documents", docs.size());
+
+    // The lookups the edge stage makes, between the senses of two
+    // words; 100 of them a call, to be well above the clock's cost.
+    if (have_table)
+    {
+        SenseSimilarityTable table(table_path);
+        HandleSeq senses;
+        as.get_handles_by_type(std::back_inserter(senses), WORD_SENSE_NODE);
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<size_t> pick(0, senses.size() - 1);
+        std::vector<std::pair<Handle, Handle>> pairs;
+        for (size_t i = 0; i < 100 * 1000; i++)
+            pairs.push_back({senses[pick(rng)], senses[pick(rng)]});
+
+        report.run("similarity/100 pairs", 1000, [&](size_t i)
+        {
+            size_t found = 0;
+            for (size_t j = 100 * i; j < 100 * (i + 1); j++)
+                found += 0 < table.similarity(pairs[j].first,
+                                              pairs[j].second)->get_mean();
+            return found;
+        });
+    }
+
+    // The whole disambiguation, a document a call; the atoms added
+    // are the sense labels and the edges between them. The documents
+    // are all different, so there is no warming up on one of them.
+    Mihalcea mihalcea;
+    mihalcea.set_atom_space(&as);
+    report.run("process_document", docs.size(), [&](size_t d)
+    {
+        size_t before = as.get_size();
+        mihalcea.process_document(docs[d]);
+        return (size_t) (as.get_size() - before);
+    }, false);
+
+    report.print(json);
+
+    if (have_table) unlink(table_path);
+    return 0;
+}
@@ -0,0 +1,24 @@
+from libcpp.vector cimport vector
+from cython.operator cimport dereference as deref
+from opencog.atomspace cimport *
+from opencog.scheme_wrapper import scheme_eval
+
+cdef extern from "opencog/nlp/anaphora/HobbsResolver.h" namespace "opencog::nlp":
+    # C++:
+    #
+    #   HandleSeq hobbs_resolve(AtomSpace* as, const Handle& parse);
+    #
+    cdef vector[cHandle] c_hobbs_resolve "opencog::nlp::hobbs_resolve" (cAtomSpace* atomspace, cHandle parse) except +
+
+
+def hobbs_resolve(AtomSpace atomspace, Atom parse):
+    """
+    Resolve every pronoun of the ParseNode parse, as HobbsAgent does for
+    all the words of the atomspace, and return the ReferenceLinks made.
+    """
+    scheme_eval(atomspace, '(use-modules (opencog nlp anaphora))')
+    scheme_eval(atomspace, '(hobbs-load-rules)')
+
+    cdef vector[cHandle] handle_vector = c_hobbs_resolve(
+        atomspace.atomspace, deref(parse.handle))
+    return [Atom.createAtom(h) for h in handle_vector]
@@ -0,0 +1,17 @@
+from libcpp.vector cimport vector
+from opencog.atomspace cimport cHandle
+
+# A sequence of atoms kept as C++ Handles; the Python Atom of each is
+# only made when it is asked for.
+cdef class HandleArray:
+    cdef vector[cHandle] handles
+    cdef vector[unsigned long] values
+    cdef Py_ssize_t shape[1]
+    cdef Py_ssize_t strides[1]
+    cdef int exports
+
+    @staticmethod
+    cdef HandleArray wrap(vector[cHandle]& handles)
+
+# The Handles of a HandleArray, or of any iterable of Atoms.
+cdef vector[cHandle] handles_of(object atoms) except *
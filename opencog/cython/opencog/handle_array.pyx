@@ -0,0 +1,87 @@
+from cpython.buffer cimport PyBUF_FORMAT, PyBUF_ND, PyBUF_STRIDES
+from cython.operator cimport dereference as deref
+from libcpp.vector cimport vector
+from opencog.atomspace cimport Atom, cHandle
+
+cdef class HandleArray:
+    """
+    A read-only sequence of atoms, as returned by the bulk variants of
+    the neighbors and openpsi functions. The atoms stay C++ Handles until
+    they are indexed or iterated over, so that getting thousands of them
+    doesn't make thousands of Python objects.
+
+    It also exposes the atom addresses, as unsigned longs, through the
+    buffer protocol, e.g. for numpy.asarray(array), so that they can be
+    compared, sorted or counted without any Atom at all. They stay valid
+    while the array is alive, as it holds the atoms.
+    """
+
+    def __cinit__(self):
+        self.exports = 0
+
+    @staticmethod
+    cdef HandleArray wrap(vector[cHandle]& handles):
+        """The HandleArray taking over the given handles, emptying them."""
+        cdef HandleArray array = HandleArray.__new__(HandleArray)
+        array.handles.swap(handles)
+        return array
+
+    def __len__(self):
+        return self.handles.size()
+
+    def __getitem__(self, index):
+        cdef Py_ssize_t i
+        if isinstance(index, slice):
+            return [self[i] for i in range(*index.indices(len(self)))]
+        i = index
+        if i < 0:
+            i += self.handles.size()
+        if i < 0 or i >= <Py_ssize_t> self.handles.size():
+            raise IndexError("HandleArray index out of range")
+        return Atom.createAtom(self.handles[i])
+
+    def __iter__(self):
+        cdef size_t i
+        for i in range(self.handles.size()):
+            yield Atom.createAtom(self.handles[i])
+
+    def __repr__(self):
+        return "HandleArray(%d atoms)" % self.handles.size()
+
+    def to_list(self):
+        """All the atoms, as a list of Atoms."""
+        return list(self)
+
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        cdef size_t i
+        if self.exports == 0:
+            self.values.resize(self.handles.size())
+            for i in range(self.handles.size()):
+                self.values[i] = <unsigned long> self.handles[i].atom_ptr()
+        self.shape[0] = self.values.size()
+        self.strides[0] = sizeof(unsigned long)
+
+        buffer.buf = <char *> self.values.data()
+        buffer.format = 'L' if flags & PyBUF_FORMAT else NULL
+        buffer.internal = NULL
+        buffer.itemsize = sizeof(unsigned long)
+        buffer.len = self.values.size() * sizeof(unsigned long)
+        buffer.ndim = 1
+        buffer.obj = self
+        buffer.readonly = 1
+        buffer.shape = self.shape if flags & PyBUF_ND else NULL
+        buffer.strides = self.strides if flags & PyBUF_STRIDES else NULL
+        buffer.suboffsets = NULL
+        self.exports += 1
+
+    def __releasebuffer__(self, Py_buffer *buffer):
+        self.exports -= 1
+
+
+cdef vector[cHandle] handles_of(object atoms) except *:
+    cdef vector[cHandle] handles
+    if isinstance(atoms, HandleArray):
+        return (<HandleArray> atoms).handles
+    for a in atoms:
+        handles.push_back(deref((<Atom> a).handle))
+    return handles
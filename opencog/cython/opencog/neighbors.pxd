@@ -13,3 +13,13 @@ cdef extern from "GetPredicates.h" namespace "opencog":
     #
     cdef vector[cHandle] c_get_predicates "get_predicates" (cHandle& target, Type t, bint subclass)
     cdef vector[cHandle] c_get_predicates_for "get_predicates_for" (cHandle& target, cHandle& predicate)
+
+cdef extern from "Neighbors.h" namespace "opencog":
+    cdef cppclass cNeighborBatch "opencog::NeighborBatch":
+        vector[size_t] offsets
+        vector[cHandle] neighbors
+        size_t size()
+
+    cdef cNeighborBatch c_get_target_neighbors_batch "get_target_neighbors_batch" (vector[cHandle]& atoms, Type t, bint subclass, unsigned num_threads)
+    cdef cNeighborBatch c_get_source_neighbors_batch "get_source_neighbors_batch" (vector[cHandle]& atoms, Type t, bint subclass, unsigned num_threads)
+    cdef cNeighborBatch c_get_all_neighbors_batch "get_all_neighbors_batch" (vector[cHandle]& atoms, Type t, unsigned num_threads)
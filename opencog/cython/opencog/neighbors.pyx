@@ -1,5 +1,6 @@
 
 from atomspace cimport *
+from opencog.handle_array cimport HandleArray, handles_of
 
 cdef class Neighbors:
     # Deprecated. Who uses this? Anyone? Is it useful for anyone?
@@ -23,3 +24,92 @@ cdef class Neighbors:
         handle_vector = c_get_predicates_for(deref(target.handle),
                                              deref(predicate.handle))
         return convert_handle_seq_to_python_list(handle_vector, self)
+
+    def get_predicates_array(self,
+                             Atom target,
+                             Type predicate_type = types.PredicateNode,
+                             subclasses=True):
+        """
+        As get_predicates, but as a HandleArray, making no Atom until
+        one is asked for.
+        """
+        cdef bint want_subclasses = subclasses
+        cdef vector[cHandle] handle_vector = c_get_predicates(
+            deref(target.handle), predicate_type, want_subclasses)
+        return HandleArray.wrap(handle_vector)
+
+    def get_predicates_for_array(self, Atom target, Atom predicate):
+        cdef vector[cHandle] handle_vector = c_get_predicates_for(
+            deref(target.handle), deref(predicate.handle))
+        return HandleArray.wrap(handle_vector)
+
+    def _convert_batch(self, cNeighborBatch& batch):
+        cdef size_t i, j
+        cdef vector[cHandle] handle_vector
+        result = []
+        for i in range(batch.size()):
+            handle_vector.clear()
+            for j in range(batch.offsets[i], batch.offsets[i + 1]):
+                handle_vector.push_back(batch.neighbors[j])
+            result.append(convert_handle_seq_to_python_list(handle_vector,
+                                                            self))
+        return result
+
+    def get_target_neighbors_batch(self, atoms, Type link_type,
+                                   subclasses=False, unsigned threads=1):
+        """
+        The target neighbors of each of the atoms, as a list of lists
+        in the same order, found in one call.
+        """
+        cdef vector[cHandle] handles = handles_of(atoms)
+        cdef bint want_subclasses = subclasses
+        cdef cNeighborBatch batch = c_get_target_neighbors_batch(
+            handles, link_type, want_subclasses, threads)
+        return self._convert_batch(batch)
+
+    def get_source_neighbors_batch(self, atoms, Type link_type,
+                                   subclasses=False, unsigned threads=1):
+        cdef vector[cHandle] handles = handles_of(atoms)
+        cdef bint want_subclasses = subclasses
+        cdef cNeighborBatch batch = c_get_source_neighbors_batch(
+            handles, link_type, want_subclasses, threads)
+        return self._convert_batch(batch)
+
+    def get_all_neighbors_batch(self, atoms, Type link_type,
+                                unsigned threads=1):
+        cdef vector[cHandle] handles = handles_of(atoms)
+        cdef cNeighborBatch batch = c_get_all_neighbors_batch(
+            handles, link_type, threads)
+        return self._convert_batch(batch)
+
+    # The bulk variants give the neighbors of all the atoms as one
+    # HandleArray, with the offsets of each atom's neighbors in it:
+    # those of atoms[i] are array[offsets[i]:offsets[i + 1]]. The atoms
+    # may be any sequence of Atoms, or a HandleArray.
+
+    def get_target_neighbors_bulk(self, atoms, Type link_type,
+                                  subclasses=False, unsigned threads=1):
+        """
+        The target neighbors of each of the atoms, as a pair of a
+        HandleArray and a list of offsets.
+        """
+        cdef vector[cHandle] handles = handles_of(atoms)
+        cdef bint want_subclasses = subclasses
+        cdef cNeighborBatch batch = c_get_target_neighbors_batch(
+            handles, link_type, want_subclasses, threads)
+        return HandleArray.wrap(batch.neighbors), batch.offsets
+
+    def get_source_neighbors_bulk(self, atoms, Type link_type,
+                                  subclasses=False, unsigned threads=1):
+        cdef vector[cHandle] handles = handles_of(atoms)
+        cdef bint want_subclasses = subclasses
+        cdef cNeighborBatch batch = c_get_source_neighbors_batch(
+            handles, link_type, want_subclasses, threads)
+        return HandleArray.wrap(batch.neighbors), batch.offsets
+
+    def get_all_neighbors_bulk(self, atoms, Type link_type,
+                               unsigned threads=1):
+        cdef vector[cHandle] handles = handles_of(atoms)
+        cdef cNeighborBatch batch = c_get_all_neighbors_batch(
+            handles, link_type, threads)
+        return HandleArray.wrap(batch.neighbors), batch.offsets
@@ -16,7 +16,7 @@ cdef extern from "opencog/openpsi/OpenPsiSCM.h" namespace "opencog":
         #  bool is_rule(const Handle& rule);
         bool c_is_rule "is_rule" (cHandle rule)
 
-        #  HandleSeq& get_context(const Handle& rule);
+        #  HandleSeq get_context(const Handle& rule);
         vector[cHandle] c_get_context "get_context" (cHandle rule)
 
         #  Handle get_action(const Handle& rule);
@@ -25,7 +25,7 @@ cdef extern from "opencog/openpsi/OpenPsiSCM.h" namespace "opencog":
         #  Handle get_goal(const Handle& rule);
         cHandle c_get_goal "get_goal" (cHandle rule)
 
-        #  HandleSeq& get_categories();
+        #  HandleSeq get_categories();
         vector[cHandle] c_get_categories "get_categories"()
 
         #  Handle add_category(const Handle& new_category);
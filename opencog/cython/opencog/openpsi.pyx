@@ -2,6 +2,7 @@ from libcpp cimport bool
 from libcpp.vector cimport vector
 from cython.operator cimport dereference as deref, preincrement as inc
 from opencog.atomspace cimport *
+from opencog.handle_array cimport HandleArray
 from opencog.scheme_wrapper import scheme_eval, scheme_eval_h, scheme_eval_v
 from opencog.type_constructors import ConceptNode
 
@@ -48,6 +49,11 @@ cdef class OpenPsi:
             inc(it)
         return list
 
+    def get_categories_array(self):
+        """As get_categories, but as a HandleArray."""
+        cdef vector[cHandle] res_handles = get_openpsi_scm().c_get_categories()
+        return HandleArray.wrap(res_handles)
+
     def add_category(self, Atom new_category):
         openPsi = get_openpsi_scm()
         cdef cHandle handle = openPsi.c_add_category(deref(new_category.handle))
@@ -115,6 +121,12 @@ cdef class OpenPsiRule:
             inc(it)
         return list
 
+    def get_context_array(self):
+        """As get_context, but as a HandleArray."""
+        cdef vector[cHandle] res_handles = \
+            get_openpsi_scm().c_get_context(deref(self.rule.handle))
+        return HandleArray.wrap(res_handles)
+
     def get_goal(self):
         openPsi = get_openpsi_scm()
         cdef cHandle handle = openPsi.c_get_goal(deref(self.rule.handle))
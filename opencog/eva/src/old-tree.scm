@@ -15,9 +15,11 @@
 ;    (behavior-tree-halt)
 ;
 ;; ------------------------------------------------------------------
-;; Main loop. Uses tail recursion optimization to form the loop.
+;; One step of the main loop. The scheduler evaluates it when one of the
+;; states it looks at changes, and at least once a second for the
+;; timers of the behaviors, such as falling asleep when bored.
 (DefineLink
-	(DefinedPredicate "main loop")
+	(DefinedPredicate "main step")
 	(SatisfactionLink
 		(SequentialAnd
 			(SequentialOr
@@ -86,7 +88,15 @@
 				    (DefinedPredicate "Keep alive"))
 
 				(True)
-			)
+			))))
+
+;; Main loop, for running without the scheduler. Uses tail recursion
+;; optimization to form the loop.
+(DefineLink
+	(DefinedPredicate "main loop")
+	(SatisfactionLink
+		(SequentialAnd
+			(DefinedPredicate "main step")
 
 			; If ROS is dead, or the continue flag not set, then stop
 			; running the behavior loop.
@@ -99,13 +109,35 @@
 
 ; ----------------------------------------------------------------------
 ;; Main loop control
+(use-modules (opencog openpsi))
+
 (define do-run-loop #t)
 
+; The main step is not evaluated more often than this, in msecs, as
+; what it does changes the states that it looks at; and at least this
+; often, for the timers.
+(define main-step-min-period 101)
+(define main-step-timeout 1000)
+
 (define-public (behavior-tree-run)
 "
  behavior-tree-run
 
- Run the Eva behavior tree main loop (in a new thread),
+ Run the Eva behavior tree (in a new thread), evaluating its main step
+ only when the states it looks at change, or when a timer may have run
+ out. Call (behavior-tree-halt) to stop it.
+"
+	(set! do-run-loop #t)
+	(psi-schedule (DefinedPredicate "main step")
+		main-step-timeout main-step-min-period)
+	(psi-scheduler-run))
+
+(define-public (behavior-tree-run-polling)
+"
+ behavior-tree-run-polling
+
+ Run the Eva behavior tree main loop (in a new thread), evaluating its
+ main step ten times a second whether or not anything changed.
  Call (behavior-tree-halt) to exit the loop.
 "
 	(set! do-run-loop #t)
@@ -116,9 +148,10 @@
 "
  behavior-tree-halt
 
- Tell the Eva behavior tree main loop thread to exit.
+ Stop the Eva behavior tree, however it was run.
 "
-	(set! do-run-loop #f))
+	(set! do-run-loop #f)
+	(psi-unschedule (DefinedPredicate "main step")))
 
 
 (define-public (behavior-tree-running?)
@@ -135,7 +168,7 @@
 
  Return the loop-count of the behavior tree.
 "
-	loop-count)
+	(+ loop-count (psi-schedule-runs (DefinedPredicate "main step"))))
 
 
 (define loop-count 0)
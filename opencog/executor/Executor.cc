@@ -0,0 +1,487 @@
+/*
+ * Executor.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/util/Logger.h>
+
+#include "Executor.h"
+
+using namespace opencog;
+
+struct Executor::Worker
+{
+    size_t index;
+    std::mutex mtx;
+    std::deque<Task> tasks;
+    std::thread thread;
+};
+
+/**
+ * One parallel_for(). Its helpers hold on to it, as those that have not
+ * started by the time the caller is done with its loop are not waited
+ * for; they do nothing once they do start.
+ */
+struct Executor::Group
+{
+    const std::function<void(size_t)>& body;
+    size_t n;
+    std::atomic<size_t> next;
+    std::atomic<bool> failed;
+
+    std::mutex mtx;
+    std::condition_variable done;
+    bool closed;        // the caller is done with its own loop
+    size_t running;     // helpers in loop()
+    std::exception_ptr error;
+
+    Group(const std::function<void(size_t)>& b, size_t n_) :
+        body(b), n(n_), next(0), failed(false), closed(false), running(0)
+    {}
+
+    void loop()
+    {
+        for (size_t i = next++; i < n and not failed; i = next++)
+        {
+            try
+            {
+                body(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lck(mtx);
+                if (not error) error = std::current_exception();
+                failed = true;
+            }
+        }
+    }
+
+    // Whether a helper starting now may join in; the body is gone once
+    // the caller has returned
+    bool join()
+    {
+        std::lock_guard<std::mutex> lck(mtx);
+        if (closed) return false;
+        running++;
+        return true;
+    }
+
+    void finish()
+    {
+        std::lock_guard<std::mutex> lck(mtx);
+        if (0 == --running) done.notify_all();
+    }
+};
+
+static void pin(size_t, bool, std::thread::native_handle_type);
+
+thread_local Executor* Executor::t_executor = nullptr;
+thread_local Executor::Worker* Executor::t_worker = nullptr;
+
+static size_t default_size()
+{
+    if (config().has("EXECUTOR_THREADS"))
+        return std::max(0, config().get_int("EXECUTOR_THREADS"));
+
+    size_t ncores = std::thread::hardware_concurrency();
+    return (1 < ncores) ? ncores - 1 : 1;
+}
+
+Executor& Executor::instance()
+{
+    static Executor executor;
+    static std::once_flag configured;
+    std::call_once(configured, [] {
+        if (config().has("EXECUTOR_AFFINITY"))
+            executor.set_affinity(config().get_bool("EXECUTOR_AFFINITY"));
+    });
+    return executor;
+}
+
+Executor::Executor(size_t n) :
+    m_queued(0),
+    m_stopping(false),
+    m_affinity(false),
+    m_executed(0),
+    m_stolen(0),
+    m_loops(0)
+{
+    start((0 < n) ? n : default_size());
+}
+
+Executor::~Executor()
+{
+    stop();
+
+    // Run what is left, so that no future is left unset
+    Task task;
+    while (take(task))
+        run(task);
+}
+
+size_t Executor::size() const
+{
+    std::shared_lock<std::shared_mutex> lck(m_workers_mtx);
+    return m_workers.size();
+}
+
+bool Executor::on_worker()
+{
+    return nullptr != t_worker;
+}
+
+void Executor::resize(size_t n)
+{
+    if (on_worker())
+        throw RuntimeException(TRACE_INFO,
+            "Executor: can't be resized from one of its tasks");
+
+    std::lock_guard<std::mutex> lck(m_resize_mtx);
+    stop();
+    start((0 < n) ? n : default_size());
+}
+
+void Executor::set_thread_init(const std::function<void()>& init)
+{
+    std::lock_guard<std::mutex> lck(m_resize_mtx);
+    m_thread_init = init;
+}
+
+void Executor::start(size_t n)
+{
+    {
+        std::lock_guard<std::mutex> lck(m_wake_mtx);
+        m_stopping = false;
+    }
+
+    std::unique_lock<std::shared_mutex> lck(m_workers_mtx);
+    for (size_t i = 0; i < n; i++)
+    {
+        m_workers.emplace_back(new Worker());
+        m_workers.back()->index = i;
+    }
+
+    // Start them once they are all there, as they steal from each other
+    for (auto& w : m_workers)
+        w->thread = std::thread(&Executor::work, this, w.get());
+}
+
+/**
+ * Stop the workers; the tasks still in their deques are moved to the
+ * shared queue, for the next workers, or for whoever waits on them.
+ */
+void Executor::stop()
+{
+    {
+        std::lock_guard<std::mutex> lck(m_wake_mtx);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    {
+        std::shared_lock<std::shared_mutex> lck(m_workers_mtx);
+        for (auto& w : m_workers)
+            w->thread.join();
+    }
+    {
+        std::unique_lock<std::shared_mutex> lck(m_workers_mtx);
+        workers.swap(m_workers);
+    }
+
+    std::lock_guard<std::mutex> lck(m_shared_mtx);
+    for (auto& w : workers)
+        for (Task& t : w->tasks)
+            m_shared.push_back(std::move(t));
+}
+
+void Executor::push(Task&& task)
+{
+    if (this == t_executor)
+    {
+        std::lock_guard<std::mutex> lck(t_worker->mtx);
+        t_worker->tasks.push_back(std::move(task));
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lck(m_shared_mtx);
+        m_shared.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lck(m_wake_mtx);
+        m_queued++;
+    }
+    m_wake.notify_one();
+}
+
+/**
+ * Take a task: from the back of the calling worker's own deque, else
+ * from the shared queue, else from the front of another worker's deque.
+ */
+bool Executor::take(Task& task)
+{
+    if (0 == m_queued) return false;
+
+    Worker* self = (this == t_executor) ? t_worker : nullptr;
+    if (self)
+    {
+        std::lock_guard<std::mutex> lck(self->mtx);
+        if (not self->tasks.empty())
+        {
+            task = std::move(self->tasks.back());
+            self->tasks.pop_back();
+            m_queued--;
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lck(m_shared_mtx);
+        if (not m_shared.empty())
+        {
+            task = std::move(m_shared.front());
+            m_shared.pop_front();
+            m_queued--;
+            return true;
+        }
+    }
+
+    std::shared_lock<std::shared_mutex> wlck(m_workers_mtx);
+    size_t n = m_workers.size();
+    size_t first = self ? self->index + 1 : 0;
+    for (size_t k = 0; k < n; k++)
+    {
+        Worker* victim = m_workers[(first + k) % n].get();
+        if (victim == self) continue;
+
+        std::lock_guard<std::mutex> lck(victim->mtx);
+        if (not victim->tasks.empty())
+        {
+            task = std::move(victim->tasks.front());
+            victim->tasks.pop_front();
+            m_queued--;
+            m_stolen++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Executor::run(Task& task)
+{
+    // The tasks queued here catch what they throw themselves; this is
+    // only for tasks that don't
+    try
+    {
+        task();
+    }
+    catch (const std::exception& ex)
+    {
+        logger().warn("Executor: a task threw: %s", ex.what());
+    }
+    catch (...)
+    {
+        logger().warn("Executor: a task threw");
+    }
+    task = nullptr;
+    m_executed++;
+}
+
+void Executor::work(Worker* self)
+{
+    t_executor = this;
+    t_worker = self;
+
+#ifdef __linux__
+    if (m_affinity) pin(self->index, true, pthread_self());
+#endif
+    if (m_thread_init) m_thread_init();
+
+    Task task;
+    while (true)
+    {
+        if (take(task))
+        {
+            run(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lck(m_wake_mtx);
+        if (m_stopping) break;
+        m_wake.wait(lck, [this] { return m_stopping or 0 < m_queued; });
+        if (m_stopping) break;
+    }
+
+    t_executor = nullptr;
+    t_worker = nullptr;
+}
+
+void Executor::parallel_for(size_t n, const std::function<void(size_t)>& body,
+                            size_t max_parallel)
+{
+    if (0 == n) return;
+
+    size_t nworkers = size();
+    if (0 == max_parallel or nworkers + 1 < max_parallel)
+        max_parallel = nworkers + 1;
+    size_t helpers = std::min(max_parallel, n) - 1;
+
+    m_loops++;
+
+    std::shared_ptr<Group> group(std::make_shared<Group>(body, n));
+    for (size_t h = 0; h < helpers; h++)
+        push([group]()
+        {
+            if (not group->join()) return;
+            group->loop();
+            group->finish();
+        });
+
+    group->loop();
+
+    // Every index has been taken by now, so only the helpers still in
+    // the loop are waited for. The caller runs no queued task while it
+    // waits, as it may be one of another loop, or a submitted one, and
+    // keep it for as long as that takes.
+    std::unique_lock<std::mutex> lck(group->mtx);
+    group->closed = true;
+    group->done.wait(lck, [&group] { return 0 == group->running; });
+
+    if (group->error)
+        std::rethrow_exception(group->error);
+}
+
+/**
+ * The cores the process may run on, in the order the workers are
+ * pinned: one from each NUMA node in turn.
+ */
+static std::vector<int> core_order()
+{
+    std::vector<int> order;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (0 != sched_getaffinity(0, sizeof(allowed), &allowed))
+        return order;
+
+    // The cores of each node, from e.g. "0-3,8-11"
+    std::map<int, std::vector<int>> nodes;
+    for (int node = 0; ; node++)
+    {
+        std::ifstream in("/sys/devices/system/node/node" +
+                         std::to_string(node) + "/cpulist");
+        if (not in) break;
+
+        std::string range;
+        while (std::getline(in, range, ','))
+        {
+            int lo = 0, hi = 0;
+            char dash;
+            std::istringstream rs(range);
+            if (not (rs >> lo)) continue;
+            hi = (rs >> dash >> hi) ? hi : lo;
+            for (int c = lo; c <= hi; c++)
+                if (c < CPU_SETSIZE and CPU_ISSET(c, &allowed))
+                    nodes[node].push_back(c);
+        }
+    }
+
+    // No NUMA information; all the cores are on one node
+    if (nodes.empty())
+        for (int c = 0; c < CPU_SETSIZE; c++)
+            if (CPU_ISSET(c, &allowed))
+                nodes[0].push_back(c);
+
+    for (size_t i = 0; ; i++)
+    {
+        bool any = false;
+        for (auto& n : nodes)
+        {
+            if (i >= n.second.size()) continue;
+            order.push_back(n.second[i]);
+            any = true;
+        }
+        if (not any) break;
+    }
+#endif
+    return order;
+}
+
+/**
+ * Pin the thread of the index-th worker to its core, or, if off, let
+ * it run on any of them again.
+ */
+static void pin(size_t index, bool on, std::thread::native_handle_type th)
+{
+#ifdef __linux__
+    static const std::vector<int> order = core_order();
+    if (order.empty()) return;
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (on)
+    {
+        CPU_SET(order[index % order.size()], &cpus);
+    }
+    else
+    {
+        for (int c : order)
+            CPU_SET(c, &cpus);
+    }
+    pthread_setaffinity_np(th, sizeof(cpus), &cpus);
+#endif
+}
+
+void Executor::set_affinity(bool on)
+{
+    std::lock_guard<std::mutex> lck(m_resize_mtx);
+    if (on == m_affinity) return;
+    m_affinity = on;
+
+    std::shared_lock<std::shared_mutex> wlck(m_workers_mtx);
+    for (auto& w : m_workers)
+        pin(w->index, on, w->thread.native_handle());
+}
+
+std::string Executor::stats_string() const
+{
+    size_t nworkers = size();
+    return "((threads . " + std::to_string(nworkers) + ")"
+        " (affinity . " + (m_affinity ? "#t" : "#f") + ")"
+        " (queued . " + std::to_string(m_queued) + ")"
+        " (executed . " + std::to_string(m_executed) + ")"
+        " (stolen . " + std::to_string(m_stolen) + ")"
+        " (parallel-loops . " + std::to_string(m_loops) + "))";
+}
+
+/* ============================== END OF FILE ====================== */
@@ -0,0 +1,184 @@
+/*
+ * Executor.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_EXECUTOR_H
+#define _OPENCOG_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opencog
+{
+
+/**
+ * A pool of worker threads, shared by everything in the process that
+ * does work in parallel, so that several parallel features running at
+ * once share the cores instead of each starting threads of its own.
+ *
+ * Each worker has a deque of tasks. Tasks queued from a worker go to
+ * the back of its own deque, and it takes them from the back, newest
+ * first; tasks queued from any other thread go to a shared queue. A
+ * worker with nothing to do takes from the shared queue, and then
+ * steals from the front of the other workers' deques.
+ *
+ * parallel_for() may be called from within a task. The calling thread
+ * takes part in the loop, and only waits for the helpers that are in
+ * it by the time it runs out of indices; those still queued then do
+ * nothing. So a nested loop can neither deadlock the pool nor start
+ * more threads, and the caller never runs a task of anyone else's.
+ *
+ * The pool is for short tasks that keep a core busy. Work that blocks,
+ * on the network, a lock or a slow parser, takes a worker away from
+ * every parallel loop for as long as it blocks; it goes on a Lane.
+ *
+ * The workers live as long as the pool, or until it is resized, so
+ * what a thread sets up once, e.g. its own SchemeEval, is reused by
+ * all the tasks it runs.
+ */
+class Executor
+{
+public:
+    typedef std::function<void()> Task;
+
+    /**
+     * The pool of the process. Its size is the config value
+     * EXECUTOR_THREADS, if it is set when the pool is first used, and
+     * else one less than the no. of cores, as the calling thread works
+     * too; EXECUTOR_AFFINITY turns on set_affinity().
+     */
+    static Executor& instance();
+
+    /// A pool of n workers; 0 for the default size of instance().
+    explicit Executor(size_t n = 0);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /// The no. of worker threads.
+    size_t size() const;
+
+    /**
+     * Use n workers, 0 for the default size. The workers finish the
+     * task they are running and are replaced; queued tasks are kept.
+     * Throws if called from a task.
+     */
+    void resize(size_t n);
+
+    /**
+     * Pin each worker to a core, spreading them over the NUMA nodes
+     * first, and then over the cores of each node; only the cores the
+     * process may run on are used. Off by default.
+     */
+    void set_affinity(bool);
+    bool affinity() const { return m_affinity; }
+
+    /**
+     * Run this in each worker thread when it starts, e.g. to put it
+     * into guile mode; it applies to the workers started after it is
+     * set, so it should be followed by a resize().
+     */
+    void set_thread_init(const std::function<void()>&);
+
+    /// Whether the calling thread is a worker of some pool.
+    static bool on_worker();
+
+    /**
+     * Call body(i) for each i in [0, n), in parallel, and return once
+     * all calls have returned. At most max_parallel calls run at once,
+     * the calling thread's included; 0 means size() + 1.
+     *
+     * If a call throws, the calls that haven't started are skipped,
+     * and the first exception is rethrown here.
+     */
+    void parallel_for(size_t n, const std::function<void(size_t)>& body,
+                      size_t max_parallel = 0);
+
+    /**
+     * Queue a task, and return the future of its result. With no
+     * workers, it is run right away, in the calling thread, so that
+     * the task must not block; see Lane for those that do.
+     */
+    template<typename F>
+    auto submit(F&& f) -> std::future<decltype(f())>
+    {
+        typedef decltype(f()) R;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+        std::future<R> result = task->get_future();
+        if (0 == size())
+            (*task)();
+        else
+            push([task]() { (*task)(); });
+        return result;
+    }
+
+    /// The workers, queued tasks and counts so far, as an association
+    /// list, for scheme.
+    std::string stats_string() const;
+
+private:
+    struct Worker;
+    struct Group;
+
+    void start(size_t n);
+    void stop();
+    void push(Task&&);
+    bool take(Task&);
+    void run(Task&);
+    void work(Worker*);
+
+    // The pool and worker of the calling thread, if it is a worker
+    static thread_local Executor* t_executor;
+    static thread_local Worker* t_worker;
+
+    mutable std::shared_mutex m_workers_mtx;   // for m_workers
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::mutex m_resize_mtx;
+
+    std::mutex m_shared_mtx;
+    std::deque<Task> m_shared;   // tasks queued from outside the pool
+
+    // The workers sleep on m_wake while m_queued is 0
+    std::mutex m_wake_mtx;
+    std::condition_variable m_wake;
+    std::atomic<size_t> m_queued;
+    bool m_stopping;
+
+    std::atomic<bool> m_affinity;
+    std::function<void()> m_thread_init;
+
+    std::atomic<uint64_t> m_executed;
+    std::atomic<uint64_t> m_stolen;
+    std::atomic<uint64_t> m_loops;
+};
+
+}
+
+#endif // _OPENCOG_EXECUTOR_H
@@ -0,0 +1,108 @@
+/*
+ * ExecutorSCM.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/guile/SchemePrimitive.h>
+
+#include "Executor.h"
+
+namespace opencog
+{
+
+/**
+ * Looking at and resizing the shared pool of worker threads from scheme.
+ */
+class ExecutorSCM
+{
+private:
+    static void* init_in_guile(void*);
+    static void init_in_module(void*);
+    void init(void);
+
+    int size(void) { return Executor::instance().size(); }
+    void resize(int);
+    bool affinity(void) { return Executor::instance().affinity(); }
+    void set_affinity(bool on) { Executor::instance().set_affinity(on); }
+    std::string stats(void) { return Executor::instance().stats_string(); }
+
+public:
+    ExecutorSCM();
+};
+
+}
+
+using namespace opencog;
+
+ExecutorSCM::ExecutorSCM()
+{
+    static bool is_init = false;
+    if (is_init) return;
+    is_init = true;
+    scm_with_guile(init_in_guile, this);
+}
+
+void* ExecutorSCM::init_in_guile(void* self)
+{
+    scm_c_define_module("opencog executor", init_in_module, self);
+    scm_c_use_module("opencog executor");
+    return NULL;
+}
+
+void ExecutorSCM::init_in_module(void* data)
+{
+    ExecutorSCM* self = (ExecutorSCM*) data;
+    self->init();
+}
+
+static void* no_op(void*) { return NULL; }
+
+void ExecutorSCM::init()
+{
+    define_scheme_primitive("executor-size", &ExecutorSCM::size, this, "executor");
+    define_scheme_primitive("executor-resize", &ExecutorSCM::resize, this, "executor");
+    define_scheme_primitive("executor-affinity?", &ExecutorSCM::affinity, this, "executor");
+    define_scheme_primitive("executor-set-affinity", &ExecutorSCM::set_affinity, this, "executor");
+    define_scheme_primitive("executor-stats-string", &ExecutorSCM::stats, this, "executor");
+
+    // Make the workers known to guile when they start, so that the
+    // tasks that go into scheme don't each have the thread registered
+    // with it; the ones already running are restarted for it.
+    Executor& executor = Executor::instance();
+    executor.set_thread_init([] { scm_with_guile(no_op, NULL); });
+    executor.resize(executor.size());
+}
+
+void ExecutorSCM::resize(int n)
+{
+    if (n < 0)
+        throw InvalidParamException(TRACE_INFO,
+            "executor-resize: Expecting a non-negative no. of threads, got %d",
+            n);
+    Executor::instance().resize(n);
+}
+
+extern "C" {
+void opencog_executor_init(void);
+};
+
+void opencog_executor_init(void)
+{
+    static ExecutorSCM executor;
+}
@@ -0,0 +1,95 @@
+/*
+ * Lane.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include <opencog/util/Logger.h>
+
+#include "Lane.h"
+
+using namespace opencog;
+
+Lane::Lane(const std::string& name, size_t n) :
+    m_name(name),
+    m_stopping(false)
+{
+    n = std::max<size_t>(n, 1);
+    for (size_t i = 0; i < n; i++)
+        m_threads.emplace_back(&Lane::work, this);
+}
+
+Lane::~Lane()
+{
+    {
+        std::lock_guard<std::mutex> lck(m_mtx);
+        m_stopping = true;
+        m_tasks.clear();
+    }
+    m_wake.notify_all();
+
+    for (std::thread& t : m_threads)
+        t.join();
+}
+
+size_t Lane::queued() const
+{
+    std::lock_guard<std::mutex> lck(m_mtx);
+    return m_tasks.size();
+}
+
+void Lane::push(Task&& task)
+{
+    {
+        std::lock_guard<std::mutex> lck(m_mtx);
+        m_tasks.push_back(std::move(task));
+    }
+    m_wake.notify_one();
+}
+
+void Lane::work()
+{
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lck(m_mtx);
+            m_wake.wait(lck, [this] { return m_stopping or not m_tasks.empty(); });
+            if (m_stopping) return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        // The tasks queued here catch what they throw themselves; this
+        // is only for tasks that don't
+        try
+        {
+            task();
+        }
+        catch (const std::exception& ex)
+        {
+            logger().warn("Lane %s: a task threw: %s", m_name.c_str(), ex.what());
+        }
+        catch (...)
+        {
+            logger().warn("Lane %s: a task threw", m_name.c_str());
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ * Lane.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LANE_H
+#define _OPENCOG_LANE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opencog
+{
+
+/**
+ * A few threads of their own, for tasks that block, e.g. on the network
+ * or on a slow parser, which would take the workers of the Executor
+ * away from its parallel loops.
+ *
+ * The tasks are run in the order they are queued, by the threads of
+ * the lane only: never in the thread that queues them, nor in one that
+ * waits on something else, so that a thread queueing one never waits
+ * on what the task waits on.
+ */
+class Lane
+{
+public:
+    typedef std::function<void()> Task;
+
+    /// A lane of n threads, at least one, named for the logs.
+    Lane(const std::string& name, size_t n);
+
+    /// Waits for the running tasks; the queued ones are dropped, their
+    /// futures getting a broken_promise.
+    ~Lane();
+
+    Lane(const Lane&) = delete;
+    Lane& operator=(const Lane&) = delete;
+
+    /// Queue a task, and return the future of its result.
+    template<typename F>
+    auto submit(F&& f) -> std::future<decltype(f())>
+    {
+        typedef decltype(f()) R;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+        std::future<R> result = task->get_future();
+        push([task]() { (*task)(); });
+        return result;
+    }
+
+    size_t size() const { return m_threads.size(); }
+
+    /// The no. of tasks queued and not started.
+    size_t queued() const;
+
+    const std::string& name() const { return m_name; }
+
+private:
+    void push(Task&&);
+    void work();
+
+    std::string m_name;
+    std::vector<std::thread> m_threads;
+
+    mutable std::mutex m_mtx;
+    std::condition_variable m_wake;
+    std::deque<Task> m_tasks;
+    bool m_stopping;
+};
+
+}
+
+#endif // _OPENCOG_LANE_H
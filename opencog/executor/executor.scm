@@ -0,0 +1,24 @@
+;
+; executor.scm
+;
+; The pool of worker threads shared by the parallel parts of the NLP
+; pipeline and OpenPsi; see README.md.
+;
+(define-module (opencog executor))
+
+(use-modules (opencog) (opencog oc-config))
+
+(load-extension (string-append opencog-ext-path-executor "libexecutor-scm") "opencog_executor_init")
+
+(set-procedure-property! executor-resize 'documentation
+"
+  executor-resize N
+
+  Use N worker threads, or the default number, one less than the no.
+  of cores, if N is 0. The workers finish what they are doing first.
+
+  Example:
+     (executor-size)                ; => 7
+     (executor-resize 3)
+     (executor-stats-string)
+")
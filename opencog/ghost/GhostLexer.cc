@@ -0,0 +1,484 @@
+/*
+ * GhostLexer.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+#include <sstream>
+
+#include "GhostLexer.h"
+
+using namespace opencog;
+
+// The right single quotation mark, U+2019
+static const char* RSQUO = "\xE2\x80\x99";
+
+static bool is_alpha(char c)
+{
+    return ('a' <= c and c <= 'z') or ('A' <= c and c <= 'Z');
+}
+
+static bool is_digit(char c)
+{
+    return '0' <= c and c <= '9';
+}
+
+static bool is_blank(char c)
+{
+    return ' ' == c or '\t' == c;
+}
+
+static size_t span(const std::string& s, size_t i, bool (*in)(char))
+{
+    size_t j = i;
+    while (j < s.size() and in(s[j])) j++;
+    return j - i;
+}
+
+static size_t literal(const std::string& s, size_t i, const char* l)
+{
+    size_t n = strlen(l);
+    return (0 == s.compare(i, n, l)) ? n : 0;
+}
+
+// The length of the apostrophe at i, ' or ’, if there is one
+static size_t apostrophe(const std::string& s, size_t i)
+{
+    if (i < s.size() and '\'' == s[i]) return 1;
+    return literal(s, i, RSQUO);
+}
+
+/**
+ * Whether the character at i is one of a word, for \b: a letter, a
+ * digit or '_', or a character other than ASCII that isn't punctuation
+ * of the U+2000 block, such as ’.
+ */
+static bool is_word_at(const std::string& s, size_t i)
+{
+    if (i >= s.size()) return false;
+    unsigned char c = s[i];
+    if (c < 0x80) return is_alpha(c) or is_digit(c) or '_' == c;
+
+    // U+2000 to U+206F are E2 80 80 to E2 81 AF
+    return not (0xE2 == c and i + 1 < s.size() and
+                (0x80 == (unsigned char) s[i+1] or
+                 0x81 == (unsigned char) s[i+1]));
+}
+
+/**
+ * The longest of the first n characters from i that is followed by a
+ * word boundary, for the patterns that end with \b.
+ */
+static size_t to_boundary(const std::string& s, size_t i, size_t n,
+                          size_t least)
+{
+    for (; n >= least and 0 < n; n--)
+        if (is_word_at(s, i + n - 1) != is_word_at(s, i + n))
+            return n;
+    return 0;
+}
+
+// ------------------------------------------------------------------
+// The patterns that aren't plain strings; each returns how much of the
+// line from i it takes, 0 if it doesn't match.
+
+static bool is_reactive(char c)
+{
+    return 'r' == c or 's' == c or '?' == c or 'u' == c;
+}
+
+static bool is_old_rejoinder(char c)
+{
+    return 'a' <= c and c <= 'e';
+}
+
+static bool is_proactive(char c)
+{
+    return 'p' == c or 't' == c;
+}
+
+static bool is_uvar(char c)
+{
+    return is_alpha(c) or is_digit(c) or '_' == c or '-' == c;
+}
+
+static bool is_dictkey(char c)
+{
+    return is_alpha(c) or ('1' <= c and c <= '9');
+}
+
+static bool is_id(char c)
+{
+    return is_alpha(c) or is_digit(c) or '_' == c;
+}
+
+static bool is_word(char c)
+{
+    return is_alpha(c) or '-' == c;
+}
+
+static bool is_number(char c)
+{
+    return is_digit(c) or '.' == c;
+}
+
+static bool is_string(char c)
+{
+    return is_alpha(c) or is_digit(c) or
+           ('\0' != c and nullptr != strchr("~'._!?-", c));
+}
+
+// [rs?u]:  [a-e]:  [pt]:
+template<bool (*in)(char)>
+static size_t rule_type(const std::string& s, size_t i)
+{
+    return (i + 1 < s.size() and in(s[i]) and ':' == s[i+1]) ? 2 : 0;
+}
+
+// j[0-9]+:
+static size_t rejoinder(const std::string& s, size_t i)
+{
+    if (0 == literal(s, i, "j")) return 0;
+    size_t n = span(s, i + 1, is_digit);
+    return (0 < n and 0 < literal(s, i + 1 + n, ":")) ? n + 2 : 0;
+}
+
+// [{][%] set delay=[0-9]+ [%][}]
+static size_t set_delay(const std::string& s, size_t i)
+{
+    size_t n = literal(s, i, "{% set delay=");
+    if (0 == n) return 0;
+    size_t d = span(s, i + n, is_digit);
+    if (0 == d) return 0;
+    size_t e = literal(s, i + n + d, " %}");
+    return (0 < e) ? n + d + e : 0;
+}
+
+// _[0-9]
+static size_t mvar(const std::string& s, size_t i)
+{
+    return (0 < literal(s, i, "_") and i + 1 < s.size() and
+            is_digit(s[i+1])) ? 2 : 0;
+}
+
+// '_[0-9]
+static size_t movar(const std::string& s, size_t i)
+{
+    return (0 < literal(s, i, "'")) ? (mvar(s, i + 1) ? 3 : 0) : 0;
+}
+
+// A prefix and one or more characters of a kind after it
+template<char prefix, bool (*in)(char)>
+static size_t prefixed(const std::string& s, size_t i)
+{
+    if (i >= s.size() or prefix != s[i]) return 0;
+    size_t n = span(s, i + 1, in);
+    return (0 < n) ? n + 1 : 0;
+}
+
+// [a-zA-Z]+~[a-zA-Z1-9]+
+static size_t dictkey(const std::string& s, size_t i)
+{
+    size_t n = span(s, i, is_alpha);
+    if (0 == n or 0 == literal(s, i + n, "~")) return 0;
+    size_t k = span(s, i + n + 1, is_dictkey);
+    return (0 < k) ? n + 1 + k : 0;
+}
+
+// \*~[0-9]+
+static size_t range_wildcard(const std::string& s, size_t i)
+{
+    if (0 == literal(s, i, "*~")) return 0;
+    size_t n = span(s, i + 2, is_digit);
+    return (0 < n) ? n + 2 : 0;
+}
+
+// <[ ]*\*
+static size_t restart(const std::string& s, size_t i)
+{
+    if (0 == literal(s, i, "<")) return 0;
+    size_t j = i + 1;
+    while (j < s.size() and ' ' == s[j]) j++;
+    return (0 < literal(s, j, "*")) ? j + 1 - i : 0;
+}
+
+// [ap]\.m\.
+static size_t time_of_day(const std::string& s, size_t i)
+{
+    if (i >= s.size() or ('a' != s[i] and 'p' != s[i])) return 0;
+    return (0 < literal(s, i + 1, ".m.")) ? 4 : 0;
+}
+
+// [a-zA-Z]+['’][a-zA-Z]+
+static size_t literal_apos(const std::string& s, size_t i)
+{
+    size_t n = span(s, i, is_alpha);
+    if (0 == n) return 0;
+    size_t a = apostrophe(s, i + n);
+    if (0 == a) return 0;
+    size_t m = span(s, i + n + a, is_alpha);
+    return (0 < m) ? n + a + m : 0;
+}
+
+// [a-zA-Z]+\.
+static size_t abbreviation(const std::string& s, size_t i)
+{
+    size_t n = span(s, i, is_alpha);
+    return (0 < n and 0 < literal(s, i + n, ".")) ? n + 1 : 0;
+}
+
+// '[a-zA-Z]+\b
+static size_t quoted_word(const std::string& s, size_t i)
+{
+    if (0 == literal(s, i, "'")) return 0;
+    size_t n = span(s, i + 1, is_alpha);
+    if (0 == n) return 0;
+    return to_boundary(s, i, n + 1, 2);
+}
+
+// [a-zA-Z-]+\b
+static size_t word(const std::string& s, size_t i)
+{
+    return to_boundary(s, i, span(s, i, is_word), 1);
+}
+
+// [0-9]+[0-9.]*\b
+static size_t number(const std::string& s, size_t i)
+{
+    if (i >= s.size() or not is_digit(s[i])) return 0;
+    return to_boundary(s, i, span(s, i, is_number), 1);
+}
+
+// [~’'._!?0-9a-zA-Z-]+
+static size_t any_string(const std::string& s, size_t i)
+{
+    size_t j = i;
+    while (j < s.size())
+    {
+        if (is_string(s[j])) j++;
+        else if (literal(s, j, RSQUO)) j += 3;
+        else break;
+    }
+    return j - i;
+}
+
+// ------------------------------------------------------------------
+
+namespace {
+
+enum Action
+{
+    NO_VALUE,       // the value is #f
+    VALUE,          // the value is what was matched, less skip and drop
+    REST_OF_LINE,   // no value, and the rest of the line is skipped
+    COMMAND_PAIR    // the command and the argument of a DICTKEY
+};
+
+struct Pattern
+{
+    const char* category;
+    const char* text;       // if not null, the pattern is just this text
+    size_t (*match)(const std::string&, size_t);
+    Action action;
+    size_t skip;            // the no. of chars left out in front
+    size_t drop;            // and at the end
+};
+
+}
+
+// In the order they are tried, from the most specific to the broadest;
+// an empty line is a NEWLINE, tried after the CR
+static const Pattern patterns[] =
+{
+    {"LPAREN", "(", nullptr, NO_VALUE, 0, 0},
+    {"RPAREN", ")", nullptr, NO_VALUE, 0, 0},
+    {"CONCEPT", "concept:", nullptr, NO_VALUE, 0, 0},
+    {"CR", "\r", nullptr, VALUE, 0, 1},
+    {"URGE", "urge:", nullptr, NO_VALUE, 0, 0},
+    {"ORD-GOAL", "ordered-goal:", nullptr, NO_VALUE, 0, 0},
+    {"GOAL", "goal:", nullptr, NO_VALUE, 0, 0},
+    {"RGOAL", "#goal:", nullptr, NO_VALUE, 0, 0},
+    {"PARALLEL-RULES", "parallel-rules:", nullptr, NO_VALUE, 0, 0},
+    {"LINK-CONCEPT", "link-concept:", nullptr, NO_VALUE, 0, 0},
+    {"RLINK-CONCEPT", "#link-concept:", nullptr, NO_VALUE, 0, 0},
+    {"GLOBAL-DEFAULT-RULE", "global-default-rule:", nullptr, NO_VALUE, 0, 0},
+    {"SAMPLE_INPUT", "#!", nullptr, REST_OF_LINE, 0, 0},
+    {"COMMENT", "#", nullptr, REST_OF_LINE, 0, 0},
+    {"REACTIVE-RULE", nullptr, rule_type<is_reactive>, VALUE, 0, 1},
+    {"REJOINDER", nullptr, rejoinder, VALUE, 0, 1},
+    {"REJOINDER", nullptr, rule_type<is_old_rejoinder>, VALUE, 0, 1},
+    {"PROACTIVE-RULE", nullptr, rule_type<is_proactive>, VALUE, 0, 1},
+    {"SET_DELAY", nullptr, set_delay, VALUE, 0, 0},
+    {"MVAR", nullptr, mvar, VALUE, 1, 0},
+    {"MOVAR", nullptr, movar, VALUE, 2, 0},
+    {"UVAR", nullptr, prefixed<'$', is_uvar>, VALUE, 1, 0},
+    {"VAR", "_", nullptr, NO_VALUE, 0, 0},
+    {"DICTKEY", nullptr, dictkey, COMMAND_PAIR, 0, 0},
+    {"*~n", nullptr, range_wildcard, VALUE, 2, 0},
+    {"ID", nullptr, prefixed<'~', is_id>, VALUE, 1, 0},
+    {"^", "^", nullptr, NO_VALUE, 0, 0},
+    {"LSBRACKET", "[", nullptr, NO_VALUE, 0, 0},
+    {"RSBRACKET", "]", nullptr, NO_VALUE, 0, 0},
+    {"LBRACE", "{", nullptr, NO_VALUE, 0, 0},
+    {"RBRACE", "}", nullptr, NO_VALUE, 0, 0},
+    {"<<", "<<", nullptr, NO_VALUE, 0, 0},
+    {">>", ">>", nullptr, NO_VALUE, 0, 0},
+    {"RESTART", nullptr, restart, NO_VALUE, 0, 0},
+    {"<", "<", nullptr, NO_VALUE, 0, 0},
+    {">", ">", nullptr, NO_VALUE, 0, 0},
+    {"DQUOTE", "\"", nullptr, VALUE, 0, 0},
+    {"*n", nullptr, prefixed<'*', is_digit>, VALUE, 1, 0},
+    {"*", "*", nullptr, VALUE, 0, 0},
+    {"NOT", "!", nullptr, NO_VALUE, 0, 0},
+    {"?", "?", nullptr, VALUE, 0, 0},
+    {"EQUAL", "=", nullptr, NO_VALUE, 0, 0},
+    {"STRING", nullptr, time_of_day, VALUE, 0, 0},
+    {"LITERAL_APOS", nullptr, literal_apos, VALUE, 0, 0},
+    {"LITERAL", nullptr, abbreviation, VALUE, 0, 0},
+    {"LITERAL", nullptr, quoted_word, VALUE, 1, 0},
+    {"WORD", nullptr, word, VALUE, 0, 0},
+    {"NUM", nullptr, number, VALUE, 0, 0},
+    {"VLINE", "|", nullptr, VALUE, 0, 0},
+    {"COMMA", ",", nullptr, VALUE, 0, 0},
+    {"STRING", nullptr, any_string, VALUE, 0, 0},
+};
+
+// The no. of characters, rather than bytes, before i
+static size_t column_of(const std::string& s, size_t i)
+{
+    size_t col = 0;
+    for (size_t j = 0; j < i; j++)
+        if (0x80 != ((unsigned char) s[j] & 0xC0)) col++;
+    return col;
+}
+
+std::vector<GhostToken> GhostLexer::tokenize(const std::string& line)
+{
+    std::vector<GhostToken> tokens;
+
+    if (line.empty())
+    {
+        tokens.push_back({"NEWLINE", GhostToken::NONE, "", "", 0});
+        return tokens;
+    }
+
+    size_t pos = 0;
+    while (pos < line.size())
+    {
+        // Where the rest of the line is first found, as the scheme
+        // lexer used to give it
+        GhostToken tok;
+        tok.column = column_of(line, line.find(line.substr(pos)));
+        tok.kind = GhostToken::NONE;
+
+        size_t start = pos + span(line, pos, is_blank);
+
+        const Pattern* pat = nullptr;
+        size_t len = 0;
+        for (const Pattern& p : patterns)
+        {
+            len = p.text ? literal(line, start, p.text) : p.match(line, start);
+            if (0 < len) { pat = &p; break; }
+        }
+
+        if (nullptr == pat)
+        {
+            tok.category = "NotDefined";
+            tok.kind = GhostToken::STRING;
+            tok.value = line.substr(pos);
+            tokens.push_back(std::move(tok));
+            break;
+        }
+
+        size_t end = start + len;
+        size_t next = end + span(line, end, is_blank);
+        tok.category = pat->category;
+
+        switch (pat->action)
+        {
+        case NO_VALUE:
+            break;
+        case VALUE:
+            tok.kind = GhostToken::STRING;
+            tok.value = line.substr(start + pat->skip,
+                                    len - pat->skip - pat->drop);
+            break;
+        case REST_OF_LINE:
+            next = line.size();
+            break;
+        case COMMAND_PAIR:
+        {
+            // What follows the "~", with the blanks after it, and the
+            // word before it
+            size_t tilde = line.find('~', start);
+            tok.kind = GhostToken::PAIR;
+            tok.value = line.substr(tilde + 1, next - tilde - 1);
+            tok.second = line.substr(start, tilde - start);
+            break;
+        }
+        }
+
+        tokens.push_back(std::move(tok));
+        pos = next;
+    }
+
+    return tokens;
+}
+
+static void write_string(std::ostream& out, const std::string& s)
+{
+    out << '"';
+    for (char c : s)
+    {
+        if ('"' == c or '\\' == c) out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+
+std::string GhostLexer::tokenize_scheme(const std::string& line)
+{
+    std::stringstream ss;
+    ss << "(";
+    const char* sep = "";
+    for (const GhostToken& tok : tokenize(line))
+    {
+        ss << sep << "(" << tok.category << " ";
+        sep = " ";
+        switch (tok.kind)
+        {
+        case GhostToken::NONE:
+            ss << "#f";
+            break;
+        case GhostToken::STRING:
+            write_string(ss, tok.value);
+            break;
+        case GhostToken::PAIR:
+            ss << "(";
+            write_string(ss, tok.value);
+            ss << " . ";
+            write_string(ss, tok.second);
+            ss << ")";
+            break;
+        }
+        ss << " " << tok.column << ")";
+    }
+    ss << ")";
+    return ss.str();
+}
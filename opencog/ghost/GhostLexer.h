@@ -0,0 +1,84 @@
+/*
+ * GhostLexer.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_GHOST_LEXER_H
+#define _OPENCOG_GHOST_LEXER_H
+
+#include <string>
+#include <vector>
+
+namespace opencog
+{
+
+/**
+ * A token of a line of a GHOST rule file.
+ */
+struct GhostToken
+{
+    enum ValueKind { NONE, STRING, PAIR };
+
+    // The category, as the grammar in cs-parse.scm names it, except
+    // that a plain word is a WORD, as only the scheme side can tell a
+    // LEMMA from a LITERAL
+    std::string category;
+
+    // No value (#f), a string, or a pair of them, as for a DICTKEY,
+    // whose value is the command and the argument
+    ValueKind kind;
+    std::string value;
+    std::string second;
+
+    // The character the rest of the line is first found at
+    size_t column;
+};
+
+/**
+ * The tokenizer of the GHOST parser, which used to be a chain of regexes
+ * in cs-parse.scm that were compiled again for each token. The patterns
+ * are tried in the same order, each after any spaces and tabs, and take
+ * the spaces and tabs after them too, as they did:
+ *
+ *  - an empty line is a NEWLINE;
+ *  - a line starting with "#!" is a SAMPLE_INPUT, and any other one
+ *    starting with "#" that isn't a declaration is a COMMENT; the rest
+ *    of the line is skipped;
+ *  - text that no pattern takes is a NotDefined, with the rest of the
+ *    line as its value.
+ *
+ * Lines are made of UTF-8; the only character other than ASCII that is
+ * part of a pattern is the right single quotation mark, as in "I’m".
+ */
+class GhostLexer
+{
+public:
+    /// The tokens of a line, without its end of line.
+    static std::vector<GhostToken> tokenize(const std::string& line);
+
+    /**
+     * The tokens of a line as a scheme list of (category value column),
+     * for the lexer in cs-parse.scm to read.
+     */
+    static std::string tokenize_scheme(const std::string& line);
+};
+
+}
+
+#endif // _OPENCOG_GHOST_LEXER_H
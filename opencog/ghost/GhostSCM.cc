@@ -0,0 +1,85 @@
+/*
+ * GhostSCM.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/guile/SchemePrimitive.h>
+
+#include "GhostLexer.h"
+
+namespace opencog
+{
+
+/**
+ * The scheme bindings of the native parts of the GHOST parser.
+ */
+class GhostSCM
+{
+private:
+    static void* init_in_guile(void*);
+    static void init_in_module(void*);
+    void init(void);
+
+    std::string tokenize(const std::string& line)
+    {
+        return GhostLexer::tokenize_scheme(line);
+    }
+
+public:
+    GhostSCM();
+};
+
+}
+
+using namespace opencog;
+
+GhostSCM::GhostSCM()
+{
+    static bool is_init = false;
+    if (is_init) return;
+    is_init = true;
+    scm_with_guile(init_in_guile, this);
+}
+
+void* GhostSCM::init_in_guile(void* self)
+{
+    scm_c_define_module("opencog ghost", init_in_module, self);
+    scm_c_use_module("opencog ghost");
+    return NULL;
+}
+
+void GhostSCM::init_in_module(void* data)
+{
+    GhostSCM* self = (GhostSCM*) data;
+    self->init();
+}
+
+void GhostSCM::init()
+{
+    define_scheme_primitive("ghost-tokenize-line", &GhostSCM::tokenize, this, "ghost");
+}
+
+extern "C" {
+void opencog_ghost_init(void);
+};
+
+void opencog_ghost_init(void)
+{
+    static GhostSCM ghost;
+}
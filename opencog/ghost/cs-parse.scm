@@ -35,207 +35,44 @@
   )
 )
 
-(define (tokeniz str location)
-  (define current-match '())
-  (define (has-match? pattern str)
-    (let ((match
-            (string-match
-              (string-append "^[ \t]*" pattern "[ \t]*") str)))
-      (if match
-        (begin (set! current-match match) #t)
-        #f
-      )))
-
-  (define (result:suffix token location value)
-    ; Returns a lexical-token
-    (cons
-      (make-lexical-token token location value)
-      (match:suffix current-match)))
-
-  (define (command-pair)
-    ; Return command string.
-    (let ((match (string-match "~" (match:substring current-match))))
-      ; The suffix is the command and the prefix is the argument
-      (cons (match:suffix match) (string-trim-both (match:prefix match)))
-    ))
-
-  ; NOTE
-  ; 1. The matching must be done starting from the most specific to the
-  ;    the broadest regex patterns.
-  ; 2. #f is given as a token value for those cases which don't have any
-  ;    semantic values.
-  (cond
-    ((has-match? "\\(" str) (result:suffix 'LPAREN location #f))
-    ((has-match? "\\)" str) (result:suffix 'RPAREN location #f))
-    ; Chatscript declarations
-    ((has-match? "concept:" str) (result:suffix 'CONCEPT location #f))
-    ; The token value for 'CR is empty-string so as to handle multiline
-    ; rules.
-    ((has-match? "\r" str) (result:suffix 'CR location ""))
-    ; FIXME: This is not really newline.
-    ((string=? "" str) (cons (make-lexical-token 'NEWLINE location #f) ""))
-    ((has-match? "urge:" str) (result:suffix 'URGE location #f))
-    ((has-match? "ordered-goal:" str) (result:suffix 'ORD-GOAL location #f))
-    ((has-match? "goal:" str) (result:suffix 'GOAL location #f))
-    ((has-match? "#goal:" str) (result:suffix 'RGOAL location #f))
-    ((has-match? "parallel-rules:" str)
-      (result:suffix 'PARALLEL-RULES location #f))
-    ((has-match? "link-concept:" str)
-      (result:suffix 'LINK-CONCEPT location #f))
-    ((has-match? "#link-concept:" str)
-      (result:suffix 'RLINK-CONCEPT location #f))
-    ((has-match? "global-default-rule:" str)
-      (result:suffix 'GLOBAL-DEFAULT-RULE location #f))
-    ((has-match? "#!" str) ; This should be checked always before #
-      ; TODO Add tester function for this
-      (cons (make-lexical-token 'SAMPLE_INPUT location #f) ""))
-    ((has-match? "*#" str)
-      (cons (make-lexical-token 'COMMENT location #f) ""))
-    ; Reactive rules (aka Responders)
-    ; Starts with "r:"; "s:", "?:" and "u:" are for backward compatibility
-    ((has-match? "[rs?u]:" str)
-      (result:suffix 'REACTIVE-RULE location
-        (string-trim-both
-          (match:substring current-match)
-            (lambda (c) (or (eqv? c #\tab) (eqv? c #\space) (eqv? c #\:))))))
-    ; Rejoinders
-    ; Starts with "j" follow by a number to denote the level
-    ((has-match? "j[0-9]+:" str)
-      (result:suffix 'REJOINDER location
-        (string-trim-both
-          (match:substring current-match)
-            (lambda (c) (or (eqv? c #\tab) (eqv? c #\space) (eqv? c #\:))))))
-    ; Rejoinders again, for backward compatibility, but limit the support
-    ; up to the letter "e" instead of "q" as in ChatScript
-    ((has-match? "[a-e]:" str)
-      (result:suffix 'REJOINDER location
-        (string-trim-both
-          (match:substring current-match)
-            (lambda (c) (or (eqv? c #\tab) (eqv? c #\space) (eqv? c #\:))))))
-    ; Proactive rules (aka Gambits)
-    ; Starts with "p:"; "t:" is for backward compatibility
-    ((has-match? "[pt]:" str)
-      (result:suffix 'PROACTIVE-RULE location
-        (string-trim-both
-          (match:substring current-match)
-            (lambda (c) (or (eqv? c #\tab) (eqv? c #\space) (eqv? c #\:))))))
-    ((has-match? "[{][%] set delay=[0-9]+ [%][}]" str)
-      (result:suffix 'SET_DELAY location
-        (string-trim-both (match:substring current-match))))
-    ((has-match? "_[0-9]" str)
-      (result:suffix 'MVAR location
-        (substring (string-trim-both (match:substring current-match)) 1)))
-    ((has-match? "'_[0-9]" str)
-      (result:suffix 'MOVAR location
-        (substring (string-trim-both (match:substring current-match)) 2)))
-    ((has-match? "\\$[a-zA-Z0-9_-]+" str)
-      (result:suffix 'UVAR location
-        (substring (string-trim-both (match:substring current-match)) 1)))
-    ((has-match? "_" str) (result:suffix 'VAR location #f))
-    ; For dictionary keyword sets
-    ((has-match? "[a-zA-Z]+~[a-zA-Z1-9]+" str)
-      (result:suffix 'DICTKEY location (command-pair)))
-    ; Range-restricted Wildcards.
-    ; TODO Maybe replace with dictionary keyword sets then process it on action?
-    ((has-match? "\\*~[0-9]+" str)
-      (result:suffix '*~n location
-        (substring (string-trim-both (match:substring current-match)) 2)))
-    ((has-match? "~[a-zA-Z0-9_]+" str)
-      (result:suffix 'ID location
-        (substring (string-trim-both (match:substring current-match)) 1)))
-    ((has-match? "\\^" str) (result:suffix '^ location #f))
-    ((has-match? "\\[" str) (result:suffix 'LSBRACKET location #f))
-    ((has-match? "]" str) (result:suffix 'RSBRACKET location #f))
-    ((has-match? "\\{" str) (result:suffix 'LBRACE location #f))
-    ((has-match? "}" str) (result:suffix 'RBRACE location #f))
-    ((has-match? "<<" str) (result:suffix '<< location #f))
-    ((has-match? ">>" str) (result:suffix '>> location #f))
-    ; For restarting matching position -- "< *"
-    ((has-match? "<[ ]*\\*" str) (result:suffix 'RESTART location #f))
-    ; This should follow <<
-    ((has-match? "<" str) (result:suffix '< location #f))
-    ; This should follow >>
-    ((has-match? ">" str) (result:suffix '> location #f))
-    ((has-match? "\"" str) (result:suffix 'DQUOTE location "\""))
-    ; Precise wildcards
-    ((has-match? "\\*[0-9]+" str) (result:suffix '*n location
-       (substring (string-trim-both (match:substring current-match)) 1)))
-    ; Wildcards
-    ((has-match? "\\*" str) (result:suffix '* location "*"))
-    ((has-match? "!" str) (result:suffix 'NOT location #f))
-    ((has-match? "[?]" str) (result:suffix '? location "?"))
-    ((has-match? "=" str) (result:suffix 'EQUAL location #f))
-    ; For time -- a.m. and p.m.
-    ; Just catch it to avoid it being splitted into multiple words
-    ; Should be done before any literal / lemma matching
-    ((has-match? "[ap]\\.m\\." str)
-      (result:suffix 'STRING location
-        (string-trim-both (match:substring current-match))))
-    ; Words with apostrophe, e.g. I'm, it's etc
-    ((has-match? "[a-zA-Z]+['’][a-zA-Z]+" str)
-      (result:suffix 'LITERAL_APOS location
-        (string-trim-both (match:substring current-match))))
-    ; Literals for example: Mr. Dr. etc
-    ((has-match? "[a-zA-Z]+\\." str)
-      (result:suffix 'LITERAL location
-        (string-trim-both (match:substring current-match))))
-    ; Literals -- words start with a '
-    ((has-match? "'[a-zA-Z]+\\b" str)
-      (result:suffix 'LITERAL location
-        (substring (string-trim-both (match:substring current-match)) 1)))
-    ((has-match? "[a-zA-Z-]+\\b" str)
-      (if (is-lemma? (string-trim-both (match:substring current-match)))
-        (result:suffix 'LEMMA location
-          (string-trim-both (match:substring current-match)))
-        ; Literals, words in the pattern that are not in their canonical forms
-        (result:suffix 'LITERAL location
-          (string-trim-both (match:substring current-match)))))
-    ((has-match? "[0-9]+[0-9.]*\\b" str)
-      (result:suffix 'NUM location
-        (string-trim-both (match:substring current-match))))
-    ((has-match? "[|]" str)
-      (result:suffix 'VLINE location
-        (string-trim-both (match:substring current-match))))
-    ((has-match? "," str)
-      (result:suffix 'COMMA location
-        (string-trim-both (match:substring current-match))))
-    ; This should always be near the end, because it is broadest of all.
-    ((has-match? "[~’'._!?0-9a-zA-Z-]+" str)
-      (result:suffix 'STRING location
-        (string-trim-both (match:substring current-match))))
-    ; NotDefined token is used for errors only and there shouldn't be any rules.
-    (else (cons (make-lexical-token 'NotDefined location str) ""))
-  )
-)
+(define (line-tokens line port)
+"
+  The lexical-tokens of LINE, just read from PORT.
+
+  The line is split by the native tokenizer, which leaves it to us to
+  tell whether a plain word is a LEMMA or a LITERAL, i.e. a word in the
+  pattern that is not in its canonical form.
+"
+  (map
+    (lambda (tok)
+      (define category (car tok))
+      (define value (cadr tok))
+      (make-lexical-token
+        (if (equal? 'WORD category)
+          (if (is-lemma? value) 'LEMMA 'LITERAL)
+          category)
+        (get-source-location port (caddr tok))
+        value))
+    (call-with-input-string (ghost-tokenize-line line) read)))
 
 (define (cs-lexer port)
-  (let ((cs-line "") (initial-line ""))
+  (let ((tokens '()))
     (lambda ()
-      (if (string=? "" cs-line)
+      (if (nil? tokens)
         (begin
           (cog-logger-debug ghost-logger
             "\n-------------------------- line ~a \n" (port-line port))
-          (set! cs-line (read-line port))
-          (set! initial-line cs-line)
-        ))
-      (let ((port-location (get-source-location port
-              (if (eof-object? cs-line)
-                0
-                (string-contains initial-line cs-line)))))
-        (if (eof-object? cs-line)
-          '*eoi*
-          (let ((result (tokeniz cs-line port-location)))
-            ; This is a sanity check for the tokenizer
-            (if (pair? result)
-              (begin
-                ; For debugging
-                (cog-logger-debug ghost-logger "=== tokeniz: ~a\n-> ~a\n"
-                  cs-line (lexical-token-category (car result)))
-                (set! cs-line (cdr result))
-                (car result))
-              (error (format #f "Tokenizer issue => ~a," result))
-            )))))
-  )
+          (let ((cs-line (read-line port)))
+            (if (not (eof-object? cs-line))
+              (set! tokens (line-tokens cs-line port))))))
+      (if (nil? tokens)
+        '*eoi*
+        (let ((token (car tokens)))
+          ; For debugging
+          (cog-logger-debug ghost-logger "=== tokeniz: -> ~a\n"
+            (lexical-token-category token))
+          (set! tokens (cdr tokens))
+          token))))
 )
 
 (define (cs-parser)
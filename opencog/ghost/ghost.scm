@@ -7,6 +7,7 @@
   #:use-module (opencog logger)
   #:use-module (opencog exec)
   #:use-module (opencog ghost procedures)
+  #:use-module (opencog oc-config)
   #:use-module (opencog attention-bank)
   #:use-module (opencog attention)
   #:use-module (srfi srfi-1)
@@ -20,6 +21,8 @@
   #:use-module (ice-9 receive)
   #:use-module (system base lalr))
 
+(load-extension (string-append opencog-ext-path-ghost "libghost") "opencog_ghost_init")
+
 ;; --------------------
 ;; Shared things being used in the module
 
@@ -176,6 +179,10 @@
 (define ghost-buffer "")
 (define ghost-processed "")
 
+; The terms of the input being processed, for finding the rules that
+; it may satisfy, see get-input-terms
+(define ghost-input-terms '())
+
 ; Keep a record of the lemmas we have seen, and it serves as a cache as well
 (define lemma-alist '())
 
@@ -197,6 +204,11 @@
 (define refractory-period 1)
 (define specificity-based-action-selection #t)
 
+; Whether to evaluate only the rules that have the terms their contexts
+; need in the input, and at most how many of them, 0 for no limit
+(define term-index-based-matching #t)
+(define max-candidate-rules 0)
+
 ;; --------------------
 ;; For monitoring the status
 (define num-rules-found 0)
@@ -265,7 +277,8 @@
            (equal? (cog-type ghost-buffer) 'SentenceNode))
     (begin
       (set! ghost-processed ghost-buffer)
-      (generate-word-seq ghost-buffer)
+      (set! ghost-input-terms (get-input-terms (cog-outgoing-set
+        (cadr (cog-outgoing-set (gdr (generate-word-seq ghost-buffer)))))))
       (append-to-sent-seq ghost-buffer)
       (State ghost-curr-proc ghost-buffer)))
 )
@@ -96,78 +96,23 @@
   Ug = Urge of the goal
 "
   ; ----------
-  ; Store the evaluation results for the contexts, so that the same context
-  ; won't be evaluated again, in the same psi-step
-  (define context-alist '())
+  ; Rules still within their refractory period are skipped; the rest are
+  ; weighed in one go, with each context evaluated only once. Rules with
+  ; no STI or strength get no weight, unless we choose to ignore these.
+  (define rules-accepted (filter not-within-refractory? RULES))
 
-  ; Store the weight of each evaluated rule
-  (define rule-weight-alist '())
-
-  ; For random number generation
-  (define total-weight 0)
+  (define weights
+    (psi-rule-weights rules-accepted
+      strength-weight context-weight sti-weight urge-weight))
 
   ; Store which rules satisfied the current context
-  (define rules-satisfied '())
+  (define rules-satisfied
+    (filter-map
+      (lambda (r w) (and (> w 0) r))
+      rules-accepted (cog-value->list weights)))
 
   ; For monitoring the status
-  (define rules-eval-cnt 0)
-
-  ; ----------
-  ; Calculate the weight of the rule R [Wr]
-  (define (calculate-rule-weight R)
-    (define strength
-      (if (> strength-weight 0)
-        (* strength-weight (cog-mean R)) 1))
-    (define context
-      (if (> context-weight 0)
-        (* context-weight
-          (assoc-ref context-alist (psi-get-context R))) 1))
-    (define sti
-      (if (> sti-weight 0)
-        (* sti-weight (cog-av-sti R)) 1))
-    (define urge
-      (if (> urge-weight 0)
-        (* urge-weight (psi-urge (psi-get-goal R))) 1))
-    (define weight (* strength context sti urge))
-    (cog-logger-debug ghost-logger "The weight of the rule ~a is ~a"
-      (psi-rule-alias R) weight)
-    weight)
-
-  ; Check if a rule should be skipped or not, based on
-  ; its current STI, strength, and the last executed time
-  (define (accept-rule? r)
-    (and (or (= sti-weight 0) (> (cog-av-sti r) 0))
-         (or (= strength-weight 0) (> (cog-mean r) 0))
-         (not-within-refractory? r)))
-
-  ; ----------
-  (for-each
-    (lambda (r)
-      ; Skip the rule if its STI or strength is zero,
-      ; or if it's still within the refractory period,
-      ; unless we choose to ignore their weights
-      (if (accept-rule? r)
-        (let ((rc (psi-get-context r))
-              (ra (psi-get-action r)))
-          ; Evaluate the context, and save the result in context-alist
-          (if (equal? (assoc-ref context-alist rc) #f)
-            (set! context-alist
-              (assoc-set! context-alist rc
-                (cog-tv-mean (psi-satisfiable? r)))))
-
-          ; Calculate the weight of this rule
-          (let ((w (calculate-rule-weight r)))
-            (set! rules-eval-cnt (1+ rules-eval-cnt))
-            (if (> w 0)
-              (begin
-                (set! rules-satisfied (cons r rules-satisfied))
-                (set! rule-weight-alist (assoc-set! rule-weight-alist r w)))
-              (cog-logger-debug ghost-logger
-                "Skipping action with zero weight: ~a" ra))
-          ))
-        (cog-logger-debug ghost-logger
-          "Skipping rule with zero STI/strength: ~a" r)))
-    RULES)
+  (define rules-eval-cnt (length rules-accepted))
 
   ; Update the status
   (set! num-rules-found (length RULES))
@@ -215,19 +160,7 @@
               (list)
               rules-satisfied
             )
-            (let* ((accum-weight 0)
-                   (cutoff (* total-weight (random:uniform (random-state-from-platform))))
-                   (rule-rtn
-                     (find
-                       (lambda (a)
-                         (set! accum-weight (+ accum-weight (cdr a)))
-                         (<= cutoff accum-weight))
-                       rule-weight-alist)))
-              (if rule-rtn
-                (car rule-rtn)
-                (list)
-              )
-            )
+            (psi-sample-by-weight rules-accepted weights)
           )
         )
         rejoinder))))
@@ -264,9 +197,22 @@
     (filter psi-rule? (cog-incoming-set (ConceptNode "Parallel-Rules"))))
 
   (let* ((candidate-rules
-           (if ghost-af-only?
-             (filter is-psi-rule? (cog-af))
-             (psi-get-rules ghost-component)))
+           (cond
+             ; Only the rules that the input has the terms for
+             ((and term-index-based-matching ghost-af-only?)
+              (let ((in-af (make-hash-table)))
+                (for-each (lambda (r) (hash-set! in-af r #t)) (cog-af))
+                (let ((rules (filter (lambda (r) (hash-ref in-af r))
+                               (psi-rules-by-terms ghost-input-terms 0))))
+                  (if (and (> max-candidate-rules 0)
+                           (> (length rules) max-candidate-rules))
+                    (list-head rules max-candidate-rules)
+                    rules))))
+             (term-index-based-matching
+              (psi-rules-by-terms ghost-input-terms max-candidate-rules))
+             (ghost-af-only?
+              (filter is-psi-rule? (cog-af)))
+             (else (psi-get-rules ghost-component))))
          (rule-selected (eval-and-select candidate-rules)))
     ; Stimulate the timer predicate
     (ghost-stimulate-timer)
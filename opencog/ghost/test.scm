@@ -367,3 +367,28 @@
 "
   (set! specificity-based-action-selection VAL)
 )
+
+(define-public (ghost-set-term-index-based-matching VAL)
+"
+  ghost-set-term-index-based-matching VAL
+
+  Set whether or not to evaluate only the rules whose contexts need
+  terms, such as words, lemmas or concepts, that the current input has,
+  instead of all of them. Only the rules created by GHOST are indexed.
+"
+  (set! term-index-based-matching VAL)
+)
+
+(define-public (ghost-set-max-candidate-rules VAL)
+"
+  ghost-set-max-candidate-rules VAL
+
+  Set the most rules to evaluate for each input when the term index is
+  used, those sharing the most terms with the input first. 0 is for no
+  limit.
+"
+  (if (and (integer? VAL) (>= VAL 0))
+    (set! max-candidate-rules VAL)
+    (cog-logger-warn ghost-logger
+      "The number of candidate rules has to be a non-negative integer!"))
+)
@@ -712,15 +712,79 @@
     )
   ))
 
+; ----------
+(define (context-term-groups CONDS)
+"
+  context-term-groups CONDS
+
+  Returns the groups of terms that an input has to have one of each of
+  for the context CONDS of a rule to be satisfiable: each of the literal
+  words in the word-seq, the lemma of each lemma term, each concept, and
+  the alternatives of each list of choices.
+
+  Optional and negated terms, and the choices that would have to be
+  looked up when matching, such as user variables, are left out, so that
+  an input that has none of them is never one the rule matches.
+"
+  (define (alternatives atom)
+    (cond ((or (equal? 'WordNode (cog-type atom))
+               (equal? 'LemmaNode (cog-type atom))
+               (equal? 'ConceptNode (cog-type atom)))
+           (list atom))
+          ((equal? 'ListLink (cog-type atom))
+           (let ((alts (map alternatives (cog-outgoing-set atom))))
+             (if (member #f alts) #f (apply append alts))))
+          (else #f)))
+
+  (append-map
+    (lambda (c)
+      (define pred (if (equal? 'EvaluationLink (cog-type c)) (gar c) '()))
+      (define args (if (nil? pred) '() (cog-outgoing-set (gdr c))))
+      (cond
+        ((nil? pred) '())
+        ((equal? ghost-word-seq pred)
+         (map list
+           (cog-filter 'WordNode (cog-outgoing-set (cadr args)))))
+        ((equal? (GroundedPredicate "scm: ghost-lemma?") pred)
+         (list (list (WordNode (string-downcase (cog-name (cadr args)))))))
+        ((equal? (GroundedPredicate "scm: ghost-concept?") pred)
+         (list (list (car args))))
+        ((equal? (GroundedPredicate "scm: ghost-choices?") pred)
+         (let ((alts (alternatives (car args))))
+           (if (or (not alts) (nil? alts)) '() (list alts))))
+        (else '())))
+    CONDS))
+
+; ----------
+(define (rule-terms CONDS)
+"
+  rule-terms CONDS
+
+  Returns the groups of terms of CONDS, the context of a rule, as
+  psi-add-rules takes them, so that ghost-find-rules only evaluates the
+  rules that the current input may satisfy.
+"
+  (apply LinkValue
+    (map (lambda (g) (apply LinkValue g)) (context-term-groups CONDS))))
+
 ; ----------
 (define (process-rule-stack)
 "
   Instantiate the rules accumulated in rule-label-list.
+
+  The psi-rules of all of them are added to OpenPsi in one go, and then
+  finished in the order they were defined.
 "
+  (define pending
+    (append-map
+      (lambda (l)
+        (apply instantiate-rule (assoc-ref rule-alist l)))
+      rule-label-list))
+
   (for-each
-    (lambda (l)
-      (apply instantiate-rule (assoc-ref rule-alist l)))
-    rule-label-list)
+    (lambda (rule p) (apply finish-rule rule (cdr p)))
+    (psi-add-rules (apply LinkValue (map car pending)))
+    pending)
 
   ; Clear the states
   (clear-parsing-states)
@@ -777,7 +841,10 @@
 ; ----------
 (define (instantiate-rule PATTERN ACTION ALL-GOALS RULE-LV-GOALS NAME TYPE ORDERED? RULE-CONCEPTS)
 "
-  To process and create the rule in the AtomSpace.
+  To process the rule, and work out its place in the rule hierarchy.
+
+  Returns a pair for each of its goals, of what psi-add-rules takes to
+  create the psi-rule, and the rest of the arguments of finish-rule.
 "
   (define (add-to-rule-hierarchy LV RULE)
     ; Reset the rule hierarchy if it's not a rejoinder
@@ -788,13 +855,6 @@
         (list-set! rule-hierarchy LV
           (append (list-ref rule-hierarchy LV) (list RULE))))))
 
-  (define (set-next-rule PRULE CRULE KEY)
-    (define val (cog-value PRULE KEY))
-    (cog-set-value! PRULE KEY
-      (if (nil? val)
-        (LinkValue CRULE)
-        (apply LinkValue (append (cog-value->list val) (list CRULE))))))
-
   ; Reset the list of local variables and rule features
   (set! pat-vars '())
   (set! rule-features '())
@@ -865,126 +925,149 @@
 
     (map
       (lambda (goal)
-        ; Create the rule
-        (define a-rule
-          (psi-rule
-            (list (Satisfaction (VariableList vars) (And conds)))
+        ; Make sure the goal has been created
+        (define goal-node
+          (psi-goal (car goal)
+            ; Check if an initial urge has been assigned to it
+            (let ((urge (assoc-ref initial-urges (car goal))))
+              (if urge (- 1 urge) default-urge))))
+
+        ; If it's a rejoinder, its parent rule should be the last
+        ; rule one level up in rule-hierarchy
+        ; 'process-type' will make sure there is a reactive rule
+        ; defined beforehand so rule-hierarchy is not empty
+        ; If it's not a rejoinder, its parent rules should be the
+        ; rules at every level that are still in the rule-hierarchy
+        (define parents
+          (cond
+            (is-rejoinder?
+             (list (last (list-ref rule-hierarchy (1- rule-lv)))))
+            ((and ORDERED? (not (nil? rule-hierarchy)))
+             (concatenate rule-hierarchy))
+            (else '())))
+
+        ; Keep track of the rule hierarchy
+        (add-to-rule-hierarchy rule-lv NAME)
+
+        (cons
+          (LinkValue
+            (LinkValue (Satisfaction (VariableList vars) (And conds)))
             action
-            ; Make sure the goal has been created
-            (psi-goal (car goal)
-              ; Check if an initial urge has been assigned to it
-              (let ((urge (assoc-ref initial-urges (car goal))))
-                (if urge (- 1 urge) default-urge)))
+            goal-node
             ; Check if the goal is defined at the rule level
             ; If the rule is ordered, the weight should change
             ; accordingly as well
             (if (or (member goal RULE-LV-GOALS) (not ORDERED?))
               (stv (cdr goal) .9)
               (stv (/ (cdr goal) (expt 2 (+ rule-lv goal-rule-cnt))) .9))
-            ghost-component))
-
-        ; Assign the features to the rule
-        (for-each
-          (lambda (f)
-            (define key-str (cog-name (car f)))
-            (define val (cog-value a-rule (car f)))
-            (cond
-              ((or (string=? "unkeep" key-str)
-                   (string=? "mark-executed" key-str))
-               (cond
-                 ; If 'val' is null, that means no such value has been
-                 ; assigned to this rule yet
-                 ((nil? val)
-                  (cog-set-value! a-rule (car f) (LinkValue (cdr f))))
-                 ; If 'val' is not null and it's an atom, just append it
-                 ; it to 'val'
-                 ((cog-atom? (cdr f))
-                  (cog-set-value! a-rule (car f)
-                    (apply LinkValue (append (flatten-linkval val)
-                      (list (cdr f))))))
-                 ; If 'val' is not null and it's not an atom, it's a
-                 ; LinkValue, based on the way it's being used here in
-                 ; GHOST, so turn it into a list and append it to 'val'
-                 (else (cog-set-value! a-rule (car f)
-                   (apply LinkValue (append (flatten-linkval val)
-                     (flatten-linkval (cdr f))))))))
-              ((string=? "last-executed" key-str)
-               (cog-set-value! a-rule (car f) (cdr f)))))
-          rule-features)
-
-        ; If the rule can possibly be satisfied by input sentence
-        ; tag it as such.
-        (if (list-ref proc-terms 2)
-          (handles-sent! a-rule)
-          a-rule)
-
-        ; Label the rule
-        (psi-rule-set-alias! a-rule NAME)
-
-        ; Set the type
-        (cog-set-value! a-rule ghost-rule-type type)
-
-        ; Set how specific the context of the rule is
-        (cog-set-value! a-rule ghost-context-specificity (FloatValue specificity))
-
-        ; Keep track of the rule hierarchy, and link rules that
-        ; are defined in a sequence
-        (if is-rejoinder?
-          ; If it's a rejoinder, its parent rule should be the
-          ; last rule one level up in rule-hierarchy
-          ; 'process-type' will make sure there is a reactive
-          ; rule defined beforehand so rule-hierarchy is not empty
-          (begin
-            (set-next-rule
-              (car (get-rules-from-label
-                (last (list-ref rule-hierarchy
-                  (1- (get-rejoinder-level TYPE))))))
-              a-rule ghost-next-rejoinder)
-            (add-to-rule-hierarchy
-              (get-rejoinder-level TYPE) NAME)
+            (LinkValue ghost-component)
+            ; Index the rule by the terms the input needs to satisfy it
+            (rule-terms conds))
+          (list NAME type specificity (list-ref proc-terms 2) conds
+            rule-features parents
             ; Record the sequence number of the rejoinder
-            ; This is used during matching, basically rejoinders is treated
-            ; as a sequence, and the one defined first will be matched first
-            ; if it satisfies the context
-            (cog-set-value! a-rule ghost-rej-seq-num (FloatValue
-              (length (list-ref rule-hierarchy (get-rejoinder-level TYPE))))))
-          (begin
-            ; If it's not a rejoinder, its parent rules should
-            ; be the rules at every level that are still in
-            ; the rule-hierarchy
-            (if (and ORDERED? (not (nil? rule-hierarchy)))
-              (for-each
-                (lambda (lv)
-                  (for-each
-                    (lambda (r)
-                      (set-next-rule
-                        (car (get-rules-from-label r))
-                          a-rule ghost-next-reactive-rule))
-                    lv))
-                rule-hierarchy))
-            (add-to-rule-hierarchy 0 NAME)))
-
-        ; Connect words, concepts and predicates from the context
-        ; directly to the rule via a HebbianLink
-        (for-each
-          (lambda (node) (AsymmetricHebbianLink node a-rule (stv 1 1)))
-          (filter
-            (lambda (x)
-              (or (equal? ghost-word-seq x)
-                  (equal? 'WordNode (cog-type x))
-                  (equal? 'ConceptNode (cog-type x))
-                  (equal? 'GroundedPredicateNode (cog-type x))))
-            (append-map cog-get-all-nodes conds)))
-
-        ; Link it to concepts, if defined
-        (map (lambda (c) (Member a-rule (Concept c))) RULE-CONCEPTS)
-
-        ; (cog-logger-debug ghost-logger "rule-hierarchy: ~a" rule-hierarchy)
-
-        ; Return
-        a-rule)
+            (if is-rejoinder?
+              (length (list-ref rule-hierarchy rule-lv))
+              #f)
+            RULE-CONCEPTS)))
       ALL-GOALS)))
 
+; ----------
+(define (set-next-rule PRULE CRULE KEY)
+"
+  Append CRULE to the rules that follow PRULE, under KEY.
+"
+  (define val (cog-value PRULE KEY))
+  (cog-set-value! PRULE KEY
+    (if (nil? val)
+      (LinkValue CRULE)
+      (apply LinkValue (append (cog-value->list val) (list CRULE))))))
+
+; ----------
+(define (finish-rule a-rule NAME TYPE SPECIFICITY HANDLES-SENT? CONDS FEATURES PARENTS REJ-SEQ-NUM RULE-CONCEPTS)
+"
+  To set up the psi-rule A-RULE, just created for one of the goals of
+  the rule NAME, with what instantiate-rule worked out for it.
+"
+  (define is-rejoinder? (equal? TYPE strval-rejoinder))
+
+  ; Assign the features to the rule
+  (for-each
+    (lambda (f)
+      (define key-str (cog-name (car f)))
+      (define val (cog-value a-rule (car f)))
+      (cond
+        ((or (string=? "unkeep" key-str)
+             (string=? "mark-executed" key-str))
+         (cond
+           ; If 'val' is null, that means no such value has been
+           ; assigned to this rule yet
+           ((nil? val)
+            (cog-set-value! a-rule (car f) (LinkValue (cdr f))))
+           ; If 'val' is not null and it's an atom, just append it
+           ; it to 'val'
+           ((cog-atom? (cdr f))
+            (cog-set-value! a-rule (car f)
+              (apply LinkValue (append (flatten-linkval val)
+                (list (cdr f))))))
+           ; If 'val' is not null and it's not an atom, it's a
+           ; LinkValue, based on the way it's being used here in
+           ; GHOST, so turn it into a list and append it to 'val'
+           (else (cog-set-value! a-rule (car f)
+             (apply LinkValue (append (flatten-linkval val)
+               (flatten-linkval (cdr f))))))))
+        ((string=? "last-executed" key-str)
+         (cog-set-value! a-rule (car f) (cdr f)))))
+    FEATURES)
+
+  ; If the rule can possibly be satisfied by input sentence
+  ; tag it as such.
+  (if HANDLES-SENT?
+    (handles-sent! a-rule)
+    a-rule)
+
+  ; Label the rule
+  (psi-rule-set-alias! a-rule NAME)
+
+  ; Set the type
+  (cog-set-value! a-rule ghost-rule-type TYPE)
+
+  ; Set how specific the context of the rule is
+  (cog-set-value! a-rule ghost-context-specificity (FloatValue SPECIFICITY))
+
+  ; Link rules that are defined in a sequence
+  (for-each
+    (lambda (r)
+      (set-next-rule (car (get-rules-from-label r)) a-rule
+        (if is-rejoinder? ghost-next-rejoinder ghost-next-reactive-rule)))
+    PARENTS)
+
+  ; This is used during matching, basically rejoinders is treated
+  ; as a sequence, and the one defined first will be matched first
+  ; if it satisfies the context
+  (if is-rejoinder?
+    (cog-set-value! a-rule ghost-rej-seq-num (FloatValue REJ-SEQ-NUM)))
+
+  ; Connect words, concepts and predicates from the context
+  ; directly to the rule via a HebbianLink
+  (for-each
+    (lambda (node) (AsymmetricHebbianLink node a-rule (stv 1 1)))
+    (filter
+      (lambda (x)
+        (or (equal? ghost-word-seq x)
+            (equal? 'WordNode (cog-type x))
+            (equal? 'ConceptNode (cog-type x))
+            (equal? 'GroundedPredicateNode (cog-type x))))
+      (append-map cog-get-all-nodes CONDS)))
+
+  ; Link it to concepts, if defined
+  (map (lambda (c) (Member a-rule (Concept c))) RULE-CONCEPTS)
+
+  ; (cog-logger-debug ghost-logger "rule-hierarchy: ~a" rule-hierarchy)
+
+  ; Return
+  a-rule)
+
 ; ----------
 (define (create-concept NAME MEMBERS)
 "
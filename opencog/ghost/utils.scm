@@ -225,6 +225,43 @@
                          GRD (flatten-list (cog-outgoing-set m))))))
        MEMB))
 
+; ----------
+(define (get-input-terms WORDS)
+"
+  Get the terms that the input WORDS, the WordNodes of a word-seq, may
+  satisfy a rule with: the words, the WordNodes and LemmaNodes of their
+  lemmas, and every concept that any of these, or any phrase with one
+  of the words in it, is a member of, directly or not.
+  Nothing is created, the terms no rule mentions are not needed.
+"
+  (define visited (make-hash-table))
+  (define terms '())
+
+  (define (add! atom)
+    (if (and (cog-atom? atom) (not (hash-ref visited atom)))
+      (begin
+        (hash-set! visited atom #t)
+        (set! terms (cons atom terms))
+        (for-each add! (cog-chase-link 'MemberLink 'ConceptNode atom)))))
+
+  (define (add-with-phrases! atom)
+    (if (cog-atom? atom)
+      (begin
+        (add! atom)
+        (for-each
+          (lambda (p) (for-each add! (cog-chase-link 'MemberLink 'ConceptNode p)))
+          (cog-incoming-by-type atom 'ListLink)))))
+
+  (for-each
+    (lambda (w)
+      (define lemma (get-lemma (cog-name w)))
+      (add-with-phrases! w)
+      (add-with-phrases! (cog-node 'WordNode (string-downcase lemma)))
+      (add-with-phrases! (cog-node 'LemmaNode lemma)))
+    WORDS)
+
+  terms)
+
 ; ----------
 (define (text-contains? RTXT LTXT TERM)
 "
@@ -17,6 +17,7 @@
 #define _OPENCOG_FOLLOW_LINK_H
 
 #include <opencog/atoms/base/Link.h>
+#include <opencog/neighbors/ForeachChaseLink.h>
 
 namespace opencog
 {
@@ -106,6 +107,28 @@ private:
 	}
 };
 
+/**
+ * The same as FollowLink::follow_link, without an object to hold the
+ * state, so that it can be inlined and called from several threads.
+ */
+inline Handle follow_link(const Handle& h, Type ltype, int from, int to)
+{
+	Handle to_atom;
+	foreach_link(h, ltype, from, to,
+		[&](const Handle& far) { to_atom = far; return true; });
+	return to_atom;
+}
+
+inline Handle follow_binary_link(const Handle& h, Type ltype)
+{
+	return follow_link(h, ltype, 0, 1);
+}
+
+inline Handle backtrack_binary_link(const Handle& h, Type ltype)
+{
+	return follow_link(h, ltype, 1, 0);
+}
+
 /** @}*/
 } // namespace opencog
 
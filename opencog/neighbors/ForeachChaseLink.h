@@ -38,6 +38,7 @@
 #define _OPENCOG_LINK_CHASE_H
 
 #include <opencog/atoms/base/Link.h>
+#include <opencog/neighbors/Neighbors.h>
 
 namespace opencog
 {
@@ -354,6 +355,74 @@ inline bool foreach_unordered_binary_link(const Handle& h, Type ltype,
 	return cl.follow_unordered_binary_link(h, ltype, cb, data);
 }
 
+/*
+ * The same, for any callable, e.g. a lambda, taking either the far
+ * atom, or the far atom and the link. Only the links of the given type
+ * are looked at, and no state object is set up, so the callbacks can
+ * be inlined, and these can be called from several threads at once.
+ */
+
+// Not for general use: calls the callback with the link if it takes it.
+template <typename F>
+inline auto private_use_only_chase_call(F& cb, const Handle& to,
+                                        const Handle& link, int)
+	-> decltype(cb(to, link))
+{
+	return cb(to, link);
+}
+
+template <typename F>
+inline auto private_use_only_chase_call(F& cb, const Handle& to,
+                                        const Handle&, long)
+	-> decltype(cb(to))
+{
+	return cb(to);
+}
+
+/**
+ * foreach_link -- follow an ordered N-ary link, calling the callable
+ * with the atom in position "to" of each link of type ltype that has h
+ * in position "from".
+ */
+template <typename F>
+inline bool foreach_link(const Handle& h, Type ltype, int from, int to, F cb)
+{
+	return foreach_incoming_of_type(h, ltype, false,
+		[&](const Handle& link) -> bool
+		{
+			const HandleSeq& out = link->getOutgoingSet();
+			if (to < 0 or out.size() <= (size_t) to) return false;
+			if (0 <= from and (size_t) from < out.size() and out[from] != h)
+				return false;
+			return private_use_only_chase_call(cb, out[to], link, 0);
+		});
+}
+
+template <typename F>
+inline bool foreach_binary_link(const Handle& h, Type ltype, F cb)
+{
+	return foreach_link(h, ltype, 0, 1, cb);
+}
+
+template <typename F>
+inline bool foreach_reverse_binary_link(const Handle& h, Type ltype, F cb)
+{
+	return foreach_link(h, ltype, 1, 0, cb);
+}
+
+template <typename F>
+inline bool foreach_unordered_binary_link(const Handle& h, Type ltype, F cb)
+{
+	return foreach_incoming_of_type(h, ltype, false,
+		[&](const Handle& link) -> bool
+		{
+			for (const Handle& other : link->getOutgoingSet())
+				if (other != h)
+					return private_use_only_chase_call(cb, other, link, 0);
+			return false;
+		});
+}
+
 /** @}*/
 } // namespace opencog
 
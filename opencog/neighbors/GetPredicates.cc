@@ -26,6 +26,7 @@
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
 #include "GetPredicates.h"
+#include "PredicateIndex.h"
 
 namespace opencog
 {
@@ -38,6 +39,11 @@ HandleSeq get_predicates(const Handle& target,
         throw InvalidParamException(TRACE_INFO,
             "get_predicates: Target handle %d doesn't refer to an Atom", target.value());
     }
+
+    PredicateIndex* index = PredicateIndex::lookup(target);
+    if (index)
+        return index->get_predicates(target, predicateType, subClasses);
+
     NameServer& nameServer = nameserver();
     HandleSeq answer;
 
@@ -84,6 +90,11 @@ HandleSeq get_predicates_for(const Handle& target,
         throw InvalidParamException(TRACE_INFO,
             "get_predicates_for: Predicate handle %d doesn't refer to an Atom", predicate.value());
     }
+
+    PredicateIndex* index = PredicateIndex::lookup(target);
+    if (index)
+        return index->get_predicates_for(target, predicate);
+
     NameServer& nameServer = nameserver();
     HandleSeq answer;
 
@@ -21,10 +21,14 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <iterator>
 
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
+#include <opencog/executor/Executor.h>
 #include "Neighbors.h"
 
 namespace opencog
@@ -33,48 +37,18 @@ namespace opencog
 HandleSeq get_target_neighbors(const Handle& h, Type desiredLinkType,
                                bool match_subtype/* = false*/)
 {
-    if (nameserver().isA(desiredLinkType, UNORDERED_LINK))
-        return HandleSeq();
-
     HandleSeq answer;
-    for (const Handle& link : h->getIncomingSet())
-    {
-        Type t = link->get_type();
-        if (not(t == desiredLinkType or
-               (match_subtype and nameserver().isA(t, desiredLinkType))))
-	    continue;
-        if (link->getOutgoingAtom(0) != h) continue;
-
-        for (const Handle& handle : link->getOutgoingSet()) {
-           if (handle == h) continue;
-           answer.emplace_back(handle);
-        }
-    }
+    get_target_neighbors(std::back_inserter(answer), h, desiredLinkType,
+                         match_subtype);
     return answer;
 }
 
-
 HandleSeq get_source_neighbors(const Handle& h, Type desiredLinkType,
                                bool match_subtype/* = false*/)
 {
-    if (nameserver().isA(desiredLinkType, UNORDERED_LINK))
-        return HandleSeq();
-
     HandleSeq answer;
-
-    for (const Handle& link : h->getIncomingSet())
-    {
-        Type t = link->get_type();
-        if (not(t == desiredLinkType or
-               (match_subtype and nameserver().isA(t, desiredLinkType))))
-	    continue;
-        if (link->getOutgoingAtom(0) == h) continue;
-
-        for (const Handle& handle : link->getOutgoingSet()) {
-           if (handle == h) continue;
-            answer.emplace_back(handle);
-        }
-    }
+    get_source_neighbors(std::back_inserter(answer), h, desiredLinkType,
+                         match_subtype);
     return answer;
 }
 
@@ -82,51 +56,187 @@ HandleSeq get_all_neighbors(const Handle& h,
                             Type desiredLinkType)
 {
     HandleSeq answer;
+    get_all_neighbors(std::back_inserter(answer), h, desiredLinkType);
+    return answer;
+}
+
+// Batches smaller than this are not worth the threads
+static const size_t parallel_batch = 1024;
 
-    for (const Handle& link : h->getIncomingSet())
+/* Put the neighbors of each atom, as given by the callback, one after
+ * the other, splitting the atoms among threads if there are enough of
+ * them. */
+template<typename Fetch>
+static NeighborBatch get_batch(const HandleSeq& atoms, unsigned num_threads,
+                               Fetch fetch)
+{
+    auto fetch_part = [&](size_t begin, size_t end, NeighborBatch& part)
     {
-        if (link->get_type() != desiredLinkType) continue;
-        for (const Handle& handle : link->getOutgoingSet())
+        part.offsets.reserve(end - begin + 1);
+        part.offsets.push_back(0);
+        for (size_t i = begin; i < end; i++)
         {
-            if (handle == h) continue;
-            answer.emplace_back(handle);
+            fetch(atoms[i], part.neighbors);
+            part.offsets.push_back(part.neighbors.size());
         }
+    };
+
+    size_t n = std::min((size_t) num_threads, atoms.size() / parallel_batch);
+    if (n < 2)
+    {
+        NeighborBatch batch;
+        fetch_part(0, atoms.size(), batch);
+        return batch;
     }
-    return answer;
+
+    size_t chunk = (atoms.size() + n - 1) / n;
+    std::vector<NeighborBatch> parts(n);
+    Executor::instance().parallel_for(n, [&](size_t i)
+    {
+        fetch_part(i * chunk, std::min(atoms.size(), (i + 1) * chunk),
+                   parts[i]);
+    }, n);
+
+    NeighborBatch batch;
+    size_t total = 0;
+    for (const NeighborBatch& part : parts)
+        total += part.neighbors.size();
+    batch.neighbors.reserve(total);
+    batch.offsets.reserve(atoms.size() + 1);
+    batch.offsets.push_back(0);
+    for (const NeighborBatch& part : parts)
+    {
+        size_t base = batch.neighbors.size();
+        for (size_t i = 1; i < part.offsets.size(); i++)
+            batch.offsets.push_back(base + part.offsets[i]);
+        batch.neighbors.insert(batch.neighbors.end(),
+                               part.neighbors.begin(), part.neighbors.end());
+    }
+    return batch;
 }
 
-/* Tail-recursive helper function. We mark it static, so that
- * gcc can optimize this, i.e. call it without buying the stack
- * frame. */
-static void get_distant_neighbors_rec(const Handle& h,
-                                      UnorderedHandleSet& res,
-                                      int dist)
+NeighborBatch get_target_neighbors_batch(const HandleSeq& atoms,
+                                         Type desiredLinkType,
+                                         bool match_subtype,
+                                         unsigned num_threads)
 {
-    res.insert(h);
-
-    // Recursive calls
-    if (dist != 0) {
-        // 1. Fetch incomings
-        for (const Handle& in_l : h->getIncomingSet()) {
-            Handle in_h = in_l->get_handle();
-            if (res.find(in_h) == res.cend()) // Do not re-explore
-                get_distant_neighbors_rec(in_h, res, dist - 1);
+    return get_batch(atoms, num_threads,
+        [&](const Handle& h, HandleSeq& out) {
+            get_target_neighbors(std::back_inserter(out), h,
+                                 desiredLinkType, match_subtype); });
+}
+
+NeighborBatch get_source_neighbors_batch(const HandleSeq& atoms,
+                                         Type desiredLinkType,
+                                         bool match_subtype,
+                                         unsigned num_threads)
+{
+    return get_batch(atoms, num_threads,
+        [&](const Handle& h, HandleSeq& out) {
+            get_source_neighbors(std::back_inserter(out), h,
+                                 desiredLinkType, match_subtype); });
+}
+
+NeighborBatch get_all_neighbors_batch(const HandleSeq& atoms,
+                                      Type desiredLinkType,
+                                      unsigned num_threads)
+{
+    return get_batch(atoms, num_threads,
+        [&](const Handle& h, HandleSeq& out) {
+            get_all_neighbors(std::back_inserter(out), h, desiredLinkType); });
+}
+
+/* Append the atoms one hop away from h: the links it is in and, if it
+ * is a link, the atoms in it; only the links of the given types if
+ * any are given. */
+static void expand(const Handle& h, const std::vector<Type>& link_types,
+                   HandleSeq& out)
+{
+    auto wanted = [&](const Handle& a)
+    {
+        return link_types.empty() or not a->is_link() or
+            std::find(link_types.begin(), link_types.end(), a->get_type())
+                != link_types.end();
+    };
+
+    if (link_types.empty())
+        for (const Handle& in_l : h->getIncomingSet())
+            out.emplace_back(in_l);
+    else
+        for (Type t : link_types)
+            h->getIncomingSetByType(std::back_inserter(out), t);
+
+    if (h->is_link() and wanted(h))
+        for (const Handle& out_h : h->getOutgoingSet())
+            if (wanted(out_h))
+                out.emplace_back(out_h);
+}
+
+// Levels smaller than this are not worth the threads
+static const size_t parallel_frontier = 1024;
+
+std::vector<HandleSeq> get_neighbors_by_distance(const Handle& h, int dist,
+                                                 const std::vector<Type>& link_types,
+                                                 size_t max_results,
+                                                 unsigned num_threads)
+{
+    std::vector<HandleSeq> levels;
+    UnorderedHandleSet visited({h});
+    size_t found = 0;
+
+    HandleSeq frontier({h});
+    for (int d = 0; (dist < 0 or d < dist) and not frontier.empty(); d++)
+    {
+        // The atoms one hop away from each atom of the frontier, which a
+        // large frontier has its parts expanded in parallel for.
+        size_t n = std::min((size_t) num_threads,
+                            frontier.size() / parallel_frontier);
+        std::vector<HandleSeq> expanded(std::max(n, (size_t) 1));
+        if (n < 2)
+        {
+            for (const Handle& f : frontier)
+                expand(f, link_types, expanded[0]);
         }
-        // 2. Fetch outgoings
-        if (h->is_link()) {
-            for (const Handle& out_h : h->getOutgoingSet()) {
-                if (res.find(out_h) == res.cend()) // Do not re-explore
-                    get_distant_neighbors_rec(out_h, res, dist - 1);
+        else
+        {
+            size_t chunk = (frontier.size() + n - 1) / n;
+            auto work = [&](size_t i)
+            {
+                size_t end = std::min(frontier.size(), (i + 1) * chunk);
+                for (size_t j = i * chunk; j < end; j++)
+                    expand(frontier[j], link_types, expanded[i]);
+            };
+
+            Executor::instance().parallel_for(n, work, n);
+        }
+
+        // Keep those not seen at a shorter distance, in order, so that
+        // the result doesn't depend on the no. of threads.
+        HandleSeq next;
+        for (const HandleSeq& part : expanded)
+        {
+            for (const Handle& a : part)
+            {
+                if (0 < max_results and found == max_results) break;
+                if (not visited.insert(a).second) continue;
+                next.emplace_back(a);
+                found++;
             }
         }
+
+        if (next.empty()) break;
+        levels.push_back(next);
+        if (0 < max_results and found == max_results) break;
+        frontier.swap(next);
     }
+    return levels;
 }
 
 UnorderedHandleSet get_distant_neighbors(const Handle& h, int dist)
 {
     UnorderedHandleSet results;
-    get_distant_neighbors_rec(h, results, dist);
-    results.erase(h);
+    for (const HandleSeq& level : get_neighbors_by_distance(h, dist))
+        results.insert(level.begin(), level.end());
     return results;
 }
 
@@ -24,7 +24,11 @@
 #ifndef _OPENCOG_NEIGHBORS_H
 #define _OPENCOG_NEIGHBORS_H
 
-#include <opencog/atoms/base/Handle.h>
+#include <iterator>
+#include <vector>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/atom_types/types.h>
 
 namespace opencog
@@ -46,6 +50,217 @@ HandleSeq get_source_neighbors(const Handle& h, Type desiredLinkType,
                                bool match_subtype = false);
 HandleSeq get_all_neighbors(const Handle& h, Type desiredLinkType);
 
+/**
+ * This is not meant for external use; it is the scratch space of the
+ * helpers below. The links they follow are fetched into it, past the
+ * ones of any call further up the stack, and dropped again when done,
+ * so that once it has grown nothing is allocated.
+ */
+inline HandleSeq& private_use_only_neighbor_links()
+{
+    static thread_local HandleSeq links;
+    return links;
+}
+
+/**
+ * Invoke the callback on each link of the given type, and of its
+ * subtypes if match_subtype is set, that h is in. Only the links of
+ * those types are looked at, not the whole incoming set.
+ *
+ * The callback should return false to go on, or true to halt; the
+ * return value is true if it was halted.
+ */
+template<typename Callback>
+bool foreach_incoming_of_type(const Handle& h, Type desiredLinkType,
+                              bool match_subtype, Callback cb)
+{
+    HandleSeq& links = private_use_only_neighbor_links();
+    const size_t start = links.size();
+    struct Restore
+    {
+        HandleSeq& links;
+        size_t size;
+        ~Restore() { links.resize(size); }
+    } restore{links, start};
+
+    h->getIncomingSetByType(std::back_inserter(links), desiredLinkType);
+    if (match_subtype)
+    {
+        Type ntypes = nameserver().getNumberOfClasses();
+        for (Type t = 0; t < ntypes; t++)
+            if (t != desiredLinkType and nameserver().isA(t, desiredLinkType))
+                h->getIncomingSetByType(std::back_inserter(links), t);
+    }
+
+    // The callback may call these helpers too, which may grow the
+    // scratch space, so index it rather than iterate over it.
+    for (size_t i = start; i < links.size(); i++)
+    {
+        Handle link(links[i]);
+        if (cb(link)) return true;
+    }
+    return false;
+}
+
+/**
+ * Invoke the callback on each neighbor that get_target_neighbors,
+ * get_source_neighbors or get_all_neighbors would return, in the
+ * same order, without building the list. The callback should return
+ * false to go on, or true to halt; the return value is true if it
+ * was halted.
+ */
+template<typename Callback>
+bool foreach_target_neighbor(const Handle& h, Type desiredLinkType,
+                             Callback cb, bool match_subtype = false)
+{
+    if (nameserver().isA(desiredLinkType, UNORDERED_LINK))
+        return false;
+
+    return foreach_incoming_of_type(h, desiredLinkType, match_subtype,
+        [&](const Handle& link)
+        {
+            if (link->getOutgoingAtom(0) != h) return false;
+            for (const Handle& handle : link->getOutgoingSet())
+                if (handle != h and cb(handle)) return true;
+            return false;
+        });
+}
+
+template<typename Callback>
+bool foreach_source_neighbor(const Handle& h, Type desiredLinkType,
+                             Callback cb, bool match_subtype = false)
+{
+    if (nameserver().isA(desiredLinkType, UNORDERED_LINK))
+        return false;
+
+    return foreach_incoming_of_type(h, desiredLinkType, match_subtype,
+        [&](const Handle& link)
+        {
+            if (link->getOutgoingAtom(0) == h) return false;
+            for (const Handle& handle : link->getOutgoingSet())
+                if (handle != h and cb(handle)) return true;
+            return false;
+        });
+}
+
+template<typename Callback>
+bool foreach_neighbor(const Handle& h, Type desiredLinkType, Callback cb)
+{
+    return foreach_incoming_of_type(h, desiredLinkType, false,
+        [&](const Handle& link)
+        {
+            for (const Handle& handle : link->getOutgoingSet())
+                if (handle != h and cb(handle)) return true;
+            return false;
+        });
+}
+
+/**
+ * Write the neighbors to the output iterator, e.g. a back_inserter
+ * of a buffer kept by the caller, and return the iterator past them.
+ */
+template<typename OutputIterator>
+OutputIterator get_target_neighbors(OutputIterator result, const Handle& h,
+                                    Type desiredLinkType,
+                                    bool match_subtype = false)
+{
+    foreach_target_neighbor(h, desiredLinkType,
+        [&](const Handle& n) { *result++ = n; return false; },
+        match_subtype);
+    return result;
+}
+
+template<typename OutputIterator>
+OutputIterator get_source_neighbors(OutputIterator result, const Handle& h,
+                                    Type desiredLinkType,
+                                    bool match_subtype = false)
+{
+    foreach_source_neighbor(h, desiredLinkType,
+        [&](const Handle& n) { *result++ = n; return false; },
+        match_subtype);
+    return result;
+}
+
+template<typename OutputIterator>
+OutputIterator get_all_neighbors(OutputIterator result, const Handle& h,
+                                 Type desiredLinkType)
+{
+    foreach_neighbor(h, desiredLinkType,
+        [&](const Handle& n) { *result++ = n; return false; });
+    return result;
+}
+
+/**
+ * Returns the first neighbor get_target_neighbors would return, or
+ * Handle::UNDEFINED if there is none, without building the list.
+ */
+inline Handle first_target_neighbor(const Handle& h, Type desiredLinkType,
+                                    bool match_subtype = false)
+{
+    Handle first;
+    foreach_target_neighbor(h, desiredLinkType,
+        [&](const Handle& n) { first = n; return true; }, match_subtype);
+    return first;
+}
+
+inline Handle first_source_neighbor(const Handle& h, Type desiredLinkType,
+                                    bool match_subtype = false)
+{
+    Handle first;
+    foreach_source_neighbor(h, desiredLinkType,
+        [&](const Handle& n) { first = n; return true; }, match_subtype);
+    return first;
+}
+
+inline bool has_target_neighbor(const Handle& h, Type desiredLinkType,
+                                bool match_subtype = false)
+{
+    return (bool) first_target_neighbor(h, desiredLinkType, match_subtype);
+}
+
+inline bool has_source_neighbor(const Handle& h, Type desiredLinkType,
+                                bool match_subtype = false)
+{
+    return (bool) first_source_neighbor(h, desiredLinkType, match_subtype);
+}
+
+
+/**
+ * The neighbors of several atoms, all in one array: those of the i'th
+ * atom are neighbors[offsets[i]] up to neighbors[offsets[i+1]].
+ */
+struct NeighborBatch
+{
+    std::vector<size_t> offsets;
+    HandleSeq neighbors;
+
+    size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    size_t count(size_t i) const { return offsets[i+1] - offsets[i]; }
+    HandleSeq::const_iterator begin(size_t i) const
+    { return neighbors.begin() + offsets[i]; }
+    HandleSeq::const_iterator end(size_t i) const
+    { return neighbors.begin() + offsets[i+1]; }
+};
+
+/**
+ * The same as get_target_neighbors, get_source_neighbors and
+ * get_all_neighbors, for each of the atoms, with one allocation for
+ * all of them rather than one each. Large batches can be split among
+ * several threads of the Executor.
+ *
+ * @param num_threads  the most threads to use
+ */
+NeighborBatch get_target_neighbors_batch(const HandleSeq& atoms,
+                                         Type desiredLinkType,
+                                         bool match_subtype = false,
+                                         unsigned num_threads = 1);
+NeighborBatch get_source_neighbors_batch(const HandleSeq& atoms,
+                                         Type desiredLinkType,
+                                         bool match_subtype = false,
+                                         unsigned num_threads = 1);
+NeighborBatch get_all_neighbors_batch(const HandleSeq& atoms,
+                                      Type desiredLinkType,
+                                      unsigned num_threads = 1);
 
 /**
  * Return all atoms connected to h up to a given distance. Both
@@ -54,12 +269,30 @@ HandleSeq get_all_neighbors(const Handle& h, Type desiredLinkType);
  * @param h     the center atom
  * @param dist  the maximum distance, or none if negative
  * @return      an UnorderedHandleSet of neighbors
- *
- * XXX FIXME -- this function is curently not used anywhere. Perhaps
- * it should be deleted?
  */
 UnorderedHandleSet get_distant_neighbors(const Handle& h, int dist = 1);
 
+/**
+ * Return the atoms connected to h up to a given distance, by their
+ * distance: the first HandleSeq has the atoms one hop away, the next
+ * the atoms two hops away, and so on. The search is breadth-first,
+ * one level at a time, so each atom is at its shortest distance, and
+ * only the current and the next level are held besides the result.
+ *
+ * @param h            the center atom
+ * @param dist         the maximum distance, or none if negative
+ * @param link_types   follow only the links of these types, or all
+ *                     of them if empty
+ * @param max_results  stop once this many atoms are found, 0 for no
+ *                     limit
+ * @param num_threads  the most Executor threads to expand large levels with
+ */
+std::vector<HandleSeq> get_neighbors_by_distance(const Handle& h,
+                                                 int dist = 1,
+                                                 const std::vector<Type>& link_types = {},
+                                                 size_t max_results = 0,
+                                                 unsigned num_threads = 1);
+
 
 /** @}*/
 }
@@ -0,0 +1,135 @@
+/*
+ * NeighborsSCM.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/guile/SchemePrimitive.h>
+
+#include "Neighbors.h"
+
+namespace opencog
+{
+
+/**
+ * The neighbor helpers that are worth calling from scheme, i.e. those
+ * that do in one call what would take many cog-incoming-by-type.
+ */
+class NeighborsSCM
+{
+private:
+    static void* init_in_guile(void*);
+    static void init_in_module(void*);
+    void init(void);
+
+    ValuePtr target_neighbors_batch(const HandleSeq&, Type, bool, int);
+    ValuePtr source_neighbors_batch(const HandleSeq&, Type, bool, int);
+    ValuePtr all_neighbors_batch(const HandleSeq&, Type, int);
+
+public:
+    NeighborsSCM();
+};
+
+}
+
+using namespace opencog;
+
+NeighborsSCM::NeighborsSCM()
+{
+    static bool is_init = false;
+    if (is_init) return;
+    is_init = true;
+    scm_with_guile(init_in_guile, this);
+}
+
+void* NeighborsSCM::init_in_guile(void* self)
+{
+    scm_c_define_module("opencog neighbors", init_in_module, self);
+    scm_c_use_module("opencog neighbors");
+    return NULL;
+}
+
+void NeighborsSCM::init_in_module(void* data)
+{
+    NeighborsSCM* self = (NeighborsSCM*) data;
+    self->init();
+}
+
+void NeighborsSCM::init()
+{
+    define_scheme_primitive("cog-target-neighbors-batch-c",
+        &NeighborsSCM::target_neighbors_batch, this, "neighbors");
+    define_scheme_primitive("cog-source-neighbors-batch-c",
+        &NeighborsSCM::source_neighbors_batch, this, "neighbors");
+    define_scheme_primitive("cog-all-neighbors-batch-c",
+        &NeighborsSCM::all_neighbors_batch, this, "neighbors");
+}
+
+/**
+ * A LinkValue with a LinkValue of the neighbors of each atom.
+ */
+static ValuePtr to_value(const NeighborBatch& batch)
+{
+    std::vector<ValuePtr> lists;
+    lists.reserve(batch.size());
+    for (size_t i = 0; i < batch.size(); i++)
+        lists.push_back(createLinkValue(
+            std::vector<ValuePtr>(batch.begin(i), batch.end(i))));
+    return createLinkValue(lists);
+}
+
+static unsigned check_threads(int num_threads, const char* fn)
+{
+    if (num_threads < 1)
+        throw InvalidParamException(TRACE_INFO,
+            "%s: Expecting a positive no. of threads, got %d", fn, num_threads);
+    return num_threads;
+}
+
+ValuePtr NeighborsSCM::target_neighbors_batch(const HandleSeq& atoms,
+                                              Type t, bool match_subtype,
+                                              int num_threads)
+{
+    return to_value(get_target_neighbors_batch(atoms, t, match_subtype,
+        check_threads(num_threads, "cog-target-neighbors-batch")));
+}
+
+ValuePtr NeighborsSCM::source_neighbors_batch(const HandleSeq& atoms,
+                                              Type t, bool match_subtype,
+                                              int num_threads)
+{
+    return to_value(get_source_neighbors_batch(atoms, t, match_subtype,
+        check_threads(num_threads, "cog-source-neighbors-batch")));
+}
+
+ValuePtr NeighborsSCM::all_neighbors_batch(const HandleSeq& atoms, Type t,
+                                           int num_threads)
+{
+    return to_value(get_all_neighbors_batch(atoms, t,
+        check_threads(num_threads, "cog-all-neighbors-batch")));
+}
+
+extern "C" {
+void opencog_neighbors_init(void);
+};
+
+void opencog_neighbors_init(void)
+{
+    static NeighborsSCM neighbors;
+}
@@ -0,0 +1,218 @@
+/*
+ * PredicateIndex.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "PredicateIndex.h"
+
+using namespace opencog;
+
+typedef std::unordered_map<const AtomSpace*, std::unique_ptr<PredicateIndex>> IndexRegistry;
+
+static std::mutex& registry_mutex()
+{
+    static std::mutex mtx;
+    return mtx;
+}
+
+static IndexRegistry& registry()
+{
+    static IndexRegistry indexes;
+    return indexes;
+}
+
+// The no. of indexes, so that looking one up costs nothing while there
+// are none.
+static std::atomic<size_t> num_indexes(0);
+
+PredicateIndex& PredicateIndex::enable(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+
+    std::unique_ptr<PredicateIndex>& index = registry()[as];
+    if (index == nullptr) {
+        index.reset(new PredicateIndex(as));
+        num_indexes++;
+    }
+    return *index;
+}
+
+void PredicateIndex::release(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+    if (registry().erase(as)) num_indexes--;
+}
+
+PredicateIndex* PredicateIndex::lookup(const Handle& h)
+{
+    if (0 == num_indexes) return nullptr;
+
+    AtomSpace* as = h->getAtomSpace();
+    if (nullptr == as) return nullptr;
+
+    std::lock_guard<std::mutex> lck(registry_mutex());
+    auto it = registry().find(as);
+    return it == registry().end() ? nullptr : it->second.get();
+}
+
+PredicateIndex::PredicateIndex(AtomSpace* as) :
+    _as(as)
+{
+    // Connect first, so that nothing added during the scan is missed;
+    // add_evaluation() ignores the EvaluationLinks it has already seen.
+    _add_conn = _as->atomAddedSignal().connect(
+        [this](const Handle& h) {
+            if (nameserver().isA(h->get_type(), EVALUATION_LINK))
+                add_evaluation(h); });
+    _remove_conn = _as->atomRemovedSignal().connect(
+        [this](const AtomPtr& a) {
+            if (nameserver().isA(a->get_type(), EVALUATION_LINK))
+                remove_evaluation(Handle(a)); });
+
+    HandleSeq evals;
+    _as->get_handles_by_type(std::back_inserter(evals), EVALUATION_LINK, true);
+
+    for (const Handle& h : evals)
+        add_evaluation(h);
+}
+
+PredicateIndex::~PredicateIndex()
+{
+    _as->atomAddedSignal().disconnect(_add_conn);
+    _as->atomRemovedSignal().disconnect(_remove_conn);
+}
+
+/**
+ * The distinct ListLinks of the EvaluationLink, and the distinct atoms
+ * in each of them; as many as get_predicates would see it for.
+ */
+static HandleSeq get_arguments(const Handle& h)
+{
+    HandleSeq lists;
+    for (const Handle& l : h->getOutgoingSet())
+        if (nameserver().isA(l->get_type(), LIST_LINK) and
+            std::find(lists.begin(), lists.end(), l) == lists.end())
+            lists.emplace_back(l);
+
+    HandleSeq args;
+    for (const Handle& l : lists)
+    {
+        HandleSeq in_l;
+        for (const Handle& a : l->getOutgoingSet())
+            if (std::find(in_l.begin(), in_l.end(), a) == in_l.end())
+                in_l.emplace_back(a);
+        args.insert(args.end(), in_l.begin(), in_l.end());
+    }
+    return args;
+}
+
+void PredicateIndex::add_evaluation(const Handle& h)
+{
+    if (h->get_arity() == 0) return;
+    const Handle& pred = h->getOutgoingAtom(0);
+
+    std::lock_guard<std::mutex> lck(_mtx);
+
+    // Already indexed, e.g. during the initial scan
+    HandleSeq& evals = _by_predicate[pred];
+    if (std::find(evals.begin(), evals.end(), h) != evals.end()) return;
+    evals.emplace_back(h);
+
+    for (const Handle& a : get_arguments(h))
+        _by_argument[a].emplace_back(pred, h);
+}
+
+void PredicateIndex::remove_evaluation(const Handle& h)
+{
+    if (h->get_arity() == 0) return;
+    const Handle& pred = h->getOutgoingAtom(0);
+
+    std::lock_guard<std::mutex> lck(_mtx);
+
+    auto pit = _by_predicate.find(pred);
+    if (pit == _by_predicate.end()) return;
+    HandleSeq& evals = pit->second;
+    evals.erase(std::remove(evals.begin(), evals.end(), h), evals.end());
+    if (evals.empty()) _by_predicate.erase(pit);
+
+    for (const Handle& a : get_arguments(h))
+    {
+        auto ait = _by_argument.find(a);
+        if (ait == _by_argument.end()) continue;
+
+        PredicateSeq& preds = ait->second;
+        preds.erase(std::remove_if(preds.begin(), preds.end(),
+                        [&](const std::pair<Handle, Handle>& pe) {
+                            return pe.second == h; }),
+                    preds.end());
+        if (preds.empty()) _by_argument.erase(ait);
+    }
+}
+
+HandleSeq PredicateIndex::get_predicates(const Handle& target,
+                                         Type predicateType,
+                                         bool subClasses)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+
+    HandleSeq answer;
+    auto it = _by_argument.find(target);
+    if (it == _by_argument.end()) return answer;
+
+    for (const auto& pe : it->second)
+    {
+        Type t = pe.first->get_type();
+        if (t == predicateType or
+            (subClasses and nameserver().isA(t, predicateType)))
+            answer.emplace_back(pe.second);
+    }
+    return answer;
+}
+
+HandleSeq PredicateIndex::get_predicates_for(const Handle& target,
+                                             const Handle& predicate)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+
+    HandleSeq answer;
+    auto it = _by_argument.find(target);
+    if (it == _by_argument.end()) return answer;
+
+    for (const auto& pe : it->second)
+        if (pe.first == predicate)
+            answer.emplace_back(pe.second);
+    return answer;
+}
+
+HandleSeq PredicateIndex::get_evaluations(const Handle& predicate)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+
+    auto it = _by_predicate.find(predicate);
+    if (it == _by_predicate.end()) return HandleSeq();
+    return it->second;
+}
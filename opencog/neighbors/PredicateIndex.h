@@ -0,0 +1,125 @@
+/*
+ * PredicateIndex.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_PREDICATE_INDEX_H
+#define _OPENCOG_PREDICATE_INDEX_H
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/atom_types/types.h>
+
+namespace opencog
+{
+class AtomSpace;
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * An index of the EvaluationLinks of an AtomSpace, by the atoms in
+ * their ListLinks and by their predicates:
+ *
+ *     EvaluationLink
+ *        PredicateNode "IsA"
+ *        ListLink
+ *           ConceptNode "dog"
+ *           ConceptNode "mammal"
+ *
+ * is found from "dog", from "mammal", and from "IsA". get_predicates
+ * and get_predicates_for answer from it, instead of walking incoming
+ * sets, for the AtomSpaces it is enabled for.
+ *
+ * There is at most one index per AtomSpace. It is built by scanning the
+ * EvaluationLinks once, and then kept up to date from the AtomSpace's
+ * add and remove signals.
+ */
+class PredicateIndex
+{
+public:
+    ~PredicateIndex();
+
+    /**
+     * Build the index of the given AtomSpace, if it hasn't one yet, and
+     * return it.
+     */
+    static PredicateIndex& enable(AtomSpace* as);
+
+    /**
+     * Drop the index of the given AtomSpace.  This must be called
+     * before the AtomSpace goes away, as the index is connected to its
+     * signals.
+     */
+    static void release(AtomSpace* as);
+
+    /**
+     * The index of the AtomSpace of the atom, or nullptr if it hasn't
+     * been enabled.
+     */
+    static PredicateIndex* lookup(const Handle& h);
+
+    /**
+     * The EvaluationLinks with a ListLink that the target is in, and
+     * a predicate of the given type; see get_predicates.
+     */
+    HandleSeq get_predicates(const Handle& target, Type predicateType,
+                             bool subClasses);
+
+    /**
+     * The EvaluationLinks with a ListLink that the target is in, and
+     * the given predicate; see get_predicates_for.
+     */
+    HandleSeq get_predicates_for(const Handle& target,
+                                 const Handle& predicate);
+
+    /**
+     * All the EvaluationLinks of the given predicate.
+     */
+    HandleSeq get_evaluations(const Handle& predicate);
+
+private:
+    PredicateIndex(AtomSpace* as);
+
+    void add_evaluation(const Handle& h);
+    void remove_evaluation(const Handle& h);
+
+    AtomSpace* _as;
+    int _add_conn;
+    int _remove_conn;
+
+    std::mutex _mtx;
+
+    // For each atom, the (predicate, EvaluationLink) pairs it is an
+    // argument of, once for each ListLink of the EvaluationLink it is in;
+    // and for each predicate, its EvaluationLinks.
+    typedef std::vector<std::pair<Handle, Handle>> PredicateSeq;
+    std::unordered_map<Handle, PredicateSeq> _by_argument;
+    std::unordered_map<Handle, HandleSeq> _by_predicate;
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_PREDICATE_INDEX_H
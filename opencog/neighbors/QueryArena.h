@@ -0,0 +1,110 @@
+/*
+ * QueryArena.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_QUERY_ARENA_H
+#define _OPENCOG_QUERY_ARENA_H
+
+#include <memory>
+#include <memory_resource>
+#include <set>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * The memory for the short-lived containers of a query, e.g. the ones
+ * a pattern matcher callback builds every time it is called.
+ *
+ * The memory comes from a monotonic buffer, starting with one of the
+ * given size, and is only given back to the global allocator as a
+ * whole, by release() or when the arena goes away.  Blocks that are
+ * freed in the meantime are pooled, so that the next callback reuses
+ * them instead of growing the buffer.
+ *
+ * An arena is not meant to be shared between threads.  A copy of an
+ * arena is a new, empty one, so that a matcher that is copied for
+ * another thread gets an arena of its own.
+ */
+class QueryArena : public std::pmr::memory_resource
+{
+public:
+    explicit QueryArena(size_t initial_size = 16 * 1024) :
+        _initial_size(initial_size),
+        _buffer(new char[initial_size]),
+        _monotonic(_buffer.get(), initial_size,
+                   std::pmr::new_delete_resource()),
+        _pool(&_monotonic)
+    {}
+
+    QueryArena(const QueryArena& other) :
+        QueryArena(other._initial_size)
+    {}
+
+    QueryArena& operator=(const QueryArena&) { return *this; }
+
+    // Give back all the memory, other than the initial buffer; nothing
+    // allocated from the arena may be used after this
+    void release()
+    {
+        _pool.release();
+        _monotonic.release();
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        return _pool.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        _pool.deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    size_t _initial_size;
+    std::unique_ptr<char[]> _buffer;
+    std::pmr::monotonic_buffer_resource _monotonic;
+    std::pmr::unsynchronized_pool_resource _pool;
+};
+
+// Containers taking their memory from a QueryArena, e.g.
+//     ArenaHandleSeq seq(&arena);
+// They can be filled with the output-iterator versions of the neighbor
+// helpers, or getIncomingSetByType, through a back_inserter.
+typedef std::pmr::vector<Handle> ArenaHandleSeq;
+typedef std::pmr::set<Handle> ArenaHandleSet;
+
+/** @}*/
+}
+
+#endif // _OPENCOG_QUERY_ARENA_H
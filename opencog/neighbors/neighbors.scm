@@ -0,0 +1,52 @@
+;
+; neighbors.scm
+;
+; Neighbor queries over many atoms at once.
+;
+(define-module (opencog neighbors))
+
+(use-modules (opencog) (opencog oc-config))
+
+(load-extension (string-append opencog-ext-path-neighbors "libneighbors-scm") "opencog_neighbors_init")
+
+(use-modules (ice-9 optargs))
+
+; ---------------------------------------------------------------------
+
+(define*-public (cog-target-neighbors-batch ATOMS TYPE
+		#:key (subtypes #f) (threads 1))
+"
+  cog-target-neighbors-batch ATOMS TYPE [#:subtypes BOOL] [#:threads N]
+
+  For each of the ATOMS, get the atoms that it links to with the links
+  of TYPE, i.e. the other atoms of the links of TYPE that it is the
+  first atom of; also with the links of the subtypes of TYPE if BOOL is
+  true. Returns a LinkValue with a LinkValue of them for each of the
+  ATOMS, in the same order. Large lists of ATOMS can be split among N
+  threads.
+
+  Example:
+     (cog-value->list (cog-target-neighbors-batch
+        (list (WordInstanceNode \"cat@1\") (WordInstanceNode \"dog@2\"))
+        'ReferenceLink))
+"
+	(cog-target-neighbors-batch-c ATOMS TYPE subtypes threads))
+
+(define*-public (cog-source-neighbors-batch ATOMS TYPE
+		#:key (subtypes #f) (threads 1))
+"
+  cog-source-neighbors-batch ATOMS TYPE [#:subtypes BOOL] [#:threads N]
+
+  The same as cog-target-neighbors-batch, for the links of TYPE that
+  each of the ATOMS is in but not the first atom of.
+"
+	(cog-source-neighbors-batch-c ATOMS TYPE subtypes threads))
+
+(define*-public (cog-all-neighbors-batch ATOMS TYPE #:key (threads 1))
+"
+  cog-all-neighbors-batch ATOMS TYPE [#:threads N]
+
+  The same as cog-target-neighbors-batch, for all the links of TYPE
+  that each of the ATOMS is in, wherever it is in them.
+"
+	(cog-all-neighbors-batch-c ATOMS TYPE threads))
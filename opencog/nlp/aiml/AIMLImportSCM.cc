@@ -0,0 +1,97 @@
+/*
+ * AIMLImportSCM.cc
+ *
+ * Scheme bindings of the AIML importer.
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/guile/SchemePrimitive.h>
+#include <opencog/guile/SchemeSmob.h>
+
+#include "AIMLImporter.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+namespace opencog
+{
+namespace nlp
+{
+
+class AIMLImportSCM
+{
+private:
+    static void* init_in_guile(void*);
+    static void init_in_module(void*);
+    void init(void);
+
+    int import_file(const std::string&, double);
+
+public:
+    AIMLImportSCM(void);
+};
+
+}
+}
+
+AIMLImportSCM::AIMLImportSCM(void)
+{
+    static bool is_init = false;
+    if (is_init) return;
+    is_init = true;
+    scm_with_guile(init_in_guile, this);
+}
+
+void* AIMLImportSCM::init_in_guile(void* self)
+{
+    scm_c_define_module("opencog nlp aiml import", init_in_module, self);
+    scm_c_use_module("opencog nlp aiml import");
+    return NULL;
+}
+
+void AIMLImportSCM::init_in_module(void* data)
+{
+    AIMLImportSCM* self = (AIMLImportSCM*) data;
+    self->init();
+}
+
+void AIMLImportSCM::init(void)
+{
+    define_scheme_primitive("aiml-import-file",
+        &AIMLImportSCM::import_file, this, "nlp aiml import");
+}
+
+/**
+ * Implement the "aiml-import-file" scheme primitive.
+ */
+int AIMLImportSCM::import_file(const std::string& path, double priority)
+{
+    AIMLImporter importer(SchemeSmob::ss_get_env_as("aiml-import-file"));
+    importer.set_priority(priority);
+    return importer.import_file(path);
+}
+
+extern "C" {
+void opencog_nlp_aiml_import_init(void);
+};
+
+void opencog_nlp_aiml_import_init(void)
+{
+    static AIMLImportSCM aiml_import;
+}
@@ -0,0 +1,511 @@
+/*
+ * AIMLImporter.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/nlp/types/atom_types.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+
+#include "AIMLImporter.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+// The number of rules added to OpenPsiRules at a time
+#define DEFAULT_BATCH_SIZE 500
+
+static std::string lower(std::string s)
+{
+    for (char& c : s) c = std::tolower((unsigned char) c);
+    return s;
+}
+
+static std::string trim(const std::string& s)
+{
+    size_t b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) return "";
+    size_t e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+/**
+ * Strip the punctuation around a word, as trim_punct in aiml2psi.pl
+ * does; the star, the underscore, and the question and exclamation
+ * marks are kept.
+ */
+static std::string trim_punct(std::string w)
+{
+    static const char* punct = ".'(){}-:;,\"\\/<>";
+
+    size_t b = w.find_first_not_of(punct);
+    if (b == std::string::npos) return "";
+    w = w.substr(b, w.find_last_not_of(punct) - b + 1);
+
+    size_t pos;
+    while ((pos = w.find("\\\"")) != std::string::npos)
+        w.erase(pos, 2);
+    std::replace(w.begin(), w.end(), '\\', '/');
+    return w;
+}
+
+static std::string attr_of(const AIMLReader::Attributes& attrs,
+                           const std::string& key)
+{
+    for (const auto& kv : attrs)
+        if (kv.first == key) return kv.second;
+    return "";
+}
+
+std::string AIMLImporter::Element::attr(const std::string& key) const
+{
+    return attr_of(attrs, key);
+}
+
+bool AIMLImporter::Element::has_elements(void) const
+{
+    for (const Element& e : children)
+        if (not e.name.empty()) return true;
+    return false;
+}
+
+AIMLImporter::AIMLImporter(AtomSpace* as) :
+    m_as(as),
+    m_rules(openpsi_cache(as)),
+    m_priority(1.0),
+    m_batch_size(DEFAULT_BATCH_SIZE),
+    m_in_category(false),
+    m_added(0)
+{
+    m_goal = m_as->add_node(CONCEPT_NODE, "AIML chat subsystem goal");
+
+    // as psi-demand makes it
+    m_demand = m_as->add_node(CONCEPT_NODE, "AIML chat demand");
+    m_as->add_link(INHERITANCE_LINK, m_demand,
+                   m_as->add_node(CONCEPT_NODE, "OpenPsi: demand"));
+}
+
+size_t AIMLImporter::import(std::istream& in)
+{
+    m_added = 0;
+    m_topic.clear();
+    m_in_category = false;
+    m_open.clear();
+    m_batch.clear();
+
+    AIMLReader reader(in, *this);
+    reader.parse();
+    flush();
+
+    return m_added;
+}
+
+size_t AIMLImporter::import_file(const std::string& path)
+{
+    std::ifstream in(path);
+    if (not in)
+        throw RuntimeException(TRACE_INFO,
+            "Can't open the AIML file %s", path.c_str());
+
+    size_t n = import(in);
+    logger().info("[AIMLImporter] Added %zu rules from %s", n, path.c_str());
+    return n;
+}
+
+void AIMLImporter::start_element(const std::string& name,
+                                 const AIMLReader::Attributes& attrs)
+{
+    if (not m_in_category)
+    {
+        if (name == "category")
+        {
+            m_in_category = true;
+            m_category = Element{name, attrs, "", {}};
+            m_open.push_back(&m_category);
+        }
+        else if (name == "topic")
+            m_topic = attr_of(attrs, "name");
+        return;
+    }
+
+    // Adding a child moves only its siblings, which are all closed
+    std::vector<Element>& siblings = m_open.back()->children;
+    siblings.push_back(Element{name, attrs, "", {}});
+    m_open.push_back(&siblings.back());
+}
+
+void AIMLImporter::end_element(const std::string& name)
+{
+    if (not m_in_category)
+    {
+        if (name == "topic") m_topic.clear();
+        return;
+    }
+
+    m_open.pop_back();
+    if (m_open.empty())
+    {
+        m_in_category = false;
+        add_category();
+        m_category = Element();
+    }
+}
+
+void AIMLImporter::characters(const std::string& text)
+{
+    if (not m_in_category) return;
+
+    std::vector<Element>& siblings = m_open.back()->children;
+    if (siblings.empty() or not siblings.back().name.empty())
+        siblings.push_back(Element());
+    siblings.back().text += text;
+}
+
+/**
+ * Make the rules of the category just read.
+ */
+void AIMLImporter::add_category(void)
+{
+    const Element* pattern = nullptr;
+    const Element* topic = nullptr;
+    const Element* that = nullptr;
+    const Element* templ = nullptr;
+    for (const Element& e : m_category.children)
+    {
+        if (e.name == "pattern") pattern = &e;
+        else if (e.name == "topic") topic = &e;
+        else if (e.name == "that") that = &e;
+        else if (e.name == "template") templ = &e;
+    }
+
+    if (pattern == nullptr)
+    {
+        logger().warn("[AIMLImporter] Skipped a category with no pattern");
+        return;
+    }
+
+    Element outer_topic{"topic", {}, "", {Element{"", {}, m_topic, {}}}};
+    if (topic == nullptr) topic = &outer_topic;
+
+    // A topic or that of "*" is the same as none
+    auto is_any = [](const Element* e) {
+        if (e == nullptr) return true;
+        if (e->has_elements()) return false;
+        std::string s;
+        for (const Element& c : e->children) s += c.text;
+        s = trim(s);
+        return s.empty() or s == "*";
+    };
+
+    size_t nwords = 0;
+    HandleSeq clauses;
+    clauses.push_back(predicate("*-AIML-pattern-*", *pattern, nwords));
+    size_t ignored = 0;
+    if (not is_any(topic))
+        clauses.push_back(predicate("*-AIML-topic-*", *topic, ignored));
+    if (not is_any(that))
+        clauses.push_back(predicate("*-AIML-that-*", *that, ignored));
+    Handle context(m_as->add_link(AND_LINK, std::move(clauses)));
+
+    // A template that is just text keeps its case; see aiml2psi.pl
+    std::vector<HandleSeq> actions;
+    if (templ == nullptr)
+        actions.push_back(HandleSeq());
+    else if (not templ->has_elements())
+    {
+        std::string text;
+        for (const Element& c : templ->children) text += c.text;
+        actions.push_back(atomic_template(text));
+    }
+    else
+        actions = template_atoms(templ->children);
+
+    // The weight aiml2psi.pl gives, which favours the longer patterns.
+    // It passes the number of stars too, but its count has always been
+    // reset by then, so it is left out here, and the rules weigh the
+    // same whichever of the two made them.
+    double kill = std::min(1.0, (0.5 + nwords) * 0.1);
+    double weight = m_priority * kill / actions.size();
+
+    for (HandleSeq& action : actions)
+    {
+        OpenPsiRules::RuleDecl d;
+        d.context = {context};
+        d.action = m_as->add_link(LIST_LINK, std::move(action));
+        d.goal = m_goal;
+        d.stv = SimpleTruthValue::createTV(1.0, weight);
+        d.categories = {m_demand};
+        m_batch.push_back(std::move(d));
+    }
+
+    if (m_batch_size <= m_batch.size()) flush();
+}
+
+void AIMLImporter::flush(void)
+{
+    if (m_batch.empty()) return;
+
+    m_added += m_rules.add_rules(m_batch).size();
+    m_batch.clear();
+}
+
+// ---------------------------------------------------------------
+// The pattern, topic and that
+
+Handle AIMLImporter::glob(size_t index)
+{
+    return m_as->add_node(GLOB_NODE, "$star-" + std::to_string(index));
+}
+
+/**
+ * Add the words of the text, with a GlobNode for each star.  The stars
+ * are numbered if nstars is given, and are all the first star if not,
+ * as in a template.
+ */
+void AIMLImporter::add_words(const std::string& text, HandleSeq& out,
+                             size_t* nstars, size_t& nwords)
+{
+    std::istringstream words(text);
+    std::string w;
+    while (words >> w)
+    {
+        w = trim_punct(w);
+        if (w.empty()) continue;
+
+        if (w == "*" or w == "_")
+            out.push_back(glob(nstars ? ++*nstars : 1));
+        else
+        {
+            out.push_back(m_as->add_node(WORD_NODE, std::move(w)));
+            nwords++;
+        }
+    }
+}
+
+Handle AIMLImporter::predicate(const char* anchor, const Element& e,
+                               size_t& nwords)
+{
+    HandleSeq words;
+    size_t nstars = 0;
+    pattern_atoms(e, words, nstars, nwords);
+
+    return m_as->add_link(EVALUATION_LINK,
+        m_as->add_node(PREDICATE_NODE, anchor),
+        m_as->add_link(LIST_LINK, std::move(words)));
+}
+
+void AIMLImporter::pattern_atoms(const Element& e, HandleSeq& out,
+                                 size_t& nstars, size_t& nwords)
+{
+    for (const Element& c : e.children)
+    {
+        if (c.name.empty())
+            add_words(lower(c.text), out, &nstars, nwords);
+        else if (c.name == "bot")
+            out.push_back(tag("bot", {}, m_as->add_node(CONCEPT_NODE,
+                lower(c.attr("name"))))[0][0]);
+        else
+            pattern_atoms(c, out, nstars, nwords);
+    }
+}
+
+// ---------------------------------------------------------------
+// The template
+
+/**
+ * A template that has no tags is a list of words, with their case.
+ * Any markup escaped in it, e.g. for a text-to-speech system, is left
+ * out, and long dashes are made into words of their own.
+ */
+HandleSeq AIMLImporter::atomic_template(const std::string& text)
+{
+    std::string plain;
+    bool in_markup = false;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        char c = text[i];
+        if (c == '<') in_markup = true;
+        else if (c == '>' and in_markup) in_markup = false;
+        else if (in_markup) continue;
+        else if (c == '-' and i + 1 < text.size() and text[i+1] == '-')
+        {
+            size_t end = text.find_first_not_of('-', i);
+            if (end == std::string::npos) end = text.size();
+            plain += " " + text.substr(i, end - i) + " ";
+            i = end - 1;
+        }
+        else plain += c;
+    }
+
+    HandleSeq words;
+    std::istringstream in(plain);
+    std::string w;
+    while (in >> w)
+    {
+        w = trim_punct(w);
+        if (not w.empty())
+            words.push_back(m_as->add_node(WORD_NODE, std::move(w)));
+    }
+    return words;
+}
+
+/**
+ * The atoms of a sequence of elements.  Each <random> in it gives a
+ * choice of atoms, so there is a sequence for each combination of the
+ * choices.
+ */
+std::vector<HandleSeq> AIMLImporter::template_atoms(
+    const std::vector<Element>& es)
+{
+    std::vector<HandleSeq> seqs(1);
+    for (const Element& e : es)
+    {
+        std::vector<HandleSeq> alts(template_atoms(e));
+        if (1 == alts.size())
+        {
+            for (HandleSeq& s : seqs)
+                s.insert(s.end(), alts[0].begin(), alts[0].end());
+            continue;
+        }
+
+        std::vector<HandleSeq> product;
+        for (const HandleSeq& s : seqs)
+        {
+            for (const HandleSeq& a : alts)
+            {
+                HandleSeq sa(s);
+                sa.insert(sa.end(), a.begin(), a.end());
+                product.push_back(std::move(sa));
+            }
+        }
+        seqs = std::move(product);
+    }
+    return seqs;
+}
+
+/**
+ * The ExecutionOutputLinks of a tag that is run on the given atoms,
+ * one for each choice of them.
+ */
+std::vector<HandleSeq> AIMLImporter::tag(const std::string& tag,
+                                         const std::vector<HandleSeq>& args,
+                                         const Handle& name)
+{
+    Handle schema(m_as->add_node(DEFINED_SCHEMA_NODE, "AIML-tag " + tag));
+
+    std::vector<HandleSeq> out;
+    if (args.empty())
+    {
+        out.push_back({m_as->add_link(EXECUTION_OUTPUT_LINK, schema,
+            m_as->add_link(LIST_LINK, name))});
+        return out;
+    }
+
+    for (const HandleSeq& a : args)
+    {
+        HandleSeq list;
+        if (name) list.push_back(name);
+        list.push_back(m_as->add_link(LIST_LINK, HandleSeq(a)));
+        out.push_back({m_as->add_link(EXECUTION_OUTPUT_LINK, schema,
+            m_as->add_link(LIST_LINK, std::move(list)))});
+    }
+    return out;
+}
+
+/**
+ * The atoms of an element of the template, as aiml2psi.pl makes them.
+ * The tags that the AIML rules of aiml.scm don't run, and markup meant
+ * for a web page, are left out, keeping their text.
+ */
+std::vector<HandleSeq> AIMLImporter::template_atoms(const Element& e)
+{
+    const std::string& n = e.name;
+
+    if (n.empty())
+    {
+        HandleSeq words;
+        size_t nwords = 0;
+        add_words(lower(e.text), words, nullptr, nwords);
+        return {words};
+    }
+
+    if (n == "random")
+    {
+        std::vector<HandleSeq> choices;
+        for (const Element& li : e.children)
+        {
+            if (li.name != "li") continue;
+            for (HandleSeq& c : template_atoms(li.children))
+                if (not c.empty()) choices.push_back(std::move(c));
+        }
+        if (choices.empty()) choices.resize(1);
+        return choices;
+    }
+
+    // <star index='2'/>, <that index='2,1'/> and the like
+    size_t index = std::max(1, atoi(e.attr("index").c_str()));
+
+    if (n == "star")
+        return {{glob(index)}};
+
+    if (n == "sr")
+        return tag("srai", {{glob(1)}});
+
+    if (n == "srai" or n == "think" or n == "formal")
+        return tag(n, template_atoms(e.children));
+
+    // The short forms apply to the star
+    if (n == "person" or n == "person2" or n == "gender")
+    {
+        bool empty = true;
+        for (const Element& c : e.children)
+            if (not c.name.empty() or not trim(c.text).empty()) empty = false;
+        if (empty) return tag(n, {{glob(1)}});
+        return tag(n, template_atoms(e.children));
+    }
+
+    if (n == "set")
+        return tag(n, template_atoms(e.children),
+            m_as->add_node(CONCEPT_NODE, lower(e.attr("name"))));
+
+    if (n == "get" or n == "bot")
+        return tag(n, {}, m_as->add_node(CONCEPT_NODE, lower(e.attr("name"))));
+
+    // The old <get_name/> form of <get name='name'/>
+    if (0 == n.compare(0, 4, "get_"))
+        return tag("get", {}, m_as->add_node(CONCEPT_NODE, n.substr(4)));
+
+    if (n == "that" or n == "input")
+        return tag(n, {}, m_as->add_node(NUMBER_NODE, std::to_string(index)));
+
+    if (n == "condition" or n == "date" or n == "size" or n == "id" or
+        n == "topicstar" or n == "thatstar" or n == "img" or
+        n == "system" or n == "javascript" or n == "learn")
+        return {HandleSeq()};
+
+    return template_atoms(e.children);
+}
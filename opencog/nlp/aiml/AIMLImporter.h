@@ -0,0 +1,142 @@
+/*
+ * AIMLImporter.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_NLP_AIML_IMPORTER_H
+#define _OPENCOG_NLP_AIML_IMPORTER_H
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/openpsi/OpenPsiRules.h>
+
+#include "AIMLReader.h"
+
+namespace opencog
+{
+class AtomSpace;
+
+namespace nlp
+{
+
+/**
+ * Turns AIML files into OpenPsi rules, as import/aiml2psi.pl and
+ * loading its output does, without going through Scheme.  The file is
+ * streamed through an AIMLReader, and each category is made into atoms
+ * as soon as it has been read, so memory use doesn't grow with the
+ * size of the file: only the current category, and the rules not yet
+ * added, are kept.  The rules are added to OpenPsiRules in batches,
+ * with add_rules.
+ *
+ * The rules are those aiml2psi.pl writes:
+ *
+ *    (psi-rule
+ *       (list (And
+ *          (Evaluation (Predicate "*-AIML-pattern-*") (List words...))
+ *          (Evaluation (Predicate "*-AIML-topic-*") (List words...))
+ *          (Evaluation (Predicate "*-AIML-that-*") (List words...))))
+ *       (List template...)
+ *       (Concept "AIML chat subsystem goal")
+ *       (stv 1 weight)
+ *       (psi-demand "AIML chat demand"))
+ *
+ * with one rule per choice of the <random> tags of the template.  The
+ * --weights and --last-only options of aiml2psi.pl are not supported.
+ */
+class AIMLImporter : private AIMLReader::Handler
+{
+public:
+    AIMLImporter(AtomSpace* as);
+
+    // The weight of a rule is scaled by the priority, as with the
+    // --priority option of aiml2psi.pl
+    void set_priority(double priority) { m_priority = priority; }
+
+    // The number of rules added to OpenPsiRules at a time
+    void set_batch_size(size_t n) { m_batch_size = (0 < n) ? n : 1; }
+
+    // Import a stream or a file; returns the number of rules added
+    size_t import(std::istream& in);
+    size_t import_file(const std::string& path);
+
+private:
+    // An element of the category being read, or a run of text if the
+    // name is empty
+    struct Element
+    {
+        std::string name;
+        AIMLReader::Attributes attrs;
+        std::string text;
+        std::vector<Element> children;
+
+        std::string attr(const std::string& key) const;
+        bool has_elements(void) const;
+    };
+
+    void start_element(const std::string& name,
+                       const AIMLReader::Attributes& attrs);
+    void end_element(const std::string& name);
+    void characters(const std::string& text);
+
+    void add_category(void);
+    void flush(void);
+
+    Handle predicate(const char* anchor, const Element& e, size_t& nwords);
+    void pattern_atoms(const Element& e, HandleSeq& out, size_t& nstars,
+                       size_t& nwords);
+
+    std::vector<HandleSeq> template_atoms(const std::vector<Element>& es);
+    std::vector<HandleSeq> template_atoms(const Element& e);
+    std::vector<HandleSeq> tag(const std::string& tag,
+                               const std::vector<HandleSeq>& args,
+                               const Handle& name = Handle::UNDEFINED);
+    HandleSeq atomic_template(const std::string& text);
+
+    void add_words(const std::string& text, HandleSeq& out, size_t* nstars,
+                   size_t& nwords);
+    Handle glob(size_t index);
+
+    AtomSpace* m_as;
+    OpenPsiRules& m_rules;
+    double m_priority;
+    size_t m_batch_size;
+
+    Handle m_goal;
+    Handle m_demand;
+
+    // The topic of the enclosing <topic> element, if any
+    std::string m_topic;
+
+    // The category being read; m_open is the path to the element that
+    // is open in it
+    bool m_in_category;
+    Element m_category;
+    std::vector<Element*> m_open;
+
+    std::vector<OpenPsiRules::RuleDecl> m_batch;
+    size_t m_added;
+};
+
+}
+}
+
+#endif // _OPENCOG_NLP_AIML_IMPORTER_H
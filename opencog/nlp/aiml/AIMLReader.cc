@@ -0,0 +1,314 @@
+/*
+ * AIMLReader.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include <opencog/util/exceptions.h>
+
+#include "AIMLReader.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+static bool is_name_char(int c)
+{
+    return std::isalnum(c) or c == '_' or c == '-' or c == '.' or
+           c == ':' or 0x80 <= c;
+}
+
+AIMLReader::AIMLReader(std::istream& in, Handler& handler) :
+    m_in(in),
+    m_handler(handler),
+    m_line(1)
+{
+}
+
+int AIMLReader::get(void)
+{
+    int c = m_in.get();
+    if (c == '\n') m_line++;
+    return c;
+}
+
+int AIMLReader::peek(void)
+{
+    return m_in.peek();
+}
+
+void AIMLReader::expect(const char* s)
+{
+    for (; *s; s++)
+    {
+        if (get() != *s)
+            throw SyntaxException(TRACE_INFO,
+                "AIML line %zu: expecting \"%s\"", m_line, s);
+    }
+}
+
+// Skip past the given string, e.g. the end of a comment. The last few
+// characters read are compared with it, as a partial match can overlap
+// the real one, e.g. the "--" of "--->".
+void AIMLReader::skip_until(const char* end)
+{
+    size_t len = strlen(end);
+    std::string last;
+    while (last.size() < len or last.compare(last.size() - len, len, end))
+    {
+        int c = get();
+        if (c == EOF)
+            throw SyntaxException(TRACE_INFO,
+                "AIML line %zu: expecting \"%s\" before the end", m_line, end);
+        last += (char) c;
+        if (2 * len < last.size()) last.erase(0, last.size() - len);
+    }
+}
+
+void AIMLReader::skip_space(void)
+{
+    while (std::isspace(peek())) get();
+}
+
+void AIMLReader::parse(void)
+{
+    int c;
+    while ((c = get()) != EOF)
+    {
+        if (c == '<')
+        {
+            flush_text();
+            read_tag();
+        }
+        else if (c == '&')
+            read_entity(m_text);
+        else
+            m_text += (char) c;
+    }
+    flush_text();
+
+    if (not m_open.empty())
+        throw SyntaxException(TRACE_INFO,
+            "AIML line %zu: <%s> is not closed", m_line, m_open.back().c_str());
+}
+
+// Text outside of the top element, e.g. the newline after the XML
+// declaration, is of no use to anyone.
+void AIMLReader::flush_text(void)
+{
+    if (not m_open.empty() and not m_text.empty())
+        m_handler.characters(m_text);
+    m_text.clear();
+}
+
+/**
+ * Read a tag, its opening "<" already read.
+ */
+void AIMLReader::read_tag(void)
+{
+    int c = peek();
+    if (c == '!' or c == '?')
+    {
+        read_markup();
+        return;
+    }
+
+    if (c == '/')
+    {
+        get();
+        std::string name = read_name();
+        skip_space();
+        expect(">");
+
+        if (m_open.empty() or m_open.back() != name)
+            throw SyntaxException(TRACE_INFO,
+                "AIML line %zu: </%s> does not close <%s>", m_line,
+                name.c_str(), m_open.empty() ? "" : m_open.back().c_str());
+        m_open.pop_back();
+        m_handler.end_element(name);
+        return;
+    }
+
+    std::string name = read_name();
+    Attributes attrs;
+    while (true)
+    {
+        skip_space();
+        c = peek();
+        if (c == '>' or c == '/' or c == EOF) break;
+
+        std::string key = read_name();
+        skip_space();
+        expect("=");
+        skip_space();
+        attrs.emplace_back(key, read_value());
+    }
+
+    bool empty = (c == '/');
+    if (empty) get();
+    expect(">");
+
+    m_open.push_back(name);
+    m_handler.start_element(name, attrs);
+    if (empty)
+    {
+        m_open.pop_back();
+        m_handler.end_element(name);
+    }
+}
+
+/**
+ * Comments, CDATA sections, the DOCTYPE and processing instructions.
+ */
+void AIMLReader::read_markup(void)
+{
+    if (get() == '?')
+    {
+        skip_until("?>");
+        return;
+    }
+
+    if (peek() == '-')
+    {
+        expect("--");
+        skip_until("-->");
+        return;
+    }
+
+    if (peek() == '[')
+    {
+        expect("[CDATA[");
+        size_t start = m_text.size();
+        while (m_text.size() < start + 3 or
+               m_text.compare(m_text.size() - 3, 3, "]]>") != 0)
+        {
+            int c = get();
+            if (c == EOF)
+                throw SyntaxException(TRACE_INFO,
+                    "AIML line %zu: CDATA section is not closed", m_line);
+            m_text += (char) c;
+        }
+        m_text.resize(m_text.size() - 3);
+        return;
+    }
+
+    // The DOCTYPE, with an internal subset if any
+    int depth = 0;
+    int c;
+    while ((c = get()) != EOF)
+    {
+        if (c == '[') depth++;
+        else if (c == ']') depth--;
+        else if (c == '>' and depth <= 0) return;
+    }
+    throw SyntaxException(TRACE_INFO,
+        "AIML line %zu: declaration is not closed", m_line);
+}
+
+std::string AIMLReader::read_name(void)
+{
+    std::string name;
+    while (is_name_char(peek()))
+        name += (char) std::tolower(get());
+
+    if (name.empty())
+        throw SyntaxException(TRACE_INFO,
+            "AIML line %zu: expecting a name", m_line);
+    return name;
+}
+
+std::string AIMLReader::read_value(void)
+{
+    int quote = get();
+    if (quote != '"' and quote != '\'')
+        throw SyntaxException(TRACE_INFO,
+            "AIML line %zu: expecting a quoted attribute value", m_line);
+
+    std::string value;
+    int c;
+    while ((c = get()) != quote)
+    {
+        if (c == EOF)
+            throw SyntaxException(TRACE_INFO,
+                "AIML line %zu: attribute value is not closed", m_line);
+        if (c == '&')
+            read_entity(value);
+        else
+            value += (char) c;
+    }
+    return value;
+}
+
+/**
+ * Decode an entity, its "&" already read.  Ones that aren't known,
+ * such as the HTML ones that turn up in AIML files, are kept as they
+ * are.
+ */
+void AIMLReader::read_entity(std::string& out)
+{
+    std::string ent;
+    while (ent.size() < 10 and (std::isalnum(peek()) or peek() == '#'))
+        ent += (char) get();
+
+    if (peek() != ';')
+    {
+        out += '&';
+        out += ent;
+        return;
+    }
+    get();
+
+    if (ent == "lt") out += '<';
+    else if (ent == "gt") out += '>';
+    else if (ent == "amp") out += '&';
+    else if (ent == "quot") out += '"';
+    else if (ent == "apos") out += '\'';
+    else if (1 < ent.size() and ent[0] == '#')
+    {
+        unsigned long cp = (ent[1] == 'x' or ent[1] == 'X') ?
+            strtoul(ent.c_str() + 2, nullptr, 16) :
+            strtoul(ent.c_str() + 1, nullptr, 10);
+
+        // as UTF-8
+        if (cp < 0x80)
+            out += (char) cp;
+        else if (cp < 0x800)
+        {
+            out += (char) (0xc0 | (cp >> 6));
+            out += (char) (0x80 | (cp & 0x3f));
+        }
+        else if (cp < 0x10000)
+        {
+            out += (char) (0xe0 | (cp >> 12));
+            out += (char) (0x80 | ((cp >> 6) & 0x3f));
+            out += (char) (0x80 | (cp & 0x3f));
+        }
+        else
+        {
+            out += (char) (0xf0 | (cp >> 18));
+            out += (char) (0x80 | ((cp >> 12) & 0x3f));
+            out += (char) (0x80 | ((cp >> 6) & 0x3f));
+            out += (char) (0x80 | (cp & 0x3f));
+        }
+    }
+    else
+        out += "&" + ent + ";";
+}
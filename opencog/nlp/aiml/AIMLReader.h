@@ -0,0 +1,97 @@
+/*
+ * AIMLReader.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_NLP_AIML_READER_H
+#define _OPENCOG_NLP_AIML_READER_H
+
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace opencog
+{
+namespace nlp
+{
+
+/**
+ * A small streaming XML reader, enough for AIML files.  The input is
+ * read a character at a time, and each element and run of text is
+ * handed to the Handler as soon as it has been read, SAX style, so
+ * nothing but the current tag and the names of the open elements is
+ * kept, whatever the size of the file.
+ *
+ * Element and attribute names are lower-cased, as AIML files in the
+ * wild use both cases.  The five predefined entities and character
+ * references are decoded; comments, processing instructions and the
+ * DOCTYPE are skipped, and CDATA sections are passed on as text.
+ * Malformed XML, e.g. a closing tag that doesn't match the open
+ * element, throws a SyntaxException giving the line.
+ */
+class AIMLReader
+{
+public:
+    typedef std::vector<std::pair<std::string, std::string>> Attributes;
+
+    class Handler
+    {
+    public:
+        virtual ~Handler() {}
+        virtual void start_element(const std::string& name,
+                                   const Attributes& attrs) = 0;
+        virtual void end_element(const std::string& name) = 0;
+        virtual void characters(const std::string& text) = 0;
+    };
+
+    AIMLReader(std::istream& in, Handler& handler);
+
+    // Read the whole input
+    void parse(void);
+
+    size_t line(void) const { return m_line; }
+
+private:
+    int get(void);
+    int peek(void);
+    void expect(const char* s);
+    void skip_until(const char* end);
+
+    void read_tag(void);
+    void read_markup(void);
+    std::string read_name(void);
+    std::string read_value(void);
+    void read_entity(std::string& out);
+    void skip_space(void);
+
+    void flush_text(void);
+
+    std::istream& m_in;
+    Handler& m_handler;
+    size_t m_line;
+
+    std::string m_text;
+    std::vector<std::string> m_open;
+};
+
+}
+}
+
+#endif // _OPENCOG_NLP_AIML_READER_H
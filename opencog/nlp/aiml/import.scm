@@ -0,0 +1,33 @@
+;
+; import.scm
+;
+; Importing AIML files into OpenPsi rules, without aiml2psi.pl.
+;
+; (use-modules (opencog nlp aiml import))
+; (aiml-import "/where/the/aiml/files/are/atomic.aiml")
+;
+(define-module (opencog nlp aiml import))
+
+(use-modules (opencog))
+(use-modules (opencog oc-config))
+
+(load-extension (string-append opencog-ext-path-aiml-import "libaiml-import") "opencog_nlp_aiml_import_init")
+
+(set-procedure-property! aiml-import-file 'documentation
+"
+  aiml-import-file FILE PRIORITY -- add the categories of the AIML file
+  FILE to the atomspace as OpenPsi rules, as aiml2psi.pl with the option
+  --priority PRIORITY would, and return how many rules were added. The
+  file is read as a stream, and its rules added in batches, so that big
+  files take no more memory than small ones. An error is thrown at the
+  first bit of malformed XML; the rules before it are kept.
+")
+
+(define-public (aiml-import FILE . PRIORITY)
+"
+  aiml-import FILE [PRIORITY] -- add the categories of the AIML file
+  FILE to the atomspace as OpenPsi rules, with the priority PRIORITY,
+  1.0 by default. See aiml-import-file.
+"
+	(aiml-import-file FILE (if (null? PRIORITY) 1.0 (car PRIORITY)))
+)
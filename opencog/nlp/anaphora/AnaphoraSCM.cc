@@ -0,0 +1,112 @@
+/*
+ * AnaphoraSCM.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/guile/SchemePrimitive.h>
+#include <opencog/guile/SchemeSmob.h>
+
+#include "HobbsResolver.h"
+
+namespace opencog
+{
+namespace nlp
+{
+
+/**
+ * The scheme bindings of the Hobbs resolver; see HobbsResolver.h.
+ */
+class AnaphoraSCM
+{
+private:
+    static void* init_in_guile(void*);
+    static void init_in_module(void*);
+    void init(void);
+
+    HandleSeq resolve(const Handle&);
+    HandleSeq pronouns(const Handle&);
+
+public:
+    AnaphoraSCM();
+};
+
+}
+}
+
+using namespace opencog;
+using namespace opencog::nlp;
+
+AnaphoraSCM::AnaphoraSCM()
+{
+    static bool is_init = false;
+    if (is_init) return;
+    is_init = true;
+    scm_with_guile(init_in_guile, this);
+}
+
+void* AnaphoraSCM::init_in_guile(void* self)
+{
+    scm_c_define_module("opencog nlp anaphora", init_in_module, self);
+    scm_c_use_module("opencog nlp anaphora");
+    return NULL;
+}
+
+void AnaphoraSCM::init_in_module(void* data)
+{
+    AnaphoraSCM* self = (AnaphoraSCM*) data;
+    self->init();
+}
+
+void AnaphoraSCM::init()
+{
+    define_scheme_primitive("hobbs-resolve", &AnaphoraSCM::resolve, this, "nlp anaphora");
+    define_scheme_primitive("hobbs-pronouns", &AnaphoraSCM::pronouns, this, "nlp anaphora");
+}
+
+/**
+ * Implement the "hobbs-resolve" scheme primitive.
+ *
+ * @param parse  the ParseNode of the sentence
+ * @return       the ReferenceLinks made for its pronouns
+ */
+HandleSeq AnaphoraSCM::resolve(const Handle& parse)
+{
+    AtomSpace* as = SchemeSmob::ss_get_env_as("hobbs-resolve");
+    return hobbs_resolve(as, parse);
+}
+
+/**
+ * Implement the "hobbs-pronouns" scheme primitive.
+ */
+HandleSeq AnaphoraSCM::pronouns(const Handle& parse)
+{
+    AtomSpace* as = SchemeSmob::ss_get_env_as("hobbs-pronouns");
+    HobbsResolver resolver(as);
+    resolver.load_rules();
+    return resolver.pronouns(parse);
+}
+
+extern "C" {
+void opencog_nlp_anaphora_init(void);
+};
+
+void opencog_nlp_anaphora_init(void)
+{
+    static AnaphoraSCM anaphora;
+}
@@ -0,0 +1,379 @@
+/*
+ * HobbsResolver.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/neighbors/Neighbors.h>
+#include <opencog/nlp/types/atom_types.h>
+#include <opencog/nlp/types/WordPosition.h>
+
+#include "HobbsResolver.h"
+
+using namespace opencog;
+using namespace opencog::nlp;
+
+namespace
+{
+
+// As in agents/hobbs.py
+const double CONFIDENCE_DECREASING_RATE = 0.7;
+const double STRENGTH_FOR_ACCEPTED_ANTECEDENTS = 0.98;
+const double STRENGTH_FOR_FILTERED_OUT_ANTECEDENTS = 0.02;
+const double CONFIDENCE_FOR_FILTERED_OUT_ANTECEDENTS = 0.9;
+const unsigned NUMBER_OF_SEARCHING_SENTENCES = 3;
+
+/**
+ * A ListLink that puts an atom in for an AnchorNode of the rules, for
+ * as long as it is in scope.
+ */
+class Binding
+{
+public:
+    Binding(AtomSpace* as, HandleSeq oset) : _as(as)
+    {
+        if (oset.front()) _link = as->add_link(LIST_LINK, std::move(oset));
+    }
+    ~Binding() { if (_link) _as->extract_atom(_link); }
+
+private:
+    AtomSpace* _as;
+    Handle _link;
+};
+
+// (EvaluationLink (DefinedLinguisticRelationship "_subj") list), as
+// getChildren.scm has it.
+bool is_relation(const Handle& list)
+{
+    return foreach_incoming_of_type(list, EVALUATION_LINK, false,
+        [](const Handle& eval)
+        {
+            Type t = eval->getOutgoingAtom(0)->get_type();
+            return DEFINED_LINGUISTIC_RELATIONSHIP_NODE == t or
+                   PREPOSITIONAL_RELATIONSHIP_NODE == t;
+        });
+}
+
+bool has_parent(const Handle& word)
+{
+    return foreach_incoming_of_type(word, LIST_LINK, false,
+        [&](const Handle& list)
+        {
+            return 2 == list->get_arity() and
+                   list->getOutgoingAtom(1) == word and is_relation(list);
+        });
+}
+
+void sort_by_position(HandleSeq& words)
+{
+    std::stable_sort(words.begin(), words.end(),
+        [](const Handle& a, const Handle& b)
+        { return word_sequence_number(a) < word_sequence_number(b); });
+}
+
+// The number of a NumberNode, as StringToNumber has it
+double number_of(const Handle& num)
+{
+    return atof(num->get_name().c_str());
+}
+
+}
+
+HobbsResolver::HobbsResolver(AtomSpace* as) :
+    _as(as), _rules(NUM_RULE_SETS),
+    _num_previous(NUMBER_OF_SEARCHING_SENTENCES), _confidence(0)
+{
+    _current_target = as->add_node(ANCHOR_NODE, "CurrentTarget");
+    _current_pronoun = as->add_node(ANCHOR_NODE, "CurrentPronoun");
+    _current_proposal = as->add_node(ANCHOR_NODE, "CurrentProposal");
+    _current_resolution = as->add_node(ANCHOR_NODE, "CurrentResolution");
+    _current_result = as->add_node(ANCHOR_NODE, "CurrentResult");
+    _pleonastic_it = as->add_node(ANCHOR_NODE, "Pleonastic-it");
+    _resolved = as->add_node(ANCHOR_NODE, "Resolved references");
+}
+
+const char* HobbsResolver::rulebase_name(RuleSet set)
+{
+    switch (set)
+    {
+        case PRE_PROCESS: return "hobbs-pre-process";
+        case IS_IT: return "hobbs-is-it";
+        case PLEONASTIC_IT: return "hobbs-pleonastic-it";
+        case FILTER: return "hobbs-filters";
+        case CONJUNCTION: return "hobbs-conjunction";
+        default: return "";
+    }
+}
+
+size_t HobbsResolver::load_rules()
+{
+    size_t n = 0;
+    for (int set = 0; set < NUM_RULE_SETS; set++)
+    {
+        _rules[set].clear();
+
+        // (MemberLink (BindLink ...) (ConceptNode "hobbs-filters"))
+        Handle rbs(_as->get_handle(CONCEPT_NODE,
+                                   rulebase_name((RuleSet) set)));
+        if (nullptr == rbs) continue;
+
+        foreach_source_neighbor(rbs, MEMBER_LINK,
+            [&](const Handle& rule)
+            {
+                if (BIND_LINK == rule->get_type())
+                    add_rule((RuleSet) set, rule);
+                return false;
+            });
+        n += _rules[set].size();
+    }
+    return n;
+}
+
+void HobbsResolver::add_rule(RuleSet set, const Handle& bindlink)
+{
+    _rules[set].push_back(bindlink);
+}
+
+HandleSeq HobbsResolver::run_rule(const Handle& rule, const Handle& anchor,
+                                  const Handle& atom)
+{
+    HandleSeq found;
+    Handle results;
+    {
+        Binding binding(_as, {anchor, atom});
+        results = HandleCast(rule->execute(_as));
+    }
+    if (nullptr == results) return found;
+
+    // (SetLink (ListLink (AnchorNode "CurrentResult") found) ...)
+    HandleSeq oset(results->getOutgoingSet());
+    _as->extract_atom(results);
+    for (const Handle& h : oset)
+    {
+        if (LIST_LINK != h->get_type() or 2 != h->get_arity() or
+            h->getOutgoingAtom(0) != _current_result)
+            continue;
+        found.push_back(h->getOutgoingAtom(1));
+        _as->extract_atom(h);
+    }
+    return found;
+}
+
+bool HobbsResolver::any_rule_finds(RuleSet set, const Handle& anchor,
+                                   const Handle& atom)
+{
+    for (const Handle& rule : _rules[set])
+        if (not run_rule(rule, anchor, atom).empty())
+            return true;
+    return false;
+}
+
+HandleSeq HobbsResolver::children(const Handle& word)
+{
+    // (EvaluationLink relationship (ListLink word child))
+    HandleSeq kids;
+    foreach_incoming_of_type(word, LIST_LINK, false,
+        [&](const Handle& list)
+        {
+            if (2 == list->get_arity() and
+                list->getOutgoingAtom(0) == word and is_relation(list))
+                kids.push_back(list->getOutgoingAtom(1));
+            return false;
+        });
+    sort_by_position(kids);
+    return kids;
+}
+
+HandleSeq HobbsResolver::roots(const Handle& parse)
+{
+    // connectRootsToParseNodes.scm, without the links it made
+    HandleSeq tops;
+    foreach_source_neighbor(parse, WORD_INSTANCE_LINK,
+        [&](const Handle& word)
+        {
+            if (not children(word).empty() and not has_parent(word))
+                tops.push_back(word);
+            return false;
+        });
+    sort_by_position(tops);
+    return tops;
+}
+
+HandleSeq HobbsResolver::previous_parses(const Handle& parse,
+                                         unsigned max) const
+{
+    // (ParseLink parse sentence) and (SentenceSequenceLink sentence num)
+    HandleSeq parses;
+    Handle sentence(first_target_neighbor(parse, PARSE_LINK));
+    if (nullptr == sentence) return parses;
+    Handle num(first_target_neighbor(sentence, SENTENCE_SEQUENCE_LINK));
+    if (nullptr == num) return parses;
+    double number = number_of(num);
+
+    HandleSeq seqs;
+    _as->get_handles_by_type(std::back_inserter(seqs),
+                             SENTENCE_SEQUENCE_LINK);
+
+    std::vector<std::pair<double, Handle>> earlier;
+    for (const Handle& seq : seqs)
+    {
+        if (2 != seq->get_arity()) continue;
+        double n = number_of(seq->getOutgoingAtom(1));
+        if (n < number)
+            earlier.emplace_back(n, seq->getOutgoingAtom(0));
+    }
+    std::sort(earlier.begin(), earlier.end(),
+        [](const std::pair<double, Handle>& a,
+           const std::pair<double, Handle>& b)
+        { return a.first > b.first; });
+
+    for (const auto& ns : earlier)
+    {
+        if (max <= parses.size()) break;
+        Handle p(first_source_neighbor(ns.second, PARSE_LINK));
+        if (p) parses.push_back(p);
+    }
+    return parses;
+}
+
+HandleSeq HobbsResolver::pronouns(const Handle& parse)
+{
+    HandleSeq words;
+    get_source_neighbors(std::back_inserter(words), parse,
+                         WORD_INSTANCE_LINK);
+    sort_by_position(words);
+
+    HandleSeq targets;
+    for (const Handle& word : words)
+        if (any_rule_finds(PRE_PROCESS, _current_target, word))
+            targets.push_back(word);
+    return targets;
+}
+
+void HobbsResolver::add_reference(const Handle& pronoun,
+                                  const Handle& antecedent,
+                                  double strength, double confidence)
+{
+    Handle ref(_as->add_link(REFERENCE_LINK, pronoun, antecedent));
+    ref->setTruthValue(SimpleTruthValue::createTV(strength, confidence));
+    _references.push_back(ref);
+}
+
+bool HobbsResolver::is_pleonastic_it(const Handle& pronoun)
+{
+    return any_rule_finds(IS_IT, _current_target, pronoun) and
+           any_rule_finds(PLEONASTIC_IT, _current_target, pronoun);
+}
+
+void HobbsResolver::propose(const Handle& pronoun, const Handle& candidate)
+{
+    Binding resolution(_as, {_current_resolution, pronoun, candidate});
+
+    // "They" may refer to the candidate and the nouns it is in a
+    // conjunction with.
+    HandleSeq conjuncts;
+    for (const Handle& rule : _rules[CONJUNCTION])
+    {
+        HandleSeq found(run_rule(rule, _current_proposal, candidate));
+        conjuncts.insert(conjuncts.end(), found.begin(), found.end());
+    }
+    if (not conjuncts.empty())
+    {
+        conjuncts.insert(conjuncts.begin(), candidate);
+        add_reference(pronoun, _as->add_link(AND_LINK, std::move(conjuncts)),
+                      STRENGTH_FOR_ACCEPTED_ANTECEDENTS, _confidence);
+        _confidence *= CONFIDENCE_DECREASING_RATE;
+    }
+
+    if (any_rule_finds(FILTER, _current_proposal, candidate))
+    {
+        add_reference(pronoun, candidate,
+                      STRENGTH_FOR_FILTERED_OUT_ANTECEDENTS,
+                      CONFIDENCE_FOR_FILTERED_OUT_ANTECEDENTS);
+        return;
+    }
+    add_reference(pronoun, candidate, STRENGTH_FOR_ACCEPTED_ANTECEDENTS,
+                  _confidence);
+    _confidence *= CONFIDENCE_DECREASING_RATE;
+}
+
+void HobbsResolver::search(const Handle& pronoun, const Handle& parse,
+                           HandleSet& visited)
+{
+    std::deque<Handle> queue;
+    for (const Handle& root : roots(parse))
+        if (visited.insert(root).second)
+            queue.push_back(root);
+
+    while (not queue.empty())
+    {
+        Handle word(queue.front());
+        queue.pop_front();
+
+        propose(pronoun, word);
+        for (const Handle& child : children(word))
+            if (visited.insert(child).second)
+                queue.push_back(child);
+    }
+}
+
+void HobbsResolver::resolve_pronoun(const Handle& pronoun,
+                                    const Handle& parse)
+{
+    Binding current(_as, {_current_pronoun, pronoun});
+    _confidence = 1.0 - CONFIDENCE_DECREASING_RATE;
+
+    if (is_pleonastic_it(pronoun))
+    {
+        add_reference(pronoun, _pleonastic_it,
+                      STRENGTH_FOR_ACCEPTED_ANTECEDENTS, _confidence);
+        _confidence *= CONFIDENCE_DECREASING_RATE;
+    }
+
+    // The graph isn't a tree, so the words met are not searched again,
+    // in this sentence or the ones before.
+    HandleSet visited;
+    search(pronoun, parse, visited);
+    for (const Handle& previous : previous_parses(parse, _num_previous))
+        search(pronoun, previous, visited);
+}
+
+HandleSeq HobbsResolver::resolve(const Handle& parse)
+{
+    _references.clear();
+    for (const Handle& pronoun : pronouns(parse))
+    {
+        resolve_pronoun(pronoun, parse);
+        _as->add_link(LIST_LINK, _resolved, pronoun);
+    }
+    return _references;
+}
+
+HandleSeq opencog::nlp::hobbs_resolve(AtomSpace* as, const Handle& parse)
+{
+    HobbsResolver resolver(as);
+    resolver.load_rules();
+    return resolver.resolve(parse);
+}
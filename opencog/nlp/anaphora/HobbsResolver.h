@@ -0,0 +1,155 @@
+/*
+ * HobbsResolver.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_HOBBS_RESOLVER_H
+#define _OPENCOG_HOBBS_RESOLVER_H
+
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+class AtomSpace;
+
+namespace nlp
+{
+
+/**
+ * The Hobbs traversal of agents/hobbs.py, done over the RelEx output of
+ * a parse with the neighbor helpers, for all the pronouns of the parse
+ * at once.
+ *
+ * For each pronoun, the dependency graph of its sentence is searched
+ * breadth first, from the words that no relation points to, children
+ * in word order, and then those of up to three previous sentences. Each
+ * word met is an antecedent candidate, and gets a ReferenceLink from
+ * the pronoun with the TV hobbs.py gives it: (stv 0.02 0.9) if a filter
+ * rejects it, and (stv 0.98 c) if not, where c starts at 0.3 and is cut
+ * by 0.7 for each candidate accepted.
+ *
+ * What makes a word a pronoun, a pleonastic "it" or an unfit candidate
+ * is still decided by the scheme rules in rules/, which find the words
+ * they are about by way of the same AnchorNodes as before; it is only
+ * the traversal that is done here. The rules are the members of the
+ * rulebases named by rulebase_name(), which anaphora.scm sets up, or
+ * are given to add_rule().
+ *
+ * The anchors are global, so only one resolve() should be running on an
+ * atomspace at a time.
+ */
+class HobbsResolver
+{
+public:
+    enum RuleSet
+    {
+        PRE_PROCESS,     // the word is a pronoun to resolve
+        IS_IT,           // the word is "it"
+        PLEONASTIC_IT,   // the "it" refers to nothing
+        FILTER,          // the candidate can't be the antecedent
+        CONJUNCTION,     // the words in a conjunction with the candidate
+        NUM_RULE_SETS
+    };
+
+    HobbsResolver(AtomSpace* as);
+
+    /// The ConceptNode that the rules of the set are members of.
+    static const char* rulebase_name(RuleSet set);
+
+    /**
+     * Take the rules of each set from the MemberLinks of its rulebase,
+     * in place of the ones had before.
+     *
+     * @return  the no. of rules found
+     */
+    size_t load_rules();
+    void add_rule(RuleSet set, const Handle& bindlink);
+    size_t num_rules(RuleSet set) const { return _rules[set].size(); }
+
+    /// The words of the parse to resolve, in word order.
+    HandleSeq pronouns(const Handle& parse);
+
+    /**
+     * Resolve every pronoun of the parse, and mark each one resolved
+     * with a ListLink from (AnchorNode "Resolved references").
+     *
+     * @return  the ReferenceLinks made, in the order they were made
+     */
+    HandleSeq resolve(const Handle& parse);
+
+    /// The no. of sentences before that of the pronoun to search.
+    void set_num_previous_sentences(unsigned n) { _num_previous = n; }
+
+    /// The words of the parse no relation points to, in word order.
+    static HandleSeq roots(const Handle& parse);
+
+    /// The words the relations of the word point to, in word order.
+    static HandleSeq children(const Handle& word);
+
+    /// The parses, one per sentence, of the sentences before that of
+    /// the parse, the nearest first.
+    HandleSeq previous_parses(const Handle& parse, unsigned max) const;
+
+private:
+    void resolve_pronoun(const Handle& pronoun, const Handle& parse);
+    bool is_pleonastic_it(const Handle& pronoun);
+    void propose(const Handle& pronoun, const Handle& candidate);
+    void search(const Handle& pronoun, const Handle& parse,
+                HandleSet& visited);
+
+    /**
+     * Run the rule with atom put in for the anchor, and return what
+     * it has found, with the atoms it made for that taken out again.
+     * The undefined anchor is for nothing put in.
+     */
+    HandleSeq run_rule(const Handle& rule, const Handle& anchor,
+                       const Handle& atom);
+    bool any_rule_finds(RuleSet set, const Handle& anchor,
+                        const Handle& atom);
+
+    void add_reference(const Handle& pronoun, const Handle& antecedent,
+                       double strength, double confidence);
+
+    AtomSpace* _as;
+    std::vector<HandleSeq> _rules;
+    unsigned _num_previous;
+
+    Handle _current_target;
+    Handle _current_pronoun;
+    Handle _current_proposal;
+    Handle _current_resolution;
+    Handle _current_result;
+    Handle _pleonastic_it;
+    Handle _resolved;
+
+    // Of the pronoun being resolved
+    double _confidence;
+    HandleSeq _references;
+};
+
+/// Resolve the pronouns of the parse with the rules loaded by
+/// anaphora.scm; see HobbsResolver::resolve().
+HandleSeq hobbs_resolve(AtomSpace* as, const Handle& parse);
+
+} // namespace nlp
+} // namespace opencog
+
+#endif // _OPENCOG_HOBBS_RESOLVER_H
@@ -0,0 +1,98 @@
+;
+; anaphora.scm
+;
+; The native Hobbs anaphora resolver, and the rules it runs.
+;
+; (use-modules (opencog nlp anaphora))
+; (hobbs-resolve (car (sentence-get-parses SENT)))
+;
+(define-module (opencog nlp anaphora))
+
+(use-modules (opencog))
+(use-modules (opencog nlp))
+(use-modules (opencog exec))
+(use-modules (opencog oc-config))
+
+(load-extension (string-append opencog-ext-path-anaphora "libanaphora") "opencog_nlp_anaphora_init")
+
+(load "anaphora/rules/getConjunction.scm")
+(load "anaphora/rules/isIt.scm")
+
+(load "anaphora/rules/filters/filter-#1.scm")
+(load "anaphora/rules/filters/filter-#2.scm")
+(load "anaphora/rules/filters/filter-#3.scm")
+(load "anaphora/rules/filters/filter-#4.scm")
+(load "anaphora/rules/filters/filter-#5.scm")
+(load "anaphora/rules/filters/filter-#6.scm")
+(load "anaphora/rules/filters/filter-#7.scm")
+(load "anaphora/rules/filters/filter-#8.scm")
+(load "anaphora/rules/filters/filter-#9.scm")
+(load "anaphora/rules/filters/filter-#10.scm")
+(load "anaphora/rules/filters/filter-#11.scm")
+(load "anaphora/rules/filters/filter-#12.scm")
+(load "anaphora/rules/filters/filter-#13.scm")
+(load "anaphora/rules/filters/filter-#14.scm")
+(load "anaphora/rules/filters/filter-#15.scm")
+(load "anaphora/rules/filters/filter-#16.scm")
+(load "anaphora/rules/filters/filter-#17.scm")
+(load "anaphora/rules/filters/filter-#18.scm")
+
+(load "anaphora/rules/pre-process/pre-process-#1.scm")
+(load "anaphora/rules/pre-process/pre-process-#2.scm")
+(load "anaphora/rules/pre-process/pre-process-#3.scm")
+
+(load "anaphora/rules/pleonastic-it/pleonastic-it-#1.scm")
+(load "anaphora/rules/pleonastic-it/pleonastic-it-#2.scm")
+(load "anaphora/rules/pleonastic-it/pleonastic-it-#3.scm")
+
+; -----------------------------------------------------------------------
+(define hobbs-rulebases
+	(list
+		(cons "hobbs-pre-process"
+			(list pre-process-#1 pre-process-#2 pre-process-#3))
+		(cons "hobbs-is-it" (list isIt))
+		(cons "hobbs-pleonastic-it"
+			(list pleonastic-it-#1 pleonastic-it-#2 pleonastic-it-#3))
+		(cons "hobbs-filters"
+			(list filter-#1 filter-#2 filter-#3 filter-#4 filter-#5
+				filter-#6 filter-#7 filter-#8 filter-#9 filter-#10
+				filter-#11 filter-#12 filter-#13 filter-#14 filter-#15
+				filter-#16 filter-#17 filter-#18))
+		(cons "hobbs-conjunction" (list getConjunction))))
+
+(define-public (hobbs-load-rules)
+"
+  hobbs-load-rules -- make the rules of the Hobbs resolver members of
+  its rulebases in the current atomspace. This is done when the module
+  is loaded; it has to be done again for any other atomspace that
+  hobbs-resolve is used in.
+"
+	(for-each
+		(lambda (rb)
+			(define base (Concept (car rb)))
+			(for-each (lambda (rule) (Member rule base)) (cdr rb)))
+		hobbs-rulebases)
+)
+
+(hobbs-load-rules)
+
+(set-procedure-property! hobbs-resolve 'documentation
+"
+  hobbs-resolve PARSE -- resolve every pronoun of the ParseNode PARSE,
+  by a breadth-first search of its sentence, and of up to three
+  sentences before it, for words that the filters don't reject. Each
+  word found gets a ReferenceLink from the pronoun, with a TV of
+  (stv 0.98 c) if it was accepted, c getting smaller for each word
+  accepted after it, or of (stv 0.02 0.9) if it was rejected. The
+  pronouns are marked resolved with a ListLink from
+  (AnchorNode \"Resolved references\").
+
+  Returns a list of the ReferenceLinks made, in the order they were
+  made.
+")
+
+(set-procedure-property! hobbs-pronouns 'documentation
+"
+  hobbs-pronouns PARSE -- return a list of the words of the ParseNode
+  PARSE that hobbs-resolve resolves, in word order.
+")
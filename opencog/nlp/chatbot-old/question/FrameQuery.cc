@@ -53,6 +53,20 @@ static void prt(Atom *atom)
 /* ======================================================== */
 /* Routines to help put the query into normal form. */
 
+/**
+ * Return true for #hyp, #what, #which, #when, #where, #why, #how
+ * and #truth-query.
+ */
+static bool is_question_markup(const std::string& name)
+{
+	if (name.empty() || '#' != name[0]) return false;
+
+	WordRelQuery::QueryWord qw =
+		WordRelQuery::query_word(name.c_str() + 1, name.size() - 1);
+	return WordRelQuery::NOT_A_QUERY_WORD != qw &&
+	       WordRelQuery::QW_WHO != qw;
+}
+
 /**
  * Return true, if the node is, for example, _subj or _obj
  */
@@ -70,19 +84,10 @@ bool FrameQuery::discard_question_markup(Atom *atom)
 	Type atype = atom->get_type();
 	if (DEFINED_LINGUISTIC_CONCEPT_NODE == atype)
 	{
-		const char *name = n->get_name().c_str();
-
 		/* Throw away #what, #which, etc. 
 		 * as that frame will never occur as a part of the answer.
 		 */
-		if (!strcmp("#hyp", name)) do_discard = true;
-		if (!strcmp("#what", name)) do_discard = true;
-		if (!strcmp("#which", name)) do_discard = true;
-		if (!strcmp("#when", name)) do_discard = true;
-		if (!strcmp("#where", name)) do_discard = true;
-		if (!strcmp("#why", name)) do_discard = true;
-		if (!strcmp("#how", name)) do_discard = true;
-		if (!strcmp("#truth-query", name)) do_discard = true;
+		if (is_question_markup(n->get_name())) do_discard = true;
 	}
 
 	return false;
@@ -157,14 +162,7 @@ bool FrameQuery::discard_heir_markup(Atom *atom)
 		/* Throw away #what, #which, etc. 
 		 * as that frame will never occur as a part of the answer.
 		 */
-		if (!strcmp("#hyp", name)) do_discard = true;
-		if (!strcmp("#what", name)) do_discard = true;
-		if (!strcmp("#which", name)) do_discard = true;
-		if (!strcmp("#when", name)) do_discard = true;
-		if (!strcmp("#where", name)) do_discard = true;
-		if (!strcmp("#why", name)) do_discard = true;
-		if (!strcmp("#how", name)) do_discard = true;
-		if (!strcmp("#truth-query", name)) do_discard = true;
+		if (is_question_markup(n->get_name())) do_discard = true;
 	}
 
 	return false;
@@ -56,6 +56,9 @@
 
 #include <stdio.h>
 
+#include <algorithm>
+#include <unordered_set>
+
 #include <opencog/atomspace/ForeachChaseLink.h>
 #include <opencog/atomspace/Node.h>
 
@@ -92,11 +95,7 @@ bool SentenceQuery::is_tq(Handle prop)
 	AtomSpace *atomspace = cogserver().getAtomSpace();
 	if (DEFINED_LINGUISTIC_CONCEPT_NODE != atomspace->getType(prop)) return false;
 
-	const std::string& name = atomspace->get_name(prop);
-	const char * str = name.c_str();
-	if (0 == strcmp(str, "truth-query"))
-		return true;
-	return false;
+	return QW_TRUTH_QUERY == query_word(atomspace->get_name(prop));
 }
 
 /**
@@ -187,13 +186,11 @@ bool SentenceQuery::discard_extra_markup(Atom *atom)
 	 * definite-FLAG matching. Everything else is ignored
 	 * in the match.
 	 */
-	const char *name = n->get_name().c_str();
-	if (!strcmp("#masculine", name)) do_discard = false;
-	else if (!strcmp("#feminine", name)) do_discard = false;
-	else if (!strcmp("#person", name)) do_discard = false;
-	else if (!strcmp("#definite", name)) do_discard = false;
-	else if (!strcmp("#singular", name)) do_discard = false;
-	else if (!strcmp("#uncountable", name)) do_discard = false;
+	static const std::unordered_set<std::string> kept_markup = {
+		"#masculine", "#feminine", "#person",
+		"#definite", "#singular", "#uncountable"
+	};
+	if (kept_markup.count(n->get_name())) do_discard = false;
 
 	return false;
 }
@@ -314,6 +311,136 @@ bool SentenceQuery::parse_solve(Handle parse_node)
 		&SentenceQuery::wordlist_solve, this);
 }
 
+/* ================================================================= */
+/* Query plans, cached by the shape of the question. */
+
+/**
+ * Work out the plan for a question of the given shape: the clauses
+ * that have a query variable in them go first, and then, one at a
+ * time, the clause sharing the most words with those already placed,
+ * so that the pattern matcher walks from the variable outwards, and
+ * has something grounded to compare against at each step.
+ *
+ * args holds the words of each clause, as indexes into the word list;
+ * qvar says which of the words are query variables.
+ */
+static SentenceQuery::QueryPlan
+make_plan(const std::vector<std::vector<size_t> >& args,
+          const std::vector<bool>& qvar)
+{
+	SentenceQuery::QueryPlan plan;
+	size_t nclauses = args.size();
+
+	for (size_t w = 0; w < qvar.size(); w++)
+		if (qvar[w]) plan.vars.push_back(w);
+
+	std::vector<bool> placed(nclauses, false);
+	std::vector<bool> seen(qvar);
+	while (plan.order.size() < nclauses)
+	{
+		size_t best = nclauses;
+		size_t best_shared = 0;
+		for (size_t c = 0; c < nclauses; c++)
+		{
+			if (placed[c]) continue;
+			size_t shared = 0;
+			for (size_t a = 0; a < args[c].size(); a++)
+				if (seen[args[c][a]]) shared++;
+			if (best == nclauses or best_shared < shared)
+			{
+				best = c;
+				best_shared = shared;
+			}
+		}
+
+		placed[best] = true;
+		plan.order.push_back(best);
+		for (size_t a = 0; a < args[best].size(); a++)
+			seen[args[best][a]] = true;
+	}
+	return plan;
+}
+
+/**
+ * Find the query variables, and put the clauses of normed_predicate
+ * into the order the plan for this question calls for.
+ *
+ * The shape of the question is the list of its relations, ordered by
+ * name, with each word replaced by its index in order of appearance,
+ * marked with a '?' if it is a query variable. Thus "Who threw the
+ * ball?" and "Who ate the cake?" are both "_obj(0,1)_subj(0,2?)", and
+ * the second one is solved with the plan worked out for the first.
+ *
+ * Each word is checked for being a query variable once; find_vars()
+ * checked every atom of every clause, including the relation nodes,
+ * whose incoming sets are as large as the atomspace has relations.
+ */
+void SentenceQuery::plan_predicate(void)
+{
+	// Order the clauses by relation name, so that the same relations,
+	// found in a different order, have the same shape.
+	std::vector<std::pair<std::string, Handle> > clauses;
+	HandleSeq::const_iterator i;
+	for (i = normed_predicate.begin(); i != normed_predicate.end(); ++i)
+	{
+		Handle h = *i;
+		const HandleSeq& oset = atom_space->getOutgoing(h);
+		clauses.push_back(std::make_pair(atom_space->get_name(oset[0]), h));
+	}
+	std::stable_sort(clauses.begin(), clauses.end(),
+		[](const std::pair<std::string, Handle>& a,
+		   const std::pair<std::string, Handle>& b)
+		{ return a.first < b.first; });
+
+	std::map<Handle, size_t> index;
+	HandleSeq words;
+	std::vector<bool> qvar;
+	std::vector<std::vector<size_t> > args(clauses.size());
+	std::string shape;
+	for (size_t c = 0; c < clauses.size(); c++)
+	{
+		shape += clauses[c].first;
+		shape += '(';
+
+		const HandleSeq& oset = atom_space->getOutgoing(clauses[c].second);
+		const HandleSeq& wset = atom_space->getOutgoing(oset[1]);
+		for (size_t a = 0; a < wset.size(); a++)
+		{
+			Handle w = wset[a];
+			std::map<Handle, size_t>::iterator it = index.find(w);
+			if (it == index.end())
+			{
+				it = index.insert(std::make_pair(w, words.size())).first;
+				words.push_back(w);
+				qvar.push_back(is_word_a_query(w));
+			}
+			args[c].push_back(it->second);
+
+			if (0 < a) shape += ',';
+			shape += std::to_string(it->second);
+			if (qvar[it->second]) shape += '?';
+		}
+		shape += ')';
+	}
+
+	std::map<std::string, QueryPlan>::iterator pit = plans.find(shape);
+	if (pit == plans.end())
+	{
+		if (max_plans <= plans.size()) plans.clear();
+		pit = plans.insert(std::make_pair(shape, make_plan(args, qvar))).first;
+	}
+	const QueryPlan& plan = pit->second;
+
+	normed_predicate.clear();
+	for (size_t c = 0; c < plan.order.size(); c++)
+		normed_predicate.push_back(clauses[plan.order[c]].second);
+
+	bound_vars.clear();
+	for (size_t v = 0; v < plan.vars.size(); v++)
+		bound_vars.push_back(words[plan.vars[v]]);
+}
+
+/* ================================================================= */
 /**
  * The input argument is a handle to a SentenceNode.
  *
@@ -375,15 +502,9 @@ void SentenceQuery::solve(AtomSpace *as, Handle sentence_node)
 	foreach_reverse_binary_link(sentence_node, PARSE_LINK, 
 		&SentenceQuery::parse_solve, this);
 
-	// Find the variables, so that they can be bound.
-	bound_vars.clear();
-	HandleSeq::const_iterator i;
-	for (i = normed_predicate.begin();
-	     i != normed_predicate.end(); ++i)
-	{
-		Handle h = *i;
-		find_vars(h);
-	}
+	// Find the variables, so that they can be bound, and put the
+	// clauses into the order the plan for this shape of question says.
+	plan_predicate();
 
 #define DEBUG
 #ifdef DEBUG
@@ -396,9 +517,8 @@ void SentenceQuery::solve(AtomSpace *as, Handle sentence_node)
 	// a solution.
 	if (0 == bound_vars.size()) return;
 
-	// Solve...
-	if (pme) delete pme;
-	pme = new PatternMatchEngine();
+	// Solve... The engine is kept from one question to the next.
+	if (NULL == pme) pme = new PatternMatchEngine();
 	pme->set_atomspace(atom_space);
 
 	HandleSeq ign;
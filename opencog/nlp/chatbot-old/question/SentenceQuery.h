@@ -25,6 +25,8 @@
 #define _OPENCOG_SENTENCE_QUERY_H
 
 #include <map>
+#include <string>
+#include <vector>
 
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/nlp/question/WordRelQuery.h>
@@ -53,6 +55,22 @@ class SentenceQuery :
 		bool is_parse_a_truth_query(Handle);
 		bool is_wordlist_a_query(Handle);
 
+	public:
+		/* How to solve a question of some shape: the order in
+		 * which to hand the clauses to the pattern matcher, and
+		 * which of the words are the variables. */
+		struct QueryPlan
+		{
+			std::vector<size_t> order;
+			std::vector<size_t> vars;
+		};
+
+	private:
+		// The plans for the question shapes seen so far.
+		std::map<std::string, QueryPlan> plans;
+		static const size_t max_plans = 1024;
+		void plan_predicate(void);
+
 	public:
 		void solve(AtomSpace *, Handle);
 
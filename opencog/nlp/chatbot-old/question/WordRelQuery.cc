@@ -37,6 +37,7 @@
 #include "WordRelQuery.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atomspace/ForeachChaseLink.h>
@@ -81,8 +82,52 @@ static inline void prt(Atom *atom) {}
  */
 
 /**
- * Return true, if atom is of type Node, and if the node
- * name is "match_name" (currently hard-coded as _$qVar)
+ * Classify the name of a DefinedLinguisticConceptNode as one of the
+ * question words, without the leading '#' if there is one. This gets
+ * called for every InheritanceLink of every word in every question,
+ * so it looks at the length and the first letter, and then compares
+ * at most one name, instead of running down a chain of strcmp's.
+ */
+WordRelQuery::QueryWord WordRelQuery::query_word(const char *str, size_t len)
+{
+#define QW(NAME, KIND) \
+	if (0 == memcmp(str, NAME, len)) return KIND; \
+	return NOT_A_QUERY_WORD;
+
+	switch (len)
+	{
+		case 3:
+			switch (str[0])
+			{
+				case 'w':
+					if ('o' == str[2]) { QW("who", QW_WHO) }
+					QW("why", QW_WHY)
+				case 'h':
+					if ('w' == str[2]) { QW("how", QW_HOW) }
+					QW("hyp", QW_HYP)
+			}
+			break;
+		case 4:
+			if ('a' == str[2]) { QW("what", QW_WHAT) }
+			QW("when", QW_WHEN)
+		case 5:
+			if ('e' == str[2]) { QW("where", QW_WHERE) }
+			QW("which", QW_WHICH)
+		case 11:
+			QW("truth-query", QW_TRUTH_QUERY)
+	}
+	return NOT_A_QUERY_WORD;
+#undef QW
+}
+
+WordRelQuery::QueryWord WordRelQuery::query_word(const std::string& name)
+{
+	return query_word(name.c_str(), name.size());
+}
+
+/**
+ * Return true, if atom is a DefinedLinguisticConceptNode naming
+ * one of the query variables: who, what, when, where or why.
  */
 bool WordRelQuery::is_qVar(Handle word_prop)
 {
@@ -90,20 +135,17 @@ bool WordRelQuery::is_qVar(Handle word_prop)
 	if (DEFINED_LINGUISTIC_CONCEPT_NODE != atomspace->getType(word_prop))
         return false;
 
-	const std::string& name = atomspace->get_name(word_prop);
-	const char * str = name.c_str();
-	if (0 == strcmp(str, "who"))
-		return true;
-	if (0 == strcmp(str, "what"))
-		return true;
-	if (0 == strcmp(str, "when"))
-		return true;
-	if (0 == strcmp(str, "where"))
-		return true;
-	if (0 == strcmp(str, "why"))
-		return true;
-
-	return false;
+	switch (query_word(atomspace->get_name(word_prop)))
+	{
+		case QW_WHO:
+		case QW_WHAT:
+		case QW_WHEN:
+		case QW_WHERE:
+		case QW_WHY:
+			return true;
+		default:
+			return false;
+	}
 }
 
 /**
@@ -36,6 +36,26 @@ namespace opencog {
 class WordRelQuery : 
 	public DefaultPatternMatchCB
 {
+	public:
+		/* The question words that RelEx marks up with a
+		 * DefinedLinguisticConceptNode, e.g. QUERY-TYPE(_$qVar, what)
+		 * or #truth-query. */
+		enum QueryWord
+		{
+			NOT_A_QUERY_WORD = 0,
+			QW_WHO,
+			QW_WHAT,
+			QW_WHICH,
+			QW_WHEN,
+			QW_WHERE,
+			QW_WHY,
+			QW_HOW,
+			QW_HYP,
+			QW_TRUTH_QUERY
+		};
+		static QueryWord query_word(const char *, size_t);
+		static QueryWord query_word(const std::string &);
+
 	private:
 		// Help determine if assertion is a query.
 		bool is_qVar(Handle);
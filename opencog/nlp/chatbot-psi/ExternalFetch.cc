@@ -0,0 +1,185 @@
+/*
+ * ExternalFetch.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include <algorithm>
+#include <mutex>
+
+#include <curl/curl.h>
+
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/StringValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/executor/Lane.h>
+#include <opencog/util/Config.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/util/Logger.h>
+
+#include "ExternalFetch.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+static const Handle& body_key(void)
+{
+    static const Handle key(createNode(PREDICATE_NODE, "*-fetch-body-*"));
+    return key;
+}
+
+static const Handle& code_key(void)
+{
+    static const Handle key(createNode(PREDICATE_NODE, "*-fetch-code-*"));
+    return key;
+}
+
+static const Handle& error_key(void)
+{
+    static const Handle key(createNode(PREDICATE_NODE, "*-fetch-error-*"));
+    return key;
+}
+
+/**
+ * The state of the marker, as set by start() and run(), or the
+ * undefined handle.
+ */
+static Handle get_state(const Handle& marker)
+{
+    for (const Handle& l : marker->getIncomingSetByType(STATE_LINK))
+        if (l->getOutgoingAtom(0) == marker)
+            return l->getOutgoingAtom(1);
+    return Handle::UNDEFINED;
+}
+
+static void set_state(AtomSpace* as, const Handle& marker,
+                      const std::string& state)
+{
+    as->add_link(STATE_LINK, marker, as->add_node(CONCEPT_NODE, std::string(state)));
+}
+
+bool ExternalFetch::start(AtomSpace* as, const Handle& marker,
+                          const std::string& url, double timeout)
+{
+    // The check and the change of state are not atomic; two fetches
+    // for the same marker at once are harmless, the last one wins.
+    Handle state(get_state(marker));
+    if (state and state->get_name() == "FetchPending")
+        return false;
+
+    set_state(as, marker, "FetchPending");
+    lane().submit(
+        [as, marker, url, timeout]() { run(as, marker, url, timeout); });
+    return true;
+}
+
+/**
+ * The fetches have threads of their own, CHATBOT_FETCH_THREADS of
+ * them, as they spend their time waiting on the network; nothing else
+ * runs on them, and they are never run by any other thread, the psi
+ * loop's included.
+ */
+Lane& ExternalFetch::lane(void)
+{
+    static Lane fetches("chatbot-fetch",
+        std::max(1, config().get_int("CHATBOT_FETCH_THREADS", 4)));
+    return fetches;
+}
+
+void ExternalFetch::run(AtomSpace* as, const Handle& marker,
+                        const std::string& url, double timeout)
+{
+    long code = 0;
+    std::string body, error;
+    try
+    {
+        body = get(url, timeout, code);
+        if (code < 200 or 300 <= code)
+            error = "HTTP status " + std::to_string(code);
+    }
+    catch (const StandardException& ex)
+    {
+        error = ex.get_message();
+    }
+
+    if (not error.empty())
+        logger().info("[ExternalFetch] %s: %s", url.c_str(), error.c_str());
+
+    // The values go first, so that they are there by the time the
+    // state says the fetch is over
+    marker->setValue(body_key(), createStringValue(body));
+    marker->setValue(code_key(), createFloatValue((double) code));
+    marker->setValue(error_key(), createStringValue(error));
+    set_state(as, marker, error.empty() ? "FetchDone" : "FetchFailed");
+}
+
+std::string ExternalFetch::body(const Handle& marker)
+{
+    StringValuePtr sv(StringValueCast(marker->getValue(body_key())));
+    if (sv and 0 < sv->value().size())
+        return sv->value()[0];
+    return "";
+}
+
+static size_t write_body(char* data, size_t size, size_t nmemb, void* user)
+{
+    std::string* body = (std::string*) user;
+    size_t len = size * nmemb;
+
+    // Returning less than was given stops the transfer
+    if (ExternalFetch::MAX_BODY < body->size() + len) return 0;
+
+    body->append(data, len);
+    return len;
+}
+
+std::string ExternalFetch::get(const std::string& url, double timeout,
+                               long& code)
+{
+    static std::once_flag init;
+    std::call_once(init, []() { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+    CURL* curl = curl_easy_init();
+    if (nullptr == curl)
+        throw RuntimeException(TRACE_INFO,
+            "ExternalFetch: Unable to start a fetch of %s", url.c_str());
+
+    std::string body;
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_body);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &body);
+
+    // Signals can't be used for the timeouts in a multi-threaded program.
+    // There is always a timeout, as a fetch that never ends would keep
+    // a thread of the lane for good.
+    if (timeout <= 0) timeout = DEFAULT_TIMEOUT;
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, (long) (timeout * 1000));
+
+    CURLcode rc = curl_easy_perform(curl);
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+    curl_easy_cleanup(curl);
+
+    if (CURLE_OK != rc)
+        throw RuntimeException(TRACE_INFO,
+            "ExternalFetch: %s", curl_easy_strerror(rc));
+    return body;
+}
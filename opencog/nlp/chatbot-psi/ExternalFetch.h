@@ -0,0 +1,93 @@
+/*
+ * ExternalFetch.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#ifndef _OPENCOG_NLP_EXTERNAL_FETCH_H
+#define _OPENCOG_NLP_EXTERNAL_FETCH_H
+
+#include <string>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+class AtomSpace;
+class Lane;
+
+namespace nlp
+{
+
+/**
+ * HTTP GETs done on threads of their own, so that the chatbot can ask
+ * external sources without the psi loop waiting on the network.
+ *
+ * Each fetch is tracked by a marker atom, given by the caller.  While
+ * it runs, the marker is in the state (ConceptNode "FetchPending"),
+ * i.e. there is a StateLink from it to that node; when it is over, the
+ * marker is given these values
+ *
+ *    (PredicateNode "*-fetch-body-*")   a StringValue of the response
+ *    (PredicateNode "*-fetch-code-*")   a FloatValue of the HTTP status
+ *    (PredicateNode "*-fetch-error-*")  a StringValue of what went
+ *                                       wrong, if anything did
+ *
+ * and then goes to the state (ConceptNode "FetchDone"), or else to
+ * (ConceptNode "FetchFailed").  As it is a StateLink that changes, a
+ * psi rule with the StateLink in its context is looked at again by the
+ * OpenPsiImplicator once the fetch is over, and not before.
+ *
+ * The fetches are queued on a Lane, not on the Executor, whose workers
+ * are for short tasks, and which may run a task in the calling thread.
+ */
+class ExternalFetch
+{
+public:
+    // Start fetching the URL, giving up after the given no. of seconds,
+    // or DEFAULT_TIMEOUT if that isn't positive.  Returns false, doing
+    // nothing, if a fetch for the marker is still pending.
+    static bool start(AtomSpace* as, const Handle& marker,
+                      const std::string& url, double timeout);
+
+    // The response of the last fetch for the marker, or the empty
+    // string if there is none
+    static std::string body(const Handle& marker);
+
+    // Fetch the URL now, in the calling thread; throws if it can't
+    static std::string get(const std::string& url, double timeout,
+                           long& code);
+
+    // Responses longer than this are cut short, and the fetch fails
+    static const size_t MAX_BODY = 1 << 20;
+
+    // The seconds a fetch is given when no timeout is
+    static constexpr double DEFAULT_TIMEOUT = 30.0;
+
+private:
+    static Lane& lane(void);
+
+    static void run(AtomSpace* as, const Handle& marker,
+                    const std::string& url, double timeout);
+};
+
+}
+}
+
+#endif // _OPENCOG_NLP_EXTERNAL_FETCH_H
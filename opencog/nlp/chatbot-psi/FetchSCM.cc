@@ -0,0 +1,109 @@
+/*
+ * FetchSCM.cc
+ *
+ * Scheme bindings of the external fetches.
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include <opencog/guile/SchemePrimitive.h>
+#include <opencog/guile/SchemeSmob.h>
+
+#include "ExternalFetch.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+namespace opencog
+{
+namespace nlp
+{
+
+class FetchSCM
+{
+private:
+    static void* init_in_guile(void*);
+    static void init_in_module(void*);
+    void init(void);
+
+    bool start(const Handle&, const std::string&, double);
+    std::string body(const Handle&);
+
+public:
+    FetchSCM(void);
+};
+
+}
+}
+
+FetchSCM::FetchSCM(void)
+{
+    static bool is_init = false;
+    if (is_init) return;
+    is_init = true;
+    scm_with_guile(init_in_guile, this);
+}
+
+void* FetchSCM::init_in_guile(void* self)
+{
+    scm_c_define_module("opencog nlp chatbot-psi fetch", init_in_module, self);
+    scm_c_use_module("opencog nlp chatbot-psi fetch");
+    return NULL;
+}
+
+void FetchSCM::init_in_module(void* data)
+{
+    FetchSCM* self = (FetchSCM*) data;
+    self->init();
+}
+
+void FetchSCM::init(void)
+{
+    define_scheme_primitive("fetch-url-async",
+        &FetchSCM::start, this, "nlp chatbot-psi fetch");
+    define_scheme_primitive("fetch-body",
+        &FetchSCM::body, this, "nlp chatbot-psi fetch");
+}
+
+/**
+ * Implement the "fetch-url-async" scheme primitive.
+ */
+bool FetchSCM::start(const Handle& marker, const std::string& url,
+                     double timeout)
+{
+    AtomSpace* as = SchemeSmob::ss_get_env_as("fetch-url-async");
+    return ExternalFetch::start(as, marker, url, timeout);
+}
+
+/**
+ * Implement the "fetch-body" scheme primitive.
+ */
+std::string FetchSCM::body(const Handle& marker)
+{
+    return ExternalFetch::body(marker);
+}
+
+extern "C" {
+void opencog_nlp_fetch_init(void);
+};
+
+void opencog_nlp_fetch_init(void)
+{
+    static FetchSCM fetch;
+}
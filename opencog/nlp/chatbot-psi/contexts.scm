@@ -1,4 +1,5 @@
-(use-modules (opencog) (opencog nlp) (opencog nlp relex2logic))
+(use-modules (opencog) (opencog nlp) (opencog nlp relex2logic)
+             (opencog nlp chatbot-psi fetch))
 
 (load "states.scm")
 (load "utils.scm")
@@ -33,6 +34,16 @@
             (State anchor (Variable "$s"))))
 )
 
+; The fetch for MARKER is over, see fetch-url-async
+(define (fetch-over? marker)
+    (Or (Equal (Set fetch-done) (Get
+            (TypedVariable (Variable "$s") (Type "ConceptNode"))
+                (State marker (Variable "$s"))))
+        (Equal (Set fetch-failed) (Get
+            (TypedVariable (Variable "$s") (Type "ConceptNode"))
+                (State marker (Variable "$s")))))
+)
+
 (define (any-result? anchor)
     (Not (Or
         (Equal (Set setup-not-done) (Get
@@ -354,6 +365,26 @@
     (any-result? openweathermap-answer)
 )
 
+(Define
+    (DefinedPredicate "duckduckgo-fetched?")
+    (fetch-over? duckduckgo-fetch)
+)
+
+(Define
+    (DefinedPredicate "wolframalpha-fetched?")
+    (fetch-over? wolframalpha-fetch)
+)
+
+(Define
+    (DefinedPredicate "weather-location-fetched?")
+    (fetch-over? openweathermap-location-fetch)
+)
+
+(Define
+    (DefinedPredicate "weather-fetched?")
+    (fetch-over? openweathermap-fetch)
+)
+
 ; Usually ChatScript is faster than the random sentence generator, so if the input has
 ; some of the keywords that will trigger either the PKD or Kurzweil generator, do not
 ; reply until the generator has finished or timeout
@@ -1,5 +1,5 @@
 (use-modules (opencog))
-(use-modules (ice-9 threads) (srfi srfi-1) (sxml simple) (web client) (web response))
+(use-modules (srfi srfi-1) (sxml simple) (web uri) (opencog nlp chatbot-psi fetch))
 
 ;-------------------------------------------------------------------------------
 ; AppID for Wolfram|Alpha Webservice API
@@ -10,6 +10,10 @@
 (define owm-appid "")
 (define has-openweathermap-setup #f)
 
+; The external sources are fetched in the background, see fetch-url-async,
+; and read by the psi rules that wait for the fetches to be over
+(define fetch-timeout 10)
+
 (define-public (set-wa-appid id)
     (set! wa-appid id)
     (State wolframalpha default-state)
@@ -22,136 +26,191 @@
     (set! has-openweathermap-setup #t)
 )
 
+; The input text, downcased and percent-encoded for the query of a URL,
+; so that e.g. '&' or '#' in it do not end the query
+(define (input-text-query)
+    (uri-encode (string-downcase (cog-name (get-input-text-node))))
+)
+
+; The response of the fetch for MARKER as SXML, or #f if it failed
+(define (fetched-sxml marker)
+    (if (equal? (cog-chase-link 'StateLink 'ConceptNode marker) (list fetch-done))
+        (catch #t
+            (lambda () (xml->sxml (fetch-body marker)))
+            (lambda (key . args) #f))
+        #f
+    )
+)
+
+; The fetch for MARKER has been read, and the process of ANCHOR is over
+(define (finish-fetch marker anchor)
+    (State marker default-state)
+    (State anchor process-finished)
+)
+
 (define (ask-duckduckgo)
     (State duckduckgo process-started)
 
-    (begin-thread
-        ; TODO: Do something better for getting the first sentence of a paragraph, though
-        ; it isn't that critical here
-        (define (get-first-sentence str)
-            (define default-length 50)
-
-            (if (< (string-length str) default-length)
-                (substring str 0 (string-index str #\.))
-                (substring str 0 (+ default-length
-                    (string-index (substring str default-length) #\.)))
-            )
+    (let ((url (string-append "http://api.duckduckgo.com/?q="
+                   (input-text-query) "&format=xml")))
+        (fetch-url-async duckduckgo-fetch url fetch-timeout)
+    )
+
+    ; Return for the GroundedSchemaNode
+    (Set)
+)
+
+(define (read-duckduckgo)
+    ; TODO: Do something better for getting the first sentence of a paragraph, though
+    ; it isn't that critical here
+    (define (get-first-sentence str)
+        (define default-length 50)
+
+        (if (< (string-length str) default-length)
+            (substring str 0 (string-index str #\.))
+            (substring str 0 (+ default-length
+                (string-index (substring str default-length) #\.)))
         )
+    )
 
-        (define query (string-downcase (cog-name (get-input-text-node))))
-        (define url (string-append "http://api.duckduckgo.com/?q=" query "&format=xml"))
-        (define body (xml->sxml (response-body-port (http-get url #:streaming? #t))))
-        (define resp (car (last-pair body)))
-        (define abstract
+    (define body (fetched-sxml duckduckgo-fetch))
+    (define abstract
+        (and body
             (find (lambda (i)
-                (and (pair? i) (equal? 'Abstract (car i)))) resp))
-
-        (if (equal? (length abstract) 1)
-            (State duckduckgo-answer no-result)
-            (let* ((ans (car (cdr abstract)))
-                   (first-sent (get-first-sentence ans))
-                   (ans-in-words (string-split first-sent #\ ))
-                  )
-                (State duckduckgo-answer (List (map Word ans-in-words)))
-            )
+                (and (pair? i) (equal? 'Abstract (car i)))) (car (last-pair body)))))
+
+    (if (or (not abstract) (equal? (length abstract) 1))
+        (State duckduckgo-answer no-result)
+        (let* ((ans (car (cdr abstract)))
+               (first-sent (get-first-sentence ans))
+               (ans-in-words (string-split first-sent #\ ))
+              )
+            (State duckduckgo-answer (List (map Word ans-in-words)))
         )
-
-        (State duckduckgo process-finished)
     )
 
+    (finish-fetch duckduckgo-fetch duckduckgo)
+
     ; Return for the GroundedSchemaNode
     (Set)
 )
 
 (define (ask-wolframalpha)
     (if (not (equal? wa-appid ""))
-        (begin
+        (let ((url (string-append
+                   "http://api.wolframalpha.com/v2/query?appid=" wa-appid
+                       "&input=" (input-text-query) "&format=plaintext")))
             (State wolframalpha process-started)
-            (begin-thread
-                (define query (string-downcase (cog-name (get-input-text-node))))
-                (define query-no-spaces (regexp-substitute/global #f " " query 'pre "+" 'post))
-                (define url (string-append
-                    "http://api.wolframalpha.com/v2/query?appid=" wa-appid
-                        "&input=" query-no-spaces "&format=plaintext"))
-                (define body (xml->sxml (response-body-port (http-get url #:streaming? #t))))
-                (define resp (car (last-pair body)))
-
-                (define ans
-                    (find (lambda (i)
-                            (and (pair? i)
-                                 (equal? 'pod (car i))
-                                 (equal? 'title (car (cadr (cadr i))))
-                                 ; The tags we are looking for
-                                 (not (equal? (member (cadr (cadr (cadr i)))
-                                     (list "Result" "Definition" "Definitions"
-                                           "Basic definition" "Basic information"))
-                                     #f))))
-                    resp)
-                )
-
-                (if (equal? ans #f)
-                    (State wolframalpha-answer no-result)
-                    (let* ((text-ans (cadr (cadddr (cadddr ans))))
-                           ; Remove '(', ')', and '|' from the answer, if any
-                           (cleaned-ans (string-trim (string-filter
-                               (lambda (c) (not (or (char=? #\( c)
-                                                    (char=? #\) c)
-                                                    (char=? #\| c)))) text-ans)))
-                           ; Remove newline and split them into words
-                           (ans-lines (string-split cleaned-ans #\newline))
-                           (ans-in-words (append-map (lambda (l) (string-split l #\ )) ans-lines)))
-                        ; Turn the answer into WordNodes, ignore the empty strings
-                        (State wolframalpha-answer (List (map Word
-                            (remove (lambda (w) (equal? w "")) ans-in-words))))
-                    )
-                )
-
-                (State wolframalpha process-finished)
-            )
+            (fetch-url-async wolframalpha-fetch url fetch-timeout)
+        )
+    )
+
+    ; Return for the GroundedSchemaNode
+    (Set)
+)
+
+(define (read-wolframalpha)
+    (define body (fetched-sxml wolframalpha-fetch))
+
+    (define ans
+        (and body
+            (find (lambda (i)
+                    (and (pair? i)
+                         (equal? 'pod (car i))
+                         (equal? 'title (car (cadr (cadr i))))
+                         ; The tags we are looking for
+                         (not (equal? (member (cadr (cadr (cadr i)))
+                             (list "Result" "Definition" "Definitions"
+                                   "Basic definition" "Basic information"))
+                             #f))))
+                (car (last-pair body)))
+        )
+    )
+
+    (if (equal? ans #f)
+        (State wolframalpha-answer no-result)
+        (let* ((text-ans (cadr (cadddr (cadddr ans))))
+               ; Remove '(', ')', and '|' from the answer, if any
+               (cleaned-ans (string-trim (string-filter
+                   (lambda (c) (not (or (char=? #\( c)
+                                        (char=? #\) c)
+                                        (char=? #\| c)))) text-ans)))
+               ; Remove newline and split them into words
+               (ans-lines (string-split cleaned-ans #\newline))
+               (ans-in-words (append-map (lambda (l) (string-split l #\ )) ans-lines)))
+            ; Turn the answer into WordNodes, ignore the empty strings
+            (State wolframalpha-answer (List (map Word
+                (remove (lambda (w) (equal? w "")) ans-in-words))))
         )
     )
 
+    (finish-fetch wolframalpha-fetch wolframalpha)
+
     ; Return for the GroundedSchemaNode
     (Set)
 )
 
+; The weather takes two fetches: where we are, and then its weather
 (define (ask-weather)
     (if (not (equal? owm-appid ""))
         (begin
             (State openweathermap process-started)
-            (begin-thread
-                (define ip-api "http://freegeoip.net/xml/")
-                (define ip-body (xml->sxml (response-body-port (http-get ip-api #:streaming? #t))))
-                (define ip-resp (car (last-pair ip-body)))
-                (define country-code
-                    (cadr (find (lambda (i) (and (pair? i) (equal? 'CountryCode (car i)))) ip-resp)))
-
-                (define owm-url (string-append "http://api.openweathermap.org/data/2.5/weather?q="
-                    country-code "&appid=" owm-appid "&mode=xml&units=imperial"))
-                (define owm-body (xml->sxml (response-body-port (http-get owm-url #:streaming? #t))))
-                (define owm-resp (car (last-pair owm-body)))
-                (define temp (find (lambda (d) (and (pair? d) (equal? 'temperature (car d)))) owm-resp))
-                (define humidity (find (lambda (d) (and (pair? d) (equal? 'humidity (car d)))) owm-resp))
-                (define weather (find (lambda (d) (and (pair? d) (equal? 'weather (car d)))) owm-resp))
-                (define temp-val (cadr (cadr (cadr temp))))
-                (define humidity-val (cadr (cadr (cadr humidity))))
-                (define weather-val (cadr (cadr (cadr weather))))
-
-                (if (equal? weather-val #f)
-                    (State openweathermap-answer no-result)
-                    (State openweathermap-answer (List (append
-                        (list (Word "it's"))
-                        (map Word (string-split weather-val #\ ))
-                        (list (Word "temperature") (Word temp-val) (Word "fahrenheit"))
-                        (list (Word "humidity") (Word humidity-val) (Word "percent"))
-                    )))
-                )
-
-                (State openweathermap process-finished)
-            )
+            (fetch-url-async openweathermap-location-fetch
+                "http://freegeoip.net/xml/" fetch-timeout)
+        )
+    )
+
+    ; Return for the GroundedSchemaNode
+    (Set)
+)
+
+(define (read-weather-location)
+    (define ip-body (fetched-sxml openweathermap-location-fetch))
+    (define country-code
+        (and ip-body
+            (let ((cc (find (lambda (i) (and (pair? i) (equal? 'CountryCode (car i))))
+                    (car (last-pair ip-body)))))
+                (and cc (cadr cc)))))
+
+    (State openweathermap-location-fetch default-state)
+    (if country-code
+        (fetch-url-async openweathermap-fetch
+            (string-append "http://api.openweathermap.org/data/2.5/weather?q="
+                country-code "&appid=" owm-appid "&mode=xml&units=imperial")
+            fetch-timeout)
+        (begin
+            (State openweathermap-answer no-result)
+            (State openweathermap process-finished)
+        )
+    )
+
+    ; Return for the GroundedSchemaNode
+    (Set)
+)
+
+(define (read-weather)
+    (define owm-body (fetched-sxml openweathermap-fetch))
+    (define owm-resp (if owm-body (car (last-pair owm-body)) '()))
+    (define temp (find (lambda (d) (and (pair? d) (equal? 'temperature (car d)))) owm-resp))
+    (define humidity (find (lambda (d) (and (pair? d) (equal? 'humidity (car d)))) owm-resp))
+    (define weather (find (lambda (d) (and (pair? d) (equal? 'weather (car d)))) owm-resp))
+
+    (if (not (and temp humidity weather (cadr (cadr (cadr weather)))))
+        (State openweathermap-answer no-result)
+        (let ((temp-val (cadr (cadr (cadr temp))))
+              (humidity-val (cadr (cadr (cadr humidity))))
+              (weather-val (cadr (cadr (cadr weather)))))
+            (State openweathermap-answer (List (append
+                (list (Word "it's"))
+                (map Word (string-split weather-val #\ ))
+                (list (Word "temperature") (Word temp-val) (Word "fahrenheit"))
+                (list (Word "humidity") (Word humidity-val) (Word "percent"))
+            )))
         )
     )
 
+    (finish-fetch openweathermap-fetch openweathermap)
+
     ; Return for the GroundedSchemaNode
     (Set)
 )
@@ -0,0 +1,48 @@
+;
+; fetch.scm
+;
+; Fetching from external sources without waiting for them.
+;
+; (use-modules (opencog nlp chatbot-psi fetch))
+; (fetch-url-async (Anchor "weather") "http://..." 10)
+;
+(define-module (opencog nlp chatbot-psi fetch))
+
+(use-modules (opencog))
+(use-modules (opencog oc-config))
+
+(load-extension (string-append opencog-ext-path-chatbot-psi-fetch "libchatbot-psi-fetch") "opencog_nlp_fetch_init")
+
+; The states of a marker, see fetch-url-async
+(define-public fetch-pending (Concept "FetchPending"))
+(define-public fetch-done (Concept "FetchDone"))
+(define-public fetch-failed (Concept "FetchFailed"))
+
+(set-procedure-property! fetch-url-async 'documentation
+"
+  fetch-url-async MARKER URL SECS -- start an HTTP GET of URL in the
+  background, giving up after SECS seconds, or 30 if SECS isn't
+  positive, and return at once. MARKER is in the state fetch-pending, i.e.
+
+     (State MARKER (Concept \"FetchPending\"))
+
+  until the fetch is over, and then in the state fetch-done, or else
+  fetch-failed. By then, fetch-body gives the response, and MARKER has
+  the HTTP status as a FloatValue under (Predicate \"*-fetch-code-*\"),
+  and what went wrong, if anything, as a StringValue under
+  (Predicate \"*-fetch-error-*\").
+
+  A psi rule with the StateLink in its context, such as
+
+     (Equal (Set fetch-done) (Get (State MARKER (Variable \"$s\"))))
+
+  is looked at again once the fetch is over, so that the psi loop does
+  not have to wait for it. Returns #f, doing nothing, if a fetch for
+  MARKER is still pending.
+")
+
+(set-procedure-property! fetch-body 'documentation
+"
+  fetch-body MARKER -- the response of the last fetch for MARKER, as
+  a string; empty if there is none.
+")
@@ -341,6 +341,61 @@
     "openweathermap"
 )
 
+; The external sources are read once they have been fetched, so that the
+; psi loop never waits on the network
+
+(psi-set-controlled-rule
+    (psi-rule
+        (list (SequentialAnd
+            (DefinedPredicate "duckduckgo-fetched?")
+        ))
+        (True (ExecutionOutput (GroundedSchema "scm: read-duckduckgo") (List)))
+        (True)
+        (stv .9 .9)
+        sociality
+    )
+    "duckduckgo"
+)
+
+(psi-set-controlled-rule
+    (psi-rule
+        (list (SequentialAnd
+            (DefinedPredicate "wolframalpha-fetched?")
+        ))
+        (True (ExecutionOutput (GroundedSchema "scm: read-wolframalpha") (List)))
+        (True)
+        (stv .9 .9)
+        sociality
+    )
+    "wolframalpha"
+)
+
+(psi-set-controlled-rule
+    (psi-rule
+        (list (SequentialAnd
+            (DefinedPredicate "weather-location-fetched?")
+        ))
+        (True (ExecutionOutput (GroundedSchema "scm: read-weather-location") (List)))
+        (True)
+        (stv .9 .9)
+        sociality
+    )
+    "openweathermap"
+)
+
+(psi-set-controlled-rule
+    (psi-rule
+        (list (SequentialAnd
+            (DefinedPredicate "weather-fetched?")
+        ))
+        (True (ExecutionOutput (GroundedSchema "scm: read-weather") (List)))
+        (True)
+        (stv .9 .9)
+        sociality
+    )
+    "openweathermap"
+)
+
 (psi-set-controlled-rule
     (psi-rule
         (list (SequentialAnd
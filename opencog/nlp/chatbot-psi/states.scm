@@ -52,16 +52,24 @@
 (define duckduckgo-answer (Anchor (chat-prefix "DuckDuckGoAnswer")))
 (State duckduckgo default-state)
 (State duckduckgo-answer default-state)
+(define duckduckgo-fetch (Anchor (chat-prefix "DuckDuckGoFetch")))
+(State duckduckgo-fetch default-state)
 
 (define wolframalpha (Anchor (chat-prefix "WolframAlpha")))
 (define wolframalpha-answer (Anchor (chat-prefix "WolframAlphaAnswer")))
 (State wolframalpha setup-not-done)  ; An AppID is required to use WolframAlpha
 (State wolframalpha-answer default-state)
+(define wolframalpha-fetch (Anchor (chat-prefix "WolframAlphaFetch")))
+(State wolframalpha-fetch default-state)
 
 (define openweathermap (Anchor (chat-prefix "OpenWeatherMap")))
 (define openweathermap-answer (Anchor (chat-prefix "OpenWeatherMapAnswer")))
 (State openweathermap setup-not-done)  ; An AppID is required to use OpenWeatherMap
 (State openweathermap-answer default-state)
+(define openweathermap-location-fetch (Anchor (chat-prefix "OpenWeatherMapLocationFetch")))
+(State openweathermap-location-fetch default-state)
+(define openweathermap-fetch (Anchor (chat-prefix "OpenWeatherMapFetch")))
+(State openweathermap-fetch default-state)
 
 (define random-pkd-sentence-generator (Anchor (chat-prefix "RandomPKDSentenceGenerator")))
 (define random-blogs-sentence-generator (Anchor (chat-prefix "RandomBlogsSentenceGenerator")))
@@ -108,12 +116,16 @@
     (State fuzzy-reply-conf default-state)
     (State duckduckgo default-state)
     (State duckduckgo-answer default-state)
+    (State duckduckgo-fetch default-state)
     (if has-wolframalpha-setup
         (State wolframalpha default-state))
     (State wolframalpha-answer default-state)
+    (State wolframalpha-fetch default-state)
     (if has-openweathermap-setup
         (State openweathermap default-state))
     (State openweathermap-answer default-state)
+    (State openweathermap-location-fetch default-state)
+    (State openweathermap-fetch default-state)
     (if has-markov-setup (begin
         (State random-pkd-sentence-generator default-state)
         (State random-blogs-sentence-generator default-state)
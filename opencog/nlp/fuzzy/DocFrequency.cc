@@ -0,0 +1,259 @@
+/*
+ * nlp/fuzzy/DocFrequency.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/neighbors/Neighbors.h>
+#include <opencog/nlp/types/atom_types.h>
+
+#include "DocFrequency.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+typedef std::unordered_map<const AtomSpace*, std::unique_ptr<DocFrequency>> Registry;
+
+static std::mutex& registry_mutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+static Registry& registry()
+{
+    static Registry tables;
+    return tables;
+}
+
+/**
+ * Get the table of the given AtomSpace, creating it if needed.
+ */
+DocFrequency& DocFrequency::instance(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+
+    std::unique_ptr<DocFrequency>& table = registry()[as];
+    if (table == nullptr)
+        table.reset(new DocFrequency(as));
+    return *table;
+}
+
+/**
+ * Drop the table of the given AtomSpace.  This must be called before
+ * the AtomSpace goes away, as the table is connected to its signals.
+ */
+void DocFrequency::release(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+    registry().erase(as);
+}
+
+DocFrequency::DocFrequency(AtomSpace* a) :
+    as(a),
+    built(false),
+    sentences(0)
+{
+    add_conn = as->atomAddedSignal().connect(
+        [this](const Handle& h) { on_add(h); });
+
+    remove_conn = as->atomRemovedSignal().connect(
+        [this](const AtomPtr& a)
+        {
+            Type t = a->get_type();
+            if (t == LEMMA_LINK or t == WORD_INSTANCE_LINK or
+                t == PARSE_LINK or t == SENTENCE_NODE)
+            {
+                std::lock_guard<std::mutex> lck(mtx);
+                built = false;
+            }
+        });
+}
+
+DocFrequency::~DocFrequency()
+{
+    as->atomAddedSignal().disconnect(add_conn);
+    as->atomRemovedSignal().disconnect(remove_conn);
+}
+
+/**
+ * Count a sentence for a word, unless it has been counted already.
+ *
+ * @param w     The WordNode
+ * @param sent  The SentenceNode
+ */
+void DocFrequency::add_occurrence(const Handle& w, const Handle& sent)
+{
+    // The words of the sentences of a snapshot are counted in it
+    if (snapshot_sentences.count(sent)) return;
+
+    if (seen[w].insert(sent).second)
+        counts[w->get_name()]++;
+}
+
+/**
+ * Count the sentences of a WordInstanceNode for its WordNodes.
+ *
+ * @param wi  The WordInstanceNode
+ */
+void DocFrequency::add_instance(const Handle& wi)
+{
+    for (const Handle& w : get_target_neighbors(wi, LEMMA_LINK))
+        for (const Handle& p : get_target_neighbors(wi, WORD_INSTANCE_LINK))
+            for (const Handle& sent : get_target_neighbors(p, PARSE_LINK))
+                add_occurrence(w, sent);
+}
+
+/**
+ * Update the table when a new atom is added.  The three links of a word
+ * occurrence may be added in any order, so whichever of them completes
+ * the chain gets it counted.
+ *
+ * @param h  The new atom
+ */
+void DocFrequency::on_add(const Handle& h)
+{
+    Type t = h->get_type();
+    if (t != LEMMA_LINK and t != WORD_INSTANCE_LINK and
+        t != PARSE_LINK and t != SENTENCE_NODE)
+        return;
+
+    std::lock_guard<std::mutex> lck(mtx);
+
+    // Will be counted by the scan
+    if (not built) return;
+
+    if (t == SENTENCE_NODE)
+        sentences++;
+
+    else if (t == PARSE_LINK)
+    {
+        const Handle& p = h->getOutgoingAtom(0);
+        for (const Handle& wi : get_source_neighbors(p, WORD_INSTANCE_LINK))
+            add_instance(wi);
+    }
+
+    else
+        add_instance(h->getOutgoingAtom(0));
+}
+
+/**
+ * Count everything from scratch; called with the lock held.
+ */
+void DocFrequency::build(void)
+{
+    counts.clear();
+    seen.clear();
+    snapshot_sentences.clear();
+
+    sentences = (size_t) as->get_num_atoms_of_type(SENTENCE_NODE);
+
+    HandleSeq lemma_links;
+    as->get_handles_by_type(std::back_inserter(lemma_links), LEMMA_LINK);
+    for (const Handle& l : lemma_links)
+        add_instance(l->getOutgoingAtom(0));
+
+    built = true;
+}
+
+size_t DocFrequency::num_sentences(void)
+{
+    std::lock_guard<std::mutex> lck(mtx);
+    if (not built) build();
+    return sentences;
+}
+
+/**
+ * @param w  A WordNode
+ * @return   The no. of sentences containing an instance of it
+ */
+size_t DocFrequency::num_sentences_with(const Handle& w)
+{
+    std::lock_guard<std::mutex> lck(mtx);
+    if (not built) build();
+
+    auto it = counts.find(w->get_name());
+    return (it == counts.end()) ? 0 : it->second;
+}
+
+/**
+ * Write the table to a file: the no. of sentences on the first line,
+ * then one "count word" line per word.
+ *
+ * @param path  The file to write to
+ * @return      True if the file was written
+ */
+bool DocFrequency::save(const std::string& path)
+{
+    std::lock_guard<std::mutex> lck(mtx);
+    if (not built) build();
+
+    std::ofstream out(path);
+    if (not out) return false;
+
+    out << sentences << "\n";
+    for (const auto& c : counts)
+        out << c.second << " " << c.first << "\n";
+
+    return bool(out);
+}
+
+/**
+ * Replace the table with one saved by save(), instead of scanning the
+ * AtomSpace.  The snapshot should have been taken on the same sentences
+ * as are in the AtomSpace now; sentences added from now on are counted
+ * on top of it.  The words of the sentences there now are taken to be
+ * counted in the snapshot, so that the links of those sentences that
+ * are added from now on, e.g. those of another parse, are not counted
+ * again; only the sentences are looked up, not their words.
+ *
+ * @param path  The file to read from
+ * @return      True if the snapshot was loaded
+ */
+bool DocFrequency::load(const std::string& path)
+{
+    std::ifstream in(path);
+    if (not in) return false;
+
+    size_t total;
+    if (not (in >> total)) return false;
+
+    std::unordered_map<std::string, size_t> loaded;
+    size_t cnt;
+    std::string word;
+    while (in >> cnt and std::getline(in >> std::ws, word))
+        loaded[word] = cnt;
+
+    UnorderedHandleSet present;
+    as->get_handles_by_type(std::inserter(present, present.end()), SENTENCE_NODE);
+
+    std::lock_guard<std::mutex> lck(mtx);
+    counts.swap(loaded);
+    seen.clear();
+    snapshot_sentences.swap(present);
+    sentences = total;
+    built = true;
+
+    return true;
+}
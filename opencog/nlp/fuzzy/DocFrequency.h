@@ -0,0 +1,111 @@
+/*
+ * DocFrequency.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef DOC_FREQUENCY_H
+#define DOC_FREQUENCY_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+class AtomSpace;
+
+namespace nlp
+{
+
+/**
+ * The number of sentences each word appears in, for the IDF part of the
+ * fuzzy matcher's TF-IDF weights.  A word appears in a sentence if one
+ * of its instances is connected to the sentence like this:
+ *
+ * LemmaLink
+ *   WordInstanceNode "like@123"
+ *   WordNode "like"
+ *
+ * WordInstanceLink
+ *   WordInstanceNode "like@123"
+ *   ParseNode "sentence@456_parse_0"
+ *
+ * ParseLink
+ *   ParseNode "sentence@456_parse_0"
+ *   SentenceNode "sentence@456"
+ *
+ * There is one table per AtomSpace, reached via instance().  It is built
+ * by scanning the AtomSpace on the first query, unless a snapshot was
+ * loaded, and then kept up to date from the AtomSpace's add signal, so
+ * that it follows every way of ingesting parses (LgParseLink, the RelEx
+ * loaders, ...).  Removing any of the links above makes the next query
+ * rebuild the table.
+ */
+class DocFrequency
+{
+    public:
+        ~DocFrequency();
+
+        static DocFrequency& instance(AtomSpace*);
+        static void release(AtomSpace*);
+
+        // Total no. of sentences
+        size_t num_sentences(void);
+
+        // No. of sentences that contain the given WordNode
+        size_t num_sentences_with(const Handle&);
+
+        // Snapshots of the table, for warm restarts on the same data
+        bool save(const std::string&);
+        bool load(const std::string&);
+
+    private:
+        DocFrequency(AtomSpace*);
+
+        void on_add(const Handle&);
+        void add_occurrence(const Handle&, const Handle&);
+        void add_instance(const Handle&);
+        void build(void);
+
+        AtomSpace* as;
+        int add_conn;
+        int remove_conn;
+
+        std::mutex mtx;
+        bool built;
+
+        size_t sentences;
+
+        // Sentence counts by word name, and the sentences already
+        // counted for each WordNode
+        std::unordered_map<std::string, size_t> counts;
+        std::unordered_map<Handle, UnorderedHandleSet> seen;
+
+        // The sentences in the AtomSpace when a snapshot was loaded,
+        // whose words it has counted already
+        UnorderedHandleSet snapshot_sentences;
+};
+
+}
+}
+
+#endif  // DOC_FREQUENCY_H
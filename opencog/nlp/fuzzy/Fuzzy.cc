@@ -22,14 +22,22 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <functional>
+#include <iterator>
+
 #include <opencog/atoms/base/Node.h>
 #include <opencog/atoms/core/FindUtils.h>
 #include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/executor/Executor.h>
 #include <opencog/neighbors/GetPredicates.h>
 #include <opencog/neighbors/Neighbors.h>
+#include <opencog/nlp/index/LinguisticIndex.h>
 #include <opencog/nlp/types/atom_types.h>
+#include <opencog/nlp/types/InstanceName.h>
 
+#include "DocFrequency.h"
 #include "Fuzzy.h"
+#include "MinHashIndex.h"
 
 using namespace opencog::nlp;
 using namespace opencog;
@@ -46,7 +54,8 @@ Fuzzy::Fuzzy(AtomSpace* a, Type tt, const HandleSeq& ll, bool af_only) :
     bank(&attentionbank(as)),
     rtn_type(tt),
     _af_only(af_only),
-    excl_list(ll)
+    excl_list(ll),
+    excl_set(ll.begin(), ll.end())
 {
 }
 
@@ -113,76 +122,200 @@ static void examine(const Handle& h, HandleSeq& wi, HandleSeq& sl)
  *   WordInstanceNode "like@123"
  *   WordNode "like"
  *
+ * The link is looked up in the LinguisticIndex of the AtomSpace; it is
+ * followed directly only for a word from some other AtomSpace.
+ *
  * @param h  The WordInstanceNode
  */
-static Handle get_word(const Handle& h)
+Handle Fuzzy::get_word(const Handle& h)
 {
-    return get_target_neighbors(h, LEMMA_LINK)[0];
+    Handle w(LinguisticIndex::instance(as).get_lemma(h));
+    if (w) return w;
+    return first_target_neighbor(h, LEMMA_LINK);
 }
 
 /**
- * Compare the WordNode associates with the WordInstanceNode
+ * Get the ID of the WordNode associates with the WordInstanceNode. The
+ * IDs are given out in the order the WordNodes are first seen, and are
+ * only meaningful within this Fuzzy object.
  *
- * @param h1, h2  Handles of the nodes being compared
+ * @param wi  The WordInstanceNode
+ * @return    The ID of its WordNode
  */
-static bool compare_word(const Handle& h1, const Handle& h2)
+uint32_t Fuzzy::get_word_id(const Handle& wi)
 {
-    return get_word(h1) < get_word(h2);
+    auto it = word_inst_ids.find(wi);
+    if (it != word_inst_ids.end())
+        return it->second;
+
+    auto wit = word_ids.emplace(get_word(wi), (uint32_t) word_ids.size()).first;
+    word_inst_ids[wi] = wit->second;
+    return wit->second;
 }
 
 /**
- * Compare two trees and return a similarity score.
+ * Get the words and SimilarityLinks of a tree, examining it only the
+ * first time it's asked for.
  *
- * @param h1, h2  The two trees that will be compared
- * @return        A similarity score between the two trees
+ * @param h  The tree
+ * @return   Its words, sorted by ID, and SimilarityLinks, sorted
  */
-double Fuzzy::fuzzy_compare(const Handle& h1, const Handle& h2)
+const Fuzzy::TreeWords& Fuzzy::get_tree_words(const Handle& h)
 {
-    start_search(h1);
+    auto it = tree_words.find(h);
+    if (it != tree_words.end())
+        return it->second;
+
+    HandleSeq wis;
+    TreeWords& tw = tree_words[h];
+    examine(h, wis, tw.simlks);
+    std::sort(tw.simlks.begin(), tw.simlks.end());
+
+    std::pmr::vector<std::pair<uint32_t, Handle>> by_id(&arena);
+    for (const Handle& wi : wis)
+        by_id.push_back({get_word_id(wi), wi});
+    std::sort(by_id.begin(), by_id.end());
 
-    HandleSeq soln_word_insts;
-    HandleSeq soln_simlks;
-    examine(h2, soln_word_insts, soln_simlks);
-    std::sort(soln_word_insts.begin(), soln_word_insts.end(), compare_word);
-    std::sort(soln_simlks.begin(), soln_simlks.end());
+    for (const auto& p : by_id)
+    {
+        tw.word_ids.push_back(p.first);
+        tw.word_insts.push_back(p.second);
+    }
 
-    HandleSeq common_words;
-    std::set_intersection(target_word_insts.begin(), target_word_insts.end(),
-                          soln_word_insts.begin(), soln_word_insts.end(),
-                          std::back_inserter(common_words), compare_word);
+    return tw;
+}
+
+/**
+ * Merge two sorted lists of word IDs, and collect the positions in the
+ * first one of the words they have in common. Like std::set_intersection,
+ * a word that appears n and m times is common min(n, m) times. The loop
+ * advances both sides without branching on the comparison.
+ *
+ * @param a, b    The sorted word IDs
+ * @param common  The positions in a of the common words
+ */
+static void merge_common(const std::vector<uint32_t>& a,
+                         const std::vector<uint32_t>& b,
+                         std::pmr::vector<size_t>& common)
+{
+    size_t i = 0, j = 0;
+    const size_t na = a.size(), nb = b.size();
 
-    HandleSeq common_simlks;
+    while (i < na and j < nb)
+    {
+        uint32_t x = a[i], y = b[j];
+        if (x == y) common.push_back(i);
+        i += (x <= y);
+        j += (y <= x);
+    }
+}
+
+/**
+ * Score a potential solution against the target, which is set up by
+ * start_search().
+ *
+ * @param soln      The potential solution
+ * @param sw        Its words and SimilarityLinks
+ * @param n_common  Set to the no. of words it has in common with the target
+ * @return          The similarity score
+ */
+double Fuzzy::common_score(const Handle& soln, const TreeWords& sw,
+                           size_t& n_common)
+{
+    // Get the common words
+    std::pmr::vector<size_t> common_words(&arena);
+    merge_common(target_word_ids, sw.word_ids, common_words);
+    n_common = common_words.size();
+
+    // Check if the soln has any atoms that are similar to the pattern
+    ArenaHandleSeq common_simlks(&arena);
     std::set_intersection(target_simlks.begin(), target_simlks.end(),
-                          soln_simlks.begin(), soln_simlks.end(),
+                          sw.simlks.begin(), sw.simlks.end(),
                           std::back_inserter(common_simlks));
 
     auto rm_simlk = [&](const Handle& s)
     {
         const HandleSeq& os = s->getOutgoingSet();
-        bool in_h1 = is_atom_in_tree(h1, os[0]);
-        bool in_h2 = is_atom_in_tree(h2, os[0]);
 
-        if (in_h1 and in_h2) return true;
+        if (in_target(os[0]) and in_tree(soln, os[0])) return true;
 
         return false;
     };
 
+    // Make sure one of the atoms in the SimilarityLink is from target,
+    // and the other one is from soln
     common_simlks.erase(std::remove_if(common_simlks.begin(),
         common_simlks.end(), rm_simlk), common_simlks.end());
 
+    // Initial value
     double score = 0;
 
-    for (const Handle& c : common_words)
-        score += get_score(c);
+    for (size_t c : common_words)
+        score += get_score(target_word_insts[c]);
 
     for (const Handle& s : common_simlks)
         score += s->getTruthValue()->get_mean() * NODE_WEIGHT;
 
-    score /= std::max(target_word_insts.size(), soln_word_insts.size());
+    score /= std::max(target_word_insts.size(), sw.word_insts.size());
 
     return score;
 }
 
+/**
+ * Compare two trees and return a similarity score.
+ *
+ * @param h1, h2  The two trees that will be compared
+ * @return        A similarity score between the two trees
+ */
+double Fuzzy::fuzzy_compare(const Handle& h1, const Handle& h2)
+{
+    start_search(h1);
+
+    size_t n_common;
+    return common_score(h2, get_tree_words(h2), n_common);
+}
+
+/**
+ * Compare each of the rows with each of the columns, giving the same
+ * scores as fuzzy_compare(row, col) would.  The columns are examined
+ * once, and each row is set up as the target once; the rows can be
+ * scored in parallel.
+ *
+ * @param rows, cols    The trees that will be compared
+ * @param num_threads   The most threads to score the rows with
+ * @return              The rows.size() x cols.size() scores, row by row
+ */
+std::vector<double> Fuzzy::fuzzy_compare_matrix(const HandleSeq& rows,
+                                                const HandleSeq& cols,
+                                                unsigned num_threads)
+{
+    std::vector<TreeWords> col_words;
+    for (const Handle& c : cols)
+        col_words.push_back(get_tree_words(c));
+
+    // Each row gets a copy of this one as its starting point, so there is
+    // no need for them to copy the columns too
+    tree_words.clear();
+
+    std::vector<double> matrix(rows.size() * cols.size());
+
+    auto score_row = [&](size_t r)
+    {
+        Fuzzy fz(*this);
+        fz.start_search(rows[r]);
+
+        size_t n_common;
+        for (size_t c = 0; c < cols.size(); c++)
+            matrix[r * cols.size() + c] =
+                fz.common_score(cols[c], col_words[c], n_common);
+    };
+
+    Executor::instance().parallel_for(rows.size(), score_row,
+                                      std::max(num_threads, 1u));
+
+    return matrix;
+}
+
 /**
  * A function intends to reflect how important a word is to a
  * document in a collection or corpus, which will be used in
@@ -198,35 +331,28 @@ void Fuzzy::calculate_tfidf(const HandleSeq& word_insts)
     // No. of words in the sentence
     int num_of_words = word_insts.size();
 
+    DocFrequency& df = DocFrequency::instance(as);
+
     // Total no. of sentences in the AtomSpace
-    size_t num_of_sents = (size_t) as->get_num_atoms_of_type(SENTENCE_NODE);
+    size_t num_of_sents = df.num_sentences();
 
     for (const Handle& wi : word_insts)
     {
         if (tfidf_weights.count(wi)) continue;
 
         Handle w = get_word(wi);
+        uint32_t id = get_word_id(wi);
 
         auto word_match = [&](const Handle& h)
         {
-            return w == get_word(h);
+            return id == get_word_id(h);
         };
 
         // No. of times this word exists in the sentence
         int word_cnt = std::count_if(word_insts.begin(), word_insts.end(), word_match);
 
-        HandleSet hs;
-        for (const Handle& l : get_source_neighbors(w, LEMMA_LINK))
-        {
-            for (const Handle& p : get_target_neighbors(l, WORD_INSTANCE_LINK))
-            {
-                const HandleSeq& sent_nodes = get_target_neighbors(p, PARSE_LINK);
-                hs.insert(sent_nodes.begin(), sent_nodes.end());
-            }
-        }
-
         // No. of sentences that contain this word
-        size_t num_sents_contains_it = hs.size();
+        size_t num_sents_contains_it = df.num_sentences_with(w);
 
         double tf = (double) word_cnt / num_of_words;
         double idf = log2((double) num_of_sents / num_sents_contains_it);
@@ -274,12 +400,51 @@ void Fuzzy::get_ling_rel(const HandleSeq& hs)
  */
 void Fuzzy::start_search(const Handle& trg)
 {
-    target = trg;
-    examine(target, target_word_insts, target_simlks);
+    set_target(trg);
+    excl_trees.clear();
+
+    const TreeWords& tw = get_tree_words(target);
+    target_word_ids = tw.word_ids;
+    target_word_insts = tw.word_insts;
+    target_simlks = tw.simlks;
+
     calculate_tfidf(target_word_insts);
     get_ling_rel(target_word_insts);
-    std::sort(target_word_insts.begin(), target_word_insts.end(), compare_word);
-    std::sort(target_simlks.begin(), target_simlks.end());
+
+    std::vector<double> word_scores;
+    for (const Handle& wi : target_word_insts)
+        word_scores.push_back(get_score(wi));
+    std::sort(word_scores.begin(), word_scores.end(), std::greater<double>());
+
+    best_scores.assign(1, 0);
+    for (double ws : word_scores)
+        best_scores.push_back(best_scores.back() + ws);
+}
+
+/**
+ * An upper bound of the score of a potential solution, given only its
+ * size: at best, it has min(target, soln) of the highest-scoring target
+ * words, and every SimilarityLink is a common one with a mean of 1.
+ *
+ * @param n_word_insts  The no. of WordInstanceNodes of the solution
+ * @param n_simlks      The no. of SimilarityLinks of the solution
+ * @return              The highest score the solution could get
+ */
+double Fuzzy::score_bound(size_t n_word_insts, size_t n_simlks)
+{
+    size_t n_common = std::min(target_word_insts.size(), n_word_insts);
+    size_t n_common_simlks = std::min(target_simlks.size(), n_simlks);
+
+    double bound = best_scores[n_common] + n_common_simlks * NODE_WEIGHT;
+
+    return bound / std::max(target_word_insts.size(), n_word_insts);
+}
+
+// Order for a min-heap of solutions
+static bool higher_score(const std::pair<Handle, double>& s1,
+                         const std::pair<Handle, double>& s2)
+{
+    return s1.second > s2.second;
 }
 
 /**
@@ -300,7 +465,38 @@ bool Fuzzy::accept_starter(const Handle& hp)
     Type t = hp->get_type();
 
     return (t == CONCEPT_NODE or t == PREDICATE_NODE) and
-           hp->get_name().find("@") == std::string::npos;
+           not is_instance_name(hp->get_name());
+}
+
+/**
+ * Check if a tree contains any of the atoms in the excl_list.  The answer
+ * is remembered for each subtree, so that the trees proposed further up
+ * the incoming sets only have to look at the subtrees right below them.
+ *
+ * @param h  The tree
+ * @return   True if it contains an unwanted atom
+ */
+bool Fuzzy::has_excluded(const Handle& h)
+{
+    if (excl_set.empty())
+        return false;
+
+    auto it = excl_trees.find(h);
+    if (it != excl_trees.end())
+        return it->second;
+
+    bool excluded = excl_set.count(h) > 0;
+
+    if (not excluded and h->is_link())
+        for (const Handle& o : h->getOutgoingSet())
+            if (has_excluded(o))
+            {
+                excluded = true;
+                break;
+            }
+
+    excl_trees[h] = excluded;
+    return excluded;
 }
 
 /**
@@ -330,69 +526,139 @@ bool Fuzzy::try_match(const Handle& soln)
         return true;
 
     // Reject if we have seen the exact same one before
-    if (std::find(solns_seen.begin(), solns_seen.end(), soln) != solns_seen.end())
+    if (not solns_seen.insert(soln).second)
         return false;
 
-    solns_seen.insert(soln);
-
     // Reject if it contains any unwanted atoms
-    for (const Handle& excl : excl_list)
-        if (is_atom_in_tree(soln, excl))
-            return false;
+    if (has_excluded(soln))
+        return false;
 
-    HandleSeq soln_word_insts;
-    HandleSeq soln_simlks;
-    examine(soln, soln_word_insts, soln_simlks);
-    std::sort(soln_word_insts.begin(), soln_word_insts.end(), compare_word);
-    std::sort(soln_simlks.begin(), soln_simlks.end());
+    const TreeWords& sw = get_tree_words(soln);
+    size_t n_soln_words = sw.word_insts.size();
 
-    // Get the common words
-    HandleSeq common_words;
-    std::set_intersection(target_word_insts.begin(), target_word_insts.end(),
-                          soln_word_insts.begin(), soln_word_insts.end(),
-                          std::back_inserter(common_words), compare_word);
+    // Skip the scoring if it can't make it into the best K anyway; the
+    // ones as big as the target are always scored, in case they are
+    // identical to it
+    if (max_results > 0 and solns.size() == max_results and
+        n_soln_words != target_word_insts.size() and
+        score_bound(n_soln_words, sw.simlks.size()) <= solns.front().second)
+        return true;
+
+    size_t n_common;
+    double score = common_score(soln, sw, n_common);
 
     // Reject if it's identical to the input
-    if (common_words.size() == target_word_insts.size() and
-        common_words.size() == soln_word_insts.size())
+    if (n_common == target_word_insts.size() and n_common == n_soln_words)
         return false;
 
-    // Check if the soln has any atoms that are similar to the pattern
-    HandleSeq common_simlks;
-    std::set_intersection(target_simlks.begin(), target_simlks.end(),
-                          soln_simlks.begin(), soln_simlks.end(),
-                          std::back_inserter(common_simlks));
+    // Accept and store the solution
+    if (score > 0)
+        add_soln(soln, score);
 
-    auto rm_simlk = [&](const Handle& s)
+    return true;
+}
+
+/**
+ * Store an accepted solution; when only the best K are wanted, it
+ * replaces the worst of them if it's better.
+ *
+ * @param soln   The solution
+ * @param score  Its similarity score
+ */
+void Fuzzy::add_soln(const Handle& soln, double score)
+{
+    if (max_results == 0)
+        solns.push_back(std::make_pair(soln, score));
+
+    else if (solns.size() < max_results or score > solns.front().second)
     {
-        const HandleSeq& os = s->getOutgoingSet();
-        bool in_target = is_atom_in_tree(target, os[0]);
-        bool in_soln = is_atom_in_tree(soln, os[0]);
+        if (solns.size() == max_results)
+        {
+            std::pop_heap(solns.begin(), solns.end(), higher_score);
+            solns.pop_back();
+        }
 
-        if (in_target and in_soln) return true;
+        solns.push_back(std::make_pair(soln, score));
+        std::push_heap(solns.begin(), solns.end(), higher_score);
+    }
+}
 
-        return false;
-    };
+/**
+ * Make a copy of this matcher, with the target already set up, for
+ * exploring some of the starters in another thread.
+ */
+std::unique_ptr<FuzzyMatch> Fuzzy::fork_worker(void)
+{
+    return std::unique_ptr<FuzzyMatch>(new Fuzzy(*this));
+}
 
-    // Make sure one of the atoms in the SimilarityLink is from target,
-    // and the other one is from soln
-    common_simlks.erase(std::remove_if(common_simlks.begin(),
-        common_simlks.end(), rm_simlk), common_simlks.end());
+/**
+ * Merge the solutions found by a copy made by fork_worker(), dropping
+ * the ones that have been found already.
+ *
+ * @param fm  The copy
+ */
+void Fuzzy::join_worker(FuzzyMatch& fm)
+{
+    Fuzzy& worker = static_cast<Fuzzy&>(fm);
 
-    // Initial value
-    double score = 0;
+    for (const auto& s : worker.solns)
+        if (solns_seen.insert(s.first).second)
+            add_soln(s.first, s.second);
+}
 
-    for (const Handle& c : common_words)
-        score += get_score(c);
+/**
+ * When only the atoms in the attentional focus are wanted, and there are
+ * fewer of them than the trees right above the starters, it's cheaper to
+ * go through the attentional focus than to explore the incoming sets and
+ * throw away almost everything found.  The atoms of the rtn_type in the
+ * attentional focus are then scored directly, whether or not the trees
+ * in between them and the starters are in the attentional focus too.
+ *
+ * Otherwise, if there is a MinHashIndex of the rtn_type, the atoms most
+ * likely to share words with the target are taken from it.  The index
+ * only knows of words, so a target with SimilarityLinks is searched by
+ * exploring the starters, as before: the solutions similar to it only
+ * through those, including the atoms without words, which the index has
+ * no signature for, would be missed.
+ *
+ * @param starters  The starters found in the target
+ * @param cands     The candidates to be scored
+ * @return          True if the candidates should be used instead of
+ *                  exploring the starters
+ */
+bool Fuzzy::get_candidates(const HandleSeq& starters, HandleSeq& cands)
+{
+    if (_af_only)
+    {
+        HandleSeq af;
+        bank->get_handle_set_in_attentional_focus(std::back_inserter(af));
 
-    for (const Handle& s : common_simlks)
-        score += s->getTruthValue()->get_mean() * NODE_WEIGHT;
+        // The no. of trees a traversal would propose first
+        size_t fan_out = 0;
+        for (const Handle& h : starters)
+            fan_out += h->getIncomingSetSize();
 
-    score /= std::max(target_word_insts.size(), soln_word_insts.size());
+        if (af.size() < fan_out)
+        {
+            for (const Handle& h : af)
+                if (h->get_type() == rtn_type)
+                    cands.push_back(h);
 
-    // Accept and store the solution
-    if (score > 0)
-        solns.push_back(std::make_pair(soln, score));
+            return true;
+        }
+    }
+
+    MinHashIndex* index = MinHashIndex::find(as, rtn_type);
+    if (index == nullptr or target_word_insts.empty() or
+        not target_simlks.empty())
+        return false;
+
+    std::vector<std::string> words;
+    for (const Handle& wi : target_word_insts)
+        words.push_back(get_word(wi)->get_name());
+
+    cands = index->query(words, INDEX_CANDIDATES);
 
     return true;
 }
@@ -426,10 +692,7 @@ double Fuzzy::get_score(const Handle& h)
 RankedHandleSeq Fuzzy::finished_search(void)
 {
     // Sort the solutions by their similarity scores
-    std::sort(solns.begin(), solns.end(),
-        [] (std::pair<Handle, double> s1, std::pair<Handle, double> s2) {
-            return s1.second > s2.second;
-    });
+    std::sort(solns.begin(), solns.end(), higher_score);
 
     return solns;
 }
@@ -25,6 +25,9 @@
 #ifndef FUZZY_H
 #define FUZZY_H
 
+#include <unordered_map>
+#include <vector>
+
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/attentionbank/bank/AttentionBank.h>
 #include <opencog/nlp/fuzzy/FuzzyMatchBasic.h>
@@ -45,11 +48,23 @@ class Fuzzy :
         // Compare two hypergraphs and return a similarity score
         double fuzzy_compare(const Handle&, const Handle&);
 
+        // Compare each of the first hypergraphs with each of the second
+        // ones; the scores are returned row by row
+        std::vector<double> fuzzy_compare_matrix(const HandleSeq&,
+                                                 const HandleSeq&,
+                                                 unsigned num_threads = 1);
+
+        // Only keep the best K solutions; 0 (the default) keeps all
+        void set_max_results(size_t k) { max_results = k; }
+
     protected:
         virtual void start_search(const Handle&);
         virtual bool accept_starter(const Handle&);
         virtual bool try_match(const Handle&);
         virtual RankedHandleSeq finished_search(void);
+        virtual std::unique_ptr<FuzzyMatch> fork_worker(void);
+        virtual void join_worker(FuzzyMatch&);
+        virtual bool get_candidates(const HandleSeq&, HandleSeq&);
 
     private:
         // For estimating similarity
@@ -57,6 +72,9 @@ class Fuzzy :
         double RARENESS_WEIGHT = 0.2;
         double LINGUISTIC_RELATION_WEIGHT = 0.3;
 
+        // The most candidates to take from a MinHashIndex
+        size_t INDEX_CANDIDATES = 1000;
+
         AtomSpace* as;
         AttentionBank* bank;
 
@@ -68,23 +86,54 @@ class Fuzzy :
 
         // The atoms that we don't want in the solutions
         HandleSeq excl_list;
+        UnorderedHandleSet excl_set;
+
+        // Whether a tree contains any of the excl_list, for the trees
+        // seen during the current search
+        std::unordered_map<Handle, bool> excl_trees;
+        bool has_excluded(const Handle&);
+
+        // The words and SimilarityLinks of a tree; the words are kept as
+        // sorted IDs of their WordNodes, so that two trees can be compared
+        // with a single merge
+        struct TreeWords
+        {
+            std::vector<uint32_t> word_ids;
+            HandleSeq word_insts;   // in the same order as word_ids
+            HandleSeq simlks;       // sorted
+        };
 
         // The target (input)
         HandleSeq target_word_insts;
         HandleSeq target_simlks;
+        std::vector<uint32_t> target_word_ids;
 
-        // The solutions
+        // The solutions; a min-heap on the score when max_results is set
         RankedHandleSeq solns;
-        HandleSet solns_seen;
+        UnorderedHandleSet solns_seen;
+        size_t max_results = 0;
+
+        // best_scores[n] is the highest total score n of the target words
+        // can get, for bounding the score of a potential solution
+        std::vector<double> best_scores;
 
         // Some caches
+        std::unordered_map<Handle, uint32_t> word_ids;
+        std::unordered_map<Handle, uint32_t> word_inst_ids;
+        std::unordered_map<Handle, TreeWords> tree_words;
         std::map<Handle, double> tfidf_weights;
         std::map<Handle, double> ling_rel_weights;
         std::map<Handle, double> scores;
 
+        Handle get_word(const Handle&);
         void calculate_tfidf(const HandleSeq&);
         void get_ling_rel(const HandleSeq&);
         double get_score(const Handle&);
+        double score_bound(size_t, size_t);
+        uint32_t get_word_id(const Handle&);
+        const TreeWords& get_tree_words(const Handle&);
+        double common_score(const Handle&, const TreeWords&, size_t&);
+        void add_soln(const Handle&, double);
 };
 
 }
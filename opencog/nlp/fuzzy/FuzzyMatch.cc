@@ -21,28 +21,46 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <atomic>
+
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/core/FindUtils.h>
+#include <opencog/executor/Executor.h>
 
 #include "FuzzyMatch.h"
 
 using namespace opencog;
 
 /**
- * Recursively explores the incoming set of a proposed tree until
- * either `try_match()` returns false or the "root" is reached.
+ * Explores the incoming sets above a starter, breadth-first, until
+ * either `try_match()` returns false, the "root" is reached, or the
+ * maximum depth is reached.  Trees that have been proposed before
+ * during this search are skipped, along with everything above them.
  *
- * @param h  A proposed tree
+ * @param h  A starter
  */
 void FuzzyMatch::explore(const Handle& h)
 {
-	for (const Handle& lptr : h->getIncomingSet())
+	frontier.clear();
+	frontier.emplace_back(h, 0);
+
+	while (not frontier.empty())
 	{
-		Handle soln(lptr->get_handle());
-		bool look_for_more = try_match(soln);
+		Handle cur = frontier.front().first;
+		size_t depth = frontier.front().second + 1;
+		frontier.pop_front();
+
+		for (const Handle& lptr : cur->getIncomingSet())
+		{
+			Handle soln(lptr->get_handle());
+			if (not visited.insert(soln).second) continue;
 
-		if (look_for_more) explore(soln);
+			bool look_for_more = try_match(soln);
+
+			if (look_for_more and (0 == max_depth or depth < max_depth))
+				frontier.emplace_back(soln, depth);
+		}
 	}
 }
 
@@ -50,14 +68,14 @@ void FuzzyMatch::explore(const Handle& h)
  * Recursively explores the target pattern and proposes each subtree
  * as a possible starting point for a similarity search. If the subtree
  * is accepted as a starting point, then all trees sharing the subtree
- * are proposed as being similar.
+ * will be proposed as being similar.
  *
  * @param hp  A subtree of the target pattern.
  */
 void FuzzyMatch::find_starters(const Handle& hp)
 {
 	if (accept_starter(hp))
-		explore(hp);
+		starters.push_back(hp);
 
 	// Check if there is a similar tree, explore it if there is one
 	// and is accepted as a starting point
@@ -65,7 +83,7 @@ void FuzzyMatch::find_starters(const Handle& hp)
 		if (lptr->get_type() == SIMILARITY_LINK)
 			for (const Handle& h : lptr->getOutgoingSet())
 				if (h != hp and accept_starter(h))
-					explore(h);
+					starters.push_back(h);
 
 	// Proposed start was not accepted. Look farther down, at it's
 	// sub-trees.
@@ -74,16 +92,68 @@ void FuzzyMatch::find_starters(const Handle& hp)
 			find_starters(h);
 }
 
+/**
+ * Explore the starters with several copies of this matcher, one per
+ * Executor task.  Each copy keeps its own visited set, so a tree
+ * reachable from starters in two tasks is proposed in both, and
+ * join_worker() has to drop the duplicates.
+ *
+ * @return  False if the search should be done in the calling thread
+ *          instead
+ */
+bool FuzzyMatch::parallel_explore(void)
+{
+	size_t n = std::min((size_t) num_threads, starters.size());
+	if (n < 2) return false;
+
+	std::vector<std::unique_ptr<FuzzyMatch>> workers;
+	for (size_t i = 0; i < n; i++)
+	{
+		std::unique_ptr<FuzzyMatch> w(fork_worker());
+		if (w == nullptr) return false;
+		workers.push_back(std::move(w));
+	}
+
+	std::atomic<size_t> next(0);
+	auto work = [&](size_t w)
+	{
+		for (size_t i = next++; i < starters.size(); i = next++)
+			workers[w]->explore(starters[i]);
+	};
+
+	Executor::instance().parallel_for(n, work, n);
+
+	for (auto& w : workers)
+		join_worker(*w);
+
+	return true;
+}
+
 /**
  * Find leaves at which a search can be started.
  */
 RankedHandleSeq FuzzyMatch::perform_search(const Handle& target)
 {
+	visited.clear();
+	starters.clear();
 	start_search(target);
 
 	// Find starting atoms from which to begin matches.
 	find_starters(target);
 
+	HandleSeq cands;
+	if (get_candidates(starters, cands))
+	{
+		for (const Handle& h : cands)
+			if (visited.insert(h).second)
+				try_match(h);
+	}
+	else if (not parallel_explore())
+		for (const Handle& h : starters)
+			explore(h);
+
 	// Give the derived class a chance to wrap things up.
-	return finished_search();
+	RankedHandleSeq solns = finished_search();
+	arena.release();
+	return solns;
 }
@@ -24,8 +24,12 @@
 #ifndef FUZZY_MATCH_H
 #define FUZZY_MATCH_H
 
+#include <deque>
+#include <memory>
+
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atoms/base/Link.h>
+#include <opencog/neighbors/QueryArena.h>
 
 namespace opencog
 {
@@ -70,6 +74,23 @@ namespace opencog
  * true, then larger and larger trees holding the starter are proposed.
  * If it returns false, then the proposal of the ever-larger trees
  * halts.
+ *
+ * The incoming sets are explored breadth-first, and each tree is
+ * proposed at most once per search, even if it is reachable from several
+ * leaves or along several paths.  `set_max_depth()` optionally limits
+ * how many levels above a starter are explored.
+ *
+ * With `set_num_threads()`, the starters are spread over several
+ * threads.  Each thread explores with its own copy of the matcher, made
+ * by `fork_worker()` once the search has started, and the copies are
+ * handed back to `join_worker()` at the end to merge what they found.
+ * A class that doesn't implement `fork_worker()` is always searched in
+ * the calling thread.
+ *
+ * Once the starters are found, `get_candidates()` may offer a list of
+ * trees to be proposed to `try_match()` directly, instead of exploring
+ * the incoming sets above the starters; e.g. when the solutions are
+ * known to be among a small set of atoms.
  */
 
 typedef std::vector<std::pair<Handle, double>> RankedHandleSeq;
@@ -80,15 +101,52 @@ public:
     RankedHandleSeq perform_search(const Handle&);
     virtual ~FuzzyMatch() {}
 
+    // Explore at most this many levels of incoming sets above each
+    // starter; 0 (the default) means no limit
+    void set_max_depth(size_t d) { max_depth = d; }
+
+    // Explore the starters with this many threads; 1 (the default)
+    // explores them one after another in the calling thread
+    void set_num_threads(unsigned n) { num_threads = n; }
+
 protected:
     virtual void start_search(const Handle&) = 0;
     virtual bool accept_starter(const Handle&) = 0;
     virtual bool try_match(const Handle&) = 0;
     virtual RankedHandleSeq finished_search(void) = 0;
 
+    // For the parallel search; see above
+    virtual std::unique_ptr<FuzzyMatch> fork_worker(void) { return nullptr; }
+    virtual void join_worker(FuzzyMatch&) {}
+
+    // Return true to propose the candidates given, instead of exploring
+    // the starters; see above
+    virtual bool get_candidates(const HandleSeq& starters, HandleSeq& cands)
+    {
+        return false;
+    }
+
+    // For the short-lived containers of try_match() and the like; it
+    // is released once a search is finished
+    QueryArena arena;
+
 private:
     void find_starters(const Handle&);
     void explore(const Handle&);
+    bool parallel_explore(void);
+
+    size_t max_depth = 0;
+    unsigned num_threads = 1;
+
+    // The starters, in the order they are found
+    HandleSeq starters;
+
+    // The trees already proposed during the current search
+    UnorderedHandleSet visited;
+
+    // The queue of the breadth-first exploration, with the depth of each
+    // tree above its starter
+    std::deque<std::pair<Handle, size_t>> frontier;
 };
 
 } // namespace opencog
@@ -53,15 +53,87 @@ static void get_all_atoms(const Handle& h, HandleSeq& nlist, HandleSeq& alist)
 }
 
 /**
- * Set up the target.
+ * Start a new search for the given target, forgetting the trees
+ * flattened for the previous one.
  *
  * @param trg  The target
  */
-void FuzzyMatchBasic::start_search(const Handle& trg)
+void FuzzyMatchBasic::set_target(const Handle& trg)
 {
 	target = trg;
+	flattenings.clear();
+
+	target_nodes.clear();
+	target_atoms.clear();
 	get_all_atoms(target, target_nodes, target_atoms);
 	std::sort(target_nodes.begin(), target_nodes.end());
+
+	target_atom_set.clear();
+	target_atom_set.insert(target_atoms.begin(), target_atoms.end());
+}
+
+/**
+ * Get the sorted nodes and the size of a tree, flattening it only the
+ * first time it's asked for during a search.
+ *
+ * @param h  The tree
+ * @return   Its flattening
+ */
+const FuzzyMatchBasic::Flattening& FuzzyMatchBasic::get_flattening(const Handle& h)
+{
+	auto it = flattenings.find(h);
+	if (it != flattenings.end())
+		return it->second;
+
+	Flattening fl;
+	fl.n_atoms = 1;
+
+	if (h->is_node())
+		fl.nodes.emplace_back(h);
+
+	else
+	{
+		for (const Handle& o : h->getOutgoingSet())
+		{
+			// References to the elements of an unordered_map stay valid
+			// as it grows
+			const Flattening& ofl = get_flattening(o);
+
+			size_t mid = fl.nodes.size();
+			fl.nodes.insert(fl.nodes.end(), ofl.nodes.begin(), ofl.nodes.end());
+			std::inplace_merge(fl.nodes.begin(), fl.nodes.begin() + mid,
+			                   fl.nodes.end());
+			fl.n_atoms += ofl.n_atoms;
+		}
+	}
+
+	return flattenings.emplace(h, std::move(fl)).first->second;
+}
+
+/**
+ * Check if an atom is in a tree; for a node, this is a binary search of
+ * the flattening of the tree.
+ *
+ * @param tree  The tree
+ * @param h     The atom
+ */
+bool FuzzyMatchBasic::in_tree(const Handle& tree, const Handle& h)
+{
+	if (h->is_link())
+		return is_atom_in_tree(tree, h);
+
+	const HandleSeq& nodes = get_flattening(tree).nodes;
+	return std::binary_search(nodes.begin(), nodes.end(), h);
+}
+
+/**
+ * Set up the target.
+ *
+ * @param trg  The target
+ */
+void FuzzyMatchBasic::start_search(const Handle& trg)
+{
+	set_target(trg);
 }
 
 /**
@@ -84,21 +156,18 @@ bool FuzzyMatchBasic::accept_starter(const Handle& hp)
  */
 bool FuzzyMatchBasic::try_match(const Handle& soln)
 {
-	if (is_atom_in_tree(target, soln)) return false;
+	if (in_target(soln)) return false;
 
 	// Find out how many atoms it has in common with the pattern
-	HandleSeq soln_nodes;
-	HandleSeq soln_atoms;
-	get_all_atoms(soln, soln_nodes, soln_atoms);
-	std::sort(soln_nodes.begin(), soln_nodes.end());
+	const Flattening& sf = get_flattening(soln);
 
-	HandleSeq common_nodes;
+	ArenaHandleSeq common_nodes(&arena);
 	std::set_intersection(target_nodes.begin(), target_nodes.end(),
-	                      soln_nodes.begin(), soln_nodes.end(),
+	                      sf.nodes.begin(), sf.nodes.end(),
 	                      std::back_inserter(common_nodes));
 
 	// The size different between the pattern and the potential solution
-	size_t diff = std::abs((int)target_atoms.size() - (int)soln_atoms.size());
+	size_t diff = std::abs((int)target_atoms.size() - (int)sf.n_atoms);
 
 	double similarity = common_nodes.size();
 
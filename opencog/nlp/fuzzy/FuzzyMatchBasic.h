@@ -24,6 +24,8 @@
 #ifndef FUZZY_MATCH_BASIC_H
 #define FUZZY_MATCH_BASIC_H
 
+#include <unordered_map>
+
 #include <opencog/nlp/fuzzy/FuzzyMatch.h>
 
 namespace opencog
@@ -36,6 +38,11 @@ namespace opencog
  * tree, and the ones with the highest scores are returned.
  *
  * This class implements certain specific similarity score.
+ *
+ * The trees proposed during a search are flattened only once; as the
+ * search goes up the incoming sets, a tree is flattened by merging the
+ * flattenings of the trees right below it, which have usually been
+ * proposed already.
  */
 class FuzzyMatchBasic : public FuzzyMatch
 {
@@ -45,12 +52,30 @@ protected:
     virtual bool try_match(const Handle&);
     virtual RankedHandleSeq finished_search(void);
 
+    // The nodes of a tree, sorted, and its size in atoms
+    struct Flattening
+    {
+        HandleSeq nodes;
+        size_t n_atoms;
+    };
+
+    void set_target(const Handle&);
+    const Flattening& get_flattening(const Handle&);
+
+    // Whether the atom is in the target, or in the given tree
+    bool in_target(const Handle& h) const { return target_atom_set.count(h) > 0; }
+    bool in_tree(const Handle& tree, const Handle&);
+
     // What we are matching
     Handle target;
     HandleSeq target_nodes;
     HandleSeq target_atoms;
+    UnorderedHandleSet target_atom_set;
 
 private:
+    // The flattenings of the trees seen during the current search
+    std::unordered_map<Handle, Flattening> flattenings;
+
     // The solutions that were found.
     RankedHandleSeq solns;
 
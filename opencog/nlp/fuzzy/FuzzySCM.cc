@@ -22,7 +22,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <atomic>
+#include <string>
+
 #include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/FloatValue.h>
 
 namespace opencog
 {
@@ -38,7 +42,21 @@ class FuzzySCM
 
         Handle find_approximate_match(Handle);
         Handle do_nlp_fuzzy_match(Handle, Type, const HandleSeq&,bool);
+        Handle do_nlp_fuzzy_match_top_k(Handle, Type, const HandleSeq&,
+                                        bool, int);
+        Handle fuzzy_match(AtomSpace*, const Handle&, Type,
+                           const HandleSeq&, bool, size_t);
         Handle do_nlp_fuzzy_compare(Handle, Handle);
+        ValuePtr do_nlp_fuzzy_compare_matrix(const HandleSeq&,
+                                             const HandleSeq&);
+        void set_num_threads(int);
+        bool save_doc_frequency(const std::string&);
+        bool load_doc_frequency(const std::string&);
+        void index_type(Type);
+        void unindex_type(Type);
+        void release(void);
+
+        std::atomic<unsigned> num_threads;
 
     public:
         FuzzySCM();
@@ -48,15 +66,33 @@ class FuzzySCM
 }
 
 extern "C" {
+/**
+ * Implement the "nlp-fuzzy-release" scheme primitive. It drops the
+ * document-frequency table and the MinHash indexes kept for the current
+ * AtomSpace, which are connected to its signals; it has to be called
+ * before the AtomSpace is deleted, while no fuzzy match is running on it.
+ */
+void FuzzySCM::release(void)
+{
+    AtomSpace* as = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("nlp-fuzzy-release"));
+    DocFrequency::release(as);
+    MinHashIndex::release(as);
+}
+
 void opencog_nlp_fuzzy_init(void);
 };
 
 
 #include <opencog/guile/SchemePrimitive.h>
+#include <opencog/nlp/index/ScratchPool.h>
 #include <opencog/nlp/types/atom_types.h>
+#include <opencog/tracing/Tracer.h>
 
+#include "DocFrequency.h"
 #include "Fuzzy.h"
 #include "FuzzyMatchBasic.h"
+#include "MinHashIndex.h"
 
 using namespace opencog::nlp;
 using namespace opencog;
@@ -64,7 +100,8 @@ using namespace opencog;
 /**
  * The constructor for FuzzySCM.
  */
-FuzzySCM::FuzzySCM()
+FuzzySCM::FuzzySCM() :
+    num_threads(1)
 {
     static bool is_init = false;
     if (is_init) return;
@@ -106,9 +143,30 @@ void FuzzySCM::init()
         &FuzzySCM::find_approximate_match, this, "nlp fuzzy");
     define_scheme_primitive("nlp-fuzzy-match", &FuzzySCM::do_nlp_fuzzy_match,
                             this, "nlp fuzzy");
+    define_scheme_primitive("nlp-fuzzy-match-top-k",
+        &FuzzySCM::do_nlp_fuzzy_match_top_k, this, "nlp fuzzy");
 
     define_scheme_primitive("nlp-fuzzy-compare", &FuzzySCM::do_nlp_fuzzy_compare,
                             this, "nlp fuzzy");
+
+    define_scheme_primitive("nlp-fuzzy-compare-matrix",
+        &FuzzySCM::do_nlp_fuzzy_compare_matrix, this, "nlp fuzzy");
+
+    define_scheme_primitive("nlp-fuzzy-set-threads",
+        &FuzzySCM::set_num_threads, this, "nlp fuzzy");
+
+    define_scheme_primitive("nlp-fuzzy-save-doc-frequency",
+        &FuzzySCM::save_doc_frequency, this, "nlp fuzzy");
+    define_scheme_primitive("nlp-fuzzy-load-doc-frequency",
+        &FuzzySCM::load_doc_frequency, this, "nlp fuzzy");
+
+    define_scheme_primitive("nlp-fuzzy-index-type",
+        &FuzzySCM::index_type, this, "nlp fuzzy");
+    define_scheme_primitive("nlp-fuzzy-unindex-type",
+        &FuzzySCM::unindex_type, this, "nlp fuzzy");
+
+    define_scheme_primitive("nlp-fuzzy-release",
+        &FuzzySCM::release, this, "nlp fuzzy");
 }
 
 Handle FuzzySCM::find_approximate_match(Handle hp)
@@ -138,8 +196,36 @@ Handle FuzzySCM::do_nlp_fuzzy_match(Handle pat, Type rtn_type,
                                     bool af_only)
 {
     AtomSpace* as = SchemeSmob::ss_get_env_as("nlp-fuzzy-match");
+    return fuzzy_match(as, pat, rtn_type, excl_list, af_only, 0);
+}
+
+/**
+ * Implement the "nlp-fuzzy-match-top-k" scheme primitive. Same as
+ * "nlp-fuzzy-match", but only the K most similar solutions are kept,
+ * which lets the matcher skip scoring the ones that can't make it.
+ *
+ * @param k  The no. of solutions wanted
+ */
+Handle FuzzySCM::do_nlp_fuzzy_match_top_k(Handle pat, Type rtn_type,
+                                          const HandleSeq& excl_list,
+                                          bool af_only, int k)
+{
+    AtomSpace* as = SchemeSmob::ss_get_env_as("nlp-fuzzy-match-top-k");
+    return fuzzy_match(as, pat, rtn_type, excl_list, af_only,
+                       (k > 0) ? k : 1);
+}
 
-    Fuzzy fpm(as, rtn_type, excl_list, af_only);
+Handle FuzzySCM::fuzzy_match(AtomSpace* as, const Handle& pat,
+                             Type rtn_type, const HandleSeq& excl_list,
+                             bool af_only, size_t max_results)
+{
+    TraceSpan span("nlp-fuzzy-match", "nlp");
+    span.arg("max-results", max_results);
+
+    // Search under any scratch AtomSpace, but leave the results in it
+    Fuzzy fpm(nlp::ScratchPool::base_of(as), rtn_type, excl_list, af_only);
+    fpm.set_max_results(max_results);
+    fpm.set_num_threads(num_threads);
 
     // A vector of solutions sorted in descending order of similarity
     RankedHandleSeq solns = fpm.perform_search(pat);
@@ -154,6 +240,7 @@ Handle FuzzySCM::do_nlp_fuzzy_match(Handle pat, Type rtn_type,
     }
 
     // Wrap everything in a ListLink and then return it
+    span.arg("solutions", rtn_solns.size());
     Handle results = as->add_link(LIST_LINK, std::move(rtn_solns));
 
     return results;
@@ -170,13 +257,119 @@ Handle FuzzySCM::do_nlp_fuzzy_compare(Handle h1, Handle h2)
 {
     AtomSpace* as = SchemeSmob::ss_get_env_as("nlp-fuzzy-compare");
 
-    Fuzzy fpm(as);
+    Fuzzy fpm(nlp::ScratchPool::base_of(as));
 
     double score = fpm.fuzzy_compare(h1, h2);
 
     return as->add_node(NUMBER_NODE, std::to_string(score));
 }
 
+/**
+ * Implement the "nlp-fuzzy-compare-matrix" scheme primitive. It gives the
+ * same scores as calling "nlp-fuzzy-compare" on every pair, but sets up
+ * each tree only once; the rows are scored with the threads set by
+ * "nlp-fuzzy-set-threads".
+ *
+ * @param rows, cols  The trees being compared
+ * @return            A FloatValue of the rows x cols scores, row by row
+ */
+ValuePtr FuzzySCM::do_nlp_fuzzy_compare_matrix(const HandleSeq& rows,
+                                               const HandleSeq& cols)
+{
+    AtomSpace* as = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("nlp-fuzzy-compare-matrix"));
+
+    Fuzzy fpm(as);
+
+    return createFloatValue(fpm.fuzzy_compare_matrix(rows, cols, num_threads));
+}
+
+/**
+ * Implement the "nlp-fuzzy-set-threads" scheme primitive. It sets the
+ * no. of threads nlp-fuzzy-match spreads its starting points over; 1,
+ * the default, does not start any thread.
+ *
+ * @param n  The no. of threads
+ */
+void FuzzySCM::set_num_threads(int n)
+{
+    num_threads = (n > 1) ? n : 1;
+}
+
+/**
+ * Implement the "nlp-fuzzy-save-doc-frequency" scheme primitive. It saves
+ * the no. of sentences each word appears in, as used by nlp-fuzzy-match,
+ * to a file.
+ *
+ * @param path  The file to save to
+ * @return      True if it is saved
+ */
+bool FuzzySCM::save_doc_frequency(const std::string& path)
+{
+    AtomSpace* as = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("nlp-fuzzy-save-doc-frequency"));
+    return DocFrequency::instance(as).save(path);
+}
+
+/**
+ * Implement the "nlp-fuzzy-load-doc-frequency" scheme primitive. It loads
+ * a file saved by nlp-fuzzy-save-doc-frequency, so that the counts do not
+ * have to be recomputed from the AtomSpace after a restart.
+ *
+ * @param path  The file to load from
+ * @return      True if it is loaded
+ */
+bool FuzzySCM::load_doc_frequency(const std::string& path)
+{
+    AtomSpace* as = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("nlp-fuzzy-load-doc-frequency"));
+    return DocFrequency::instance(as).load(path);
+}
+
+/**
+ * Implement the "nlp-fuzzy-index-type" scheme primitive. It indexes the
+ * atoms of the given type by their words, so that nlp-fuzzy-match looking
+ * for that type only scores the ones likely to be similar, instead of
+ * everything sharing a word with the input.
+ *
+ * @param t  The type of atoms to index, e.g. SetLink
+ */
+void FuzzySCM::index_type(Type t)
+{
+    AtomSpace* as = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("nlp-fuzzy-index-type"));
+
+    // Build it now rather than on the first match
+    MinHashIndex::instance(as, t).size();
+}
+
+/**
+ * Implement the "nlp-fuzzy-unindex-type" scheme primitive. It drops the
+ * index made by nlp-fuzzy-index-type.
+ *
+ * @param t  The type of atoms indexed
+ */
+void FuzzySCM::unindex_type(Type t)
+{
+    AtomSpace* as = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("nlp-fuzzy-unindex-type"));
+    MinHashIndex::release(as, t);
+}
+
+/**
+ * Implement the "nlp-fuzzy-release" scheme primitive. It drops the
+ * document-frequency table and the MinHash indexes kept for the current
+ * AtomSpace, which are connected to its signals; it has to be called
+ * before the AtomSpace is deleted, while no fuzzy match is running on it.
+ */
+void FuzzySCM::release(void)
+{
+    AtomSpace* as = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("nlp-fuzzy-release"));
+    DocFrequency::release(as);
+    MinHashIndex::release(as);
+}
+
 void opencog_nlp_fuzzy_init(void)
 {
     static FuzzySCM fuzzy;
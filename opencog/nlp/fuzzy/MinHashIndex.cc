@@ -0,0 +1,365 @@
+/*
+ * nlp/fuzzy/MinHashIndex.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/neighbors/Neighbors.h>
+#include <opencog/nlp/types/atom_types.h>
+
+#include "MinHashIndex.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+typedef std::map<std::pair<const AtomSpace*, Type>,
+                 std::unique_ptr<MinHashIndex>> Registry;
+
+static std::mutex& registry_mutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+static Registry& registry()
+{
+    static Registry indexes;
+    return indexes;
+}
+
+/**
+ * Get the index of the atoms of the given type, creating it if needed.
+ */
+MinHashIndex& MinHashIndex::instance(AtomSpace* as, Type t)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+
+    std::unique_ptr<MinHashIndex>& index = registry()[{as, t}];
+    if (index == nullptr)
+        index.reset(new MinHashIndex(as, t));
+    return *index;
+}
+
+/**
+ * @return  The index of the atoms of the given type, or nullptr if
+ *          there isn't one
+ */
+MinHashIndex* MinHashIndex::find(AtomSpace* as, Type t)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+
+    auto it = registry().find({as, t});
+    return (it == registry().end()) ? nullptr : it->second.get();
+}
+
+/**
+ * Drop the index of the atoms of the given type.
+ */
+void MinHashIndex::release(AtomSpace* as, Type t)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+    registry().erase({as, t});
+}
+
+/**
+ * Drop all the indexes of the given AtomSpace.  This must be called
+ * before the AtomSpace goes away, as they are connected to its signals.
+ */
+void MinHashIndex::release(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+
+    Registry& reg = registry();
+    for (auto it = reg.begin(); it != reg.end();)
+    {
+        if (it->first.first == as)
+            it = reg.erase(it);
+        else
+            it++;
+    }
+}
+
+MinHashIndex::MinHashIndex(AtomSpace* a, Type t) :
+    as(a),
+    type(t),
+    built(false),
+    buckets(BANDS)
+{
+    add_conn = as->atomAddedSignal().connect(
+        [this](const Handle& h)
+        {
+            Type t = h->get_type();
+            if (t != type and t != LEMMA_LINK and t != REFERENCE_LINK)
+                return;
+
+            std::lock_guard<std::mutex> lck(mtx);
+            if (not built) return;
+
+            if (t == type) insert(h);
+            else reindex_above(h);
+        });
+
+    remove_conn = as->atomRemovedSignal().connect(
+        [this](const AtomPtr& a)
+        {
+            if (a->get_type() != type) return;
+
+            std::lock_guard<std::mutex> lck(mtx);
+            if (built) erase(a->get_handle());
+        });
+}
+
+MinHashIndex::~MinHashIndex()
+{
+    as->atomAddedSignal().disconnect(add_conn);
+    as->atomRemovedSignal().disconnect(remove_conn);
+}
+
+/**
+ * Collect the names of the words of a tree.
+ *
+ * @param h      The tree
+ * @param words  The names of the WordNodes of its WordInstanceNodes
+ */
+static void get_words(const Handle& h, std::vector<std::string>& words)
+{
+    if (h->is_link())
+    {
+        for (const Handle& o : h->getOutgoingSet())
+            get_words(o, words);
+        return;
+    }
+
+    for (const Handle& lp : h->getIncomingSet())
+    {
+        if (lp->get_type() != REFERENCE_LINK) continue;
+
+        const Handle& wi = lp->getOutgoingAtom(1);
+        if (wi->get_type() != WORD_INSTANCE_NODE or
+            wi->get_name() != h->get_name())
+            continue;
+
+        for (const Handle& w : get_target_neighbors(wi, LEMMA_LINK))
+            words.push_back(w->get_name());
+    }
+}
+
+// A well-mixed 64-bit hash of a 64-bit value
+static uint64_t mix(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Compute the MinHash signature of a set of words; the i-th hash of the
+ * signature is the minimum over the words of a hash seeded with i.
+ *
+ * @param words  The words; duplicates don't matter
+ * @param sig    The signature
+ * @return       False if there are no words to sign
+ */
+bool MinHashIndex::sign(const std::vector<std::string>& words, Signature& sig)
+{
+    if (words.empty()) return false;
+
+    sig.fill(std::numeric_limits<uint64_t>::max());
+
+    std::hash<std::string> hasher;
+    for (const std::string& w : words)
+    {
+        uint64_t wh = hasher(w);
+        for (size_t i = 0; i < sig.size(); i++)
+            sig[i] = std::min(sig[i], mix(wh ^ mix(i)));
+    }
+
+    return true;
+}
+
+/**
+ * The key of the bucket of a signature in a band.
+ */
+uint64_t MinHashIndex::band_key(const Signature& sig, size_t band)
+{
+    uint64_t key = 0;
+    for (size_t r = 0; r < ROWS; r++)
+        key = mix(key ^ sig[band * ROWS + r]);
+    return key;
+}
+
+/**
+ * Index an atom; called with the lock held.  Atoms without any words
+ * are left out, as no query would find them.
+ */
+void MinHashIndex::insert(const Handle& h)
+{
+    std::vector<std::string> words;
+    get_words(h, words);
+
+    Signature sig;
+    if (not sign(words, sig)) return;
+    if (not signatures.emplace(h, sig).second) return;
+
+    for (size_t b = 0; b < BANDS; b++)
+        buckets[b][band_key(sig, b)].insert(h);
+}
+
+/**
+ * Remove an atom from the index; called with the lock held.
+ */
+void MinHashIndex::erase(const Handle& h)
+{
+    auto it = signatures.find(h);
+    if (it == signatures.end()) return;
+
+    for (size_t b = 0; b < BANDS; b++)
+    {
+        auto bit = buckets[b].find(band_key(it->second, b));
+        bit->second.erase(h);
+        if (bit->second.empty()) buckets[b].erase(bit);
+    }
+
+    signatures.erase(it);
+}
+
+/**
+ * Sign again the indexed atoms above the ConceptNode of a word, when a
+ * link that gives it its word is added after them, as the words of an
+ * atom may come after the atom.  Called with the lock held.
+ *
+ * @param h  A new LemmaLink or ReferenceLink
+ */
+void MinHashIndex::reindex_above(const Handle& h)
+{
+    HandleSeq todo;
+    auto add_concept = [&](const Handle& ref)
+    {
+        const Handle& wi = ref->getOutgoingAtom(1);
+        const Handle& c = ref->getOutgoingAtom(0);
+        if (wi->get_type() == WORD_INSTANCE_NODE and
+            c->get_name() == wi->get_name())
+            todo.push_back(c);
+    };
+
+    if (h->get_type() == REFERENCE_LINK)
+    {
+        if (h->get_arity() == 2) add_concept(h);
+    }
+    else
+    {
+        const Handle& wi = h->getOutgoingAtom(0);
+        for (const Handle& ref : wi->getIncomingSetByType(REFERENCE_LINK))
+            if (ref->get_arity() == 2 and ref->getOutgoingAtom(1) == wi)
+                add_concept(ref);
+    }
+
+    UnorderedHandleSet seen;
+    while (not todo.empty())
+    {
+        Handle a(todo.back());
+        todo.pop_back();
+        if (not seen.insert(a).second) continue;
+
+        if (a->get_type() == type)
+        {
+            erase(a);
+            insert(a);
+        }
+
+        for (const Handle& up : a->getIncomingSet())
+            todo.push_back(up);
+    }
+}
+
+/**
+ * Index everything from scratch; called with the lock held.
+ */
+void MinHashIndex::build(void)
+{
+    signatures.clear();
+    for (auto& band : buckets)
+        band.clear();
+
+    HandleSeq atoms;
+    as->get_handles_by_type(std::back_inserter(atoms), type);
+    for (const Handle& h : atoms)
+        insert(h);
+
+    built = true;
+}
+
+/**
+ * Find the indexed atoms that are likely to have many words in common
+ * with the given ones.
+ *
+ * @param words      The words being looked for
+ * @param max_cands  The most atoms to return
+ * @return           The atoms sharing a bucket with the words, sorted by
+ *                   the no. of buckets they share
+ */
+HandleSeq MinHashIndex::query(const std::vector<std::string>& words,
+                              size_t max_cands)
+{
+    Signature sig;
+    if (not sign(words, sig)) return HandleSeq();
+
+    std::lock_guard<std::mutex> lck(mtx);
+    if (not built) build();
+
+    std::unordered_map<Handle, size_t> hits;
+    for (size_t b = 0; b < BANDS; b++)
+    {
+        auto bit = buckets[b].find(band_key(sig, b));
+        if (bit == buckets[b].end()) continue;
+
+        for (const Handle& h : bit->second)
+            hits[h]++;
+    }
+
+    std::vector<std::pair<size_t, Handle>> ranked;
+    for (const auto& hit : hits)
+        ranked.push_back({hit.second, hit.first});
+
+    size_t n = std::min(max_cands, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + n, ranked.end(),
+        [](const std::pair<size_t, Handle>& a,
+           const std::pair<size_t, Handle>& b)
+        { return a.first > b.first; });
+
+    HandleSeq cands;
+    for (size_t i = 0; i < n; i++)
+        cands.push_back(ranked[i].second);
+    return cands;
+}
+
+size_t MinHashIndex::size(void)
+{
+    std::lock_guard<std::mutex> lck(mtx);
+    if (not built) build();
+    return signatures.size();
+}
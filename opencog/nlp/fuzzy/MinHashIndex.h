@@ -0,0 +1,120 @@
+/*
+ * MinHashIndex.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef MIN_HASH_INDEX_H
+#define MIN_HASH_INDEX_H
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+class AtomSpace;
+
+namespace nlp
+{
+
+/**
+ * A locality-sensitive index of the atoms of one type, e.g. the SetLinks
+ * generated by R2L, by the words they contain.  The words of an atom are
+ * found the same way the fuzzy matcher finds them:
+ *
+ * ReferenceLink
+ *   ConceptNode "like@123"
+ *   WordInstanceNode "like@123"
+ *
+ * LemmaLink
+ *   WordInstanceNode "like@123"
+ *   WordNode "like"
+ *
+ * Each atom gets a MinHash signature of the set of its word names, cut
+ * into BANDS bands of ROWS hashes; two atoms share the bucket of a band
+ * with a probability of J^ROWS, where J is the Jaccard similarity of
+ * their words.  A query only looks at the buckets of its own signature,
+ * so its cost depends on how many atoms are similar to it, rather than
+ * on how many share a common word with it.
+ *
+ * An index is only kept for the types asked for via instance(); find()
+ * tells whether there is one.  It is built by scanning the AtomSpace on
+ * the first query, and then kept up to date from the AtomSpace's signals.
+ * An atom is indexed when it's added, and signed again when a LemmaLink
+ * or ReferenceLink below it is added, so that its words may come after
+ * it.  An atom with no words has no signature, and is found by no query;
+ * the fuzzy matcher only scores such atoms by their SimilarityLinks, and
+ * traverses the AtomSpace instead when the target has any.
+ */
+class MinHashIndex
+{
+    public:
+        ~MinHashIndex();
+
+        static MinHashIndex& instance(AtomSpace*, Type);
+        static MinHashIndex* find(AtomSpace*, Type);
+        static void release(AtomSpace*, Type);
+        static void release(AtomSpace*);
+
+        static const size_t BANDS = 16;
+        static const size_t ROWS = 2;
+
+        // The indexed atoms sharing at least one bucket with the given
+        // words, the ones sharing the most first
+        HandleSeq query(const std::vector<std::string>&, size_t max_cands);
+
+        // No. of atoms indexed
+        size_t size(void);
+
+    private:
+        MinHashIndex(AtomSpace*, Type);
+
+        typedef std::array<uint64_t, BANDS * ROWS> Signature;
+
+        static bool sign(const std::vector<std::string>&, Signature&);
+        static uint64_t band_key(const Signature&, size_t);
+
+        void insert(const Handle&);
+        void erase(const Handle&);
+        void reindex_above(const Handle&);
+        void build(void);
+
+        AtomSpace* as;
+        Type type;
+        int add_conn;
+        int remove_conn;
+
+        std::mutex mtx;
+        bool built;
+
+        std::unordered_map<Handle, Signature> signatures;
+
+        // The atoms in each bucket of each band
+        std::vector<std::unordered_map<uint64_t, UnorderedHandleSet>> buckets;
+};
+
+}
+}
+
+#endif  // MIN_HASH_INDEX_H
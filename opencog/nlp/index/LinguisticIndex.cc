@@ -0,0 +1,366 @@
+/*
+ * LinguisticIndex.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/nlp/types/atom_types.h>
+
+#include "LinguisticIndex.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+
+typedef std::unordered_map<const AtomSpace*, std::unique_ptr<LinguisticIndex>> IndexRegistry;
+
+static std::mutex& registry_mutex()
+{
+    static std::mutex mtx;
+    return mtx;
+}
+
+static IndexRegistry& registry()
+{
+    static IndexRegistry indexes;
+    return indexes;
+}
+
+/**
+ * Get the index of the given AtomSpace, building it if needed.
+ */
+LinguisticIndex& LinguisticIndex::instance(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+
+    std::unique_ptr<LinguisticIndex>& index = registry()[as];
+    if (index == nullptr) {
+        index.reset(new LinguisticIndex(as));
+    }
+    return *index;
+}
+
+/**
+ * Drop the index of the given AtomSpace.  This must be called before
+ * the AtomSpace goes away, as the index is connected to its signals.
+ */
+void LinguisticIndex::release(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+    registry().erase(as);
+}
+
+LinguisticIndex::LinguisticIndex(AtomSpace* as) :
+    m_as(as)
+{
+    // connect first, so that nothing added during the scan is missed;
+    // add_link() ignores the links it has already seen
+    m_add_conn = m_as->atomAddedSignal().connect(
+        [this](const Handle& h) {
+            Relation rel;
+            if (get_relation(h, rel)) add_link(h); });
+    m_remove_conn = m_as->atomRemovedSignal().connect(
+        [this](const AtomPtr& a) {
+            Handle h(a);
+            Relation rel;
+            if (get_relation(h, rel)) remove_link(h);
+            else remove_atom(h); });
+
+    for (Type t : {REFERENCE_LINK, LEMMA_LINK, WORD_INSTANCE_LINK,
+                   PARSE_LINK, INTERPRETATION_LINK})
+    {
+        HandleSeq links;
+        m_as->get_handles_by_type(std::back_inserter(links), t);
+        for (const Handle& h : links)
+        {
+            Relation rel;
+            if (get_relation(h, rel)) add_link(h);
+        }
+    }
+}
+
+LinguisticIndex::~LinguisticIndex()
+{
+    m_as->atomAddedSignal().disconnect(m_add_conn);
+    m_as->atomRemovedSignal().disconnect(m_remove_conn);
+}
+
+/**
+ * Tell which of the indexed relations a link is, if any.  ReferenceLinks
+ * are used for other things as well, so they are told apart by the
+ * types of what they link.
+ */
+bool LinguisticIndex::get_relation(const Handle& h, Relation& rel)
+{
+    Type t = h->get_type();
+    if (t != REFERENCE_LINK and t != LEMMA_LINK and
+        t != WORD_INSTANCE_LINK and t != PARSE_LINK and
+        t != INTERPRETATION_LINK)
+        return false;
+
+    if (h->get_arity() != 2) return false;
+
+    Type from = h->getOutgoingAtom(0)->get_type();
+    Type to = h->getOutgoingAtom(1)->get_type();
+
+    if (t == REFERENCE_LINK and from == WORD_INSTANCE_NODE and to == WORD_NODE)
+        rel = WORD;
+    else if (t == REFERENCE_LINK and from == INTERPRETATION_NODE and to == SET_LINK)
+        rel = SETLINK;
+    else if (t == LEMMA_LINK and from == WORD_INSTANCE_NODE)
+        rel = LEMMA;
+    else if (t == WORD_INSTANCE_LINK and from == WORD_INSTANCE_NODE and
+             to == PARSE_NODE)
+        rel = PARSE;
+    else if (t == PARSE_LINK and from == PARSE_NODE and to == SENTENCE_NODE)
+        rel = SENTENCE;
+    else if (t == INTERPRETATION_LINK and from == INTERPRETATION_NODE and
+             to == PARSE_NODE)
+        rel = INTERP_PARSE;
+    else
+        return false;
+
+    return true;
+}
+
+/**
+ * Get the id of an atom, giving it one if it has none; called with the
+ * lock held.
+ */
+LinguisticIndex::Id LinguisticIndex::make_id(const Handle& h)
+{
+    auto it = m_ids.find(h);
+    if (it != m_ids.end()) return it->second;
+
+    Id id;
+    if (not m_free.empty())
+    {
+        id = m_free.back();
+        m_free.pop_back();
+        m_atoms[id] = h;
+    }
+    else
+    {
+        id = m_atoms.size();
+        m_atoms.push_back(h);
+        for (int rel = 0; rel < NUM_RELATIONS; rel++)
+        {
+            m_targets[rel].push_back(NO_ID);
+            m_sources[rel].emplace_back();
+        }
+    }
+
+    m_ids[h] = id;
+    return id;
+}
+
+void LinguisticIndex::add_link(const Handle& h)
+{
+    Relation rel;
+    if (not get_relation(h, rel)) return;
+
+    std::unique_lock<std::shared_mutex> lck(m_mtx);
+
+    Id from = make_id(h->getOutgoingAtom(0));
+    Id to = make_id(h->getOutgoingAtom(1));
+
+    // already indexed, e.g. during the initial scan
+    Id& target = m_targets[rel][from];
+    if (target == to) return;
+
+    // a later link of the same kind wins
+    if (target != NO_ID)
+    {
+        std::vector<Id>& old = m_sources[rel][target];
+        old.erase(std::remove(old.begin(), old.end(), from), old.end());
+    }
+
+    target = to;
+    m_sources[rel][to].push_back(from);
+}
+
+void LinguisticIndex::remove_link(const Handle& h)
+{
+    Relation rel;
+    if (not get_relation(h, rel)) return;
+
+    const Handle& hFrom = h->getOutgoingAtom(0);
+    const Handle& hTo = h->getOutgoingAtom(1);
+
+    std::unique_lock<std::shared_mutex> lck(m_mtx);
+
+    auto fit = m_ids.find(hFrom);
+    auto tit = m_ids.find(hTo);
+    if (fit == m_ids.end() or tit == m_ids.end()) return;
+
+    Id from = fit->second;
+    Id to = tit->second;
+    if (m_targets[rel][from] != to) return;
+
+    m_targets[rel][from] = NO_ID;
+    std::vector<Id>& srcs = m_sources[rel][to];
+    srcs.erase(std::remove(srcs.begin(), srcs.end(), from), srcs.end());
+
+    // fall back on another link of the same kind, if there is one
+    for (const Handle& l : hFrom->getIncomingSetByType(h->get_type()))
+    {
+        Relation lrel;
+        if (l == h or l->getOutgoingAtom(0) != hFrom or
+            not get_relation(l, lrel) or lrel != rel)
+            continue;
+
+        Id other = make_id(l->getOutgoingAtom(1));
+        m_targets[rel][from] = other;
+        m_sources[rel][other].push_back(from);
+        break;
+    }
+}
+
+/**
+ * Give back the id of a removed atom.  The links it was in have been
+ * removed before it, so nothing refers to the id any more.
+ */
+void LinguisticIndex::remove_atom(const Handle& h)
+{
+    std::unique_lock<std::shared_mutex> lck(m_mtx);
+
+    auto it = m_ids.find(h);
+    if (it == m_ids.end()) return;
+
+    Id id = it->second;
+    for (int rel = 0; rel < NUM_RELATIONS; rel++)
+    {
+        m_targets[rel][id] = NO_ID;
+        m_sources[rel][id].clear();
+    }
+
+    m_atoms[id] = Handle::UNDEFINED;
+    m_ids.erase(it);
+    m_free.push_back(id);
+}
+
+LinguisticIndex::Id LinguisticIndex::get_id(const Handle& h) const
+{
+    std::shared_lock<std::shared_mutex> lck(m_mtx);
+
+    auto it = m_ids.find(h);
+    return (it == m_ids.end()) ? NO_ID : it->second;
+}
+
+Handle LinguisticIndex::get_atom(Id id) const
+{
+    std::shared_lock<std::shared_mutex> lck(m_mtx);
+
+    return (id < m_atoms.size()) ? m_atoms[id] : Handle::UNDEFINED;
+}
+
+Handle LinguisticIndex::follow(const Handle& h, Relation rel) const
+{
+    std::shared_lock<std::shared_mutex> lck(m_mtx);
+
+    auto it = m_ids.find(h);
+    if (it == m_ids.end()) return Handle::UNDEFINED;
+
+    Id to = m_targets[rel][it->second];
+    return (to == NO_ID) ? Handle::UNDEFINED : m_atoms[to];
+}
+
+HandleSeq LinguisticIndex::collect(const Handle& h, Relation rel) const
+{
+    std::shared_lock<std::shared_mutex> lck(m_mtx);
+
+    HandleSeq result;
+    auto it = m_ids.find(h);
+    if (it == m_ids.end()) return result;
+
+    for (Id from : m_sources[rel][it->second])
+        result.push_back(m_atoms[from]);
+    return result;
+}
+
+/**
+ * @param winst  A WordInstanceNode
+ * @return       Its WordNode, via the ReferenceLink, if any
+ */
+Handle LinguisticIndex::get_word(const Handle& winst) const
+{
+    return follow(winst, WORD);
+}
+
+/**
+ * @param winst  A WordInstanceNode
+ * @return       Its lemma, via the LemmaLink, if any
+ */
+Handle LinguisticIndex::get_lemma(const Handle& winst) const
+{
+    return follow(winst, LEMMA);
+}
+
+Handle LinguisticIndex::get_parse(const Handle& winst) const
+{
+    return follow(winst, PARSE);
+}
+
+Handle LinguisticIndex::get_sentence(const Handle& parse) const
+{
+    return follow(parse, SENTENCE);
+}
+
+/**
+ * @param parse  A ParseNode
+ * @return       Its WordInstanceNodes, in the order they were added
+ */
+HandleSeq LinguisticIndex::get_word_instances(const Handle& parse) const
+{
+    return collect(parse, PARSE);
+}
+
+HandleSeq LinguisticIndex::get_interpretations(const Handle& parse) const
+{
+    return collect(parse, INTERP_PARSE);
+}
+
+HandleSeq LinguisticIndex::get_parses(const Handle& sentence) const
+{
+    return collect(sentence, SENTENCE);
+}
+
+Handle LinguisticIndex::get_interp_parse(const Handle& interp) const
+{
+    return follow(interp, INTERP_PARSE);
+}
+
+/**
+ * @param interp  An InterpretationNode
+ * @return        The SetLink of its R2L output, if any
+ */
+Handle LinguisticIndex::get_setlink(const Handle& interp) const
+{
+    return follow(interp, SETLINK);
+}
+
+size_t LinguisticIndex::size(void) const
+{
+    std::shared_lock<std::shared_mutex> lck(m_mtx);
+    return m_ids.size();
+}
@@ -0,0 +1,131 @@
+/*
+ * LinguisticIndex.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_NLP_LINGUISTIC_INDEX_H
+#define _OPENCOG_NLP_LINGUISTIC_INDEX_H
+
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+class AtomSpace;
+
+namespace nlp
+{
+
+/**
+ * An index of the links that tie the words of a parse together, as
+ * the loaders and LgParseLink write them:
+ *
+ *    ReferenceLink       WordInstanceNode "cats@1"    WordNode "cats"
+ *    LemmaLink           WordInstanceNode "cats@1"    WordNode "cat"
+ *    WordInstanceLink    WordInstanceNode "cats@1"    ParseNode "sent@2_parse_0"
+ *    ParseLink           ParseNode "sent@2_parse_0"   SentenceNode "sent@2"
+ *    InterpretationLink  InterpretationNode "..."     ParseNode "sent@2_parse_0"
+ *    ReferenceLink       InterpretationNode "..."     SetLink ...
+ *
+ * Each atom that is in one of these links gets a small integer id, and
+ * the links are kept as arrays by id, so that following one is a hash
+ * lookup and an array access, rather than a walk of the incoming set.
+ * The ids of the atoms that are removed are given out again.
+ *
+ * There is one index per AtomSpace, reached via instance(); it is built
+ * by scanning the links once, and then kept up to date from the
+ * AtomSpace's add and remove signals.  Lookups may be done from any
+ * number of threads at once.
+ */
+class LinguisticIndex
+{
+public:
+    typedef uint32_t Id;
+    static const Id NO_ID = UINT32_MAX;
+
+    ~LinguisticIndex();
+
+    static LinguisticIndex& instance(AtomSpace* as);
+    static void release(AtomSpace* as);
+
+    // The id of an atom, or NO_ID if it isn't indexed, and back
+    Id get_id(const Handle& h) const;
+    Handle get_atom(Id id) const;
+
+    // Of a WordInstanceNode
+    Handle get_word(const Handle& winst) const;
+    Handle get_lemma(const Handle& winst) const;
+    Handle get_parse(const Handle& winst) const;
+
+    // Of a ParseNode
+    Handle get_sentence(const Handle& parse) const;
+    HandleSeq get_word_instances(const Handle& parse) const;
+    HandleSeq get_interpretations(const Handle& parse) const;
+
+    // Of a SentenceNode
+    HandleSeq get_parses(const Handle& sentence) const;
+
+    // Of an InterpretationNode
+    Handle get_interp_parse(const Handle& interp) const;
+    Handle get_setlink(const Handle& interp) const;
+
+    size_t size(void) const;
+
+private:
+    LinguisticIndex(AtomSpace* as);
+
+    // The links that are indexed, each from its first atom to its
+    // second one
+    enum Relation { WORD, LEMMA, PARSE, SENTENCE, INTERP_PARSE, SETLINK,
+                    NUM_RELATIONS };
+
+    static bool get_relation(const Handle& h, Relation& rel);
+
+    void add_link(const Handle& h);
+    void remove_link(const Handle& h);
+    void remove_atom(const Handle& h);
+
+    Id make_id(const Handle& h);
+    Handle follow(const Handle& h, Relation rel) const;
+    HandleSeq collect(const Handle& h, Relation rel) const;
+
+    AtomSpace* m_as;
+    int m_add_conn;
+    int m_remove_conn;
+
+    mutable std::shared_mutex m_mtx;
+
+    std::unordered_map<Handle, Id> m_ids;
+    HandleSeq m_atoms;
+    std::vector<Id> m_free;
+
+    // m_targets[rel][id] is the id that the atom links to, and
+    // m_sources[rel][id] are the ids of those that link to it
+    std::vector<Id> m_targets[NUM_RELATIONS];
+    std::vector<std::vector<Id>> m_sources[NUM_RELATIONS];
+};
+
+}
+}
+
+#endif // _OPENCOG_NLP_LINGUISTIC_INDEX_H
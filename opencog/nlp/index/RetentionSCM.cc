@@ -0,0 +1,154 @@
+/*
+ * RetentionSCM.cc
+ *
+ * Scheme bindings of the sentence retention.
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/guile/SchemePrimitive.h>
+#include <opencog/guile/SchemeSmob.h>
+
+#include "SentenceRetention.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+namespace opencog
+{
+namespace nlp
+{
+
+class RetentionSCM
+{
+private:
+    static void* init_in_guile(void*);
+    static void init_in_module(void*);
+    void init(void);
+
+    void set_policy(int, double, int);
+    int evict(void);
+    bool evict_sentence(const Handle&);
+    bool touch(const Handle&);
+    int num_sentences(void);
+
+    SentenceRetention& retention(const char*);
+
+public:
+    RetentionSCM(void);
+};
+
+}
+}
+
+RetentionSCM::RetentionSCM(void)
+{
+    static bool is_init = false;
+    if (is_init) return;
+    is_init = true;
+    scm_with_guile(init_in_guile, this);
+}
+
+void* RetentionSCM::init_in_guile(void* self)
+{
+    scm_c_define_module("opencog nlp retention", init_in_module, self);
+    scm_c_use_module("opencog nlp retention");
+    return NULL;
+}
+
+void RetentionSCM::init_in_module(void* data)
+{
+    RetentionSCM* self = (RetentionSCM*) data;
+    self->init();
+}
+
+void RetentionSCM::init(void)
+{
+    define_scheme_primitive("nlp-retention-set-policy",
+        &RetentionSCM::set_policy, this, "nlp retention");
+    define_scheme_primitive("nlp-retention-evict",
+        &RetentionSCM::evict, this, "nlp retention");
+    define_scheme_primitive("nlp-retention-evict-sentence",
+        &RetentionSCM::evict_sentence, this, "nlp retention");
+    define_scheme_primitive("nlp-retention-touch",
+        &RetentionSCM::touch, this, "nlp retention");
+    define_scheme_primitive("nlp-retention-count",
+        &RetentionSCM::num_sentences, this, "nlp retention");
+}
+
+SentenceRetention& RetentionSCM::retention(const char* fn)
+{
+    return SentenceRetention::instance(SchemeSmob::ss_get_env_as(fn));
+}
+
+/**
+ * Implement the "nlp-retention-set-policy" scheme primitive.
+ */
+void RetentionSCM::set_policy(int max_turns, double max_minutes,
+                              int max_sentences)
+{
+    SentenceRetention::Policy policy;
+    policy.max_turns = (max_turns > 0) ? max_turns : 0;
+    if (max_minutes > 0)
+        policy.max_age = std::chrono::duration_cast<SentenceRetention::Clock::duration>(
+            std::chrono::duration<double, std::ratio<60>>(max_minutes));
+    policy.max_sentences = (max_sentences > 0) ? max_sentences : 0;
+
+    retention("nlp-retention-set-policy").set_policy(policy);
+}
+
+/**
+ * Implement the "nlp-retention-evict" scheme primitive.
+ */
+int RetentionSCM::evict(void)
+{
+    return retention("nlp-retention-evict").evict();
+}
+
+/**
+ * Implement the "nlp-retention-evict-sentence" scheme primitive.
+ */
+bool RetentionSCM::evict_sentence(const Handle& sent)
+{
+    return retention("nlp-retention-evict-sentence").evict(sent);
+}
+
+/**
+ * Implement the "nlp-retention-touch" scheme primitive.
+ */
+bool RetentionSCM::touch(const Handle& h)
+{
+    return retention("nlp-retention-touch").touch(h);
+}
+
+/**
+ * Implement the "nlp-retention-count" scheme primitive.
+ */
+int RetentionSCM::num_sentences(void)
+{
+    return retention("nlp-retention-count").num_sentences();
+}
+
+extern "C" {
+void opencog_nlp_retention_init(void);
+};
+
+void opencog_nlp_retention_init(void)
+{
+    static RetentionSCM retention;
+}
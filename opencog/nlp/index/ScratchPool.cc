@@ -0,0 +1,224 @@
+/*
+ * ScratchPool.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include <unordered_map>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+
+#include "ScratchPool.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+
+typedef std::unordered_map<const AtomSpace*, std::unique_ptr<ScratchPool>> PoolRegistry;
+
+static std::mutex& registry_mutex()
+{
+    static std::mutex mtx;
+    return mtx;
+}
+
+static PoolRegistry& registry()
+{
+    static PoolRegistry pools;
+    return pools;
+}
+
+// Each scratch AtomSpace made by a pool, and the AtomSpace it is over
+static std::unordered_map<const AtomSpace*, AtomSpace*>& bases()
+{
+    static std::unordered_map<const AtomSpace*, AtomSpace*> bs;
+    return bs;
+}
+
+ScratchPool& ScratchPool::instance(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+
+    std::unique_ptr<ScratchPool>& pool = registry()[as];
+    if (pool == nullptr) {
+        pool.reset(new ScratchPool(as));
+    }
+    return *pool;
+}
+
+/**
+ * Drop the pool of the given AtomSpace, with its idle scratch
+ * AtomSpaces.  This must be called before the AtomSpace goes away,
+ * and once none of its scratch AtomSpaces are leased.
+ */
+void ScratchPool::release(AtomSpace* as)
+{
+    std::unique_ptr<ScratchPool> pool;
+    {
+        std::lock_guard<std::mutex> lck(registry_mutex());
+        auto it = registry().find(as);
+        if (it == registry().end()) return;
+        pool = std::move(it->second);
+        registry().erase(it);
+    }
+}
+
+AtomSpace* ScratchPool::base_of(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+
+    auto it = bases().find(as);
+    while (it != bases().end())
+    {
+        as = it->second;
+        it = bases().find(as);
+    }
+    return as;
+}
+
+/**
+ * The capacity is the config value NLP_SCRATCH_POOL_SIZE, if it is
+ * set, and else 8.
+ */
+ScratchPool::ScratchPool(AtomSpace* as) :
+    m_as(as),
+    m_leased(0),
+    m_capacity(8)
+{
+    if (config().has("NLP_SCRATCH_POOL_SIZE"))
+        m_capacity = config().get_int("NLP_SCRATCH_POOL_SIZE");
+}
+
+ScratchPool::~ScratchPool()
+{
+    if (0 < m_leased)
+        logger().warn("[ScratchPool] Dropped with %zu scratch AtomSpaces "
+                      "still leased", m_leased);
+
+    for (std::unique_ptr<AtomSpace>& scratch : m_idle)
+        drop(scratch.release());
+}
+
+/**
+ * Forget a scratch AtomSpace, along with any pool over it, and delete
+ * it.
+ */
+void ScratchPool::drop(AtomSpace* scratch)
+{
+    release(scratch);
+    {
+        std::lock_guard<std::mutex> lck(registry_mutex());
+        bases().erase(scratch);
+    }
+    delete scratch;
+}
+
+ScratchPool::Lease::Lease(Lease&& other) :
+    m_pool(other.m_pool),
+    m_as(other.m_as)
+{
+    other.m_as = nullptr;
+}
+
+ScratchPool::Lease::~Lease()
+{
+    if (m_as) m_pool->give_back(m_as);
+}
+
+ScratchPool::Lease ScratchPool::acquire(void)
+{
+    return Lease(this, take());
+}
+
+/**
+ * An empty scratch AtomSpace, idle or new.  It must be given back.
+ */
+AtomSpace* ScratchPool::take(void)
+{
+    {
+        std::lock_guard<std::mutex> lck(m_mtx);
+        m_leased++;
+        if (not m_idle.empty())
+        {
+            AtomSpace* scratch = m_idle.back().release();
+            m_idle.pop_back();
+            return scratch;
+        }
+    }
+
+    AtomSpace* scratch = new AtomSpace(m_as);
+
+    std::lock_guard<std::mutex> lck(registry_mutex());
+    bases()[scratch] = m_as;
+    return scratch;
+}
+
+/**
+ * Clear the scratch AtomSpace, and keep it for the next lease, if
+ * there is room for it.
+ */
+void ScratchPool::give_back(AtomSpace* scratch)
+{
+    // A pool over this one, from a nested lease, goes with its atoms
+    release(scratch);
+    scratch->clear();
+
+    {
+        std::lock_guard<std::mutex> lck(m_mtx);
+        m_leased--;
+        if (m_idle.size() < m_capacity)
+        {
+            m_idle.emplace_back(scratch);
+            return;
+        }
+    }
+
+    drop(scratch);
+}
+
+void ScratchPool::set_capacity(size_t n)
+{
+    std::vector<std::unique_ptr<AtomSpace>> extra;
+    {
+        std::lock_guard<std::mutex> lck(m_mtx);
+        m_capacity = n;
+        while (m_capacity < m_idle.size())
+        {
+            extra.push_back(std::move(m_idle.back()));
+            m_idle.pop_back();
+        }
+    }
+
+    for (std::unique_ptr<AtomSpace>& scratch : extra)
+        drop(scratch.release());
+}
+
+size_t ScratchPool::num_idle(void)
+{
+    std::lock_guard<std::mutex> lck(m_mtx);
+    return m_idle.size();
+}
+
+size_t ScratchPool::num_leased(void)
+{
+    std::lock_guard<std::mutex> lck(m_mtx);
+    return m_leased;
+}
@@ -0,0 +1,115 @@
+/*
+ * ScratchPool.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#ifndef _OPENCOG_NLP_SCRATCH_POOL_H
+#define _OPENCOG_NLP_SCRATCH_POOL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace opencog
+{
+class AtomSpace;
+
+namespace nlp
+{
+
+/**
+ * A pool of scratch AtomSpaces over one AtomSpace, to hold the atoms
+ * that only live for the length of a query, such as the SetLinks that
+ * SuReal tries out, or the results of a fuzzy match.  Atoms made in a
+ * scratch AtomSpace don't touch the indexes of the AtomSpace it is
+ * over, nor fire its signals, while everything in that one can be seen
+ * from it.
+ *
+ * A scratch AtomSpace is cleared when it is given back, so clearing it
+ * costs only as much as the atoms made in it, whatever the size of the
+ * AtomSpace it is over; it is then kept for the next lease, up to the
+ * capacity of the pool.
+ *
+ * There is one pool per AtomSpace, reached via instance().  The scheme
+ * code that calls SuReal and the fuzzy matcher in a scratch AtomSpace
+ * still has them search the AtomSpace under it; see base_of().
+ */
+class ScratchPool
+{
+public:
+    // A scratch AtomSpace, given back to the pool when it goes
+    class Lease
+    {
+    public:
+        Lease(Lease&&);
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        AtomSpace* get(void) const { return m_as; }
+        AtomSpace* operator->(void) const { return m_as; }
+
+    private:
+        friend class ScratchPool;
+        Lease(ScratchPool* pool, AtomSpace* as) : m_pool(pool), m_as(as) {}
+
+        ScratchPool* m_pool;
+        AtomSpace* m_as;
+    };
+
+    ~ScratchPool();
+
+    static ScratchPool& instance(AtomSpace* as);
+    static void release(AtomSpace* as);
+
+    // The AtomSpace that a scratch AtomSpace is over, all the way down,
+    // or the given one if it isn't a scratch AtomSpace
+    static AtomSpace* base_of(AtomSpace* as);
+
+    Lease acquire(void);
+
+    // The two halves of a Lease, for when it can't be scoped, as in
+    // the scheme bindings
+    AtomSpace* take(void);
+    void give_back(AtomSpace* scratch);
+
+    // The no. of cleared scratch AtomSpaces kept for reuse
+    void set_capacity(size_t n);
+
+    size_t num_idle(void);
+    size_t num_leased(void);
+
+private:
+    ScratchPool(AtomSpace* as);
+
+    static void drop(AtomSpace* scratch);
+
+    AtomSpace* m_as;
+
+    std::mutex m_mtx;
+    std::vector<std::unique_ptr<AtomSpace>> m_idle;
+    size_t m_leased;
+    size_t m_capacity;
+};
+
+}
+}
+
+#endif // _OPENCOG_NLP_SCRATCH_POOL_H
@@ -0,0 +1,142 @@
+/*
+ * ScratchSCM.cc
+ *
+ * Scheme bindings of the scratch AtomSpace pool.
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include <vector>
+
+#include <opencog/guile/SchemePrimitive.h>
+#include <opencog/guile/SchemeSmob.h>
+
+#include "ScratchPool.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+namespace opencog
+{
+namespace nlp
+{
+
+class ScratchSCM
+{
+private:
+    static void* init_in_guile(void*);
+    static void init_in_module(void*);
+    void init(void);
+
+    void enter(void);
+    void leave(void);
+    void set_capacity(int);
+
+    // The AtomSpaces that were current before each scratch one the
+    // thread entered, the innermost last
+    struct Entered
+    {
+        AtomSpace* base;
+        AtomSpace* scratch;
+    };
+    static thread_local std::vector<Entered> t_entered;
+
+public:
+    ScratchSCM(void);
+};
+
+}
+}
+
+thread_local std::vector<ScratchSCM::Entered> ScratchSCM::t_entered;
+
+ScratchSCM::ScratchSCM(void)
+{
+    static bool is_init = false;
+    if (is_init) return;
+    is_init = true;
+    scm_with_guile(init_in_guile, this);
+}
+
+void* ScratchSCM::init_in_guile(void* self)
+{
+    scm_c_define_module("opencog nlp scratch", init_in_module, self);
+    scm_c_use_module("opencog nlp scratch");
+    return NULL;
+}
+
+void ScratchSCM::init_in_module(void* data)
+{
+    ScratchSCM* self = (ScratchSCM*) data;
+    self->init();
+}
+
+void ScratchSCM::init(void)
+{
+    define_scheme_primitive("nlp-scratch-enter",
+        &ScratchSCM::enter, this, "nlp scratch");
+    define_scheme_primitive("nlp-scratch-leave",
+        &ScratchSCM::leave, this, "nlp scratch");
+    define_scheme_primitive("nlp-scratch-set-capacity",
+        &ScratchSCM::set_capacity, this, "nlp scratch");
+}
+
+/**
+ * Implement the "nlp-scratch-enter" scheme primitive.
+ */
+void ScratchSCM::enter(void)
+{
+    AtomSpace* as = SchemeSmob::ss_get_env_as("nlp-scratch-enter");
+    AtomSpace* scratch = ScratchPool::instance(as).take();
+
+    t_entered.push_back({as, scratch});
+    SchemeSmob::ss_set_env_as(scratch);
+}
+
+/**
+ * Implement the "nlp-scratch-leave" scheme primitive.
+ */
+void ScratchSCM::leave(void)
+{
+    if (t_entered.empty()) return;
+
+    Entered e = t_entered.back();
+    t_entered.pop_back();
+
+    SchemeSmob::ss_set_env_as(e.base);
+    ScratchPool::instance(e.base).give_back(e.scratch);
+}
+
+/**
+ * Implement the "nlp-scratch-set-capacity" scheme primitive.
+ */
+void ScratchSCM::set_capacity(int n)
+{
+    AtomSpace* as = SchemeSmob::ss_get_env_as("nlp-scratch-set-capacity");
+    ScratchPool::instance(as).set_capacity((n > 0) ? n : 0);
+}
+
+extern "C" {
+void opencog_nlp_scratch_init(void);
+};
+
+void opencog_nlp_scratch_init(void)
+{
+    static ScratchSCM scratch;
+}
@@ -0,0 +1,368 @@
+/*
+ * SentenceRetention.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <memory>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/nlp/types/atom_types.h>
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+
+#include "LinguisticIndex.h"
+#include "SentenceRetention.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+
+typedef std::unordered_map<const AtomSpace*, std::unique_ptr<SentenceRetention>> RetentionRegistry;
+
+static std::mutex& registry_mutex()
+{
+    static std::mutex mtx;
+    return mtx;
+}
+
+static RetentionRegistry& registry()
+{
+    static RetentionRegistry retentions;
+    return retentions;
+}
+
+bool SentenceRetention::Policy::enabled(void) const
+{
+    return 0 < max_turns or Clock::duration::zero() < max_age or
+           0 < max_sentences;
+}
+
+/**
+ * Get the retention of the given AtomSpace, making it if needed, with
+ * the policy of the config file.
+ */
+SentenceRetention& SentenceRetention::instance(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+
+    std::unique_ptr<SentenceRetention>& ret = registry()[as];
+    if (ret == nullptr) {
+        ret.reset(new SentenceRetention(as));
+    }
+    return *ret;
+}
+
+SentenceRetention* SentenceRetention::find(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+
+    auto it = registry().find(as);
+    return (it == registry().end()) ? nullptr : it->second.get();
+}
+
+/**
+ * Drop the retention of the given AtomSpace.  This must be called
+ * before the AtomSpace goes away, as it is connected to its signals.
+ */
+void SentenceRetention::release(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+    registry().erase(as);
+}
+
+/**
+ * The policy of the config file, if any, e.g.
+ *
+ *    NLP_RETENTION_MAX_TURNS     = 50
+ *    NLP_RETENTION_MAX_MINUTES   = 30
+ *    NLP_RETENTION_MAX_SENTENCES = 200
+ */
+SentenceRetention::Policy SentenceRetention::config_policy(void)
+{
+    Policy policy;
+    if (config().has("NLP_RETENTION_MAX_TURNS"))
+        policy.max_turns = config().get_int("NLP_RETENTION_MAX_TURNS");
+    if (config().has("NLP_RETENTION_MAX_MINUTES"))
+        policy.max_age = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double, std::ratio<60>>(
+                config().get_double("NLP_RETENTION_MAX_MINUTES")));
+    if (config().has("NLP_RETENTION_MAX_SENTENCES"))
+        policy.max_sentences = config().get_int("NLP_RETENTION_MAX_SENTENCES");
+    return policy;
+}
+
+/**
+ * Evict the stale sentences of the AtomSpace.  Nothing is done unless
+ * it has a retention already, or the config file gives a policy.
+ */
+size_t SentenceRetention::enforce(AtomSpace* as)
+{
+    SentenceRetention* ret = find(as);
+    if (ret == nullptr)
+    {
+        if (not config_policy().enabled()) return 0;
+        ret = &instance(as);
+    }
+    return ret->evict();
+}
+
+SentenceRetention::SentenceRetention(AtomSpace* as) :
+    m_as(as),
+    m_policy(config_policy()),
+    m_turn(0)
+{
+    // connect first, so that nothing added during the scan is missed;
+    // add_sentence() ignores the sentences it has already seen
+    m_add_conn = m_as->atomAddedSignal().connect(
+        [this](const Handle& h) {
+            if (h->get_type() == SENTENCE_NODE) add_sentence(h); });
+    m_remove_conn = m_as->atomRemovedSignal().connect(
+        [this](const AtomPtr& a) {
+            if (a->get_type() == SENTENCE_NODE) remove_sentence(Handle(a)); });
+
+    HandleSeq sents;
+    m_as->get_handles_by_type(std::back_inserter(sents), SENTENCE_NODE);
+
+    for (const Handle& h : sents)
+        add_sentence(h);
+}
+
+SentenceRetention::~SentenceRetention()
+{
+    m_as->atomAddedSignal().disconnect(m_add_conn);
+    m_as->atomRemovedSignal().disconnect(m_remove_conn);
+}
+
+void SentenceRetention::set_policy(const Policy& policy)
+{
+    std::lock_guard<std::mutex> lck(m_mtx);
+    m_policy = policy;
+}
+
+SentenceRetention::Policy SentenceRetention::get_policy(void)
+{
+    std::lock_guard<std::mutex> lck(m_mtx);
+    return m_policy;
+}
+
+size_t SentenceRetention::num_sentences(void)
+{
+    std::lock_guard<std::mutex> lck(m_mtx);
+    return m_uses.size();
+}
+
+/**
+ * A new sentence is a new turn.
+ */
+void SentenceRetention::add_sentence(const Handle& h)
+{
+    std::lock_guard<std::mutex> lck(m_mtx);
+
+    if (m_uses.count(h)) return;
+
+    m_turn++;
+    m_lru.push_back(h);
+    m_uses[h] = {std::prev(m_lru.end()), m_turn, Clock::now()};
+}
+
+void SentenceRetention::remove_sentence(const Handle& h)
+{
+    std::lock_guard<std::mutex> lck(m_mtx);
+
+    auto it = m_uses.find(h);
+    if (it == m_uses.end()) return;
+
+    m_lru.erase(it->second.pos);
+    m_uses.erase(it);
+}
+
+/**
+ * Mark a sentence as used, so that it is kept for longer.
+ *
+ * @param h  The SentenceNode, or one of its ParseNodes,
+ *           WordInstanceNodes or InterpretationNodes
+ * @return   False if the sentence isn't known
+ */
+bool SentenceRetention::touch(const Handle& h)
+{
+    const LinguisticIndex& index = LinguisticIndex::instance(m_as);
+
+    Type t = h->get_type();
+    Handle sent;
+    if (t == SENTENCE_NODE)
+        sent = h;
+    else if (t == PARSE_NODE)
+        sent = index.get_sentence(h);
+    else if (t == WORD_INSTANCE_NODE)
+        sent = index.get_sentence(index.get_parse(h));
+    else if (t == INTERPRETATION_NODE)
+        sent = index.get_sentence(index.get_interp_parse(h));
+    if (not sent) return false;
+
+    std::lock_guard<std::mutex> lck(m_mtx);
+
+    auto it = m_uses.find(sent);
+    if (it == m_uses.end()) return false;
+
+    m_lru.splice(m_lru.end(), m_lru, it->second.pos);
+    it->second.turn = m_turn;
+    it->second.time = Clock::now();
+    return true;
+}
+
+/**
+ * A sentence is in use if any of its interpretations is in a link
+ * other than the ones that R2L made for it.
+ */
+bool SentenceRetention::is_pinned(const Handle& sent) const
+{
+    const LinguisticIndex& index = LinguisticIndex::instance(m_as);
+
+    for (const Handle& parse : index.get_parses(sent))
+    {
+        for (const Handle& interp : index.get_interpretations(parse))
+        {
+            for (const Handle& l : interp->getIncomingSet())
+            {
+                Type t = l->get_type();
+                if (t == INTERPRETATION_LINK) continue;
+                if (t == REFERENCE_LINK and l->get_arity() == 2 and
+                    l->getOutgoingAtom(1)->get_type() == SET_LINK)
+                    continue;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Remove the sentence and everything that hangs off it.  Extracting a
+ * word instance recursively takes most of its links with it; the LG
+ * link instances between the words, and the NumberNodes of the word
+ * and sentence sequences, are left behind by that, so they are removed
+ * here first.
+ */
+void SentenceRetention::remove_atoms(const Handle& sent)
+{
+    const LinguisticIndex& index = LinguisticIndex::instance(m_as);
+
+    // a NumberNode goes only if nothing else uses it
+    auto remove_sequence = [&](const Handle& h, Type t)
+    {
+        for (const Handle& l : h->getIncomingSetByType(t))
+        {
+            Handle num(l->getOutgoingAtom(1));
+            m_as->extract_atom(l);
+            m_as->extract_atom(num);
+        }
+    };
+
+    for (const Handle& parse : index.get_parses(sent))
+    {
+        for (const Handle& interp : index.get_interpretations(parse))
+        {
+            Handle setlk(index.get_setlink(interp));
+            m_as->extract_atom(interp, true);
+            if (setlk) m_as->extract_atom(setlk, true);
+        }
+
+        for (const Handle& winst : index.get_word_instances(parse))
+        {
+            HandleSeq linsts;
+            for (const Handle& ll : winst->getIncomingSetByType(LIST_LINK))
+                for (const Handle& ev : ll->getIncomingSetByType(EVALUATION_LINK))
+                    if (ev->getOutgoingAtom(0)->get_type() == LG_LINK_INSTANCE_NODE)
+                        linsts.push_back(ev->getOutgoingAtom(0));
+
+            for (const Handle& li : linsts)
+                m_as->extract_atom(li, true);
+
+            remove_sequence(winst, WORD_SEQUENCE_LINK);
+            m_as->extract_atom(winst, true);
+        }
+
+        m_as->extract_atom(parse, true);
+    }
+
+    remove_sequence(sent, SENTENCE_SEQUENCE_LINK);
+    m_as->extract_atom(sent, true);
+}
+
+/**
+ * Remove one sentence now, whatever the policy.
+ *
+ * @return  False if it is in use, and so was kept
+ */
+bool SentenceRetention::evict(const Handle& sent)
+{
+    {
+        std::lock_guard<std::mutex> lck(m_mtx);
+        if (is_pinned(sent)) return false;
+    }
+    remove_atoms(sent);
+    return true;
+}
+
+/**
+ * Remove all the stale sentences.  They are picked with the lock held,
+ * and removed after it is let go, as removing them calls back into
+ * remove_sentence().
+ *
+ * @return  The no. of sentences removed
+ */
+size_t SentenceRetention::evict(void)
+{
+    HandleSeq victims;
+    {
+        std::lock_guard<std::mutex> lck(m_mtx);
+        if (not m_policy.enabled()) return 0;
+
+        Clock::time_point now = Clock::now();
+        size_t left = m_lru.size();
+
+        // The LRU list is in the order of use, so the first sentence
+        // that is fresh enough ends the search
+        for (const Handle& sent : m_lru)
+        {
+            const Use& use = m_uses[sent];
+            bool stale =
+                (0 < m_policy.max_turns and
+                 m_policy.max_turns <= m_turn - use.turn) or
+                (Clock::duration::zero() < m_policy.max_age and
+                 m_policy.max_age < now - use.time) or
+                (0 < m_policy.max_sentences and m_policy.max_sentences < left);
+            if (not stale) break;
+
+            if (is_pinned(sent)) continue;
+
+            victims.push_back(sent);
+            left--;
+        }
+    }
+
+    for (const Handle& sent : victims)
+        remove_atoms(sent);
+
+    if (not victims.empty())
+        logger().debug("[SentenceRetention] Evicted %zu sentences, %zu left",
+                       victims.size(), num_sentences());
+
+    return victims.size();
+}
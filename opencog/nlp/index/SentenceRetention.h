@@ -0,0 +1,138 @@
+/*
+ * SentenceRetention.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_NLP_SENTENCE_RETENTION_H
+#define _OPENCOG_NLP_SENTENCE_RETENTION_H
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+class AtomSpace;
+
+namespace nlp
+{
+
+/**
+ * Removes old sentences from the AtomSpace, so that a long running
+ * chat does not pile up parses forever.  Each sentence is removed as
+ * a whole, much as delete-sentence in nlp-utils.scm does it: its
+ * parses, their word instances, with their LemmaLinks, ReferenceLinks,
+ * sense links and the like, the LG link instances between them, and
+ * their interpretations.
+ *
+ * A sentence is stale when it hasn't been used for more than the given
+ * number of turns, i.e. of sentences added after it, or for more than
+ * the given time; when there are more than the given number of
+ * sentences, the ones used longest ago go as well.  A sentence is used
+ * when it is added, and whenever touch() is called on it or on one of
+ * its parts.  Each of the limits is off when it is zero.
+ *
+ * A sentence with an interpretation that is still in use, i.e. that is
+ * in any link other than its InterpretationLink and the ReferenceLink
+ * to its R2L SetLink, is kept.
+ *
+ * The indexes that follow the AtomSpace signals, such as LinguisticIndex,
+ * SuRealIndex and DocFrequency, update themselves as the atoms go.
+ *
+ * There is one per AtomSpace, reached via instance(); nothing is
+ * removed until evict() is called.  LgParseLink calls enforce() after
+ * each sentence it adds.
+ */
+class SentenceRetention
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Policy
+    {
+        size_t max_turns = 0;
+        Clock::duration max_age = Clock::duration::zero();
+        size_t max_sentences = 0;
+
+        bool enabled(void) const;
+    };
+
+    ~SentenceRetention();
+
+    static SentenceRetention& instance(AtomSpace* as);
+    static SentenceRetention* find(AtomSpace* as);
+    static void release(AtomSpace* as);
+
+    // Evict from the AtomSpace, if it has a policy, or the config file
+    // gives one
+    static size_t enforce(AtomSpace* as);
+
+    void set_policy(const Policy&);
+    Policy get_policy(void);
+
+    // Mark the sentence of a SentenceNode, ParseNode, WordInstanceNode
+    // or InterpretationNode as used
+    bool touch(const Handle& h);
+
+    // Remove the stale sentences; returns how many were removed
+    size_t evict(void);
+
+    // Remove one sentence, unless it is in use
+    bool evict(const Handle& sentence);
+
+    size_t num_sentences(void);
+
+private:
+    SentenceRetention(AtomSpace* as);
+
+    static Policy config_policy(void);
+
+    void add_sentence(const Handle& h);
+    void remove_sentence(const Handle& h);
+
+    bool is_pinned(const Handle& sentence) const;
+    void remove_atoms(const Handle& sentence);
+
+    AtomSpace* m_as;
+    int m_add_conn;
+    int m_remove_conn;
+
+    std::mutex m_mtx;
+    Policy m_policy;
+    uint64_t m_turn;
+
+    // The sentences, used longest ago first
+    struct Use
+    {
+        std::list<Handle>::iterator pos;
+        uint64_t turn;
+        Clock::time_point time;
+    };
+    std::list<Handle> m_lru;
+    std::unordered_map<Handle, Use> m_uses;
+};
+
+}
+}
+
+#endif // _OPENCOG_NLP_SENTENCE_RETENTION_H
@@ -0,0 +1,60 @@
+;
+; retention.scm
+;
+; Removal of old sentences from the atomspace.
+;
+; (use-modules (opencog nlp retention))
+; (nlp-retention-set-policy 50 30 200)
+;
+(define-module (opencog nlp retention))
+
+(use-modules (opencog))
+(use-modules (opencog oc-config))
+
+(load-extension (string-append opencog-ext-path-nlp-index "libnlp-index") "opencog_nlp_retention_init")
+
+(set-procedure-property! nlp-retention-set-policy 'documentation
+"
+  nlp-retention-set-policy TURNS MINUTES SENTENCES -- set when the
+  sentences of the current atomspace are removed. A sentence goes when
+  it hasn't been used for TURNS sentences, or for MINUTES minutes, and
+  the ones used longest ago go when there are more than SENTENCES of
+  them. Zero turns a limit off. A sentence is used when it is parsed,
+  and by nlp-retention-touch.
+
+  Sentences with an InterpretationNode that is still in use, i.e. in
+  any link but its InterpretationLink and the ReferenceLink to its R2L
+  SetLink, are kept.
+
+  The sentences are removed by nlp-retention-evict, and after each
+  LgParseLink. The defaults come from the NLP_RETENTION_MAX_TURNS,
+  NLP_RETENTION_MAX_MINUTES and NLP_RETENTION_MAX_SENTENCES keys of
+  the config file.
+")
+
+(set-procedure-property! nlp-retention-evict 'documentation
+"
+  nlp-retention-evict -- remove the sentences that are stale by the
+  policy, with their parses, word instances and interpretations, and
+  return how many were removed.
+")
+
+(set-procedure-property! nlp-retention-evict-sentence 'documentation
+"
+  nlp-retention-evict-sentence SENT -- remove the SentenceNode SENT as
+  nlp-retention-evict would, whatever the policy. Returns #f if it is
+  in use, and so was kept.
+")
+
+(set-procedure-property! nlp-retention-touch 'documentation
+"
+  nlp-retention-touch ATOM -- mark the sentence of ATOM as used, so
+  that it is kept for longer. ATOM is a SentenceNode, or one of its
+  ParseNodes, WordInstanceNodes or InterpretationNodes. Returns #f if
+  it isn't the sentence of anything.
+")
+
+(set-procedure-property! nlp-retention-count 'documentation
+"
+  nlp-retention-count -- the number of sentences in the atomspace.
+")
@@ -0,0 +1,60 @@
+;
+; scratch.scm
+;
+; Scratch atomspaces, for the atoms that only live for one query.
+;
+; (use-modules (opencog nlp scratch))
+; (nlp-with-scratch (lambda () (nlp-fuzzy-match ...)))
+;
+(define-module (opencog nlp scratch))
+
+(use-modules (opencog))
+(use-modules (opencog oc-config))
+
+(load-extension (string-append opencog-ext-path-nlp-index "libnlp-index") "opencog_nlp_scratch_init")
+
+(set-procedure-property! nlp-scratch-enter 'documentation
+"
+  nlp-scratch-enter -- make an empty scratch atomspace over the current
+  one the current atomspace, until nlp-scratch-leave. Everything in the
+  atomspace under it can be seen from it; the atoms made in it don't
+  touch the indexes of that one, nor fire its signals. SuReal and the
+  fuzzy matcher still search the atomspace under it.
+")
+
+(set-procedure-property! nlp-scratch-leave 'documentation
+"
+  nlp-scratch-leave -- go back to the atomspace that was current at the
+  last nlp-scratch-enter, and throw away the atoms made in the scratch
+  atomspace since.
+")
+
+(set-procedure-property! nlp-scratch-set-capacity 'documentation
+"
+  nlp-scratch-set-capacity N -- keep up to N cleared scratch atomspaces
+  over the current atomspace for reuse, rather than making new ones.
+  The default is the NLP_SCRATCH_POOL_SIZE key of the config file, or
+  else 8.
+")
+
+(define-public (nlp-with-scratch THUNK)
+"
+  nlp-with-scratch THUNK -- call THUNK with a scratch atomspace as the
+  current one, and throw away the atoms it made there when it returns
+  or throws. For example, to look for sentences like SENT without
+  leaving the results of the match behind:
+
+     (nlp-with-scratch (lambda ()
+        (map (lambda (ref) (cog-outgoing-atom ref 0))
+           (cog-outgoing-set (nlp-fuzzy-match
+              (get-r2l-set-of-sent SENT) 'SetLink '() #f)))))
+
+  What THUNK returns must not hold on to the atoms made in the scratch
+  atomspace, as they are gone by then, such as the NumberNodes of the
+  scores above; atoms of the atomspace under it, such as the SetLinks
+  found, are fine.
+"
+	(dynamic-wind
+		nlp-scratch-enter
+		THUNK
+		nlp-scratch-leave))
@@ -0,0 +1,161 @@
+/*
+ *   Latency statistics for the La Cogita IRC chatbot
+ *   Copyright (C) 2026 OpenCog Foundation
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include <algorithm>
+
+#include "ChatStats.h"
+
+using namespace opencog::chatbot;
+
+static const char* stage_names[] =
+	{"queued", "first-line", "reply", "sending", "total"};
+
+static const char* counter_names[] =
+	{"requests", "rejected", "slow", "lines", "bytes"};
+
+void ChatStats::Histogram::add(double seconds)
+{
+	double ms = 1000.0 * seconds;
+	int b = (ms < 1.0) ? 0 : 1 + (int) log2(ms);
+	buckets[std::min(b, num_buckets - 1)]++;
+	count++;
+	sum += seconds;
+	max = std::max(max, seconds);
+}
+
+/**
+ * The upper end of the bucket holding the given fraction of the
+ * requests; never more than the longest one.
+ */
+double ChatStats::Histogram::percentile(double p) const
+{
+	size_t want = (size_t) ceil(p * count);
+	size_t seen = 0;
+	for (int b = 0; b < num_buckets; b++)
+	{
+		seen += buckets[b];
+		if (want <= seen)
+			return std::min(max, ldexp(1.0, b) / 1000.0);
+	}
+	return max;
+}
+
+ChatStats::ChatStats(double slow) :
+	_slow(slow),
+	_stop(false)
+{
+}
+
+ChatStats::~ChatStats()
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_stop = true;
+	}
+	_cv.notify_all();
+	if (_printer.joinable())
+		_printer.join();
+}
+
+void ChatStats::count(Counter c, size_t n)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_counters[c] += n;
+}
+
+void ChatStats::record(const RequestTiming& t)
+{
+	typedef std::chrono::duration<double> Seconds;
+	Seconds queued = t.started - t.received;
+	Seconds total = t.sent - t.received;
+
+	// Without a reply, it is all waiting for the cogserver.
+	Seconds first = (t.replied ? t.first_line : t.last_line) - t.started;
+	Seconds reply = t.replied ? t.last_line - t.first_line : Seconds(0);
+	Seconds sending = t.sent - t.last_line;
+
+	bool slow = 0.0 < _slow and _slow < total.count();
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_stages[QUEUED].add(queued.count());
+		_stages[FIRST_LINE].add(first.count());
+		_stages[REPLY].add(reply.count());
+		_stages[SENDING].add(sending.count());
+		_stages[TOTAL].add(total.count());
+		if (slow) _counters[SLOW]++;
+	}
+
+	if (slow)
+		fprintf(stderr, "Slow request: %.3fs (queued %.3fs, first-line "
+		        "%.3fs, reply %.3fs, sending %.3fs) from %s: %s\n",
+		        total.count(), queued.count(), first.count(),
+		        reply.count(), sending.count(), t.who.c_str(),
+		        t.query.c_str());
+}
+
+std::vector<std::string> ChatStats::report()
+{
+	std::vector<std::string> lines;
+	char buff[256];
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	std::string counts;
+	for (int c = 0; c < NUM_COUNTERS; c++)
+	{
+		snprintf(buff, sizeof(buff), "%s%s=%zu", c ? " " : "",
+		         counter_names[c], _counters[c]);
+		counts += buff;
+	}
+	lines.push_back(counts);
+
+	for (int s = 0; s < NUM_STAGES; s++)
+	{
+		const Histogram& h = _stages[s];
+		double mean = h.count ? h.sum / h.count : 0.0;
+		snprintf(buff, sizeof(buff), "%s: n=%zu mean=%.3fs p50=%.3fs "
+		         "p90=%.3fs p99=%.3fs max=%.3fs", stage_names[s], h.count,
+		         mean, h.percentile(0.5), h.percentile(0.9),
+		         h.percentile(0.99), h.max);
+		lines.push_back(buff);
+	}
+	return lines;
+}
+
+void ChatStats::print_every(int seconds)
+{
+	if (0 < seconds and not _printer.joinable())
+		_printer = std::thread(&ChatStats::print_loop, this, seconds);
+}
+
+void ChatStats::print_loop(int seconds)
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (not _cv.wait_for(lck, std::chrono::seconds(seconds),
+	                        [this] { return _stop; }))
+	{
+		lck.unlock();
+		for (const std::string& line : report())
+			printf("stats %s\n", line.c_str());
+		fflush(stdout);
+		lck.lock();
+	}
+}
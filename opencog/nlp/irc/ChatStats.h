@@ -0,0 +1,128 @@
+/*
+ *   Latency statistics for the La Cogita IRC chatbot
+ *   Copyright (C) 2026 OpenCog Foundation
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _OPENCOG_CHAT_STATS_H
+#define _OPENCOG_CHAT_STATS_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opencog {
+namespace chatbot {
+
+/**
+ * When each step of answering one chat request happened: from the
+ * message coming in from IRC, through the request to the cogserver and
+ * its reply, to the last line of the reply being sent to IRC.
+ */
+struct RequestTiming
+{
+	typedef std::chrono::steady_clock Clock;
+
+	std::string who;          // the target and the nick
+	std::string query;        // what was said
+	Clock::time_point received;  // by got_privmsg
+	Clock::time_point started;   // the request to the cogserver
+	Clock::time_point first_line; // of the reply
+	Clock::time_point last_line;  // of the reply
+	Clock::time_point sent;      // the last line, to IRC
+	bool replied = false;     // there was a first line
+};
+
+/**
+ * Histograms of how long each step of the chat requests took, and a
+ * few counters, to tell whether slowness comes from the queue of
+ * requests, the cogserver, the sockets, or the flood control. The
+ * histograms have a bucket for each power of two milliseconds.
+ *
+ * The requests taking longer than the slow threshold are logged, with
+ * what was asked.
+ */
+class ChatStats
+{
+public:
+	enum Stage
+	{
+		QUEUED,      // received, until the request is sent
+		FIRST_LINE,  // sent, until the first line of the reply
+		REPLY,       // the first line of the reply, until the last
+		SENDING,     // the last line of the reply, until it is sent
+		TOTAL,       // received, until the reply is sent
+		NUM_STAGES
+	};
+
+	enum Counter
+	{
+		REQUESTS,    // taken in
+		REJECTED,    // with too many waiting for the same user
+		SLOW,        // slower than the slow threshold
+		LINES,       // of replies, queued for IRC
+		BYTES,       // of replies, queued for IRC
+		NUM_COUNTERS
+	};
+
+	/// @param slow  seconds, over which a request is logged; 0 for none
+	ChatStats(double slow);
+	~ChatStats();
+
+	void count(Counter, size_t n = 1);
+
+	/// Record the times of a request that is done.
+	void record(const RequestTiming&);
+
+	/// A few lines, a stage or counter a line.
+	std::vector<std::string> report();
+
+	/// Print the report every so many seconds, until destroyed.
+	void print_every(int seconds);
+
+private:
+	static const int num_buckets = 24;
+
+	struct Histogram
+	{
+		size_t buckets[num_buckets] = {};
+		size_t count = 0;
+		double sum = 0.0;
+		double max = 0.0;
+
+		void add(double seconds);
+		double percentile(double) const;
+	};
+
+	void print_loop(int seconds);
+
+	double _slow;
+
+	std::mutex _mtx;
+	Histogram _stages[NUM_STAGES];
+	size_t _counters[NUM_COUNTERS] = {};
+
+	std::condition_variable _cv;
+	bool _stop;
+	std::thread _printer;
+};
+
+}} // ~namespace opencog::chatbot
+
+#endif // _OPENCOG_CHAT_STATS_H
@@ -0,0 +1,113 @@
+/*
+ *   Worker threads for the La Cogita IRC chatbot
+ *   Copyright (C) 2026 OpenCog Foundation
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <stdio.h>
+
+#include <exception>
+
+#include "ChatWorkers.h"
+
+using namespace opencog::chatbot;
+
+ChatWorkers::ChatWorkers(size_t num_threads) :
+	_stop(false),
+	_num_jobs(0)
+{
+	if (0 == num_threads) num_threads = 1;
+	for (size_t i = 0; i < num_threads; i++)
+		_threads.emplace_back(&ChatWorkers::work, this);
+}
+
+/**
+ * The jobs not started yet are dropped; the running ones are finished.
+ */
+ChatWorkers::~ChatWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_stop = true;
+	}
+	_cv.notify_all();
+	for (std::thread& t : _threads)
+		t.join();
+}
+
+bool ChatWorkers::submit(const std::string& key, Job job)
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		std::deque<Job>& jobs = _jobs[key];
+		if (max_pending <= jobs.size())
+			return false;
+
+		// If it has jobs already, it is either running one of them,
+		// or in the ready queue.
+		if (jobs.empty())
+			_ready.push_back(key);
+		jobs.push_back(std::move(job));
+		_num_jobs++;
+	}
+	_cv.notify_one();
+	return true;
+}
+
+size_t ChatWorkers::pending()
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _num_jobs;
+}
+
+void ChatWorkers::work()
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (true)
+	{
+		_cv.wait(lck, [this] { return _stop or not _ready.empty(); });
+		if (_stop) return;
+
+		std::string key(std::move(_ready.front()));
+		_ready.pop_front();
+		auto it = _jobs.find(key);
+		Job job(it->second.front());
+
+		lck.unlock();
+		try
+		{
+			job();
+		}
+		catch (const std::exception& ex)
+		{
+			fprintf(stderr, "Error: chat request failed: %s\n", ex.what());
+		}
+		lck.lock();
+
+		// The conversation goes back in the queue with its next job,
+		// behind the other conversations waiting.
+		it = _jobs.find(key);
+		it->second.pop_front();
+		_num_jobs--;
+		if (it->second.empty())
+			_jobs.erase(it);
+		else
+		{
+			_ready.push_back(key);
+			_cv.notify_one();
+		}
+	}
+}
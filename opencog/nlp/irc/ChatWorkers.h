@@ -0,0 +1,83 @@
+/*
+ *   Worker threads for the La Cogita IRC chatbot
+ *   Copyright (C) 2026 OpenCog Foundation
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _OPENCOG_CHAT_WORKERS_H
+#define _OPENCOG_CHAT_WORKERS_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opencog {
+namespace chatbot {
+
+/**
+ * Runs the chat requests on a few threads, so that the IRC socket is
+ * read, and other users are answered, while the cogserver is busy with
+ * one request.
+ *
+ * The requests of one conversation, i.e. with the same key, such as
+ * the channel and the nick, are run one at a time, in the order they
+ * were submitted; those of different conversations run concurrently,
+ * as many at a time as there are threads.
+ */
+class ChatWorkers
+{
+public:
+	typedef std::function<void()> Job;
+
+	ChatWorkers(size_t num_threads);
+	~ChatWorkers();
+
+	/**
+	 * Run the job after the jobs already submitted with the same key.
+	 * The job is dropped, and false is returned, if that conversation
+	 * already has max_pending jobs waiting.
+	 */
+	bool submit(const std::string& key, Job job);
+
+	/// The no. of jobs waiting or running.
+	size_t pending();
+
+	static const size_t max_pending = 8;
+
+private:
+	void work();
+
+	std::mutex _mtx;
+	std::condition_variable _cv;
+	bool _stop;
+
+	// The jobs of each conversation with any, the first being the one
+	// running, if the conversation is not in the ready queue.
+	std::map<std::string, std::deque<Job>> _jobs;
+	std::deque<std::string> _ready;
+	size_t _num_jobs;
+
+	std::vector<std::thread> _threads;
+};
+
+}} // ~namespace opencog::chatbot
+
+#endif // _OPENCOG_CHAT_WORKERS_H
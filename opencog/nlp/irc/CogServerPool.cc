@@ -0,0 +1,327 @@
+/*
+ *   Pooled connections to the cogserver, for the La Cogita IRC chatbot
+ *   Copyright (C) 2026 OpenCog Foundation
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "CogServerPool.h"
+
+using namespace opencog::chatbot;
+
+#define CRASHED_MSG "La Cogita has crashed. Try again later.\n"
+#define BUSY_MSG "La Cogita is busy thinking about something else. " \
+                 "Try again later.\n"
+
+CogServerPool::CogServerPool(const std::string& addr, int port,
+                             size_t max_idle, int connect_timeout,
+                             int read_timeout, int ping_after) :
+	_max_idle(max_idle),
+	_connect_timeout(connect_timeout),
+	_read_timeout(read_timeout),
+	_ping_after(ping_after),
+	_seq(0)
+{
+	memset(&_addr, 0, sizeof(_addr));
+	_addr.sin_family = AF_INET;
+	_addr.sin_addr.s_addr = inet_addr(addr.c_str());
+	_addr.sin_port = htons(port);
+}
+
+CogServerPool::~CogServerPool()
+{
+	clear();
+}
+
+void CogServerPool::clear()
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	for (const Session& s : _idle)
+		close(s.fd);
+	_idle.clear();
+}
+
+/**
+ * Connect to the cogserver, waiting no longer than the connect
+ * timeout. Returns the socket, or -1.
+ */
+int CogServerPool::connect_socket()
+{
+	int sock = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (0 > sock)
+	{
+		fprintf(stderr, "Error: can't create socket: %s\n", strerror(errno));
+		return -1;
+	}
+
+	int flags = fcntl(sock, F_GETFL, 0);
+	fcntl(sock, F_SETFL, flags | O_NONBLOCK);
+
+	int rc = connect(sock, (struct sockaddr *) &_addr, sizeof(_addr));
+	if (0 > rc and EINPROGRESS == errno)
+	{
+		struct pollfd pfd = {sock, POLLOUT, 0};
+		rc = poll(&pfd, 1, 1000 * _connect_timeout);
+		int err = 0;
+		socklen_t len = sizeof(err);
+		if (1 == rc)
+			getsockopt(sock, SOL_SOCKET, SO_ERROR, &err, &len);
+		rc = (1 == rc and 0 == err) ? 0 : -1;
+	}
+	if (0 > rc)
+	{
+		fprintf(stderr, "Error: can't connect to server\n");
+		close(sock);
+		return -1;
+	}
+
+	fcntl(sock, F_SETFL, flags);
+	return sock;
+}
+
+std::string CogServerPool::next_sentinel()
+{
+	return ";;whirr-end-" + std::to_string(++_seq) + ";;";
+}
+
+// The scheme code making the shell print the sentinel
+static std::string print_sentinel(const std::string& sentinel)
+{
+	return "(display \"" + sentinel + "\\n\")\n";
+}
+
+bool CogServerPool::send_all(int fd, const std::string& msg)
+{
+	size_t sent = 0;
+	while (sent < msg.size())
+	{
+		ssize_t n = send(fd, msg.data() + sent, msg.size() - sent,
+		                 MSG_NOSIGNAL);
+		if (0 > n and EINTR == errno) continue;
+		if (0 >= n)
+		{
+			fprintf(stderr, "Error: not everything was sent, len=%zu "
+			        "sent len=%zu\n", msg.size(), sent);
+			return false;
+		}
+		sent += n;
+	}
+	return true;
+}
+
+/**
+ * Read into out until the sentinel, which is left out, waiting no
+ * more than the timeout (in seconds, 0 for none) each time for more.
+ * Returns 1 if the sentinel was found, 0 if the server closed the
+ * connection or failed, and -1 on a timeout.
+ */
+int CogServerPool::read_until(int fd, const std::string& sentinel,
+                              int timeout, std::string& out)
+{
+	return read_lines(fd, sentinel, timeout,
+		[&out](const char* line, size_t len) { out.append(line, len); });
+}
+
+/**
+ * Like read_until, but giving each line to the handler as soon as it
+ * is complete. Only the start of the last line is ever kept, so this
+ * takes time linear in the length of the reply.
+ */
+int CogServerPool::read_lines(int fd, const std::string& sentinel_text,
+                              int timeout, const LineHandler& on_line)
+{
+	// With its newline, so that nothing is left to read after it.
+	// What the reply printed last, without a newline, comes before it.
+	std::string sentinel(sentinel_text + "\n");
+	std::string pending;
+	char buff[4096];
+	while (true)
+	{
+		if (0 < timeout)
+		{
+			struct pollfd pfd = {fd, POLLIN, 0};
+			int rc = poll(&pfd, 1, 1000 * timeout);
+			if (0 > rc and EINTR == errno) continue;
+			if (0 == rc) return -1;
+			if (0 > rc) return 0;
+		}
+
+		ssize_t rlen = recv(fd, buff, sizeof(buff), 0);
+		if (0 > rlen and EINTR == errno) continue;
+		if (0 > rlen)
+		{
+			fprintf(stderr, "Error: bad read errno=%d %s\n",
+			        errno, strerror(errno));
+			return 0;
+		}
+		if (0 == rlen) return 0;
+
+		// Only what came in can end a line.
+		size_t start = 0;
+		size_t from = pending.size();
+		pending.append(buff, rlen);
+		size_t nl;
+		while (std::string::npos != (nl = pending.find('\n', from)))
+		{
+			size_t end = nl + 1;
+			if (sentinel.size() <= end - start and 0 == pending.compare(
+			    end - sentinel.size(), sentinel.size(), sentinel))
+			{
+				size_t len = end - sentinel.size() - start;
+				if (0 < len) on_line(pending.data() + start, len);
+				return 1;
+			}
+			on_line(pending.data() + start, end - start);
+			start = from = end;
+		}
+		pending.erase(0, start);
+	}
+}
+
+/**
+ * Open a session, and get the shell into the scheme shell, without
+ * prompts. Whatever the server says before then is dropped.
+ */
+bool CogServerPool::open_session(Session& s)
+{
+	s.fd = connect_socket();
+	if (0 > s.fd) return false;
+
+	std::string sentinel(next_sentinel());
+	std::string junk;
+	if (not send_all(s.fd, "scm hush\n" + print_sentinel(sentinel)) or
+	    1 != read_until(s.fd, sentinel, _connect_timeout, junk))
+	{
+		close(s.fd);
+		s.fd = -1;
+		return false;
+	}
+	s.last_used = Clock::now();
+	return true;
+}
+
+/**
+ * An idle session should have nothing to read; if it does, the server
+ * either closed it, or sent something out of turn, and it is not known
+ * where the next reply would start.
+ */
+bool CogServerPool::is_idle_clean(const Session& s)
+{
+	struct pollfd pfd = {s.fd, POLLIN, 0};
+	return 0 == poll(&pfd, 1, 0);
+}
+
+/**
+ * Take an idle session, checking it first, or else open a new one.
+ */
+bool CogServerPool::borrow(Session& s)
+{
+	while (true)
+	{
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			if (_idle.empty()) break;
+			s = _idle.back();
+			_idle.pop_back();
+		}
+
+		if (not is_idle_clean(s))
+		{
+			close(s.fd);
+			continue;
+		}
+
+		// Ping the sessions idle for long, e.g. across a restart of
+		// the cogserver, or a firewall timing out the connection.
+		std::chrono::duration<double> idle = Clock::now() - s.last_used;
+		if (_ping_after <= idle.count())
+		{
+			std::string sentinel(next_sentinel());
+			std::string junk;
+			if (not send_all(s.fd, print_sentinel(sentinel)) or
+			    1 != read_until(s.fd, sentinel, _connect_timeout, junk))
+			{
+				close(s.fd);
+				continue;
+			}
+		}
+		return true;
+	}
+
+	return open_session(s);
+}
+
+void CogServerPool::give_back(Session& s)
+{
+	s.last_used = Clock::now();
+	std::lock_guard<std::mutex> lck(_mtx);
+	if (_idle.size() < _max_idle)
+		_idle.push_back(s);
+	else
+		close(s.fd);
+}
+
+bool CogServerPool::request(const std::string& scm, std::string& reply)
+{
+	reply.clear();
+	return request(scm,
+		[&reply](const char* line, size_t len) { reply.append(line, len); });
+}
+
+bool CogServerPool::request(const std::string& scm,
+                            const LineHandler& on_line)
+{
+	Session s;
+	if (not borrow(s))
+	{
+		on_line(CRASHED_MSG, strlen(CRASHED_MSG));
+		return false;
+	}
+
+	std::string msg(scm);
+	if (msg.empty() or '\n' != msg.back()) msg += '\n';
+	std::string sentinel(next_sentinel());
+	msg += print_sentinel(sentinel);
+
+	if (not send_all(s.fd, msg))
+	{
+		close(s.fd);
+		on_line(CRASHED_MSG, strlen(CRASHED_MSG));
+		return false;
+	}
+
+	int rc = read_lines(s.fd, sentinel, _read_timeout, on_line);
+	if (1 != rc)
+	{
+		// The session is in an unknown state; the rest of the reply
+		// may yet come. Don't give it to anyone else.
+		close(s.fd);
+		const char* msg = (0 > rc) ? BUSY_MSG : CRASHED_MSG;
+		on_line(msg, strlen(msg));
+		return false;
+	}
+
+	give_back(s);
+	return true;
+}
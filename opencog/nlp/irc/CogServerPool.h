@@ -0,0 +1,121 @@
+/*
+ *   Pooled connections to the cogserver, for the La Cogita IRC chatbot
+ *   Copyright (C) 2026 OpenCog Foundation
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _OPENCOG_COGSERVER_POOL_H
+#define _OPENCOG_COGSERVER_POOL_H
+
+#include <netinet/in.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace opencog {
+namespace chatbot {
+
+/**
+ * A pool of scheme shell sessions on the cogserver, kept open from one
+ * request to the next, so that a chat line doesn't pay for a TCP
+ * connect and teardown, and for the shell to start up.
+ *
+ * Each session is put into the scheme shell, with "scm hush", when it
+ * is opened. The end of the reply to each request is marked by having
+ * the shell print a sentinel after it, since the connection is not
+ * closed any more. A session that times out, or that sends anything
+ * while it is idle, is closed rather than put back; one that has been
+ * idle for long is pinged before it is used.
+ */
+class CogServerPool
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	/// Given each line of a reply as it comes in, with its newline,
+	/// except for the last line, if the reply doesn't end with one.
+	typedef std::function<void(const char* line, size_t len)> LineHandler;
+
+	/**
+	 * @param addr             the IP address of the cogserver
+	 * @param port             the port of its shell
+	 * @param max_idle         the no. of idle sessions to keep open
+	 * @param connect_timeout  seconds to wait for a connection
+	 * @param read_timeout     seconds to wait for more of a reply;
+	 *                         0 to wait for as long as it takes
+	 * @param ping_after       seconds of idleness after which a
+	 *                         session is checked before it is used
+	 */
+	CogServerPool(const std::string& addr, int port, size_t max_idle,
+	              int connect_timeout, int read_timeout, int ping_after);
+	~CogServerPool();
+
+	/**
+	 * Evaluate the scheme code in a session, and put what it printed
+	 * in the reply. On failure, false is returned, and the reply says
+	 * what to tell the chat user.
+	 */
+	bool request(const std::string& scm, std::string& reply);
+
+	/**
+	 * Evaluate the scheme code in a session, giving each line of what
+	 * it prints to the handler, as soon as the line is complete. On
+	 * failure, the handler is given a last line saying what to tell
+	 * the chat user, and false is returned.
+	 */
+	bool request(const std::string& scm, const LineHandler& on_line);
+
+	/// Close all the idle sessions.
+	void clear();
+
+private:
+	struct Session
+	{
+		int fd;
+		Clock::time_point last_used;
+	};
+
+	bool borrow(Session&);
+	void give_back(Session&);
+
+	int connect_socket();
+	bool open_session(Session&);
+	bool is_idle_clean(const Session&);
+	bool send_all(int fd, const std::string&);
+	int read_until(int fd, const std::string& sentinel, int timeout,
+	               std::string& out);
+	int read_lines(int fd, const std::string& sentinel, int timeout,
+	               const LineHandler& on_line);
+	std::string next_sentinel();
+
+	struct sockaddr_in _addr;
+	size_t _max_idle;
+	int _connect_timeout;
+	int _read_timeout;
+	int _ping_after;
+
+	std::mutex _mtx;
+	std::vector<Session> _idle;
+	std::atomic<unsigned long> _seq;
+};
+
+}} // ~namespace opencog::chatbot
+
+#endif // _OPENCOG_COGSERVER_POOL_H
@@ -49,18 +49,39 @@ namespace chatbot {
 
 #define DEFAULT_COG_IP "127.0.0.1"
 #define DEFAULT_COG_PORT 17004
+#define DEFAULT_COG_POOL 4
+#define DEFAULT_COG_CONNECT_TIMEOUT 5
+#define DEFAULT_COG_READ_TIMEOUT 120
+#define DEFAULT_COG_PING_AFTER 60
+#define DEFAULT_MAX_CONCURRENT 4
+#define DEFAULT_FLOOD_RATE 120
+#define DEFAULT_FLOOD_BURST 512
+#define DEFAULT_LINE_LIMIT 400
+#define DEFAULT_SHORT_REPLY 240
+#define DEFAULT_STATS_EVERY 0
+#define DEFAULT_SLOW_REQUEST 10
 
 
 CogitaConfig::CogitaConfig() :
     version_string(VSTRING),
-    ircNetwork(DEFAULT_SERVER),
     ircPort(DEFAULT_PORT),
     irc_nick(DEFAULT_NICK),
     irc_name(DEFAULT_NAME),
     irc_pass(DEFAULT_PASS),
     dry_run(false),
     cog_addr(DEFAULT_COG_IP),
-    cog_port(DEFAULT_COG_PORT)
+    cog_port(DEFAULT_COG_PORT),
+    cog_pool_size(DEFAULT_COG_POOL),
+    cog_connect_timeout(DEFAULT_COG_CONNECT_TIMEOUT),
+    cog_read_timeout(DEFAULT_COG_READ_TIMEOUT),
+    cog_ping_after(DEFAULT_COG_PING_AFTER),
+    max_concurrent(DEFAULT_MAX_CONCURRENT),
+    irc_flood_rate(DEFAULT_FLOOD_RATE),
+    irc_flood_burst(DEFAULT_FLOOD_BURST),
+    irc_line_limit(DEFAULT_LINE_LIMIT),
+    irc_short_reply(DEFAULT_SHORT_REPLY),
+    stats_every(DEFAULT_STATS_EVERY),
+    slow_request(DEFAULT_SLOW_REQUEST)
 {
     const char* defaultAttns[] = DEFAULT_ATTN;
     const char* defaultSuffixes[] = DEFAULT_ATTN_SUFFIXES;
@@ -74,6 +95,7 @@ CogitaConfig::CogitaConfig() :
     for (int i = 0; defaultChannels[i]; i++) {
         ircChannels.push_back(std::string(defaultChannels[i]));
     }
+    ircNetworks.push_back(DEFAULT_SERVER);
 }
 
 const char * CogitaConfig::helpOutput =
@@ -83,11 +105,19 @@ const char * CogitaConfig::helpOutput =
     " -n,--nick      Set bot nick. (default: %s)\n"
     " -f,--name      Set bot full name. (default: %s)\n"
     " -w,--pass      Set bot password. (default: %s)\n"
-    " -s,--server    IRC server to connect to. (default: %s)\n"
-    " -p,--port      Port of IRC server to connect to. (default: %d)\n"
+    " -s,--server    IRC servers to connect to, comma separated, each\n"
+    "                optionally with :port. (default: %s)\n"
+    " -p,--port      Port of IRC servers without one. (default: %d)\n"
     " -c,--channel   Channel (without #) to join (default: %s)\n"
     " -o,--cogserver Cogserver to use (default: %s)\n"
     " -t,--cog-port  Cogserver port number (default: %d)\n"
+    " -P,--cog-pool  Cogserver sessions to keep open, 0 for none (default: %d)\n"
+    " -T,--cog-timeout Seconds to wait for a reply, 0 for ever (default: %d)\n"
+    " -j,--jobs      Chat requests to process at once (default: %d)\n"
+    " -r,--flood-rate  Bytes a second to send to IRC (default: %d)\n"
+    " -b,--flood-burst Bytes to send to IRC at once (default: %d)\n"
+    " -S,--stats-every Seconds between printing latency stats, 0 for never (default: %d)\n"
+    " -L,--slow-log  Seconds, over which requests are logged, 0 for never (default: %g)\n"
     " -d,--dry-run   Print settings and quit.\n"
     " -v,--version   Print version information.\n"
     " \n";
@@ -98,9 +128,14 @@ void CogitaConfig::printHelp()
     if (0 == pass[0]) pass = "(no password)";
 #define BUFSZ 8190
     char buff[BUFSZ];
+    string networks;
+    for (const string& net : ircNetworks)
+        networks += (networks.empty() ? "" : ",") + net;
     snprintf(buff, BUFSZ, helpOutput, irc_nick.c_str(),
-             irc_name.c_str(), pass, ircNetwork.c_str(),
-             ircPort, ircChannels[0].c_str(), cog_addr.c_str(), cog_port);
+             irc_name.c_str(), pass, networks.c_str(),
+             ircPort, ircChannels[0].c_str(), cog_addr.c_str(), cog_port,
+             cog_pool_size, cog_read_timeout, max_concurrent,
+             irc_flood_rate, irc_flood_burst, stats_every, slow_request);
     cout << buff;
 }
 
@@ -109,7 +144,7 @@ void CogitaConfig::printVersion() { cout << VSTRING << endl; }
 int CogitaConfig::parseOptions(int argc, char* argv[])
 {
     int c = 0;
-    static const char *optString = "n:f:w:s:p:c:o:t:dvh";
+    static const char *optString = "n:f:w:s:p:c:o:t:P:T:j:r:b:S:L:dvh";
 
     static const struct option longOptions[] =
     {
@@ -117,10 +152,17 @@ int CogitaConfig::parseOptions(int argc, char* argv[])
         {"name", required_argument, 0, 'f'},
         {"pass", required_argument, 0, 'w'},
         {"server", required_argument, 0, 's'},
-        {"port", required_argument, 0, 's'},
+        {"port", required_argument, 0, 'p'},
         {"channel", required_argument, 0, 'c'},
         {"cogserver", required_argument, 0, 'o'},
         {"cog-port", required_argument, 0, 't'},
+        {"cog-pool", required_argument, 0, 'P'},
+        {"cog-timeout", required_argument, 0, 'T'},
+        {"jobs", required_argument, 0, 'j'},
+        {"flood-rate", required_argument, 0, 'r'},
+        {"flood-burst", required_argument, 0, 'b'},
+        {"stats-every", required_argument, 0, 'S'},
+        {"slow-log", required_argument, 0, 'L'},
         {"dry-run", 0, 0, 'd'},
         {"version", 0, 0, 'v'},
         {"help", 0, 0, '?'},
@@ -149,7 +191,15 @@ int CogitaConfig::parseOptions(int argc, char* argv[])
             irc_pass = string(optarg);
             break;
         case 's':
-            ircNetwork = string(optarg);
+            ircNetworks.clear();
+            channelsTemp = optarg;
+            st.set_string(channelsTemp);
+            st.set_delimiter(string(","));
+            for (string network = st.next_token();
+                    network.size() > 0;
+                    network = st.next_token()) {
+                ircNetworks.push_back(network);
+            }
             break;
         case 'o':
             cog_addr = string(optarg);
@@ -160,6 +210,29 @@ int CogitaConfig::parseOptions(int argc, char* argv[])
         case 't':
             cog_port = atoi(optarg);
             break;
+        case 'P':
+            cog_pool_size = atoi(optarg);
+            break;
+        case 'T':
+            cog_read_timeout = atoi(optarg);
+            break;
+        case 'j':
+            max_concurrent = atoi(optarg);
+            if (max_concurrent < 1) max_concurrent = 1;
+            break;
+        case 'r':
+            irc_flood_rate = atoi(optarg);
+            if (irc_flood_rate < 1) irc_flood_rate = 1;
+            break;
+        case 'b':
+            irc_flood_burst = atoi(optarg);
+            break;
+        case 'S':
+            stats_every = atoi(optarg);
+            break;
+        case 'L':
+            slow_request = atof(optarg);
+            break;
         case 'c':
             ircChannels.clear();
             channelsTemp = optarg;
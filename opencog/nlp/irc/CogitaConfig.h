@@ -37,7 +37,7 @@ class CogitaConfig
 public:
     std::string version_string;
 
-    std::string ircNetwork;
+    std::vector<std::string> ircNetworks; // "server" or "server:port"
     std::vector<std::string> ircChannels;
     int ircPort;
     std::string irc_nick;
@@ -48,6 +48,19 @@ public:
 
     std::string cog_addr; // OpenCog cogserver IP address.
     int cog_port;         // OpenCog cogserver port number.
+    int cog_pool_size;    // Idle cogserver sessions kept; 0 for none.
+    int cog_connect_timeout; // Seconds to wait for the cogserver.
+    int cog_read_timeout; // Seconds to wait for more of a reply; 0 for ever.
+    int cog_ping_after;   // Seconds idle, after which a session is checked.
+    int max_concurrent;   // Chat requests processed at the same time.
+
+    int irc_flood_rate;   // Bytes a second sent to IRC, on average.
+    int irc_flood_burst;  // Bytes sent to IRC at once, at most.
+    int irc_line_limit;   // Longest line sent to IRC, in bytes.
+    int irc_short_reply;  // Bytes of a reply sent ahead of longer replies.
+
+    int stats_every;      // Seconds between printing the stats; 0 for never.
+    double slow_request;  // Seconds, over which a request is logged; 0 for none.
 
     CogitaConfig();
 
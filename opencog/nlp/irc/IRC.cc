@@ -50,7 +50,8 @@ IRC::IRC() :
     dataout(nullptr),
     datain(nullptr),
     chan_users(nullptr),
-    hooks(nullptr)
+    hooks(nullptr),
+    in_len(0)
 {}
 
 IRC::~IRC()
@@ -119,6 +120,7 @@ int IRC::start(const char* server, int port, const char* nick,
 	socklen_t optlen = sizeof(optval);
 	int rc;
 
+	std::lock_guard<std::mutex> lck(out_mtx);
 	if (connected)
 		return 1;
 
@@ -202,6 +204,7 @@ int IRC::start(const char* server, int port, const char* nick,
 	}
 	
 	connected=true;
+	in_len=0;
 	
 	cur_nick=new char[strlen(nick)+1];
 	strcpy(cur_nick, nick);
@@ -216,12 +219,12 @@ int IRC::start(const char* server, int port, const char* nick,
 
 void IRC::disconnect()
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	if (connected)
 	{
 		fclose(dataout);
 		printf("Disconnected from server.\n");
 		connected=false;
-		quit("Leaving");
 		#ifdef WIN32_NOT_UNIX
 		shutdown(irc_socket, 2);
 		#endif
@@ -231,6 +234,7 @@ void IRC::disconnect()
 
 int IRC::quit(const char* quit_message)
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	if (connected)
 	{
 		if (quit_message)
@@ -245,9 +249,6 @@ int IRC::quit(const char* quit_message)
 
 int IRC::message_loop()
 {
-	char buffer[1024];
-	int ret_len;
-
 	if (not connected)
 	{
 		printf("Not connected!\n");
@@ -256,29 +257,82 @@ int IRC::message_loop()
 
 	while (1)
 	{
-		ret_len=recv(irc_socket, buffer, 1023, 0);
-		if (ret_len==SOCKET_ERROR || !ret_len)
-		{
-			perror("Exit main loop");
+		if (read_input())
 			return 1;
-		}
-		buffer[ret_len]='\0';
-		split_to_replies(buffer);
 	}
 
 	return 0;
 }
 
-void IRC::split_to_replies(char* data)
+/*
+ * Read once from the server, blocking until something comes in, and
+ * handle each line completed by it. A connection polled for input can
+ * be read this way without blocking. Returns 1 if the server closed
+ * the connection, or it failed.
+ */
+int IRC::read_input()
 {
-	char* p;
+	int ret_len;
+
+	if (not connected)
+		return 1;
+
+	ret_len=recv(irc_socket, in_buf+in_len, IRC_INPUT_BUFSZ-1-in_len, 0);
+	if (ret_len==SOCKET_ERROR && EINTR==errno)
+		return 0;
+	if (ret_len==SOCKET_ERROR || !ret_len)
+	{
+		perror("Exit main loop");
+		return 1;
+	}
+
+	size_t from=in_len;
+	in_len+=ret_len;
+	parse_input(from);
+	return 0;
+}
+
+/*
+ * Parse each complete line in the input buffer, looking for line ends
+ * only in what came in after from, and keep the rest for next time.
+ */
+void IRC::parse_input(size_t from)
+{
+	char* line=in_buf;
+	char* end=in_buf+in_len;
+	char* nl;
 
-	while ((p=strstr(data, "\r\n")))
+	while ((nl=(char*) memchr(in_buf+from, '\n', end-(in_buf+from))))
 	{
-		*p='\0';
-		parse_irc_reply(data);
-		data=p+2;
+		char* eol=nl;
+		if (line<eol && '\r'==eol[-1])
+			eol--;
+		*eol='\0';
+		if (line<eol)
+			parse_irc_reply(line);
+		line=nl+1;
+		from=line-in_buf;
 	}
+
+	in_len=end-line;
+	if (IRC_INPUT_BUFSZ-1<=in_len)
+	{
+		// No line is this long; whatever it is, drop it.
+		printf("Dropped %zu bytes of input with no end of line\n", in_len);
+		in_len=0;
+		return;
+	}
+	memmove(in_buf, line, in_len);
+}
+
+int IRC::socket_fd()
+{
+	return irc_socket;
+}
+
+bool IRC::is_connected()
+{
+	return connected;
 }
 
 int IRC::is_op(const char* channel, const char* nick)
@@ -751,6 +805,7 @@ void IRC::parse_irc_reply(char* data)
 		{
 			if (!params)
 				return;
+			std::lock_guard<std::mutex> lck(out_mtx);
 			fprintf(dataout, "PONG %s\r\n", &params[1]);
 			#ifdef __IRC_DEBUG__
 			const time_t now = time(0);
@@ -793,6 +848,7 @@ void IRC::call_hook(const char* irc_command, const char* params, irc_reply_data*
 
 int IRC::notice(const char* target, const char* message)
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	if (!connected)
 		return 1;
 	fprintf(dataout, "NOTICE %s :%s\r\n", target, message);
@@ -801,6 +857,7 @@ int IRC::notice(const char* target, const char* message)
 
 int IRC::notice(const char* fmt, ...)
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	va_list argp;
 	
 	if (!connected)
@@ -815,6 +872,7 @@ int IRC::notice(const char* fmt, ...)
 
 int IRC::privmsg(const char* target, const char* message)
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	if (!connected)
 		return 1;
 	fprintf(dataout, "PRIVMSG %s :%s\r\n", target, message);
@@ -823,6 +881,7 @@ int IRC::privmsg(const char* target, const char* message)
 
 int IRC::privmsg(const char* fmt, ...)
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	va_list argp;
 	
 	if (!connected)
@@ -838,6 +897,7 @@ int IRC::privmsg(const char* fmt, ...)
 
 int IRC::join(const char* channel)
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	if (!connected)
 		return 1;
 	fprintf(dataout, "JOIN %s\r\n", channel);
@@ -846,6 +906,7 @@ int IRC::join(const char* channel)
 
 int IRC::part(const char* channel)
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	if (!connected)
 		return 1;
 	fprintf(dataout, "PART %s\r\n", channel);
@@ -854,6 +915,7 @@ int IRC::part(const char* channel)
 
 int IRC::kick(const char* channel, const char* nick)
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	if (!connected)
 		return 1;
 	fprintf(dataout, "KICK %s %s\r\n", channel, nick);
@@ -862,6 +924,7 @@ int IRC::kick(const char* channel, const char* nick)
 
 int IRC::raw(const char* data)
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	if (!connected)
 		return 1;
 	fprintf(dataout, "%s\r\n", data);
@@ -870,6 +933,7 @@ int IRC::raw(const char* data)
 
 int IRC::kick(const char* channel, const char* nick, const char* message)
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	if (!connected)
 		return 1;
 	fprintf(dataout, "KICK %s %s :%s\r\n", channel, nick, message);
@@ -878,6 +942,7 @@ int IRC::kick(const char* channel, const char* nick, const char* message)
 
 int IRC::mode(const char* channel, const char* modes, const char* targets)
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	if (!connected)
 		return 1;
 	if (!targets)
@@ -897,6 +962,7 @@ int IRC::mode(const char* modes)
 
 int IRC::nick(const char* newnick)
 {
+	std::lock_guard<std::mutex> lck(out_mtx);
 	if (not connected)
 		return 1;
 	fprintf(dataout, "NICK %s\r\n", newnick);
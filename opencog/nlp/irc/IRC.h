@@ -26,6 +26,8 @@
 #include <stdio.h>
 #include <stdarg.h>
 
+#include <mutex>
+
 #define __CPIRC_VERSION__	0.1
 #define __IRC_DEBUG__ 1
 
@@ -33,6 +35,9 @@
 #define IRC_USER_HALFOP	2
 #define IRC_USER_OP		4
 
+/* Room for several lines from the server; a line is at most 512 bytes */
+#define IRC_INPUT_BUFSZ	8192
+
 struct irc_reply_data
 {
 	char* nick;
@@ -78,6 +83,9 @@ public:
 	int raw(const char* data);
 	void hook_irc_command(const char* cmd_name, int (*function_ptr)(const char*, irc_reply_data*, void*));
 	int message_loop();
+	int read_input();
+	int socket_fd();
+	bool is_connected();
 	int is_op(const char* channel, const char* nick);
 	int is_voice(const char* channel, const char* nick);
 	const char* current_nick(void);
@@ -85,15 +93,21 @@ private:
 	void call_hook(const char* irc_command, const char*params, irc_reply_data* hostd);
 	/*void call_the_hook(irc_command_hook* hook, const char* irc_command, const char*params, irc_host_data* hostd);*/
 	void parse_irc_reply(char* data);
-	void split_to_replies(char* data);
+	void parse_input(size_t from);
 	void insert_irc_command_hook(irc_command_hook* hook, const char* cmd_name, int (*function_ptr)(const char*, irc_reply_data*, void*));
 	void delete_irc_command_hook(irc_command_hook* cmd_hook);
 
 	int irc_socket;
 	bool connected;
+	std::mutex out_mtx; // the replies may be sent from several threads
 	char* cur_nick;
 	FILE* dataout;
 	FILE* datain;
 	channel_user* chan_users;
 	irc_command_hook* hooks;
+
+	// What was read from the server, and not yet parsed: the start of
+	// a line, the rest of which has not come in yet.
+	char in_buf[IRC_INPUT_BUFSZ];
+	size_t in_len;
 };
@@ -0,0 +1,104 @@
+/*
+ *   Event loop for the IRC connections of the La Cogita IRC chatbot
+ *   Copyright (C) 2026 OpenCog Foundation
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+
+#include <algorithm>
+
+#include "IRC.h"
+#include "IRCReactor.h"
+
+using namespace opencog::chatbot;
+
+IRCReactor::IRCReactor(int retry_delay) :
+	_retry_delay(retry_delay)
+{
+}
+
+/**
+ * The connection is connected when run() gets to it.
+ */
+void IRCReactor::add(IRC* conn, Connect connect)
+{
+	_conns.push_back({conn, connect, Clock::now()});
+}
+
+int IRCReactor::run()
+{
+	std::vector<struct pollfd> fds;
+	std::vector<Entry*> polled;
+
+	while (not _conns.empty())
+	{
+		// Connect those that are due, and poll those connected. The
+		// others are waited for, if no input comes first.
+		Clock::time_point now = Clock::now();
+		int timeout = -1;
+		fds.clear();
+		polled.clear();
+		for (Entry& e : _conns)
+		{
+			if (not e.conn->is_connected() and e.retry_at <= now and
+			    0 != e.connect(e.conn))
+			{
+				fprintf(stderr, "Error: can't connect; "
+				        "trying again in %d seconds\n", _retry_delay);
+				e.retry_at = now + std::chrono::seconds(_retry_delay);
+			}
+
+			if (e.conn->is_connected())
+			{
+				fds.push_back({e.conn->socket_fd(), POLLIN, 0});
+				polled.push_back(&e);
+				continue;
+			}
+
+			int ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+				e.retry_at - now).count();
+			ms = std::max(ms, 0);
+			if (0 > timeout or ms < timeout) timeout = ms;
+		}
+
+		int rc = poll(fds.data(), fds.size(), timeout);
+		if (0 > rc and EINTR == errno) continue;
+		if (0 > rc)
+		{
+			perror("poll()");
+			return 1;
+		}
+
+		for (size_t i = 0; i < fds.size(); i++)
+		{
+			if (0 == fds[i].revents) continue;
+
+			Entry* e = polled[i];
+			if (e->conn->read_input())
+			{
+				fprintf(stderr, "Error: remote side closed socket; "
+				        "connecting again in %d seconds\n", _retry_delay);
+				e->conn->disconnect();
+				e->retry_at = Clock::now() +
+					std::chrono::seconds(_retry_delay);
+			}
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,70 @@
+/*
+ *   Event loop for the IRC connections of the La Cogita IRC chatbot
+ *   Copyright (C) 2026 OpenCog Foundation
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _OPENCOG_IRC_REACTOR_H
+#define _OPENCOG_IRC_REACTOR_H
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+class IRC;
+
+namespace opencog {
+namespace chatbot {
+
+/**
+ * Reads several IRC connections, e.g. to different networks, on one
+ * thread: it polls their sockets, and has each connection that has
+ * input read it and handle its complete lines, without waiting on the
+ * others. A connection that is closed is connected again after a
+ * while, without holding up the others either.
+ */
+class IRCReactor
+{
+public:
+	/// Connect the connection, e.g. with IRC::start; 0 on success.
+	typedef std::function<int(IRC*)> Connect;
+
+	/// @param retry_delay  seconds to wait before connecting again
+	IRCReactor(int retry_delay);
+
+	void add(IRC* conn, Connect connect);
+
+	/// Handle the connections, for ever; returns only if there are
+	/// none, or poll fails.
+	int run();
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	struct Entry
+	{
+		IRC* conn;
+		Connect connect;
+		Clock::time_point retry_at;
+	};
+
+	std::vector<Entry> _conns;
+	int _retry_delay;
+};
+
+}} // ~namespace opencog::chatbot
+
+#endif // _OPENCOG_IRC_REACTOR_H
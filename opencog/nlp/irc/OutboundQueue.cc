@@ -0,0 +1,168 @@
+/*
+ *   Rate-limited IRC output for the La Cogita IRC chatbot
+ *   Copyright (C) 2026 OpenCog Foundation
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+
+#include "IRC.h"
+#include "OutboundQueue.h"
+
+using namespace opencog::chatbot;
+
+// What a line costs, besides its text: "PRIVMSG ", " :" and "\r\n"
+#define LINE_OVERHEAD 12
+
+OutboundQueue::OutboundQueue(IRC* conn, double rate, double burst,
+                             size_t line_limit) :
+	_conn(conn),
+	_rate(std::max(rate, 1.0)),
+	_burst(std::max(burst, (double) line_limit)),
+	_line_limit(line_limit),
+	_tokens(_burst),
+	_filled(Clock::now()),
+	_stop(false)
+{
+	_writer = std::thread(&OutboundQueue::write, this);
+}
+
+/**
+ * What is still waiting is dropped.
+ */
+OutboundQueue::~OutboundQueue()
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_stop = true;
+	}
+	_cv.notify_all();
+	_writer.join();
+}
+
+size_t OutboundQueue::size()
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _urgent.size() + _normal.size();
+}
+
+// How many bytes of text a message to the target can hold
+static size_t text_limit(size_t line_limit, const std::string& target)
+{
+	size_t used = LINE_OVERHEAD + target.size();
+	return (used + 16 < line_limit) ? line_limit - used : 16;
+}
+
+void OutboundQueue::push(const std::string& target, const std::string& text,
+                         bool urgent)
+{
+	size_t limit = text_limit(_line_limit, target);
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	std::deque<Message>& queue = urgent ? _urgent : _normal;
+
+	// Split it at the line limit, at the last space before it if there
+	// is one, and never within a UTF-8 character.
+	size_t start = 0;
+	while (start < text.size())
+	{
+		size_t len = text.size() - start;
+		if (limit < len)
+		{
+			len = limit;
+			size_t space = text.rfind(' ', start + len);
+			if (space != std::string::npos and start < space)
+				len = space - start;
+			else
+				while (0 < len and 0x80 == (text[start + len] & 0xc0))
+					len--;
+			if (0 == len) len = limit;
+		}
+
+		queue.push_back({target, text.substr(start, len), nullptr});
+		start += len;
+		while (start < text.size() and ' ' == text[start]) start++;
+	}
+	_cv.notify_one();
+}
+
+void OutboundQueue::when_sent(bool urgent, std::function<void()> done)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	(urgent ? _urgent : _normal).push_back({"", "", done});
+	_cv.notify_one();
+}
+
+/**
+ * Take the next message to send, with the ones after it to the same
+ * target that fit in with it. Waits for one, unless stopped.
+ */
+bool OutboundQueue::take(Message& msg)
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	_cv.wait(lck, [this]
+		{ return _stop or not _urgent.empty() or not _normal.empty(); });
+	if (_stop) return false;
+
+	std::deque<Message>& queue = _urgent.empty() ? _normal : _urgent;
+	msg = std::move(queue.front());
+	queue.pop_front();
+
+	if (msg.done) return true;
+	size_t limit = text_limit(_line_limit, msg.target);
+	while (not queue.empty() and not queue.front().done and
+	       queue.front().target == msg.target and
+	       msg.text.size() + 1 + queue.front().text.size() <= limit)
+	{
+		msg.text += ' ';
+		msg.text += queue.front().text;
+		queue.pop_front();
+	}
+	return true;
+}
+
+void OutboundQueue::write()
+{
+	Message msg;
+	while (take(msg))
+	{
+		if (msg.done)
+		{
+			msg.done();
+			continue;
+		}
+
+		// Wait for the bucket to have enough for it.
+		double cost = std::min(_burst,
+			(double) (msg.text.size() + msg.target.size() + LINE_OVERHEAD));
+		while (true)
+		{
+			Clock::time_point now = Clock::now();
+			std::chrono::duration<double> dt = now - _filled;
+			_tokens = std::min(_burst, _tokens + dt.count() * _rate);
+			_filled = now;
+			if (cost <= _tokens) break;
+
+			std::unique_lock<std::mutex> lck(_mtx);
+			_cv.wait_for(lck, std::chrono::duration<double>(
+				(cost - _tokens) / _rate), [this] { return _stop; });
+			if (_stop) return;
+		}
+		_tokens -= cost;
+
+		_conn->privmsg(msg.target.c_str(), msg.text.c_str());
+	}
+}
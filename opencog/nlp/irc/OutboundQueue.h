@@ -0,0 +1,105 @@
+/*
+ *   Rate-limited IRC output for the La Cogita IRC chatbot
+ *   Copyright (C) 2026 OpenCog Foundation
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _OPENCOG_OUTBOUND_QUEUE_H
+#define _OPENCOG_OUTBOUND_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class IRC;
+
+namespace opencog {
+namespace chatbot {
+
+/**
+ * The messages to send to one IRC server, sent by a thread of its own
+ * no faster than the server allows, so that waiting for the rate limit
+ * never holds up the reading of IRC or the handling of requests.
+ *
+ * The rate is limited by a token bucket, counted in bytes: it holds at
+ * most `burst` bytes, and fills at `rate` bytes a second; a line takes
+ * its length, and a bit for the command, out of it. Lines longer than
+ * the IRC line limit are split, at a space if there is one. Lines to
+ * the same target, waiting one after the other, are sent as one line,
+ * as long as that fits. Urgent lines, i.e. the starts of replies, go
+ * ahead of the others, so that a short answer isn't stuck behind a
+ * long one.
+ */
+class OutboundQueue
+{
+public:
+	/**
+	 * @param conn        the connection to send on
+	 * @param rate        bytes per second
+	 * @param burst       bytes that may be sent at once
+	 * @param line_limit  the most bytes of text in one message
+	 */
+	OutboundQueue(IRC* conn, double rate, double burst, size_t line_limit);
+	~OutboundQueue();
+
+	/// Queue a PRIVMSG of the text to the target.
+	void push(const std::string& target, const std::string& text,
+	          bool urgent);
+
+	/// Call done once what was pushed so far, with the same urgency,
+	/// has been sent.
+	void when_sent(bool urgent, std::function<void()> done);
+
+	/// The no. of messages waiting.
+	size_t size();
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	struct Message
+	{
+		std::string target;
+		std::string text;
+		std::function<void()> done; // for a when_sent mark, not sent
+	};
+
+	void write();
+	bool take(Message&);
+
+	IRC* _conn;
+	double _rate;
+	double _burst;
+	size_t _line_limit;
+
+	double _tokens;
+	Clock::time_point _filled;
+
+	std::mutex _mtx;
+	std::condition_variable _cv;
+	bool _stop;
+	std::deque<Message> _urgent;
+	std::deque<Message> _normal;
+
+	std::thread _writer;
+};
+
+}} // ~namespace opencog::chatbot
+
+#endif // _OPENCOG_OUTBOUND_QUEUE_H
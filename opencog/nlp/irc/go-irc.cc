@@ -29,12 +29,18 @@
 #include <unistd.h>
 #include <getopt.h>
 
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <set>
 
 #include "IRC.h"
+#include "ChatStats.h"
+#include "ChatWorkers.h"
 #include "CogitaConfig.h"
+#include "IRCReactor.h"
+#include "OutboundQueue.h"
 
 #include "whirr-sockets.h"
 
@@ -43,6 +49,16 @@ using std::string;
 
 CogitaConfig cc;
 
+// The requests are run here, off the thread reading the IRC socket.
+static ChatWorkers* workers = NULL;
+
+// How long the requests take, and where the time goes.
+static ChatStats* stats = NULL;
+
+// Everything said to the chatrooms of each network goes out through
+// its queue here.
+static std::map<IRC*, OutboundQueue*> out_queues;
+
 /* printf can puke if these fields are NULL */
 void fixup_reply(irc_reply_data* ird)
 {
@@ -67,14 +83,13 @@ int end_of_motd(const char* params, irc_reply_data* ird, void* data)
 	// Quit hard, if dry-run.
 	if (cc.dry_run) exit(0);
 
-	sleep(1);
+	// No sleeping between these, as that would hold up the other
+	// networks; the hello waits its turn in the queue.
 	conn->join (cc.ircChannels[0].c_str());
 	printf("chatbot sent channel join %s\n", cc.ircChannels[0].c_str());
-	sleep(2);
 	conn->notice (cc.ircChannels[0].c_str(), "ola");
 	printf("chatbot sent channel notice\n");
-	sleep(2);
-	conn->privmsg (cc.ircChannels[0].c_str(), "here we are");
+	out_queues.at(conn)->push(cc.ircChannels[0], "here we are", false);
 	printf("chatbot said hello to the channel\n");
 	return 0;
 }
@@ -89,12 +104,16 @@ static bool is_nonblank(const char * str)
 	return true;
 }
 
+static void process_request(OutboundQueue*, std::shared_ptr<RequestTiming>,
+                            const char*, const char*);
+
 /**
  * Handle a message received from IRC.
  */
 int got_privmsg(const char* params, irc_reply_data* ird, void* data)
 {
-	IRC* conn = static_cast<IRC*>(data);
+	RequestTiming::Clock::time_point received = RequestTiming::Clock::now();
+	OutboundQueue* outq = out_queues.at(static_cast<IRC*>(data));
 	fixup_reply(ird);
 
 	printf("input=%s\n", params);
@@ -142,7 +161,15 @@ int got_privmsg(const char* params, irc_reply_data* ird, void* data)
 	if ((0x1 == start[0]) && !strncmp (&start[1], "VERSION", 7))
 	{
 		printf ("VERSION: %s\n", cc.version_string.c_str());
-		conn->privmsg (msg_target, cc.version_string.c_str());
+		outq->push(msg_target, cc.version_string, true);
+		return 0;
+	}
+
+	// Reply to a private request for the latency statistics
+	if (priv && !strncmp (start, ":stats", 6))
+	{
+		for (const string& line : stats->report())
+			outq->push(msg_target, line, true);
 		return 0;
 	}
 
@@ -197,90 +224,149 @@ int got_privmsg(const char* params, irc_reply_data* ird, void* data)
 #else
 	else
 	{
-		conn->privmsg (msg_target, "Shell escapes disabled in this chatbot version\n");
+		outq->push(msg_target, "Shell escapes disabled in this chatbot version", true);
 		free(cmdline);
 		return 0;
 	}
 #endif /* ENABLE_SHELL_ESCAPES */
 
-#define FLOOD_CHAR_COUNT 120
+	// The requests of each user on each channel are answered in turn.
+	string target(msg_target);
+	string request(cmdline);
+	free(cmdline);
 
-	size_t flood_cnt = FLOOD_CHAR_COUNT;
-	size_t cnt = 0;
-	bool dosend = true;
+	std::shared_ptr<RequestTiming> timing(new RequestTiming);
+	timing->who = target + " " + ird->nick;
+	timing->query = start;
+	timing->received = received;
 
-	// printf ("Sending to opencog: %s\n", cmdline);
-	char * reply = whirr_sock_io (cmdline);
-	free(cmdline);
-	cmdline = NULL;
+	bool queued = workers->submit(timing->who,
+		[outq, timing, target, request]()
+		{
+			process_request(outq, timing, target.c_str(), request.c_str());
+		});
+	if (queued)
+		stats->count(ChatStats::REQUESTS);
+	else
+	{
+		stats->count(ChatStats::REJECTED);
+		outq->push(msg_target, "Slow down, I'm still thinking about what you said before.", true);
+	}
 
-	printf ("opencog reply: %s\n", reply);
+	return 0;
+}
+
+// Where a reply is, as its lines come in.
+struct ReplyState
+{
+	OutboundQueue* outq;
+	RequestTiming* timing;
+	const char* msg_target;
+	size_t sent;
+	bool urgent;  // the last line queued was
+	bool dosend;
+	string resubmit;
+};
+
+/**
+ * Queue a line of a reply, its first few hundred bytes ahead of the
+ * longer replies waiting.
+ */
+static void send_line(ReplyState* rs, const char* line)
+{
+	size_t len = strcspn(line, "\r\n");
+	rs->urgent = rs->sent < (size_t) cc.irc_short_reply;
+	rs->outq->push(rs->msg_target, string(line, len), rs->urgent);
+	rs->sent += len;
+	stats->count(ChatStats::LINES);
+	stats->count(ChatStats::BYTES, len);
+}
 
-	/* Each newline has to be on its own line */
-	/* Limit length of reply so we don't get kicked for flooding */
-	char * p = reply;
-	while (*p)
+/**
+ * Handle one line of a reply from opencog, as soon as it is in.
+ */
+static void got_reply_line(const char* text, size_t len, void* data)
+{
+	ReplyState* rs = static_cast<ReplyState*>(data);
+	string line(text, len);
+
+	printf ("opencog reply: %s", line.c_str());
+
+	if (not rs->timing->replied)
 	{
-		char *ep = strchr (p, '\n');
+		rs->timing->first_line = RequestTiming::Clock::now();
+		rs->timing->replied = true;
+	}
 
-		// The last line -- no newline found.
-		if (!ep)
-		{
-			if (is_nonblank(p))
-				conn->privmsg (msg_target, p);
-			break;
-		}
-		ep ++;
-		int save = *ep;
-		*ep = 0x0;
-
-		// If the line starts with ":scm", resubmit it to the
-		// server. This is a kind-of cheap, hacky way of doing
-		// multi-processing.
-		if (0 == strncmp(p, ":scm", 4))
-		{
-			char * cr = strchr(p, '\r');
-			if (cr) *cr = '\n';
-			char * r = whirr_sock_io (p+1);
-			free(reply);
-			reply = r;
-			p = reply;
-			printf ("opencog reply: %s\n", reply);
-			continue;
-		}
+	// After a resubmission, the rest of the reply is dropped.
+	if (not rs->resubmit.empty()) return;
 
-		// If the line starts with ":dbg", the do not send to chatroom
-		if (0 == strncmp(p, ":dbg", 4))
-		{
-			*ep = save;
-			p = ep;
-			dosend = false;
-			continue;
-		}
-		if (0 == strncmp(p, ":end-dbg", 8))
-		{
-			*ep = save;
-			p = ep;
-			dosend = true;
-			continue;
-		}
+	// The last line -- no newline found.
+	if ('\n' != line.back())
+	{
+		printf ("\n");
+		if (is_nonblank(line.c_str()))
+			send_line(rs, line.c_str());
+		return;
+	}
 
-		// Else send output to chatroom
-		if (dosend && is_nonblank(p))
-		{
-			conn->privmsg (msg_target, p);
-			cnt += strlen (p);
+	// If the line starts with ":scm", resubmit it to the
+	// server. This is a kind-of cheap, hacky way of doing
+	// multi-processing.
+	if (0 == line.compare(0, 4, ":scm"))
+	{
+		size_t cr = line.find('\r');
+		if (string::npos != cr) line[cr] = '\n';
+		rs->resubmit = line.substr(1);
+		return;
+	}
 
-			/* Sleep so that we don't get kicked for flooding */
-			if (flood_cnt < cnt) { sleep(1); cnt -= FLOOD_CHAR_COUNT; }
-			if (50 < flood_cnt) flood_cnt -= 15;
-		}
-		*ep = save;
-		p = ep;
+	// If the line starts with ":dbg", the do not send to chatroom
+	if (0 == line.compare(0, 4, ":dbg"))
+	{
+		rs->dosend = false;
+		return;
+	}
+	if (0 == line.compare(0, 8, ":end-dbg"))
+	{
+		rs->dosend = true;
+		return;
 	}
-	free(reply);
 
-	return 0;
+	// Else send output to chatroom
+	if (rs->dosend && is_nonblank(line.c_str()))
+		send_line(rs, line.c_str());
+}
+
+/**
+ * Send the request to opencog, and its reply to IRC, line by line, as
+ * it comes in. This is run by the workers, so that it can block on
+ * opencog without holding up the reading of IRC.
+ */
+static void process_request(OutboundQueue* outq,
+                            std::shared_ptr<RequestTiming> timing,
+                            const char* msg_target, const char* cmdline)
+{
+	ReplyState rs = {outq, timing.get(), msg_target, 0, true, true, ""};
+	timing->started = RequestTiming::Clock::now();
+
+	// printf ("Sending to opencog: %s\n", cmdline);
+	whirr_sock_lines (cmdline, got_reply_line, &rs);
+
+	while (not rs.resubmit.empty())
+	{
+		string request(std::move(rs.resubmit));
+		rs.resubmit.clear();
+		whirr_sock_lines (request.c_str(), got_reply_line, &rs);
+	}
+	timing->last_line = RequestTiming::Clock::now();
+
+	// The request is done once its last line has gone out to IRC.
+	outq->when_sent(rs.urgent, [timing]()
+	{
+		timing->sent = RequestTiming::Clock::now();
+		stats->record(*timing);
+	});
 }
 
 int got_kick(const char* params, irc_reply_data* ird, void* data)
@@ -302,37 +388,61 @@ int main (int argc, char * argv[])
 	// Set up connection to the cogserver.
 	whirr_sock_setup();
 
-	// Connect to the IRC network.
-	IRC conn;
-	conn.hook_irc_command("376", &end_of_motd);
-	conn.hook_irc_command("PRIVMSG", &got_privmsg);
-	conn.hook_irc_command("KICK", &got_kick);
+	ChatStats chat_stats(cc.slow_request);
+	chat_stats.print_every(cc.stats_every);
+	stats = &chat_stats;
 
 	const char *login = getlogin();
 	if (nullptr == login) login = "no-controlling-tty";
 
-	// Loop forever. When the IRC network burps and closes our
-	// connection, just log in again.
-	while (true)
+	// A connection, and an output queue, for each network, all read
+	// by the reactor. The workers go last, so that they are stopped
+	// before what they send to.
+	std::vector<std::unique_ptr<IRC>> conns;
+	std::vector<std::unique_ptr<OutboundQueue>> queues;
+	IRCReactor reactor(20);
+	for (const string& network : cc.ircNetworks)
 	{
-		printf("Joining network=%s port=%d nick=%s user=%s\n",
-			cc.ircNetwork.c_str(), cc.ircPort, cc.irc_nick.c_str(), login);
+		string server(network);
+		int port = cc.ircPort;
+		size_t colon = network.rfind(':');
+		if (string::npos != colon)
+		{
+			server = network.substr(0, colon);
+			port = atoi(network.c_str() + colon + 1);
+		}
 
-		// The login-name, nick, etc. are there only to make it look
-		// pretty on IRC ident.
-		conn.start(cc.ircNetwork.c_str(), cc.ircPort, cc.irc_nick.c_str(),
-		           login, cc.irc_name.c_str(), cc.irc_pass.c_str());
+		IRC* conn = new IRC;
+		conns.emplace_back(conn);
+		conn->hook_irc_command("376", &end_of_motd);
+		conn->hook_irc_command("PRIVMSG", &got_privmsg);
+		conn->hook_irc_command("KICK", &got_kick);
 
-		conn.message_loop();
+		OutboundQueue* outq = new OutboundQueue(conn, cc.irc_flood_rate,
+			cc.irc_flood_burst, cc.irc_line_limit);
+		queues.emplace_back(outq);
+		out_queues[conn] = outq;
 
-		fprintf(stderr, "%s: Fatal Error: Remote side closed socket\n",
-			argv[0]);
+		// When the IRC network burps and closes our connection,
+		// the reactor just logs in again.
+		reactor.add(conn, [server, port, login](IRC* conn)
+		{
+			printf("Joining network=%s port=%d nick=%s user=%s\n",
+				server.c_str(), port, cc.irc_nick.c_str(), login);
+
+			// The login-name, nick, etc. are there only to make it
+			// look pretty on IRC ident.
+			return conn->start(server.c_str(), port, cc.irc_nick.c_str(),
+			                   login, cc.irc_name.c_str(), cc.irc_pass.c_str());
+		});
+	}
 
-		conn.disconnect();
+	ChatWorkers chat_workers(cc.max_concurrent);
+	workers = &chat_workers;
 
-		sleep(20);
-	}
+	reactor.run();
 
+	fprintf(stderr, "%s: Fatal Error: no IRC connections left\n", argv[0]);
 	return 1;
 }
 
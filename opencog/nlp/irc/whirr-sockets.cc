@@ -1,9 +1,14 @@
 
 /**
- * Simple blocking, stateless TCP socket I/O.
+ * Simple blocking TCP socket I/O.
  *
  * Call whirr_sock_setup() to initialize.
  * Call whirr_sock_io() to send message, and return reply.
+ * Call whirr_sock_lines() to have each line of the reply as it comes.
+ *
+ * Scheme messages go over the pooled sessions of a CogServerPool;
+ * anything else, and everything if the pool size is zero, gets a
+ * connection of its own, as it used to.
  *
  * Copied from "whirr.c".
  * Linas October 2007 ported to opencog April 2009
@@ -17,8 +22,12 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <memory>
+#include <string>
+
 #include "whirr-sockets.h"
 #include "CogitaConfig.h"
+#include "CogServerPool.h"
 
 using namespace opencog::chatbot;
 extern CogitaConfig cc;
@@ -32,6 +41,7 @@ extern CogitaConfig cc;
 #define SERVER_PORT (cc.cog_port)
 
 struct sockaddr_in global_server_addr;
+static std::unique_ptr<CogServerPool> global_pool;
 
 /**
  * whirr_sock_setup -- initialze socket to the OpenCog server
@@ -42,11 +52,72 @@ void whirr_sock_setup (void)
 	global_server_addr.sin_family = AF_INET;
 	global_server_addr.sin_addr.s_addr = inet_addr(SERVER_HOST);
 	global_server_addr.sin_port = htons(SERVER_PORT);
+
+	if (0 < cc.cog_pool_size)
+		global_pool.reset(new CogServerPool(cc.cog_addr, cc.cog_port,
+			cc.cog_pool_size, cc.cog_connect_timeout,
+			cc.cog_read_timeout, cc.cog_ping_after));
+}
+
+/**
+ * The scheme code of a message for the scheme shell, i.e. what comes
+ * after its "scm" or "scm hush" line, or NULL if it is a message for
+ * the plain shell.
+ */
+static const char * scheme_part (const char * msg)
+{
+	if (0 == strncmp(msg, "scm hush", 8) and
+	    (' ' == msg[8] or '\n' == msg[8] or '\r' == msg[8]))
+		return msg + 9;
+	if (0 == strncmp(msg, "scm", 3) and
+	    (' ' == msg[3] or '\n' == msg[3] or '\r' == msg[3]))
+		return msg + 4;
+	return NULL;
+}
+
+static void whirr_sock_io_once (const char * msg,
+                                const CogServerPool::LineHandler& on_line);
+
+/**
+ * whirr_sock_lines -- send mesg to the server, and pass each line of
+ * the reply to fn as soon as it is in, rather than after all of it.
+ *
+ * Scheme messages are evaluated in a pooled session; the reply is
+ * complete when the session prints the end-of-reply sentinel, and
+ * the wait for it is bounded by the read timeout.  See CogServerPool.
+ */
+void whirr_sock_lines (const char * msg, whirr_line_fn fn, void * data)
+{
+	CogServerPool::LineHandler on_line =
+		[fn, data](const char * line, size_t len) { fn(line, len, data); };
+
+	const char * scm = global_pool ? scheme_part(msg) : NULL;
+	if (NULL == scm)
+		whirr_sock_io_once(msg, on_line);
+	else
+		global_pool->request(scm, on_line);
+}
+
+static void append_line (const char * line, size_t len, void * data)
+{
+	static_cast<std::string *>(data)->append(line, len);
 }
 
 /**
  * whirr_sock_io -- send mesg to the server, receive reply.
  *
+ * Users should be sure to free the returned string when done.
+ */
+char * whirr_sock_io (const char * msg)
+{
+	std::string reply;
+	whirr_sock_lines(msg, append_line, &reply);
+	return strdup(reply.c_str());
+}
+
+/**
+ * whirr_sock_io_once -- send mesg to the server, receive reply.
+ *
  * The i/o is stateless and blocking: each new message opens
  * a new connection to the server. After the message is sent,
  * the send conection is closed, to indicate end-of-message.
@@ -60,11 +131,10 @@ void whirr_sock_setup (void)
  * it will make the chat server unresponsive. ... XXX this should
  * be fixed in some way, to tell the chat user that the server is
  * busy...
- *
- * Users should be sure to free the returned string when done.
  */
 
-char * whirr_sock_io (const char * msg)
+static void whirr_sock_io_once (const char * msg,
+                                const CogServerPool::LineHandler& on_line)
 {
 	int sock = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
 	if (0 > sock)
@@ -76,7 +146,10 @@ char * whirr_sock_io (const char * msg)
 	if (0 > connect(sock, (struct sockaddr *) &global_server_addr, sizeof(global_server_addr)))
 	{
 		fprintf (stderr, "Error: can't connect to server\n");
-		return strdup("La Cogita has crashed. Try again later.\n");
+		close(sock);
+		const char * crashed = "La Cogita has crashed. Try again later.\n";
+		on_line(crashed, strlen(crashed));
+		return;
 	}
 
 	int len = strlen (msg);
@@ -90,30 +163,35 @@ char * whirr_sock_io (const char * msg)
 #define BUFSZ 4050
 	char buff[BUFSZ];
 
-	char * retstr = (char *) malloc (sizeof(char) * BUFSZ);
-	retstr[0] = 0;
-	size_t cum_len = 0;
+	// The start of the line not yet ended.
+	std::string pending;
 
-	int rlen = recv (sock, buff, BUFSZ-1, 0);
+	int rlen = recv (sock, buff, BUFSZ, 0);
 	int norr = errno;
 	while (0 < rlen)
 	{
-		buff[rlen] = 0x0;
-		cum_len += rlen;
-		retstr = (char *) realloc (retstr, sizeof(char) * (cum_len+1));
-		strcat (retstr, buff);
-		rlen = recv (sock, buff, BUFSZ-1, 0);
+		size_t start = 0;
+		pending.append(buff, rlen);
+		for (size_t nl = pending.find('\n', pending.size() - rlen);
+		     std::string::npos != nl; nl = pending.find('\n', start))
+		{
+			on_line(pending.data() + start, nl + 1 - start);
+			start = nl + 1;
+		}
+		pending.erase(0, start);
+
+		rlen = recv (sock, buff, BUFSZ, 0);
 		norr = errno;
 	}
 	if (0 > rlen)
 	{
 		fprintf (stderr, "Error: bad read rel=%d errno=%d %s\n", rlen, norr, strerror(norr));
 	}
+	if (0 < pending.size())
+		on_line(pending.data(), pending.size());
 
 	shutdown (sock, SHUT_RD);
 	close(sock);
-
-	return retstr;
 }
 
 /* ================== END OF FILE ================= */
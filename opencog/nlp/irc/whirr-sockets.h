@@ -5,6 +5,8 @@
  * Linas October 2007 
  */
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -12,6 +14,10 @@ extern "C" {
 void whirr_sock_setup (void);
 char * whirr_sock_io (const char * msg);
 
+/* Called with each line of the reply, newline included, as it arrives */
+typedef void (*whirr_line_fn) (const char * line, size_t len, void * data);
+void whirr_sock_lines (const char * msg, whirr_line_fn fn, void * data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,86 @@
+/*
+ * opencog/nlp/lg-dict/ExportDisjuncts.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <link-grammar/link-includes.h>
+#include <opencog/util/exceptions.h>
+
+#include "LGDisjunctStore.h"
+
+using namespace opencog;
+
+// Write the disjuncts of the words listed in a file, one per line, to
+// a disjunct store that LgDictNode can load with lg-dict-load-disjuncts.
+int main(int argc, char *argv[])
+{
+	if (argc != 4)
+	{
+		std::cerr << "Usage: " << argv[0]
+		          << " LANG WORD-LIST STORE-FILE" << std::endl;
+		return 1;
+	}
+
+	std::string lang(argv[1]);
+	std::ifstream in(argv[2]);
+	if (not in)
+	{
+		std::cerr << "Cannot open " << argv[2] << std::endl;
+		return 1;
+	}
+
+	std::vector<std::string> words;
+	std::string line;
+	while (std::getline(in, line))
+	{
+		size_t b = line.find_first_not_of(" \t\r");
+		if (std::string::npos == b) continue;
+		size_t e = line.find_last_not_of(" \t\r");
+		words.push_back(line.substr(b, e - b + 1));
+	}
+
+	Dictionary dict = dictionary_create_lang(lang.c_str());
+	if (nullptr == dict)
+	{
+		std::cerr << "Cannot open the dictionary " << lang << std::endl;
+		return 1;
+	}
+
+	int rc = 0;
+	try
+	{
+		size_t n = LGDisjunctStore::write(dict, lang, words, argv[3]);
+		std::cout << "Wrote " << n << " of " << words.size()
+		          << " words to " << argv[3] << std::endl;
+	}
+	catch (const RuntimeException& ex)
+	{
+		std::cerr << ex.get_message() << std::endl;
+		rc = 1;
+	}
+
+	dictionary_delete(dict);
+	return rc;
+}
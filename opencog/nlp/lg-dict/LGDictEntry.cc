@@ -105,7 +105,7 @@ ValuePtr LGDictEntry::execute(AtomSpace* as, bool silent)
 			"LgDictEntry requires valid dictionary! %s was given.",
 			ldn->get_name().c_str());
 
-	HandleSeq djs = getDictEntry(dict, _outgoing[0]->get_name());
+	HandleSeq djs = ldn->get_dict_entry(_outgoing[0]->get_name());
 	for (const Handle& dj: djs) as->add_atom(dj);
 
 	return _outgoing[0];
@@ -21,7 +21,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-#include <opencog/util/oc_assert.h>
+#include <algorithm>
+#include <set>
 
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
@@ -31,31 +32,81 @@
 using namespace opencog;
 
 /**
- * Constructor for CONNECTOR_type.
+ * Constructor.  Copy the LG expression tree.
  *
- * @param t     must be CONNECTOR_type
  * @param exp   pointer to the LG Exp structure
  */
-LGDictExpContainer::LGDictExpContainer(Exp_type t, Exp* exp)
-    : m_type(t)
+LGDictExpContainer::LGDictExpContainer(Exp* exp)
 {
-    if (t != CONNECTOR_type)
+    std::unordered_map<std::string, size_t> ids;
+    add_exp(exp, ids);
+}
+
+/**
+ * Append an expression, and then its sub-expressions, to the nodes.
+ *
+ * @param exp   the LG expression
+ * @param ids   the index of each connector seen so far, by spelling
+ * @return      the index of the node of the expression
+ */
+size_t LGDictExpContainer::add_exp(Exp* exp,
+                                   std::unordered_map<std::string, size_t>& ids)
+{
+    size_t idx = m_nodes.size();
+    m_nodes.push_back({exp->type, 0, 0});
+
+    if (CONNECTOR_type == exp->type)
+    {
+        m_nodes[idx].first = add_connector(exp, ids);
+        return idx;
+    }
+
+    if (exp->type != AND_type && exp->type != OR_type)
         throw InvalidParamException(TRACE_INFO,
-            "Expected CONNECTOR_type for expression type.");
+            "Expected AND_type/OR_type for expression type.");
+
+    std::vector<size_t> subexps;
 
-    // fill stuff with fixed junk for the OPTIONAL connector
-    if (exp == NULL)
+    // FIXME XXX -- Optionals are handled incorrectly here;
+    // they are denoted by a null Exp pointer in an OR_list!
+    // Ignoring all the nulls is just ... wrong.
+#if (LINK_MAJOR_VERSION == 5) &&  (LINK_MINOR_VERSION < 7)
+    E_list* el = exp->u.l;
+    while (el)
     {
-        m_string = "OPTIONAL";
-        m_direction = '+';
-        m_multi = false;
-        return;
+        subexps.push_back(add_exp(el->e, ids));
+        el = el->next;
     }
+#else
+    Exp* subexp = lg_exp_operand_first(exp);
+    while (subexp)
+    {
+        subexps.push_back(add_exp(subexp, ids));
+        subexp = lg_exp_operand_next(subexp);
+    }
+#endif
+
+    m_nodes[idx].first = m_children.size();
+    m_nodes[idx].count = subexps.size();
+    m_children.insert(m_children.end(), subexps.begin(), subexps.end());
+    return idx;
+}
+
+/**
+ * Get the index of a connector, adding it if it's a new one.
+ *
+ * @param exp   an LG expression of CONNECTOR_type
+ * @param ids   the index of each connector seen so far, by spelling
+ */
+size_t LGDictExpContainer::add_connector(Exp* exp,
+                               std::unordered_map<std::string, size_t>& ids)
+{
+    Connector c;
 
 #if (LINK_MAJOR_VERSION == 5) && (LINK_MINOR_VERSION == 4) && (LINK_MICRO_VERSION < 4)
-    m_string = exp->u.string;
-    m_direction = exp->dir;
-    m_multi = exp->multi;
+    c.name = exp->u.string;
+    c.direction = exp->dir;
+    c.multi = exp->multi;
 #endif
 
 #if (LINK_MAJOR_VERSION == 5) && (LINK_MINOR_VERSION == 4) && (LINK_MICRO_VERSION == 4)
@@ -63,219 +114,189 @@ LGDictExpContainer::LGDictExpContainer(Exp_type t, Exp* exp)
 #endif
 
 #if (LINK_MAJOR_VERSION == 5) && (LINK_MINOR_VERSION >= 5)
-    m_string = lg_exp_get_string(exp);
-    m_direction = lg_exp_get_dir(exp);
-    m_multi = lg_exp_get_multi(exp);
+    c.name = lg_exp_get_string(exp);
+    c.direction = lg_exp_get_dir(exp);
+    c.multi = lg_exp_get_multi(exp);
 #endif
-}
 
-/**
- * Constructor for AND_type and OR_type.  Always return flatten DNF.
- *
- * @param t    AND_type or OR_type
- * @param s    vector of next level's containers
- */
-LGDictExpContainer::LGDictExpContainer(Exp_type t,
-                                       const std::vector<LGDictExpContainer> &s)
-    : m_type(t), m_subexps(s)
-{
-    if (t != AND_type && t != OR_type)
-        throw InvalidParamException(TRACE_INFO,
-            "Expected AND_type/OR_type for expression type.");
+    std::string spelling((c.multi ? "@" : "") + c.name + c.direction);
 
-    // flatten & dnf on construction
-    basic_flatten();
-    basic_dnf();
+    auto it = ids.find(spelling);
+    if (it != ids.end()) return it->second;
 
-    // need flattening again after changing to dnf
-    basic_flatten();
+    size_t id = m_connectors.size();
+    m_connectors.push_back(std::move(c));
+    ids.emplace(std::move(spelling), id);
+    return id;
+}
+
+// -------------------------------------------------------------------
 
-    // convert to normal order (- before +)
-    basic_normal_order();
+LGDictExpContainer::DisjunctIterator::DisjunctIterator(
+                                     const LGDictExpContainer& exp)
+    : m_exp(exp), m_started(false), m_done(false),
+      m_choices(exp.m_nodes.size(), 0)
+{
 }
 
 /**
- * Flatten the container.
+ * Get the next disjunct.
  *
- * Remove nested and-recursive trees. Thus, AND(A, AND(B, C)) becomes
- * AND(A, B, C), assuming the sub-levels are already flattened.
+ * Connectors are OR-distributive but not AND-distributive. Thus, while
+ * (A & (B or C)) = ((A & B) or (A & C)), it is NOT the case that
+ * (A or (B & C)) = ((A or B) & (A or C)).  So, a disjunct is had by
+ * taking one branch of each OR met, and all the branches of each AND.
+ * The branches taken are counted through like the digits of a number,
+ * the ORs further down the pre-order being the lower digits.
+ *
+ * @param connectors   the connectors of the disjunct
+ * @return             false if there are no more disjuncts
  */
-void LGDictExpContainer::basic_flatten()
+bool LGDictExpContainer::DisjunctIterator::next(std::vector<size_t>& connectors)
 {
-    std::vector<LGDictExpContainer> new_subexps;
-
-    // do not need this level if only one sub-expression
-    if (m_subexps.size() == 1)
+    while (not m_done)
     {
-        m_type = m_subexps[0].m_type;
-
-        if (m_type == CONNECTOR_type)
-        {
-            m_string = m_subexps[0].m_string;
-            m_direction = m_subexps[0].m_direction;
-            m_multi = m_subexps[0].m_multi;
-        }
-        else
+        if (m_started and not advance())
         {
-            m_subexps = m_subexps[0].m_subexps;
+            m_done = true;
+            break;
         }
+        m_started = true;
 
-        return;
-    }
+        connectors.clear();
+        m_ors.clear();
 
-    for (LGDictExpContainer& exp : m_subexps)
-    {
-        // cannot merge diffenent type
-        if (m_type != exp.m_type)
-        {
-            new_subexps.push_back(exp);
-            continue;
-        }
+        // An OR without any branches; none of the choices of the
+        // lower digits give a disjunct.
+        if (not collect(0, connectors)) continue;
+
+        // Normal order: - before +, otherwise in the order given
+        std::stable_partition(connectors.begin(), connectors.end(),
+            [this](size_t c)
+            { return m_exp.m_connectors[c].direction == '-'; });
 
-        // bring things up a level, assuming the sub-level is already flat
-        for (LGDictExpContainer& subexp : exp.m_subexps)
-            new_subexps.push_back(subexp);
+        return true;
     }
 
-    m_subexps = new_subexps;
+    return false;
 }
 
 /**
- * Construct disjunctive normal form.
- *
- * Convert the expression into DNF form (ie. a disjuction of
- * conjunctions of connectors).
+ * Collect the connectors under a node, for the current choices.
  *
- * Connectors are OR-distributive but not AND-distributive. Thus, while
- * (A & (B or C)) = ((A & B) or (A & C)), it is NOT the case that
- * (A or (B & C)) = ((A or B) & (A or C)).
+ * @return  false if an OR without any branches was met
  */
-void LGDictExpContainer::basic_dnf()
+bool LGDictExpContainer::DisjunctIterator::collect(size_t n,
+                                         std::vector<size_t>& connectors)
 {
-    std::vector<LGDictExpContainer> new_subexps(m_subexps);
+    const ExpNode& node = m_exp.m_nodes[n];
 
-    // assuming sub-level already in dnf, then OR can just be returned
-    if (m_type == OR_type)
-        return;
+    if (CONNECTOR_type == node.type)
+    {
+        connectors.push_back(node.first);
+        return true;
+    }
 
-    // find the first OR to distribute
-    auto or_exp_it = std::find_if(new_subexps.begin(),
-                                  new_subexps.end(),
-           [](LGDictExpContainer& exp) { return exp.m_type == OR_type; });
+    if (OR_type == node.type)
+    {
+        if (0 == node.count) return false;
 
-    // no OR, the end
-    if (or_exp_it == new_subexps.end())
-        return;
+        m_ors.push_back(n);
+        return collect(m_exp.m_children[node.first + m_choices[n]],
+                       connectors);
+    }
 
-    // copy the OR exp out, then remove it from the list
-    LGDictExpContainer or_exp = *or_exp_it;
-    new_subexps.erase(or_exp_it);
+    for (size_t i = 0; i < node.count; i++)
+        if (not collect(m_exp.m_children[node.first + i], connectors))
+            return false;
 
-    // Change the type of this container to OR, and distribute
-    // the stuff in or_exp
-    m_type = OR_type;
-    m_subexps.clear();
+    return true;
+}
 
-    for (auto& e : or_exp.m_subexps)
+/**
+ * Move on to the next choice of branches.  The branches of the ORs
+ * that come after the one changed are reset, whether or not they are
+ * still on the path; the ones off the path are kept at zero.
+ *
+ * @return  false if all the choices have been made
+ */
+bool LGDictExpContainer::DisjunctIterator::advance()
+{
+    for (auto it = m_ors.rbegin(); it != m_ors.rend(); it++)
     {
-        // don't bother distributing the optional connector, just clone
-        if (e.m_type == CONNECTOR_type && e.m_string == "OPTIONAL")
+        size_t o = *it;
+        if (m_choices[o] + 1 < m_exp.m_nodes[o].count)
         {
-            m_subexps.push_back(LGDictExpContainer(AND_type, new_subexps));
-            continue;
+            m_choices[o]++;
+            std::fill(m_choices.begin() + o + 1, m_choices.end(), 0);
+            return true;
         }
-
-        new_subexps.push_back(e);
-        m_subexps.push_back(LGDictExpContainer(AND_type, new_subexps));
-        new_subexps.pop_back();
     }
+
+    return false;
 }
 
+// -------------------------------------------------------------------
+
 /**
- * Convert to normal order.
+ * Create the OpenCog atom for a connector.
  *
- * Putting connectors with - direction before those with + direction.
- * Assume everything already in DNF.
+ * @param i    the index of the connector
+ * @return     handle to the LgConnector
  */
-void LGDictExpContainer::basic_normal_order()
+Handle LGDictExpContainer::connector_to_handle(size_t i) const
 {
-    // do nothing for OR
-    if (m_type == OR_type)
-        return;
+    static Handle multi(createNode(LG_CONN_MULTI_NODE, "@"));
 
-    std::vector<LGDictExpContainer> new_leftexps;
-    std::vector<LGDictExpContainer> new_rightexps;
+    const Connector& c = m_connectors[i];
 
-    for (auto& exp : m_subexps)
-    {
-        if (exp.m_direction == '-')
-            new_leftexps.push_back(exp);
-        else
-            new_rightexps.push_back(exp);
-    }
+    Handle connector(createNode(LG_CONNECTOR_NODE,
+                                std::move(std::string(c.name))));
+    Handle direction(createNode(LG_CONN_DIR_NODE,
+                      std::move(std::string(1, c.direction))));
 
-    m_subexps = new_leftexps;
-    m_subexps.insert(m_subexps.end(),
-                     new_rightexps.begin(),
-                     new_rightexps.end());
+    if (c.multi)
+        return Handle(createLink(LG_CONNECTOR, connector, direction, multi));
+    else
+        return Handle(createLink(LG_CONNECTOR, connector, direction));
 }
 
 /**
- * Create the OpenCog atom for the LG dictionary expression.
+ * Create the OpenCog atoms for the disjuncts of the LG dictionary
+ * expression.  Disjuncts that the expression has more than once are
+ * only created once.
  *
- * @param as   pointer to the AtomSpace
- * @return     handle to the atom
+ * @param hWordNode   the word the expression belongs to
+ * @return            the LgDisjuncts
  */
-HandleSeq LGDictExpContainer::to_handle(const Handle& hWordNode)
+HandleSeq LGDictExpContainer::to_handle(const Handle& hWordNode) const
 {
-    static Handle multi(createNode(LG_CONN_MULTI_NODE, "@"));
-    static Handle optnl(createLink(LG_CONNECTOR,
-                           Handle(createNode(LG_CONNECTOR_NODE, "0"))));
-
-    if (m_type == CONNECTOR_type)
-    {
-        // XXX FIXME this does not smell right; optionals should get
-        // blown up into pairs of disjuncts, one with and one without.
-        if (m_string == "OPTIONAL") return { optnl };
+    HandleSeq connectors;
+    for (size_t i = 0; i < m_connectors.size(); i++)
+        connectors.push_back(connector_to_handle(i));
 
-        Handle connector(createNode(LG_CONNECTOR_NODE,
-                                    std::move(std::string(m_string))));
-        Handle direction(createNode(LG_CONN_DIR_NODE,
-                          std::move(std::string(1, m_direction))));
+    std::set<std::vector<size_t>> seen;
+    HandleSeq qDisjuncts;
 
-        if (m_multi)
-            return { Handle(createLink(LG_CONNECTOR, connector, direction, multi)) };
-        else
-            return { Handle(createLink(LG_CONNECTOR, connector, direction)) };
-    }
-
-    HandleSeq outgoing;
-
-    for (auto& exp: m_subexps)
+    std::vector<size_t> dj;
+    DisjunctIterator it(disjuncts());
+    while (it.next(dj))
     {
-        HandleSeq q = exp.to_handle(hWordNode);
-        outgoing.insert(outgoing.end(), q.begin(), q.end());
-    }
+        if (not seen.insert(dj).second) continue;
 
-    if (m_type == AND_type)
-        return { Handle(createLink(std::move(outgoing), LG_AND)) };
+        Handle conj;
+        if (1 == dj.size())
+            conj = connectors[dj[0]];
+        else
+        {
+            HandleSeq outgoing;
+            for (size_t c : dj)
+                outgoing.push_back(connectors[c]);
+            conj = createLink(std::move(outgoing), LG_AND);
+        }
 
-    // remove repeated atoms from OR
-    if (m_type == OR_type)
-    {
-        // XXX FIXME ... using an std::map would be more efficient.
-        std::sort(outgoing.begin(), outgoing.end());
-        outgoing.erase(std::unique(outgoing.begin(),
-                                   outgoing.end()),
-                                   outgoing.end());
-        HandleSeq qDisjuncts;
-        for (const Handle& h : outgoing)
-            qDisjuncts.push_back(Handle(createLink(LG_DISJUNCT, hWordNode, h)));
-
-        return qDisjuncts;
+        qDisjuncts.push_back(Handle(createLink(LG_DISJUNCT, hWordNode, conj)));
     }
 
-    // Should never get here
-    OC_ASSERT(false, "Unknown Link Grammar Expression type %d", m_type);
-    return HandleSeq();
+    return qDisjuncts;
 }
@@ -24,6 +24,10 @@
 #ifndef _OPENCOG_LG_DICT_EXP_H
 #define _OPENCOG_LG_DICT_EXP_H
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <link-grammar/dict-api.h>
 
 #include <opencog/atomspace/AtomSpace.h>
@@ -35,28 +39,73 @@ namespace opencog
 /**
  * Link Grammar expression container.
  *
- * A helper class for doing operations on LG expression.
+ * A helper class for doing operations on LG expression.  The tree of
+ * the expression is copied into flat arrays, in pre-order, with each
+ * distinct connector stored once.  Its disjunctive normal form is not
+ * built: the disjuncts are enumerated one at a time, by picking one
+ * branch of each OR, so that a word with thousands of disjuncts costs
+ * no more memory than its expression.
  */
 class LGDictExpContainer
 {
 public:
-    LGDictExpContainer(Exp_type, Exp* exp);
-    LGDictExpContainer(Exp_type, const std::vector<LGDictExpContainer>&);
+    struct Connector
+    {
+        std::string name;
+        char direction;
+        bool multi;
+    };
 
-    HandleSeq to_handle(const Handle& h);
+    /**
+     * Enumerates the disjuncts of an expression.  Each disjunct is
+     * given as the indexes of its connectors, in normal order (the -
+     * connectors before the + ones).  The same disjunct may be given
+     * more than once, if the expression has it more than once.
+     */
+    class DisjunctIterator
+    {
+    public:
+        DisjunctIterator(const LGDictExpContainer&);
 
-private:
-    void basic_flatten();
-    void basic_dnf();
-    void basic_normal_order();
+        bool next(std::vector<size_t>& connectors);
+
+    private:
+        bool collect(size_t, std::vector<size_t>&);
+        bool advance();
+
+        const LGDictExpContainer& m_exp;
+        bool m_started;
+        bool m_done;
+
+        // The branch taken by each OR, and the ORs on the path of the
+        // last disjunct, in pre-order.
+        std::vector<size_t> m_choices;
+        std::vector<size_t> m_ors;
+    };
 
-    Exp_type m_type;
+    LGDictExpContainer(Exp* exp);
+
+    size_t num_connectors() const { return m_connectors.size(); }
+    const Connector& get_connector(size_t i) const { return m_connectors[i]; }
+    DisjunctIterator disjuncts() const { return DisjunctIterator(*this); }
+
+    Handle connector_to_handle(size_t) const;
+    HandleSeq to_handle(const Handle& h) const;
+
+private:
+    size_t add_exp(Exp*, std::unordered_map<std::string, size_t>&);
+    size_t add_connector(Exp*, std::unordered_map<std::string, size_t>&);
 
-    std::string m_string;
-    char m_direction;
-    bool m_multi;
+    struct ExpNode
+    {
+        Exp_type type;
+        size_t first;       // first child in m_children, or connector
+        size_t count;       // no. of children
+    };
 
-    std::vector<LGDictExpContainer> m_subexps;
+    std::vector<ExpNode> m_nodes;
+    std::vector<size_t> m_children;
+    std::vector<Connector> m_connectors;
 };
 
 }
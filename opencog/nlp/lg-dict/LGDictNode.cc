@@ -24,10 +24,14 @@
 
 #include <link-grammar/link-includes.h>
 #include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/Link.h>
 #include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
 #include <opencog/nlp/types/atom_types.h>
 
 #include "LGDictNode.h"
+#include "LGDictReader.h"
+#include "LGDictUtils.h"
 
 using namespace opencog;
 
@@ -47,7 +51,8 @@ void error_handler(lg_errinfo *ei, void *data)
 // ------------------------------------------------------
 
 LgDictNode::LgDictNode(const std::string&& name)
-	: Node(LG_DICT_NODE, std::move(name)), _dict(nullptr)
+	: Node(LG_DICT_NODE, std::move(name)), _dict(nullptr),
+	  _max_entries(DEFAULT_ENTRY_CACHE)
 {
 }
 
@@ -81,6 +86,143 @@ Dictionary LgDictNode::get_dictionary()
 	return _dict;
 }
 
+/// Get the LgConnector for a connector, as it's spelt in disjunct
+/// strings: an optional "@" for multi-connectors, the connector name,
+/// and the direction, e.g.
+///
+///    LgConnector
+///        LgConnectorNode "MX"
+///        LgConnDirNode "+"
+///        LgConnMultiNode "@"
+///
+/// The atoms are made the first time a connector is seen, and shared
+/// after that.
+Handle LgDictNode::get_connector(const std::string& spelling)
+{
+	std::lock_guard<std::mutex> lck(_conn_mtx);
+
+	auto it = _connectors.find(spelling);
+	if (it != _connectors.end()) return it->second;
+
+	bool multi = ('@' == spelling[0]);
+	size_t start = multi ? 1 : 0;
+	size_t len = spelling.size() - start - 1;
+
+	HandleSeq cono;
+	cono.push_back(createNode(LG_CONNECTOR_NODE, spelling.substr(start, len)));
+	cono.push_back(createNode(LG_CONN_DIR_NODE, spelling.substr(start + len)));
+	if (multi)
+		cono.push_back(createNode(LG_CONN_MULTI_NODE, "@"));
+
+	Handle conl(createLink(std::move(cono), LG_CONNECTOR));
+	_connectors.emplace(spelling, conl);
+
+	// Compile it now, for matching it against others.
+	nlp::lg_conn_signature(conl);
+	return conl;
+}
+
+/// Get the disjuncts of the dictionary entry of a word.  Expanding an
+/// entry into disjuncts is costly, and the same words are looked up
+/// again and again (e.g. by SuReal), so the disjuncts of the last
+/// words looked up are remembered.  Two threads asking for the same
+/// new word may both expand it; only the first result is kept.
+HandleSeq LgDictNode::get_dict_entry(const std::string& word)
+{
+	{
+		std::lock_guard<std::mutex> lck(_entry_mtx);
+		auto it = _entries.find(word);
+		if (it != _entries.end()) return it->second;
+	}
+
+	HandleSeq djs;
+	LGDisjunctStorePtr store = get_disjunct_store();
+	if (store and store->have_word(word))
+		djs = store->get_dict_entry(word);
+	else
+	{
+		Dictionary dict = get_dictionary();
+		if (nullptr == dict) return HandleSeq();
+		djs = getDictEntry(dict, word);
+	}
+
+	std::lock_guard<std::mutex> lck(_entry_mtx);
+	if (0 == _max_entries) return djs;
+	if (not _entries.emplace(word, djs).second) return djs;
+
+	_entry_order.push_back(word);
+	if (_entries.size() > _max_entries)
+	{
+		_entries.erase(_entry_order.front());
+		_entry_order.pop_front();
+	}
+	return djs;
+}
+
+void LgDictNode::set_entry_cache(size_t max_entries)
+{
+	std::lock_guard<std::mutex> lck(_entry_mtx);
+	_max_entries = max_entries;
+	_entries.clear();
+	_entry_order.clear();
+}
+
+void LgDictNode::clear_entry_cache(void)
+{
+	std::lock_guard<std::mutex> lck(_entry_mtx);
+	_entries.clear();
+	_entry_order.clear();
+}
+
+/// Look the words up in a disjunct store, as written by
+/// lg-export-disjuncts, before looking them up in the dictionary.
+/// The store must have been written from the same dictionary, as a
+/// store with the disjuncts of another language would be believed.
+void LgDictNode::load_disjunct_store(const std::string& path)
+{
+	LGDisjunctStorePtr store;
+	if (not path.empty())
+	{
+		store = std::make_shared<const LGDisjunctStore>(path);
+		if (store->get_language() != get_name())
+			throw InvalidParamException(TRACE_INFO,
+				"LgDictNode: the disjunct store %s is for \"%s\", not \"%s\"",
+				path.c_str(), store->get_language().c_str(),
+				get_name().c_str());
+	}
+
+	{
+		std::lock_guard<std::mutex> lck(_conn_mtx);
+		_store = store;
+	}
+	clear_entry_cache();
+}
+
+LGDisjunctStorePtr LgDictNode::get_disjunct_store(void)
+{
+	std::lock_guard<std::mutex> lck(_conn_mtx);
+	return _store;
+}
+
+/// Keep the parses of the last max_entries phrases parsed with this
+/// dictionary, so that they can be placed in the atomspace again
+/// without parsing them again. Setting it drops the cached parses,
+/// and 0, the default, turns the cache off.
+void LgDictNode::set_parse_cache(size_t max_entries)
+{
+	std::lock_guard<std::mutex> lck(_conn_mtx);
+	if (0 == max_entries)
+		_parse_cache = nullptr;
+	else
+		_parse_cache = std::make_shared<LGParseCache>(max_entries);
+}
+
+LGParseCachePtr LgDictNode::get_parse_cache(void)
+{
+	std::lock_guard<std::mutex> lck(_conn_mtx);
+	return _parse_cache;
+}
+
 // ------------------------------------------------------
 // Factory stuff.
 
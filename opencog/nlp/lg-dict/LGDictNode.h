@@ -23,9 +23,14 @@
 #ifndef _OPENCOG_LG_DICT_NODE_H
 #define _OPENCOG_LG_DICT_NODE_H
 
+#include <list>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <link-grammar/dict-api.h>
 #include <opencog/atoms/base/Node.h>
+#include <opencog/nlp/lg-dict/LGDisjunctStore.h>
+#include <opencog/nlp/lg-dict/LGParseCache.h>
 
 namespace opencog
 {
@@ -38,12 +43,30 @@ namespace opencog
 /// external data source that certain subsystems need to access to
 /// obtain grammatical data.  The Node holds a pointer to the Link
 /// Grammar Dictionary itself, so that it can be directly accessed.
+///
+/// It also holds the LgConnector atoms of the connectors seen in the
+/// parses made with the dictionary, so that each connector is only
+/// converted to atomese once, and the disjuncts of the dictionary
+/// entries looked up with it, up to a bound; see set_entry_cache().
+/// Optionally, it holds a cache of the parses made with it; see
+/// set_parse_cache().
 
 class LgDictNode : public Node
 {
 protected:
 	Dictionary _dict;
 
+	std::mutex _conn_mtx;
+	std::unordered_map<std::string, Handle> _connectors;
+
+	LGParseCachePtr _parse_cache;
+
+	std::mutex _entry_mtx;
+	size_t _max_entries;
+	std::unordered_map<std::string, HandleSeq> _entries;
+	std::list<std::string> _entry_order;   // Oldest first
+	LGDisjunctStorePtr _store;
+
 public:
 	LgDictNode(const std::string&&);
 	LgDictNode(const LgDictNode&) = delete;
@@ -52,6 +75,32 @@ public:
 
 	Dictionary get_dictionary(void);
 
+	// The LgConnector for a connector as spelt by LG, e.g. "@MX+".
+	// The atom returned is not in any atomspace.
+	Handle get_connector(const std::string&);
+
+	// No. of words whose entries are remembered by default.
+	static const size_t DEFAULT_ENTRY_CACHE = 10000;
+
+	// The disjuncts of the dictionary entry of a word, as returned by
+	// getDictEntry().  The atoms returned are not in any atomspace.
+	HandleSeq get_dict_entry(const std::string&);
+
+	// Remember the entries of up to this many words; 0 turns the
+	// memo off.  Setting it, or clearing it, forgets all the entries;
+	// this must be done whenever the dictionary changes.
+	void set_entry_cache(size_t);
+	void clear_entry_cache(void);
+
+	// Serve the entries of the words in the given disjunct store from
+	// it; an empty path drops the store.
+	void load_disjunct_store(const std::string&);
+	LGDisjunctStorePtr get_disjunct_store(void);
+
+	// Cache up to this many parsed phrases; 0 drops the cache.
+	void set_parse_cache(size_t);
+	LGParseCachePtr get_parse_cache(void);
+
 	static Handle factory(const Handle&);
 };
 
@@ -30,41 +30,6 @@
 
 using namespace opencog;
 
-/**
- * Helper function for storing LG expression trees in custom container.
- *
- * @param exp   the input expression trees
- * @return      the flatten container
- */
-static LGDictExpContainer lg_exp_to_container(Exp* exp)
-{
-    if (CONNECTOR_type == exp->type)
-        return LGDictExpContainer(CONNECTOR_type, exp);
-
-    std::vector<LGDictExpContainer> subcontainers;
-
-    // FIXME XXX -- Optionals are handled incorrectly here;
-    // they are denoted by a null Exp pointer in an OR_list!
-    // Ignoring all the nulls is just ... wrong.
-#if (LINK_MAJOR_VERSION == 5) &&  (LINK_MINOR_VERSION < 7)
-    E_list* el = exp->u.l;
-    while (el)
-    {
-        subcontainers.push_back(lg_exp_to_container(el->e));
-        el = el->next;
-    }
-#else
-    Exp* subexp = lg_exp_operand_first(exp);
-    while (subexp)
-    {
-        subcontainers.push_back(lg_exp_to_container(subexp));
-        subexp = lg_exp_operand_next(subexp);
-    }
-#endif
-
-    return LGDictExpContainer(exp->type, subcontainers);
-}
-
 /**
  * Function to return LG dictionary entries.
  *
@@ -110,8 +75,7 @@ HandleSeq opencog::getDictEntry(Dictionary _dictionary,
 
     for (Dict_node* dn = dn_head; dn; dn = dn->right)
     {
-        Exp* exp = dn->exp;
-        HandleSeq qLG = lg_exp_to_container(exp).to_handle(hWord);
+        HandleSeq qLG = LGDictExpContainer(dn->exp).to_handle(hWord);
 
         outgoing.insert(outgoing.end(), qLG.begin(), qLG.end());
     }
@@ -120,6 +84,40 @@ HandleSeq opencog::getDictEntry(Dictionary _dictionary,
     return outgoing;
 }
 
+void opencog::forEachDictDisjunct(Dictionary _dictionary,
+                                  const std::string& word,
+                    const std::function<bool(const HandleSeq&)>& cb)
+{
+    Dict_node* dn_head = dictionary_lookup_list(_dictionary, word.c_str());
+    if (!dn_head) return;
+
+    for (Dict_node* dn = dn_head; dn; dn = dn->right)
+    {
+        LGDictExpContainer exp(dn->exp);
+        HandleSeq connectors;
+        std::vector<size_t> dj;
+
+        bool more = true;
+        LGDictExpContainer::DisjunctIterator it(exp.disjuncts());
+        while (more and it.next(dj))
+        {
+            // Make the connectors as they are first needed.
+            HandleSeq conns;
+            for (size_t c : dj)
+            {
+                if (connectors.size() <= c) connectors.resize(c + 1);
+                if (nullptr == connectors[c])
+                    connectors[c] = exp.connector_to_handle(c);
+                conns.push_back(connectors[c]);
+            }
+            more = cb(conns);
+        }
+        if (not more) break;
+    }
+
+    free_lookup_list(_dictionary, dn_head);
+}
+
 bool opencog::haveDictEntry(Dictionary _dictionary,
                             const std::string& word)
 {
@@ -24,6 +24,7 @@
 #ifndef _OPENCOG_LG_DICT_READER_H
 #define _OPENCOG_LG_DICT_READER_H
 
+#include <functional>
 #include <link-grammar/dict-api.h>
 #include "LGDictExpContainer.h"
 
@@ -37,6 +38,16 @@ namespace opencog
  */
 HandleSeq getDictEntry(Dictionary, const std::string& word);
 
+/**
+ * Link Grammar dictionary entry reader.
+ *
+ * Call the callback with the LgConnectors of each disjunct for the
+ * word, one disjunct at a time, until it returns false.  The disjuncts
+ * are not all made at once, nor are their LgDisjunct atoms made.
+ */
+void forEachDictDisjunct(Dictionary, const std::string& word,
+                         const std::function<bool(const HandleSeq&)>&);
+
 /**
  * Link Grammar dictionary entry reader.
  *
@@ -21,9 +21,13 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <string>
+
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/guile/SchemePrimitive.h>
 
+#include "LGDictNode.h"
+#include "LGParseStats.h"
 #include "LGDictReader.h"
 #include "LGDictUtils.h"
 
@@ -38,6 +42,12 @@ private:
 
     bool do_lg_conn_type_match(Handle, Handle);
     bool do_lg_conn_linkable(Handle, Handle);
+    void do_lg_parse_cache(Handle, int);
+    std::string do_lg_parse_cache_stats(Handle);
+    void do_lg_dict_entry_cache(Handle, int);
+    void do_lg_dict_load_disjuncts(Handle, const std::string&);
+    std::string do_lg_parse_stats(void);
+    void do_lg_parse_stats_reset(void);
 
 public:
     LGDictSCM();
@@ -94,6 +104,18 @@ void LGDictSCM::init()
 		 &LGDictSCM::do_lg_conn_type_match, this, "nlp lg-dict");
 	define_scheme_primitive("lg-conn-linkable?",
 		 &LGDictSCM::do_lg_conn_linkable, this, "nlp lg-dict");
+	define_scheme_primitive("lg-parse-cache",
+		 &LGDictSCM::do_lg_parse_cache, this, "nlp lg-dict");
+	define_scheme_primitive("lg-parse-cache-stats-string",
+		 &LGDictSCM::do_lg_parse_cache_stats, this, "nlp lg-dict");
+	define_scheme_primitive("lg-dict-entry-cache",
+		 &LGDictSCM::do_lg_dict_entry_cache, this, "nlp lg-dict");
+	define_scheme_primitive("lg-dict-load-disjuncts",
+		 &LGDictSCM::do_lg_dict_load_disjuncts, this, "nlp lg-dict");
+	define_scheme_primitive("lg-parse-stats-string",
+		 &LGDictSCM::do_lg_parse_stats, this, "nlp lg-dict");
+	define_scheme_primitive("lg-parse-stats-reset",
+		 &LGDictSCM::do_lg_parse_stats_reset, this, "nlp lg-dict");
 }
 
 /**
@@ -120,6 +142,90 @@ bool LGDictSCM::do_lg_conn_linkable(Handle h1, Handle h2)
 	return lg_conn_linkable(h1, h2);
 }
 
+/**
+ * Implementation of the "lg-parse-cache" scheme primitive.
+ *
+ * @param h     the LgDictNode
+ * @param n     the no. of phrases to cache the parses of; 0 for none
+ */
+void LGDictSCM::do_lg_parse_cache(Handle h, int n)
+{
+	LgDictNodePtr ldn(LgDictNodeCast(h));
+	if (nullptr == ldn)
+		throw InvalidParamException(TRACE_INFO,
+			"lg-parse-cache: Expecting LgDictNode, got %s",
+			h->to_string().c_str());
+
+	ldn->set_parse_cache(0 < n ? n : 0);
+}
+
+/**
+ * Implementation of the "lg-parse-cache-stats-string" scheme primitive.
+ *
+ * @param h     the LgDictNode
+ * @return      an association list of the cache hits, misses and size
+ */
+std::string LGDictSCM::do_lg_parse_cache_stats(Handle h)
+{
+	LgDictNodePtr ldn(LgDictNodeCast(h));
+	LGParseCachePtr cache = (ldn ? ldn->get_parse_cache() : nullptr);
+	if (nullptr == cache) return "()";
+
+	return "((hits . " + std::to_string(cache->hits()) + ")"
+		" (misses . " + std::to_string(cache->misses()) + ")"
+		" (size . " + std::to_string(cache->size()) + "))";
+}
+
+/**
+ * Implementation of the "lg-dict-entry-cache" scheme primitive.
+ *
+ * @param h     the LgDictNode
+ * @param n     the no. of words to remember the entries of; 0 for none
+ */
+void LGDictSCM::do_lg_dict_entry_cache(Handle h, int n)
+{
+	LgDictNodePtr ldn(LgDictNodeCast(h));
+	if (nullptr == ldn)
+		throw InvalidParamException(TRACE_INFO,
+			"lg-dict-entry-cache: Expecting LgDictNode, got %s",
+			h->to_string().c_str());
+
+	ldn->set_entry_cache(0 < n ? n : 0);
+}
+
+/**
+ * Implementation of the "lg-dict-load-disjuncts" scheme primitive.
+ *
+ * @param h     the LgDictNode
+ * @param path  the disjunct store file; empty to drop the store
+ */
+void LGDictSCM::do_lg_dict_load_disjuncts(Handle h, const std::string& path)
+{
+	LgDictNodePtr ldn(LgDictNodeCast(h));
+	if (nullptr == ldn)
+		throw InvalidParamException(TRACE_INFO,
+			"lg-dict-load-disjuncts: Expecting LgDictNode, got %s",
+			h->to_string().c_str());
+
+	ldn->load_disjunct_store(path);
+}
+
+/**
+ * Implementation of the "lg-parse-stats-string" scheme primitive.
+ *
+ * @return      an association list of the counts and histograms of
+ *              all the parses made so far
+ */
+std::string LGDictSCM::do_lg_parse_stats(void)
+{
+	return LGParseStats::instance().to_string();
+}
+
+void LGDictSCM::do_lg_parse_stats_reset(void)
+{
+	LGParseStats::instance().reset();
+}
+
 extern "C" {
 void opencog_nlp_lgdict_init(void)
 {
@@ -21,6 +21,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
@@ -37,22 +41,85 @@ namespace opencog
 namespace nlp
 {
 
-Handle lg_conn_get_type(const Handle& hConn)
+/**
+ * Compile a connector.  The name is split into the head/tail mark, if
+ * it starts with a lower-case letter, the upper-case part, and the
+ * subscript; only the first 8 characters of the subscript are kept,
+ * which is more than LG dictionaries use.
+ *
+ * @param hConn   the LGConnector
+ * @return        its signature; the type is 0 if it's not a connector
+ */
+LGConnSignature lg_conn_compile(const Handle& hConn)
 {
-    return hConn->getOutgoingSet()[0];
+    // The type ids of upper-case parts, for the whole process.
+    static std::mutex mtx;
+    static std::unordered_map<std::string, uint32_t> type_ids;
+
+    LGConnSignature sig = {0, 0, 0, 0, 0, 0, 0};
+    if (hConn->get_type() != LG_CONNECTOR)
+        return sig;
+
+    const HandleSeq& oset = hConn->getOutgoingSet();
+    const std::string& name = oset[0]->get_name();
+    size_t i = 0;
+
+    if (i < name.size() and islower((int) name[i]))
+        sig.head = name[i++];
+
+    size_t start = i;
+    while (i < name.size() and isupper((int) name[i])) i++;
+    std::string upper(name, start, i - start);
+
+    for (size_t b = 0; i < name.size() and b < 8; i++, b++)
+    {
+        uint64_t byte = uint64_t(0xff) << (8 * b);
+        sig.sub |= uint64_t((unsigned char) name[i]) << (8 * b);
+        sig.sub_mask |= byte;
+        if ('*' == name[i]) sig.wild_mask |= byte;
+    }
+
+    if (1 < oset.size())
+        sig.dir = oset[1]->get_name()[0];
+    sig.multi = (2 < oset.size());
+
+    std::lock_guard<std::mutex> lck(mtx);
+    auto it = type_ids.find(upper);
+    if (it == type_ids.end())
+        it = type_ids.emplace(upper, type_ids.size() + 1).first;
+    sig.type = it->second;
+
+    return sig;
 }
 
-Handle lg_conn_get_dir(const Handle& hConn)
+/**
+ * Get the signature of a connector, compiling it the first time it is
+ * asked for.  The signatures are kept for the whole process; there are
+ * only so many different connectors.
+ *
+ * @param hConn   the LGConnector
+ * @return        its signature
+ */
+const LGConnSignature& lg_conn_signature(const Handle& hConn)
 {
-    return hConn->getOutgoingSet()[1];
+    static std::mutex mtx;
+    static std::unordered_map<Handle, LGConnSignature> sigs;
+
+    {
+        std::lock_guard<std::mutex> lck(mtx);
+        auto it = sigs.find(hConn);
+        if (it != sigs.end()) return it->second;
+    }
+
+    LGConnSignature sig = lg_conn_compile(hConn);
+
+    // References into an unordered_map stay valid as it grows.
+    std::lock_guard<std::mutex> lck(mtx);
+    return sigs.emplace(hConn, sig).first->second;
 }
 
 /**
  * Check if two connectors' type matches.
-
-XXX FIXME -- this currently fails to correctly handle the head-tail
-indicators on link types.  Perhaps it would be better to just call
-the same matchinng routines the link-grammar uses?
  *
  * @param hConn1   the first LGConnector
  * @param hConn2   the second LGConnector
@@ -60,45 +127,8 @@ the same matchinng routines the link-grammar uses?
  */
 bool lg_conn_type_match(const Handle& hConn1, const Handle& hConn2)
 {
-    if (hConn1->get_type() != LG_CONNECTOR or
-        hConn2->get_type() != LG_CONNECTOR)
-        return false;
-
-    // Convert the types to string
-    std::string type1 = lg_conn_get_type(hConn1)->get_name();
-    std::string type2 = lg_conn_get_type(hConn2)->get_name();
-    uint i1 = 0;
-    uint i2 = 0;
-
-    // check header
-    if (islower((int) type1[i1]))
-        i1++;
-    if (islower((int) type2[i2]))
-        i2++;
-
-    if (i1 > 0 && i2 > 0 && type1[0] == type2[0])
-        return false;
-
-    while (i1 < type1.length() and i2 < type2.length())
-    {
-        if (isupper((int) type1[i1]) or isupper((int) type2[i2]))
-        {
-            if (type1[i1] != type2[i2])
-                return false;
-
-            i1++;
-            i2++;
-            continue;
-        }
-
-        if (type1[i1] != '*' and type2[i2] != '*' and type1[i1] != type2[i2])
-            return false;
-
-        i1++;
-        i2++;
-    }
-
-    return true;
+    return lg_conn_type_match(lg_conn_signature(hConn1),
+                              lg_conn_signature(hConn2));
 }
 
 /**
@@ -113,8 +143,49 @@ bool lg_conn_type_match(const Handle& hConn1, const Handle& hConn2)
  */
 bool lg_conn_linkable(const Handle& hConn1, const Handle& hConn2)
 {
-    return lg_conn_type_match(hConn1, hConn2) and
-        lg_conn_get_dir(hConn1) != lg_conn_get_dir(hConn2);
+    return lg_conn_linkable(lg_conn_signature(hConn1),
+                            lg_conn_signature(hConn2));
+}
+
+void LGConnSignatureSeq::push_back(const LGConnSignature& sig)
+{
+    m_type.push_back(sig.type);
+    m_head.push_back(sig.head);
+    m_dir.push_back(sig.dir);
+    m_sub.push_back(sig.sub);
+    m_sub_mask.push_back(sig.sub_mask);
+    m_wild_mask.push_back(sig.wild_mask);
+}
+
+/**
+ * Check one connector against all of them, as lg_conn_linkable() does,
+ * without branches.
+ *
+ * @param c     the connector
+ * @param out   at least size() results
+ */
+void LGConnSignatureSeq::linkable(const LGConnSignature& c, uint8_t* out) const
+{
+    size_t n = m_type.size();
+    const uint32_t* type = m_type.data();
+    const uint8_t* head = m_head.data();
+    const uint8_t* dir = m_dir.data();
+    const uint64_t* sub = m_sub.data();
+    const uint64_t* sub_mask = m_sub_mask.data();
+    const uint64_t* wild_mask = m_wild_mask.data();
+
+    uint8_t has_type = (c.type != 0);
+    uint8_t has_head = (c.head != 0);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t care = c.sub_mask & sub_mask[i] & ~(c.wild_mask | wild_mask[i]);
+        out[i] = has_type &
+            (type[i] == c.type) &
+            (dir[i] != c.dir) &
+            ((has_head & (head[i] == c.head)) ^ 1) &
+            (0 == ((c.sub ^ sub[i]) & care));
+    }
 }
 
 }
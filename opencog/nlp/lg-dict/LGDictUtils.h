@@ -24,14 +24,82 @@
 #ifndef _OPENCOG_LG_DICT_UTILS_H
 #define _OPENCOG_LG_DICT_UTILS_H
 
+#include <cstdint>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
 namespace opencog
 {
 namespace nlp
 {
 
+/**
+ * A LG connector compiled for fast matching.  The upper-case part of
+ * the connector name is interned into an id, and up to 8 characters of
+ * the subscript are packed one per byte, with masks for the bytes that
+ * are used and for the '*' wildcards.
+ */
+struct LGConnSignature
+{
+    uint32_t type;       // id of the upper-case part; 0 if not a connector
+    uint8_t head;        // the lower-case head/tail mark, e.g. 'h', or 0
+    uint8_t dir;         // '+' or '-', or 0 if none
+    uint8_t multi;       // 1 for a multi-connector
+    uint64_t sub;
+    uint64_t sub_mask;
+    uint64_t wild_mask;
+};
+
+LGConnSignature lg_conn_compile(const Handle& hConn);
+const LGConnSignature& lg_conn_signature(const Handle& hConn);
+
+/**
+ * Check if two compiled connectors' types match: the upper-case parts
+ * are the same, the subscripts agree wherever both have a character
+ * that is not '*', and they do not both have the same head/tail mark.
+ */
+inline bool lg_conn_type_match(const LGConnSignature& c1,
+                               const LGConnSignature& c2)
+{
+    uint64_t care = c1.sub_mask & c2.sub_mask & ~(c1.wild_mask | c2.wild_mask);
+    return c1.type != 0 and c1.type == c2.type and
+        not (c1.head != 0 and c1.head == c2.head) and
+        0 == ((c1.sub ^ c2.sub) & care);
+}
+
+inline bool lg_conn_linkable(const LGConnSignature& c1,
+                             const LGConnSignature& c2)
+{
+    return lg_conn_type_match(c1, c2) and c1.dir != c2.dir;
+}
+
 bool lg_conn_type_match(const Handle& hConn1, const Handle& hConn2);
 bool lg_conn_linkable(const Handle& hConn1, const Handle& hConn2);
 
+/**
+ * Compiled connectors, stored field by field, so that one connector
+ * can be checked against all of them in a loop the compiler can
+ * vectorize.
+ */
+class LGConnSignatureSeq
+{
+public:
+    void push_back(const LGConnSignature&);
+    size_t size() const { return m_type.size(); }
+
+    // Set out[i] to 1 if c can link to the i-th connector, else to 0.
+    void linkable(const LGConnSignature& c, uint8_t* out) const;
+
+private:
+    std::vector<uint32_t> m_type;
+    std::vector<uint8_t> m_head;
+    std::vector<uint8_t> m_dir;
+    std::vector<uint64_t> m_sub;
+    std::vector<uint64_t> m_sub_mask;
+    std::vector<uint64_t> m_wild_mask;
+};
+
 }
 }
 
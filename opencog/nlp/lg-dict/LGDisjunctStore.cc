@@ -0,0 +1,380 @@
+/*
+ * opencog/nlp/lg-dict/LGDisjunctStore.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <set>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/nlp/types/atom_types.h>
+
+#include "LGDictExpContainer.h"
+#include "LGDisjunctStore.h"
+
+using namespace opencog;
+
+static const char MAGIC[8] = {'L', 'G', 'D', 'J', 'S', 'T', 'O', 'R'};
+
+struct LGDisjunctStore::Header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t lang;
+	uint32_t n_connectors;
+	uint32_t n_words;
+	uint32_t n_disjuncts;
+	uint32_t n_refs;
+	uint32_t strings_size;
+	uint32_t unused;
+};
+
+struct LGDisjunctStore::Connector
+{
+	uint32_t name;
+	uint8_t direction;
+	uint8_t multi;
+	uint8_t unused[2];
+};
+
+struct LGDisjunctStore::Word
+{
+	uint32_t name;
+	uint32_t first;
+	uint32_t count;
+};
+
+struct LGDisjunctStore::Disjunct
+{
+	uint32_t first;
+	uint32_t count;
+};
+
+// ------------------------------------------------------
+
+/// Count something going into the file, which must stay addressable
+/// with 32 bits.
+static uint32_t count32(size_t n, const std::string& path)
+{
+	if (n > std::numeric_limits<uint32_t>::max())
+		throw RuntimeException(TRACE_INFO,
+			"Too many disjuncts for the disjunct store %s", path.c_str());
+	return (uint32_t) n;
+}
+
+/// Expand the dictionary entries of the words, and write them to the
+/// file.  The disjuncts of each word are the ones getDictEntry() makes,
+/// in the same order.
+size_t LGDisjunctStore::write(Dictionary dict, const std::string& lang,
+                              const std::vector<std::string>& words,
+                              const std::string& path)
+{
+	std::vector<std::string> sorted(words);
+	std::sort(sorted.begin(), sorted.end());
+	sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+	std::string strings;
+	auto add_string = [&](const std::string& s)
+	{
+		uint32_t off = count32(strings.size(), path);
+		strings += s;
+		strings += '\0';
+		return off;
+	};
+
+	Header hdr;
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, MAGIC, sizeof(MAGIC));
+	hdr.version = VERSION;
+	hdr.lang = add_string(lang);
+
+	std::unordered_map<std::string, uint32_t> conn_ids;
+	std::vector<Connector> connectors;
+	std::vector<Word> wrds;
+	std::vector<Disjunct> disjuncts;
+	std::vector<uint32_t> refs;
+
+	for (const std::string& w : sorted)
+	{
+		Dict_node* dn_head = dictionary_lookup_list(dict, w.c_str());
+		if (nullptr == dn_head) continue;
+
+		Word wrd;
+		wrd.name = add_string(w);
+		wrd.first = count32(disjuncts.size(), path);
+
+		for (Dict_node* dn = dn_head; dn; dn = dn->right)
+		{
+			LGDictExpContainer exp(dn->exp);
+
+			// The ids of the connectors of the expression
+			std::vector<uint32_t> ids;
+			for (size_t i = 0; i < exp.num_connectors(); i++)
+			{
+				const LGDictExpContainer::Connector& c = exp.get_connector(i);
+				std::string spelling((c.multi ? "@" : "") + c.name + c.direction);
+
+				auto it = conn_ids.find(spelling);
+				if (it == conn_ids.end())
+				{
+					Connector con;
+					memset(&con, 0, sizeof(con));
+					con.name = add_string(c.name);
+					con.direction = c.direction;
+					con.multi = c.multi;
+
+					uint32_t id = count32(connectors.size(), path);
+					connectors.push_back(con);
+					it = conn_ids.emplace(spelling, id).first;
+				}
+				ids.push_back(it->second);
+			}
+
+			// Leave out the repeats, as to_handle() does.
+			std::set<std::vector<size_t>> seen;
+			std::vector<size_t> dj;
+			LGDictExpContainer::DisjunctIterator dit(exp.disjuncts());
+			while (dit.next(dj))
+			{
+				if (not seen.insert(dj).second) continue;
+
+				Disjunct d;
+				d.first = count32(refs.size(), path);
+				d.count = dj.size();
+				for (size_t c : dj)
+					refs.push_back(ids[c]);
+				disjuncts.push_back(d);
+			}
+		}
+		free_lookup_list(dict, dn_head);
+
+		wrd.count = disjuncts.size() - wrd.first;
+		wrds.push_back(wrd);
+	}
+
+	hdr.n_connectors = connectors.size();
+	hdr.n_words = wrds.size();
+	hdr.n_disjuncts = count32(disjuncts.size(), path);
+	hdr.n_refs = count32(refs.size(), path);
+	hdr.strings_size = count32(strings.size(), path);
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (not out)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot create the disjunct store %s", path.c_str());
+
+	out.write((const char*) &hdr, sizeof(hdr));
+	out.write((const char*) connectors.data(),
+	          connectors.size() * sizeof(Connector));
+	out.write((const char*) wrds.data(), wrds.size() * sizeof(Word));
+	out.write((const char*) disjuncts.data(),
+	          disjuncts.size() * sizeof(Disjunct));
+	out.write((const char*) refs.data(), refs.size() * sizeof(uint32_t));
+	out.write(strings.data(), strings.size());
+	out.close();
+
+	if (not out)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot write the disjunct store %s", path.c_str());
+
+	return wrds.size();
+}
+
+// ------------------------------------------------------
+
+/// Map the file into memory.  It is checked through, so that a bad
+/// file is refused here, rather than crashing the lookups.
+LGDisjunctStore::LGDisjunctStore(const std::string& path)
+	: _path(path), _map(nullptr), _map_size(0)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot open the disjunct store %s", path.c_str());
+
+	struct stat st;
+	if (0 == fstat(fd, &st) and sizeof(Header) <= (size_t) st.st_size)
+	{
+		_map_size = st.st_size;
+		_map = mmap(nullptr, _map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (MAP_FAILED == _map) _map = nullptr;
+	}
+	close(fd);
+
+	auto fail = [&](const char* why)
+	{
+		if (_map) munmap(_map, _map_size);
+		throw RuntimeException(TRACE_INFO,
+			"Bad disjunct store %s: %s", path.c_str(), why);
+	};
+
+	if (nullptr == _map) fail("cannot map it");
+
+	const char* base = (const char*) _map;
+	_header = (const Header*) base;
+	if (memcmp(_header->magic, MAGIC, sizeof(MAGIC)))
+		fail("not a disjunct store");
+	if (VERSION != _header->version)
+		fail("wrong version; write it again");
+
+	uint64_t size = sizeof(Header);
+	size += (uint64_t) _header->n_connectors * sizeof(Connector);
+	size += (uint64_t) _header->n_words * sizeof(Word);
+	size += (uint64_t) _header->n_disjuncts * sizeof(Disjunct);
+	size += (uint64_t) _header->n_refs * sizeof(uint32_t);
+	size += _header->strings_size;
+	if (size != _map_size) fail("truncated");
+
+	_connectors = (const Connector*) (base + sizeof(Header));
+	_words = (const Word*) (_connectors + _header->n_connectors);
+	_disjuncts = (const Disjunct*) (_words + _header->n_words);
+	_refs = (const uint32_t*) (_disjuncts + _header->n_disjuncts);
+	_strings = (const char*) (_refs + _header->n_refs);
+
+	uint32_t ssz = _header->strings_size;
+	if (0 == ssz or '\0' != _strings[ssz - 1] or _header->lang >= ssz)
+		fail("bad strings");
+
+	for (uint32_t i = 0; i < _header->n_connectors; i++)
+		if (_connectors[i].name >= ssz) fail("bad connector");
+
+	for (uint32_t i = 0; i < _header->n_words; i++)
+	{
+		const Word& w = _words[i];
+		if (w.name >= ssz or
+		    (uint64_t) w.first + w.count > _header->n_disjuncts)
+			fail("bad word");
+		if (0 < i and strcmp(_strings + _words[i-1].name,
+		                     _strings + w.name) >= 0)
+			fail("words out of order");
+	}
+
+	for (uint32_t i = 0; i < _header->n_disjuncts; i++)
+	{
+		const Disjunct& d = _disjuncts[i];
+		if ((uint64_t) d.first + d.count > _header->n_refs)
+			fail("bad disjunct");
+	}
+
+	for (uint32_t i = 0; i < _header->n_refs; i++)
+		if (_refs[i] >= _header->n_connectors) fail("bad connector id");
+
+	_lang = _strings + _header->lang;
+}
+
+LGDisjunctStore::~LGDisjunctStore()
+{
+	munmap(_map, _map_size);
+}
+
+size_t LGDisjunctStore::num_words(void) const
+{
+	return _header->n_words;
+}
+
+const LGDisjunctStore::Word* LGDisjunctStore::find_word(const std::string& word) const
+{
+	const Word* end = _words + _header->n_words;
+	const Word* w = std::lower_bound(_words, end, word.c_str(),
+		[this](const Word& wd, const char* s)
+		{ return strcmp(_strings + wd.name, s) < 0; });
+
+	if (w == end or strcmp(_strings + w->name, word.c_str())) return nullptr;
+	return w;
+}
+
+bool LGDisjunctStore::have_word(const std::string& word) const
+{
+	return nullptr != find_word(word);
+}
+
+bool LGDisjunctStore::foreach_disjunct(const std::string& word,
+	const std::function<bool(const uint32_t*, size_t)>& cb) const
+{
+	const Word* w = find_word(word);
+	if (nullptr == w) return false;
+
+	for (uint32_t i = w->first; i < w->first + w->count; i++)
+	{
+		const Disjunct& d = _disjuncts[i];
+		if (not cb(_refs + d.first, d.count)) break;
+	}
+	return true;
+}
+
+Handle LGDisjunctStore::get_connector(uint32_t id) const
+{
+	static Handle multi(createNode(LG_CONN_MULTI_NODE, "@"));
+
+	const Connector& c = _connectors[id];
+	Handle connector(createNode(LG_CONNECTOR_NODE,
+	                            std::string(_strings + c.name)));
+	Handle direction(createNode(LG_CONN_DIR_NODE,
+	                            std::string(1, (char) c.direction)));
+
+	if (c.multi)
+		return Handle(createLink(LG_CONNECTOR, connector, direction, multi));
+	return Handle(createLink(LG_CONNECTOR, connector, direction));
+}
+
+HandleSeq LGDisjunctStore::get_dict_entry(const std::string& word) const
+{
+	HandleSeq djs;
+	Handle hWord(createNode(WORD_NODE, std::string(word)));
+
+	// Each connector is made once for the word.
+	std::unordered_map<uint32_t, Handle> conns;
+	auto conn = [&](uint32_t id) -> const Handle&
+	{
+		Handle& h = conns[id];
+		if (nullptr == h) h = get_connector(id);
+		return h;
+	};
+
+	foreach_disjunct(word,
+		[&](const uint32_t* ids, size_t n)
+		{
+			Handle conj;
+			if (1 == n)
+				conj = conn(ids[0]);
+			else
+			{
+				HandleSeq outgoing;
+				for (size_t i = 0; i < n; i++)
+					outgoing.push_back(conn(ids[i]));
+				conj = createLink(std::move(outgoing), LG_AND);
+			}
+			djs.push_back(Handle(createLink(LG_DISJUNCT, hWord, conj)));
+			return true;
+		});
+
+	return djs;
+}
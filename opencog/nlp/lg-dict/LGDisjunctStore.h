@@ -0,0 +1,118 @@
+/*
+ * opencog/nlp/lg-dict/LGDisjunctStore.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_DISJUNCT_STORE_H
+#define _OPENCOG_LG_DISJUNCT_STORE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <link-grammar/dict-api.h>
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// The disjuncts of the words of a Link Grammar dictionary, expanded
+/// ahead of time and written to a file, which is then mapped into
+/// memory.  Looking words up in it needs neither the dictionary to be
+/// opened, nor any expansion of its expressions, so a freshly started
+/// process can serve them at once.
+///
+/// The file holds, in the native byte order:
+///
+///    a header, with the format version and the language
+///    the connectors, each stored once
+///    the words, in strcmp() order, each with its range of disjuncts
+///    the disjuncts, each with its range of connector ids
+///    the connector ids of the disjuncts, in normal order
+///    the strings, each ending with a nul
+///
+/// Files of any other version are refused; they must be written again.
+class LGDisjunctStore
+{
+public:
+	static const uint32_t VERSION = 1;
+
+	// Expand the entries of the words and write them to the file.
+	// Words not in the dictionary are left out.  Returns the number
+	// of words written.
+	static size_t write(Dictionary, const std::string& lang,
+	                    const std::vector<std::string>& words,
+	                    const std::string& path);
+
+	LGDisjunctStore(const std::string& path);
+	LGDisjunctStore(const LGDisjunctStore&) = delete;
+	LGDisjunctStore& operator=(const LGDisjunctStore&) = delete;
+	~LGDisjunctStore();
+
+	const std::string& get_language(void) const { return _lang; }
+	size_t num_words(void) const;
+	bool have_word(const std::string&) const;
+
+	// Call the callback with the connector ids of each disjunct of
+	// the word, until it returns false.  Returns false if the word
+	// is not in the store.
+	bool foreach_disjunct(const std::string&,
+		const std::function<bool(const uint32_t*, size_t)>&) const;
+
+	// The LgConnector of a connector id; not in any atomspace.
+	Handle get_connector(uint32_t) const;
+
+	// The LgDisjuncts of the word, as getDictEntry() makes them.
+	HandleSeq get_dict_entry(const std::string&) const;
+
+private:
+	struct Header;
+	struct Connector;
+	struct Word;
+	struct Disjunct;
+
+	const Word* find_word(const std::string&) const;
+
+	std::string _path;
+	std::string _lang;
+
+	void* _map;
+	size_t _map_size;
+
+	const Header* _header;
+	const Connector* _connectors;
+	const Word* _words;
+	const Disjunct* _disjuncts;
+	const uint32_t* _refs;
+	const char* _strings;
+};
+
+typedef std::shared_ptr<const LGDisjunctStore> LGDisjunctStorePtr;
+
+/** @}*/
+}
+
+#endif // _OPENCOG_LG_DISJUNCT_STORE_H
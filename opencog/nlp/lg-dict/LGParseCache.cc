@@ -0,0 +1,122 @@
+/*
+ * opencog/nlp/lg-dict/LGParseCache.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cctype>
+
+#include "LGParseCache.h"
+
+using namespace opencog;
+
+LGParseCache::LGParseCache(size_t max_entries)
+	: _max_entries(max_entries), _hits(0), _misses(0)
+{
+}
+
+/// The key of a phrase: the words separated by single blanks, and
+/// then the parse settings and policy.  Only the white space is normalized, as
+/// the parser does care about capitalization and punctuation.
+std::string LGParseCache::make_key(const std::string& phrase,
+                                   int max_linkages, bool minimal,
+                                   const std::string& policy)
+{
+	std::string key;
+	bool blank = false;
+	for (char c : phrase)
+	{
+		if (isspace((unsigned char) c))
+		{
+			blank = not key.empty();
+			continue;
+		}
+		if (blank) key += ' ';
+		blank = false;
+		key += c;
+	}
+
+	key += '\0';
+	key += std::to_string(max_linkages);
+	key += minimal ? "m" : "f";
+	key += policy;
+	return key;
+}
+
+/// Get the parses of a phrase, or nullptr if they are not cached.
+LGParsedSentencePtr LGParseCache::find(const std::string& phrase,
+                                       int max_linkages, bool minimal,
+                                       const std::string& policy)
+{
+	std::string key(make_key(phrase, max_linkages, minimal, policy));
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	auto it = _entries.find(key);
+	if (it == _entries.end())
+	{
+		_misses++;
+		return nullptr;
+	}
+
+	_hits++;
+	_lru.splice(_lru.begin(), _lru, it->second);
+	return it->second->second;
+}
+
+/// Remember the parses of a phrase.
+void LGParseCache::insert(const std::string& phrase, int max_linkages,
+                          bool minimal, const std::string& policy,
+                          LGParsedSentencePtr parses)
+{
+	if (0 == _max_entries) return;
+
+	std::string key(make_key(phrase, max_linkages, minimal, policy));
+
+	std::lock_guard<std::mutex> lck(_mtx);
+
+	// Another thread may have parsed it at the same time.
+	if (_entries.count(key)) return;
+
+	_lru.emplace_front(key, parses);
+	_entries[key] = _lru.begin();
+
+	if (_entries.size() > _max_entries)
+	{
+		_entries.erase(_lru.back().first);
+		_lru.pop_back();
+	}
+}
+
+size_t LGParseCache::hits(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _hits;
+}
+
+size_t LGParseCache::misses(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _misses;
+}
+
+size_t LGParseCache::size(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _entries.size();
+}
@@ -0,0 +1,115 @@
+/*
+ * opencog/nlp/lg-dict/LGParseCache.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_PARSE_CACHE_H
+#define _OPENCOG_LG_PARSE_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// A link of a linkage, between the words at lword and rword.
+struct LGParsedLink
+{
+	int lword;
+	int rword;
+	std::string label;
+	std::string llabel;
+	std::string rlabel;
+};
+
+/// What the LgParseLink takes from a Link Grammar linkage: the words,
+/// the disjunct strings of the words, and the links.  This is enough
+/// to place the linkage into the atomspace again, without the parser.
+struct LGParsedLinkage
+{
+	std::vector<std::string> words;
+	std::vector<std::string> disjuncts;
+	std::vector<LGParsedLink> links;
+};
+
+/// The linkages of a phrase, and how they were found: the tier of
+/// the parse policy that found them, whether null links had to be
+/// allowed, and how many linkages the parser had.
+struct LGParsedSentence
+{
+	std::vector<LGParsedLinkage> linkages;
+	int tier;
+	bool null_links;
+	int num_found;
+	int num_valid;
+	int num_post_processed;
+};
+
+typedef std::shared_ptr<const LGParsedSentence> LGParsedSentencePtr;
+
+/// A cache of the parses of the phrases seen by the LgParseLink, for
+/// one dictionary.  The phrases are looked up with their white space
+/// normalized, together with the number of linkages asked for,
+/// whether the parse is minimal, and the name of the parse policy.  When full, the least recently used
+/// phrase is dropped.
+class LGParseCache
+{
+public:
+	LGParseCache(size_t max_entries);
+
+	LGParsedSentencePtr find(const std::string&, int, bool,
+	                         const std::string&);
+	void insert(const std::string&, int, bool, const std::string&,
+	            LGParsedSentencePtr);
+
+	size_t hits(void);
+	size_t misses(void);
+	size_t size(void);
+
+private:
+	static std::string make_key(const std::string&, int, bool,
+	                            const std::string&);
+
+	typedef std::list<std::pair<std::string, LGParsedSentencePtr>> LRUList;
+
+	std::mutex _mtx;
+	size_t _max_entries;
+	size_t _hits;
+	size_t _misses;
+
+	// Most recently used first
+	LRUList _lru;
+	std::unordered_map<std::string, LRUList::iterator> _entries;
+};
+
+typedef std::shared_ptr<LGParseCache> LGParseCachePtr;
+
+/** @}*/
+}
+
+#endif // _OPENCOG_LG_PARSE_CACHE_H
@@ -0,0 +1,136 @@
+/*
+ * opencog/nlp/lg-dict/LGParseStats.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+
+#include "LGParseStats.h"
+
+using namespace opencog;
+
+std::vector<double> LGParseTelemetry::to_vector(void) const
+{
+	return {parse_time, convert_time,
+	        (double) num_found, (double) num_valid,
+	        (double) num_post_processed,
+	        null_links ? 1.0 : 0.0, cached ? 1.0 : 0.0,
+	        (double) tier, (double) atoms};
+}
+
+// ------------------------------------------------------
+
+void LGParseStats::Histogram::add(double v)
+{
+	size_t b = 0;
+	for (double top = 1.0; b < NBUCKETS-1 and top <= v; top *= 2.0) b++;
+	counts[b]++;
+	sum += v;
+}
+
+/// An entry of the association list, e.g. for a histogram named
+/// parse-ms, "(parse-ms (sum . 412.5) (1 . 3) (2 . 0) (4 . 7))"; the
+/// empty buckets after the last one used are left out.
+std::string LGParseStats::Histogram::to_string(const char* name) const
+{
+	size_t last = 0;
+	for (size_t b = 0; b < NBUCKETS; b++)
+		if (counts[b]) last = b + 1;
+
+	std::string str = std::string("(") + name +
+		" (sum . " + std::to_string(sum) + ")";
+	for (size_t b = 0; b < last; b++)
+		str += " (" + std::to_string(1UL << b) + " . " +
+			std::to_string(counts[b]) + ")";
+	return str + ")";
+}
+
+// ------------------------------------------------------
+
+LGParseStats& LGParseStats::instance(void)
+{
+	static LGParseStats stats;
+	return stats;
+}
+
+LGParseStats::LGParseStats(void)
+{
+	reset();
+}
+
+void LGParseStats::reset(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_parses = 0;
+	_failures = 0;
+	_null_links = 0;
+	_cached = 0;
+	_tiers.clear();
+
+	for (Histogram* h : {&_parse_ms, &_convert_ms, &_linkages, &_atoms})
+	{
+		memset(h->counts, 0, sizeof(h->counts));
+		h->sum = 0.0;
+	}
+}
+
+void LGParseStats::record(const LGParseTelemetry& t)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_parses++;
+	if (t.null_links) _null_links++;
+	if (t.cached) _cached++;
+
+	if (_tiers.size() <= (size_t) t.tier) _tiers.resize(t.tier + 1, 0);
+	_tiers[t.tier]++;
+
+	if (not t.cached) _parse_ms.add(1000.0 * t.parse_time);
+	_convert_ms.add(1000.0 * t.convert_time);
+	_linkages.add(t.num_found);
+	_atoms.add(t.atoms);
+}
+
+/// A phrase that did not parse, after the given time in the parser.
+void LGParseStats::record_failure(double parse_time)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_failures++;
+	_parse_ms.add(1000.0 * parse_time);
+}
+
+std::string LGParseStats::to_string(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+
+	std::string tiers = "(tiers";
+	for (size_t n : _tiers)
+		tiers += " " + std::to_string(n);
+	tiers += ")";
+
+	return "((parses . " + std::to_string(_parses) + ")"
+		" (failures . " + std::to_string(_failures) + ")"
+		" (null-links . " + std::to_string(_null_links) + ")"
+		" (cached . " + std::to_string(_cached) + ") " +
+		tiers + " " +
+		_parse_ms.to_string("parse-ms") + " " +
+		_convert_ms.to_string("convert-ms") + " " +
+		_linkages.to_string("linkages") + " " +
+		_atoms.to_string("atoms") + ")";
+}
@@ -0,0 +1,99 @@
+/*
+ * opencog/nlp/lg-dict/LGParseStats.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_PARSE_STATS_H
+#define _OPENCOG_LG_PARSE_STATS_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// What happened in one parse made by the LgParseLink.
+struct LGParseTelemetry
+{
+	double parse_time;       // seconds in the parser; 0 if cached
+	double convert_time;     // seconds placing the parses in the atomspace
+	int num_found;           // sentence_num_linkages_found()
+	int num_valid;           // sentence_num_valid_linkages()
+	int num_post_processed;  // sentence_num_linkages_post_processed()
+	bool null_links;         // the null-link retry was needed
+	bool cached;             // the parses came from the parse cache
+	int tier;                // the tier of the parse policy used
+	size_t atoms;            // growth of the atomspace
+
+	// In the order of the fields
+	std::vector<double> to_vector(void) const;
+};
+
+/// Counts and histograms of all the parses made in the process. The
+/// histograms have power-of-two buckets; the bucket of 2^i counts the
+/// values below 2^i that are not counted by a smaller bucket.
+class LGParseStats
+{
+public:
+	static LGParseStats& instance(void);
+
+	void record(const LGParseTelemetry&);
+	void record_failure(double parse_time);
+	void reset(void);
+
+	// As a scheme association list
+	std::string to_string(void);
+
+private:
+	static const size_t NBUCKETS = 24;
+
+	struct Histogram
+	{
+		size_t counts[NBUCKETS];
+		double sum;
+
+		void add(double);
+		std::string to_string(const char*) const;
+	};
+
+	LGParseStats(void);
+
+	std::mutex _mtx;
+	size_t _parses;
+	size_t _failures;
+	size_t _null_links;
+	size_t _cached;
+	std::vector<size_t> _tiers;
+
+	Histogram _parse_ms;
+	Histogram _convert_ms;
+	Histogram _linkages;
+	Histogram _atoms;
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_LG_PARSE_STATS_H
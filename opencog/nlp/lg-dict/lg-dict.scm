@@ -34,6 +34,78 @@
      standard Link Grammar connector matching rules.
 ")
 
+(export lg-parse-cache)
+(set-procedure-property! lg-parse-cache 'documentation
+"
+  lg-parse-cache DICT N
+     Cache the parses of the last N phrases parsed by LgParseLink with
+     the dictionary DICT, an LgDictNode. A cached phrase is placed in
+     the atomspace again, with new instances, without running the
+     parser. N of zero turns the cache off. The phrases are matched
+     with their white space normalized, and with the same number of
+     parses asked for.
+
+     As the cached parses are reused, this should not be used with
+     dictionaries parsed for random sampling, such as \"any\".
+")
+
+(export lg-dict-entry-cache)
+(set-procedure-property! lg-dict-entry-cache 'documentation
+"
+  lg-dict-entry-cache DICT N
+     Remember the disjuncts of the dictionary entries of the last N
+     words looked up in DICT, an LgDictNode, by LgDictEntry. By default,
+     10000 words are remembered; N of zero turns this off. Calling this
+     forgets all the remembered entries, so it should be called after
+     the dictionary has been changed.
+")
+
+(export lg-dict-load-disjuncts)
+(set-procedure-property! lg-dict-load-disjuncts 'documentation
+"
+  lg-dict-load-disjuncts DICT PATH
+     Look up the dictionary entries of words in the disjunct store at
+     PATH before looking them up in DICT, an LgDictNode. The store is
+     written from the same dictionary by the lg-export-disjuncts tool:
+
+        lg-export-disjuncts en words.txt en.disjuncts
+
+     The words in the store are served from it straight away, without
+     opening the dictionary. An empty PATH drops the store.
+")
+
+(define-public (lg-parse-cache-stats DICT)
+"
+  lg-parse-cache-stats DICT
+     Return an association list of the hits, misses and size of the
+     parse cache of DICT, an LgDictNode; see lg-parse-cache.
+"
+	(with-input-from-string (lg-parse-cache-stats-string DICT) read)
+)
+
+(define-public (lg-parse-stats)
+"
+  lg-parse-stats
+     Return an association list describing all the parses made by
+     LgParseLink so far: the number of parses, of failed parses, of
+     parses that needed null links, of parses taken from the parse
+     cache, and of parses found by each tier of the parse policy;
+     then histograms of the milliseconds spent in the parser and in
+     placing the parses in the atomspace, of the linkages found, and
+     of the atoms added. Each histogram gives its sum, and then the
+     count of values below each power of two. The parses of each
+     sentence are also described on its SentenceNode; see the README.
+"
+	(with-input-from-string (lg-parse-stats-string) read)
+)
+
+(export lg-parse-stats-reset)
+(set-procedure-property! lg-parse-stats-reset 'documentation
+"
+  lg-parse-stats-reset
+     Clear the counts and histograms given by lg-parse-stats.
+")
+
 ; ---------------------------------------------------------------------
 
 (define-public (lg-dict-entry WORD)
@@ -0,0 +1,185 @@
+/*
+ * opencog/nlp/lg-parse/LGParseFuture.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include <opencog/executor/Lane.h>
+#include <opencog/util/Config.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/util/Logger.h>
+#include "LGParseFuture.h"
+
+using namespace opencog;
+
+LGParseFuture::LGParseFuture(const LGParseLinkPtr& link, AtomSpace* as,
+                             double deadline)
+	: _link(link), _as(as), _has_deadline(0 < deadline), _cancel(false),
+	  _status(PENDING)
+{
+	if (_has_deadline)
+		_deadline = Clock::now() +
+			std::chrono::duration_cast<Clock::duration>(
+				std::chrono::duration<double>(deadline));
+}
+
+LGParseFuturePtr LGParseFuture::start(const Handle& h, AtomSpace* as,
+                                      double deadline)
+{
+	LGParseLinkPtr link(LGParseLinkCast(h));
+	if (nullptr == link)
+		throw InvalidParamException(TRACE_INFO,
+			"LGParseFuture: Expecting an LgParseLink, got %s",
+			h->to_string().c_str());
+
+	LGParseFuturePtr fut(new LGParseFuture(link, as, deadline));
+
+	// The lane holds on to the future until the parse is over; the
+	// result is taken from here, not from the std::future.
+	lane().submit([fut]() { fut->run(); });
+	return fut;
+}
+
+/// The parses have threads of their own, LG_PARSE_ASYNC_THREADS of
+/// them, as a parse may take as long as the budget of its policy, for
+/// which it would hold a worker of the Executor.
+Lane& LGParseFuture::lane(void)
+{
+	static Lane parses("lg-parse",
+		std::max(1, config().get_int("LG_PARSE_ASYNC_THREADS", 2)));
+	return parses;
+}
+
+void LGParseFuture::run(void)
+{
+	double budget = 0.0;
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		if (PENDING != _status) return;
+
+		if (_has_deadline)
+		{
+			std::chrono::duration<double> left = _deadline - Clock::now();
+			if (left.count() <= 0.0)
+			{
+				_status = EXPIRED;
+				_over.notify_all();
+				return;
+			}
+			budget = left.count();
+		}
+		_status = RUNNING;
+	}
+
+	try
+	{
+		Handle snode(_link->execute_parse(_as, budget, _cancel));
+		finish(snode ? DONE : CANCELLED, snode, "");
+	}
+	catch (const StandardException& ex)
+	{
+		// Running out of time, with no parse, is the parser timing
+		// out; when that happens past the deadline, it's the deadline.
+		bool late = _has_deadline and _deadline <= Clock::now();
+		finish(late ? EXPIRED : FAILED, Handle::UNDEFINED, ex.get_message());
+	}
+	catch (const std::exception& ex)
+	{
+		finish(FAILED, Handle::UNDEFINED, ex.what());
+	}
+}
+
+void LGParseFuture::finish(Status status, const Handle& result,
+                           const std::string& error)
+{
+	if (FAILED == status)
+		LAZY_LOG_WARN << "LGParseFuture: failed to parse "
+		              << _link->getOutgoingAtom(0)->get_name()
+		              << ": " << error;
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_status = status;
+	_result = result;
+	_error = error;
+	_over.notify_all();
+}
+
+LGParseFuture::Status LGParseFuture::status(void) const
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _status;
+}
+
+const char* LGParseFuture::status_name(Status status)
+{
+	switch (status)
+	{
+		case PENDING: return "pending";
+		case RUNNING: return "running";
+		case DONE: return "done";
+		case FAILED: return "failed";
+		case CANCELLED: return "cancelled";
+		case EXPIRED: return "expired";
+	}
+	return "unknown";
+}
+
+bool LGParseFuture::wait(double timeout) const
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	auto over = [this] { return PENDING != _status and RUNNING != _status; };
+	if (timeout < 0)
+	{
+		_over.wait(lck, over);
+		return true;
+	}
+	return _over.wait_for(lck, std::chrono::duration<double>(timeout), over);
+}
+
+Handle LGParseFuture::result(void) const
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _result;
+}
+
+std::string LGParseFuture::error(void) const
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _error;
+}
+
+/// A queued parse is cancelled right away.  A running one is cancelled
+/// once its pass of the parser is over, unless its parses are being
+/// placed in the atomspace already; it is then DONE after all.
+bool LGParseFuture::cancel(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	if (PENDING == _status)
+	{
+		_status = CANCELLED;
+		_over.notify_all();
+		return true;
+	}
+	if (RUNNING != _status) return false;
+
+	_cancel = true;
+	return true;
+}
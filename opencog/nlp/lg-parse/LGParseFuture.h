@@ -0,0 +1,120 @@
+/*
+ * opencog/nlp/lg-parse/LGParseFuture.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_PARSE_FUTURE_H
+#define _OPENCOG_LG_PARSE_FUTURE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <opencog/atoms/base/Handle.h>
+#include "LGParseLink.h"
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+class Lane;
+class LGParseFuture;
+typedef std::shared_ptr<LGParseFuture> LGParseFuturePtr;
+
+/// An LgParseLink executed in the background, on a Lane of its own, so
+/// that the caller need not block on the parser, for as long as the
+/// budget of the parse policy.  The caller polls it, or waits on it,
+/// for the SentenceNode, and may cancel it.
+///
+/// A deadline, if given, is counted from the call to start(); a parse
+/// still queued by then is not started at all, and one that is running
+/// has the budget of its policy cut to what is left.  The parser can't
+/// be stopped part way through a pass, so that a cancelled parse keeps
+/// running to the end of its pass; but its parses are then dropped,
+/// rather than placed in the atomspace.
+class LGParseFuture
+{
+public:
+	enum Status
+	{
+		PENDING,     // queued
+		RUNNING,
+		DONE,        // the SentenceNode is ready
+		FAILED,      // the parser threw; see error()
+		CANCELLED,
+		EXPIRED,     // not done by the deadline
+	};
+
+	// Queue the LgParseLink or LgParseMinimal; the deadline is in
+	// seconds, and is off unless positive.
+	static LGParseFuturePtr start(const Handle&, AtomSpace*,
+	                              double deadline = 0.0);
+
+	LGParseFuture(const LGParseFuture&) = delete;
+	LGParseFuture& operator=(const LGParseFuture&) = delete;
+
+	Status status(void) const;
+	static const char* status_name(Status);
+
+	// Wait until the parse is over, for at most so many seconds, or
+	// for ever if that is negative.  Returns false if it isn't over.
+	bool wait(double timeout = -1.0) const;
+
+	// The SentenceNode, once DONE; else the undefined handle.
+	Handle result(void) const;
+	std::string error(void) const;
+
+	// Ask the parse to stop.  Returns false if it is over already.
+	bool cancel(void);
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	LGParseFuture(const LGParseLinkPtr&, AtomSpace*, double);
+
+	static Lane& lane(void);
+
+	void run(void);
+	void finish(Status, const Handle&, const std::string&);
+
+	LGParseLinkPtr _link;
+	AtomSpace* _as;
+	bool _has_deadline;
+	Clock::time_point _deadline;
+
+	std::atomic<bool> _cancel;
+
+	mutable std::mutex _mtx;
+	mutable std::condition_variable _over;
+	Status _status;
+	Handle _result;
+	std::string _error;
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_LG_PARSE_FUTURE_H
@@ -22,14 +22,27 @@
  */
 
 #include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <thread>
 #include <uuid/uuid.h>
 #include <link-grammar/link-includes.h>
 
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/base/Node.h>
 #include <opencog/atoms/core/NumberNode.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/StringValue.h>
 #include <opencog/atomspace/AtomSpace.h>
+#include <opencog/executor/Executor.h>
 #include <opencog/nlp/lg-dict/LGDictNode.h>
+#include <opencog/nlp/lg-dict/LGParseStats.h>
+#include <opencog/nlp/index/SentenceRetention.h>
+#include <opencog/nlp/types/WordPosition.h>
+#include <opencog/tracing/Tracer.h>
+#include <opencog/util/Logger.h>
 #include "LGParseLink.h"
 
 using namespace opencog;
@@ -41,13 +54,20 @@ void error_handler(lg_errinfo *ei, void *data);
 ///         PhraseNode "this is a test."
 ///         LgDictNode "en"
 ///         NumberNode  6   -- optional, number of parses.
+///         ConceptNode "interactive" -- optional, the parse policy.
 ///
 /// When executed, the result of parsing the phrase text, using the
 /// specified dictionary, is placed in the atomspace.  Execution
 /// returns a Sentencenode pointing at the parse results.  If the third,
 /// optional NumberNode is present, then that will be the number of
 /// parses that are captured. If the NumberNode is not present, it
-/// defaults to four.
+/// defaults to four.  The parse policy is described at LGParsePolicy;
+/// the tier of the policy that found the parses, and whether null
+/// links were needed, are kept on the SentenceNode, as a FloatValue
+/// under the key (PredicateNode "*-LG-parse-tier-*").  What the parse
+/// cost is kept under (PredicateNode "*-LG-parse-stats-*"); this is
+/// the FloatValue of an LGParseTelemetry.  The same is added to the
+/// process-wide LGParseStats.
 ///
 /// The LgParseLink is a kind of FunctionLink, and can thus be used in
 /// any expression that FunctionLinks can be used with.
@@ -57,9 +77,9 @@ void LGParseLink::init()
 	const HandleSeq& oset = _outgoing;
 
 	size_t osz = oset.size();
-	if (2 != osz and 3 != osz)
+	if (2 > osz or 4 < osz)
 		throw InvalidParamException(TRACE_INFO,
-			"LGParseLink: Expecting two or three arguments, got %lu", osz);
+			"LGParseLink: Expecting two to four arguments, got %lu", osz);
 
 	Type pht = oset[0]->get_type();
 	if (PHRASE_NODE != pht and VARIABLE_NODE != pht and GLOB_NODE != pht)
@@ -73,13 +93,16 @@ void LGParseLink::init()
 			"LGParseLink: Expecting LgDictNode, got %s",
 			oset[1]->to_string().c_str());
 
-	if (3 == osz)
+	// The number of parses and the policy, either of them optional.
+	for (size_t i = 2; i < osz; i++)
 	{
-		Type nit = oset[2]->get_type();
-		if (NUMBER_NODE != nit and VARIABLE_NODE != nit and GLOB_NODE != nit)
-			throw InvalidParamException(TRACE_INFO,
-				"LGParseLink: Expecting NumberNode, got %s",
-				oset[2]->to_string().c_str());
+		Type nit = oset[i]->get_type();
+		if (VARIABLE_NODE == nit or GLOB_NODE == nit) continue;
+		if (NUMBER_NODE == nit and 2 == i) continue;
+		if (CONCEPT_NODE == nit and osz-1 == i) continue;
+		throw InvalidParamException(TRACE_INFO,
+			"LGParseLink: Expecting NumberNode or ConceptNode, got %s",
+			oset[i]->to_string().c_str());
 	}
 }
 
@@ -111,39 +134,61 @@ LGParseMinimal::LGParseMinimal(const HandleSeq&& oset, Type t)
 
 // =================================================================
 
-ValuePtr LGParseLink::execute(AtomSpace* as, bool silent)
+/// The parse policies, by name.
+static const std::map<std::string, LGParsePolicy>& policies(void)
 {
-	if (PHRASE_NODE != _outgoing[0]->get_type())
-		throw InvalidParamException(TRACE_INFO,
-			"LGParseLink: Invalid outgoing set at 0; expecting PhraseNode");
-	if (LG_DICT_NODE != _outgoing[1]->get_type())
-		throw InvalidParamException(TRACE_INFO,
-			"LGParseLink: Invalid outgoing set at 1; expecting LgDictNode");
-	if (3 == _outgoing.size() and
-	   NUMBER_NODE != _outgoing[2]->get_type())
+	static const std::map<std::string, LGParsePolicy> pols = {
+		{"batch", {"batch", {{38000, 60}}, 0}},
+		{"interactive", {"interactive", {{100, 1}, {1000, 1}}, 2}},
+		{"adaptive", {"adaptive", {{100, 1}, {1000, 5}, {38000, 60}}, 60}},
+	};
+	return pols;
+}
+
+const LGParsePolicy& LGParsePolicy::find(const std::string& name)
+{
+	auto it = policies().find(name);
+	if (it == policies().end())
 		throw InvalidParamException(TRACE_INFO,
-			"LGParseLink: Invalid outgoing set at 2; expecting NumberNode");
+			"LGParseLink: Unknown parse policy \"%s\"", name.c_str());
+	return it->second;
+}
 
-	// Link grammar, for some reason, has a different error handler
-	// per thread. Don't know why. So we have to set it every time,
-	// because we don't know what thread we are in.
-	lg_error_set_handler(error_handler, nullptr);
+/// Get the policy named by the ConceptNode, if there is one, or else
+/// the one named on the LgDictNode, or else the batch policy.
+const LGParsePolicy& LGParsePolicy::find(const Handle& dict_node,
+                                         const Handle& name)
+{
+	if (name and CONCEPT_NODE == name->get_type())
+		return find(name->get_name());
 
-	// Get the dictionary
-	LgDictNodePtr ldn(LgDictNodeCast(_outgoing[1]));
+	static const Handle key(createNode(PREDICATE_NODE, "*-LG-parse-policy-*"));
+	StringValuePtr sv(StringValueCast(dict_node->getValue(key)));
+	if (sv and 0 < sv->value().size())
+		return find(sv->value()[0]);
+
+	return find("batch");
+}
+
+// =================================================================
+
+/// Get the dictionary of an LgDictNode, opening it if needed.
+Dictionary LGParseLink::get_dictionary(const Handle& h)
+{
+	LgDictNodePtr ldn(LgDictNodeCast(h));
 	Dictionary dict = ldn->get_dictionary();
 	if (nullptr == dict)
 		throw InvalidParamException(TRACE_INFO,
 			"LgParseLink requires valid dictionary! \"%s\" was given.",
 			ldn->get_name().c_str());
+	return dict;
+}
 
-	// Set up the sentence
-	const char* phrstr = _outgoing[0]->get_name().c_str() ;
-	Sentence sent = sentence_create(phrstr, dict);
-	if (nullptr == sent)
-		throw FatalErrorException(TRACE_INFO,
-			"LGParseLink: Unexpected parser failure!");
-
+/// The parse options used for all parses. They can be reused for
+/// any number of sentences, but only by one thread at a time.
+/// The linkage limit and parse time are set by the parse policy.
+Parse_Options LGParseLink::create_parse_options(void)
+{
 	// Work with the default parse options (mostly).
 	// Suppress printing of combinatorial-overflow warning.
 	// Larger linkage limit; improves sample accuracy.
@@ -169,151 +214,513 @@ ValuePtr LGParseLink::execute(AtomSpace* as, bool silent)
 	// different parse for it, each time. Bug #3065.
 	parse_options_set_repeatable_rand(opts, 0);
 
-	// Count the number of parses.
-	int num_linkages = sentence_parse(sent, opts);
-	if (num_linkages < 0)
+	return opts;
+}
+
+/// Copy what is needed from a linkage, so that it can be converted
+/// after the sentence is gone, and more than once.
+static void extract_linkage(Linkage lkg, const char* phrstr, bool minimal,
+                            LGParsedLinkage& pl)
+{
+	// Loop over all the words.
+	int nwords = linkage_get_num_words(lkg);
+	for (int w=0; w<nwords; w++)
 	{
-		sentence_delete(sent);
-		parse_options_delete(opts);
-		throw FatalErrorException(TRACE_INFO,
-			"LGParseLink: Unexpected parser error!");
+		size_t sb = linkage_get_word_byte_start(lkg, w);
+		size_t eb = linkage_get_word_byte_end(lkg, w);
+
+		// Problem: the default LG API supplies the word together with
+		// the subscript, and with word regex and guess-marks. We really
+		// do NOT want that crud. So use the byte offsets to get the
+		// actual original string.  Since LEFT-WALL and RIGHT-WALL have
+		// no offsets, we need to handle those differently.
+		std::string wrd;
+		if (eb == sb)
+			wrd = linkage_get_word(lkg, w);
+		else
+			wrd.assign(phrstr + sb, eb-sb);
+
+		// LEFT-WALL is not an ordinary word. Its special. Make it
+		// extra-special by adding "illegal" punctuation to it.
+		// FYI, this is compatible with Relex, relex2logic.
+		if (0 == w and wrd == "LEFT-WALL") wrd = "###LEFT-WALL###";
+		if (nwords-1 == w and wrd == "RIGHT-WALL") wrd = "###RIGHT-WALL###";
+
+		pl.words.push_back(std::move(wrd));
+
+		// Don't bother with disjuncts for the minimal parses.
+		if (not minimal)
+			pl.disjuncts.push_back(linkage_get_disjunct_str(lkg, w));
 	}
 
-	// If num_links is zero, try again, allowing null linked words.
-	if (num_linkages == 0)
+	// Loop over all the links
+	int nlinks = linkage_get_num_links(lkg);
+	for (int lk=0; lk<nlinks; lk++)
 	{
-		parse_options_reset_resources(opts);
-		parse_options_set_min_null_count(opts, 1);
-		parse_options_set_max_null_count(opts, sentence_length(sent));
-		num_linkages = sentence_parse(sent, opts);
+		LGParsedLink link;
+		link.lword = linkage_get_link_lword(lkg, lk);
+		link.rword = linkage_get_link_rword(lkg, lk);
+		link.label = linkage_get_link_label(lkg, lk);
+
+		// Don't bother with the link instances for the minimal parse.
+		if (not minimal)
+		{
+			link.llabel = linkage_get_link_llabel(lkg, lk);
+			link.rlabel = linkage_get_link_rlabel(lkg, lk);
+		}
+
+		pl.links.push_back(std::move(link));
 	}
+}
 
-	if (num_linkages <= 0)
+/// Parse the phrase, and place up to max_linkages of its parses into
+/// the atomspace; all of them if max_linkages is not positive.
+/// If the dictionary has a parse cache, the parses are taken from it
+/// when the phrase has been parsed before.
+/// Returns the SentenceNode of the parses.
+Handle LGParseLink::parse(const std::string& phrase, const Handle& dict_node,
+                          Parse_Options opts, const LGParsePolicy& policy,
+                          int max_linkages, bool minimal, AtomSpace* as)
+{
+	LGParseTelemetry tlm;
+	LGParsedSentencePtr parses(find_parses(phrase, dict_node, opts, policy,
+	                                       max_linkages, minimal, tlm));
+
+	return place_parses(parses, *LgDictNodeCast(dict_node), minimal, as, tlm);
+}
+
+/// The first half of parse(): get the parses of the phrase, from the
+/// parse cache, or else from the parser.  The parse time, and whether
+/// the parses were cached, are set in the telemetry.
+LGParsedSentencePtr LGParseLink::find_parses(const std::string& phrase,
+                                             const Handle& dict_node,
+                                             Parse_Options opts,
+                                             const LGParsePolicy& policy,
+                                             int max_linkages, bool minimal,
+                                             LGParseTelemetry& tlm)
+{
+	LgDictNodePtr ldn(LgDictNodeCast(dict_node));
+	LGParseCachePtr cache(ldn->get_parse_cache());
+
+	typedef std::chrono::duration<double> Seconds;
+	auto start = std::chrono::steady_clock::now();
+
+	tlm.parse_time = 0.0;
+	tlm.cached = false;
+
+	LGParsedSentencePtr parses;
+	if (cache)
+		parses = cache->find(phrase, max_linkages, minimal, policy.name);
+
+	if (parses)
 	{
-		sentence_delete(sent);
-		parse_options_delete(opts);
-		throw RuntimeException(TRACE_INFO,
-			"LGParseLink: Parser timeout.");
+		tlm.cached = true;
+		return parses;
 	}
 
-	// Post-processor might not accept all of the parses.
-	num_linkages = sentence_num_valid_linkages(sent);
-
-	// The number of linkages to process.
-	int max_linkages = 0;
-	if (3 == _outgoing.size())
+	try
 	{
-		NumberNodePtr nnp(NumberNodeCast(_outgoing[2]));
-		max_linkages = nnp->get_value() + 0.5;
+		parses = run_parser(phrase, get_dictionary(dict_node), opts,
+		                    policy, max_linkages, minimal);
+	}
+	catch (...)
+	{
+		Seconds spent = std::chrono::steady_clock::now() - start;
+		LGParseStats::instance().record_failure(spent.count());
+		LAZY_LOG_INFO << "LGParseLink: no parse of \"" << phrase
+		              << "\" after " << spent.count() << " s";
+		throw;
 	}
+	if (cache)
+		cache->insert(phrase, max_linkages, minimal, policy.name, parses);
 
-	// Takes limit from parameter only if it's positive and smaller
-	if ((max_linkages > 0) && (max_linkages < num_linkages))
+	tlm.parse_time = Seconds(std::chrono::steady_clock::now() - start).count();
+	return parses;
+}
+
+static std::atomic<bool> compact_naming(false);
+
+/// Name the atoms of all the parses compactly, unless the LgDictNode
+/// says otherwise.
+void LGParseLink::set_compact_naming(bool compact)
+{
+	compact_naming = compact;
+}
+
+/// Whether to name the atoms of the parses with the dictionary
+/// compactly: as given by a StringValue, "compact" or "uuid", on the
+/// LgDictNode, under the key (PredicateNode "*-LG-instance-naming-*"),
+/// or else as set by set_compact_naming().
+bool LGParseLink::use_compact_naming(const Handle& dict_node)
+{
+	static const Handle key(createNode(PREDICATE_NODE, "*-LG-instance-naming-*"));
+	StringValuePtr sv(StringValueCast(dict_node->getValue(key)));
+	if (sv and 0 < sv->value().size())
 	{
-		num_linkages = max_linkages;
+		const std::string& naming = sv->value()[0];
+		if ("compact" == naming) return true;
+		if ("uuid" == naming) return false;
+		throw InvalidParamException(TRACE_INFO,
+			"LGParseLink: Unknown instance naming \"%s\"", naming.c_str());
 	}
+	return compact_naming;
+}
+
+/// A short sentence id, in base 36: a process-wide count, started at
+/// a random 48-bit number, so the ids of different processes are
+/// unlikely to meet.  Use the UUIDs for atomspaces that get merged.
+static void compact_id(char* buf, size_t len)
+{
+	static std::atomic<uint64_t> next([]()
+	{
+		uuid_t uu;
+		uuid_generate(uu);
+		uint64_t start = 0;
+		memcpy(&start, uu, sizeof(start));
+		return start & ((1ULL << 48) - 1);
+	}());
+
+	static const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+	char tmp[16];
+	char* p = tmp + sizeof(tmp);
+	*--p = 0;
+	uint64_t n = next++;
+	do { *--p = digits[n % 36]; n /= 36; } while (n);
+	strncpy(buf, p, len);
+	buf[len - 1] = 0;
+}
+
+/// The second half of parse(): place the parses into the atomspace,
+/// under a new SentenceNode, which is returned.  The rest of the
+/// telemetry is filled in, kept on the SentenceNode, and recorded.
+///
+/// The SentenceNode is named "sentence@" and a UUID, such as
+/// "sentence@0d2b...", or, with the compact naming, a short id, such
+/// as "sentence@2kq8f0x1"; see use_compact_naming().  The names of the
+/// other atoms are made from that id, see cvt_linkage().
+Handle LGParseLink::place_parses(const LGParsedSentencePtr& parses,
+                                 LgDictNode& ldn, bool minimal,
+                                 AtomSpace* as, LGParseTelemetry& tlm)
+{
+	typedef std::chrono::duration<double> Seconds;
+	auto cvt_start = std::chrono::steady_clock::now();
+	size_t atoms_before = as->get_size();
 
-	// Hmm. I hope that uuid_generate() won't block if there is not
-	// enough entropy in the entropy pool....
-	uuid_t uu;
-	uuid_generate(uu);
+	bool compact = use_compact_naming(ldn.get_handle());
 	char idstr[37];
-	uuid_unparse(uu, idstr);
+	if (compact)
+		compact_id(idstr, sizeof(idstr));
+	else
+	{
+		// Hmm. I hope that uuid_generate() won't block if there is not
+		// enough entropy in the entropy pool....
+		uuid_t uu;
+		uuid_generate(uu);
+		uuid_unparse(uu, idstr);
+	}
 
 	char sentstr[sizeof(idstr) + 10] = "sentence@";
 	strcat(sentstr, idstr);
 
 	Handle snode(as->add_node(SENTENCE_NODE, sentstr));
 
-	// Avoid generating big piles of Atoms, if the user did not
-	// want them. (The extra Atoms deescribe disjuncts, etc.)
-	bool minimal = (get_type() == LG_PARSE_MINIMAL);
+	static const Handle tier_key(createNode(PREDICATE_NODE, "*-LG-parse-tier-*"));
+	snode->setValue(tier_key, createFloatValue(std::vector<double>(
+		{(double) parses->tier, parses->null_links ? 1.0 : 0.0})));
+
+	for (size_t i = 0; i < parses->linkages.size(); i++)
+	{
+		Handle pnode = cvt_linkage(parses->linkages[i], i, sentstr,
+		                           minimal, compact, ldn, as);
+		as->add_link(PARSE_LINK, pnode, snode);
+	}
+
+	// With other parses going on, such as in the LgParseBatchLink,
+	// their atoms get counted too.
+	tlm.convert_time = Seconds(std::chrono::steady_clock::now() - cvt_start).count();
+	tlm.atoms = as->get_size() - atoms_before;
+	tlm.num_found = parses->num_found;
+	tlm.num_valid = parses->num_valid;
+	tlm.num_post_processed = parses->num_post_processed;
+	tlm.null_links = parses->null_links;
+	tlm.tier = parses->tier;
+
+	static const Handle stats_key(createNode(PREDICATE_NODE, "*-LG-parse-stats-*"));
+	snode->setValue(stats_key, createFloatValue(tlm.to_vector()));
+	LGParseStats::instance().record(tlm);
+
+	return snode;
+}
+
+/// Run the parser on the phrase, and keep up to max_linkages parses.
+/// The tiers of the policy are tried in turn, for as long as the
+/// parser runs out of time and the budget is not spent.
+LGParsedSentencePtr LGParseLink::run_parser(const std::string& phrase,
+                                            Dictionary dict,
+                                            Parse_Options opts,
+                                            const LGParsePolicy& policy,
+                                            int max_linkages, bool minimal)
+{
+	// Set up the sentence
+	const char* phrstr = phrase.c_str();
+	Sentence sent = sentence_create(phrstr, dict);
+	if (nullptr == sent)
+		throw FatalErrorException(TRACE_INFO,
+			"LGParseLink: Unexpected parser failure!");
+
+	auto start = std::chrono::steady_clock::now();
+
+	// Run one pass of the parser with the tier's settings, within what
+	// is left of the budget. Returns -1 if the budget is spent.
+	auto run_pass = [&](const LGParsePolicy::Tier& tier, bool nulls)
+	{
+		int secs = tier.max_parse_time;
+		if (0 < policy.budget)
+		{
+			std::chrono::duration<double> spent =
+				std::chrono::steady_clock::now() - start;
+			double left = policy.budget - spent.count();
+			if (left <= 0) return -1;
+			secs = std::min(secs, (int) std::ceil(left));
+		}
+
+		// The options may have been used for another sentence already.
+		parse_options_reset_resources(opts);
+		parse_options_set_linkage_limit(opts, tier.linkage_limit);
+		parse_options_set_max_parse_time(opts, secs);
+		parse_options_set_min_null_count(opts, nulls ? 1 : 0);
+		parse_options_set_max_null_count(opts, nulls ? sentence_length(sent) : 0);
+
+		// Count the number of parses.
+		int n = sentence_parse(sent, opts);
+		if (n < 0)
+		{
+			sentence_delete(sent);
+			throw FatalErrorException(TRACE_INFO,
+				"LGParseLink: Unexpected parser error!");
+		}
+		return n;
+	};
+
+	// The outcome of the last pass run; the sentence holds its parses.
+	int num_linkages = 0;
+	int used_tier = 0;
+	bool null_links = false;
+	for (size_t t = 0; t < policy.tiers.size(); t++)
+	{
+		const LGParsePolicy::Tier& tier = policy.tiers[t];
+
+		// Once it's known that null links are needed, don't bother
+		// looking for parses without them at the next tiers.
+		if (not null_links)
+		{
+			int n = run_pass(tier, false);
+			if (n < 0) break;
+			num_linkages = n;
+			used_tier = t;
+		}
+
+		// If num_links is zero, try again, allowing null linked words;
+		// unless it ran out of time, and a bigger tier can be tried.
+		bool expired = null_links ? false : parse_options_timer_expired(opts);
+		bool last = (t+1 == policy.tiers.size());
+		if (null_links or (0 == num_linkages and (not expired or last)))
+		{
+			int n = run_pass(tier, true);
+			if (n < 0) break;
+			num_linkages = n;
+			used_tier = t;
+			null_links = true;
+			expired = parse_options_timer_expired(opts);
+		}
+
+		if (0 < num_linkages and not expired) break;
+	}
+
+	if (num_linkages <= 0)
+	{
+		sentence_delete(sent);
+		throw RuntimeException(TRACE_INFO,
+			"LGParseLink: Parser timeout.");
+	}
+
+	int num_found = sentence_num_linkages_found(sent);
+
+	// Post-processor might not accept all of the parses.
+	num_linkages = sentence_num_valid_linkages(sent);
+	int num_valid = num_linkages;
+
+	// Takes limit from parameter only if it's positive and smaller
+	if ((max_linkages > 0) && (max_linkages < num_linkages))
+	{
+		num_linkages = max_linkages;
+	}
 
 	// There are only so many parses available.
 	int num_available = sentence_num_linkages_post_processed(sent);
 
-	int jct = 0;
-	for (int i=0; jct<num_linkages and i<num_available; i++)
+	std::shared_ptr<LGParsedSentence> parses(new LGParsedSentence());
+	parses->tier = used_tier;
+	parses->null_links = null_links;
+	parses->num_found = num_found;
+	parses->num_valid = num_valid;
+	parses->num_post_processed = num_available;
+
+	std::vector<LGParsedLinkage>& lkgs = parses->linkages;
+	for (int i=0; (int) lkgs.size()<num_linkages and i<num_available; i++)
 	{
 		// Skip sentences with P.P. violations.
 		if (0 < sentence_num_violations(sent, i)) continue;
-		jct ++;
 		Linkage lkg = linkage_create(i, sent, opts);
-		Handle pnode = cvt_linkage(lkg, i, sentstr, phrstr, minimal, as);
-		as->add_link(PARSE_LINK, pnode, snode);
+		lkgs.emplace_back();
+		extract_linkage(lkg, phrstr, minimal, lkgs.back());
 		linkage_delete(lkg);
 	}
 
 	sentence_delete(sent);
+	return parses;
+}
+
+ValuePtr LGParseLink::execute(AtomSpace* as, bool silent)
+{
+	static const std::atomic<bool> never(false);
+	return execute_parse(as, 0.0, never);
+}
+
+/// The body of execute().  The budget, if positive, caps that of the
+/// parse policy, so that the parse gives up by then; as the parser
+/// can't be stopped part way through a pass, it may run over by the
+/// time of a pass.  The cancel flag is looked at before the parse
+/// starts, and again before the parses are placed in the atomspace,
+/// so that a cancelled parse leaves nothing behind.
+Handle LGParseLink::execute_parse(AtomSpace* as, double budget,
+                                  const std::atomic<bool>& cancel)
+{
+	if (PHRASE_NODE != _outgoing[0]->get_type())
+		throw InvalidParamException(TRACE_INFO,
+			"LGParseLink: Invalid outgoing set at 0; expecting PhraseNode");
+	if (LG_DICT_NODE != _outgoing[1]->get_type())
+		throw InvalidParamException(TRACE_INFO,
+			"LGParseLink: Invalid outgoing set at 1; expecting LgDictNode");
+	for (size_t i = 2; i < _outgoing.size(); i++)
+	{
+		Type t = _outgoing[i]->get_type();
+		if (NUMBER_NODE != t and CONCEPT_NODE != t)
+			throw InvalidParamException(TRACE_INFO,
+				"LGParseLink: Invalid outgoing set at %lu; "
+				"expecting NumberNode or ConceptNode", i);
+	}
+
+	if (cancel) return Handle::UNDEFINED;
+
+	TraceSpan span("lg-parse", "nlp");
+	span.arg("phrase", _outgoing[0]->get_name())
+	    .arg("dict", _outgoing[1]->get_name());
+
+	// Link grammar, for some reason, has a different error handler
+	// per thread. Don't know why. So we have to set it every time,
+	// because we don't know what thread we are in.
+	lg_error_set_handler(error_handler, nullptr);
+
+	// Get the dictionary
+	get_dictionary(_outgoing[1]);
+
+	// The number of linkages to process.
+	int max_linkages = 0;
+	if (3 <= _outgoing.size() and NUMBER_NODE == _outgoing[2]->get_type())
+	{
+		NumberNodePtr nnp(NumberNodeCast(_outgoing[2]));
+		max_linkages = nnp->get_value() + 0.5;
+	}
+
+	LGParsePolicy policy = LGParsePolicy::find(_outgoing[1],
+		2 < _outgoing.size() ? _outgoing.back() : Handle::UNDEFINED);
+	if (0 < budget and (policy.budget <= 0 or budget < policy.budget))
+		policy.budget = budget;
+
+	// Avoid generating big piles of Atoms, if the user did not
+	// want them. (The extra Atoms deescribe disjuncts, etc.)
+	bool minimal = (get_type() == LG_PARSE_MINIMAL);
+
+	Parse_Options opts = create_parse_options();
+	LGParseTelemetry tlm;
+	LGParsedSentencePtr parses;
+	try
+	{
+		parses = find_parses(_outgoing[0]->get_name(), _outgoing[1], opts,
+		                     policy, max_linkages, minimal, tlm);
+	}
+	catch (...)
+	{
+		parse_options_delete(opts);
+		throw;
+	}
+
 	parse_options_delete(opts);
 	lg_error_flush();
 	lg_error_clearall();
+
+	if (cancel) return Handle::UNDEFINED;
+
+	Handle snode = place_parses(parses, *LgDictNodeCast(_outgoing[1]),
+	                            minimal, as, tlm);
+
+	// Each chat utterance comes through here, so this is where the
+	// old sentences are let go of, if there is a retention policy.
+	nlp::SentenceRetention::enforce(as);
+
 	return snode;
 }
 
 static std::atomic<unsigned long> wcnt;
 
-Handle LGParseLink::cvt_linkage(Linkage lkg, int i, const char* idstr,
-                                const char* phrstr,
-                                bool minimal, AtomSpace* as) const
+/// The ParseNode is named after the SentenceNode, e.g.
+/// "sentence@0d2b..._parse_0", or "sentence@2kq8f0x1_0" with the
+/// compact naming.  The word instances are named after the sentence
+/// id, the parse and the word, rather than getting a UUID each; e.g.
+/// "this@0d2b...-0-1" for the second word of the first parse.  The
+/// link instances are named after the parse, e.g.
+/// "Ss@sentence@0d2b..._parse_0-link-3", or, with the compact naming,
+/// like the word instances, e.g. "Ss@2kq8f0x1-0-3".
+Handle LGParseLink::cvt_linkage(const LGParsedLinkage& lkg, int i,
+                                const char* idstr, bool minimal,
+                                bool compact, LgDictNode& ldn,
+                                AtomSpace* as)
 {
 	char parseid[80];
-	snprintf(parseid, 80, "%s_parse_%d", idstr, i);
+	snprintf(parseid, 80, compact ? "%s_%d" : "%s_parse_%d", idstr, i);
 	Handle pnode(as->add_node(PARSE_NODE, parseid));
 
+	std::string winst_base(strchr(idstr, '@') + 1);
+	winst_base += "-" + std::to_string(i) + "-";
+
 	// Loop over all the words.
 	HandleSeq wrds;
-	int nwords = linkage_get_num_words(lkg);
-	for (int w=0; w<nwords; w++)
+	size_t nwords = lkg.words.size();
+	for (size_t w=0; w<nwords; w++)
 	{
-		size_t sb = linkage_get_word_byte_start(lkg, w);
-		size_t eb = linkage_get_word_byte_end(lkg, w);
+		const std::string& wrd = lkg.words[w];
 
-		// Problem: the default LG API supplies the word together with
-		// the subscript, and with word regex and guess-marks. We really
-		// do NOT want that crud. So use the byte offsets to get the
-		// actual original string.  Since LEFT-WALL and RIGHT-WALL have
-		// no offsets, we need to handle those differently.
-		// strndupa allocates on stack, no need to free.
-		const char* wrd;
-		if (eb == sb)
-			wrd = linkage_get_word(lkg, w);
-		else
-		{
-			// eb points at the byte after the last char,
-			// its a great place to write a null byte.
-			wrd = strndupa(phrstr + sb, eb-sb);
-		}
-
-		// LEFT-WALL is not an ordinary word. Its special. Make it
-		// extra-special by adding "illegal" punctuation to it.
-		// FYI, this is compatible with Relex, relex2logic.
-		if (0 == w and 0 == strcmp(wrd, "LEFT-WALL")) wrd = "###LEFT-WALL###";
-		if (nwords-1 == w and 0 == strcmp(wrd, "RIGHT-WALL")) wrd = "###RIGHT-WALL###";
-
-		uuid_t uu2;
-		uuid_generate(uu2);
-		char idstr2[37];
-		uuid_unparse(uu2, idstr2);
-		char buff[801] = "";
-		snprintf(buff, sizeof(buff), "%s@%s", wrd, idstr2);
-		Handle winst(as->add_node(WORD_INSTANCE_NODE, buff));
+		Handle winst(as->add_node(WORD_INSTANCE_NODE,
+			wrd + "@" + winst_base + std::to_string(w)));
 		wrds.push_back(winst);
 
 		// Associate the word with the parse.
 		as->add_link(WORD_INSTANCE_LINK, winst, pnode);
 		as->add_link(REFERENCE_LINK, winst,
 			as->add_node(WORD_NODE, wrd));
+		unsigned long seq = ++wcnt;
 		as->add_link(WORD_SEQUENCE_LINK, winst,
-			Handle(createNumberNode(++wcnt)));
+			Handle(createNumberNode(seq)));
+		set_word_position(winst, seq, w, i);
 
 		// Don't bother with disjuncts for the minimal parses.
 		if (minimal) continue;
 
 		// Convert the disjunct to atomese.
-		// This requires parsing a string. Fortunately, the
-		// string is a very simple format.
-		const char* djstr = linkage_get_disjunct_str(lkg, w);
+		// This requires splitting a string into connectors, such
+		// as "@MX+"; the dictionary node has the atoms for them.
+		const char* djstr = lkg.disjuncts[w].c_str();
 
 		HandleSeq conseq;
 		const char* p = djstr;
@@ -321,33 +728,13 @@ Handle LGParseLink::cvt_linkage(Linkage lkg, int i, const char* idstr,
 		{
 			while (' ' == *p) p++;
 			if (0 == *p) break;
-			bool multi = false;
-			if ('@' == *p) { multi = true; p++; }
 			const char* s = strchr(p, ' ');
-			size_t len = s-p-1;
-			if (NULL == s) len = strlen(p) - 1;
-			char cstr[60];
+			size_t len = (NULL == s) ? strlen(p) : s-p;
 			if (60 <= len)
 				throw RuntimeException(TRACE_INFO,
 					"LGParseLink: Dictionary has a bug; Uuexpectedly long connector=%s", djstr);
-			strncpy(cstr, p, len);
-			cstr[len] = 0;
-			Handle con(createNode(LG_CONNECTOR_NODE, cstr));
-			cstr[0] = *(p+len);
-			cstr[1] = 0;
-			Handle dir(createNode(LG_CONN_DIR_NODE, cstr));
-			p = p+len+1;
-
-			HandleSeq cono;
-			cono.push_back(con);
-			cono.push_back(dir);
-			if (multi)
-			{
-				Handle mu(createNode(LG_CONN_MULTI_NODE, "@"));
-				cono.push_back(mu);
-			}
-			Handle conl(createLink(std::move(cono), LG_CONNECTOR));
-			conseq.push_back(conl);
+			conseq.push_back(ldn.get_connector(std::string(p, len)));
+			p = p+len;
 		}
 
 		// Set up the disjuncts on each word
@@ -357,15 +744,14 @@ Handle LGParseLink::cvt_linkage(Linkage lkg, int i, const char* idstr,
 	}
 
 	// Loop over all the links
-	int nlinks = linkage_get_num_links(lkg);
+	int nlinks = lkg.links.size();
 	for (int lk=0; lk<nlinks; lk++)
 	{
-		int lword = linkage_get_link_lword(lkg, lk);
-		int rword = linkage_get_link_rword(lkg, lk);
-		Handle lst(as->add_link(LIST_LINK, wrds[lword], wrds[rword]));
+		const LGParsedLink& link = lkg.links[lk];
+		Handle lst(as->add_link(LIST_LINK, wrds[link.lword], wrds[link.rword]));
 
 		// The link
-		const char* label = linkage_get_link_label(lkg, lk);
+		const char* label = link.label.c_str();
 		Handle lrel(as->add_node(LINK_GRAMMAR_RELATIONSHIP_NODE, label));
 		as->add_link(EVALUATION_LINK, lrel, lst);
 
@@ -374,7 +760,10 @@ Handle LGParseLink::cvt_linkage(Linkage lkg, int i, const char* idstr,
 
 		// The link instance.
 		char buff[140];
-		snprintf(buff, 140, "%s@%s-link-%d", label, parseid, lk);
+		if (compact)
+			snprintf(buff, 140, "%s@%s%d", label, winst_base.c_str(), lk);
+		else
+			snprintf(buff, 140, "%s@%s-link-%d", label, parseid, lk);
 		Handle linst(as->add_node(LG_LINK_INSTANCE_NODE, buff));
 		as->add_link(EVALUATION_LINK, linst, lst);
 
@@ -382,16 +771,10 @@ Handle LGParseLink::cvt_linkage(Linkage lkg, int i, const char* idstr,
 		as->add_link(REFERENCE_LINK, linst, lrel);
 
 		// The connectors for the link instance.
-		const char* llab = linkage_get_link_llabel(lkg, lk);
-		const char* rlab = linkage_get_link_rlabel(lkg, lk);
 		as->add_link(LG_LINK_INSTANCE_LINK,
 			linst,
-			as->add_link(LG_CONNECTOR,
-				as->add_node(LG_CONNECTOR_NODE, llab),
-				as->add_node(LG_CONN_DIR_NODE, "+")),
-			as->add_link(LG_CONNECTOR,
-				as->add_node(LG_CONNECTOR_NODE, rlab),
-				as->add_node(LG_CONN_DIR_NODE, "-")));
+			as->add_atom(ldn.get_connector(link.llabel + "+")),
+			as->add_atom(ldn.get_connector(link.rlabel + "-")));
 	}
 
 	return pnode;
@@ -399,4 +782,168 @@ Handle LGParseLink::cvt_linkage(Linkage lkg, int i, const char* idstr,
 
 DEFINE_LINK_FACTORY(LGParseLink, LG_PARSE_LINK)
 
+// =================================================================
+
+/// The expected format of an LgParseBatchLink is:
+///
+///     LgParseBatchLink
+///         ListLink
+///             PhraseNode "this is a test."
+///             PhraseNode "this is another test."
+///             ...
+///         LgDictNode "en"
+///         NumberNode  6   -- optional, number of parses of each.
+///         NumberNode  8   -- optional, number of threads.
+///         ConceptNode "batch" -- optional, the parse policy.
+///
+/// When executed, each phrase is parsed as by the LgParseLink, and
+/// the SentenceNodes of the parses are returned in a ListLink, in the
+/// same order as the phrases.  The phrases are spread over the given
+/// number of threads, which defaults to the number of cores; they all
+/// share the one dictionary, and each thread reuses its parse options
+/// from one phrase to the next.  A phrase that fails to parse is
+/// logged and left out of the results, rather than failing the batch.
+///
+void LGParseBatchLink::init()
+{
+	const HandleSeq& oset = _outgoing;
+
+	size_t osz = oset.size();
+	if (2 > osz or 5 < osz)
+		throw InvalidParamException(TRACE_INFO,
+			"LGParseBatchLink: Expecting two to five arguments, got %lu", osz);
+
+	Type pht = oset[0]->get_type();
+	if (LIST_LINK != pht and VARIABLE_NODE != pht and GLOB_NODE != pht)
+		throw InvalidParamException(TRACE_INFO,
+			"LGParseBatchLink: Expecting ListLink, got %s",
+			oset[0]->to_string().c_str());
+
+	Type dit = oset[1]->get_type();
+	if (LG_DICT_NODE != dit and VARIABLE_NODE != dit and GLOB_NODE != dit)
+		throw InvalidParamException(TRACE_INFO,
+			"LGParseBatchLink: Expecting LgDictNode, got %s",
+			oset[1]->to_string().c_str());
+
+	// Up to two numbers, and then the policy.
+	for (size_t i = 2; i < osz; i++)
+	{
+		Type nit = oset[i]->get_type();
+		if (VARIABLE_NODE == nit or GLOB_NODE == nit) continue;
+		if (NUMBER_NODE == nit and i < 4) continue;
+		if (CONCEPT_NODE == nit and osz-1 == i) continue;
+		throw InvalidParamException(TRACE_INFO,
+			"LGParseBatchLink: Expecting NumberNode or ConceptNode, got %s",
+			oset[i]->to_string().c_str());
+	}
+}
+
+LGParseBatchLink::LGParseBatchLink(const HandleSeq&& oset, Type t)
+	: FunctionLink(std::move(oset), t)
+{
+	// Type must be as expected
+	if (not nameserver().isA(t, LG_PARSE_BATCH_LINK))
+	{
+		const std::string& tname = nameserver().getTypeName(t);
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting an LgParseBatchLink, got %s", tname.c_str());
+	}
+	init();
+}
+
+ValuePtr LGParseBatchLink::execute(AtomSpace* as, bool silent)
+{
+	if (LIST_LINK != _outgoing[0]->get_type())
+		throw InvalidParamException(TRACE_INFO,
+			"LGParseBatchLink: Invalid outgoing set at 0; expecting ListLink");
+	if (LG_DICT_NODE != _outgoing[1]->get_type())
+		throw InvalidParamException(TRACE_INFO,
+			"LGParseBatchLink: Invalid outgoing set at 1; expecting LgDictNode");
+	Handle policy_name;
+	HandleSeq numbers;
+	for (size_t i = 2; i < _outgoing.size(); i++)
+	{
+		Type t = _outgoing[i]->get_type();
+		if (CONCEPT_NODE == t and _outgoing.size()-1 == i)
+			policy_name = _outgoing[i];
+		else if (NUMBER_NODE == t)
+			numbers.push_back(_outgoing[i]);
+		else
+			throw InvalidParamException(TRACE_INFO,
+				"LGParseBatchLink: Invalid outgoing set at %lu; "
+				"expecting NumberNode or ConceptNode", i);
+	}
+
+	const HandleSeq& phrases = _outgoing[0]->getOutgoingSet();
+	for (const Handle& ph : phrases)
+		if (PHRASE_NODE != ph->get_type())
+			throw InvalidParamException(TRACE_INFO,
+				"LGParseBatchLink: Expecting a list of PhraseNodes, got %s",
+				ph->to_string().c_str());
+
+	lg_error_set_handler(error_handler, nullptr);
+	LGParseLink::get_dictionary(_outgoing[1]);
+
+	// The number of linkages to process.
+	int max_linkages = 0;
+	if (1 <= numbers.size())
+	{
+		NumberNodePtr nnp(NumberNodeCast(numbers[0]));
+		max_linkages = nnp->get_value() + 0.5;
+	}
+
+	size_t nthreads = std::thread::hardware_concurrency();
+	if (2 == numbers.size())
+	{
+		NumberNodePtr nnp(NumberNodeCast(numbers[1]));
+		nthreads = nnp->get_value() + 0.5;
+	}
+
+	const LGParsePolicy& policy = LGParsePolicy::find(_outgoing[1],
+	                                                  policy_name);
+	nthreads = std::max((size_t) 1, std::min(nthreads, phrases.size()));
+
+	bool minimal = (get_type() == LG_PARSE_BATCH_MINIMAL);
+
+	HandleSeq snodes(phrases.size());
+	std::atomic<size_t> next(0);
+	auto work = [&]()
+	{
+		// The error handler is per thread; see LGParseLink::execute()
+		lg_error_set_handler(error_handler, nullptr);
+		Parse_Options opts = LGParseLink::create_parse_options();
+
+		for (size_t i = next++; i < phrases.size(); i = next++)
+		{
+			const std::string& phrase = phrases[i]->get_name();
+			try
+			{
+				snodes[i] = LGParseLink::parse(phrase, _outgoing[1], opts,
+				                               policy, max_linkages,
+				                               minimal, as);
+			}
+			catch (const StandardException& ex)
+			{
+				LAZY_LOG_WARN << "LGParseBatchLink: failed to parse \""
+				              << phrase << "\": " << ex.get_message();
+			}
+		}
+
+		parse_options_delete(opts);
+		lg_error_flush();
+		lg_error_clearall();
+	};
+
+	Executor::instance().parallel_for(nthreads,
+		[&](size_t) { work(); }, nthreads);
+
+	HandleSeq parsed;
+	for (const Handle& sn : snodes)
+		if (sn) parsed.push_back(sn);
+
+	return as->add_link(LIST_LINK, std::move(parsed));
+}
+
+DEFINE_LINK_FACTORY(LGParseBatchLink, LG_PARSE_BATCH_LINK)
+
 /* ===================== END OF FILE ===================== */
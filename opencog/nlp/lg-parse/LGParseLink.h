@@ -24,17 +24,56 @@
 #ifndef _OPENCOG_LG_PARSE_H
 #define _OPENCOG_LG_PARSE_H
 
+#include <atomic>
+#include <string>
+#include <vector>
 #include <link-grammar/link-includes.h>
 
 #include <opencog/atoms/core/FunctionLink.h>
+#include <opencog/nlp/lg-dict/LGParseCache.h>
+#include <opencog/nlp/lg-dict/LGParseStats.h>
 #include <opencog/nlp/types/atom_types.h>
 
 namespace opencog
 {
+class LgDictNode;
+
 /** \addtogroup grp_atomspace
  *  @{
  */
 
+/// How hard to try to parse a phrase.  The phrase is parsed first
+/// with the cheap settings of the first tier, and with those of the
+/// next tier only if the parser ran out of time.  The time spent on
+/// all the tiers, including the retries with null links, is kept
+/// within the budget, unless it is zero.  The policies are:
+///
+///    "batch"        Do everything to find parses; the default.
+///    "interactive"  Small linkage limits, and a short budget, for
+///                   answering in real time.
+///    "adaptive"     Escalate from interactive to batch settings.
+///
+/// The policy is given by a ConceptNode argument of the LgParseLink,
+/// or else by a StringValue on the LgDictNode, under the key
+/// (PredicateNode "*-LG-parse-policy-*").
+
+struct LGParsePolicy
+{
+	struct Tier
+	{
+		int linkage_limit;
+		int max_parse_time;  // seconds
+	};
+
+	std::string name;
+	std::vector<Tier> tiers;
+	double budget;           // seconds; 0 for no limit
+
+	static const LGParsePolicy& find(const std::string&);
+	static const LGParsePolicy& find(const Handle& dict_node,
+	                                 const Handle& name);
+};
+
 /// Link Grammar parser.
 ///
 /// An atomspace wrapper to the LG parser.
@@ -48,8 +87,11 @@ class LGParseLink : public FunctionLink
 {
 protected:
 	void init();
-	Handle cvt_linkage(Linkage, int, const char*, const char*,
-	                   bool, AtomSpace*) const;
+	static LGParsedSentencePtr run_parser(const std::string&, Dictionary,
+	                                      Parse_Options,
+	                                      const LGParsePolicy&, int, bool);
+	static Handle cvt_linkage(const LGParsedLinkage&, int, const char*,
+	                          bool, bool, LgDictNode&, AtomSpace*);
 
 public:
 	LGParseLink(const HandleSeq&&, Type=LG_PARSE_LINK);
@@ -59,7 +101,34 @@ public:
 	// Return a pointer to the atom being specified.
 	virtual ValuePtr execute(AtomSpace*, bool);
 
+	// What execute() does, with the budget of the parse policy cut to
+	// the given no. of seconds, if positive; the parses are not placed
+	// if the flag is set by then, and the undefined handle is returned.
+	// For parsing in the background, as the LGParseFuture does.
+	Handle execute_parse(AtomSpace*, double budget,
+	                     const std::atomic<bool>& cancel);
+
 	static Handle factory(const Handle&);
+
+	// The steps of execute(), for parsing many phrases with the
+	// same dictionary and options.
+	static Dictionary get_dictionary(const Handle&);
+	static Parse_Options create_parse_options(void);
+	static Handle parse(const std::string&, const Handle&, Parse_Options,
+	                    const LGParsePolicy&, int, bool, AtomSpace*);
+
+	// The two halves of parse(), for parsing and placing the parses
+	// in different threads, as the LGParsePipeline does.
+	static LGParsedSentencePtr find_parses(const std::string&,
+	                                       const Handle&, Parse_Options,
+	                                       const LGParsePolicy&, int, bool,
+	                                       LGParseTelemetry&);
+	static Handle place_parses(const LGParsedSentencePtr&, LgDictNode&,
+	                           bool, AtomSpace*, LGParseTelemetry&);
+
+	// How the atoms of the parses are named; see place_parses().
+	static void set_compact_naming(bool);
+	static bool use_compact_naming(const Handle&);
 };
 
 class LGParseMinimal : public LGParseLink
@@ -86,6 +155,36 @@ static inline LGParseMinimalPtr LGParseMinimalCast(AtomPtr a)
 
 #define createLGParseMinimal std::make_shared<LGParseMinimal>
 
+/// Batch parser.
+///
+/// Parses a list of phrases with the same dictionary, several of them
+/// at a time, and returns a ListLink of their SentenceNodes.  The
+/// LgParseBatchMinimal places the same atoms as the LGParseMinimal.
+
+class LGParseBatchLink : public FunctionLink
+{
+protected:
+	void init();
+
+public:
+	LGParseBatchLink(const HandleSeq&&, Type=LG_PARSE_BATCH_LINK);
+	LGParseBatchLink(const LGParseBatchLink&) = delete;
+	LGParseBatchLink& operator=(const LGParseBatchLink&) = delete;
+
+	// Return a pointer to the atom being specified.
+	virtual ValuePtr execute(AtomSpace*, bool);
+
+	static Handle factory(const Handle&);
+};
+
+typedef std::shared_ptr<LGParseBatchLink> LGParseBatchLinkPtr;
+static inline LGParseBatchLinkPtr LGParseBatchLinkCast(const Handle& h)
+	{ return std::dynamic_pointer_cast<LGParseBatchLink>(h); }
+static inline LGParseBatchLinkPtr LGParseBatchLinkCast(AtomPtr a)
+	{ return std::dynamic_pointer_cast<LGParseBatchLink>(a); }
+
+#define createLGParseBatchLink std::make_shared<LGParseBatchLink>
+
 /** @}*/
 }
 #endif // _OPENCOG_LG_PARSE_H
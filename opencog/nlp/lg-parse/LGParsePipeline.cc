@@ -0,0 +1,258 @@
+/*
+ * opencog/nlp/lg-parse/LGParsePipeline.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <link-grammar/link-includes.h>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/util/Logger.h>
+#include <opencog/nlp/lg-dict/LGDictNode.h>
+#include "LGParsePipeline.h"
+
+using namespace opencog;
+void error_handler(lg_errinfo *ei, void *data);
+
+LGParsePipeline::LGParsePipeline(const Handle& dict_node, AtomSpace* as,
+                                 size_t parsers, size_t converters,
+                                 int max_linkages, bool minimal,
+                                 const LGParsePolicy& policy)
+	: _dict_node(dict_node), _as(as),
+	  _max_linkages(max_linkages), _minimal(minimal), _policy(policy),
+	  _finished(false),
+	  _phrases(4 * std::max((size_t) 1, parsers)),
+	  _parsed(4 * std::max((size_t) 1, converters)),
+	  _results(64),
+	  _cancel(false), _num_sentences(0), _num_failed(0)
+{
+	if (nullptr == LgDictNodeCast(dict_node))
+		throw InvalidParamException(TRACE_INFO,
+			"LGParsePipeline: Expecting LgDictNode, got %s",
+			dict_node->to_string().c_str());
+
+	// Open the dictionary now, rather than in all the parsers at once.
+	LGParseLink::get_dictionary(dict_node);
+
+	parsers = std::max((size_t) 1, parsers);
+	converters = std::max((size_t) 1, converters);
+	_parsers_running = parsers;
+	_converters_running = converters;
+
+	for (size_t i = 0; i < parsers; i++)
+		_threads.push_back(std::thread(&LGParsePipeline::parse_work, this));
+	for (size_t i = 0; i < converters; i++)
+		_threads.push_back(std::thread(&LGParsePipeline::convert_work, this));
+}
+
+LGParsePipeline::~LGParsePipeline()
+{
+	stop();
+}
+
+/// Anyone waiting in feed() or next() returns; feed() drops the text.
+void LGParsePipeline::stop(void)
+{
+	_cancel = true;
+	_phrases.close();
+	_parsed.close();
+	_results.close();
+
+	std::lock_guard<std::mutex> lck(_join_mtx);
+	for (std::thread& th : _threads)
+		if (th.joinable()) th.join();
+}
+
+// ------------------------------------------------------
+
+void LGParsePipeline::feed(const std::string& text)
+{
+	if (_finished)
+		throw RuntimeException(TRACE_INFO,
+			"LGParsePipeline: Text fed after the end of the text");
+
+	_buffer += text;
+	split(false);
+}
+
+void LGParsePipeline::feed_file(const std::string& path)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (not in)
+		throw RuntimeException(TRACE_INFO,
+			"LGParsePipeline: Cannot open %s", path.c_str());
+
+	std::string chunk(1 << 16, '\0');
+	while (in.read(&chunk[0], chunk.size()) or 0 < in.gcount())
+	{
+		feed(chunk.substr(0, in.gcount()));
+		if (_cancel) break;
+	}
+}
+
+void LGParsePipeline::finish(void)
+{
+	if (_finished) return;
+	split(true);
+	_finished = true;
+	_phrases.close();
+}
+
+Handle LGParsePipeline::next(void)
+{
+	Handle snode;
+	if (_results.pop(snode)) return snode;
+	return Handle::UNDEFINED;
+}
+
+// ------------------------------------------------------
+
+/// Split the complete sentences off the front of the buffer, and hand
+/// them to the parsers.  A terminator at the very end of the buffer
+/// only ends a sentence at the end of the text, as the text to come
+/// may go on with it, as in "3.14".
+void LGParsePipeline::split(bool at_end)
+{
+	size_t size = _buffer.size();
+	size_t start = 0;
+	for (size_t i = 0; i < size; i++)
+	{
+		char c = _buffer[i];
+		size_t j = i + 1;
+		if ('.' == c or '!' == c or '?' == c)
+		{
+			// Closing quotes and brackets go with the sentence.
+			while (j < size and strchr("\"')]", _buffer[j])) j++;
+			if (j < size and not isspace((unsigned char) _buffer[j]))
+				continue;
+		}
+		else if ('\n' == c)
+		{
+			while (j < size and (' ' == _buffer[j] or '\t' == _buffer[j]
+			                     or '\r' == _buffer[j])) j++;
+			if (j < size and '\n' != _buffer[j])
+				continue;
+		}
+		else continue;
+
+		if (j == size and not at_end) break;
+
+		emit(_buffer.substr(start, j - start));
+		start = j;
+		i = j - 1;
+	}
+
+	if (at_end)
+	{
+		emit(_buffer.substr(start));
+		start = size;
+	}
+	_buffer.erase(0, start);
+}
+
+/// Hand a sentence to the parsers, with its white space tidied up.
+void LGParsePipeline::emit(const std::string& text)
+{
+	std::string phrase;
+	bool blank = false;
+	for (char c : text)
+	{
+		if (isspace((unsigned char) c))
+		{
+			blank = not phrase.empty();
+			continue;
+		}
+		if (blank) phrase += ' ';
+		blank = false;
+		phrase += c;
+	}
+	if (phrase.empty()) return;
+
+	if (_phrases.push(std::move(phrase)))
+		_num_sentences++;
+}
+
+// ------------------------------------------------------
+
+void LGParsePipeline::parse_work(void)
+{
+	// The error handler is per thread; see LGParseLink::execute()
+	lg_error_set_handler(error_handler, nullptr);
+	Parse_Options opts = LGParseLink::create_parse_options();
+
+	std::string phrase;
+	while (not _cancel and _phrases.pop(phrase))
+	{
+		Parsed p;
+		try
+		{
+			p.parses = LGParseLink::find_parses(phrase, _dict_node, opts,
+			                                    _policy, _max_linkages,
+			                                    _minimal, p.tlm);
+		}
+		catch (const StandardException& ex)
+		{
+			_num_failed++;
+			LAZY_LOG_WARN << "LGParsePipeline: failed to parse \""
+			              << phrase << "\": " << ex.get_message();
+			continue;
+		}
+		if (not _parsed.push(std::move(p))) break;
+	}
+
+	parse_options_delete(opts);
+	lg_error_flush();
+	lg_error_clearall();
+
+	// The last parser out tells the converters there is no more.
+	if (0 == --_parsers_running)
+		_parsed.close();
+}
+
+void LGParsePipeline::convert_work(void)
+{
+	LgDictNode& ldn = *LgDictNodeCast(_dict_node);
+
+	Parsed p;
+	while (not _cancel and _parsed.pop(p))
+	{
+		Handle snode;
+		try
+		{
+			snode = LGParseLink::place_parses(p.parses, ldn, _minimal,
+			                                  _as, p.tlm);
+		}
+		catch (const StandardException& ex)
+		{
+			_num_failed++;
+			LAZY_LOG_WARN << "LGParsePipeline: failed to place a parse: "
+			              << ex.get_message();
+			continue;
+		}
+		if (not _results.push(std::move(snode))) break;
+	}
+
+	if (0 == --_converters_running)
+		_results.close();
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,180 @@
+/*
+ * opencog/nlp/lg-parse/LGParsePipeline.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_PARSE_PIPELINE_H
+#define _OPENCOG_LG_PARSE_PIPELINE_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include "LGParseLink.h"
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// A queue holding at most so many items.  Pushing waits for room,
+/// and popping waits for an item.  Once closed, pushing fails, and
+/// popping fails when the queue has run empty.
+template<typename T>
+class LGBoundedQueue
+{
+public:
+	LGBoundedQueue(size_t capacity)
+		: _capacity(std::max((size_t) 1, capacity)), _closed(false) {}
+
+	bool push(T&& item)
+	{
+		std::unique_lock<std::mutex> lck(_mtx);
+		_not_full.wait(lck, [this]
+			{ return _closed or _items.size() < _capacity; });
+		if (_closed) return false;
+		_items.push_back(std::move(item));
+		_not_empty.notify_one();
+		return true;
+	}
+
+	bool pop(T& item)
+	{
+		std::unique_lock<std::mutex> lck(_mtx);
+		_not_empty.wait(lck, [this]
+			{ return _closed or not _items.empty(); });
+		if (_items.empty()) return false;
+		item = std::move(_items.front());
+		_items.pop_front();
+		_not_full.notify_one();
+		return true;
+	}
+
+	void close(void)
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_closed = true;
+		_not_full.notify_all();
+		_not_empty.notify_all();
+	}
+
+private:
+	std::mutex _mtx;
+	std::condition_variable _not_full;
+	std::condition_variable _not_empty;
+	std::deque<T> _items;
+	size_t _capacity;
+	bool _closed;
+};
+
+/// Parse a stream of text into the atomspace, in stages that run at
+/// the same time:
+///
+///    the reader, in the thread calling feed(), splits the text into
+///       sentences;
+///    the parsers run the Link Grammar parser on the sentences;
+///    the converters place the parses into the atomspace, as the
+///       LgParseLink does;
+///    the caller takes the SentenceNodes with next(), to hand them on
+///       to R2L, WSD and so on.
+///
+/// The stages are joined by bounded queues, so that a slow stage holds
+/// up the ones before it, rather than letting the text pile up.  The
+/// SentenceNodes come out in the order they were finished in, not in
+/// the order of the text.  Sentences the parser fails on are logged
+/// and left out.
+class LGParsePipeline
+{
+public:
+	LGParsePipeline(const Handle& dict_node, AtomSpace*,
+	                size_t parsers, size_t converters,
+	                int max_linkages, bool minimal,
+	                const LGParsePolicy&);
+	LGParsePipeline(const LGParsePipeline&) = delete;
+	LGParsePipeline& operator=(const LGParsePipeline&) = delete;
+	~LGParsePipeline();
+
+	// Add text to be parsed.  A sentence ends at a '.', '!' or '?'
+	// followed by white space, or at a blank line.  Waits while the
+	// parsers are behind.
+	void feed(const std::string&);
+	void feed_file(const std::string&);
+
+	// No more text; the last sentence need not be ended.
+	void finish(void);
+
+	// The next parsed SentenceNode, waiting for it if need be; or the
+	// undefined handle, once all of them have been taken.  This must
+	// be called until then, or else the converters will stall.
+	Handle next(void);
+
+	// Stop all the stages, dropping whatever they have not done yet.
+	void stop(void);
+
+	size_t num_sentences(void) const { return _num_sentences; }
+	size_t num_failed(void) const { return _num_failed; }
+
+private:
+	struct Parsed
+	{
+		LGParsedSentencePtr parses;
+		LGParseTelemetry tlm;
+	};
+
+	void split(bool);
+	void emit(const std::string&);
+	void parse_work(void);
+	void convert_work(void);
+
+	Handle _dict_node;
+	AtomSpace* _as;
+	int _max_linkages;
+	bool _minimal;
+	const LGParsePolicy& _policy;
+
+	std::string _buffer;
+	bool _finished;
+
+	LGBoundedQueue<std::string> _phrases;
+	LGBoundedQueue<Parsed> _parsed;
+	LGBoundedQueue<Handle> _results;
+
+	std::atomic<bool> _cancel;
+	std::atomic<size_t> _parsers_running;
+	std::atomic<size_t> _converters_running;
+	std::atomic<size_t> _num_sentences;
+	std::atomic<size_t> _num_failed;
+
+	std::mutex _join_mtx;
+	std::vector<std::thread> _threads;
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_LG_PARSE_PIPELINE_H
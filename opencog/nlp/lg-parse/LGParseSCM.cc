@@ -0,0 +1,380 @@
+/*
+ * opencog/nlp/lg-parse/LGParseSCM.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/guile/SchemePrimitive.h>
+#include <opencog/nlp/lg-dict/LGDictNode.h>
+
+#include "LGParseFuture.h"
+#include "LGParseLink.h"
+#include "LGParsePipeline.h"
+
+namespace opencog
+{
+class LGParseSCM
+{
+private:
+	static void* init_in_guile(void*);
+	static void init_in_module(void*);
+	void init(void);
+
+	std::shared_ptr<LGParsePipeline> get_pipeline(int, const char*);
+
+	int do_lg_pipeline_open(Handle, int, int, int, bool,
+	                        const std::string&);
+	void do_lg_pipeline_feed(int, const std::string&);
+	void do_lg_pipeline_feed_file(int, const std::string&);
+	void do_lg_pipeline_finish(int);
+	Handle do_lg_pipeline_next(int);
+	int do_lg_pipeline_close(int);
+	void do_lg_set_compact_naming(bool);
+
+	LGParseFuturePtr get_future(int, const char*);
+	Handle take_result(int, const LGParseFuturePtr&);
+
+	int do_lg_parse_async(Handle, double);
+	std::string do_lg_parse_status(int);
+	Handle do_lg_parse_poll(int);
+	Handle do_lg_parse_wait(int, double);
+	bool do_lg_parse_cancel(int);
+
+	// The pipelines opened, and the parses started, from scheme, by
+	// their ids.
+	std::mutex _mtx;
+	std::map<int, std::shared_ptr<LGParsePipeline>> _pipelines;
+	std::map<int, LGParseFuturePtr> _futures;
+	int _next_id;
+
+public:
+	LGParseSCM();
+};
+
+}
+
+using namespace opencog;
+
+/**
+ * The constructor for LGParseSCM.
+ */
+LGParseSCM::LGParseSCM() : _next_id(1)
+{
+	static bool is_init = false;
+	if (is_init) return;
+	is_init = true;
+	scm_with_guile(init_in_guile, this);
+}
+
+/**
+ * Init function for using with scm_with_guile.
+ *
+ * Creates the lg-parse scheme module and uses it by default.
+ *
+ * @param self   pointer to the LGParseSCM object
+ * @return       null
+ */
+void* LGParseSCM::init_in_guile(void* self)
+{
+	scm_c_define_module("opencog nlp lg-parse", init_in_module, self);
+	scm_c_use_module("opencog nlp lg-parse");
+	return NULL;
+}
+
+/**
+ * The main function for defining stuff in the lg-parse scheme module.
+ *
+ * @param data   pointer to the LGParseSCM object
+ */
+void LGParseSCM::init_in_module(void* data)
+{
+	LGParseSCM* self = (LGParseSCM*) data;
+	self->init();
+}
+
+/**
+ * The main init function for the LGParseSCM object.
+ */
+void LGParseSCM::init()
+{
+	define_scheme_primitive("lg-pipeline-open",
+		 &LGParseSCM::do_lg_pipeline_open, this, "nlp lg-parse");
+	define_scheme_primitive("lg-pipeline-feed",
+		 &LGParseSCM::do_lg_pipeline_feed, this, "nlp lg-parse");
+	define_scheme_primitive("lg-pipeline-feed-file",
+		 &LGParseSCM::do_lg_pipeline_feed_file, this, "nlp lg-parse");
+	define_scheme_primitive("lg-pipeline-finish",
+		 &LGParseSCM::do_lg_pipeline_finish, this, "nlp lg-parse");
+	define_scheme_primitive("lg-pipeline-next",
+		 &LGParseSCM::do_lg_pipeline_next, this, "nlp lg-parse");
+	define_scheme_primitive("lg-pipeline-close",
+		 &LGParseSCM::do_lg_pipeline_close, this, "nlp lg-parse");
+	define_scheme_primitive("lg-set-compact-naming",
+		 &LGParseSCM::do_lg_set_compact_naming, this, "nlp lg-parse");
+	define_scheme_primitive("lg-parse-async",
+		 &LGParseSCM::do_lg_parse_async, this, "nlp lg-parse");
+	define_scheme_primitive("lg-parse-status",
+		 &LGParseSCM::do_lg_parse_status, this, "nlp lg-parse");
+	define_scheme_primitive("lg-parse-poll",
+		 &LGParseSCM::do_lg_parse_poll, this, "nlp lg-parse");
+	define_scheme_primitive("lg-parse-wait",
+		 &LGParseSCM::do_lg_parse_wait, this, "nlp lg-parse");
+	define_scheme_primitive("lg-parse-cancel",
+		 &LGParseSCM::do_lg_parse_cancel, this, "nlp lg-parse");
+}
+
+std::shared_ptr<LGParsePipeline> LGParseSCM::get_pipeline(int id,
+                                                          const char* fn)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	auto it = _pipelines.find(id);
+	if (it == _pipelines.end())
+		throw InvalidParamException(TRACE_INFO,
+			"%s: No such pipeline: %d", fn, id);
+	return it->second;
+}
+
+/**
+ * Implementation of the "lg-pipeline-open" scheme primitive.
+ *
+ * @param h           the LgDictNode
+ * @param parsers     the no. of parser threads
+ * @param converters  the no. of threads placing parses in the atomspace
+ * @param linkages    the no. of linkages to keep; 0 for all
+ * @param minimal     whether to place only the minimal parses
+ * @param policy      the name of the parse policy; empty for the one
+ *                    on the LgDictNode
+ * @return            the id of the pipeline
+ */
+int LGParseSCM::do_lg_pipeline_open(Handle h, int parsers, int converters,
+                                    int linkages, bool minimal,
+                                    const std::string& policy)
+{
+	if (nullptr == LgDictNodeCast(h))
+		throw InvalidParamException(TRACE_INFO,
+			"lg-pipeline-open: Expecting LgDictNode, got %s",
+			h->to_string().c_str());
+
+	const LGParsePolicy& pol = policy.empty() ?
+		LGParsePolicy::find(h, Handle::UNDEFINED) :
+		LGParsePolicy::find(policy);
+
+	AtomSpace* as = SchemeSmob::ss_get_env_as("lg-pipeline-open");
+	auto pipeline = std::make_shared<LGParsePipeline>(h, as,
+		0 < parsers ? parsers : 1, 0 < converters ? converters : 1,
+		linkages, minimal, pol);
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	int id = _next_id++;
+	_pipelines[id] = pipeline;
+	return id;
+}
+
+/**
+ * Implementation of the "lg-pipeline-feed" scheme primitive.
+ *
+ * @param id     the pipeline
+ * @param text   more text to parse
+ */
+void LGParseSCM::do_lg_pipeline_feed(int id, const std::string& text)
+{
+	get_pipeline(id, "lg-pipeline-feed")->feed(text);
+}
+
+/**
+ * Implementation of the "lg-pipeline-feed-file" scheme primitive.
+ *
+ * @param id     the pipeline
+ * @param path   a file of text to parse
+ */
+void LGParseSCM::do_lg_pipeline_feed_file(int id, const std::string& path)
+{
+	get_pipeline(id, "lg-pipeline-feed-file")->feed_file(path);
+}
+
+void LGParseSCM::do_lg_pipeline_finish(int id)
+{
+	get_pipeline(id, "lg-pipeline-finish")->finish();
+}
+
+/**
+ * Implementation of the "lg-pipeline-next" scheme primitive.
+ *
+ * @param id     the pipeline
+ * @return       the next parsed SentenceNode, or the empty list once
+ *               all of them have been taken
+ */
+Handle LGParseSCM::do_lg_pipeline_next(int id)
+{
+	return get_pipeline(id, "lg-pipeline-next")->next();
+}
+
+/**
+ * Implementation of the "lg-pipeline-close" scheme primitive.
+ * Whatever the pipeline has not done yet is dropped.
+ *
+ * @param id     the pipeline
+ * @return       the no. of sentences that failed to parse
+ */
+int LGParseSCM::do_lg_pipeline_close(int id)
+{
+	std::shared_ptr<LGParsePipeline> pipeline;
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		auto it = _pipelines.find(id);
+		if (it == _pipelines.end()) return 0;
+		pipeline = it->second;
+		_pipelines.erase(it);
+	}
+
+	// Whatever is still feeding it, or waiting on it, lets go now.
+	pipeline->stop();
+	return pipeline->num_failed();
+}
+
+/**
+ * Implementation of the "lg-set-compact-naming" scheme primitive.
+ * The StringValue on an LgDictNode, if any, takes precedence.
+ *
+ * @param compact  whether to name the atoms of all parses compactly
+ */
+void LGParseSCM::do_lg_set_compact_naming(bool compact)
+{
+	LGParseLink::set_compact_naming(compact);
+}
+
+LGParseFuturePtr LGParseSCM::get_future(int id, const char* fn)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	auto it = _futures.find(id);
+	if (it == _futures.end())
+		throw InvalidParamException(TRACE_INFO,
+			"%s: No such parse: %d", fn, id);
+	return it->second;
+}
+
+/**
+ * The SentenceNode of a parse that is over, or the empty list if it
+ * isn't over, or was cancelled or ran out of time.  The id is let go
+ * of once the parse is over.  A parse that failed throws.
+ */
+Handle LGParseSCM::take_result(int id, const LGParseFuturePtr& fut)
+{
+	LGParseFuture::Status status = fut->status();
+	if (LGParseFuture::PENDING == status or
+	    LGParseFuture::RUNNING == status)
+		return Handle::UNDEFINED;
+
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_futures.erase(id);
+	}
+
+	if (LGParseFuture::FAILED == status)
+		throw RuntimeException(TRACE_INFO,
+			"lg-parse: Parse %d failed: %s", id, fut->error().c_str());
+	return fut->result();
+}
+
+/**
+ * Implementation of the "lg-parse-async" scheme primitive.
+ *
+ * @param h         the LgParseLink or LgParseMinimal
+ * @param deadline  seconds to give it, from now; 0 for no deadline
+ * @return          the id of the parse
+ */
+int LGParseSCM::do_lg_parse_async(Handle h, double deadline)
+{
+	AtomSpace* as = SchemeSmob::ss_get_env_as("lg-parse-async");
+	LGParseFuturePtr fut(LGParseFuture::start(h, as, deadline));
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	int id = _next_id++;
+	_futures[id] = fut;
+	return id;
+}
+
+/**
+ * Implementation of the "lg-parse-status" scheme primitive.
+ *
+ * @param id   the parse
+ * @return     one of "pending", "running", "done", "failed",
+ *             "cancelled" or "expired"
+ */
+std::string LGParseSCM::do_lg_parse_status(int id)
+{
+	return LGParseFuture::status_name(
+		get_future(id, "lg-parse-status")->status());
+}
+
+/**
+ * Implementation of the "lg-parse-poll" scheme primitive.
+ * Doesn't wait; see take_result().
+ */
+Handle LGParseSCM::do_lg_parse_poll(int id)
+{
+	return take_result(id, get_future(id, "lg-parse-poll"));
+}
+
+/**
+ * Implementation of the "lg-parse-wait" scheme primitive.
+ *
+ * @param id       the parse
+ * @param timeout  seconds to wait at most; negative for no limit
+ * @return         see take_result()
+ */
+Handle LGParseSCM::do_lg_parse_wait(int id, double timeout)
+{
+	LGParseFuturePtr fut(get_future(id, "lg-parse-wait"));
+	fut->wait(timeout);
+	return take_result(id, fut);
+}
+
+/**
+ * Implementation of the "lg-parse-cancel" scheme primitive.
+ * The id is let go of.
+ *
+ * @param id   the parse
+ * @return     false if the parse was over already
+ */
+bool LGParseSCM::do_lg_parse_cancel(int id)
+{
+	LGParseFuturePtr fut;
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		auto it = _futures.find(id);
+		if (it == _futures.end()) return false;
+		fut = it->second;
+		_futures.erase(it);
+	}
+	return fut->cancel();
+}
+
+extern "C" {
+void opencog_nlp_lgparse_scm_init(void)
+{
+	static LGParseSCM lgparse;
+}
+};
@@ -8,3 +8,136 @@
 (use-modules (opencog) (opencog oc-config) (opencog nlp))
 
 (load-extension (string-append opencog-ext-path-lg-parse "liblg-parse") "opencog_nlp_lgparse_init")
+(load-extension (string-append opencog-ext-path-lg-parse "liblg-parse") "opencog_nlp_lgparse_scm_init")
+
+(use-modules (ice-9 threads) (rnrs io ports))
+
+; ---------------------------------------------------------------------
+
+(define* (lg-parse-corpus SOURCE #:key
+		(dict (LgDictNode "en"))
+		(parsers (current-processor-count))
+		(converters 2)
+		(linkages 4)
+		(minimal #f)
+		(policy "")
+		(hook #f))
+"
+  lg-parse-corpus SOURCE [#:dict DICT] [#:parsers N] [#:converters M]
+                  [#:linkages L] [#:minimal BOOL] [#:policy NAME]
+                  [#:hook PROC]
+
+  Parse all of the text in SOURCE, a file name or an input port, into
+  the AtomSpace, and return the number of sentences parsed.  The text
+  is split into sentences at a '.', '!' or '?' followed by white space,
+  and at blank lines.
+
+  The sentences are parsed by N threads, and the parses are placed in
+  the AtomSpace by M other threads, at the same time as the text is
+  read; the stages are joined by bounded queues, so that the text is
+  only read as fast as it can be parsed.  The parses are the same as
+  those of the LgParseLink, or of the LgParseMinimal if BOOL is true.
+
+  If PROC is given, it is called with the SentenceNode of each parsed
+  sentence, in the order the parses were finished in, while the rest
+  are still being parsed.  This is the place to hand them on to R2L
+  or WSD, for example:
+
+     (lg-parse-corpus \"corpus.txt\" #:hook r2l-parse)
+
+  The defaults are (LgDictNode \"en\"), one parser per processor, two
+  converters, four linkages, full parses, and the parse policy on the
+  LgDictNode, or else \"batch\".  Sentences that fail to parse are
+  logged and left out.
+"
+	(let ()
+		(define id
+			(lg-pipeline-open dict parsers converters linkages minimal policy))
+
+		; Read the text in a thread of its own, so that it can wait for
+		; the parsers while the parses are taken below.
+		(define (feed)
+			(if (string? SOURCE)
+				(lg-pipeline-feed-file id SOURCE)
+				(let loop ((text (get-string-n SOURCE 65536)))
+					(if (not (eof-object? text))
+						(begin
+							(lg-pipeline-feed id text)
+							(loop (get-string-n SOURCE 65536))))))
+			(lg-pipeline-finish id)
+			#f)
+
+		(define feeder
+			(call-with-new-thread
+				(lambda ()
+					(catch #t feed
+						(lambda (key . args)
+							(lg-pipeline-finish id)
+							(cons key args))))))
+
+		(define (take count)
+			(define sent (lg-pipeline-next id))
+			(if (null? sent)
+				count
+				(begin
+					(if hook (hook sent))
+					(take (+ count 1)))))
+
+		(define count
+			(dynamic-wind
+				(lambda () #f)
+				(lambda () (take 0))
+				(lambda () (lg-pipeline-close id))))
+
+		(define failure (join-thread feeder))
+		(if failure (apply throw failure))
+		count))
+
+(export lg-parse-corpus)
+
+; ---------------------------------------------------------------------
+
+(set-procedure-property! lg-parse-async 'documentation
+"
+  lg-parse-async LINK SECS -- start executing the LgParseLink or
+  LgParseMinimal LINK in the background, and return an id for it at
+  once, without waiting for the parser. If SECS is positive, the parse
+  gives up SECS seconds from now: it isn't started if it is still
+  queued by then, and the budget of its parse policy is cut to what is
+  left. The id is for lg-parse-poll, lg-parse-wait, lg-parse-status
+  and lg-parse-cancel, for example:
+
+     (define id (lg-parse-async
+        (LgParseLink (PhraseNode \"this is a test.\") (LgDictNode \"en\"))
+        5))
+     (lg-parse-wait id -1)
+")
+
+(set-procedure-property! lg-parse-status 'documentation
+"
+  lg-parse-status ID -- how the parse ID is doing: one of \"pending\",
+  \"running\", \"done\", \"failed\", \"cancelled\" or \"expired\".
+")
+
+(set-procedure-property! lg-parse-poll 'documentation
+"
+  lg-parse-poll ID -- the SentenceNode of the parse ID if it is done,
+  without waiting for it. The empty list is returned if it isn't over
+  yet, and if it was cancelled, or ran out of time. Once it is over,
+  the ID is let go of; if the parse failed, this throws.
+")
+
+(set-procedure-property! lg-parse-wait 'documentation
+"
+  lg-parse-wait ID SECS -- as lg-parse-poll, but wait up to SECS
+  seconds for the parse ID to be over; for as long as it takes if SECS
+  is negative.
+")
+
+(set-procedure-property! lg-parse-cancel 'documentation
+"
+  lg-parse-cancel ID -- stop the parse ID, and let go of the ID.
+  A parse that is running stops at the end of its pass of the parser,
+  and its parses are not placed in the atomspace. Returns #f if the
+  parse was over already.
+")
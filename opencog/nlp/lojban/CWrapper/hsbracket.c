@@ -1,11 +1,18 @@
 #include <HsFFI.h>
+#include <Rts.h>
 
 static void my_enter(void) __attribute__((constructor));
 static void my_enter(void)
 {
   static char *argv[] = { "libopencog-lojban.so", 0 }, **argv_ = argv;
   static int argc = 1;
-  hs_init(&argc, &argv_);
+
+  /* A capability for each core, so that lojban_parse called from
+   * several threads runs in parallel. */
+  RtsConfig conf = defaultRtsConfig;
+  conf.rts_opts_enabled = RtsOptsAll;
+  conf.rts_opts = "-N";
+  hs_init_ghc(&argc, &argv_, conf);
 }
 
 static void my_exit(void) __attribute__((destructor));
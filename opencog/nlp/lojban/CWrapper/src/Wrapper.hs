@@ -6,6 +6,7 @@ import OpenCog.AtomSpace
 import System.Random
 
 import Foreign.C
+import Foreign.Marshal.Array
 import Foreign.Ptr
 import Foreign.StablePtr
 
@@ -16,7 +17,23 @@ foreign export ccall "lojban_parse" c_parse :: Ptr AtomSpaceRef
                                      -> CString
                                      -> IO Handle
 
-foreign export ccall "lojban_print" c_print :: Ptr AtomSpaceRef
+foreign export ccall "lojban_parse_batch" c_parse_batch :: Ptr AtomSpaceRef
+                                     -> StablePtr WordList
+                                     -> CInt
+                                     -> Ptr CString
+                                     -> Ptr Handle
+                                     -> IO ()
+
+foreign export ccall "lojban_print" -- Parse n sentences in one call, putting the handle of each, or
+-- nullPtr, into the array given.
+c_parse_batch :: Ptr AtomSpaceRef -> StablePtr WordList -> CInt
+              -> Ptr CString -> Ptr Handle -> IO ()
+c_parse_batch asRef swl n ctexts out = do
+    ctextl <- peekArray (fromIntegral n) ctexts
+    handles <- mapM (c_parse asRef swl) ctextl
+    pokeArray out handles
+
+c_print :: Ptr AtomSpaceRef
                                      -> StablePtr WordList
                                      -> Handle
                                      -> IO CString
@@ -23,9 +23,16 @@
 
 #include "LojbanModule.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <thread>
 #include <sys/stat.h>
 
+#include <opencog/util/Logger.h>
+
 
 using namespace opencog::nlp;
 using namespace opencog;
@@ -38,7 +45,8 @@ DECLARE_MODULE(LojbanModule);
  * @param cs   the OpenCog server
  */
 LojbanModule::LojbanModule(CogServer& cs) :
-        Module(cs) , _cs(cs) , _as(&cs.getAtomSpace()) , scmeval(_as)
+        Module(cs) , _load_lines(0) , _load_parsed(0) , _load_failed(0) ,
+        _cs(cs) , _as(&cs.getAtomSpace()) , scmeval(_as)
 {
     _wordlist = lojban_init();
 }
@@ -51,6 +59,9 @@ LojbanModule::~LojbanModule()
     lojban_exit(_wordlist);
     do_load_lojban_unregister();
     do_parse_lojban_unregister();
+    do_load_lojban_bulk_unregister();
+    do_parse_lojban_batch_unregister();
+    do_lojban_parse_cache_unregister();
 }
 
 /**
@@ -60,6 +71,9 @@ void LojbanModule::init(void)
 {
     do_load_lojban_register();
     do_parse_lojban_register();
+    do_load_lojban_bulk_register();
+    do_parse_lojban_batch_register();
+    do_lojban_parse_cache_register();
 }
 
 
@@ -68,12 +82,123 @@ std::string LojbanModule::do_parse_lojban(Request *req, std::list<std::string> a
     std::string sentence;
     for (const auto& a: args) sentence += a + " ";
 
-    Handle * hptr = lojban_parse(_as,_wordlist,sentence.c_str());
+    Handle h = parse_lojban(sentence);
 
-    if (!hptr or (*hptr) == Handle::UNDEFINED)
+    if (h == Handle::UNDEFINED)
         return "Parsing Failed";
     else
-        return (*hptr)->to_string();
+        return h->to_string();
+}
+
+std::string LojbanModule::do_parse_lojban_batch(Request *req, std::list<std::string> args)
+{
+    std::vector<std::string> sentences(1);
+    for (const auto& a: args)
+    {
+        if (";" == a)
+            sentences.emplace_back();
+        else
+            sentences.back() += a + " ";
+    }
+
+    std::string reply;
+    for (const Handle& h : parse_lojban_batch(sentences))
+    {
+        if (h == Handle::UNDEFINED)
+            reply += "Parsing Failed\n";
+        else
+            reply += h->to_string();
+    }
+    return reply;
+}
+
+std::string LojbanModule::do_lojban_parse_cache(Request *req, std::list<std::string> args)
+{
+    if (not args.empty())
+    {
+        set_parse_cache(std::stoul(args.front()));
+        return "";
+    }
+
+    std::shared_ptr<LojbanParseCache> cache(get_parse_cache());
+    if (nullptr == cache)
+        return "The parse cache is off\n";
+    return "hits: " + std::to_string(cache->hits()) +
+        " misses: " + std::to_string(cache->misses()) +
+        " size: " + std::to_string(cache->size()) + "\n";
+}
+
+void LojbanModule::set_parse_cache(size_t max_entries)
+{
+    std::lock_guard<std::mutex> lck(_cache_mtx);
+    if (0 == max_entries)
+        _cache = nullptr;
+    else
+        _cache = std::make_shared<LojbanParseCache>(max_entries);
+}
+
+std::shared_ptr<LojbanParseCache> LojbanModule::get_parse_cache(void)
+{
+    std::lock_guard<std::mutex> lck(_cache_mtx);
+    return _cache;
+}
+
+// What lojban_parse returned, as a handle
+static Handle result_handle(Handle * hptr)
+{
+    if (!hptr) return Handle::UNDEFINED;
+    return *hptr;
+}
+
+Handle LojbanModule::parse_lojban(const std::string& sentence)
+{
+    std::shared_ptr<LojbanParseCache> cache(get_parse_cache());
+    if (nullptr == cache)
+        return result_handle(lojban_parse(_as, _wordlist, sentence.c_str()));
+
+    std::string key(LojbanParseCache::normalize(sentence));
+    Handle h(cache->find(key));
+    if (h) return h;
+
+    h = result_handle(lojban_parse(_as, _wordlist, key.c_str()));
+    cache->insert(key, h);
+    return h;
+}
+
+HandleSeq LojbanModule::parse_lojban_batch(const std::vector<std::string>& sentences)
+{
+    std::shared_ptr<LojbanParseCache> cache(get_parse_cache());
+    HandleSeq results(sentences.size());
+
+    // The sentences for the parser, and where their results go.
+    std::vector<std::string> keys;
+    std::vector<size_t> where;
+    for (size_t i = 0; i < sentences.size(); i++)
+    {
+        std::string key(LojbanParseCache::normalize(sentences[i]));
+        if (cache)
+        {
+            results[i] = cache->find(key);
+            if (results[i]) continue;
+        }
+        keys.emplace_back(std::move(key));
+        where.push_back(i);
+    }
+    if (keys.empty()) return results;
+
+    std::vector<const char *> texts;
+    for (const std::string& key : keys)
+        texts.push_back(key.c_str());
+    std::vector<Handle *> parsed(keys.size(), nullptr);
+    lojban_parse_batch(_as, _wordlist, keys.size(), texts.data(),
+                       parsed.data());
+
+    for (size_t j = 0; j < keys.size(); j++)
+    {
+        results[where[j]] = result_handle(parsed[j]);
+        if (cache) cache->insert(keys[j], results[where[j]]);
+    }
+    return results;
 }
 
 std::string LojbanModule::do_load_lojban(Request *req, std::list<std::string> args)
@@ -95,3 +220,163 @@ std::string LojbanModule::do_load_lojban(Request *req, std::list<std::string> ar
 
     return "";
 }
+
+std::string LojbanModule::do_load_lojban_bulk(Request *req, std::list<std::string> args)
+{
+    if (args.empty())
+        return "Usage: load-lojban-bulk path [threads]\n";
+
+    std::string path = args.front();
+    size_t num_threads = 0;
+    if (1 < args.size())
+        num_threads = std::stoul(*std::next(args.begin()));
+
+    std::ifstream file(path);
+    if (not file)
+        return "Can't open " + path + "\n";
+    file.close();
+
+    LoadStats ls = load_lojban_bulk(path, num_threads);
+    return "Parsed " + std::to_string(ls.parsed) + " of " +
+        std::to_string(ls.lines) + " lines in " +
+        std::to_string(ls.seconds) + " seconds\n";
+}
+
+// The lines handed to a thread at a time
+#define LOAD_BATCH 256
+
+// The bytes read from the file at a time
+#define LOAD_BLOCK (1 << 20)
+
+// The lines between progress reports
+#define LOAD_REPORT 10000
+
+void LojbanModule::parse_lines(const std::vector<std::string>& lines)
+{
+    size_t parsed = 0;
+    for (const std::string& line : lines)
+    {
+        Handle * hptr = lojban_parse(_as, _wordlist, line.c_str());
+        if (hptr and (*hptr) != Handle::UNDEFINED)
+            parsed++;
+    }
+
+    size_t before = _load_lines.fetch_add(lines.size());
+    _load_parsed += parsed;
+    _load_failed += lines.size() - parsed;
+
+    if (before / LOAD_REPORT != (before + lines.size()) / LOAD_REPORT)
+        logger().info("[Lojban] Loaded %zu lines, %zu failed to parse",
+                      before + lines.size(), _load_failed.load());
+}
+
+/**
+ * The parser is reentrant: the word list is only read, the atomspace
+ * takes care of itself, and the Haskell runtime, being threaded, runs
+ * the calls from each thread on a capability of its own.
+ */
+LojbanModule::LoadStats LojbanModule::load_lojban_bulk(const std::string& path,
+                                                      size_t num_threads)
+{
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+
+    if (0 == num_threads) num_threads = std::thread::hardware_concurrency();
+    if (0 == num_threads) num_threads = 1;
+
+    _load_lines = 0;
+    _load_parsed = 0;
+    _load_failed = 0;
+
+    // The batches waiting; no more than a couple for each thread, so
+    // that the file is not read far ahead of the parsers.
+    std::mutex mtx;
+    std::condition_variable not_empty, not_full;
+    std::deque<std::vector<std::string>> batches;
+    bool done = false;
+    size_t max_waiting = 2 * num_threads;
+
+    auto work = [&]()
+    {
+        while (true)
+        {
+            std::vector<std::string> batch;
+            {
+                std::unique_lock<std::mutex> lck(mtx);
+                not_empty.wait(lck, [&] { return done or not batches.empty(); });
+                if (batches.empty()) return;
+                batch = std::move(batches.front());
+                batches.pop_front();
+            }
+            not_full.notify_one();
+            parse_lines(batch);
+        }
+    };
+
+    auto hand_out = [&](std::vector<std::string>& batch)
+    {
+        {
+            std::unique_lock<std::mutex> lck(mtx);
+            not_full.wait(lck, [&] { return batches.size() < max_waiting; });
+            batches.push_back(std::move(batch));
+        }
+        not_empty.notify_one();
+        batch.clear();
+        batch.reserve(LOAD_BATCH);
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < num_threads; i++)
+        threads.emplace_back(work);
+
+    // Read the file a block at a time, keeping the start of the line
+    // that runs past the end of each block for the next one.
+    std::ifstream file(path, std::ios::binary);
+    std::string block(LOAD_BLOCK, '\0');
+    std::string partial;
+    std::vector<std::string> batch;
+    batch.reserve(LOAD_BATCH);
+    while (file)
+    {
+        file.read(&block[0], block.size());
+        size_t got = file.gcount();
+
+        size_t begin = 0;
+        for (size_t nl = block.find('\n'); nl < got; nl = block.find('\n', begin))
+        {
+            partial.append(block, begin, nl - begin);
+            if (not partial.empty() and '\r' == partial.back())
+                partial.pop_back();
+            if (not partial.empty())
+                batch.emplace_back(std::move(partial));
+            partial.clear();
+            begin = nl + 1;
+
+            if (LOAD_BATCH <= batch.size())
+                hand_out(batch);
+        }
+        partial.append(block, begin, got - begin);
+    }
+    if (not partial.empty())
+        batch.emplace_back(std::move(partial));
+    if (not batch.empty())
+        hand_out(batch);
+
+    {
+        std::lock_guard<std::mutex> lck(mtx);
+        done = true;
+    }
+    not_empty.notify_all();
+    for (std::thread& t : threads)
+        t.join();
+
+    LoadStats ls;
+    ls.lines = _load_lines;
+    ls.parsed = _load_parsed;
+    ls.failed = _load_failed;
+    ls.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    logger().info("[Lojban] Loaded %s: %zu lines, %zu parsed, in %g seconds",
+                  path.c_str(), ls.lines, ls.parsed, ls.seconds);
+    return ls;
+}
@@ -24,6 +24,12 @@
 #ifndef _OPENCOG_LOJBAN_MODULE_H
 #define _OPENCOG_LOJBAN_MODULE_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include <opencog/cogserver/server/Module.h>
 #include <opencog/cogserver/server/Factory.h>
 #include <opencog/cogserver/server/CogServer.h>
@@ -34,6 +40,7 @@
 #include <opencog/guile/SchemeEval.h>
 
 #include "LojbanParser.h"
+#include "LojbanParseCache.h"
 
 namespace opencog
 {
@@ -48,10 +55,32 @@ namespace nlp
  */
 class LojbanModule : public Module
 {
+public:
+    /// What a bulk load did, so far, or in all.
+    struct LoadStats
+    {
+        size_t lines;
+        size_t parsed;
+        size_t failed;
+        double seconds;
+    };
+
 private:
 
     HsStablePtr _wordlist;
 
+    // The progress of the bulk load running, if any.
+    std::atomic<size_t> _load_lines;
+    std::atomic<size_t> _load_parsed;
+    std::atomic<size_t> _load_failed;
+
+    void parse_lines(const std::vector<std::string>&);
+
+    // The atoms of the sentences parsed last, if caching.
+    std::mutex _cache_mtx;
+    std::shared_ptr<LojbanParseCache> _cache;
+    std::shared_ptr<LojbanParseCache> get_parse_cache(void);
+
     CogServer & _cs;
     AtomSpace * _as;
 
@@ -67,12 +96,54 @@ public:
                         "Parse a Lojban Sentence to Atomese.\n",
                         "Usage: parse-lojban sentence\n", false, true)
 
+    DECLARE_CMD_REQUEST(LojbanModule, "parse-lojban-batch", do_parse_lojban_batch,
+                        "Parse several Lojban Sentences to Atomese.\n",
+                        "Usage: parse-lojban-batch sentence ; sentence ; ...\n",
+                        false, true)
+
+    DECLARE_CMD_REQUEST(LojbanModule, "lojban-parse-cache", do_lojban_parse_cache,
+                        "Cache the atoms of the Lojban sentences parsed last.\n",
+                        "Usage: lojban-parse-cache [size]\n"
+                        "With a size, cache that many sentences; 0 turns "
+                        "the cache off.\nWithout, print how well the "
+                        "cache does.\n", false, true)
+
+    DECLARE_CMD_REQUEST(LojbanModule, "load-lojban-bulk", do_load_lojban_bulk,
+                        "Load Lojban Data for learning, parsing it on "
+                        "several threads.\n",
+                        "Usage: load-lojban-bulk path [threads]\n", false, true)
+
     LojbanModule(CogServer&);
     virtual ~LojbanModule();
 
     const char * id(void);
     virtual void init(void);
 
+    /**
+     * Parse each line of the file into the atomspace, on so many
+     * threads, or as many as there are cores, if 0. The file is read
+     * in large blocks, and the lines handed out in batches; progress
+     * is logged every so many lines, rather than printed.
+     */
+    LoadStats load_lojban_bulk(const std::string& path, size_t num_threads);
+
+    /// The atom of the sentence, or undefined if it doesn't parse.
+    Handle parse_lojban(const std::string&);
+
+    /**
+     * The atoms of the sentences, undefined for those that don't
+     * parse. The sentences not in the cache are handed to the parser
+     * all at once.
+     */
+    HandleSeq parse_lojban_batch(const std::vector<std::string>&);
+
+    /**
+     * Keep the atoms of the last max_entries sentences parsed, so that
+     * a sentence parsed again gets the same atom, without the parser.
+     * Setting it drops what was cached; 0, the default, turns it off.
+     */
+    void set_parse_cache(size_t max_entries);
+
 };
 
 }
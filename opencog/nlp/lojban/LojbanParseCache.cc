@@ -0,0 +1,121 @@
+/*
+ * LojbanParseCache.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cctype>
+
+#include "LojbanParseCache.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+LojbanParseCache::LojbanParseCache(size_t max_entries)
+    : _max_entries(max_entries), _hits(0), _misses(0)
+{
+}
+
+/**
+ * The words of the sentence, separated by single blanks.  Nothing else
+ * is changed, as capitals mark the stress in Lojban.
+ */
+std::string LojbanParseCache::normalize(const std::string& sentence)
+{
+    std::string key;
+    bool blank = false;
+    for (char c : sentence)
+    {
+        if (isspace((unsigned char) c))
+        {
+            blank = not key.empty();
+            continue;
+        }
+        if (blank) key += ' ';
+        blank = false;
+        key += c;
+    }
+    return key;
+}
+
+Handle LojbanParseCache::find(const std::string& key)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    auto it = _entries.find(key);
+    if (it == _entries.end())
+    {
+        _misses++;
+        return Handle::UNDEFINED;
+    }
+
+    // Removed from the atomspace since; it has to be parsed again.
+    Handle h(it->second->second);
+    if (nullptr == h->getAtomSpace())
+    {
+        _lru.erase(it->second);
+        _entries.erase(it);
+        _misses++;
+        return Handle::UNDEFINED;
+    }
+
+    _hits++;
+    _lru.splice(_lru.begin(), _lru, it->second);
+    return h;
+}
+
+void LojbanParseCache::insert(const std::string& key, const Handle& h)
+{
+    if (0 == _max_entries or nullptr == h) return;
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    auto it = _entries.find(key);
+    if (it != _entries.end())
+    {
+        it->second->second = h;
+        _lru.splice(_lru.begin(), _lru, it->second);
+        return;
+    }
+
+    _lru.emplace_front(key, h);
+    _entries[key] = _lru.begin();
+
+    if (_entries.size() > _max_entries)
+    {
+        _entries.erase(_lru.back().first);
+        _lru.pop_back();
+    }
+}
+
+size_t LojbanParseCache::hits(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    return _hits;
+}
+
+size_t LojbanParseCache::misses(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    return _misses;
+}
+
+size_t LojbanParseCache::size(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    return _entries.size();
+}
@@ -0,0 +1,74 @@
+/*
+ * LojbanParseCache.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the
+ * exceptions at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LOJBAN_PARSE_CACHE_H
+#define _OPENCOG_LOJBAN_PARSE_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+namespace nlp
+{
+
+/**
+ * The atoms the Lojban parser made of the sentences seen last, so that
+ * a sentence seen again is not parsed again.  The sentences are looked
+ * up with their white space normalized.  When full, the least recently
+ * used sentence is dropped; an atom no longer in its atomspace is not
+ * returned.
+ */
+class LojbanParseCache
+{
+public:
+    LojbanParseCache(size_t max_entries);
+
+    static std::string normalize(const std::string&);
+
+    /// The atom of the normalized sentence, or undefined.
+    Handle find(const std::string&);
+    void insert(const std::string&, const Handle&);
+
+    size_t hits(void);
+    size_t misses(void);
+    size_t size(void);
+
+private:
+    typedef std::list<std::pair<std::string, Handle>> LRUList;
+
+    std::mutex _mtx;
+    size_t _max_entries;
+    LRUList _lru;
+    std::unordered_map<std::string, LRUList::iterator> _entries;
+    size_t _hits;
+    size_t _misses;
+};
+
+}
+}
+
+#endif // _OPENCOG_LOJBAN_PARSE_CACHE_H
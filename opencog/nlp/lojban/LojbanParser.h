@@ -26,6 +26,11 @@ extern "C"
 {
     opencog::Handle *lojban_parse(opencog::AtomSpace *, HsStablePtr, const char *);
 
+    // Parse n sentences; the result of each, as lojban_parse would
+    // return it, goes into the array of n results.
+    void lojban_parse_batch(opencog::AtomSpace *, HsStablePtr, int,
+                            const char **, opencog::Handle **);
+
     char* lojban_print(opencog::AtomSpace *, HsStablePtr, opencog::Handle *);
 
     HsStablePtr lojban_init();
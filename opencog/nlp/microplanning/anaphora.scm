@@ -85,14 +85,11 @@
 		(lambda (changed index)
 			(if changed
 				(let* ((chunk (get-chunk results-set index))
-				       (ut (get-utterance-type results-set index))
-				       (temp-set-link (SetLink (get-utterance-link ut chunk) chunk)))
+				       (ut (get-utterance-type results-set index)))
 					; failed to SuReal? bring back the old chunk
-					(if (nil? (sureal temp-set-link))
+					(if (not (first-sayable-chunk (list chunk) ut))
 						(mod-chunk results-set index (get-chunk inputs-set index))
 					)
-				
-					(cog-extract! temp-set-link)
 				)
 			)
 		)
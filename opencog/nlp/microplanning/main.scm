@@ -5,7 +5,8 @@
              (opencog)
              (opencog nlp)  ; need the atom types
              (opencog nlp relex2logic) ; helpers.scm uses this
-             (opencog nlp sureal))
+             (opencog nlp sureal)
+             (opencog tracing))
 
 ;
 ; loading additional dependency
@@ -99,31 +100,21 @@
 		(map wrap-setlink (get-chunks new-set) (get-utterance-types new-set))
 	)
 
-	; Initialize the sentence forms as needed
-	(microplanning-init)
-
-    ; Reset (clear) SuReal cache to assure it is empty before start calling sureal.
-    ; Remark that SuReal Cache is not thread-safe. So it is not supposed to be used
-    ; if the sureal queries are split into several threads. If you plan to do
-    ; this (split sureal requests amongst multiple threads), just comment the
-    ; following call and change the call to sureal below to use its non-cached version.
-    ;
-    ; It is not thread safe because in this version there is only one instance of
-    ; the cache (reached via a singleton wrapper). So if two threads with two
-    ; different Microplanner queries add stuff to the cache, one may lead to false
-    ; hits in the other. In addition to this, the cache is reset (clear) just before
-    ; the Microplanner query starts so if the second query reach the reset point
-    ; before the first query ended, the cache will be reset during the lifetime
-    ; of the first query, which may lead to false misses.
-    ;
-    ; A suggested approach to make it thread safe is having each Microplanner
-    ; query to have its own cache instance.
-	(reset-sureal-cache seq-link)
-
-	(set! all-sets (make-sentence-chunks
-		(cog-outgoing-set seq-link) utterance-type option))
-
-	(if (nil? all-sets) #f (map finalize all-sets))
+	(with-trace-span "microplanning"
+		; Initialize the sentence forms as needed
+		(microplanning-init)
+
+		; Reset (clear) SuReal cache to assure it is empty before start calling sureal.
+		; The cache belongs to the current AtomSpace and is thread-safe, so the sureal
+		; queries can be split amongst several threads.  Note however that resetting
+		; it while another Microplanner query is running on the same AtomSpace will
+		; make that query miss the cache (it will still get correct answers).
+		(reset-sureal-cache seq-link)
+
+		(set! all-sets (make-sentence-chunks
+			(cog-outgoing-set seq-link) utterance-type option))
+
+		(if (nil? all-sets) #f (map finalize all-sets)))
 )
 
 ; -----------------------------------------------------------------------
@@ -276,14 +267,22 @@
 	; The set of successful atoms to be returned.
 	(define atomW-chunk '())
 
-	; Main helper function for looping
+	; Main helper function for looping.  'do-check' is #t to check the
+	; atoms with SuReal, #f if they are known to be say-able and not too
+	; long, or the say-ability already found out, 'say-able or
+	; 'not-say-able.
 	(define (recursive-helper atomW-to-try do-check)
 		; The result of trying to say the atoms in a sentence.
 		(define result
-			; Return *microplanning_sayable* if no need to check.
-			(if do-check
-				(check-chunk (map get-atom atomW-to-try) utterance-type option)
-				*microplanning_sayable*
+			(cond
+				((eq? do-check 'say-able)
+					(chunk-result (map get-atom atomW-to-try) utterance-type option #t))
+				((eq? do-check 'not-say-able)
+					*microplanning_not_sayable*)
+				(do-check
+					(check-chunk (map get-atom atomW-to-try) utterance-type option))
+				; Return *microplanning_sayable* if no need to check.
+				(else *microplanning_sayable*)
 			)
 		)
 
@@ -374,15 +373,29 @@
 				; Add the currently "say-able" stuff to our chunk.
 				(update-chunk)
 
-				; Continue only if there is more to say.
+				; Continue only if there is more to say.  Rather than
+				; checking the best atom to add, and then the next best
+				; if it can't be said, all of them are checked as one
+				; batch, best first, and the first say-able one is added.
+				; The better ones are given up on, as they would have
+				; been one by one; if none is say-able, the best one is
+				; still tried with the words it is missing.
 				(if (not (nil? atomW-unused))
-					(recursive-helper
-						(cons
-							(pick-atomW atomW-unused atomW-chunk
-								(get-supp-weight-proc option) utterance-type)
-							atomW-to-try
+					(let* ((ranked (rank-atomW atomW-unused atomW-chunk
+								(get-supp-weight-proc option) utterance-type))
+					       (k (first-sayable-chunk
+								(map (lambda (a) (map get-atom (cons a atomW-to-try)))
+									ranked)
+								utterance-type)))
+						(if k
+							(begin
+								(set! atomW-unused
+									(lset-difference equal? atomW-unused (take ranked k)))
+								(recursive-helper
+									(cons (list-ref ranked k) atomW-to-try) 'say-able))
+							(recursive-helper
+								(cons (car ranked) atomW-to-try) 'not-say-able)
 						)
-						#t
 					)
 				)
 			)
@@ -477,13 +490,22 @@
 ; -----------------------------------------------------------------------
 ; pick-atomW -- Pick the best atom using some weighting function
 ;
+; The first of the atoms ranked by 'rank-atomW'.
+;
+(define (pick-atomW atomW-list base-atomW-list comb-proc utterance-type)
+	(car (rank-atomW atomW-list base-atomW-list comb-proc utterance-type))
+)
+
+; -----------------------------------------------------------------------
+; rank-atomW -- Rank the atoms using some weighting function
+;
 ; Helper function that weights the atomW in 'atomW-list' against bases,
-; using function 'comb-proc', and choose the one with the highest weight.
+; using function 'comb-proc', and sorts them, the highest weight first.
 ;
 ; 'comb-proc' should be a function that takes in param "time", "form", "link"
 ; in this order
 ;
-(define (pick-atomW atomW-list base-atomW-list comb-proc utterance-type)
+(define (rank-atomW atomW-list base-atomW-list comb-proc utterance-type)
 	(define favored-forms (get-sentence-forms utterance-type))
 
 	; helper function that calculate the weights of each atoms in 'choices' using 'comb-proc'
@@ -511,7 +533,7 @@
 
 	(define weights (calc-weights atomW-list base-atomW-list comb-proc))
 	(define assoc-list (sort (map cons atomW-list weights) (lambda (x y) (> (cdr x) (cdr y)))))
-	(caar assoc-list)
+	(map car assoc-list)
 )
 
 ; -----------------------------------------------------------------------
@@ -522,25 +544,20 @@
 ; the sentence is too long or complex.
 ;
 (define (check-chunk atoms utterance-type option)
+	; do something with SuReal to see if all atoms can be included in a sentence
+	(chunk-result atoms utterance-type option
+		(first-sayable-chunk (list atoms) utterance-type))
+)
+
+; -----------------------------------------------------------------------
+; chunk-result -- The result of check-chunk, given whether it is say-able
+;
+(define (chunk-result atoms utterance-type option say-able)
 	(define favored-forms (get-sentence-forms utterance-type))
 	(define ok-length
 		(< (length (filter-map (lambda (l) (match-sentence-forms l favored-forms)) atoms)) (get-form-limit option))
 	)
 
-	(define temp-set-link (SetLink (get-utterance-link utterance-type atoms) atoms))
-
-	; do something with SuReal to see if all atoms can be included in a sentence
-    ;
-    ; Remark that SuReal Cache is not thread-safe. So it is not supposed to be used
-    ; if the sureal queries are split into several threads. If you plan to do
-    ; this (split sureal requests among multiple threads), just comment the
-    ; call to reset-sureal-cache above and change the line below to call 'sureal'
-    ; instead of 'cached-sureal'
-	(define say-able (not (nil? (cached-sureal temp-set-link))))
-
-	; remove the temporary SetLink
-	(cog-extract! temp-set-link)
-
 	(cond
 		; not long/complex but sayable
 		((and ok-length say-able) *microplanning_sayable*)
@@ -550,3 +567,21 @@
 		(else *microplanning_not_sayable*)
 	)
 )
+
+; -----------------------------------------------------------------------
+; first-sayable-chunk -- Find the first say-able chunk of a list
+;
+; Each chunk is a list of atoms, to be said with the link for the
+; 'utterance-type'.  They are checked by SuReal as one batch, in a
+; scratch AtomSpace, so that no SetLink is added to the AtomSpace; the
+; chunks after the first say-able one are not checked.  Returns its
+; index, or #f if none is say-able.
+;
+(define (first-sayable-chunk chunks utterance-type)
+	(define (variant atoms)
+		(apply LinkValue (cons (get-utterance-link utterance-type atoms) atoms))
+	)
+	(define k (sureal-first-sayable (apply LinkValue (map variant chunks))))
+
+	(if (< k 0) #f k)
+)
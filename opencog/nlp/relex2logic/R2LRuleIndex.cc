@@ -0,0 +1,385 @@
+/*
+ * R2LRuleIndex.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <sstream>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/ClassServer.h>
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/executor/Executor.h>
+#include <opencog/nlp/types/atom_types.h>
+
+#include "R2LRuleIndex.h"
+
+using namespace opencog;
+using namespace opencog::nlp;
+
+R2LRuleIndex::R2LRuleIndex() :
+    _parses(0), _run(0), _skipped(0)
+{
+}
+
+static bool is_relation(Type t)
+{
+    return DEFINED_LINGUISTIC_RELATIONSHIP_NODE == t or
+           LINK_GRAMMAR_RELATIONSHIP_NODE == t;
+}
+
+static bool is_feature(Type t)
+{
+    return INHERITANCE_LINK == t or PART_OF_SPEECH_LINK == t or
+           TENSE_LINK == t;
+}
+
+/**
+ * The variable declarations of a BindLink, one per variable; empty if
+ * it has none.
+ */
+static HandleSeq get_decls(const Handle& bindlink)
+{
+    if (bindlink->get_arity() < 3) return HandleSeq();
+
+    const Handle& vardecl = bindlink->getOutgoingAtom(0);
+    if (VARIABLE_LIST == vardecl->get_type())
+        return vardecl->getOutgoingSet();
+    return HandleSeq{vardecl};
+}
+
+/**
+ * The relation or concept a clause needs the parse to have, if it is
+ * a clause of a kind that is indexed, else nullptr.
+ */
+static Handle clause_key(const Handle& clause,
+                         const std::unordered_map<Handle, Type>& var_types)
+{
+    Type t = clause->get_type();
+    if (not clause->is_link() or 2 != clause->get_arity()) return Handle();
+
+    const Handle& first = clause->getOutgoingAtom(0);
+    const Handle& second = clause->getOutgoingAtom(1);
+
+    // (dependency "_subj" "$verb" "$subj") and (lg-link "Ss" ...)
+    if (EVALUATION_LINK == t and is_relation(first->get_type()) and
+        LIST_LINK == second->get_type())
+        return first;
+
+    // (word-feat "$noun" "definite"), (word-pos ...), (verb-tense ...);
+    // those of other atoms, e.g. of the interpretation, may be made by
+    // other rules, so aren't looked for in the parse
+    if (is_feature(t) and DEFINED_LINGUISTIC_CONCEPT_NODE == second->get_type())
+    {
+        auto it = var_types.find(first);
+        if (it != var_types.end() and WORD_INSTANCE_NODE == it->second)
+            return second;
+    }
+
+    return Handle();
+}
+
+void R2LRuleIndex::add_rule(const Handle& bindlink)
+{
+    Rule rule;
+    rule.bindlink = bindlink;
+
+    std::unordered_map<Handle, Type> var_types;
+    for (const Handle& decl : get_decls(bindlink))
+    {
+        if (TYPED_VARIABLE_LINK != decl->get_type()) continue;
+        const Handle& var = decl->getOutgoingAtom(0);
+        const Handle& type = decl->getOutgoingAtom(1);
+        if (TYPE_NODE != type->get_type()) continue;
+
+        Type vt = nameserver().getType(type->get_name());
+        var_types[var] = vt;
+
+        // A rule with more than one parse variable relates parses, and
+        // is run as it is
+        if (PARSE_NODE == vt)
+            rule.parse_var = rule.parse_var ? Handle::UNDEFINED : var;
+        else if (INTERPRETATION_NODE == vt)
+            rule.interp_var = rule.interp_var ? Handle::UNDEFINED : var;
+    }
+
+    const Handle& body = bindlink->getOutgoingAtom(bindlink->get_arity() - 2);
+    HandleSeq clauses;
+    if (AND_LINK == body->get_type())
+        clauses = body->getOutgoingSet();
+    else
+        clauses.push_back(body);
+
+    for (const Handle& clause : clauses)
+    {
+        HandleSet group;
+        if (CHOICE_LINK == clause->get_type())
+        {
+            // Only if every choice needs a key
+            for (const Handle& choice : clause->getOutgoingSet())
+            {
+                Handle key(clause_key(choice, var_types));
+                if (nullptr == key)
+                {
+                    group.clear();
+                    break;
+                }
+                group.insert(key);
+            }
+        }
+        else
+        {
+            Handle key(clause_key(clause, var_types));
+            if (key) group.insert(key);
+        }
+
+        if (not group.empty())
+            rule.groups.push_back(std::move(group));
+    }
+
+    size_t index = _rules.size();
+    if (rule.groups.empty())
+        _unkeyed.push_back(index);
+
+    HandleSet keys;
+    for (const HandleSet& group : rule.groups)
+        keys.insert(group.begin(), group.end());
+    for (const Handle& key : keys)
+        _by_key[key].push_back(index);
+
+    _rules.push_back(std::move(rule));
+}
+
+size_t R2LRuleIndex::add_rulebase(const Handle& rbs)
+{
+    clear();
+
+    // (MemberLink (DefinedSchemaNode "amod") rbs) and
+    // (DefineLink (DefinedSchemaNode "amod") (BindLink ...))
+    for (const Handle& member : rbs->getIncomingSetByType(MEMBER_LINK))
+    {
+        if (member->getOutgoingAtom(1) != rbs) continue;
+        const Handle& alias = member->getOutgoingAtom(0);
+        if (DEFINED_SCHEMA_NODE != alias->get_type()) continue;
+
+        for (const Handle& def : alias->getIncomingSetByType(DEFINE_LINK))
+        {
+            if (def->getOutgoingAtom(0) != alias) continue;
+            const Handle& rule = def->getOutgoingAtom(1);
+            if (BIND_LINK == rule->get_type())
+                add_rule(rule);
+        }
+    }
+
+    return _rules.size();
+}
+
+void R2LRuleIndex::clear()
+{
+    _rules.clear();
+    _by_key.clear();
+    _unkeyed.clear();
+}
+
+HandleSet R2LRuleIndex::keys_of(const Handle& parse) const
+{
+    HandleSet keys;
+    for (const Handle& wil : parse->getIncomingSetByType(WORD_INSTANCE_LINK))
+    {
+        if (wil->getOutgoingAtom(1) != parse) continue;
+        const Handle& word = wil->getOutgoingAtom(0);
+
+        for (const Handle& l : word->getIncomingSet())
+        {
+            Type t = l->get_type();
+            if (LIST_LINK == t)
+            {
+                for (const Handle& eval : l->getIncomingSetByType(EVALUATION_LINK))
+                {
+                    const Handle& pred = eval->getOutgoingAtom(0);
+                    if (eval->getOutgoingAtom(1) == l and
+                        is_relation(pred->get_type()))
+                        keys.insert(pred);
+                }
+            }
+            else if (is_feature(t) and 2 == l->get_arity() and
+                     l->getOutgoingAtom(0) == word and
+                     DEFINED_LINGUISTIC_CONCEPT_NODE ==
+                         l->getOutgoingAtom(1)->get_type())
+            {
+                keys.insert(l->getOutgoingAtom(1));
+            }
+        }
+    }
+    return keys;
+}
+
+/**
+ * The rules that have a key of every group among the given keys, in
+ * the order they were added.
+ */
+void R2LRuleIndex::candidates(const HandleSet& keys,
+                              std::vector<size_t>& cands) const
+{
+    std::vector<bool> seen(_rules.size(), false);
+    for (size_t i : _unkeyed) seen[i] = true;
+
+    for (const Handle& key : keys)
+    {
+        auto it = _by_key.find(key);
+        if (it == _by_key.end()) continue;
+
+        for (size_t i : it->second)
+        {
+            if (seen[i]) continue;
+            seen[i] = true;
+
+            bool ok = true;
+            for (const HandleSet& group : _rules[i].groups)
+            {
+                bool any = false;
+                for (const Handle& k : group)
+                    if (keys.count(k)) { any = true; break; }
+                if (not any) { ok = false; break; }
+            }
+            if (ok) cands.push_back(i);
+        }
+    }
+
+    cands.insert(cands.end(), _unkeyed.begin(), _unkeyed.end());
+    std::sort(cands.begin(), cands.end());
+}
+
+HandleSeq R2LRuleIndex::rules_for(const Handle& parse) const
+{
+    std::vector<size_t> cands;
+    candidates(keys_of(parse), cands);
+
+    HandleSeq rules;
+    for (size_t i : cands)
+        rules.push_back(_rules[i].bindlink);
+    return rules;
+}
+
+static Handle substitute(const Handle& h, const HandleMap& values)
+{
+    auto it = values.find(h);
+    if (it != values.end()) return it->second;
+    if (not h->is_link()) return h;
+
+    bool changed = false;
+    HandleSeq oset;
+    for (const Handle& o : h->getOutgoingSet())
+    {
+        oset.push_back(substitute(o, values));
+        changed = changed or (oset.back() != o);
+    }
+    if (not changed) return h;
+
+    // Through the factory, so that e.g. an ExecutionOutputLink is one
+    Handle link(createLink(std::move(oset), h->get_type()));
+    return classserver().factory(link);
+}
+
+/**
+ * The rule, with the parse and the interpretation put in for its
+ * variables, so that it can only match the RelEx output of this parse.
+ */
+Handle R2LRuleIndex::specialize(const Rule& rule, const Handle& parse,
+                                const Handle& interp) const
+{
+    HandleMap values;
+    if (rule.parse_var) values[rule.parse_var] = parse;
+    if (rule.interp_var and interp) values[rule.interp_var] = interp;
+    if (values.empty()) return rule.bindlink;
+
+    HandleSeq decls;
+    for (const Handle& decl : get_decls(rule.bindlink))
+    {
+        const Handle& var = (TYPED_VARIABLE_LINK == decl->get_type()) ?
+            decl->getOutgoingAtom(0) : decl;
+        if (values.find(var) == values.end())
+            decls.push_back(decl);
+    }
+
+    const HandleSeq& oset = rule.bindlink->getOutgoingSet();
+    HandleSeq spec{Handle(createLink(std::move(decls), VARIABLE_LIST)),
+                   substitute(oset[1], values),
+                   substitute(oset[2], values)};
+    Handle bindlink(createLink(std::move(spec), BIND_LINK));
+    return classserver().factory(bindlink);
+}
+
+HandleSeq R2LRuleIndex::apply(AtomSpace* as, const Handle& parse,
+                              const Handle& interp)
+{
+    std::vector<size_t> cands;
+    candidates(keys_of(parse), cands);
+
+    _parses++;
+    _run += cands.size();
+    _skipped += _rules.size() - cands.size();
+
+    HandleSeq outputs;
+    for (size_t i : cands)
+    {
+        Handle rule(specialize(_rules[i], parse, interp));
+        Handle results(HandleCast(rule->execute(as)));
+        if (nullptr == results) continue;
+
+        if (SET_LINK != results->get_type())
+        {
+            outputs.push_back(results);
+            continue;
+        }
+
+        // The results come wrapped in a SetLink, which isn't wanted
+        const HandleSeq& oset = results->getOutgoingSet();
+        outputs.insert(outputs.end(), oset.begin(), oset.end());
+        as->extract_atom(results);
+    }
+    return outputs;
+}
+
+HandleSeqSeq R2LRuleIndex::apply(AtomSpace* as, const HandleSeq& parses,
+                                 const HandleSeq& interps,
+                                 unsigned max_threads)
+{
+    HandleSeqSeq outputs(parses.size());
+    Executor::instance().parallel_for(parses.size(),
+        [&](size_t i)
+        {
+            Handle interp(i < interps.size() ? interps[i] : Handle());
+            outputs[i] = apply(as, parses[i], interp);
+        },
+        std::max(max_threads, 1u));
+    return outputs;
+}
+
+std::string R2LRuleIndex::stats_string() const
+{
+    std::stringstream ss;
+    ss << "((rules . " << _rules.size() << ")"
+       << " (unkeyed . " << _unkeyed.size() << ")"
+       << " (parses . " << _parses << ")"
+       << " (run . " << _run << ")"
+       << " (skipped . " << _skipped << "))";
+    return ss.str();
+}
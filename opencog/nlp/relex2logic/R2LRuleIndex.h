@@ -0,0 +1,129 @@
+/*
+ * R2LRuleIndex.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_R2L_RULE_INDEX_H
+#define _OPENCOG_R2L_RULE_INDEX_H
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+class AtomSpace;
+
+namespace nlp
+{
+
+/**
+ * The R2L rules, indexed by what each of them needs from the RelEx
+ * output of a parse:
+ *
+ *  - the relation of each dependency and LG link clause, e.g. `_subj`
+ *    in (dependency "_subj" "$verb" "$subj"), and
+ *  - the concept of each feature, part of speech and tense clause of a
+ *    word instance, e.g. `definite` in (word-feat "$noun" "definite").
+ *
+ * A ChoiceLink of such clauses needs one of their keys. Clauses under
+ * a NotLink, an AbsentLink or any other link are left out, so a rule
+ * is never skipped when the parse could satisfy it.
+ *
+ * For a parse, the relations and concepts its word instances have are
+ * collected once, and only the rules whose every need is among them are
+ * run, with the parse, and the interpretation if the rule has one, put
+ * in for their variables. Each rule only reads the RelEx output, so
+ * one pass over the rules gives what the forward chainer gave.
+ */
+class R2LRuleIndex
+{
+public:
+    R2LRuleIndex();
+
+    /**
+     * Index the rules of a URE rule base, i.e. the BindLinks defined by
+     * the DefinedSchemaNodes that are members of it, in place of the
+     * ones indexed before.
+     *
+     * @return  the no. of rules indexed
+     */
+    size_t add_rulebase(const Handle& rbs);
+    void add_rule(const Handle& bindlink);
+    void clear();
+    size_t size() const { return _rules.size(); }
+
+    /// The relations and concepts of the word instances of the parse.
+    HandleSet keys_of(const Handle& parse) const;
+
+    /// The rules that can fire for the parse.
+    HandleSeq rules_for(const Handle& parse) const;
+
+    /**
+     * Run the rules that can fire for the parse, and return what their
+     * rewrites created.
+     */
+    HandleSeq apply(AtomSpace*, const Handle& parse, const Handle& interp);
+
+    /**
+     * Run apply() for each parse and its interpretation, with at most
+     * max_threads of them at once.
+     */
+    HandleSeqSeq apply(AtomSpace*, const HandleSeq& parses,
+                       const HandleSeq& interps, unsigned max_threads);
+
+    /// The parses seen, and the rules run and skipped, as an
+    /// association list, for scheme.
+    std::string stats_string() const;
+
+private:
+    struct Rule
+    {
+        Handle bindlink;
+        Handle parse_var;
+        Handle interp_var;
+
+        // Each group holds the keys one clause could be satisfied with
+        std::vector<HandleSet> groups;
+    };
+
+    void candidates(const HandleSet& keys, std::vector<size_t>&) const;
+    Handle specialize(const Rule&, const Handle& parse,
+                      const Handle& interp) const;
+
+    std::vector<Rule> _rules;
+
+    // A key, to the rules that have it in one of their groups
+    std::unordered_map<Handle, std::vector<size_t>> _by_key;
+
+    // The rules without any group, run for every parse
+    std::vector<size_t> _unkeyed;
+
+    std::atomic<uint64_t> _parses;
+    std::atomic<uint64_t> _run;
+    std::atomic<uint64_t> _skipped;
+};
+
+}
+}
+
+#endif // _OPENCOG_R2L_RULE_INDEX_H
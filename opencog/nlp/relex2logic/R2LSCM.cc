@@ -0,0 +1,142 @@
+/*
+ * R2LSCM.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/guile/SchemePrimitive.h>
+#include <opencog/guile/SchemeSmob.h>
+
+#include "R2LRuleIndex.h"
+
+namespace opencog
+{
+namespace nlp
+{
+
+/**
+ * The scheme bindings of the R2L rule index; see R2LRuleIndex.h.
+ */
+class R2LSCM
+{
+private:
+    static void* init_in_guile(void*);
+    static void init_in_module(void*);
+    void init(void);
+
+    int index_rulebase(const Handle&);
+    HandleSeq rules_for(const Handle&);
+    HandleSeqSeq apply_rules(const HandleSeq&, const HandleSeq&);
+    void set_num_threads(int);
+    std::string stats(void) { return m_index.stats_string(); }
+
+    R2LRuleIndex m_index;
+    std::atomic<unsigned> m_num_threads;
+
+public:
+    R2LSCM();
+};
+
+}
+}
+
+using namespace opencog;
+using namespace opencog::nlp;
+
+R2LSCM::R2LSCM() :
+    m_num_threads(1)
+{
+    static bool is_init = false;
+    if (is_init) return;
+    is_init = true;
+    scm_with_guile(init_in_guile, this);
+}
+
+void* R2LSCM::init_in_guile(void* self)
+{
+    scm_c_define_module("opencog nlp relex2logic", init_in_module, self);
+    scm_c_use_module("opencog nlp relex2logic");
+    return NULL;
+}
+
+void R2LSCM::init_in_module(void* data)
+{
+    R2LSCM* self = (R2LSCM*) data;
+    self->init();
+}
+
+void R2LSCM::init()
+{
+    define_scheme_primitive("r2l-index-rulebase", &R2LSCM::index_rulebase, this, "nlp relex2logic");
+    define_scheme_primitive("r2l-rules-for", &R2LSCM::rules_for, this, "nlp relex2logic");
+    define_scheme_primitive("r2l-apply-rules", &R2LSCM::apply_rules, this, "nlp relex2logic");
+    define_scheme_primitive("r2l-set-threads", &R2LSCM::set_num_threads, this, "nlp relex2logic");
+    define_scheme_primitive("r2l-stats-string", &R2LSCM::stats, this, "nlp relex2logic");
+}
+
+/**
+ * Implement the "r2l-index-rulebase" scheme primitive.
+ *
+ * @return   the no. of rules indexed
+ */
+int R2LSCM::index_rulebase(const Handle& rbs)
+{
+    return m_index.add_rulebase(rbs);
+}
+
+/**
+ * Implement the "r2l-rules-for" scheme primitive.
+ */
+HandleSeq R2LSCM::rules_for(const Handle& parse)
+{
+    return m_index.rules_for(parse);
+}
+
+/**
+ * Implement the "r2l-apply-rules" scheme primitive.
+ *
+ * @param parses    the ParseNodes
+ * @param interps   the InterpretationNode of each parse
+ * @return          what the rules created, for each parse
+ */
+HandleSeqSeq R2LSCM::apply_rules(const HandleSeq& parses,
+                                 const HandleSeq& interps)
+{
+    AtomSpace* as = SchemeSmob::ss_get_env_as("r2l-apply-rules");
+    return m_index.apply(as, parses, interps, m_num_threads);
+}
+
+/**
+ * Implement the "r2l-set-threads" scheme primitive.
+ *
+ * Sets the most parses that r2l-apply-rules runs the rules of at once;
+ * 1 (the default) runs them one after the other.
+ */
+void R2LSCM::set_num_threads(int n)
+{
+    m_num_threads = (n > 1) ? n : 1;
+}
+
+extern "C" {
+void opencog_nlp_relex2logic_init(void);
+};
+
+void opencog_nlp_relex2logic_init(void)
+{
+    static R2LSCM r2l;
+}
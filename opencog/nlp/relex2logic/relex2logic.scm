@@ -5,6 +5,11 @@
 (use-modules (opencog))
 (use-modules (opencog nlp))
 (use-modules (opencog ure))
+(use-modules (opencog tracing))
+(use-modules (opencog executor))
+(use-modules (opencog oc-config))
+
+(load-extension (string-append opencog-ext-path-relex2logic "librelex2logic") "opencog_nlp_relex2logic_init")
 
 (load "relex2logic/rule-utils.scm")
 (load "relex2logic/r2l-utilities.scm")
@@ -12,6 +17,96 @@
 (load "relex2logic/post-processing.scm")
 
 ; -----------------------------------------------------------------------
+; Whether r2l-parse runs only the rules the RelEx relations of a parse
+; can satisfy, by way of the native rule index, or has the forward
+; chainer try all of them.
+(define use-rule-index #t)
+
+(define-public (r2l-set-rule-index-dispatch ON)
+"
+  r2l-set-rule-index-dispatch ON -- whether r2l-parse runs only the rules
+  the parse has the RelEx relations of (ON is #t, the default), or has
+  the forward chainer try every rule (ON is #f).
+"
+    (set! use-rule-index ON)
+)
+
+(define (unwrap-list-link A-LINK IS-FROM-FC)
+    ; Many rules return a ListLink of the results that
+    ; they generated. Some rules return singletons. The
+    ; Forward Chainer uses a SetLink to wrap all these
+    ; results. So, if A-LINK is a ListLink or is directly
+    ; from the FC, then delete it and return a list of
+    ; its contents, else return a list holding A-LINK.
+    ;
+    ; XXX maybe this should be part of the ure module??
+    (if (or (equal? 'ListLink (cog-type A-LINK)) IS-FROM-FC)
+        (let ((returned-list (cog-outgoing-set A-LINK)))
+                (cog-extract! A-LINK)
+                returned-list)
+        (list A-LINK))
+)
+
+(define (unwrap-rule-outputs OUTPUTS)
+    (append-map (lambda (o) (unwrap-list-link o #f)) OUTPUTS)
+)
+
+(define (fc-apply-r2l-rules PARSE-NODE INTERP-LINK)
+    ; This applies all the rules in the R2L-en-RuleBase to the
+    ; RelEx parse, and returns a cleaned and de-duplicated list.
+    ; The RelEx outputs associated with `PARSE-NODE` are the
+    ; focus-set. Thus, if there are multiple parses, then
+    ; each is handled independently, by passing it seperately,
+    ; since each is likely to exist in a seperate semantic-universe.
+    (define focus-set
+        (SetLink (parse-get-relex-outputs PARSE-NODE) INTERP-LINK))
+    (define outputs
+        (unwrap-list-link (cog-fc r2l-rules (Set) #:focus-set focus-set) #t))
+
+    (unwrap-rule-outputs outputs)
+)
+
+(define (make-interp-link PARSE-NODE)
+    ; FIXME: Presently, only a single interpretation is created for
+    ; each parse. Multiple interpreation should be handled, when
+    ; word-sense-disambiguation, anaphora-resolution and other
+    ; post-processing are added to the pipeline.
+    (define interp-name
+        (string-append (cog-name PARSE-NODE) "_interpretation_$X"))
+
+    ; Associate the interpretation with a parse, as there
+    ; could be multiplie interpretations for the same parse.
+    (InterpretationLink (InterpretationNode interp-name) PARSE-NODE)
+)
+
+(define (finish-interp INTERP-LINK OUTPUTS)
+    (let* ((interp-node (gar INTERP-LINK))
+           (result (SetLink (remove
+                (lambda (a) (equal? (cog-type a) 'ReferenceLink))
+                (delete-duplicates OUTPUTS)))))
+
+        ; Construct a ReferenceLink to the output
+        (ReferenceLink interp-node result)
+
+        ; Return the SetLink of R2L rule outputs.
+        result
+    )
+)
+
+(define (interpret-parses PARSES)
+    ; The rules of each parse are independent of those of the others;
+    ; with the index, they are run by r2l-apply-rules, as many parses
+    ; at once as r2l-set-threads allows.
+    (define interp-links (map make-interp-link PARSES))
+    (define outputs
+        (if use-rule-index
+            (map unwrap-rule-outputs
+                (r2l-apply-rules PARSES (map gar interp-links)))
+            (map fc-apply-r2l-rules PARSES interp-links)))
+
+    (map finish-interp interp-links outputs)
+)
+
 (define-public (r2l-parse SENT)
 "
   r2l-parse SENT -- perform relex2logic processing on sentence SENT.
@@ -21,75 +116,37 @@
   Returns a list of `SetLinks`, each `SetLink` holding the R2L
   interpretation of one parse of the sentence.
 
-  This can't handle  mutliple thread execution (Why??? This is a bug,
-  I would think ...). Thus, mapping this function over a list of
-  sentences, even though possible, is not advised.
+  Only the rules that the RelEx relations of a parse can satisfy are
+  run; see r2l-set-rule-index-dispatch.
 
   SENT must be a SentenceNode.
 "
-    (define (unwrap-list-link A-LINK IS-FROM-FC)
-        ; Many rules return a ListLink of the results that
-        ; they generated. Some rules return singletons. The
-        ; Forward Chainer uses a SetLink to wrap all these
-        ; results. So, if A-LINK is a ListLink or is directly
-        ; from the FC, then delete it and return a list of
-        ; its contents, else return a list holding A-LINK.
-        ;
-        ; XXX maybe this should be part of the ure module??
-        (if (or (equal? 'ListLink (cog-type A-LINK)) IS-FROM-FC)
-            (let ((returned-list (cog-outgoing-set A-LINK)))
-                    (cog-extract! A-LINK)
-                    returned-list)
-            (list A-LINK))
-    )
-
-    (define (apply-r2l-rules PARSE-NODE INTERP-LINK)
-        ; This applies all the rules in the R2L-en-RuleBase to the
-        ; RelEx parse, and returns a cleaned and de-duplicated list.
-        ; The RelEx outputs associated with `PARSE-NODE` are the
-        ; focus-set. Thus, if there are multiple parses, then
-        ; each is handled independently, by passing it seperately,
-        ; since each is likely to exist in a seperate semantic-universe.
-        (define focus-set
-            (SetLink (parse-get-relex-outputs PARSE-NODE) INTERP-LINK))
-        (define outputs
-            (unwrap-list-link (cog-fc r2l-rules (Set) #:focus-set focus-set) #t))
-
-        (append-map (lambda (o) (unwrap-list-link o #f)) outputs)
-    )
-
-    (define (interpret PARSE-NODE)
-        ; FIXME: Presently, only a single interpretation is created for
-        ; each parse. Multiple interpreation should be handled, when
-        ; word-sense-disambiguation, anaphora-resolution and other
-        ; post-processing are added to the pipeline.
-        (let* (
-                (interp-name (string-append
-                    (cog-name PARSE-NODE) "_interpretation_$X"))
-
-                (interp-node (InterpretationNode interp-name))
-
-                ; Associate the interpretation with a parse, as there
-                ; could be multiplie interpretations for the same parse.
-                (interp-link (InterpretationLink interp-node PARSE-NODE))
-
-                (pre-result (remove
-                    (lambda (a) (equal? (cog-type a) 'ReferenceLink))
-                    (delete-duplicates
-                        (apply-r2l-rules PARSE-NODE interp-link))))
-
-                (result (SetLink pre-result)))
-
-            ; Construct a ReferenceLink to the output
-            (ReferenceLink interp-node result)
+    (with-trace-span "r2l-parse"
+        (interpret-parses (sentence-get-parses SENT)))
+)
 
-            ; Return the SetLink of R2L rule outputs.
-            result
-        )
-    )
+(define-public (r2l-parse-sentences SENTS)
+"
+  r2l-parse-sentences SENTS -- perform relex2logic processing on each
+  of the SentenceNodes in the list SENTS.
 
-    ;; Can this safely be made parallel ???
-    (map interpret (sentence-get-parses SENT))
+  Returns a list holding, for each sentence, what r2l-parse would have
+  returned for it. The parses of all the sentences are handed to the
+  rule index together, so that up to (r2l-set-threads N) of them are
+  processed in parallel.
+"
+    (define parses (map sentence-get-parses SENTS))
+    (define results
+        (with-trace-span "r2l-parse-sentences"
+            (interpret-parses (concatenate parses))))
+
+    ; Split the results up by sentence again
+    (let loop ((parses parses) (results results) (acc '()))
+        (if (null? parses)
+            (reverse acc)
+            (let ((n (length (car parses))))
+                (loop (cdr parses) (drop results n)
+                    (cons (take results n) acc)))))
 )
 ; -----------------------------------------------------------------------
 
@@ -102,6 +159,7 @@
 	(load "relex2logic/rule-helpers.scm")
 	(load "relex2logic/loader/load-rules.scm")  ; XXX
 	(load "relex2logic/loader/gen-r2l-en-rulebase.scm")
+	(r2l-index-rulebase r2l-rules)
 
 	*unspecified*  ; no return value, avoids printing gunk.
 )
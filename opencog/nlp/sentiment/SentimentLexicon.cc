@@ -0,0 +1,229 @@
+/*
+ * SentimentLexicon.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cctype>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+
+#include "SentimentLexicon.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+#ifndef SENTIMENT_DICTS_DIR
+#define SENTIMENT_DICTS_DIR "/usr/local/etc/opencog/dicts"
+#endif
+
+static std::string lower(std::string s)
+{
+    for (char& c : s) c = std::tolower((unsigned char) c);
+    return s;
+}
+
+static std::string trim(const std::string& s)
+{
+    size_t b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) return "";
+    size_t e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+SentimentLexicon::SentimentLexicon(void) :
+    m_tags(1, 0),
+    m_size(0)
+{
+}
+
+/**
+ * Load the five word lists of basic_sentiment_analysis.py.
+ */
+std::shared_ptr<const SentimentLexicon> SentimentLexicon::load(const std::string& dir)
+{
+    std::shared_ptr<SentimentLexicon> lex(new SentimentLexicon());
+    for (const char* name : {"positive.yml", "negative.yml", "inc.yml",
+                             "dec.yml", "inv.yml"})
+        lex->load_file(dir + "/" + name);
+
+    logger().debug("[SentimentLexicon] Loaded %zu entries from %s",
+                   lex->size(), dir.c_str());
+    return lex;
+}
+
+std::shared_ptr<const SentimentLexicon> SentimentLexicon::standard(void)
+{
+    static std::shared_ptr<const SentimentLexicon> lex;
+    static std::once_flag loaded;
+    std::call_once(loaded, [] {
+        std::string dir(SENTIMENT_DICTS_DIR);
+        if (config().has("NLP_SENTIMENT_DICTS"))
+            dir = config()["NLP_SENTIMENT_DICTS"];
+        lex = load(dir);
+    });
+    return lex;
+}
+
+/**
+ * The word lists are YAML maps of the entries to lists of tags, one per
+ * line, e.g.
+ *
+ *    lack of: [inv]
+ *
+ * which is all that is read of YAML here.
+ */
+void SentimentLexicon::load_file(const std::string& path)
+{
+    std::ifstream in(path);
+    if (not in)
+        throw RuntimeException(TRACE_INFO,
+            "Can't open the sentiment word list %s", path.c_str());
+
+    std::string line;
+    size_t lineno = 0;
+    while (std::getline(in, line))
+    {
+        lineno++;
+        line = trim(line);
+        if (line.empty() or line[0] == '#') continue;
+
+        size_t colon = line.rfind(": [");
+        if (colon == std::string::npos or line.back() != ']')
+            throw SyntaxException(TRACE_INFO,
+                "%s:%zu: expecting \"entry: [tags]\"", path.c_str(), lineno);
+
+        std::string entry = trim(line.substr(0, colon));
+        if (2 <= entry.size() and (entry[0] == '"' or entry[0] == '\'') and
+            entry.back() == entry[0])
+            entry = entry.substr(1, entry.size() - 2);
+
+        uint8_t tags = 0;
+        std::istringstream list(line.substr(colon + 3, line.size() - colon - 4));
+        std::string tag;
+        while (std::getline(list, tag, ','))
+        {
+            tag = trim(tag);
+            if (tag == "positive") tags |= POSITIVE;
+            else if (tag == "negative") tags |= NEGATIVE;
+            else if (tag == "inc") tags |= INC;
+            else if (tag == "dec") tags |= DEC;
+            else if (tag == "inv") tags |= INV;
+        }
+
+        if (not entry.empty() and tags) add(lower(entry), tags);
+    }
+}
+
+uint32_t SentimentLexicon::child(uint32_t node, uint32_t word) const
+{
+    auto it = m_edges.find(((uint64_t) node << 32) | word);
+    return (it == m_edges.end()) ? NONE : it->second;
+}
+
+void SentimentLexicon::add(const std::string& entry, uint8_t tags)
+{
+    std::istringstream words(entry);
+    std::string w;
+    uint32_t node = 0;
+    while (words >> w)
+    {
+        auto wit = m_words.emplace(w, m_words.size()).first;
+        uint64_t key = ((uint64_t) node << 32) | wit->second;
+
+        auto eit = m_edges.find(key);
+        if (eit == m_edges.end())
+        {
+            eit = m_edges.emplace(key, m_tags.size()).first;
+            m_tags.push_back(0);
+        }
+        node = eit->second;
+    }
+
+    if (node == 0) return;
+    if (m_tags[node] == 0) m_size++;
+    m_tags[node] |= tags;
+}
+
+/**
+ * The longest entry starting at words[i]; the words are lower-cased
+ * first, as the entries are.
+ */
+size_t SentimentLexicon::match(const std::vector<std::string>& words,
+                               size_t i, uint8_t& tags) const
+{
+    tags = 0;
+    size_t len = 0;
+    uint32_t node = 0;
+    for (size_t j = i; j < words.size(); j++)
+    {
+        auto wit = m_words.find(lower(words[j]));
+        if (wit == m_words.end()) break;
+
+        node = child(node, wit->second);
+        if (node == NONE) break;
+
+        if (m_tags[node])
+        {
+            tags = m_tags[node];
+            len = j - i + 1;
+        }
+    }
+    return len;
+}
+
+/**
+ * As sentence_score in basic_sentiment_analysis.py, the entries being
+ * matched left to right, longest first.  An intensifier, diminisher or
+ * negation works on the word or entry right after it.
+ */
+double SentimentLexicon::score(const std::vector<std::string>& words) const
+{
+    double score = 0.0;
+    size_t negations = 0;
+    uint8_t prev = 0;
+    bool first = true;
+
+    size_t i = 0;
+    while (i < words.size())
+    {
+        uint8_t tags;
+        size_t len = match(words, i, tags);
+        i += (0 < len) ? len : 1;
+
+        double s = ((tags & POSITIVE) ? 1.0 : 0.0) -
+                   ((tags & NEGATIVE) ? 1.0 : 0.0);
+        if (not first)
+        {
+            if (prev & INC) s *= 2.0;
+            else if (prev & DEC) s /= 2.0;
+            else if (prev & INV) negations++;
+        }
+
+        score += s;
+        prev = tags;
+        first = false;
+    }
+
+    return (negations % 2) ? -score : score;
+}
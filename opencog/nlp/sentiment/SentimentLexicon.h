@@ -0,0 +1,103 @@
+/*
+ * SentimentLexicon.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_NLP_SENTIMENT_LEXICON_H
+#define _OPENCOG_NLP_SENTIMENT_LEXICON_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace opencog
+{
+namespace nlp
+{
+
+/**
+ * The word lists of basic_sentiment_analysis.py: positive.yml,
+ * negative.yml, and the intensifiers, diminishers and negations of
+ * inc.yml, dec.yml and inv.yml.  An entry may be more than one word,
+ * e.g. "lack of".
+ *
+ * The entries are kept as a trie of words: each distinct word is
+ * stored once, and given a number, and the edges of the trie are all
+ * in one hash table, keyed by the node and the number of the word.
+ * Finding the longest entry at a place in a sentence is then a hash
+ * lookup per word.
+ *
+ * A lexicon doesn't change once it has been loaded, and may be used
+ * from any number of threads at once.
+ */
+class SentimentLexicon
+{
+public:
+    enum Tag : uint8_t
+    {
+        POSITIVE = 1,
+        NEGATIVE = 2,
+        INC = 4,
+        DEC = 8,
+        INV = 16,
+    };
+
+    // Load the word lists of the given directory
+    static std::shared_ptr<const SentimentLexicon> load(const std::string& dir);
+
+    // The word lists of the NLP_SENTIMENT_DICTS directory of the config
+    // file, or else the installed ones; loaded on first use
+    static std::shared_ptr<const SentimentLexicon> standard(void);
+
+    // The longest entry at words[i], with its tags; returns how many
+    // words it has, or 0 if there is none
+    size_t match(const std::vector<std::string>& words, size_t i,
+                 uint8_t& tags) const;
+
+    // The score of a sentence, as sentence_score gives it, i.e. the
+    // number of positive entries less the number of negative ones, one
+    // doubled after an intensifier and halved after a diminisher, all
+    // negated if an odd number of negations have a word after them
+    double score(const std::vector<std::string>& words) const;
+
+    // The number of entries
+    size_t size(void) const { return m_size; }
+
+private:
+    SentimentLexicon(void);
+
+    void load_file(const std::string& path);
+    void add(const std::string& entry, uint8_t tags);
+
+    uint32_t child(uint32_t node, uint32_t word) const;
+
+    static const uint32_t NONE = UINT32_MAX;
+
+    std::unordered_map<std::string, uint32_t> m_words;
+    std::unordered_map<uint64_t, uint32_t> m_edges;
+    std::vector<uint8_t> m_tags;
+    size_t m_size;
+};
+
+}
+}
+
+#endif // _OPENCOG_NLP_SENTIMENT_LEXICON_H
@@ -0,0 +1,152 @@
+/*
+ * SentimentSCM.cc
+ *
+ * Scheme bindings of the sentiment scorer.
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <mutex>
+
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/guile/SchemePrimitive.h>
+#include <opencog/guile/SchemeSmob.h>
+
+#include "SentimentScorer.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+namespace opencog
+{
+namespace nlp
+{
+
+class SentimentSCM
+{
+private:
+    static void* init_in_guile(void*);
+    static void init_in_module(void*);
+    void init(void);
+
+    int load_lexicon(const std::string&);
+    double score(const Handle&);
+    ValuePtr score_batch(const HandleSeq&);
+    Handle tag(const Handle&);
+
+    SentimentScorer scorer(const char*);
+
+    // The lexicon set by nlp-sentiment-load-lexicon, if any
+    std::mutex m_mtx;
+    std::shared_ptr<const SentimentLexicon> m_lex;
+
+public:
+    SentimentSCM(void);
+};
+
+}
+}
+
+SentimentSCM::SentimentSCM(void)
+{
+    static bool is_init = false;
+    if (is_init) return;
+    is_init = true;
+    scm_with_guile(init_in_guile, this);
+}
+
+void* SentimentSCM::init_in_guile(void* self)
+{
+    scm_c_define_module("opencog nlp sentiment", init_in_module, self);
+    scm_c_use_module("opencog nlp sentiment");
+    return NULL;
+}
+
+void SentimentSCM::init_in_module(void* data)
+{
+    SentimentSCM* self = (SentimentSCM*) data;
+    self->init();
+}
+
+void SentimentSCM::init(void)
+{
+    define_scheme_primitive("nlp-sentiment-load-lexicon",
+        &SentimentSCM::load_lexicon, this, "nlp sentiment");
+    define_scheme_primitive("nlp-sentiment-score",
+        &SentimentSCM::score, this, "nlp sentiment");
+    define_scheme_primitive("nlp-sentiment-score-batch",
+        &SentimentSCM::score_batch, this, "nlp sentiment");
+    define_scheme_primitive("nlp-sentiment-tag",
+        &SentimentSCM::tag, this, "nlp sentiment");
+}
+
+SentimentScorer SentimentSCM::scorer(const char* fn)
+{
+    AtomSpace* as = SchemeSmob::ss_get_env_as(fn);
+
+    std::lock_guard<std::mutex> lck(m_mtx);
+    if (m_lex == nullptr) m_lex = SentimentLexicon::standard();
+    return SentimentScorer(as, m_lex);
+}
+
+/**
+ * Implement the "nlp-sentiment-load-lexicon" scheme primitive.
+ */
+int SentimentSCM::load_lexicon(const std::string& dir)
+{
+    std::shared_ptr<const SentimentLexicon> lex(SentimentLexicon::load(dir));
+
+    std::lock_guard<std::mutex> lck(m_mtx);
+    m_lex = lex;
+    return lex->size();
+}
+
+/**
+ * Implement the "nlp-sentiment-score" scheme primitive.
+ */
+double SentimentSCM::score(const Handle& sentence)
+{
+    return scorer("nlp-sentiment-score").score(sentence);
+}
+
+/**
+ * Implement the "nlp-sentiment-score-batch" scheme primitive.
+ */
+ValuePtr SentimentSCM::score_batch(const HandleSeq& sentences)
+{
+    return createFloatValue(
+        scorer("nlp-sentiment-score-batch").score(sentences));
+}
+
+/**
+ * Implement the "nlp-sentiment-tag" scheme primitive.
+ */
+Handle SentimentSCM::tag(const Handle& sentence)
+{
+    SentimentScorer sc(scorer("nlp-sentiment-tag"));
+    return sc.tag(sentence, sc.score(sentence));
+}
+
+extern "C" {
+void opencog_nlp_sentiment_init(void);
+};
+
+void opencog_nlp_sentiment_init(void)
+{
+    static SentimentSCM sentiment;
+}
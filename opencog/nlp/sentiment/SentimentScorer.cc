@@ -0,0 +1,101 @@
+/*
+ * SentimentScorer.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/executor/Executor.h>
+#include <opencog/nlp/index/LinguisticIndex.h>
+#include <opencog/nlp/types/WordPosition.h>
+#include <opencog/nlp/types/atom_types.h>
+
+#include "SentimentScorer.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+SentimentScorer::SentimentScorer(AtomSpace* as,
+                                 std::shared_ptr<const SentimentLexicon> lex) :
+    m_as(as),
+    m_lex(lex)
+{
+}
+
+/**
+ * The words of the first parse; all the parses of a sentence have the
+ * same words, bar the odd split of a word that doesn't change its
+ * score.
+ */
+std::vector<std::string> SentimentScorer::get_words(const Handle& sentence) const
+{
+    const LinguisticIndex& index = LinguisticIndex::instance(m_as);
+
+    HandleSeq parses(index.get_parses(sentence));
+    if (parses.empty()) return {};
+    Handle parse = *std::min_element(parses.begin(), parses.end(),
+        [](const Handle& a, const Handle& b) {
+            return a->get_name() < b->get_name(); });
+
+    std::vector<std::pair<double, std::string>> words;
+    for (const Handle& winst : index.get_word_instances(parse))
+    {
+        Handle word(index.get_word(winst));
+        std::string name = word ? word->get_name() :
+            winst->get_name().substr(0, winst->get_name().rfind('@'));
+
+        // ###LEFT-WALL### and ###RIGHT-WALL###
+        if (0 == name.compare(0, 3, "###")) continue;
+
+        words.emplace_back(word_sequence_number(winst), std::move(name));
+    }
+    std::sort(words.begin(), words.end());
+
+    std::vector<std::string> seq;
+    seq.reserve(words.size());
+    for (auto& w : words) seq.push_back(std::move(w.second));
+    return seq;
+}
+
+double SentimentScorer::score(const Handle& sentence) const
+{
+    return m_lex->score(get_words(sentence));
+}
+
+/**
+ * The lexicon, and the index the words are read through, may be used
+ * from many threads at once.
+ */
+std::vector<double> SentimentScorer::score(const HandleSeq& sentences) const
+{
+    std::vector<double> scores(sentences.size(), 0.0);
+    Executor::instance().parallel_for(sentences.size(),
+        [&](size_t i) { scores[i] = score(sentences[i]); });
+    return scores;
+}
+
+Handle SentimentScorer::tag(const Handle& sentence, double score) const
+{
+    const char* name = (0 < score) ? "Positive" :
+                       (score < 0) ? "Negative" : "Neutral";
+    Handle sentiment(m_as->add_node(CONCEPT_NODE, name));
+    m_as->add_link(INHERITANCE_LINK, sentence, sentiment);
+    return sentiment;
+}
@@ -0,0 +1,74 @@
+/*
+ * SentimentScorer.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_NLP_SENTIMENT_SCORER_H
+#define _OPENCOG_NLP_SENTIMENT_SCORER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
+#include "SentimentLexicon.h"
+
+namespace opencog
+{
+class AtomSpace;
+
+namespace nlp
+{
+
+/**
+ * Scores parsed sentences with a SentimentLexicon, reading their words
+ * from the AtomSpace: the WordNodes of the WordInstanceNodes of a parse
+ * of the sentence, in the order of their word sequence numbers, the
+ * walls left out.  This takes the place of basic_sentiment_analysis.py,
+ * with no Python, and no tokenizing of the raw text again.
+ */
+class SentimentScorer
+{
+public:
+    SentimentScorer(AtomSpace* as,
+        std::shared_ptr<const SentimentLexicon> lex = SentimentLexicon::standard());
+
+    // The words of the first parse of the sentence, in order
+    std::vector<std::string> get_words(const Handle& sentence) const;
+
+    double score(const Handle& sentence) const;
+
+    // Score many sentences, e.g. those of a document, in parallel on
+    // the Executor; the scores are in the same order
+    std::vector<double> score(const HandleSeq& sentences) const;
+
+    // Link the sentence to (Concept "Positive"), "Negative" or "Neutral"
+    // by its score, as sentiment.scm does, and return the ConceptNode
+    Handle tag(const Handle& sentence, double score) const;
+
+private:
+    AtomSpace* m_as;
+    std::shared_ptr<const SentimentLexicon> m_lex;
+};
+
+}
+}
+
+#endif // _OPENCOG_NLP_SENTIMENT_SCORER_H
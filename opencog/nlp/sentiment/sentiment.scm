@@ -3,72 +3,57 @@
 ;
 ; Sentiment analysis module
 ;
+; (use-modules (opencog nlp sentiment))
+; (perform-sentiment-analysis (car (nlp-parse "This is not a bad test.")))
+;
 ; -----------------------------------------------------------------------
 
 (define-module (opencog nlp sentiment))
 
-(use-modules (opencog) (opencog python) (opencog exec))
+(use-modules (opencog) (opencog oc-config))
 (use-modules (opencog logger))
 
-(python-eval "
-from opencog.atomspace import AtomSpace, types, TruthValue
-
-have_sentiment_analysis = True
-try:
-      import basic_sentiment_analysis
-except ImportError:
-      have_sentiment_analysis = False
-
-atomspace = ''
-
-def set_atomspace(atsp):
-      global atomspace
-      atomspace = atsp
-      return TruthValue(1, 1)
+(load-extension (string-append opencog-ext-path-nlp-sentiment "libnlp-sentiment") "opencog_nlp_sentiment_init")
 
-def call_sentiment_parse(text_node, sent_node):
-      global atomspace
-      global have_sentiment_analysis
-
-      if not have_sentiment_analysis:
-          return TruthValue(1, 1)
+(set-procedure-property! nlp-sentiment-score 'documentation
+"
+  nlp-sentiment-score SENT -- the sentiment score of the parsed
+  SentenceNode SENT, as basic_sentiment_analysis.py gives it: the
+  number of positive words less the number of negative ones, a word
+  counting double after an intensifier such as \"very\", and half after
+  a diminisher such as \"slightly\", and the whole negated if an odd
+  number of negations such as \"not\" have a word after them. The words
+  are those of the first parse of SENT, in order.
+")
 
-      sentiment_score = basic_sentiment_analysis.sentiment_parse(text_node.name)
-      if sentiment_score > 0:
-          positive_node = atomspace.add_node(types.ConceptNode, 'Positive')
-          atomspace.add_link(types.InheritanceLink, [sent_node, positive_node])
-      elif sentiment_score < 0:
-          negative_node = atomspace.add_node(types.ConceptNode, 'Negative')
-          atomspace.add_link(types.InheritanceLink, [sent_node, negative_node])
-      else:
-          neutral_node = atomspace.add_node(types.ConceptNode, 'Neutral')
-          atomspace.add_link(types.InheritanceLink, [sent_node, neutral_node])
+(set-procedure-property! nlp-sentiment-score-batch 'documentation
+"
+  nlp-sentiment-score-batch SENTS -- the scores of the list of
+  SentenceNodes SENTS, e.g. those of a document, as nlp-sentiment-score
+  gives them, in a FloatValue. The sentences are scored in parallel.
+  The score of a whole document is their sum.
+")
 
-      return TruthValue(1, 1)
+(set-procedure-property! nlp-sentiment-tag 'documentation
+"
+  nlp-sentiment-tag SENT -- score the SentenceNode SENT, and link it to
+  (Concept \"Positive\"), (Concept \"Negative\") or (Concept \"Neutral\")
+  by its score, with an InheritanceLink. Returns the ConceptNode.
 ")
 
-(python-call-with-as "set_atomspace" (cog-atomspace))
+(set-procedure-property! nlp-sentiment-load-lexicon 'documentation
+"
+  nlp-sentiment-load-lexicon DIR -- score with the word lists in the
+  directory DIR from now on, instead of the ones in the
+  NLP_SENTIMENT_DICTS directory of the config file, or else the
+  installed ones. Returns the number of entries.
+")
 
 (define-public (perform-sentiment-analysis SENT)
 "
-	Call the Sentiment_eval function.
+  perform-sentiment-analysis SENT -- tag the parsed SentenceNode SENT
+  with its sentiment; see nlp-sentiment-tag.
 "
-
-	; Fetch the raw input text for the sentence.
-	; Assumes it's located here:
-	;     EvaluationLink
-	;          PredicateNode "sentence-rawtext"
-	;          ListLink
-	;              SentenceNode "1234-1324-1234-1234"
-	;              SomeNode "This is the raw text of the sentence"
-	;
-	(define plain-text
-		(cog-pred-get-partner (PredicateNode "sentence-rawtext") SENT))
-
 	(cog-logger-info "Performing Sentiment Analysis")
-
-	(cog-evaluate!
-		(Evaluation
-			(GroundedPredicate "py: call_sentiment_parse")
-			(List plain-text SENT)))
+	(nlp-sentiment-tag SENT)
 )
@@ -21,17 +21,25 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-#include "SuRealCache.h"
+#include <algorithm>
+#include <memory>
 
-#include <opencog/atoms/atom_types/NameServer.h>
-#include <opencog/atoms/base/Atom.h>
+#include "SuRealCache.h"
+#include "SuRealStats.h"
 
 using namespace opencog::nlp;
 using namespace opencog;
 using namespace std;
 
 
-SuRealCache::SuRealCache()
+// A rough estimate of what a node of an unordered_map or a list costs
+// on top of the element itself.
+static const size_t NODE_OVERHEAD = 4 * sizeof(void*);
+
+static std::atomic<size_t> default_budget(64 * 1024 * 1024);
+
+SuRealCache::SuRealCache(size_t budget) :
+    m_budget(budget)
 {
 }
 
@@ -39,192 +47,407 @@ SuRealCache::~SuRealCache()
 {
 }
 
-SuRealCache *SuRealCache::instance_ = NULL;
+typedef std::unordered_map<const AtomSpace*, std::unique_ptr<SuRealCache>> CacheRegistry;
 
-SuRealCache& SuRealCache::instance() 
+static std::mutex& registry_mutex()
 {
-    if (instance_ == NULL) {
-        instance_ = new SuRealCache();
-    }
-    return *instance_;
+    static std::mutex mtx;
+    return mtx;
 }
 
-void SuRealCache::add_match(HandleCacheMap &map, const Handle &h1, const Handle &h2, bool value) 
+static CacheRegistry& registry()
 {
+    static CacheRegistry caches;
+    return caches;
+}
 
-    SuRealCache::HandleCacheMap::iterator it1 = map.find(h1);
-    if (it1 == map.end()) {
-        HandleBoolMap new_map;
-        new_map.insert(HandleBoolMap::value_type(h2, value));
-        map.insert(HandleCacheMap::value_type(h1, new_map));
-    } else {
-        (*it1).second.insert(HandleBoolMap::value_type(h2, value));
+/**
+ * Get the cache of the given AtomSpace, creating it if needed.
+ */
+SuRealCache& SuRealCache::instance(const AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+
+    std::unique_ptr<SuRealCache>& cache = registry()[as];
+    if (cache == nullptr) {
+        cache.reset(new SuRealCache(default_budget));
     }
+    return *cache;
 }
 
-int SuRealCache::match(HandleCacheMap &map, const Handle &h1, const Handle &h2) 
+/**
+ * Drop the cache of the given AtomSpace.  This should be called before
+ * the AtomSpace goes away, as the cache keeps its atoms alive; no other
+ * thread may be using the cache at that point.
+ */
+void SuRealCache::release(const AtomSpace* as)
 {
+    std::lock_guard<std::mutex> lck(registry_mutex());
+    registry().erase(as);
+}
 
-    int answer = -1;
+void SuRealCache::set_default_budget(size_t bytes)
+{
+    default_budget = bytes;
+}
 
-    SuRealCache::HandleCacheMap::iterator it1 = map.find(h1);
-    if (it1 != map.end()) {
-        HandleBoolMap::iterator it2 = (*it1).second.find(h2);
-        if (it2 != (*it1).second.end()) {
-            answer = ((*it2).second ? 1 : 0);
-        }
+void SuRealCache::set_memory_budget(size_t bytes)
+{
+    m_budget = bytes;
+
+    for (Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lck(shard.mtx);
+        evict(shard);
     }
+}
 
-    return answer;
+size_t SuRealCache::memory_budget() const
+{
+    return m_budget;
 }
 
-void SuRealCache::add_grounding_match(const HandleMap &m1, bool value) 
+size_t SuRealCache::memory_used()
 {
-    std::string key1 = build_map_hash_key(m1);
-    SuRealCache::StringMap::iterator it1 = m_partial_grounding_cache.find(key1);
-    if (it1 == m_partial_grounding_cache.end()) {
-        m_partial_grounding_cache.insert(StringMap::value_type(key1, value));
+    size_t used = 0;
+    for (Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lck(shard.mtx);
+        used += shard.used;
     }
+    return used;
 }
 
-void SuRealCache::add_grounding_match(const HandleMap &m1, const HandleMap &m2, bool value) 
+size_t SuRealCache::HandlePairHash::operator()(const HandlePair &p) const
 {
+    size_t seed = std::hash<Handle>()(p.first);
+    seed ^= std::hash<Handle>()(p.second) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    return seed;
+}
 
-    std::string key1 = build_map_hash_key(m1);
-    std::string key2 = build_map_hash_key(m2);
-    SuRealCache::StringCacheMap::iterator it1 = m_grounding_cache.find(key1);
-    if (it1 == m_grounding_cache.end()) {
-        StringMap new_map;
-        new_map.insert(StringMap::value_type(key2, value));
-        m_grounding_cache.insert(StringCacheMap::value_type(key1, new_map));
-    } else {
-        (*it1).second.insert(StringMap::value_type(key2, value));
+SuRealCache::Shard& SuRealCache::shard_for(size_t hash)
+{
+    // the low bits are what the maps use for their buckets
+    return m_shards[(hash >> 16) % NUM_SHARDS];
+}
+
+/**
+ * Account for a new entry, and make room for it if the shard went over
+ * its share of the budget.
+ */
+void SuRealCache::admit(Shard &shard, const Slot &slot)
+{
+    shard.used += slot.bytes;
+    shard.clock.push_back(slot);
+    evict(shard);
+}
+
+/**
+ * The CLOCK sweep: entries that were hit since the hand last passed get
+ * a second chance, the others are evicted until the shard fits again.
+ */
+void SuRealCache::evict(Shard &shard)
+{
+    if (m_budget == 0) return;
+    size_t budget = m_budget / NUM_SHARDS;
+
+    while (shard.used > budget and not shard.clock.empty()) {
+        Slot& slot = shard.clock.front();
+        if (*slot.referenced) {
+            *slot.referenced = false;
+            shard.clock.splice(shard.clock.end(), shard.clock, shard.clock.begin());
+            continue;
+        }
+
+        shard.used -= slot.bytes;
+        erase(shard, slot);
+        shard.clock.pop_front();
     }
 }
 
-int SuRealCache::grounding_match(const HandleMap &m1, const HandleMap &m2) 
+void SuRealCache::erase(Shard &shard, const Slot &slot)
+{
+    GroundingCacheMap* grounding_map = nullptr;
+
+    switch (slot.kind) {
+        case VARIABLE_SLOT:
+            shard.variable_cache.erase(slot.pair);
+            return;
+        case CLAUSE_SLOT:
+            shard.clause_cache.erase(slot.pair);
+            return;
+        case NODE_LIST_SLOT:
+            shard.node_list_cache.erase(slot.pair.first);
+            return;
+        case GROUNDING_SLOT:
+            grounding_map = &shard.grounding_cache;
+            break;
+        case PARTIAL_GROUNDING_SLOT:
+            grounding_map = &shard.partial_grounding_cache;
+            break;
+    }
+
+    auto range = grounding_map->equal_range(slot.hash);
+    for (auto it = range.first; it != range.second; it++) {
+        if (&(*it).second == slot.entry) {
+            grounding_map->erase(it);
+            return;
+        }
+    }
+}
+
+void SuRealCache::add_match(PairCacheMap Shard::*map, SlotKind kind,
+                            const Handle &h1, const Handle &h2, bool value) 
+{
+    HandlePair key(h1, h2);
+    Shard& shard = shard_for(HandlePairHash()(key));
+    std::lock_guard<std::mutex> lck(shard.mtx);
+
+    auto result = (shard.*map).insert(PairCacheMap::value_type(key, BoolRecord{value, false}));
+    if (not result.second) return;
+
+    Slot slot;
+    slot.kind = kind;
+    slot.pair = key;
+    slot.hash = 0;
+    slot.entry = nullptr;
+    slot.referenced = &(*result.first).second.referenced;
+    slot.bytes = sizeof(PairCacheMap::value_type) + sizeof(Slot) + 2 * NODE_OVERHEAD;
+    admit(shard, slot);
+}
+
+int SuRealCache::match(PairCacheMap Shard::*map, const Handle &h1, const Handle &h2) 
 {
+    HandlePair key(h1, h2);
+    Shard& shard = shard_for(HandlePairHash()(key));
+    std::lock_guard<std::mutex> lck(shard.mtx);
 
     int answer = -1;
 
-    std::string key1 = build_map_hash_key(m1);
-    SuRealCache::StringMap::iterator it1 = m_partial_grounding_cache.find(key1);
-    if (it1 != m_partial_grounding_cache.end()) {
-        answer = ((*it1).second ? 1 : 0);
-    } else {
-        std::string key2 = build_map_hash_key(m2);
-        SuRealCache::StringMap::iterator it2 = m_partial_grounding_cache.find(key2);
-        if (it2 != m_partial_grounding_cache.end()) {
-            answer = ((*it2).second ? 1 : 0);
-        } else {
-            SuRealCache::StringCacheMap::iterator it3 = m_grounding_cache.find(key1);
-            if (it3 != m_grounding_cache.end()) {
-                StringMap::iterator it4 = (*it3).second.find(key2);
-                if (it4 != (*it3).second.end()) {
-                    answer = ((*it4).second ? 1 : 0);
-                }
-            }
-        }
+    auto it = (shard.*map).find(key);
+    if (it != (shard.*map).end()) {
+        (*it).second.referenced = true;
+        answer = ((*it).second.value ? 1 : 0);
     }
 
     return answer;
 }
 
-void SuRealCache::add_variable_match(const Handle &h1, const Handle &h2, bool value) 
+static inline void mix_hash(ContentHash &seed, ContentHash h)
 {
-    return add_match(m_variable_cache, h1, h2, value);
+    seed ^= h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
 }
 
-int SuRealCache::variable_match(const Handle &h1, const Handle &h2) 
+/**
+ * Fold the content hashes of all the (pattern, solution) pairs of a
+ * HandleMap into a single hash.  The HandleMap is ordered, so equal
+ * maps always produce the same hash.
+ */
+ContentHash SuRealCache::map_hash(const HandleMap &m)
 {
-    return match(m_variable_cache, h1, h2);
+    ContentHash seed = m.size();
+    for (const auto& kv : m) {
+        mix_hash(seed, kv.first->get_hash());
+        mix_hash(seed, kv.second->get_hash());
+    }
+
+    return seed;
 }
 
-void SuRealCache::add_clause_match(const Handle &h1, const Handle &h2, bool value) 
+/**
+ * Two atoms are the same key component if they are the same atom, or
+ * if they have the same content (e.g. they are from different AtomSpaces).
+ */
+static inline bool same_atom(const Handle &h1, const Handle &h2)
 {
-    return add_match(m_clause_cache, h1, h2, value);
+    if (h1 == h2) return true;
+    return h1->get_hash() == h2->get_hash() and *h1 == *h2;
 }
 
-int SuRealCache::clause_match(const Handle &h1, const Handle &h2) 
+static bool same_key(const SuRealCache::HandlePairSeq &key, const HandleMap &m)
 {
-    return match(m_clause_cache, h1, h2);
+    if (key.size() != m.size()) return false;
+
+    return std::equal(key.begin(), key.end(), m.begin(),
+        [](const HandlePair &p, const HandleMap::value_type &kv) {
+            return same_atom(p.first, kv.first) and
+                   same_atom(p.second, kv.second); });
 }
 
-bool SuRealCache::get_node_list(const Handle &h, HandleSeq &list)
+// The caller must hold the lock of the shard the map belongs to.
+int SuRealCache::find_grounding(GroundingCacheMap &map, ContentHash hash,
+                                const HandleMap &m1, const HandleMap *m2)
 {
-    bool answer = false;
-
-    SuRealCache::HandleSeqCache::iterator it = m_node_list_cache.find(h);
-    if (it != m_node_list_cache.end()) {
-        list = (*it).second;
-        answer = true;
+    auto range = map.equal_range(hash);
+    for (auto it = range.first; it != range.second; it++) {
+        GroundingEntry &entry = (*it).second;
+        if (not same_key(entry.key1, m1)) continue;
+        if (m2 != nullptr and not same_key(entry.key2, *m2)) continue;
+        entry.referenced = true;
+        return (entry.value ? 1 : 0);
     }
 
-    return answer;
+    return -1;
 }
 
-void SuRealCache::add_node_list(const Handle &h, const HandleSeq &list)
+// The caller must hold the lock of the shard the map belongs to.
+void SuRealCache::insert_grounding(Shard &shard, GroundingCacheMap &map,
+                                   SlotKind kind, ContentHash hash,
+                                   const HandleMap &m1, const HandleMap *m2,
+                                   bool value)
 {
-    SuRealCache::HandleSeqCache::iterator it = m_node_list_cache.find(h);
-    if (it == m_node_list_cache.end()) {
-        m_node_list_cache.insert(HandleSeqCache::value_type(h, list));
-    }
+    // keep the first value added, as the string-keyed maps used to do
+    if (find_grounding(map, hash, m1, m2) >= 0) return;
+
+    GroundingEntry entry;
+    entry.key1.assign(m1.begin(), m1.end());
+    if (m2 != nullptr) entry.key2.assign(m2->begin(), m2->end());
+    entry.value = value;
+    entry.referenced = false;
+
+    size_t key_size = entry.key1.size() + entry.key2.size();
+    auto it = map.emplace(hash, std::move(entry));
+
+    Slot slot;
+    slot.kind = kind;
+    slot.hash = hash;
+    slot.entry = &(*it).second;
+    slot.referenced = &(*it).second.referenced;
+    slot.bytes = sizeof(GroundingCacheMap::value_type) + sizeof(Slot) +
+                 key_size * sizeof(HandlePair) + 2 * NODE_OVERHEAD;
+    admit(shard, slot);
 }
 
-void SuRealCache::reset() 
+void SuRealCache::add_grounding_match(const HandleMap &m1, bool value) 
 {
+    ContentHash hash = map_hash(m1);
+    Shard& shard = shard_for(hash);
+    std::lock_guard<std::mutex> lck(shard.mtx);
 
-    for (auto it = m_variable_cache.begin(); it != m_variable_cache.end(); it++) {
-        (*it).second.clear();
-    }
+    insert_grounding(shard, shard.partial_grounding_cache,
+                     PARTIAL_GROUNDING_SLOT, hash, m1, nullptr, value);
+}
 
-    for (auto it = m_clause_cache.begin(); it != m_clause_cache.end(); it++) {
-        (*it).second.clear();
-    }
+void SuRealCache::add_grounding_match(const HandleMap &m1, const HandleMap &m2, bool value) 
+{
+    ContentHash hash = map_hash(m1);
+    mix_hash(hash, map_hash(m2));
+    Shard& shard = shard_for(hash);
+    std::lock_guard<std::mutex> lck(shard.mtx);
 
-    for (auto it = m_grounding_cache.begin(); it != m_grounding_cache.end(); it++) {
-        (*it).second.clear();
-    }
+    insert_grounding(shard, shard.grounding_cache,
+                     GROUNDING_SLOT, hash, m1, &m2, value);
+}
+
+int SuRealCache::grounding_match(const HandleMap &m1, const HandleMap &m2) 
+{
+    // check the partial groundings first, on either of the two maps
+    auto partial_match = [&](ContentHash hash, const HandleMap &m)
+    {
+        Shard& shard = shard_for(hash);
+        std::lock_guard<std::mutex> lck(shard.mtx);
+        return find_grounding(shard.partial_grounding_cache, hash, m, nullptr);
+    };
+
+    auto lookup = [&]()
+    {
+        ContentHash hash1 = map_hash(m1);
+        int answer = partial_match(hash1, m1);
+        if (answer >= 0) return answer;
+
+        ContentHash hash2 = map_hash(m2);
+        answer = partial_match(hash2, m2);
+        if (answer >= 0) return answer;
+
+        ContentHash hash = hash1;
+        mix_hash(hash, hash2);
+        Shard& shard = shard_for(hash);
+        std::lock_guard<std::mutex> lck(shard.mtx);
+
+        return find_grounding(shard.grounding_cache, hash, m1, &m2);
+    };
+
+    int answer = lookup();
+
+    SuRealStats::count(answer >= 0 ? SuRealStats::GROUNDING_CACHE_HIT
+                                   : SuRealStats::GROUNDING_CACHE_MISS);
+    return answer;
+}
 
-    m_variable_cache.clear();
-    m_clause_cache.clear();
-    m_grounding_cache.clear();
-    m_partial_grounding_cache.clear();
-    m_node_list_cache.clear();
+void SuRealCache::add_variable_match(const Handle &h1, const Handle &h2, bool value) 
+{
+    return add_match(&Shard::variable_cache, VARIABLE_SLOT, h1, h2, value);
 }
 
-std::string SuRealCache::handle_to_hash_key(const Handle &h) 
+int SuRealCache::variable_match(const Handle &h1, const Handle &h2) 
 {
+    int answer = match(&Shard::variable_cache, h1, h2);
+    SuRealStats::count(answer >= 0 ? SuRealStats::VARIABLE_CACHE_HIT
+                                   : SuRealStats::VARIABLE_CACHE_MISS);
+    return answer;
+}
 
-    std::string answer = "";
-    Type type = h->get_type();
-    if (nameserver().isNode(type)) {
-        answer += nameserver().getTypeName(type);
-        answer += ":";
-        answer += h->get_name();
-    } else {
-        answer += nameserver().getTypeName(type);
-        answer += "(";
-        for (const Handle& target_handle: h->getOutgoingSet()) {
-            answer += handle_to_hash_key(target_handle);
-            answer += ",";
-        }
-        answer += ")";
-    }
+void SuRealCache::add_clause_match(const Handle &h1, const Handle &h2, bool value) 
+{
+    return add_match(&Shard::clause_cache, CLAUSE_SLOT, h1, h2, value);
+}
 
+int SuRealCache::clause_match(const Handle &h1, const Handle &h2) 
+{
+    int answer = match(&Shard::clause_cache, h1, h2);
+    SuRealStats::count(answer >= 0 ? SuRealStats::CLAUSE_CACHE_HIT
+                                   : SuRealStats::CLAUSE_CACHE_MISS);
     return answer;
 }
 
-std::string SuRealCache::build_map_hash_key(const HandleMap &m) 
+bool SuRealCache::get_node_list(const Handle &h, ArenaHandleSeq &list)
 {
+    Shard& shard = shard_for(std::hash<Handle>()(h));
+    std::lock_guard<std::mutex> lck(shard.mtx);
+
+    bool answer = false;
 
-    std::string answer = "";
-    for (auto it = m.begin(); it != m.end(); it++) {
-        answer += handle_to_hash_key(it->first);
-        answer += "-";
-        answer += handle_to_hash_key(it->second);
-        answer += "#";
+    SuRealCache::HandleSeqCache::iterator it = shard.node_list_cache.find(h);
+    if (it != shard.node_list_cache.end()) {
+        (*it).second.referenced = true;
+        list.assign((*it).second.list.begin(), (*it).second.list.end());
+        answer = true;
     }
 
+    SuRealStats::count(answer ? SuRealStats::NODE_LIST_CACHE_HIT
+                              : SuRealStats::NODE_LIST_CACHE_MISS);
     return answer;
 }
+
+void SuRealCache::add_node_list(const Handle &h, const ArenaHandleSeq &list)
+{
+    Shard& shard = shard_for(std::hash<Handle>()(h));
+    std::lock_guard<std::mutex> lck(shard.mtx);
+
+    auto result = shard.node_list_cache.insert(
+        HandleSeqCache::value_type(h, ListRecord{HandleSeq(list.begin(), list.end()), false}));
+    if (not result.second) return;
+
+    Slot slot;
+    slot.kind = NODE_LIST_SLOT;
+    slot.pair = HandlePair(h, Handle::UNDEFINED);
+    slot.hash = 0;
+    slot.entry = nullptr;
+    slot.referenced = &(*result.first).second.referenced;
+    slot.bytes = sizeof(HandleSeqCache::value_type) + sizeof(Slot) +
+                 list.size() * sizeof(Handle) + 2 * NODE_OVERHEAD;
+    admit(shard, slot);
+}
+
+void SuRealCache::reset() 
+{
+    for (Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lck(shard.mtx);
+
+        shard.variable_cache.clear();
+        shard.clause_cache.clear();
+        shard.grounding_cache.clear();
+        shard.partial_grounding_cache.clear();
+        shard.node_list_cache.clear();
+        shard.clock.clear();
+        shard.used = 0;
+    }
+}
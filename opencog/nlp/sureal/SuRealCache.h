@@ -24,23 +24,25 @@
 #ifndef _OPENCOG_SUREAL_CACHE_H
 #define _OPENCOG_SUREAL_CACHE_H
 
+#include <atomic>
+#include <list>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 #include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/neighbors/QueryArena.h>
 
 namespace opencog
 {
+class AtomSpace;
+
 namespace nlp
 {
 
 /**
- * A Cache between SuReal and PatternMatcher. This class is a Singleton.
- *
- * XXX THIS IS A BROKEN DESIGN! -- FIXME! (The fix is easy) The cache
- * needs to be kept in the atomspace; just put the atoms there, keep
- * them there, put them in well-known locations!  The problem with this
- * cache is that it does NOT work with multiple atomspaces; see for
- * example SuRealUTest, which bombs when multiple atomspces are used!!
- * FIXME by getting rid of this class!!!
+ * A Cache between SuReal and PatternMatcher.  There is one cache per
+ * AtomSpace, reached via instance().
  *
  * This cache stores the results of calls to differents methods of PatternMatcherCallBack
  * in separate Caches. This makes sense because such calls in SuReal are
@@ -51,8 +53,13 @@ namespace nlp
  * This class have a reset() method which is supposed to be called when the
  * bunch of similar SuReal requests have ended.
  *
- * A major deficiency of this cache is that is is not ready to be used in a
- * multi-thread scenario.
+ * The entries are spread over a fixed number of shards, each guarded by
+ * its own lock, so that several threads can run cached sureal queries
+ * against the same AtomSpace.  The cache is bounded by a memory budget;
+ * once a shard goes over its share of the budget, entries are evicted
+ * following the CLOCK (second chance) policy.  The memory used is an
+ * estimate of the cache's own bookkeeping; the atoms themselves live in
+ * the AtomSpace and are not counted.
  */
 class SuRealCache
 {
@@ -60,13 +67,34 @@ class SuRealCache
 public:
     ~SuRealCache();
 
-    static SuRealCache& instance();
-
-    typedef std::unordered_map<Handle, HandleSeq> HandleSeqCache;
-    typedef std::unordered_map<std::string, bool> StringMap;
-    typedef std::unordered_map<std::string, StringMap> StringCacheMap;
-    typedef std::unordered_map<Handle, bool> HandleBoolMap;
-    typedef std::unordered_map<Handle, HandleBoolMap> HandleCacheMap;
+    static SuRealCache& instance(const AtomSpace* as);
+    static void release(const AtomSpace* as);
+
+    // The budget is in bytes; zero means unbounded.
+    static void set_default_budget(size_t bytes);
+    void set_memory_budget(size_t bytes);
+    size_t memory_budget() const;
+    size_t memory_used();
+
+    /**
+     * The groundings are keyed by a fixed-width hash of the (sorted)
+     * pattern-solution pairs of the HandleMaps, computed from the content
+     * hashes of the atoms.  The pairs themselves are kept in the entry
+     * so that a hash collision can be told apart with a cheap comparison.
+     * Looking up a grounding does not allocate anything; memory is only
+     * used when a new entry is added.
+     */
+    typedef std::vector<HandlePair> HandlePairSeq;
+    struct GroundingEntry
+    {
+        HandlePairSeq key1;
+        HandlePairSeq key2;
+        bool value;
+        bool referenced;
+    };
+    typedef std::unordered_multimap<ContentHash, GroundingEntry> GroundingCacheMap;
+
+    static ContentHash map_hash(const HandleMap &m);
 
     int variable_match(const Handle &h1, const Handle &h2);
     void add_variable_match(const Handle &h1, const Handle &h2, bool value);
@@ -78,28 +106,88 @@ public:
     void add_grounding_match(const HandleMap &m1, bool value);
     void add_grounding_match(const HandleMap &m1, const HandleMap &m2, bool value);
 
-    bool get_node_list(const Handle &h, HandleSeq &list);
-    void add_node_list(const Handle &h, const HandleSeq &list);
+    bool get_node_list(const Handle &h, ArenaHandleSeq &list);
+    void add_node_list(const Handle &h, const ArenaHandleSeq &list);
 
     void reset();
 
 
 private:
 
-    SuRealCache();
-
-    static SuRealCache *instance_;
-
-    HandleCacheMap m_variable_cache;
-    HandleCacheMap m_clause_cache;
-    StringCacheMap m_grounding_cache;
-    StringMap m_partial_grounding_cache;
-    HandleSeqCache m_node_list_cache;
-
-    int match(HandleCacheMap &map, const Handle &h1, const Handle &h2);
-    void add_match(HandleCacheMap &map, const Handle &h1, const Handle &h2, bool value);
-    std::string build_map_hash_key(const HandleMap &m);
-    std::string handle_to_hash_key(const Handle &h);
+    SuRealCache(size_t budget);
+
+    static const size_t NUM_SHARDS = 16;
+
+    struct HandlePairHash
+    {
+        size_t operator()(const HandlePair &p) const;
+    };
+
+    struct BoolRecord
+    {
+        bool value;
+        bool referenced;
+    };
+
+    struct ListRecord
+    {
+        HandleSeq list;
+        bool referenced;
+    };
+
+    typedef std::unordered_map<HandlePair, BoolRecord, HandlePairHash> PairCacheMap;
+    typedef std::unordered_map<Handle, ListRecord> HandleSeqCache;
+
+    enum SlotKind
+    {
+        VARIABLE_SLOT,
+        CLAUSE_SLOT,
+        GROUNDING_SLOT,
+        PARTIAL_GROUNDING_SLOT,
+        NODE_LIST_SLOT
+    };
+
+    // An element of the CLOCK ring, i.e. enough to find an entry
+    // again in order to evict it.
+    struct Slot
+    {
+        SlotKind kind;
+        HandlePair pair;
+        ContentHash hash;
+        const GroundingEntry *entry;
+        bool *referenced;
+        size_t bytes;
+    };
+
+    struct Shard
+    {
+        std::mutex mtx;
+        PairCacheMap variable_cache;
+        PairCacheMap clause_cache;
+        GroundingCacheMap grounding_cache;
+        GroundingCacheMap partial_grounding_cache;
+        HandleSeqCache node_list_cache;
+        std::list<Slot> clock;   // the hand always points to the front
+        size_t used = 0;
+    };
+
+    Shard m_shards[NUM_SHARDS];
+    std::atomic<size_t> m_budget;
+
+    Shard& shard_for(size_t hash);
+
+    int match(PairCacheMap Shard::*map, const Handle &h1, const Handle &h2);
+    void add_match(PairCacheMap Shard::*map, SlotKind kind,
+                   const Handle &h1, const Handle &h2, bool value);
+    int find_grounding(GroundingCacheMap &map, ContentHash hash,
+                       const HandleMap &m1, const HandleMap *m2);
+    void insert_grounding(Shard &shard, GroundingCacheMap &map, SlotKind kind,
+                          ContentHash hash, const HandleMap &m1,
+                          const HandleMap *m2, bool value);
+
+    void admit(Shard &shard, const Slot &slot);
+    void evict(Shard &shard);
+    void erase(Shard &shard, const Slot &slot);
 };
 
 }
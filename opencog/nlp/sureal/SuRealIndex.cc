@@ -0,0 +1,251 @@
+/*
+ * SuRealIndex.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <memory>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/neighbors/GetPredicates.h>
+#include <opencog/neighbors/Neighbors.h>
+#include <opencog/nlp/lg-dict/LGDictUtils.h>
+#include <opencog/nlp/types/atom_types.h>
+
+#include "SuRealIndex.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+
+typedef std::unordered_map<const AtomSpace*, std::unique_ptr<SuRealIndex>> IndexRegistry;
+
+static std::mutex& registry_mutex()
+{
+    static std::mutex mtx;
+    return mtx;
+}
+
+static IndexRegistry& registry()
+{
+    static IndexRegistry indexes;
+    return indexes;
+}
+
+/**
+ * Get the index of the given AtomSpace, building it if needed.
+ */
+SuRealIndex& SuRealIndex::instance(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+
+    std::unique_ptr<SuRealIndex>& index = registry()[as];
+    if (index == nullptr) {
+        index.reset(new SuRealIndex(as));
+    }
+    return *index;
+}
+
+/**
+ * Drop the index of the given AtomSpace.  This must be called before
+ * the AtomSpace goes away, as the index is connected to its signals.
+ */
+void SuRealIndex::release(AtomSpace* as)
+{
+    std::lock_guard<std::mutex> lck(registry_mutex());
+    registry().erase(as);
+}
+
+SuRealIndex::SuRealIndex(AtomSpace* as) :
+    m_as(as)
+{
+    // connect first, so that nothing added during the scan is missed;
+    // add_reference() ignores the ReferenceLinks it has already seen
+    m_add_conn = m_as->atomAddedSignal().connect(
+        [this](const Handle& h) {
+            if (h->get_type() == REFERENCE_LINK) add_reference(h); });
+    m_remove_conn = m_as->atomRemovedSignal().connect(
+        [this](const AtomPtr& a) {
+            if (a->get_type() == REFERENCE_LINK) remove_reference(Handle(a)); });
+
+    HandleSeq qRefLinks;
+    m_as->get_handles_by_type(std::back_inserter(qRefLinks), REFERENCE_LINK);
+
+    for (const Handle& h : qRefLinks)
+        add_reference(h);
+}
+
+SuRealIndex::~SuRealIndex()
+{
+    m_as->atomAddedSignal().disconnect(m_add_conn);
+    m_as->atomRemovedSignal().disconnect(m_remove_conn);
+}
+
+/**
+ * The two bits of the Bloom filter for a node, out of 256.
+ */
+static inline void node_bits(const Handle& h, size_t& b1, size_t& b2)
+{
+    size_t hash = std::hash<Handle>()(h);
+    b1 = hash & 0xff;
+    b2 = (hash >> 8) & 0xff;
+}
+
+void SuRealIndex::Signature::add_node(const Handle& h)
+{
+    size_t b1, b2;
+    node_bits(h, b1, b2);
+    nodes[b1 / 64] |= uint64_t(1) << (b1 % 64);
+    nodes[b2 / 64] |= uint64_t(1) << (b2 % 64);
+}
+
+bool SuRealIndex::Signature::may_have_node(const Handle& h) const
+{
+    size_t b1, b2;
+    node_bits(h, b1, b2);
+    return (nodes[b1 / 64] & (uint64_t(1) << (b1 % 64))) and
+           (nodes[b2 / 64] & (uint64_t(1) << (b2 % 64)));
+}
+
+/**
+ * Summarize a R2L SetLink.  The nodes that are words, i.e. that have a
+ * WordInstanceNode of the same name, add the types of the connectors
+ * of the LG links of that instance:
+ *
+ *    EvaluationLink
+ *       LgLinkInstanceNode "Ss@123"
+ *       ListLink
+ *          WordInstanceNode "cats@456"
+ *          WordInstanceNode "sleep@789"
+ *
+ *    LgLinkInstanceLink
+ *       LgLinkInstanceNode "Ss@123"
+ *       LgConnector ...
+ *       LgConnector ...
+ *
+ * The parse is in by the time R2L links its output to the
+ * InterpretationNode.
+ */
+SuRealIndex::SignaturePtr SuRealIndex::make_signature(const Handle& hSetLink)
+{
+    auto sig = std::make_shared<Signature>();
+
+    HandleSeq stack(hSetLink->getOutgoingSet());
+    UnorderedHandleSet seen;
+    while (not stack.empty())
+    {
+        Handle h(stack.back());
+        stack.pop_back();
+        if (not seen.insert(h).second) continue;
+
+        if (h->is_link())
+        {
+            const HandleSeq& oset = h->getOutgoingSet();
+            stack.insert(stack.end(), oset.begin(), oset.end());
+            continue;
+        }
+
+        sig->add_node(h);
+
+        Handle hWordInst = m_as->get_handle(WORD_INSTANCE_NODE, h->get_name());
+        if (hWordInst == nullptr) continue;
+
+        for (const Handle& hEval : get_predicates(hWordInst, LG_LINK_INSTANCE_NODE))
+            for (const Handle& hConn : get_all_neighbors(hEval->getOutgoingAtom(0),
+                                                         LG_LINK_INSTANCE_LINK))
+                sig->conn_types |= Signature::conn_type_bit(lg_conn_signature(hConn).type);
+    }
+
+    return sig;
+}
+
+/**
+ * Index the members of the SetLink of a ReferenceLink, if it links
+ * an InterpretationNode to a SetLink.
+ */
+void SuRealIndex::add_reference(const Handle& h)
+{
+    if (h->get_arity() != 2) return;
+
+    const Handle& hInterp = h->getOutgoingAtom(0);
+    const Handle& hSetLink = h->getOutgoingAtom(1);
+    if (hInterp->get_type() != INTERPRETATION_NODE or
+        hSetLink->get_type() != SET_LINK)
+        return;
+
+    // made before taking the lock, as it looks at the parse
+    SignaturePtr sig = make_signature(hSetLink);
+
+    std::lock_guard<std::mutex> lck(m_mtx);
+
+    for (const Handle& c : hSetLink->getOutgoingSet())
+    {
+        ReferenceMap& refs = m_candidates[c->get_type()];
+
+        // already indexed, e.g. during the initial scan
+        auto range = refs.equal_range(h);
+        if (std::any_of(range.first, range.second,
+                        [&](const ReferenceMap::value_type& kv) {
+                            return kv.second.link == c; }))
+            continue;
+
+        refs.insert({h, {c, hInterp, hSetLink->get_arity(), sig}});
+    }
+}
+
+void SuRealIndex::remove_reference(const Handle& h)
+{
+    if (h->get_arity() != 2) return;
+
+    const Handle& hSetLink = h->getOutgoingAtom(1);
+    if (hSetLink->get_type() != SET_LINK) return;
+
+    std::lock_guard<std::mutex> lck(m_mtx);
+
+    for (const Handle& c : hSetLink->getOutgoingSet())
+    {
+        auto it = m_candidates.find(c->get_type());
+        if (it != m_candidates.end())
+            it->second.erase(h);
+    }
+}
+
+/**
+ * Get all the candidates of the given link type.  There is one for each
+ * (link, InterpretationNode) pair, so a link may appear several times.
+ *
+ * @param t   the type of the candidate links
+ * @return    a copy of the candidates
+ */
+SuRealIndex::CandidateSeq SuRealIndex::get_candidates(Type t)
+{
+    std::lock_guard<std::mutex> lck(m_mtx);
+
+    CandidateSeq results;
+
+    auto it = m_candidates.find(t);
+    if (it == m_candidates.end())
+        return results;
+
+    results.reserve(it->second.size());
+    for (const auto& kv : it->second)
+        results.push_back(kv.second);
+
+    return results;
+}
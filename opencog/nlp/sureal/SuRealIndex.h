@@ -0,0 +1,120 @@
+/*
+ * SuRealIndex.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_SUREAL_INDEX_H
+#define _OPENCOG_SUREAL_INDEX_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+class AtomSpace;
+
+namespace nlp
+{
+
+/**
+ * An index of the links that SuReal can start a search from, i.e. the
+ * links that are in a R2L SetLink of some InterpretationNode:
+ *
+ *    ReferenceLink
+ *       InterpretationNode "sentence@123_parse_0_interpretation_$X"
+ *       SetLink
+ *          <candidate link>
+ *          ...
+ *
+ * The candidates are grouped by link type.  There is one index per
+ * AtomSpace, reached via instance(); it is built by scanning the
+ * ReferenceLinks once, and then kept up to date from the AtomSpace's
+ * add and remove signals.  Each candidate carries the Signature of its
+ * SetLink, made when the ReferenceLink is indexed.
+ */
+class SuRealIndex
+{
+public:
+    ~SuRealIndex();
+
+    static SuRealIndex& instance(AtomSpace* as);
+    static void release(AtomSpace* as);
+
+    /**
+     * A summary of a R2L SetLink, for dropping search candidates that
+     * cannot match before the pattern matcher is started on them: a
+     * Bloom filter of the nodes in it, and the types of the LG
+     * connectors of their word instances, one bit per type, by the id
+     * of its upper-case part.  Both may say yes wrongly, never no.
+     */
+    struct Signature
+    {
+        uint64_t nodes[4] = {0, 0, 0, 0};
+        uint64_t conn_types = 0;
+
+        static uint64_t conn_type_bit(uint32_t type)
+        {
+            return uint64_t(1) << (type % 64);
+        }
+
+        void add_node(const Handle& h);
+        bool may_have_node(const Handle& h) const;
+    };
+    typedef std::shared_ptr<const Signature> SignaturePtr;
+
+    struct Candidate
+    {
+        Handle link;
+        Handle interp;
+        size_t r2lSetLinkSize;
+        SignaturePtr sig;
+    };
+    typedef std::vector<Candidate> CandidateSeq;
+
+    CandidateSeq get_candidates(Type t);
+
+private:
+    SuRealIndex(AtomSpace* as);
+
+    void add_reference(const Handle& h);
+    void remove_reference(const Handle& h);
+
+    SignaturePtr make_signature(const Handle& hSetLink);
+
+    AtomSpace* m_as;
+    int m_add_conn;
+    int m_remove_conn;
+
+    std::mutex m_mtx;
+
+    // the candidates, by link type, and then by the ReferenceLink
+    // they come from
+    typedef std::unordered_multimap<Handle, Candidate> ReferenceMap;
+    std::unordered_map<Type, ReferenceMap> m_candidates;
+};
+
+}
+}
+
+#endif // _OPENCOG_SUREAL_INDEX_H
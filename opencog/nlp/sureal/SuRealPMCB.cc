@@ -21,16 +21,27 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+
 #include <opencog/atoms/core/FindUtils.h>
 #include <opencog/atoms/pattern/PatternTerm.h>
 #include <opencog/query/PatternMatchEngine.h>
+#include <opencog/executor/Executor.h>
 #include <opencog/neighbors/GetPredicates.h>
 #include <opencog/neighbors/Neighbors.h>
+#include <opencog/neighbors/QueryArena.h>
 #include <opencog/nlp/types/atom_types.h>
+#include <opencog/nlp/types/InstanceName.h>
+#include <opencog/nlp/types/WordPosition.h>
 #include <opencog/nlp/lg-dict/LGDictUtils.h>
+#include <opencog/util/Logger.h>
 
 #include "SuRealPMCB.h"
 #include "SuRealCache.h"
+#include "SuRealIndex.h"
+#include "SuRealStats.h"
 
 
 using namespace opencog::nlp;
@@ -43,14 +54,25 @@ using namespace std;
  *
  * @param pAS            the corresponding AtomSpace
  * @param vars           the set of nodes that should be treated as variables
+ * @param use_cache      whether to use the SuRealCache of the AtomSpace
+ * @param lookups        the lookups shared with other queries, if any
  */
-SuRealPMCB::SuRealPMCB(AtomSpace* pAS, const HandleSet& vars, bool use_cache) :
+SuRealPMCB::SuRealPMCB(AtomSpace* pAS, const HandleSet& vars, bool use_cache,
+                       std::shared_ptr<SuRealLookups> lookups) :
     InitiateSearchMixin(pAS),
     TermMatchMixin(pAS),
     m_as(pAS),
-    m_vars(vars)
+    m_vars(vars),
+    m_lookups(lookups)
 {
+    if (m_lookups == nullptr)
+        m_lookups = std::make_shared<SuRealLookups>();
+
     m_use_cache = use_cache;
+    m_cache = use_cache ? &SuRealCache::instance(pAS) : nullptr;
+    m_results_cleared = false;
+    m_num_threads = 1;
+    m_max_results = 0;
 }
 
 SuRealPMCB::~SuRealPMCB()
@@ -70,8 +92,10 @@ SuRealPMCB::~SuRealPMCB()
  */
 bool SuRealPMCB::variable_match(const Handle &hPat, const Handle &hSoln)
 {
+    SuRealStats::count(SuRealStats::VARIABLE_MATCHES);
+
     if (m_use_cache) {
-        int cached = SuRealCache::instance().variable_match(hPat, hSoln);
+        int cached = m_cache->variable_match(hPat, hSoln);
         if (cached >= 0) {
             if (cached == 0) {
                 return false;
@@ -81,14 +105,17 @@ bool SuRealPMCB::variable_match(const Handle &hPat, const Handle &hSoln)
         }
     }
 
-    logger().debug("[SuReal] In variable_match, trying to ground:\n%sto\n%s",
-        hPat->to_short_string().c_str(), hSoln->to_short_string().c_str());
+    LAZY_LOG_DEBUG << "[SuReal] In variable_match, trying to ground:\n"
+                   << hPat->to_short_string()
+                   << "to\n"
+                   << hSoln->to_short_string();
 
     bool answer;
 
     // Reject if the solution is not of the same type.
     if (hPat->get_type() != hSoln->get_type()) {
-        logger().debug("[SuReal] In variable_match, type mismatch!");
+        LAZY_LOG_DEBUG << "[SuReal] In variable_match, type mismatch!";
+        SuRealStats::count(SuRealStats::REJECT_TYPE);
         answer = false;
     } else {
         // VariableNode can be matched to any VariableNode, similarly
@@ -97,13 +124,12 @@ bool SuRealPMCB::variable_match(const Handle &hPat, const Handle &hSoln)
             hPat->get_type() == INTERPRETATION_NODE) {
             answer = true;
         } else {
-            std::string sSoln = hSoln->get_name();
             // get the corresponding WordInstanceNode for hSoln
-            Handle hSolnWordInst = m_as->get_handle(WORD_INSTANCE_NODE, sSoln);
+            Handle hSolnWordInst = get_word_instance(hSoln);
             // no WordInstanceNode? reject!
             if (hSolnWordInst == Handle::UNDEFINED) {
-                logger().debug(
-                    "[SuReal] In variable_match, no word instance found!");
+                LAZY_LOG_DEBUG << "[SuReal] In variable_match, no word instance found!";
+                SuRealStats::count(SuRealStats::REJECT_NO_WORD_INST);
                 answer = false;
             } else {
                 answer = true;
@@ -112,7 +138,7 @@ bool SuRealPMCB::variable_match(const Handle &hPat, const Handle &hSoln)
     }
 
     if (m_use_cache) {
-        SuRealCache::instance().add_variable_match(hPat, hSoln, answer);
+        m_cache->add_variable_match(hPat, hSoln, answer);
     }
 
     return answer;
@@ -124,7 +150,7 @@ bool SuRealPMCB::variable_match(const Handle &hPat, const Handle &hSoln)
  * @param h     the top level link
  * @return      a HandleSeq of nodes
  */
-static void get_nodes(const Handle& h, HandleSeq& node_list)
+static void get_nodes(const Handle& h, ArenaHandleSeq& node_list)
 {
    if (h->is_node())
    {
@@ -136,13 +162,13 @@ static void get_nodes(const Handle& h, HandleSeq& node_list)
       get_nodes(o, node_list);
 }
 
-static void get_all_nodes(const Handle& h, HandleSeq& node_list, bool use_cache)
+static void get_all_nodes(const Handle& h, ArenaHandleSeq& node_list, SuRealCache* cache)
 {
-    if (use_cache) {
-        bool cached = SuRealCache::instance().get_node_list(h, node_list);
+    if (cache != nullptr) {
+        bool cached = cache->get_node_list(h, node_list);
         if (! cached) {
             get_nodes(h, node_list);
-            SuRealCache::instance().add_node_list(h, node_list);
+            cache->add_node_list(h, node_list);
         }
     } else {
         get_nodes(h, node_list);
@@ -168,8 +194,10 @@ static void get_all_nodes(const Handle& h, HandleSeq& node_list, bool use_cache)
  */
 bool SuRealPMCB::clause_match(const Handle &pattrn_link_h, const Handle &grnd_link_h)
 {
+    SuRealStats::count(SuRealStats::CLAUSE_MATCHES);
+
     if (m_use_cache) {
-        int cached = SuRealCache::instance().clause_match(pattrn_link_h, grnd_link_h);
+        int cached = m_cache->clause_match(pattrn_link_h, grnd_link_h);
         if (cached >= 0) {
             if (cached == 0) {
                 return false;
@@ -179,22 +207,25 @@ bool SuRealPMCB::clause_match(const Handle &pattrn_link_h, const Handle &grnd_li
         }
     }
 
-    logger().debug("[SuReal] In clause_match, trying to ground:\n%sto\n%s",
-        pattrn_link_h->to_short_string().c_str(),
-            grnd_link_h->to_short_string().c_str());
+    LAZY_LOG_DEBUG << "[SuReal] In clause_match, trying to ground:\n"
+                   << pattrn_link_h->to_short_string()
+                   << "to\n"
+                   << grnd_link_h->to_short_string();
 
-    HandleSeq qISet;
+    ArenaHandleSeq qISet(&m_arena);
     grnd_link_h->getIncomingSetByType(back_inserter(qISet), SET_LINK);
 
     // Store the InterpretationNodes, will be needed if this grounding
     // is accepted.
-    HandleSeq qTempInterpNodes;
+    ArenaHandleSeq qTempInterpNodes(&m_arena);
 
     // helper lambda function to check for linkage to an InterpretationNode,
     // and see if it's one of the targets we are looking for, given SetLink
+    ArenaHandleSeq qN(&m_arena);
     auto hasInterpretation = [&](Handle& h)
     {
-        HandleSeq qN = get_source_neighbors(h, REFERENCE_LINK);
+        qN.clear();
+        get_source_neighbors(back_inserter(qN), h, REFERENCE_LINK);
         return std::any_of(qN.begin(), qN.end(), [&](Handle& hn) {
                 bool isInterpNode = hn->get_type() == INTERPRETATION_NODE;
                 bool isTarget = m_targets.size() > 0? (m_targets.find(hn) != m_targets.end()) : true;
@@ -206,26 +237,26 @@ bool SuRealPMCB::clause_match(const Handle &pattrn_link_h, const Handle &grnd_li
     // the InterpretationNode is not one of the targets
     if (not std::any_of(qISet.begin(), qISet.end(), hasInterpretation)) {
         if (m_use_cache) {
-            SuRealCache::instance().add_clause_match(pattrn_link_h, grnd_link_h, false);
+            m_cache->add_clause_match(pattrn_link_h, grnd_link_h, false);
         }
 
-        logger().debug("[SuReal] In clause_match, no target InterpretationNode found!");
+        LAZY_LOG_DEBUG << "[SuReal] In clause_match, no target InterpretationNode found!";
         return false;
     }
 
     // Get all the nodes from the pattern and the potential solution.
-    HandleSeq qAllPatNodes;
-    get_all_nodes(pattrn_link_h, qAllPatNodes, m_use_cache);
-    HandleSeq qAllSolnNodes;
-    get_all_nodes(grnd_link_h, qAllSolnNodes, m_use_cache);
+    ArenaHandleSeq qAllPatNodes(&m_arena);
+    get_all_nodes(pattrn_link_h, qAllPatNodes, m_cache);
+    ArenaHandleSeq qAllSolnNodes(&m_arena);
+    get_all_nodes(grnd_link_h, qAllSolnNodes, m_cache);
 
     // Just in case if their sizes are not the same, reject the match.
     if (qAllPatNodes.size() != qAllSolnNodes.size()) {
         if (m_use_cache) {
-            SuRealCache::instance().add_clause_match(pattrn_link_h, grnd_link_h, false);
+            m_cache->add_clause_match(pattrn_link_h, grnd_link_h, false);
         }
 
-        logger().debug("[SuReal] In clause_match, size mismatch!");
+        LAZY_LOG_DEBUG << "[SuReal] In clause_match, size mismatch!";
         return false;
     }
 
@@ -243,31 +274,10 @@ bool SuRealPMCB::clause_match(const Handle &pattrn_link_h, const Handle &grnd_li
         if (hPatNode->get_type() == PREDICATE_NODE) continue;
 
         // get the corresponding WordNode of the pattern node
-        Handle hPatWordNode;
-        auto it = m_words.find(hPatNode);
-        if (it == m_words.end())
-        {
-            HandleSeq neighbor_win = get_target_neighbors(hPatNode, REFERENCE_LINK);
-
-            if (neighbor_win.size() != 0)
-            {
-                HandleSeq neighbor_wn = get_target_neighbors(neighbor_win[0], REFERENCE_LINK);
-                hPatWordNode = neighbor_wn[0];
-
-            }
-            else
-            {
-                string sPat = hPatNode->get_name();
-                string sPatWord = sPat.substr(0, sPat.find_first_of('@'));
-                sPatWord = sPatWord.substr(0, sPatWord.find_last_of('.'));
-                hPatWordNode = m_as->get_handle(WORD_NODE, sPatWord);
-            }
-        }
-        else hPatWordNode = it->second;
+        Handle hPatWordNode = get_pattern_word(hPatNode);
 
         // get the corresponding WordInstanceNode of the solution node
-        std::string sSoln = hSolnNode->get_name();
-        Handle hSolnWordInst = m_as->get_handle(WORD_INSTANCE_NODE, sSoln);
+        Handle hSolnWordInst = get_word_instance(hSolnNode);
 
         // if the node is a variable, it would have matched to a node with
         // corresponding WordInstanceNode by variable match
@@ -280,12 +290,13 @@ bool SuRealPMCB::clause_match(const Handle &pattrn_link_h, const Handle &grnd_li
         // do the actual disjunct match
         if (not disjunct_match(hPatWordNode, hSolnWordInst)) {
             if (m_use_cache) {
-                SuRealCache::instance().add_clause_match(pattrn_link_h, grnd_link_h, false);
+                m_cache->add_clause_match(pattrn_link_h, grnd_link_h, false);
             }
 
-            logger().debug("[SuReal] In clause_match, disjuncts mismatch:\n%s%s",
-                hPatWordNode->to_short_string().c_str(),
-                    hSolnWordInst->to_short_string().c_str());
+            LAZY_LOG_DEBUG << "[SuReal] In clause_match, disjuncts mismatch:\n"
+                           << hPatWordNode->to_short_string()
+                           << hSolnWordInst->to_short_string();
+            SuRealStats::count(SuRealStats::REJECT_DISJUNCT);
 
             return false;
         }
@@ -296,7 +307,7 @@ bool SuRealPMCB::clause_match(const Handle &pattrn_link_h, const Handle &grnd_li
     m_interp.insert(qTempInterpNodes.begin(), qTempInterpNodes.end());
 
     if (m_use_cache) {
-        SuRealCache::instance().add_clause_match(pattrn_link_h, grnd_link_h, true);
+        m_cache->add_clause_match(pattrn_link_h, grnd_link_h, true);
     }
 
     return true;
@@ -316,8 +327,11 @@ bool SuRealPMCB::clause_match(const Handle &pattrn_link_h, const Handle &grnd_li
  */
 bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln)
 {
+    SuRealStats::count(SuRealStats::GROUNDINGS);
+    SuRealStats::ScopedTimer timer(SuRealStats::GROUNDING_TIME);
+
     if (m_use_cache) {
-        int cached = SuRealCache::instance().grounding_match(var_soln, pred_soln);
+        int cached = m_cache->grounding_match(var_soln, pred_soln);
         if (cached >= 0) {
             if (cached == 0) {
                 return false;
@@ -328,53 +342,56 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
     }
 
     // helper to get the InterpretationNode
+    ArenaHandleSeq qISet(&m_arena);
     auto getInterpretation = [&](const Handle& h)
     {
-        HandleSeq qISet;
+        qISet.clear();
         h->getIncomingSetByType(back_inserter(qISet), SET_LINK);
 
-        HandleSeq results;
+        ArenaHandleSeq results(&m_arena);
         for (auto& hSetLink : qISet)
         {
-            HandleSeq qN = get_source_neighbors(hSetLink, REFERENCE_LINK);
-            qN.erase(std::remove_if(qN.begin(), qN.end(), [](Handle& h) { return h->get_type() != INTERPRETATION_NODE; }), qN.end());
-
-            results.insert(results.end(), qN.begin(), qN.end());
+            foreach_source_neighbor(hSetLink, REFERENCE_LINK, [&](const Handle& hn) {
+                if (hn->get_type() == INTERPRETATION_NODE) results.push_back(hn);
+                return false; });
         }
 
         return results;
     };
 
-    HandleSeq qItprNode = getInterpretation(pred_soln.begin()->second);
+    ArenaHandleSeq qItprNode = getInterpretation(pred_soln.begin()->second);
     std::sort(qItprNode.begin(), qItprNode.end());
 
-    string debug_str = (pred_soln.begin()->second)->to_short_string();
-
     // try to find a common InterpretationNode to the solutions
     // i.e. all the solution-clauses have to come from the same interpretation (of a sentence)
+    ArenaHandleSeq overlapSeq(&m_arena);
     for (HandleMap::const_iterator it = ++pred_soln.begin(); it != pred_soln.end(); ++it)
     {
-        debug_str.append(it->second->to_short_string());
-
-        HandleSeq thisSeq = getInterpretation(it->second);
+        ArenaHandleSeq thisSeq = getInterpretation(it->second);
         std::sort(thisSeq.begin(), thisSeq.end());
 
-        HandleSeq overlapSeq;
+        overlapSeq.clear();
         std::set_intersection(qItprNode.begin(), qItprNode.end(), thisSeq.begin(), thisSeq.end(), std::back_inserter(overlapSeq));
 
-        qItprNode = overlapSeq;
+        qItprNode.swap(overlapSeq);
     }
 
-    logger().debug("[SuReal] In grounding, trying to find a common interpretation between:\n%s",
-      debug_str.c_str());
+    if (logger().is_debug_enabled())
+    {
+        string debug_str;
+        for (const auto& ps : pred_soln)
+            debug_str.append(ps.second->to_short_string());
+        logger().debug("[SuReal] In grounding, trying to find a common interpretation between:\n%s",
+          debug_str.c_str());
+    }
 
     // no common InterpretationNode, ignore this grounding
     if (qItprNode.empty()) {
         if (m_use_cache) {
-            SuRealCache::instance().add_grounding_match(pred_soln, false); // pred
+            m_cache->add_grounding_match(pred_soln, false); // pred
         }
 
-        logger().debug("[SuReal] In grounding, no common InterpretationNode found!");
+        LAZY_LOG_DEBUG << "[SuReal] In grounding, no common InterpretationNode found!";
         return false;
     }
 
@@ -395,30 +412,16 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
         // because each variable should map to its own unique solution
         if (std::any_of(shrinked_soln.begin(), shrinked_soln.end(), checker)) {
             if (m_use_cache) {
-                SuRealCache::instance().add_grounding_match(var_soln, false); // var
+                m_cache->add_grounding_match(var_soln, false); // var
             }
 
-            logger().debug("[SuReal] In grounding, can't ground it to the same solution!");
+            LAZY_LOG_DEBUG << "[SuReal] In grounding, can't ground it to the same solution!";
+            SuRealStats::count(SuRealStats::REJECT_SAME_SOLUTION);
             return false;
         }
 
-        std::string sName = kv.first->get_name();
-
-        Handle hPatWord;
-        HandleSeq neighbor_win = get_target_neighbors(kv.first, REFERENCE_LINK);
-        if (neighbor_win.size() != 0 )
-        {
-            HandleSeq neighbor_wn = get_target_neighbors(neighbor_win[0], REFERENCE_LINK);
-            hPatWord = neighbor_wn[0];
-        }
-        else
-        {
-            string sWord = sName.substr(0, sName.find_first_of('@'));
-            sWord = sWord.substr(0, sWord.find_last_of('.'));
-            hPatWord = m_as->get_handle(WORD_NODE, sWord);
-        }
-
-        Handle hSolnWordInst = m_as->get_handle(WORD_INSTANCE_NODE, kv.second->get_name());
+        Handle hPatWord = get_pattern_word(kv.first);
+        Handle hSolnWordInst = get_word_instance(kv.second);
         // do a disjunct match for PredicateNodes as well
         if (kv.first->get_type() == PREDICATE_NODE and kv.second->get_type() == PREDICATE_NODE)
         {
@@ -428,18 +431,19 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
             // not a lemma, so just do a disjunct match for it
             if (qLemmaLinks.size() == 0)
             {
-                logger().debug("[SuReal] In grounding, this predicate is probably not a lemma: %s",
-                  hPatWord->to_short_string().c_str());
+                LAZY_LOG_DEBUG << "[SuReal] In grounding, this predicate is probably not a lemma: "
+                               << hPatWord->to_short_string();
 
                 // reject it if disjuncts do not match
                 if (not disjunct_match(hPatWord, hSolnWordInst)) {
                     if (m_use_cache) {
-                        SuRealCache::instance().add_grounding_match(var_soln, false); // var
+                        m_cache->add_grounding_match(var_soln, false); // var
                     }
 
-                    logger().debug("[SuReal] In grounding, disjunct mismatch!\n%s%s",
-                        hPatWord->to_short_string().c_str(),
-                            hSolnWordInst->to_short_string().c_str());
+                    LAZY_LOG_DEBUG << "[SuReal] In grounding, disjunct mismatch!\n"
+                                   << hPatWord->to_short_string()
+                                   << hSolnWordInst->to_short_string();
+                    SuRealStats::count(SuRealStats::REJECT_DISJUNCT);
 
                     return false;
                 }
@@ -452,8 +456,8 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
             // and do a disjunct match for each of them
             else
             {
-                logger().debug("[SuReal] In grounding, this predicate is a lemma: %s",
-                  hPatWord->to_short_string().c_str());
+                LAZY_LOG_DEBUG << "[SuReal] In grounding, this predicate is a lemma: "
+                               << hPatWord->to_short_string();
 
                 bool found = false;
 
@@ -466,7 +470,7 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
                         continue;
 
                     std::string sName = qOS[0]->get_name();
-                    std::string sWord = get_target_neighbors(qOS[0], REFERENCE_LINK)[0]->get_name();
+                    std::string sWord = first_target_neighbor(qOS[0], REFERENCE_LINK)->get_name();
 
                     // make sure the tense matches
                     // first get the tense of the solution instance node
@@ -484,8 +488,10 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
                         {
                             sTense = qInhOS[1]->get_name();
 
-                            logger().debug("[SuReal] In grounding, tense of %sis %s",
-                                kv.second->to_short_string().c_str(), sTense.c_str());
+                            LAZY_LOG_DEBUG << "[SuReal] In grounding, tense of "
+                                           << kv.second->to_short_string()
+                                           << "is "
+                                           << sTense;
 
                             break;
                         }
@@ -506,9 +512,10 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
                                 has_tense = true;
                                 eq_tense = sTense == qInhOS[1]->get_name();
 
-                                logger().debug("[SuReal] In grounding, tense of %sis %s",
-                                    hPatPredNode->to_short_string().c_str(),
-                                        qInhOS[1]->get_name().c_str());
+                                LAZY_LOG_DEBUG << "[SuReal] In grounding, tense of "
+                                               << hPatPredNode->to_short_string()
+                                               << "is "
+                                               << qInhOS[1]->get_name();
 
                                 break;
                             }
@@ -518,7 +525,7 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
                     // reject if their tenses don't match
                     if (has_tense and not eq_tense)
                     {
-                        logger().debug("[SuReal] In grounding, tense mismatch!");
+                        LAZY_LOG_DEBUG << "[SuReal] In grounding, tense mismatch!";
                         continue;
                     }
 
@@ -543,10 +550,11 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
                 // passed the disjunct match
                 if (not found) {
                     if (m_use_cache) {
-                        SuRealCache::instance().add_grounding_match(var_soln, false); // var
+                        m_cache->add_grounding_match(var_soln, false); // var
                     }
 
-                    logger().debug("[SuReal] In grounding, no matching disjunct found!");
+                    LAZY_LOG_DEBUG << "[SuReal] In grounding, no matching disjunct found!";
+                    SuRealStats::count(SuRealStats::REJECT_DISJUNCT);
                     return false;
                 }
             }
@@ -563,9 +571,11 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
 
                 else
                 {
-                    logger().debug("[SuReal] In grounding, disjunct mismatch!\n%s\n%s",
-                        hPatWord->to_short_string().c_str(),
-                            hSolnWordInst->to_short_string().c_str());
+                    LAZY_LOG_DEBUG << "[SuReal] In grounding, disjunct mismatch!\n"
+                                   << hPatWord->to_short_string()
+                                   << "\n"
+                                   << hSolnWordInst->to_short_string();
+                    SuRealStats::count(SuRealStats::REJECT_DISJUNCT);
 
                     return false;
                 }
@@ -579,21 +589,21 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
         }
     }
 
-    HandleSet qSolnSetLinks;
+    ArenaHandleSet qSolnSetLinks(&m_arena);
 
     // get the R2L-SetLinks that are related to these InterpretationNodes
     for (Handle& hItprNode : qItprNode)
     {
-        HandleSeq qN = get_target_neighbors(hItprNode, REFERENCE_LINK);
-        qN.erase(std::remove_if(qN.begin(), qN.end(), [](Handle& h) { return h->get_type() != SET_LINK; }), qN.end());
-
-        // just in case... make sure all the pred_solns exist in the SetLink
-        for (auto& hSetLink : qN)
+        foreach_target_neighbor(hItprNode, REFERENCE_LINK, [&](const Handle& hSetLink)
         {
+            if (hSetLink->get_type() != SET_LINK) return false;
+
+            // just in case... make sure all the pred_solns exist in the SetLink
             if (std::all_of(pred_soln.begin(), pred_soln.end(),
-                            [&](HandlePair soln) { return is_atom_in_tree(hSetLink, soln.second); }))
+                            [&](const HandlePair& soln) { return is_atom_in_tree(hSetLink, soln.second); }))
                 qSolnSetLinks.insert(hSetLink);
-        }
+            return false;
+        });
     }
 
     // if there are more than one common InterpretationNodes at this point,
@@ -603,7 +613,8 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
         bool isGoodEnough = true;
 
         // extract the leftovers from the solution SetLink
-        HandleSeq qLeftover = hSetLink->getOutgoingSet();
+        const HandleSeq& qOS = hSetLink->getOutgoingSet();
+        ArenaHandleSeq qLeftover(qOS.begin(), qOS.end(), &m_arena);
         for (auto it = pred_soln.begin(); it != pred_soln.end(); it++)
         {
             auto itc = std::find(qLeftover.begin(), qLeftover.end(), it->second);
@@ -619,12 +630,16 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
         //     WordInstanceNode "water@123"
         auto checker = [] (Handle& h)
         {
-            HandleSeq qN = get_target_neighbors(h, REFERENCE_LINK);
-            return qN.size() != 1 or qN[0]->get_type() != WORD_INSTANCE_NODE;
+            size_t n = 0;
+            bool isWordInst = false;
+            foreach_target_neighbor(h, REFERENCE_LINK, [&](const Handle& hn) {
+                isWordInst = hn->get_type() == WORD_INSTANCE_NODE;
+                return ++n > 1; });
+            return n != 1 or not isWordInst;
         };
 
-        HandleSeq qWordInstNodes;
-        get_all_nodes(hSetLink, qWordInstNodes, m_use_cache);
+        ArenaHandleSeq qWordInstNodes(&m_arena);
+        get_all_nodes(hSetLink, qWordInstNodes, m_cache);
         qWordInstNodes.erase(std::remove_if(qWordInstNodes.begin(), qWordInstNodes.end(),
                                             checker), qWordInstNodes.end());
 
@@ -632,9 +647,9 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
         // form a logical relationship with more than one word of the sentence
         for (Handle& l : qLeftover)
         {
-            std::set<UUID> sWordFound;
-            HandleSeq qNodes;
-            get_all_nodes(l, qNodes, m_use_cache);
+            std::pmr::set<UUID> sWordFound(&m_arena);
+            ArenaHandleSeq qNodes(&m_arena);
+            get_all_nodes(l, qNodes, m_cache);
 
             for (const Handle& n : qNodes)
             {
@@ -671,7 +686,8 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
                 // two or more words
                 if (cnt > 0)
                 {
-                    logger().debug("[SuReal] In grounding, solution is not good enough!");
+                    LAZY_LOG_DEBUG << "[SuReal] In grounding, solution is not good enough!";
+                    SuRealStats::count(SuRealStats::REJECT_NOT_GOOD_ENOUGH);
                     isGoodEnough = false;
                     break;
                 }
@@ -680,7 +696,10 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
 
         // if we find a good enough solution, clear previous (not good enough) ones, if any
         if (isGoodEnough)
+        {
             m_results.clear();
+            m_results_cleared = true;
+        }
 
         // store the solution; all common InterpretationNode are solutions for this
         // grounding, so store the solution for each InterpretationNode
@@ -693,201 +712,342 @@ bool SuRealPMCB::grounding(const HandleMap &var_soln, const HandleMap &pred_soln
             if (m_results.count(n) == 0)
                 m_results[n] = HandleMapSeq();
 
-            logger().debug("[SuReal] grounding Interpreation: %s", n->to_short_string().c_str());
+            LAZY_LOG_DEBUG << "[SuReal] grounding Interpreation: "
+                           << n->to_short_string();
             m_results[n].push_back(shrinked_soln);
         }
 
         if (m_use_cache) {
-            //SuRealCache::instance().add_grounding_match(var_soln, pred_soln, true);
+            //m_cache->add_grounding_match(var_soln, pred_soln, true);
             return true;
         } else {
+            // stop if we have got as many interpretations as we were asked for
+            if (m_max_results > 0 and m_results.size() >= m_max_results)
+                return true;
+
             return isGoodEnough;
         }
     }
 
     if (m_use_cache) {
-        SuRealCache::instance().add_grounding_match(var_soln, pred_soln, false);
+        m_cache->add_grounding_match(var_soln, pred_soln, false);
     }
 
     return false;
 }
 
 /**
- * Check the disjuncts between two words and see if they match.
+ * Get the InterpretationNodes of the results, sorted by the size of their
+ * SetLinks; the idea is that the larger the size, the more stuff in the
+ * SetLink that are not part of the query's clauses.
  *
- * @param hPatWordNode   a WordNode from the input pattern
- * @param hSolnWordInst  a WordInstanceNode from a potential solution
- * @return               true if matches, false otherwise
+ * @param max_results  the most InterpretationNodes to return; 0 for all
+ * @return             the best InterpretationNodes first
  */
-bool SuRealPMCB::disjunct_match(const Handle& hPatWordNode, const Handle& hSolnWordInst)
+HandleSeq SuRealPMCB::ranked_interpretations(size_t max_results) const
 {
-    logger().debug("[SuReal] In disjunct_match, checking disjuncts for:\n%s%s",
-        hPatWordNode->to_short_string().c_str(),
-            hSolnWordInst->to_short_string().c_str());
+    std::vector<std::pair<size_t, Handle>> qSortedItpr;
+    for (auto& r : m_results)
+    {
+        // get the corresponding SetLink
+        HandleSeq qSetLinks = get_target_neighbors(r.first, REFERENCE_LINK);
+        auto it = std::find_if(qSetLinks.begin(), qSetLinks.end(),
+            [](const Handle& h) { return h->get_type() == SET_LINK; });
+
+        // the SetLink may have been removed since it was matched, by
+        // another thread; then there is nothing left to say
+        if (it == qSetLinks.end())
+            continue;
 
-    // the source connectors for the solution
-    HandleSeq qTargetConns;
+        // assuming each InterpretationNode is only linked to one SetLink
+        // and compare using arity
+        qSortedItpr.push_back({(*it)->get_arity(), r.first});
+    }
 
-    HandleSeq qSolnEvalLinks = get_predicates(hSolnWordInst, LG_LINK_INSTANCE_NODE);
+    std::stable_sort(qSortedItpr.begin(), qSortedItpr.end(),
+        [](const std::pair<size_t, Handle>& i, const std::pair<size_t, Handle>& j)
+        { return i.first < j.first; });
 
-    HandleSeq qLGInstsLeft;
-    HandleSeq qLGInstsRight;
-    for (Handle& hSolnEvalLink : qSolnEvalLinks)
-    {
-        HandleSeq qOS = hSolnEvalLink->getOutgoingSet();
-        HandleSeq qWordInsts = qOS[1]->getOutgoingSet();
+    HandleSeq keys;
+    for (auto& i : qSortedItpr)
+        keys.push_back(i.second);
 
-        // divide them into two groups, assuming there are only two WordInstanceNodes in the ListLink
-        if (qWordInsts[0] == hSolnWordInst) qLGInstsRight.push_back(hSolnEvalLink);
-        if (qWordInsts[1] == hSolnWordInst) qLGInstsLeft.push_back(hSolnEvalLink);
-    }
+    if (max_results > 0 and keys.size() > max_results)
+        keys.resize(max_results);
+
+    return keys;
+}
+
+/**
+ * Find the corresponding WordNode of a node in a pattern, either through
+ * its WordInstanceNode, or from its name if it does not have one.
+ *
+ * @param pAS   the AtomSpace to look in
+ * @param h     a node from the pattern
+ * @return      the WordNode, or Handle::UNDEFINED if there is none
+ */
+Handle SuRealPMCB::find_word_node(AtomSpace* pAS, const Handle& h)
+{
+    Handle hWord = get_instance_word(h);
+    if (hWord)
+        return hWord;
+
+    const string& sName = h->get_name();
+    string sWord(sName, 0, instance_word_length(sName));
+    sWord = sWord.substr(0, sWord.find_last_of('.'));
+    return pAS->get_handle(WORD_NODE, sWord);
+}
 
-    // helper for sorting EvaluationLinks in reverse word sequence order
-    auto sortLeftInsts = [](const Handle& h1, const Handle& h2)
+/**
+ * Get the corresponding WordNode of a pattern node, from the table given
+ * by set_pattern_words() if it is there.
+ *
+ * @param hPatNode   a node from the pattern
+ * @return           the WordNode, or Handle::UNDEFINED if there is none
+ */
+Handle SuRealPMCB::get_pattern_word(const Handle& hPatNode)
+{
+    if (m_pat_words != nullptr)
     {
-        // get the ListLinks from the EvaluationLinks
-        const Handle& hListLink1 = h1->getOutgoingAtom(1);
-        const Handle& hListLink2 = h2->getOutgoingAtom(1);
+        auto it = m_pat_words->find(hPatNode);
+        if (it != m_pat_words->end())
+            return it->second;
+    }
 
-        // get the first WordInstanceNodes from the ListLinks
-        const Handle& hWordInst1 = hListLink1->getOutgoingAtom(0);
-        const Handle& hWordInst2 = hListLink2->getOutgoingAtom(0);
+    return find_word_node(m_as, hPatNode);
+}
 
-        // get the NumberNodes from the WordSequenceLinks
-        Handle hNumNode1 = get_target_neighbors(hWordInst1, WORD_SEQUENCE_LINK)[0];
-        Handle hNumNode2 = get_target_neighbors(hWordInst2, WORD_SEQUENCE_LINK)[0];
+/**
+ * Get the corresponding WordInstanceNode of a solution node, i.e. the
+ * WordInstanceNode with the same name.
+ *
+ * @param hSolnNode   a node from a potential solution
+ * @return            the WordInstanceNode, or Handle::UNDEFINED if there is none
+ */
+Handle SuRealPMCB::get_word_instance(const Handle& hSolnNode)
+{
+    auto it = m_lookups->word_insts.find(hSolnNode);
+    if (it != m_lookups->word_insts.end())
+        return it->second;
 
-        // compare their word sequences
-        return hNumNode1->get_name() > hNumNode2->get_name();
-    };
+    Handle hSolnWordInst = m_as->get_handle(WORD_INSTANCE_NODE, hSolnNode->get_name());
+    m_lookups->word_insts[hSolnNode] = hSolnWordInst;
+    return hSolnWordInst;
+}
 
-    // helper for sorting EvaluationLinks in word sequence order
-    auto sortRightInsts = [](const Handle& h1, const Handle& h2)
-    {
-        // get the ListLinks from the EvaluationLinks
-        const Handle& hListLink1 = h1->getOutgoingAtom(1);
-        const Handle& hListLink2 = h2->getOutgoingAtom(1);
+/**
+ * Get the ID of a LG connector, giving it a new one if it has not been
+ * seen before.
+ *
+ * @param hConn   a LgConnector
+ * @return        the ID of hConn, an index into m_lookups->conns
+ */
+SuRealPMCB::ConnId SuRealPMCB::intern_connector(const Handle& hConn)
+{
+    auto it = m_lookups->conn_ids.find(hConn);
+    if (it != m_lookups->conn_ids.end())
+        return it->second;
 
-        // get the second WordInstanceNodes from the ListLinks
-        const Handle& hWordInst1 = hListLink1->getOutgoingAtom(1);
-        const Handle& hWordInst2 = hListLink2->getOutgoingAtom(1);
+    ConnId id = m_lookups->conns.size();
+    m_lookups->conns.push_back(hConn);
+    m_lookups->sigs.push_back(lg_conn_signature(hConn));
+    m_lookups->conn_ids.insert({hConn, id});
 
-        // get the NumberNodes from the WordSequenceLinks
-        Handle hNumNode1 = get_target_neighbors(hWordInst1, WORD_SEQUENCE_LINK)[0];
-        Handle hNumNode2 = get_target_neighbors(hWordInst2, WORD_SEQUENCE_LINK)[0];
+    return id;
+}
 
-        // compare their word sequences
-        return hNumNode1->get_name() < hNumNode2->get_name();
-    };
+/**
+ * Same as lg_conn_linkable(), but on interned connectors, using their
+ * compiled signatures.
+ */
+bool SuRealPMCB::connector_linkable(ConnId c1, ConnId c2)
+{
+    return lg_conn_linkable(m_lookups->sigs[c1], m_lookups->sigs[c2]);
+}
 
-    // sort the qLGInstsLeft in reverse word sequence order
-    std::sort(qLGInstsLeft.begin(), qLGInstsLeft.end(), sortLeftInsts);
+/**
+ * Get the LG connectors used by a WordInstanceNode in its sentence,
+ * in the order a disjunct would have them: the connectors linking to
+ * the left, closest word first, followed by the connectors linking to
+ * the right, closest word first.
+ *
+ * The sequence is computed once for each WordInstanceNode and stored.
+ *
+ * @param hSolnWordInst  a WordInstanceNode from a potential solution
+ * @return               the ordered connectors
+ */
+const SuRealPMCB::ConnSeq& SuRealPMCB::get_target_connectors(const Handle& hSolnWordInst)
+{
+    auto iter = m_lookups->target_conns.find(hSolnWordInst);
+    if (iter != m_lookups->target_conns.end())
+        return iter->second;
 
-    // sort the qLGInstsRight in word sequence order
-    std::sort(qLGInstsRight.begin(), qLGInstsRight.end(), sortRightInsts);
+    HandleSeq qSolnEvalLinks = get_predicates(hSolnWordInst, LG_LINK_INSTANCE_NODE);
 
-    // get the LG connectors for those in the qLGInstsLeft
-    for (Handle& hEvalLink : qLGInstsLeft)
+    // the EvaluationLinks, with the word sequence number of the other word
+    typedef std::pair<double, Handle> SeqLink;
+    std::vector<SeqLink> qLGInstsLeft;
+    std::vector<SeqLink> qLGInstsRight;
+    for (Handle& hSolnEvalLink : qSolnEvalLinks)
     {
-        const Handle& hLinkInstNode = hEvalLink->getOutgoingAtom(0);
-
-        HandleSeq qLGConns = get_all_neighbors(hLinkInstNode, LG_LINK_INSTANCE_LINK);
+        const HandleSeq& qWordInsts = hSolnEvalLink->getOutgoingAtom(1)->getOutgoingSet();
 
-        // get the first LG connector
-        qTargetConns.push_back(qLGConns[0]);
+        // divide them into two groups, assuming there are only two WordInstanceNodes in the ListLink
+        if (qWordInsts[0] == hSolnWordInst)
+            qLGInstsRight.emplace_back(
+                word_sequence_number(qWordInsts[1]),
+                hSolnEvalLink);
+        if (qWordInsts[1] == hSolnWordInst)
+            qLGInstsLeft.emplace_back(
+                word_sequence_number(qWordInsts[0]),
+                hSolnEvalLink);
     }
 
-    // get the LG connectors for those in the qLGInstsRight
-    for (Handle& hEvalLink : qLGInstsRight)
-    {
-        const Handle& hLinkInstNode = hEvalLink->getOutgoingAtom(0);
+    // sort the qLGInstsLeft in reverse word sequence order
+    std::sort(qLGInstsLeft.begin(), qLGInstsLeft.end(),
+              [](const SeqLink& l1, const SeqLink& l2) { return l1.first > l2.first; });
 
-        HandleSeq qLGConns = get_all_neighbors(hLinkInstNode, LG_LINK_INSTANCE_LINK);
+    // sort the qLGInstsRight in word sequence order
+    std::sort(qLGInstsRight.begin(), qLGInstsRight.end(),
+              [](const SeqLink& l1, const SeqLink& l2) { return l1.first < l2.first; });
 
-        // get the second LG connector
-        qTargetConns.push_back(qLGConns[1]);
-    }
+    ConnSeq qTargetConns;
+    qTargetConns.reserve(qLGInstsLeft.size() + qLGInstsRight.size());
 
-    // disjuncts of the hPatWordNode
-    HandleSeq qDisjuncts;
+    // get the first LG connector for those in the qLGInstsLeft
+    for (const SeqLink& l : qLGInstsLeft)
+    {
+        const Handle& hLinkInstNode = l.second->getOutgoingAtom(0);
+        HandleSeq qLGConns = get_all_neighbors(hLinkInstNode, LG_LINK_INSTANCE_LINK);
+        qTargetConns.push_back(intern_connector(qLGConns[0]));
+    }
 
-    // check if we got the disjuncts of the hPatWordNode already,
-    // otherwise store them in a map so that we only need to do
-    // this disjuncts-getting procedure once
-    auto iter = m_disjuncts.find(hPatWordNode);
-    if (iter == m_disjuncts.end())
+    // get the second LG connector for those in the qLGInstsRight
+    for (const SeqLink& l : qLGInstsRight)
     {
-        qDisjuncts = get_target_neighbors(hPatWordNode, LG_DISJUNCT);
-        m_disjuncts.insert({hPatWordNode, qDisjuncts});
+        const Handle& hLinkInstNode = l.second->getOutgoingAtom(0);
+        HandleSeq qLGConns = get_all_neighbors(hLinkInstNode, LG_LINK_INSTANCE_LINK);
+        qTargetConns.push_back(intern_connector(qLGConns[1]));
     }
-    else qDisjuncts = iter->second;
 
-    logger().debug("[SuReal] Looking at %d disjuncts of %s", qDisjuncts.size(), hPatWordNode->to_short_string().c_str());
+    return m_lookups->target_conns.insert({hSolnWordInst, std::move(qTargetConns)}).first->second;
+}
 
-    // for each disjunct, get its outgoing set, and match 1-to-1 with qTargetConns
-    auto matchHelper = [&](const Handle& hDisjunct)
+/**
+ * Get the disjuncts of a WordNode, each as a sequence of connectors.
+ *
+ * The disjuncts are computed once for each WordNode and stored.
+ *
+ * @param hPatWordNode   a WordNode from the input pattern
+ * @return               the disjuncts of hPatWordNode
+ */
+const SuRealPMCB::DisjunctSeq& SuRealPMCB::get_disjuncts(const Handle& hPatWordNode)
+{
+    auto iter = m_lookups->disjuncts.find(hPatWordNode);
+    if (iter != m_lookups->disjuncts.end())
+        return iter->second;
+
+    DisjunctSeq qDisjuncts;
+    for (const Handle& hDisjunct : get_target_neighbors(hPatWordNode, LG_DISJUNCT))
     {
-        std::list<Handle> sourceConns;
-        std::list<Handle> targetConns(qTargetConns.begin(), qTargetConns.end());
+        Disjunct d;
+        d.handle = hDisjunct;
 
         // check if hDisjunct is LgAnd or just a lone connector
         if (hDisjunct->get_type() == LG_AND)
         {
-            const HandleSeq& q = hDisjunct->getOutgoingSet();
-            sourceConns = std::list<Handle>(q.begin(), q.end());
+            for (const Handle& hConn : hDisjunct->getOutgoingSet())
+                d.conns.push_back(intern_connector(hConn));
         }
         else
         {
-            sourceConns.push_back(hDisjunct);
+            d.conns.push_back(intern_connector(hDisjunct));
         }
 
-        Handle hMultiConn = Handle::UNDEFINED;
+        qDisjuncts.push_back(std::move(d));
+    }
+
+    return m_lookups->disjuncts.insert({hPatWordNode, std::move(qDisjuncts)}).first->second;
+}
+
+/**
+ * Check the disjuncts between two words and see if they match.
+ *
+ * @param hPatWordNode   a WordNode from the input pattern
+ * @param hSolnWordInst  a WordInstanceNode from a potential solution
+ * @return               true if matches, false otherwise
+ */
+bool SuRealPMCB::disjunct_match(const Handle& hPatWordNode, const Handle& hSolnWordInst)
+{
+    SuRealStats::count(SuRealStats::DISJUNCT_MATCHES);
+
+    LAZY_LOG_DEBUG << "[SuReal] In disjunct_match, checking disjuncts for:\n"
+                   << hPatWordNode->to_short_string()
+                   << hSolnWordInst->to_short_string();
+
+    // the source connectors for the solution
+    const ConnSeq& qTargetConns = get_target_connectors(hSolnWordInst);
+
+    // disjuncts of the hPatWordNode
+    const DisjunctSeq& qDisjuncts = get_disjuncts(hPatWordNode);
+
+    LAZY_LOG_DEBUG << "[SuReal] Looking at "
+                   << qDisjuncts.size()
+                   << " disjuncts of "
+                   << hPatWordNode->to_short_string();
+
+    // for each disjunct, match its connectors 1-to-1 with qTargetConns
+    auto matchHelper = [&](const Disjunct& d)
+    {
+        const ConnSeq& qSourceConns = d.conns;
+        size_t iSource = 0;
+        size_t iTarget = 0;
+
+        bool bMulti = false;
+        ConnId cMultiConn = 0;
 
         // loop thru all connectors on both list
-        while (not sourceConns.empty() && not targetConns.empty())
+        while (iSource < qSourceConns.size() and iTarget < qTargetConns.size())
         {
-            bool bResult;
-
-            if (hMultiConn != Handle::UNDEFINED)
-                bResult = lg_conn_linkable(hMultiConn, targetConns.front());
-            else
-                bResult = lg_conn_linkable(sourceConns.front(), targetConns.front());
+            ConnId cSource = bMulti ? cMultiConn : qSourceConns[iSource];
 
             // if the two connectors cannot be linked
-            if (not bResult)
+            if (not connector_linkable(cSource, qTargetConns[iTarget]))
             {
-                // don't pop anything if we were retrying a multi-connector
-                if (hMultiConn != Handle::UNDEFINED)
+                // don't move on if we were retrying a multi-connector
+                if (bMulti)
                 {
-                    hMultiConn = Handle::UNDEFINED;
+                    bMulti = false;
                     continue;
                 }
 
                 return false;
             }
 
-            // pop only the target connector if we were repeating
-            // a multi-conn.
-            if (hMultiConn != Handle::UNDEFINED)
+            // move on only on the target connectors if we were
+            // repeating a multi-conn.
+            if (bMulti)
             {
-                targetConns.pop_front();
+                iTarget++;
                 continue;
             }
 
-            // dumb hacky way of checking of the connector is
-            // a multi-connector
-            if (sourceConns.front()->get_arity() == 3)
-                hMultiConn = sourceConns.front();
+            // check if the connector is a multi-connector
+            if (m_lookups->sigs[cSource].multi)
+            {
+                bMulti = true;
+                cMultiConn = cSource;
+            }
 
-            sourceConns.pop_front();
-            targetConns.pop_front();
+            iSource++;
+            iTarget++;
         }
 
         // check if both source and target are used up
-        if (not sourceConns.empty() or not targetConns.empty())
+        if (iSource < qSourceConns.size() or iTarget < qTargetConns.size())
             return false;
 
-        logger().debug("[SuReal] " + hDisjunct->to_short_string() + " passed!");
+        LAZY_LOG_DEBUG << "[SuReal] " << d.handle->to_short_string() << " passed!";
 
         return true;
     };
@@ -907,7 +1067,8 @@ bool SuRealPMCB::disjunct_match(const Handle& hPatWordNode, const Handle& hSolnW
  * for SuReal will have 0 constants, most searches will require looking at all
  * the links.  This implementation improves that by looking at links within a
  * SetLink within a ReferenceLink with a InterpretationNode neightbor, thus
- * limiting the search space.
+ * limiting the search space.  Those links are kept in a SuRealIndex, so
+ * that they do not have to be looked for on every search.
  *
  * @param pPME       pointer to the PatternMatchEngine
  */
@@ -935,52 +1096,46 @@ bool SuRealPMCB::perform_search(PatternMatchCallback& pmc)
     PatternTermPtr root_clause = _pattern->pmandatory[0];
     PatternTermPtr bestClause = root_clause;
 
-    logger().debug("[SuReal] Start pred is: %s",
-                   bestClause->to_full_string().c_str());
+    LAZY_LOG_DEBUG << "[SuReal] Start pred is: "
+                   << bestClause->to_full_string();
 
     // keep only links of the same type as bestClause and
-    // have linkage to InterpretationNode
-    HandleSeq qCandidate;
-    m_as->get_handles_by_type(std::back_inserter(qCandidate), bestClause->getHandle()->get_type());
-
-    // selected candidates, a subset of qCandidate
-    std::vector<CandHandle> sCandidate;
-
-    for (auto& c : qCandidate)
+    // have linkage to a target InterpretationNode, keeping the size
+    // of the largest R2L SetLink they are in; those whose SetLink
+    // lacks what the pattern needs are dropped here, rather than in
+    // clause_match() after the search has started on them
+    std::unordered_map<Handle, size_t> qCandidate;
+    SuRealIndex::CandidateSeq qIndexed =
+        SuRealIndex::instance(m_as).get_candidates(bestClause->getHandle()->get_type());
+
+    Prefilter prefilter;
+    make_prefilter(prefilter);
+
+    for (const SuRealIndex::Candidate& c : qIndexed)
     {
-        auto rm = [&](Handle& h)
-        {
-            if (h->get_type() != SET_LINK) return true;
-
-            HandleSeq qN = get_source_neighbors(h, REFERENCE_LINK);
-            return not std::any_of(qN.begin(), qN.end(),
-                [&](Handle& hn) {
-                    bool isInterpNode = hn->get_type() == INTERPRETATION_NODE;
-                    bool isTarget = m_targets.size() > 0? (m_targets.find(hn) != m_targets.end()) : true;
-                    return isInterpNode and isTarget;
-                });
-        };
+        bool isTarget = m_targets.size() > 0? (m_targets.find(c.interp) != m_targets.end()) : true;
+        if (not isTarget) continue;
 
-        HandleSeq qISet;
-        c->getIncomingSet(back_inserter(qISet));
+        if (c.sig and not may_match(prefilter, *c.sig))
+        {
+            SuRealStats::count(SuRealStats::REJECT_PREFILTER);
+            continue;
+        }
 
-        // erase atoms that are neither a SetLink nor a target
-        qISet.erase(std::remove_if(qISet.begin(), qISet.end(), rm), qISet.end());
+        size_t& maxSize = qCandidate[c.link];
+        if (c.r2lSetLinkSize > maxSize) maxSize = c.r2lSetLinkSize;
+    }
 
-        if (qISet.size() >= 1)
-        {
-            size_t maxSize = 0;
-            for (Handle& q : qISet)
-            {
-                size_t s = q->get_arity();
-                if (s > maxSize) maxSize = s;
-            }
+    // selected candidates
+    std::vector<CandHandle> sCandidate;
+    sCandidate.reserve(qCandidate.size());
 
-            CandHandle ch;
-            ch.handle = c;
-            ch.r2lSetLinkSize = maxSize;
-            sCandidate.push_back(ch);
-        }
+    for (const auto& kv : qCandidate)
+    {
+        CandHandle ch;
+        ch.handle = kv.first;
+        ch.r2lSetLinkSize = kv.second;
+        sCandidate.push_back(ch);
     }
 
     auto sortBySize = [](const CandHandle& h1, const CandHandle& h2)
@@ -988,11 +1143,16 @@ bool SuRealPMCB::perform_search(PatternMatchCallback& pmc)
 
     std::sort(sCandidate.begin(), sCandidate.end(), sortBySize);
 
+    if (m_num_threads > 1 and sCandidate.size() > 1)
+        return parallel_search(bestClause, sCandidate);
+
     PatternMatchEngine pme(pmc);
     pme.set_pattern(*_variables, *_pattern);
     for (auto& c : sCandidate)
     {
-        logger().debug("[SuReal] Loop candidate: %s", c.handle->to_short_string().c_str());
+        LAZY_LOG_DEBUG << "[SuReal] Loop candidate: "
+                       << c.handle->to_short_string();
+        SuRealStats::count(SuRealStats::CANDIDATES);
 
         if (pme.explore_neighborhood(bestClause, c.handle, root_clause))
             return true;
@@ -1000,6 +1160,182 @@ bool SuRealPMCB::perform_search(PatternMatchCallback& pmc)
     return false;
 }
 
+/**
+ * Work out what a R2L SetLink must have for the pattern to be grounded
+ * in it.  The constant nodes are matched as they are, so they must be
+ * in it.  Each word that is a variable, other than a predicate, whose
+ * other forms are only looked at in grounding(), must be grounded to a
+ * word instance whose LG connectors pair up one to one with those of
+ * one of its disjuncts (see disjunct_match()), and linkable connectors
+ * have the same type.  All of the clauses are grounded in the SetLink of
+ * one InterpretationNode, and R2L gives each of them only one.
+ *
+ * @param pf   set to what is needed
+ */
+void SuRealPMCB::make_prefilter(Prefilter& pf)
+{
+    HandleSet qConstants;
+    HandleSet qWords;
+
+    std::function<void(const Handle&)> collect = [&](const Handle& h)
+    {
+        if (h->is_link())
+        {
+            for (const Handle& o : h->getOutgoingSet())
+                collect(o);
+            return;
+        }
+
+        Type t = h->get_type();
+        if (m_vars.count(h) == 0)
+            qConstants.insert(h);
+        else if (t != VARIABLE_NODE and t != INTERPRETATION_NODE and
+                 t != PREDICATE_NODE)
+            qWords.insert(h);
+    };
+
+    for (const PatternTermPtr& ptm : _pattern->pmandatory)
+        collect(ptm->getHandle());
+
+    pf.constants.assign(qConstants.begin(), qConstants.end());
+
+    for (const Handle& hPatNode : qWords)
+    {
+        Handle hPatWordNode = get_pattern_word(hPatNode);
+        if (hPatWordNode == Handle::UNDEFINED) continue;
+
+        std::vector<uint64_t> qTypes;
+        for (const Disjunct& d : get_disjuncts(hPatWordNode))
+        {
+            uint64_t types = 0;
+            for (ConnId c : d.conns)
+                types |= SuRealIndex::Signature::conn_type_bit(m_lookups->sigs[c].type);
+            qTypes.push_back(types);
+        }
+
+        std::sort(qTypes.begin(), qTypes.end());
+        qTypes.erase(std::unique(qTypes.begin(), qTypes.end()), qTypes.end());
+        pf.word_conn_types.push_back(std::move(qTypes));
+    }
+}
+
+/**
+ * Check a SetLink against what the pattern needs.  False means that the
+ * pattern cannot match in it; true only means that it might.
+ */
+bool SuRealPMCB::may_match(const Prefilter& pf, const SuRealIndex::Signature& sig)
+{
+    for (const Handle& h : pf.constants)
+        if (not sig.may_have_node(h))
+            return false;
+
+    for (const std::vector<uint64_t>& qTypes : pf.word_conn_types)
+    {
+        if (not std::any_of(qTypes.begin(), qTypes.end(),
+                            [&](uint64_t types) { return 0 == (types & ~sig.conn_types); }))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Explore the search candidates from several threads.
+ *
+ * The threads pull the candidates, in order, from a shared counter, so
+ * that a thread that is done with a cheap candidate simply takes the next
+ * one.  Each thread has its own PatternMatchEngine and callback, hence its
+ * own disjunct and word caches, and keeps the results of each candidate
+ * apart.  These are merged afterwards, in candidate order, exactly as if
+ * the candidates were explored one after another: the search stops at the
+ * first candidate that got a good enough solution, and the candidates
+ * after it are skipped (or ignored, if they were already explored).
+ *
+ * @param clause   the clause to start the search from
+ * @param cands    the candidates, sorted in the order they should be seen
+ * @return         true if the search should stop, like perform_search
+ */
+bool SuRealPMCB::parallel_search(const PatternTermPtr& clause,
+                                 const std::vector<CandHandle>& cands)
+{
+    struct Outcome
+    {
+        std::map<Handle, HandleMapSeq> results;
+        HandleSet interp;
+        bool cleared = false;
+        bool found = false;
+    };
+
+    std::vector<Outcome> outcomes(cands.size());
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> stop(cands.size());
+
+    auto worker = [&]()
+    {
+        SuRealPMCB pmcb(m_as, m_vars, m_use_cache);
+        pmcb.m_targets = m_targets;
+        pmcb.m_max_results = m_max_results;
+        pmcb.m_pat_words = m_pat_words;
+        pmcb.set_pattern(*_variables, *_pattern);
+
+        PatternMatchEngine pme(pmcb);
+        pme.set_pattern(*_variables, *_pattern);
+
+        for (size_t i = next++; i < cands.size() and i < stop; i = next++)
+        {
+            LAZY_LOG_DEBUG << "[SuReal] Loop candidate: "
+                           << cands[i].handle->to_short_string();
+            SuRealStats::count(SuRealStats::CANDIDATES);
+
+            Outcome& o = outcomes[i];
+            o.found = pme.explore_neighborhood(clause, cands[i].handle, clause);
+
+            o.results.swap(pmcb.m_results);
+            o.interp.swap(pmcb.m_interp);
+            o.cleared = pmcb.m_results_cleared;
+            pmcb.m_results.clear();
+            pmcb.m_interp.clear();
+            pmcb.m_results_cleared = false;
+
+            // no need to look at the candidates after this one
+            if (o.found)
+            {
+                size_t s = stop;
+                while (i < s and not stop.compare_exchange_weak(s, i));
+            }
+        }
+    };
+
+    size_t n = std::min<size_t>(m_num_threads, cands.size());
+    Executor::instance().parallel_for(n, [&](size_t) { worker(); }, n);
+
+    for (Outcome& o : outcomes)
+    {
+        if (o.cleared)
+        {
+            m_results.clear();
+            m_results_cleared = true;
+        }
+
+        for (auto& r : o.results)
+        {
+            HandleMapSeq& seq = m_results[r.first];
+            seq.insert(seq.end(), r.second.begin(), r.second.end());
+        }
+
+        m_interp.insert(o.interp.begin(), o.interp.end());
+
+        if (o.found)
+            return true;
+
+        // each worker only counts the results of its own candidate
+        if (m_max_results > 0 and m_results.size() >= m_max_results)
+            return true;
+    }
+
+    return false;
+}
+
 /**
  * Override the find_starter_recursive method in InitiateSearchCB.
  *
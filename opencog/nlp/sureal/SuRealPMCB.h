@@ -24,18 +24,62 @@
 #ifndef _OPENCOG_SUREAL_PMCB_H
 #define _OPENCOG_SUREAL_PMCB_H
 
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include <opencog/atoms/base/Handle.h>
+#include <opencog/neighbors/QueryArena.h>
+#include <opencog/nlp/lg-dict/LGDictUtils.h>
 #include <opencog/query/InitiateSearchMixin.h>
 #include <opencog/query/TermMatchMixin.h>
 #include <opencog/query/SatisfyMixin.h>
 
+#include "SuRealIndex.h"
+
+class SuRealPMCBUTest;
+
 namespace opencog
 {
 namespace nlp
 {
 
+class SuRealCache;
+
+/**
+ * What SuRealPMCB looks up about the words, their LG dictionary entries
+ * and the parses in the AtomSpace.  None of it depends on the pattern, so
+ * several queries on the same AtomSpace can share it, e.g. a batch of
+ * sureal-match; it is not meant to be shared between threads.
+ */
+struct SuRealLookups
+{
+    // LG connectors are interned into small integer IDs, so that the
+    // disjunct matching only has to scan flat arrays of them
+    typedef uint32_t ConnId;
+    typedef std::vector<ConnId> ConnSeq;
+
+    struct Disjunct
+    {
+        Handle handle;
+        ConnSeq conns;
+    };
+    typedef std::vector<Disjunct> DisjunctSeq;
+
+    std::unordered_map<Handle, DisjunctSeq> disjuncts;   // store the disjuncts of WordNodes
+    std::unordered_map<Handle, ConnSeq> target_conns;   // store the ordered LG connectors used by WordInstanceNodes
+
+    HandleSeq conns;   // the interned LG connectors, indexed by ConnId
+    std::vector<nlp::LGConnSignature> sigs;   // their compiled forms, indexed by ConnId
+    std::unordered_map<Handle, ConnId> conn_ids;
+
+    std::unordered_map<Handle, Handle> word_insts;   // store the corresponding WordInstanceNodes of the solution nodes
+};
+
+// The corresponding WordNodes of the nodes in a pattern; built once before
+// the search and only read during it.
+typedef std::unordered_map<Handle, Handle> PatternWordMap;
+
 /**
  * A PatternMatchCallback for Surface Realization.
  *
@@ -47,8 +91,12 @@ class SuRealPMCB :
     public TermMatchMixin,
     public SatisfyMixin
 {
+    // For checking the lookups without running a search
+    friend class ::SuRealPMCBUTest;
+
 public:
-    SuRealPMCB(AtomSpace* as, const HandleSet& vars, bool use_cache);
+    SuRealPMCB(AtomSpace* as, const HandleSet& vars, bool use_cache,
+               std::shared_ptr<SuRealLookups> lookups = nullptr);
     ~SuRealPMCB();
 
     virtual bool variable_match(const Handle& hPat, const Handle& hSoln);
@@ -63,28 +111,82 @@ public:
         TermMatchMixin::set_pattern(vars, pat);
     }
 
+    // Explore the search candidates with this many threads; 1 (the
+    // default) explores them one after another in the calling thread.
+    void set_num_threads(unsigned n) { m_num_threads = n; }
+
+    // Use this table to find the WordNodes of the pattern nodes; nodes
+    // not in it are resolved through the AtomSpace.
+    void set_pattern_words(std::shared_ptr<const PatternWordMap> words)
+    {
+        m_pat_words = words;
+    }
+
+    static Handle find_word_node(AtomSpace*, const Handle&);
+
+    // Stop the search once solutions for this many InterpretationNodes
+    // are found; 0 (the default) looks for all of them.
+    void set_max_results(size_t n) { m_max_results = n; }
+
+    // The InterpretationNodes of m_results, those of the smallest SetLinks
+    // first; at most max_results of them, unless it is 0
+    HandleSeq ranked_interpretations(size_t max_results = 0) const;
+
     std::map<Handle, HandleMapSeq> m_results;   // store the PM results
 
 private:
+    struct CandHandle
+    {
+        Handle handle;
+        size_t r2lSetLinkSize;
+    };
+
+    // What a R2L SetLink must have for the pattern to match in it: the
+    // constant nodes of the pattern, and, for each word in it, the LG
+    // connector types of one of its disjuncts
+    struct Prefilter
+    {
+        HandleSeq constants;
+        std::vector<std::vector<uint64_t>> word_conn_types;
+    };
+
     virtual Handle find_starter_recursive(const PatternTermPtr&, size_t&, PatternTermPtr&, size_t&);
+    void make_prefilter(Prefilter&);
+    static bool may_match(const Prefilter&, const SuRealIndex::Signature&);
+    bool parallel_search(const PatternTermPtr&, const std::vector<CandHandle>&);
     bool disjunct_match(const Handle&, const Handle&);
 
+    typedef SuRealLookups::ConnId ConnId;
+    typedef SuRealLookups::ConnSeq ConnSeq;
+    typedef SuRealLookups::Disjunct Disjunct;
+    typedef SuRealLookups::DisjunctSeq DisjunctSeq;
+
+    Handle get_pattern_word(const Handle&);
+    Handle get_word_instance(const Handle&);
+
+    ConnId intern_connector(const Handle&);
+    bool connector_linkable(ConnId, ConnId);
+    const ConnSeq& get_target_connectors(const Handle&);
+    const DisjunctSeq& get_disjuncts(const Handle&);
+
     AtomSpace* m_as;
     bool m_use_cache;
+    SuRealCache* m_cache;
     HandleSet m_vars;   // store nodes that are variables
 
-    std::unordered_map<Handle, HandleSeq> m_disjuncts;   // store the disjuncts of nodes in the pattern
-
-    std::unordered_map<Handle, Handle> m_words;   // store the corresponding WordNodes of the nodes in the pattern
+    std::shared_ptr<SuRealLookups> m_lookups;
+    std::shared_ptr<const PatternWordMap> m_pat_words;
 
     HandleSet m_interp;   // store a set of InterpretationNodes correspond to some clauses accepted in clause_match()
     HandleSet m_targets;   // store a set of target InterpretationNodes
 
-    struct CandHandle
-    {
-        Handle handle;
-        size_t r2lSetLinkSize;
-    };
+    // the containers the callbacks build while checking a grounding take
+    // their memory from here; it is given back when the query is done
+    QueryArena m_arena;
+
+    bool m_results_cleared;   // whether grounding() has dropped the not good enough results
+    unsigned m_num_threads;
+    size_t m_max_results;
 };
 
 }
@@ -22,16 +22,25 @@
  */
 
 #include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/core/FindUtils.h>
+#include <opencog/atoms/value/LinkValue.h>
 #include <opencog/atoms/pattern/PatternUtils.h>
 #include <opencog/atoms/pattern/PatternLink.h>
+#include <opencog/executor/Executor.h>
 #include <opencog/guile/SchemePrimitive.h>
 #include <opencog/neighbors/Neighbors.h>
+#include <opencog/nlp/index/ScratchPool.h>
 #include <opencog/nlp/types/atom_types.h>
+#include <opencog/nlp/types/InstanceName.h>
+#include <opencog/tracing/Tracer.h>
 
 #include "SuRealSCM.h"
 #include "SuRealPMCB.h"
 #include "SuRealCache.h"
+#include "SuRealIndex.h"
+#include "SuRealStats.h"
 
 
 using namespace opencog::nlp;
@@ -43,7 +52,8 @@ using namespace std;
 /**
  * The constructor for SuRealSCM.
  */
-SuRealSCM::SuRealSCM()
+SuRealSCM::SuRealSCM() :
+    m_num_threads(1)
 {
     static bool is_init = false;
     if (is_init) return;
@@ -85,11 +95,29 @@ void SuRealSCM::init()
 #ifdef HAVE_GUILE
     define_scheme_primitive("sureal-match", &SuRealSCM::do_non_cached_sureal_match, this, "nlp sureal");
     define_scheme_primitive("cached-sureal-match", &SuRealSCM::do_cached_sureal_match, this, "nlp sureal");
+    define_scheme_primitive("sureal-match-top-k", &SuRealSCM::do_sureal_match_top_k, this, "nlp sureal");
+    define_scheme_primitive("sureal-match-batch-value", &SuRealSCM::do_sureal_match_batch, this, "nlp sureal");
+    define_scheme_primitive("sureal-first-sayable", &SuRealSCM::do_first_sayable, this, "nlp sureal");
     define_scheme_primitive("reset-cache", &SuRealSCM::reset_cache, this, "nlp sureal");
+    define_scheme_primitive("set-sureal-cache-budget", &SuRealSCM::set_cache_budget, this, "nlp sureal");
+    define_scheme_primitive("sureal-release", &SuRealSCM::release, this, "nlp sureal");
+    define_scheme_primitive("set-sureal-threads", &SuRealSCM::set_num_threads, this, "nlp sureal");
+    define_scheme_primitive("sureal-stats-enable", &SuRealSCM::enable_stats, this, "nlp sureal");
+    define_scheme_primitive("sureal-stats-string", &SuRealSCM::get_stats, this, "nlp sureal");
+    define_scheme_primitive("sureal-stats-reset", &SuRealSCM::reset_stats, this, "nlp sureal");
 #endif
 }
 
 
+/**
+ * What is looked up while matching, and can be shared between queries.
+ */
+struct SuRealSCM::MatchState
+{
+    std::shared_ptr<SuRealLookups> lookups;
+    std::unordered_map<Handle, bool> is_variable;   // see is_variable()
+};
+
 /**
  * Get all the nodes within a link and its sublinks.
  *
@@ -112,10 +140,91 @@ static void get_all_unique_nodes(const Handle& h,
 /**
  * Implement the "reset-sureal-cache" scheme primitive.
  *
+ * Only the cache of the current AtomSpace is reset.
  */
 void SuRealSCM::reset_cache(void)
 {
-    SuRealCache::instance().reset();
+#ifdef HAVE_GUILE
+    AtomSpace* pAS = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("reset-cache"));
+    SuRealCache::instance(pAS).reset();
+#endif
+}
+
+/**
+ * Implement the "set-sureal-cache-budget" scheme primitive.
+ *
+ * Sets the memory budget, in megabytes, of the cache of the current
+ * AtomSpace, as well as the budget of caches created from now on.
+ * Zero means unbounded.
+ */
+void SuRealSCM::set_cache_budget(int megabytes)
+{
+#ifdef HAVE_GUILE
+    size_t bytes = (megabytes > 0) ? size_t(megabytes) * 1024 * 1024 : 0;
+
+    AtomSpace* pAS = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("set-sureal-cache-budget"));
+    SuRealCache::set_default_budget(bytes);
+    SuRealCache::instance(pAS).set_memory_budget(bytes);
+#endif
+}
+
+/**
+ * Implement the "sureal-release" scheme primitive.
+ *
+ * Drops the cache and the candidate index of the current AtomSpace.  It
+ * has to be called before the AtomSpace is deleted, while no sureal
+ * query is running on it; a later query makes them again.
+ */
+void SuRealSCM::release(void)
+{
+#ifdef HAVE_GUILE
+    AtomSpace* pAS = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("sureal-release"));
+    SuRealCache::release(pAS);
+    SuRealIndex::release(pAS);
+#endif
+}
+
+/**
+ * Implement the "set-sureal-threads" scheme primitive.
+ *
+ * Sets the number of threads each sureal query explores its search
+ * candidates with; 1 (the default) does not start any thread.
+ */
+void SuRealSCM::set_num_threads(int n)
+{
+    m_num_threads = (n > 1) ? n : 1;
+}
+
+/**
+ * Implement the "sureal-stats-enable" scheme primitive.
+ *
+ * Turns the collection of the SuReal statistics on or off; it is off by
+ * default.
+ */
+void SuRealSCM::enable_stats(bool on)
+{
+    SuRealStats::set_enabled(on);
+}
+
+/**
+ * Implement the "sureal-stats-string" scheme primitive.
+ *
+ * @return   the SuReal statistics as a string of a scheme association list
+ */
+std::string SuRealSCM::get_stats(void)
+{
+    return SuRealStats::report();
+}
+
+/**
+ * Implement the "sureal-stats-reset" scheme primitive.
+ */
+void SuRealSCM::reset_stats(void)
+{
+    SuRealStats::reset();
 }
 
 /**
@@ -136,6 +245,59 @@ HandleSeqSeq SuRealSCM::do_non_cached_sureal_match(Handle h)
     return do_sureal_match(h, false);
 }
 
+/**
+ * Check whether a node of the input SetLink is a word, in which case it
+ * needs to become a variable for the Pattern Matcher.
+ *
+ * @param pAS   the AtomSpace the query is done on
+ * @param n     a node of the input SetLink
+ * @return      true if n should be a variable
+ */
+bool SuRealSCM::is_variable(AtomSpace* pAS, const Handle& n)
+{
+    // special treatment for InterpretationNode and VariableNode, treating
+    // them as variables;  this is because we have
+    //    (InterpreationNode "MicroplanningNewSentence")
+    // from the microplanner that should be matched to any InterpretationNode
+    if (n->get_type() == INTERPRETATION_NODE || n->get_type() == VARIABLE_NODE)
+        return true;
+
+    // special treatment for DefinedLinguisticConceptNode and
+    // DefinedLinguisticPredicateNode, do not treat them as variables
+    // because they are not actual words of a sentence.
+    if (n->get_type() == DEFINED_LINGUISTIC_CONCEPT_NODE or
+        n->get_type() == DEFINED_LINGUISTIC_PREDICATE_NODE)
+       return false;
+
+    const std::string& sName = n->get_name();
+
+    // if it is an instance, check if it has the LG relationships
+    if (is_instance_name(sName))
+    {
+        Handle hWordInstNode = pAS->get_handle(WORD_INSTANCE_NODE, sName);
+
+        // no corresponding WordInstanceNode found
+        if (hWordInstNode == nullptr)
+            return false;
+
+        // if no LG link generated for the instance
+        if (not has_target_neighbor(hWordInstNode, LG_WORD_CSET))
+            return false;
+    } 
+    // n is a concept or predicate node
+    Handle hWordNode = get_instance_word(n);
+    if (not hWordNode)
+    {
+        std::string sWord(sName, 0, instance_word_length(sName));
+        hWordNode = pAS->get_handle(WORD_NODE, sWord);
+    }
+    // no WordNode found
+    if (hWordNode == nullptr)
+        return false;
+
+    return true;
+}
+
 /**
  * Uses the pattern matcher to find all InterpretationNodes whoses
  * corresponding SetLink contains a structure similar to the input,
@@ -150,11 +312,158 @@ HandleSeqSeq SuRealSCM::do_non_cached_sureal_match(Handle h)
 HandleSeqSeq SuRealSCM::do_sureal_match(Handle h, bool use_cache)
 {
 #ifdef HAVE_GUILE
+    AtomSpace* pAS = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("sureal-match"));
+
+    MatchState state;
+    return sureal_match(pAS, h, use_cache, state);
+#else
+    return HandleSeqSeq();
+#endif
+}
+
+/**
+ * Implement the "sureal-match-top-k" scheme primitive.
+ *
+ * Same as "sureal-match", but the search stops once k InterpretationNodes
+ * are found, looking at the smallest R2L SetLinks first, and only the
+ * best k of them are returned.
+ */
+HandleSeqSeq SuRealSCM::do_sureal_match_top_k(Handle h, int k)
+{
+#ifdef HAVE_GUILE
+    AtomSpace* pAS = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("sureal-match-top-k"));
+
+    MatchState state;
+    return sureal_match(pAS, h, false, state, (k > 0) ? k : 1);
+#else
+    return HandleSeqSeq();
+#endif
+}
+
+/**
+ * Implement the "sureal-match-batch-value" scheme primitive.
+ *
+ * Do a sureal-match on each of the given SetLinks, sharing the word and
+ * LG dictionary lookups between them, and, if asked, the SuRealCache of
+ * the AtomSpace as cached-sureal-match does.  As a scheme primitive can
+ * only return a list of lists of atoms, the results are returned as a
+ * LinkValue, which the "sureal-match-batch" scheme function turns into
+ * a list.
+ *
+ * @param qSetLinks   the SetLinks to match
+ * @param use_cache   whether to use the SuRealCache of the AtomSpace
+ * @return            a LinkValue of the result of each match, in the
+ *                    same order as the SetLinks; each is a LinkValue of
+ *                    the lists of atoms returned by sureal-match
+ */
+ValuePtr SuRealSCM::do_sureal_match_batch(const HandleSeq& qSetLinks,
+                                          bool use_cache)
+{
+#ifdef HAVE_GUILE
+    AtomSpace* pAS = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("sureal-match-batch-value"));
+
+    MatchState state;
+
+    std::vector<ValuePtr> results;
+    for (const Handle& h : qSetLinks)
+    {
+        std::vector<ValuePtr> rows;
+        for (const HandleSeq& row : sureal_match(pAS, h, use_cache, state))
+            rows.push_back(createLinkValue(row));
+        results.push_back(createLinkValue(rows));
+    }
+
+    return createLinkValue(results);
+#else
+    return createLinkValue(std::vector<ValuePtr>());
+#endif
+}
+
+/**
+ * Implement the "sureal-first-sayable" scheme primitive.
+ *
+ * Find the first of several variants of a chunk that SuReal can say,
+ * e.g. a chunk with each of the atoms that could be added to it next.
+ * Each variant is a LinkValue of the atoms of a SetLink; the SetLinks
+ * are made in a scratch AtomSpace from the ScratchPool of the current
+ * one, which is left as it was, and matched the way cached-sureal does.
+ *
+ * The variants are checked as one batch on the Executor, up to
+ * set-sureal-threads of them at once, in order; once one is found
+ * sayable, the variants after it are no longer checked.
+ *
+ * @param variants   a LinkValue of the variants
+ * @return           the index of the first sayable variant, or -1
+ */
+int SuRealSCM::do_first_sayable(const ValuePtr& variants)
+{
+#ifdef HAVE_GUILE
+    AtomSpace* pAS = nlp::ScratchPool::base_of(
+        SchemeSmob::ss_get_env_as("sureal-first-sayable"));
+
+    if (not nameserver().isA(variants->get_type(), LINK_VALUE))
+        throw InvalidParamException(TRACE_INFO,
+            "sureal-first-sayable: Expecting a LinkValue of the variants");
+
+    nlp::ScratchPool::Lease scratch(nlp::ScratchPool::instance(pAS).acquire());
+    HandleSeq qSetLinks;
+    for (const ValuePtr& v : LinkValueCast(variants)->value())
+    {
+        HandleSeq atoms;
+        if (nameserver().isA(v->get_type(), LINK_VALUE))
+        {
+            for (const ValuePtr& a : LinkValueCast(v)->value())
+                if (a->is_atom()) atoms.push_back(HandleCast(a));
+        }
+        qSetLinks.push_back(scratch->add_link(SET_LINK, std::move(atoms)));
+    }
+
+    std::atomic<size_t> first(qSetLinks.size());
+    Executor::instance().parallel_for(qSetLinks.size(),
+        [&](size_t i)
+        {
+            if (first < i) return;
+
+            MatchState state;
+            if (sureal_match(pAS, qSetLinks[i], true, state).empty())
+                return;
+
+            size_t prev = first;
+            while (i < prev and not first.compare_exchange_weak(prev, i));
+        },
+        m_num_threads);
+
+    return (first < qSetLinks.size()) ? (int) first : -1;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * The actual work behind "sureal-match" and its variants.
+ *
+ * @param pAS        the AtomSpace to search
+ * @param h          a SetLink contains the atoms which will become the clauses
+ * @param use_cache  whether to use the SuRealCache of the AtomSpace
+ * @param state      the lookups that can be shared with other queries
+ * @param max_results  stop after this many InterpretationNodes are found,
+ *                   and only return the best of them; 0 for all of them
+ * @return           same as do_sureal_match
+ */
+HandleSeqSeq SuRealSCM::sureal_match(AtomSpace* pAS, const Handle& h,
+                                     bool use_cache, MatchState& state,
+                                     size_t max_results)
+{
     // only accept SetLink
     if (h->get_type() != SET_LINK)
         return HandleSeqSeq();
 
-    AtomSpace* pAS = SchemeSmob::ss_get_env_as("sureal-match");
+    SuRealStats::ScopedTimer timer(SuRealStats::MATCH_TIME);
+    TraceSpan span("sureal-match", "nlp");
+    span.arg("clauses", h->get_arity()).arg("cached", use_cache);
 
     HandleSet sVars;
 
@@ -172,62 +481,31 @@ HandleSeqSeq SuRealSCM::do_sureal_match(Handle h, bool use_cache)
     get_all_unique_nodes(h, allNodes);
 
     // isolate which nodes are actually words, and which are not; all words
-    // need to become variable for the Pattern Matcher
+    // need to become variable for the Pattern Matcher; also find their
+    // WordNodes now, so that the callback does not have to during the search
+    auto words = std::make_shared<PatternWordMap>();
     for (auto& n : allNodes)
     {
-        // special treatment for InterpretationNode and VariableNode, treating
-        // them as variables;  this is because we have
-        //    (InterpreationNode "MicroplanningNewSentence")
-        // from the microplanner that should be matched to any InterpretationNode
-        if (n->get_type() == INTERPRETATION_NODE || n->get_type() == VARIABLE_NODE)
-        {
-            sVars.insert(n);
-            continue;
-        }
-
-        // special treatment for DefinedLinguisticConceptNode and
-        // DefinedLinguisticPredicateNode, do not treat them as variables
-        // because they are not actual words of a sentence.
-        if (n->get_type() == DEFINED_LINGUISTIC_CONCEPT_NODE or
-            n->get_type() == DEFINED_LINGUISTIC_PREDICATE_NODE)
-           continue;
+        auto it = state.is_variable.find(n);
+        if (it == state.is_variable.end())
+            it = state.is_variable.insert({n, is_variable(pAS, n)}).first;
 
-        std::string sName = n->get_name();
+        if (it->second)
+            sVars.insert(n);
 
-        // if it is an instance, check if it has the LG relationships
-        if (sName.find("@") != std::string::npos)
-        {
-            Handle hWordInstNode = pAS->get_handle(WORD_INSTANCE_NODE, sName);
-
-            // no corresponding WordInstanceNode found
-            if (hWordInstNode == nullptr)
-                continue;
-
-            // if no LG link generated for the instance
-            if (get_target_neighbors(hWordInstNode, LG_WORD_CSET).empty())
-                continue;
-        } 
-        // n is a concept or predicate node
-        Handle hWordNode;
-        HandleSeq neighbor_win = get_target_neighbors(n, REFERENCE_LINK);
-        if (neighbor_win.size() != 0)
-        {
-            HandleSeq neighbor_wn = get_target_neighbors(neighbor_win[0], REFERENCE_LINK);
-            hWordNode = neighbor_wn[0];
-        }
-        else
-        {
-            std::string sWord = sName.substr(0, sName.find_first_of('@'));
-            hWordNode = pAS->get_handle(WORD_NODE, sWord);
-        }
-        // no WordNode found
-        if (hWordNode == nullptr)
+        if (n->get_type() == VARIABLE_NODE or n->get_type() == INTERPRETATION_NODE)
             continue;
 
-        sVars.insert(n);
+        (*words)[n] = SuRealPMCB::find_word_node(pAS, n);
     }
 
-    SuRealPMCB pmcb(pAS, sVars, use_cache);
+    if (state.lookups == nullptr)
+        state.lookups = std::make_shared<SuRealLookups>();
+
+    SuRealPMCB pmcb(pAS, sVars, use_cache, state.lookups);
+    pmcb.set_num_threads(m_num_threads);
+    pmcb.set_max_results(max_results);
+    pmcb.set_pattern_words(words);
     PatternLinkPtr slp(createPatternLink(sVars, qClauses));
     pmcb.satisfy(slp);
 
@@ -252,29 +530,7 @@ HandleSeqSeq SuRealSCM::do_sureal_match(Handle h, bool use_cache)
         }
     }
 
-    HandleSeq keys;
-
-    // construct the list of InterpretationNode to be returned
-    for (auto& r : pmcb.m_results)
-        keys.push_back(r.first);
-
-    // sort the InterpretationNode bases on the size of the corresponding
-    // SetLink; the idea is that the larger the size, the more stuff in
-    // the SetLink that are not part of the query's clauses
-    auto itprComp = [&pAS](const Handle& hi, const Handle& hj)
-    {
-        // get the corresponding SetLink
-        HandleSeq qi = get_target_neighbors(hi, REFERENCE_LINK);
-        HandleSeq qj = get_target_neighbors(hj, REFERENCE_LINK);
-        qi.erase(std::remove_if(qi.begin(), qi.end(), [](Handle& h) { return h->get_type() != SET_LINK; }), qi.end());
-        qj.erase(std::remove_if(qj.begin(), qj.end(), [](Handle& h) { return h->get_type() != SET_LINK; }), qj.end());
-
-        // assuming each InterpretationNode is only linked to one SetLink
-        // and compare using arity
-        return qi[0]->get_arity() < qj[0]->get_arity();
-    };
-
-    std::sort(keys.begin(), keys.end(), itprComp);
+    HandleSeq keys = pmcb.ranked_interpretations(max_results);
 
     HandleSeqSeq results;
 
@@ -285,10 +541,6 @@ HandleSeqSeq SuRealSCM::do_sureal_match(Handle h, bool use_cache)
     }
 
     return results;
-
-#else
-    return HandleSeqSeq();
-#endif
 }
 
 /**
@@ -318,7 +570,10 @@ HandleSeqSeq SuRealSCM::do_sureal_match(Handle h, bool use_cache)
  */
 HandleSeqSeq SuRealSCM::sureal_get_mapping(Handle& h, std::vector<HandleMap >& mappings)
 {
-    logger().debug("[SuReal] %d mapping(s) for %s", mappings.size(), h->to_short_string().c_str());
+    LAZY_LOG_DEBUG << "[SuReal] "
+                   << mappings.size()
+                   << " mapping(s) for "
+                   << h->to_short_string();
 
     HandleSeq qKeys, qVars;
 
@@ -25,8 +25,11 @@
 #define _OPENCOG_SUREAL_SCM_H
 
 
+#include <atomic>
 #include <map>
+#include <string>
 #include <opencog/atoms/base/Handle.h>
+#include <opencog/atomspace/AtomSpace.h>
 
 
 namespace opencog
@@ -47,13 +50,29 @@ private:
     static void init_in_module(void*);
     void init(void);
 
+    struct MatchState;
+
     HandleSeqSeq do_sureal_match(Handle, bool);
+    ValuePtr do_sureal_match_batch(const HandleSeq&, bool);
+    int do_first_sayable(const ValuePtr&);
+    HandleSeqSeq do_sureal_match_top_k(Handle, int);
+    HandleSeqSeq sureal_match(AtomSpace*, const Handle&, bool, MatchState&,
+                              size_t max_results = 0);
+    bool is_variable(AtomSpace*, const Handle&);
     HandleSeqSeq do_non_cached_sureal_match(Handle);
     HandleSeqSeq do_cached_sureal_match(Handle);
     void reset_cache(void);
+    void set_cache_budget(int);
+    void release(void);
+    void set_num_threads(int);
+    void enable_stats(bool);
+    std::string get_stats(void);
+    void reset_stats(void);
 
     HandleSeqSeq sureal_get_mapping(Handle&, std::vector<HandleMap >&);
 
+    std::atomic<unsigned> m_num_threads;
+
 public:
     SuRealSCM();
 };
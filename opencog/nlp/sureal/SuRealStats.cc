@@ -0,0 +1,163 @@
+/*
+ * SuRealStats.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <sstream>
+
+#include "SuRealStats.h"
+
+using namespace opencog::nlp;
+using namespace opencog;
+
+std::atomic<bool> SuRealStats::s_enabled(false);
+std::atomic<uint64_t> SuRealStats::s_counters[NUM_COUNTERS];
+SuRealStats::Histogram SuRealStats::s_timers[NUM_TIMERS];
+
+static const char* counter_names[] =
+{
+    "candidates",
+    "variable-matches",
+    "clause-matches",
+    "disjunct-matches",
+    "groundings",
+    "reject-type",
+    "reject-no-word-instance",
+    "reject-disjunct",
+    "reject-same-solution",
+    "not-good-enough",
+    "reject-prefilter",
+    "variable-cache-hits",
+    "variable-cache-misses",
+    "clause-cache-hits",
+    "clause-cache-misses",
+    "grounding-cache-hits",
+    "grounding-cache-misses",
+    "node-list-cache-hits",
+    "node-list-cache-misses",
+};
+
+static const char* timer_names[] =
+{
+    "match-time",
+    "grounding-time",
+};
+
+void SuRealStats::set_enabled(bool on)
+{
+    s_enabled.store(on, std::memory_order_relaxed);
+}
+
+/**
+ * Add a latency to a histogram.
+ *
+ * @param t    the timer to add to
+ * @param ns   the latency, in nanoseconds
+ */
+void SuRealStats::record(Timer t, uint64_t ns)
+{
+    Histogram& hist = s_timers[t];
+
+    int b = 0;
+    while (b < NUM_BUCKETS - 1 and (ns >> b) > 1) b++;
+
+    hist.buckets[b].fetch_add(1, std::memory_order_relaxed);
+    hist.count.fetch_add(1, std::memory_order_relaxed);
+    hist.total.fetch_add(ns, std::memory_order_relaxed);
+
+    uint64_t prev = hist.max.load(std::memory_order_relaxed);
+    while (prev < ns and
+           not hist.max.compare_exchange_weak(prev, ns, std::memory_order_relaxed));
+}
+
+void SuRealStats::reset()
+{
+    for (auto& c : s_counters)
+        c.store(0, std::memory_order_relaxed);
+
+    for (Histogram& hist : s_timers)
+    {
+        for (auto& b : hist.buckets)
+            b.store(0, std::memory_order_relaxed);
+        hist.count.store(0, std::memory_order_relaxed);
+        hist.total.store(0, std::memory_order_relaxed);
+        hist.max.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Estimate a percentile of a histogram, as the upper bound of the bucket
+ * it falls in.
+ *
+ * @param hist   the histogram
+ * @param p      the percentile, between 0 and 1
+ * @return       the estimate, in nanoseconds
+ */
+double SuRealStats::percentile(const Histogram& hist, double p)
+{
+    uint64_t count = hist.count.load(std::memory_order_relaxed);
+    if (count == 0) return 0;
+
+    uint64_t rank = p * count;
+    uint64_t seen = 0;
+    for (int b = 0; b < NUM_BUCKETS; b++)
+    {
+        seen += hist.buckets[b].load(std::memory_order_relaxed);
+        if (seen > rank)
+            return std::min(double(uint64_t(1) << (b + 1)),
+                            double(hist.max.load(std::memory_order_relaxed)));
+    }
+
+    return hist.max.load(std::memory_order_relaxed);
+}
+
+/**
+ * Format the statistics as a scheme association list, e.g.
+ *
+ *   ((enabled . #t) (candidates . 12) ...
+ *    (match-time (count . 3) (mean-us . 1520.2) (p50-us . 1048.6)
+ *                (p99-us . 2097.2) (max-us . 2011.0)) ...)
+ */
+std::string SuRealStats::report()
+{
+    std::ostringstream oss;
+    oss << "((enabled . " << (enabled() ? "#t" : "#f") << ")";
+
+    for (int c = 0; c < NUM_COUNTERS; c++)
+        oss << " (" << counter_names[c] << " . "
+            << s_counters[c].load(std::memory_order_relaxed) << ")";
+
+    for (int t = 0; t < NUM_TIMERS; t++)
+    {
+        const Histogram& hist = s_timers[t];
+        uint64_t count = hist.count.load(std::memory_order_relaxed);
+        double mean = count ? double(hist.total.load(std::memory_order_relaxed)) / count : 0;
+
+        oss << " (" << timer_names[t]
+            << " (count . " << count << ")"
+            << " (mean-us . " << mean / 1000 << ")"
+            << " (p50-us . " << percentile(hist, 0.5) / 1000 << ")"
+            << " (p99-us . " << percentile(hist, 0.99) / 1000 << ")"
+            << " (max-us . " << hist.max.load(std::memory_order_relaxed) / 1000.0 << "))";
+    }
+
+    oss << ")";
+    return oss.str();
+}
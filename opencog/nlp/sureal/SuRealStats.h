@@ -0,0 +1,147 @@
+/*
+ * SuRealStats.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_SUREAL_STATS_H
+#define _OPENCOG_SUREAL_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace opencog
+{
+namespace nlp
+{
+
+/**
+ * Process-wide counters and latency histograms of the SuReal hot paths.
+ *
+ * Collection is off by default; when it is off, counting costs a single
+ * relaxed atomic load, so it can be left compiled in.  The counters are
+ * updated with relaxed atomics and are only approximately consistent with
+ * each other while a search is running.
+ */
+class SuRealStats
+{
+public:
+    enum Counter
+    {
+        CANDIDATES,            // search candidates explored
+        VARIABLE_MATCHES,      // variable_match calls
+        CLAUSE_MATCHES,        // clause_match calls
+        DISJUNCT_MATCHES,      // disjunct_match calls
+        GROUNDINGS,            // grounding calls
+
+        REJECT_TYPE,           // variable rejected for type mismatch
+        REJECT_NO_WORD_INST,   // variable rejected for having no WordInstanceNode
+        REJECT_DISJUNCT,       // clause or grounding rejected by the LG disjuncts
+        REJECT_SAME_SOLUTION,  // grounding rejected for grounding two variables to one node
+        REJECT_NOT_GOOD_ENOUGH,// grounding kept, but not good enough to stop on
+        REJECT_PREFILTER,      // candidate dropped before the search by its SetLink signature
+
+        VARIABLE_CACHE_HIT,
+        VARIABLE_CACHE_MISS,
+        CLAUSE_CACHE_HIT,
+        CLAUSE_CACHE_MISS,
+        GROUNDING_CACHE_HIT,
+        GROUNDING_CACHE_MISS,
+        NODE_LIST_CACHE_HIT,
+        NODE_LIST_CACHE_MISS,
+
+        NUM_COUNTERS
+    };
+
+    enum Timer
+    {
+        MATCH_TIME,            // a whole sureal-match
+        GROUNDING_TIME,        // a grounding call
+
+        NUM_TIMERS
+    };
+
+    static bool enabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    static void set_enabled(bool);
+
+    static void count(Counter c, uint64_t n = 1)
+    {
+        if (enabled())
+            s_counters[c].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    static void record(Timer, uint64_t ns);
+    static void reset();
+
+    // The counters and timers as a scheme association list.
+    static std::string report();
+
+    /**
+     * Records the time between its construction and destruction, if the
+     * collection was on when it was constructed.
+     */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(Timer t) : m_timer(t), m_on(enabled())
+        {
+            if (m_on) m_start = std::chrono::steady_clock::now();
+        }
+
+        ~ScopedTimer()
+        {
+            if (not m_on) return;
+            std::chrono::nanoseconds d = std::chrono::steady_clock::now() - m_start;
+            record(m_timer, d.count());
+        }
+
+    private:
+        Timer m_timer;
+        bool m_on;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+private:
+    // power-of-two buckets of nanoseconds; the last one takes everything
+    // above 2^(NUM_BUCKETS-1) ns
+    static const int NUM_BUCKETS = 40;
+
+    struct Histogram
+    {
+        std::atomic<uint64_t> buckets[NUM_BUCKETS];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> total;
+        std::atomic<uint64_t> max;
+    };
+
+    static double percentile(const Histogram&, double);
+
+    static std::atomic<bool> s_enabled;
+    static std::atomic<uint64_t> s_counters[NUM_COUNTERS];
+    static Histogram s_timers[NUM_TIMERS];
+};
+
+}
+}
+
+#endif // _OPENCOG_SUREAL_STATS_H
@@ -66,7 +66,9 @@
 ;; This cached version makes sense for Microplanner because it performs a lot of
 ;; sureal queries with very similar inputs.
 ;;
-;; The cache lifetime is a single call of a Microplanner query
+;; The cache lifetime is a single call of a Microplanner query.  There is
+;; one cache per AtomSpace, safe to share between threads; its size is
+;; bounded by `set-sureal-cache-budget` (in megabytes).
 (define-public (cached-sureal a-set-link)
 "
   sureal SETLINK -- main entry point for surface realization
@@ -85,6 +87,49 @@
     )
 )
 
+;; The cache and the candidate index of an AtomSpace live until
+;; `(sureal-release)` is called in that AtomSpace; this has to be done
+;; before the AtomSpace is deleted, once no sureal query is running.
+(set-procedure-property! sureal-release 'documentation
+"
+  sureal-release -- delete the SuReal tables of the current atomspace
+
+  They are made again by the next sureal query.
+")
+
+;; Statistics of the SuReal internals, e.g. how many candidates were
+;; explored and how often the cache was hit; collection is off until
+;; `(sureal-stats-enable #t)` is called.
+(define-public (sureal-stats)
+"
+  sureal-stats -- return the SuReal statistics as an association list
+
+  The counters are kept since the last `(sureal-stats-reset)`; the
+  latencies are in microseconds.
+"
+    (with-input-from-string (sureal-stats-string) read)
+)
+
+;; Batch version of sureal-match, for callers such as the Microplanner,
+;; that need to match many similar SetLinks in a row.  The lookups done
+;; on the words and their LG dictionary entries are shared by the whole
+;; batch.
+(define*-public (sureal-match-batch set-links #:optional (use-cache #f))
+"
+  sureal-match-batch SETLINKS [USE-CACHE] -- sureal-match each of the
+  SETLINKS
+
+  Returns a list with the result of (sureal-match SETLINK) for each
+  SetLink in the list SETLINKS, in the same order.  If USE-CACHE is #t,
+  the matches go through the cache of the atomspace, as those of
+  cached-sureal do.
+"
+    (map
+        (lambda (result) (map cog-value->list (cog-value->list result)))
+        (cog-value->list (sureal-match-batch-value set-links use-cache))
+    )
+)
+
 ; Returns a possible set of SuReals from an input SetLink
 ; * 'a-set-link' : A SetLink which is to be SuRealed
 ; * 'use-cache' : A flag to specify that the cached version of SuReal should be used
@@ -0,0 +1,93 @@
+/*
+ * opencog/nlp/types/InstanceName.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_NLP_INSTANCE_NAME_H
+#define _OPENCOG_NLP_INSTANCE_NAME_H
+
+#include <cstring>
+#include <string>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/base/Link.h>
+#include <opencog/nlp/types/atom_types.h>
+
+namespace opencog
+{
+
+/**
+ * The instances made from a parse, i.e. WordInstanceNodes, and the
+ * ConceptNodes and PredicateNodes that R2L makes from them, are named
+ * "word@id", whatever the id looks like (see LgParseLink about the
+ * naming modes). These get the word part without cutting up names.
+ */
+
+/// True if the name is that of an instance.
+inline bool is_instance_name(const std::string& name)
+{
+    return nullptr != strchr(name.c_str(), '@');
+}
+
+/// The length of the word part of the name of an instance, or of the
+/// whole name if it isn't one; compare the first that many characters
+/// of the name, rather than making a substring of it.
+inline size_t instance_word_length(const std::string& name)
+{
+    const char* at = strchr(name.c_str(), '@');
+    return at ? at - name.c_str() : name.size();
+}
+
+/**
+ * The WordNode of an instance: that of the WordInstanceNode itself,
+ * or of the WordInstanceNode that an R2L instance refers to. This
+ * follows the ReferenceLinks, and doesn't look at the names at all.
+ *
+ * @return  the WordNode, or Handle::UNDEFINED if there isn't one
+ */
+inline Handle get_instance_word(const Handle& h)
+{
+    Handle winst(WORD_INSTANCE_NODE == h->get_type() ? h : Handle::UNDEFINED);
+    if (not winst)
+    {
+        for (const Handle& l : h->getIncomingSetByType(REFERENCE_LINK))
+        {
+            const Handle& to = l->getOutgoingAtom(1);
+            if (l->getOutgoingAtom(0) == h and
+                WORD_INSTANCE_NODE == to->get_type())
+            {
+                winst = to;
+                break;
+            }
+        }
+        if (not winst) return Handle::UNDEFINED;
+    }
+
+    for (const Handle& l : winst->getIncomingSetByType(REFERENCE_LINK))
+    {
+        const Handle& to = l->getOutgoingAtom(1);
+        if (l->getOutgoingAtom(0) == winst and WORD_NODE == to->get_type())
+            return to;
+    }
+    return Handle::UNDEFINED;
+}
+
+} // namespace opencog
+
+#endif // _OPENCOG_NLP_INSTANCE_NAME_H
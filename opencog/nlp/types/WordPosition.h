@@ -0,0 +1,104 @@
+/*
+ * opencog/nlp/types/WordPosition.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_NLP_WORD_POSITION_H
+#define _OPENCOG_NLP_WORD_POSITION_H
+
+#include <cstdlib>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/core/NumberNode.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/nlp/types/atom_types.h>
+
+namespace opencog
+{
+
+/**
+ * The position of a WordInstanceNode, kept on it as a FloatValue of
+ * three numbers: its word sequence number, i.e. the NumberNode of its
+ * WordSequenceLink, the index of the word in its parse, and the index
+ * of the parse in its sentence.  The LgParseLink sets it when it makes
+ * the word instance, so that code ordering words can get it without
+ * going through the WordSequenceLink and reading the name of the
+ * NumberNode.
+ */
+struct WordPosition
+{
+    double sequence;  // -1 if unknown
+    int word;         // -1 if unknown
+    int parse;        // -1 if unknown
+};
+
+inline const Handle& word_position_key()
+{
+    static const Handle key(createNode(PREDICATE_NODE, "*-word-position-*"));
+    return key;
+}
+
+inline void set_word_position(const Handle& winst, double sequence,
+                              int word, int parse)
+{
+    winst->setValue(word_position_key(),
+        createFloatValue(std::vector<double>({sequence,
+                                              (double) word,
+                                              (double) parse})));
+}
+
+/**
+ * The position of the word instance, from its value if it has one,
+ * or else, for the word instances that weren't made by LgParseLink,
+ * e.g. ones loaded from RelEx output, from its WordSequenceLink; then
+ * only the sequence number is known.
+ */
+inline WordPosition get_word_position(const Handle& winst)
+{
+    FloatValuePtr fv(FloatValueCast(winst->getValue(word_position_key())));
+    if (fv and 3 <= fv->value().size())
+    {
+        const std::vector<double>& v = fv->value();
+        return WordPosition{v[0], (int) v[1], (int) v[2]};
+    }
+
+    WordPosition pos{-1, -1, -1};
+    for (const Handle& l : winst->getIncomingSetByType(WORD_SEQUENCE_LINK))
+    {
+        const Handle& num = l->getOutgoingAtom(1);
+        if (l->getOutgoingAtom(0) != winst or NUMBER_NODE != num->get_type())
+            continue;
+        NumberNodePtr nnp(NumberNodeCast(num));
+        pos.sequence = nnp ? nnp->get_value() : atof(num->get_name().c_str());
+        break;
+    }
+    return pos;
+}
+
+/// The word sequence number alone, to sort word instances by.
+inline double word_sequence_number(const Handle& winst)
+{
+    return get_word_position(winst).sequence;
+}
+
+} // namespace opencog
+
+#endif // _OPENCOG_NLP_WORD_POSITION_H
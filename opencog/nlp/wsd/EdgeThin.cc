@@ -6,6 +6,8 @@
  * Copyright (c) 2008 Linas Vepstas <linasvepstas@gmail.com>
  */
 
+#include <algorithm>
+
 #include <opencog/atoms/base/Node.h>
 
 #include "EdgeThin.h"
@@ -138,70 +140,51 @@ void EdgeThin::dbg_parse(Handle h)
  * Remove edges between senses in the indicated parse.
  *
  * Similar to, but opposite of MihalceaEdge::annotate_parse()
- * rather than adding edges, it removes them.
+ * rather than adding edges, it removes them.  The edges and senses
+ * to be removed are collected for all of the words first, and then
+ * removed all together.
  */
 void EdgeThin::thin_parse(const Handle& h, int _keep)
 {
 	edge_count = 0;
 	keep = _keep;
+	doomed_edges.clear();
+	doomed_senses.clear();
 	foreach_word_instance(h, &EdgeThin::thin_word, this);
+
+	for (const Handle& edge : doomed_edges)
+	{
+#ifdef LINK_DEBUG
+		Handle fs = get_word_sense_of_sense_link(edge->getOutgoingAtom(0));
+		Handle ss = get_word_sense_of_sense_link(edge->getOutgoingAtom(1));
+		printf("slink: %s <<-->> %s delete\n",
+			fs->get_name().c_str(), ss->get_name().c_str());
+#endif
+		if (atom_space->remove_atom(edge, false)) edge_count ++;
+	}
+
+	// The senses have no edges left, so they can go now.
+	for (const Handle& sense_h : doomed_senses)
+		atom_space->remove_atom(sense_h, false);
+
+	doomed_edges.clear();
+	doomed_senses.clear();
+
 #ifdef DEBUG
 	printf("; EdgeThin::thin_parse %lx keep=%d deleted %d edges\n",
 		h.value(), keep, edge_count);
 #endif
 }
 
-/**
- * Compare two senses, returning true if the first is more likely than
- * the second.
- */
-static bool sense_compare(const Handle& ha, const Handle& hb)
-{
-	double sa = ha->getTruthValue()->get_count();
-	double sb = hb->getTruthValue()->get_count();
-	if (sa > sb) return true;
-	return false;
-}
-
 bool EdgeThin::make_sense_list(const Handle& sense_h, const Handle& sense_link_h)
 {
-	sense_list.push_back(sense_link_h);
+	sense_list.push_back(std::make_pair(
+		sense_link_h->getTruthValue()->get_count(), sense_link_h));
 	return false;
 }
 
 /**
- * Remove a similarity relation between a pair of word senses.
- * The arg should be a handle to a CosenseLink, previously constructed
- * by MihalceaEdge::sense_of_second_inst().
- */
-bool EdgeThin::delete_sim(const Handle& h)
-{
-#ifdef LINK_DEBUG
-	HandleSeq oset = atom_space.getOutgoing(h);
-	Handle first_sense_link = oset[0];
-	Handle second_sense_link = oset[1];
-
-	Handle fw = get_word_instance_of_sense_link(first_sense_link);
-	Handle fs = get_word_sense_of_sense_link(first_sense_link);
-	const char *vfw = atom_space.get_name(fw).c_str();
-	const char *vfs = atom_space.get_name(fs).c_str();
-
-	Handle sw = get_word_instance_of_sense_link(second_sense_link);
-	Handle ss = get_word_sense_of_sense_link(second_sense_link);
-	const char *vsw = atom_space.get_name(sw).c_str();
-	const char *vss = atom_space.get_name(ss).c_str();
-
-	printf("slink: %s ## %s <<-->> %s ## %s delete\n", vfw, vsw, vfs, vss); 
-	printf("slink: %s ## %s <<-->> %s ## %s delete\n", vsw, vfw, vss, vfs); 
-#endif
-
-	atom_space->remove_atom(h, false);
-	edge_count ++;
-	return true;
-}
-
-/**
- * Remove edges between senses of a pair of words.
+ * Mark the edges between senses of a pair of words for removal.
  *
  * Similar to, but opposite to MihalceaEdge::annotate_word_pair()
  * rather than adding edges, it removes them.
@@ -210,58 +193,43 @@ bool EdgeThin::thin_word(const Handle& word_h)
 {
 	sense_list.clear();
 	foreach_word_sense_of_inst(word_h, &EdgeThin::make_sense_list, this);
-	sense_list.sort(sense_compare);
 
 #ifdef THIN_DEBUG
 	Handle wh = get_dict_word_of_word_instance(word_h);
-	const std::string &wn = atom_space->get_name(wh);
 	printf ("; EdgeThin::thin_word %s to %d from %zu\n",
-		wn.c_str(), keep, sense_list.size());
+		wh->get_name().c_str(), keep, sense_list.size());
 #endif
 
-	// unqueue the ones that we will keep
-	int k = sense_list.size();
-	if (keep < k) k = keep;
-	for (int i=0; i<k; i++) sense_list.pop_front();
-
-	// Delete the rest.
-	std::list<Handle>::iterator it;
-	for (it=sense_list.begin(); it != sense_list.end(); ++it)
+	// Only the top-ranked ones need to be in order; they are kept.
+	size_t k = sense_list.size();
+	if (keep < (int) k) k = std::max(keep, 0);
+	std::partial_sort(sense_list.begin(), sense_list.begin() + k,
+		sense_list.end(),
+		[](const std::pair<double, Handle>& a,
+		   const std::pair<double, Handle>& b)
+		{ return a.first > b.first; });
+
+	// Mark the rest.
+	for (size_t i = k; i < sense_list.size(); i++)
 	{
-		Handle sense_h = *it;
+		const Handle& sense_h = sense_list[i].second;
+		for (const Handle& edge : sense_h->getIncomingSet())
+			doomed_edges.insert(edge);
+
+		// If 'keep' is positive, we'll delete all of the recently disconnected senses. The reason
+		// for this is that we don't want these interfering with the final score
+		// determination process: Some of the disconnected senses might end
+		// up with a higher score than the remaining senses, which would be
+		// wrong; it would be an inversion of how scoring is meant to work.
+		// So we get rid of these now.
+		if (0 < keep) doomed_senses.push_back(sense_h);
 
-		// The for-each traversal is not safe against deletion (bummer!)
-		// and so has to be restarted after each attempt.
-		bool rc = true;
-		int deleted_links = 0;
-		while (rc)
-		{
-			rc = sense_h->foreach_incoming(&EdgeThin::delete_sim, this);
-			deleted_links ++;
-		}
 #ifdef THIN_DEBUG
-		double sa = atom_space->getTV(sense_h).get_count();
 		Handle hws = get_word_sense_of_sense_link(sense_h);
-		printf ("; delete %s with score %f (%d links)\n",
-			atom_space->get_name(hws).c_str(), sa, deleted_links);
+		printf ("; delete %s with score %f\n",
+			hws->get_name().c_str(), sense_list[i].first);
 #endif
 	}
 
-	if (0 >= keep) return false;
-
-	// We can be here only if 'keep' was positive.
-	// We'll delete all of the recently disconnected senses. The reason
-	// for this is that we don't want these interfering with the final score
-	// determination process: Some of the disconnected senses might end
-	// up with a higher score than the remaining senses, which would be
-	// wrong; it would be an inversion of how scoring is meant to work.
-	// So we get rid of these now.
-	for (it=sense_list.begin(); it != sense_list.end(); ++it)
-	{
-		Handle sense_h = *it;
-		atom_space->remove_atom(sense_h, false);
-	}
-
 	return false;
 }
-
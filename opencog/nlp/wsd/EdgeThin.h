@@ -9,7 +9,7 @@
 #ifndef _OPENCOG_WSD_THIN_EDGE_H
 #define _OPENCOG_WSD_THIN_EDGE_H
 
-#include <list>
+#include <vector>
 
 #include <opencog/atoms/base/Atom.h>
 #include <opencog/atomspace/AtomSpace.h>
@@ -27,9 +27,12 @@ class EdgeThin
 		int sense_count;
 		bool count_sense(const Handle&, const Handle&);
 
-		std::list<Handle> sense_list;
+		// The sense links of a word, with their scores, and the edges
+		// and senses to be removed once all words have been looked at.
+		std::vector<std::pair<double, Handle>> sense_list;
 		bool make_sense_list(const Handle&, const Handle&);
-		bool delete_sim(const Handle&);
+		HandleSet doomed_edges;
+		HandleSeq doomed_senses;
 
 		int keep;
 		int edge_count;
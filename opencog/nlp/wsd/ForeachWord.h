@@ -36,7 +36,8 @@ namespace opencog {
 template<class T>
 inline bool foreach_parse(const Handle& h, bool (T::*cb)(const Handle&), T *data)
 {
-	return foreach_reverse_binary_link(h, PARSE_LINK, cb, data);
+	return foreach_reverse_binary_link(h, PARSE_LINK,
+		[&](const Handle& p) { return (data->*cb)(p); });
 }
 
 /**
@@ -54,9 +55,10 @@ inline bool foreach_parse(const Handle& h, bool (T::*cb)(const Handle&), T *data
 template <class T>
 inline bool foreach_word_instance(const Handle& ha, bool (T::*cb)(const Handle&), T *data)
 {
-	FollowLink fl;
-	Handle h = fl.follow_binary_link(ha, REFERENCE_LINK);
-	return LinkCast(h)->foreach_outgoing(cb, data);
+	Handle h = follow_binary_link(ha, REFERENCE_LINK);
+	for (const Handle& wi : h->getOutgoingSet())
+		if ((data->*cb)(wi)) return true;
+	return false;
 }
 
 /**
@@ -76,28 +78,17 @@ inline bool foreach_word_instance(const Handle& ha, bool (T::*cb)(const Handle&)
  * contain the handle of the word-sense; the second arg will contain the
  * handle of the link making up the pair.
  */
-template<typename T>
-class PrivateUseOnlyEachSense
-{
-	public:
-		bool (T::*user_cb)(const Handle&, const Handle&);
-		T *user_data;
-		bool sense_filter(const Handle& h, const Handle& l)
-		{
-			// Rule out relations that aren't actual word-senses.
-			if (h->get_type() != WORD_SENSE_NODE) return false;
-			return (user_data->*user_cb)(h, l);
-		}
-};
-
 template<typename T>
 inline bool foreach_word_sense_of_inst(const Handle& h,
                     bool (T::*cb)(const Handle&, const Handle&), T *data)
 {
-	PrivateUseOnlyEachSense<T> es;
-	es.user_cb = cb;
-	es.user_data = data;
-	return foreach_binary_link(h, INHERITANCE_LINK, &PrivateUseOnlyEachSense<T>::sense_filter, &es);
+	return foreach_binary_link(h, INHERITANCE_LINK,
+		[&](const Handle& s, const Handle& l)
+		{
+			// Rule out relations that aren't actual word-senses.
+			if (s->get_type() != WORD_SENSE_NODE) return false;
+			return (data->*cb)(s, l);
+		});
 }
 
 /**
@@ -115,7 +106,8 @@ template <class T>
 inline bool foreach_dict_word_sense(const Handle& h,
                      bool (T::*cb)(const Handle&), T *data)
 {
-	return foreach_binary_link(h, WORD_SENSE_LINK, cb, data);
+	return foreach_binary_link(h, WORD_SENSE_LINK,
+		[&](const Handle& s) { return (data->*cb)(s); });
 }
 
 /**
@@ -137,43 +129,25 @@ inline bool foreach_dict_word_sense(const Handle& h,
  *       DefinedLinguisticConceptNode "noun"
  *
  */
-// The PrivateUseOnlyPOSFilter class should be local scope to
-// foreach_dict_word_sense_pos() only, but C++ doesn't allow this. :-(
-// This class is not for general, public use!
 template <typename T>
-class PrivateUseOnlyPOSFilter
+inline bool foreach_dict_word_sense_pos(const Handle& h, const std::string &pos,
+                                        bool (T::*cb)(const Handle&), T *data)
 {
-	public:
-		bool (T::*user_cb)(const Handle&);
-		T *user_data;
-		const std::string *desired_pos;
-		bool pos_filter(const Handle& word_sense)
+	return foreach_binary_link(h, WORD_SENSE_LINK,
+		[&](const Handle& word_sense)
 		{
 			// Find the part-of-speech for this word-sense.
-			FollowLink fl;
-			Handle h(fl.follow_binary_link(word_sense, PART_OF_SPEECH_LINK));
+			Handle ph(follow_binary_link(word_sense, PART_OF_SPEECH_LINK));
 
 			// The 'no-sense' special-case sense will not have a pos.
-			const std::string &sense_pos = h->get_name();
+			const std::string &sense_pos = ph->get_name();
 
 			// If there's no POS match, skip this sense.
-			if (desired_pos->compare(sense_pos)) return false;
+			if (pos.compare(sense_pos)) return false;
 
 			// If we are here, there's a match, so call the user callback.
-			return (user_data->*user_cb)(h);
-		}
-};
-
-template <typename T>
-inline bool foreach_dict_word_sense_pos(const Handle& h, const std::string &pos,
-                                        bool (T::*cb)(const Handle&), T *data)
-{
-	PrivateUseOnlyPOSFilter<T> pf;
-	pf.user_cb = cb;
-	pf.user_data = data;
-	pf.desired_pos = &pos;
-	return foreach_binary_link(h, WORD_SENSE_LINK,
-	                         &PrivateUseOnlyPOSFilter<T>::pos_filter, &pf);
+			return (data->*cb)(ph);
+		});
 }
 
 /**
@@ -202,9 +176,8 @@ inline const std::string get_part_of_speech(const Handle& word_instance)
 	static std::string empty;
 
 	// Find the part-of-speech for this word instance.
-	FollowLink fl;
-	Handle inst_pos(fl.follow_binary_link(word_instance, PART_OF_SPEECH_LINK));
-	if (not inst_pos->is_link()) return empty;
+	Handle inst_pos(follow_binary_link(word_instance, PART_OF_SPEECH_LINK));
+	if (nullptr == inst_pos or not inst_pos->is_node()) return empty;
 	return inst_pos->get_name();
 }
 
@@ -220,9 +193,7 @@ inline const std::string get_part_of_speech(const Handle& word_instance)
  */
 inline Handle get_dict_word_of_word_instance(const Handle& word_instance)
 {
-	FollowLink fl;
-	Handle dict_word = fl.follow_binary_link(word_instance, REFERENCE_LINK);
-	return dict_word;
+	return follow_binary_link(word_instance, REFERENCE_LINK);
 }
 
 /**
@@ -237,9 +208,7 @@ inline Handle get_dict_word_of_word_instance(const Handle& word_instance)
  */
 inline Handle get_lemma_of_word_instance(const Handle& word_instance)
 {
-	FollowLink fl;
-	Handle dict_word = fl.follow_binary_link(word_instance, LEMMA_LINK);
-	return dict_word;
+	return follow_binary_link(word_instance, LEMMA_LINK);
 }
 
 /**
@@ -253,7 +222,9 @@ inline bool
 foreach_sense_edge(const Handle& h,
                    bool (T::*cb)(const Handle&, const Handle&), T *data)
 {
-	return foreach_unordered_binary_link(h, COSENSE_LINK, cb, data);
+	return foreach_unordered_binary_link(h, COSENSE_LINK,
+		[&](const Handle& far, const Handle& edge)
+		{ return (data->*cb)(far, edge); });
 }
 
 
@@ -276,62 +247,37 @@ foreach_sense_edge(const Handle& h,
  * It is assumed that the passed handle indicates the first word
  * instance in the relationship.
  */
-// The PrivateUseOnlyRelationFinder class should be local scope to
-// foreach_relex_relation() only, but C++ doesn't allow this. :-(
-// This class is not for general, public use!
-template <typename T>
-class PrivateUseOnlyRelexRelationFinder
-{
-	private:
-		Handle listlink;
-		bool look_for_eval_link(const Handle& h)
-		{
-			Type t = h->get_type();
-			if (t != EVALUATION_LINK) return false;
-
-			// If we are here, lets see if the first node is a ling rel.
-			const Handle& a(h->getOutgoingAtom(0));
-			if (a->get_type() != DEFINED_LINGUISTIC_RELATIONSHIP_NODE) return false;
-
-			// OK, we've found a relationship. Get the second member of
-			// the list link, and call the user callback with it.
-			const std::string &relname = a->get_name();
-
-			const HandleSeq outset = listlink->getOutgoingSet();
-
-			// First arg must be first (avoid reporting twice with swapped order).
-			if (first_arg != outset[0]) return false;
-
-			(user_data->*user_cb)(relname, outset[0], outset[1]);
-			return false;
-		}
-
-	public:
-		Handle first_arg;
-		bool (T::*user_cb)(const std::string &, const Handle&, const Handle&);
-		T *user_data;
-
-		bool look_for_list_link(const Handle& h)
-		{
-			if (h->get_type() != LIST_LINK) return false;
-			listlink = h;
-
-			// If we are here, lets see if the list link is in eval link.
-			h->foreach_incoming(&PrivateUseOnlyRelexRelationFinder::look_for_eval_link, this);
-			return false;
-		}
-};
-
 template <typename T>
 inline bool
 foreach_relex_relation(const Handle& h,
                        bool (T::*cb)(const std::string &, const Handle&, const Handle&), T *data)
 {
-	PrivateUseOnlyRelexRelationFinder<T> rrf;
-	rrf.user_cb = cb;
-	rrf.user_data = data;
-	rrf.first_arg = h;
-	return h->foreach_incoming(&PrivateUseOnlyRelexRelationFinder<T>::look_for_list_link, &rrf);
+	return foreach_incoming_of_type(h, LIST_LINK, false,
+		[&](const Handle& listlink)
+		{
+			// If we are here, lets see if the list link is in eval link.
+			foreach_incoming_of_type(listlink, EVALUATION_LINK, false,
+				[&](const Handle& evl)
+				{
+					// Lets see if the first node is a ling rel.
+					const Handle& a(evl->getOutgoingAtom(0));
+					if (a->get_type() != DEFINED_LINGUISTIC_RELATIONSHIP_NODE)
+						return false;
+
+					// OK, we've found a relationship. Call the user
+					// callback with the members of the list link.
+					const std::string &relname = a->get_name();
+					const HandleSeq& outset = listlink->getOutgoingSet();
+
+					// First arg must be first (avoid reporting twice with
+					// swapped order).
+					if (h != outset[0]) return false;
+
+					(data->*cb)(relname, outset[0], outset[1]);
+					return false;
+				});
+			return false;
+		});
 }
 
 /**
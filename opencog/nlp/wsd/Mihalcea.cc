@@ -12,11 +12,13 @@
 
 #include <opencog/neighbors/ForeachChaseLink.h>
 #include <opencog/nlp/types/atom_types.h>
+#include <opencog/nlp/wsd/ForeachWord.h>
 #include <opencog/nlp/wsd/MihalceaEdge.h>
 #include <opencog/nlp/wsd/MihalceaLabel.h>
 #include <opencog/nlp/wsd/ParseRank.h>
 #include <opencog/nlp/wsd/SenseRank.h>
 #include <opencog/nlp/wsd/ReportRank.h>
+#include <opencog/util/Config.h>
 #include <opencog/util/platform.h>
 
 using namespace opencog;
@@ -27,6 +29,9 @@ Mihalcea::Mihalcea(void)
 {
 	atom_space = NULL;
 	previous_parse = Handle::UNDEFINED;
+	profiling = false;
+	stage_rec = &sentence_rec;
+	stage_lookups = 0;
 }
 
 Mihalcea::~Mihalcea()
@@ -41,6 +46,17 @@ void Mihalcea::set_atom_space(AtomSpace *as)
 	edger.set_atom_space(as);
 	thinner.set_atom_space(as);
 	sweeper.set_atom_space(as);
+
+	if (config().has("WSD_SENSE_RANK") and
+	    "power" == config()["WSD_SENSE_RANK"])
+		sense_ranker.set_engine(SenseRank::POWER_ITERATION);
+
+	if (config().has("WSD_SENSE_RANK_WARM_START"))
+		sense_ranker.set_incremental(config().get_bool("WSD_SENSE_RANK_WARM_START"));
+
+	if (config().has("WORD_PAIR_MI_TABLE") and not parse_ranker.get_mi_table())
+		parse_ranker.set_mi_table(std::make_shared<WordPairMITable>(
+			config()["WORD_PAIR_MI_TABLE"]));
 }
 
 bool Mihalcea::process_sentence(const Handle& h)
@@ -61,10 +77,24 @@ bool Mihalcea::process_sentence(const Handle& h)
 		top_parse.value(), h.value());
 #endif
 
+	profiling = WSDProfile::instance().enabled();
+	if (profiling)
+	{
+		sentence_rec.clear();
+		sentence_rec.document = document_name;
+		sentence_rec.sentence = h->get_name();
+		sentence_rec.sentences = 1;
+		stage_rec = &sentence_rec;
+	}
+	current_parse = top_parse;
+
 	// Attach senses to word instances
+	start_stage();
 	labeller.annotate_parse(top_parse);
+	end_stage(WSDProfile::LABEL);
 
 	// Create edges between sense pairs
+	start_stage();
 	edger.annotate_parse(top_parse);
 
 	// Tweak, based on parser markup
@@ -77,6 +107,7 @@ bool Mihalcea::process_sentence(const Handle& h)
 		edger.annotate_parse_pair(previous_parse, top_parse);
 	}
 	previous_parse = top_parse;
+	end_stage(WSDProfile::EDGE);
 
 #define WINDOW_SIZE 3
 	// Create a short list of the last 3 sentences
@@ -86,21 +117,27 @@ bool Mihalcea::process_sentence(const Handle& h)
 	{
 		Handle earliest = short_list.front();
 		short_list.pop_front();
+		start_stage();
 		thinner.thin_parse(earliest, 0);
+		end_stage(WSDProfile::THIN);
 	}
 
 	// Find the largest disconnected component of the graph, 
 	// and keep only that. Discard all smaller connected components.
+	start_stage();
 	sweeper.sweep_parse(top_parse);
+	end_stage(WSDProfile::SWEEP);
 
 	// If there are any senses that are not attached to anything,
 	// get rid of them now.
+	start_stage();
 	std::deque<Handle>::iterator it;
 	for (it = short_list.begin(); it != short_list.end(); ++it)
 	{
 		Handle parse = *it;
 		thinner.prune_parse(parse);
 	}
+	end_stage(WSDProfile::PRUNE);
 
 	// THICKNESS is the number of senses that we leave attached to a 
 	// given word. We don't want to make this too thin, since the
@@ -112,25 +149,47 @@ bool Mihalcea::process_sentence(const Handle& h)
 	if (WINDOW_SIZE-1 == short_list.size())
 	{
 		// Solve the page-rank equations for the short list.
+		start_stage();
 		sense_ranker.rank_document(short_list);
+		end_stage(WSDProfile::RANK);
 	}
 	if (WINDOW_SIZE == short_list.size())
 	{
 		Handle first = short_list.front();
+		start_stage();
 		thinner.thin_parse(first, THICKNESS);
+		end_stage(WSDProfile::THIN);
 
 		// Solve the page-rank equations for the short list.
+		start_stage();
 		sense_ranker.rank_document(short_list);
+		end_stage(WSDProfile::RANK);
 	}
 
+	if (profiling)
+		WSDProfile::instance().record_sentence(sentence_rec);
+
 	return false;
 }
 
 bool Mihalcea::process_sentence_list(const Handle& h)
 {
 	short_list.clear();
+	sense_ranker.reset();
 	LinkCast(h)->foreach_outgoing(&Mihalcea::process_sentence, this);
 
+	// The rest is profiled as a part of the document, not of any
+	// one sentence.
+	profiling = WSDProfile::instance().enabled();
+	if (profiling)
+	{
+		document_rec.clear();
+		document_rec.document = document_name;
+		document_rec.sentences = LinkCast(h)->get_arity();
+		stage_rec = &document_rec;
+	}
+	current_parse = Handle::UNDEFINED;
+
 	// Solve the page-rank equations for the whole set of sentences.
 	// sense_ranker.rank_document(parse_list);
 	// No .. don't. Use the sliding-window mechanism, above.
@@ -142,27 +201,92 @@ bool Mihalcea::process_sentence_list(const Handle& h)
 	{
 		Handle earliest = short_list.front();
 		short_list.pop_front();
+		start_stage();
 		thinner.thin_parse(earliest, 0);
+		end_stage(WSDProfile::THIN);
 	}
 	while (0 < short_list.size())
 	{
 		Handle earliest = short_list.front();
+		start_stage();
 		thinner.thin_parse(earliest, THICKNESS);
+		end_stage(WSDProfile::THIN);
 
 		// Solve the page-rank equations for the short list.
+		start_stage();
 		sense_ranker.rank_document(short_list);
+		end_stage(WSDProfile::RANK);
 
 		short_list.pop_front();
+		start_stage();
 		thinner.thin_parse(earliest, 0);
+		end_stage(WSDProfile::THIN);
 	}
 
 	// Report the results.
+	start_stage();
 	reporter.report_document(parse_list);
+	end_stage(WSDProfile::REPORT);
+
+	if (profiling)
+		WSDProfile::instance().record_document(document_rec);
 
 	return false;
 }
 
 void Mihalcea::process_document(const Handle& h)
 {
+	document_name = h->get_name();
 	foreach_binary_link(h, REFERENCE_LINK, &Mihalcea::process_sentence_list, this);
 }
+
+// ----------------------------------------
+
+void Mihalcea::start_stage(void)
+{
+	if (not profiling) return;
+	stage_lookups = edger.get_lookup_count();
+	stage_start = std::chrono::steady_clock::now();
+}
+
+/**
+ * Add the time since start_stage() to the stage, and the size of the
+ * graph of the sliding window, as it is now. The counting of the graph
+ * is not timed.
+ */
+void Mihalcea::end_stage(WSDProfile::Stage stage)
+{
+	if (not profiling) return;
+	std::chrono::duration<double> spent =
+		std::chrono::steady_clock::now() - stage_start;
+
+	graph_senses = 0;
+	graph_edges = 0;
+	for (const Handle& parse : short_list)
+		foreach_word_instance(parse, &Mihalcea::count_word, this);
+	if (current_parse and
+	    (short_list.empty() or current_parse != short_list.back()))
+		foreach_word_instance(current_parse, &Mihalcea::count_word, this);
+
+	WSDProfile::Counts& c = stage_rec->stages[stage];
+	c.calls ++;
+	c.seconds += spent.count();
+	c.senses += graph_senses;
+	// Each edge in the window was seen from both of its ends.
+	c.edges += graph_edges / 2;
+	c.lookups += edger.get_lookup_count() - stage_lookups;
+}
+
+bool Mihalcea::count_word(const Handle& word_inst)
+{
+	foreach_word_sense_of_inst(word_inst, &Mihalcea::count_sense, this);
+	return false;
+}
+
+bool Mihalcea::count_sense(const Handle& sense, const Handle& sense_link)
+{
+	graph_senses ++;
+	for (const Handle& edge : sense_link->getIncomingSet())
+		if (COSENSE_LINK == edge->get_type()) graph_edges ++;
+	return false;
+}
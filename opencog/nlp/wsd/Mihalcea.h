@@ -9,6 +9,7 @@
 #ifndef _OPENCOG_MIHALCEA_H
 #define _OPENCOG_MIHALCEA_H
 
+#include <chrono>
 #include <string>
 
 #include <opencog/atoms/base/Atom.h>
@@ -20,6 +21,7 @@
 #include <opencog/nlp/wsd/SenseRank.h>
 #include <opencog/nlp/wsd/ReportRank.h>
 #include <opencog/nlp/wsd/Sweep.h>
+#include <opencog/nlp/wsd/WSDProfile.h>
 
 #include "EdgeThin.h"
 
@@ -44,6 +46,23 @@ class Mihalcea
 		bool process_sentence_list(const Handle&);
 		bool process_sentence(const Handle&);
 
+		// Profiling of the stages, when WSDProfile is enabled.
+		bool profiling;
+		std::string document_name;
+		Handle current_parse;
+		WSDProfile::Record sentence_rec;
+		WSDProfile::Record document_rec;
+		WSDProfile::Record *stage_rec;
+		std::chrono::steady_clock::time_point stage_start;
+		size_t stage_lookups;
+		void start_stage(void);
+		void end_stage(WSDProfile::Stage);
+
+		size_t graph_senses;
+		size_t graph_edges;
+		bool count_word(const Handle&);
+		bool count_sense(const Handle&, const Handle&);
+
 	public:
 		Mihalcea(void);
 		~Mihalcea();
@@ -20,13 +20,19 @@
 #include <stdio.h>
 #include <sys/time.h>
 
+#include <algorithm>
+#include <thread>
+
 #include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/executor/Executor.h>
 #include <opencog/nlp/types/atom_types.h>
 #include <opencog/nlp/wsd/ForeachWord.h>
 #include <opencog/nlp/wsd/MihalceaEdge.h>
 #include <opencog/nlp/wsd/SenseCache.h>
 #include <opencog/nlp/wsd/SenseSimilarityLCH.h>
 #include <opencog/nlp/wsd/SenseSimilaritySQL.h>
+#include <opencog/nlp/wsd/SenseSimilarityTable.h>
+#include <opencog/util/Config.h>
 #include <opencog/util/platform.h>
 
 #define DEBUG
@@ -40,6 +46,8 @@ MihalceaEdge::MihalceaEdge()
 {
 	sen_sim = NULL;
 	atom_space = NULL;
+	nthreads = 1;
+	lookup_count = 0;
 }
 
 MihalceaEdge::~MihalceaEdge()
@@ -52,20 +60,42 @@ void MihalceaEdge::set_atom_space(AtomSpace *as)
 {
 	atom_space = as;
 	if (sen_sim) delete sen_sim;
+	sen_sim = NULL;
 
+	// A sense similarity table, if there is one, is the fastest, as
+	// it needs no database.
+	if (config().has("SENSE_SIMILARITY_TABLE"))
+		sen_sim = new SenseSimilarityTable(config()["SENSE_SIMILARITY_TABLE"]);
+	else
+	{
 #ifdef HAVE_SQL_STORAGE
-	sen_sim = new SenseSimilaritySQL(atom_space);
+		sen_sim = new SenseSimilaritySQL(atom_space);
 #else
-	fprintf (stderr, 
-		"Warning/Error: MihalceaEdge: proper operation of word-sense \n"
-		"disambiguation requires precomputed sense similarities to be\n"
-		"pulled from SQL stoarage.\n");
-	sen_sim = new SenseSimilarityLCH();
+		fprintf (stderr, 
+			"Warning/Error: MihalceaEdge: proper operation of word-sense \n"
+			"disambiguation requires precomputed sense similarities to be\n"
+			"pulled from SQL stoarage, or from a SENSE_SIMILARITY_TABLE.\n");
+		sen_sim = new SenseSimilarityLCH(atom_space);
 #endif /* HAVE_SQL_STORAGE */
+	}
+
+	if (config().has("WSD_EDGE_THREADS"))
+		set_threads(config().get_int("WSD_EDGE_THREADS"));
 
 	sense_cache.set_atom_space(as);
 }
 
+/**
+ * Score the sense pairs with this many threads. This only pays off if
+ * the similarity measure is thread-safe, as the SenseSimilarityTable
+ * is; otherwise they are scored in the calling thread.
+ */
+void MihalceaEdge::set_threads(size_t n)
+{
+	nthreads = (0 < n) ? n : std::thread::hardware_concurrency();
+	if (0 == nthreads) nthreads = 1;
+}
+
 /** Loop over all parses for this sentence. */
 void MihalceaEdge::annotate_sentence(const Handle& h)
 {
@@ -101,6 +131,7 @@ void MihalceaEdge::annotate_parse(const Handle& h)
 			annotate_word_pair(*f, *s);
 		}
 	}
+	make_edges();
 #ifdef DEBUG
 	struct timeval finish, elapsed;
 	gettimeofday(&finish, NULL);
@@ -152,6 +183,7 @@ void MihalceaEdge::annotate_parse_pair(const Handle& ha, const Handle& hb)
 			annotate_word_pair(*ia, *ib);
 		}
 	}
+	make_edges();
 #ifdef DEBUG
 	struct timeval finish, elapsed;
 	gettimeofday(&finish, NULL);
@@ -213,15 +245,34 @@ bool MihalceaEdge::sense_of_first_inst(const Handle& first_word_sense_h,
 }
 
 /**
- * Use a word-sense similarity/relationship measure to assign an
- * initial truth value to the edge. Create an edge only if the
- * relationship is greater than zero.
- *
  * Called for every pair (word-instance,word-sense) of the second
  * word-instance of a relex relationship. This routine is the last,
  * most deeply nested loop of all of this set of nested loops.  This
- * routine now has possession of both pairs, and can now create a
- * Mihalcea-graph edge between these pairs.
+ * routine now has possession of both pairs, and remembers them, so
+ * that make_edges() can score all the pairs of the parse at once.
+ */
+bool MihalceaEdge::sense_of_second_inst(const Handle& second_word_sense_h,
+                                        const Handle& second_sense_link)
+{
+#ifdef SENSE_DETAIL_DEBUG
+	const std::string &fn = second_word_sense_h->get_name();
+	printf ("; Second word sense: %s\n", fn.c_str());
+#endif
+
+	sense_pairs.push_back(
+		SenseSimilarity::SensePair(first_word_sense, second_word_sense_h));
+	sense_link_pairs.push_back(std::make_pair(first_sense_link,
+	                                          second_sense_link));
+	return false;
+}
+
+/**
+ * Use a word-sense similarity/relationship measure to assign an
+ * initial truth value to the edges between all the sense pairs found
+ * so far. Create an edge only if the relationship is greater than
+ * zero. The similarities not in the sense cache are fetched all at
+ * once, which, for the database, is a few queries in place of one per
+ * sense pair.
  *
  * As discussed in the README file, the resulting structure is:
  *
@@ -235,53 +286,98 @@ bool MihalceaEdge::sense_of_first_inst(const Handle& first_word_sense_h,
  *          WordInstanceNode "bark_144"
  *          WordSenseNode "bark_sense_23"
  */
-bool MihalceaEdge::sense_of_second_inst(const Handle& second_word_sense_h,
-                                        const Handle& second_sense_link)
+void MihalceaEdge::make_edges(void)
 {
-#ifdef SENSE_DETAIL_DEBUG
-	const std::string &fn = as->get_name(second_word_sense_h);
-	printf ("; Second word sense: %s\n", fn.c_str());
-#endif
+	// Get the similarities out of the cache, where they are, and fetch
+	// the rest all at once.
+	std::vector<TruthValuePtr> sims(sense_pairs.size());
+	std::vector<SenseSimilarity::SensePair> missing;
+	std::vector<size_t> missing_idx;
+	for (size_t i = 0; i < sense_pairs.size(); i++)
+	{
+		const SenseSimilarity::SensePair& sp = sense_pairs[i];
+		TruthValuePtr tv(sense_cache.similarity(sp.first, sp.second));
+		if (tv == TruthValue::DEFAULT_TV())
+		{
+			missing.push_back(sp);
+			missing_idx.push_back(i);
+		}
+		else
+			sims[i] = tv;
+	}
 
-#ifdef USE_LOCAL_CACHE
-	// Get the similarity between the two word senses out of the
-	// cache (if it exists). XXX This appears to be a loosing strategy,
-	// See the README file for details.  The core problem is that the
-	// cache is using the atomspace in a very inefficient way. XXX
-	SimpleTruthValue stv(0.5,0.5);
-	stv = sense_cache.similarity(first_word_sense, second_word_sense_h);
-	if (stv == TruthValue::DEFAULT_TV())
+	lookup_count += missing.size();
+	std::vector<SimpleTruthValuePtr> fetched(fetch_similarities(missing));
+	for (size_t j = 0; j < fetched.size(); j++)
 	{
-		// Similarity was not found in the cache. Go fetch a value
-		// from the database.
-		stv = sen_sim->similarity(first_word_sense, second_word_sense_h);
-		sense_cache.set_similarity(first_word_sense, second_word_sense_h, stv);
+		const SenseSimilarity::SensePair& sp = missing[j];
+		sense_cache.set_similarity(sp.first, sp.second, fetched[j]);
+		sims[missing_idx[j]] = fetched[j];
 	}
-#else
-	TruthValuePtr stv = sen_sim->similarity(first_word_sense, second_word_sense_h);
-#endif
 
-	// Skip making edges between utterly unrelated nodes.
-	if (stv->get_mean() < 0.01) return false;
+	for (size_t i = 0; i < sims.size(); i++)
+	{
+		const TruthValuePtr& stv = sims[i];
+
+		// Skip making edges between utterly unrelated nodes.
+		if (stv->get_mean() < 0.01) continue;
 
-	// Create a link connecting the first pair to the second pair.
-	atom_space->add_link(COSENSE_LINK, first_sense_link, second_sense_link)->setTruthValue(stv);
-	edge_count ++;
+		// Create a link connecting the first pair to the second pair.
+		const Handle& first_sense_link = sense_link_pairs[i].first;
+		const Handle& second_sense_link = sense_link_pairs[i].second;
+		atom_space->add_link(COSENSE_LINK, first_sense_link,
+		                     second_sense_link)->setTruthValue(stv);
+		edge_count ++;
 
 #ifdef LINK_DEBUG
-	Handle fw = get_word_instance_of_sense_link(first_sense_link);
-	Handle fs = get_word_sense_of_sense_link(first_sense_link);
-	const char *vfw = as->get_name(fw).c_str();
-	const char *vfs = as->get_name(fs).c_str();
-
-	Handle sw = get_word_instance_of_sense_link(second_sense_link);
-	Handle ss = get_word_sense_of_sense_link(second_sense_link);
-	const char *vsw = as->get_name(sw).c_str();
-	const char *vss = as->get_name(ss).c_str();
-
-	printf("slink: %s ## %s <<-->> %s ## %s add\n", vfw, vsw, vfs, vss); 
-	printf("slink: %s ## %s <<-->> %s ## %s add\n", vsw, vfw, vss, vfs); 
+		Handle fw = get_word_instance_of_sense_link(first_sense_link);
+		Handle fs = get_word_sense_of_sense_link(first_sense_link);
+		const char *vfw = fw->get_name().c_str();
+		const char *vfs = fs->get_name().c_str();
+
+		Handle sw = get_word_instance_of_sense_link(second_sense_link);
+		Handle ss = get_word_sense_of_sense_link(second_sense_link);
+		const char *vsw = sw->get_name().c_str();
+		const char *vss = ss->get_name().c_str();
+
+		printf("slink: %s ## %s <<-->> %s ## %s add\n", vfw, vsw, vfs, vss);
+		printf("slink: %s ## %s <<-->> %s ## %s add\n", vsw, vfw, vss, vfs);
 #endif
+	}
 
-	return false;
+	sense_pairs.clear();
+	sense_link_pairs.clear();
+}
+
+/**
+ * Score the sense pairs, splitting them between the threads, if the
+ * similarity measure allows it. The pairs are independent of each
+ * other; the edges are made afterwards, in one pass.
+ */
+std::vector<SimpleTruthValuePtr>
+MihalceaEdge::fetch_similarities(const std::vector<SenseSimilarity::SensePair>& pairs)
+{
+	// Fewer pairs than this are not worth starting a thread for.
+	static const size_t MIN_PAIRS = 64;
+
+	size_t nthr = 1;
+	if (1 < nthreads and sen_sim->is_thread_safe())
+		nthr = std::min(nthreads, (pairs.size() + MIN_PAIRS - 1) / MIN_PAIRS);
+	if (nthr <= 1) return sen_sim->similarities(pairs);
+
+	std::vector<SimpleTruthValuePtr> sims(pairs.size());
+	size_t chunk = (pairs.size() + nthr - 1) / nthr;
+	auto work = [&](size_t begin)
+	{
+		size_t end = std::min(begin + chunk, pairs.size());
+		std::vector<SenseSimilarity::SensePair>
+			part(pairs.begin() + begin, pairs.begin() + end);
+		std::vector<SimpleTruthValuePtr> psims(sen_sim->similarities(part));
+		std::copy(psims.begin(), psims.end(), sims.begin() + begin);
+	};
+
+	Executor::instance().parallel_for(nthr,
+		[&](size_t t) { work(t * chunk); }, nthr);
+
+	return sims;
 }
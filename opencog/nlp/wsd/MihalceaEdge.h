@@ -12,6 +12,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include <opencog/atoms/base/Atom.h>
 #include <opencog/atomspace/AtomSpace.h>
@@ -40,13 +41,31 @@ class MihalceaEdge : private EdgeUtils
 		bool sense_of_first_inst(const Handle&, const Handle&);
 		bool sense_of_second_inst(const Handle&, const Handle&);
 
+		// The sense pairs of all the word pairs of a parse, and their
+		// sense links, to be scored all at once by make_edges().
+		std::vector<SenseSimilarity::SensePair> sense_pairs;
+		std::vector<std::pair<Handle, Handle>> sense_link_pairs;
+		void make_edges(void);
+
+		// The number of sense pairs looked up, not found in the cache.
+		size_t lookup_count;
+
+		// The number of threads scoring the sense pairs.
+		size_t nthreads;
+		std::vector<SimpleTruthValuePtr>
+		fetch_similarities(const std::vector<SenseSimilarity::SensePair>&);
+
 	public:
 		MihalceaEdge();
 		~MihalceaEdge();
 		void set_atom_space(AtomSpace *);
+		void set_threads(size_t);
 		void annotate_sentence(const Handle&);
 		void annotate_parse(const Handle&);
 		void annotate_parse_pair(const Handle&, const Handle&);
+
+		/// The number of similarities looked up so far.
+		size_t get_lookup_count(void) const { return lookup_count; }
 };
 
 } // namespace opencog
@@ -1,8 +1,9 @@
 /*
  * ParseRank.cc
  *
- * Place-holder -- does nothing except return the top-ranked parse,
- * as previously ranked by relex.
+ * Returns the top-ranked parse of a sentence: by the total word-pair
+ * mutual information of its link-grammar links, if a table of it has
+ * been given, else as previously ranked by relex.
  *
  * Copyright (c) 2008 Linas Vepstas <linas@linas.org>
  */
@@ -13,6 +14,8 @@
 #include <stdlib.h>
 #include <math.h>
 
+#include <map>
+
 #include <opencog/util/platform.h>
 #include <opencog/atoms/base/Node.h>
 #include <opencog/atoms/truthvalue/CountTruthValue.h>
@@ -41,6 +44,21 @@ Handle ParseRank::get_top_ranked_parse(const Handle& h)
 {
 	top = Handle::UNDEFINED;
 	top_rank = -123456.0;
+
+	if (mi_table)
+	{
+		// The first of the best, as for the relex ranking.
+		for (const auto& ps : score_parses(h))
+		{
+			if (top_rank < ps.second)
+			{
+				top_rank = ps.second;
+				top = ps.first;
+			}
+		}
+		return top;
+	}
+
 	foreach_parse(h, &ParseRank::lookat_parse, this);
 	return top;
 }
@@ -62,4 +80,90 @@ bool ParseRank::lookat_parse(const Handle& h)
 	return false;
 }
 
+void ParseRank::set_mi_table(std::shared_ptr<const WordPairMITable> table)
+{
+	mi_table = table;
+}
+
+/**
+ * The link-grammar links of a parse are of the form
+ *
+ *    EvaluationLink
+ *       LinkGrammarRelationshipNode "EB"
+ *       ListLink
+ *          WordInstanceNode "consist@79aac665"
+ *          WordInstanceNode "mostly@69de3109"
+ *
+ * and are found from the left word of each; the word instances are
+ * turned into their WordNodes.  Words with no WordNode, such as the
+ * LEFT-WALL, are left out.
+ */
+void ParseRank::get_word_pairs(const Handle& parse, WordPairs& pairs)
+{
+	foreach_reverse_binary_link(parse, WORD_INSTANCE_LINK,
+		[&](const Handle& left_inst)
+		{
+			for (const Handle& ll : left_inst->getIncomingSetByType(LIST_LINK))
+			{
+				if (2 != ll->get_arity() or ll->getOutgoingAtom(0) != left_inst)
+					continue;
+
+				bool is_lg_link = false;
+				for (const Handle& ev : ll->getIncomingSetByType(EVALUATION_LINK))
+					if (LINK_GRAMMAR_RELATIONSHIP_NODE ==
+					    ev->getOutgoingAtom(0)->get_type())
+						is_lg_link = true;
+				if (not is_lg_link) continue;
+
+				Handle left(get_dict_word_of_word_instance(left_inst));
+				Handle right(get_dict_word_of_word_instance(ll->getOutgoingAtom(1)));
+				if (left and right)
+					pairs.push_back(std::make_pair(left, right));
+			}
+			return false;
+		});
+}
+
+/**
+ * Score each parse of the sentence by the total mutual information of
+ * the word pairs of its link-grammar links, as parse-rank.scm did.
+ * Pairs that the table doesn't have add nothing.
+ */
+ParseRank::ParseScores ParseRank::score_parses(const Handle& sentence) const
+{
+	ParseScores scores;
+	std::vector<WordPairs> parse_pairs;
+	foreach_reverse_binary_link(sentence, PARSE_LINK,
+		[&](const Handle& parse)
+		{
+			scores.push_back(std::make_pair(parse, 0.0));
+			parse_pairs.emplace_back();
+			get_word_pairs(parse, parse_pairs.back());
+			return false;
+		});
+
+	// The parses of a sentence mostly share their links.
+	std::map<std::pair<Handle, Handle>, double> mi_of;
+	for (const WordPairs& pairs : parse_pairs)
+		for (const auto& pr : pairs)
+			mi_of.emplace(pr, 0.0);
+
+	if (mi_table)
+	{
+		for (auto& pm : mi_of)
+		{
+			double mi;
+			if (mi_table->find(pm.first.first->get_name(),
+			                   pm.first.second->get_name(), mi))
+				pm.second = mi;
+		}
+	}
+
+	for (size_t i = 0; i < scores.size(); i++)
+		for (const auto& pr : parse_pairs[i])
+			scores[i].second += mi_of[pr];
+
+	return scores;
+}
+
 /* ============================== END OF FILE ====================== */
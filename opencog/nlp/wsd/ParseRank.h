@@ -1,8 +1,9 @@
 /*
  * ParseRank.h
  *
- * Place-holder -- does nothing except return the top-ranked parse,
- * as previously ranked by relex.
+ * Returns the top-ranked parse of a sentence: by the total word-pair
+ * mutual information of its link-grammar links, if a table of it has
+ * been given, else as previously ranked by relex.
  *
  * Copyright (c) 2008 Linas Vepstas <linas@linas.org>
  */
@@ -10,21 +11,49 @@
 #ifndef _OPENCOG_PARSE_RANK_H
 #define _OPENCOG_PARSE_RANK_H
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include <opencog/atoms/base/Handle.h>
+#include <opencog/nlp/wsd/WordPairMITable.h>
 
 namespace opencog {
 
 class ParseRank
 {
+	public:
+		/// The parses of a sentence, each with its score.
+		typedef std::vector<std::pair<Handle, double>> ParseScores;
+
+		/// The left and right WordNodes of a link-grammar link.
+		typedef std::vector<std::pair<Handle, Handle>> WordPairs;
+
 	private:
 		Handle top;
 		double top_rank;
 		bool lookat_parse(const Handle&);
 
+		std::shared_ptr<const WordPairMITable> mi_table;
+
 	public:
 		ParseRank(void);
 		~ParseRank();
 		Handle get_top_ranked_parse(const Handle&);
+
+		/// Rank by the mutual information in the table, rather than by
+		/// the relex ranking; the null pointer is for the latter.
+		void set_mi_table(std::shared_ptr<const WordPairMITable>);
+		std::shared_ptr<const WordPairMITable> get_mi_table(void) const
+		{ return mi_table; }
+
+		/// The word pairs of the link-grammar links of the parse, in one
+		/// pass over its word instances.
+		static void get_word_pairs(const Handle& parse, WordPairs&);
+
+		/// The total mutual information of each parse of the sentence.
+		/// A pair found in several parses is looked up once.
+		ParseScores score_parses(const Handle& sentence) const;
 };
 
 } // namespace opencog
@@ -0,0 +1,155 @@
+/*
+ * ParseRankSCM.cc
+ *
+ * Scheme bindings of the word-pair mutual-information parse ranking,
+ * in place of the interpreted lookups of nlp/scm/parse-rank.scm.
+ *
+ * Copyright (c) 2026 OpenCog Foundation
+ */
+
+#include <algorithm>
+
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/guile/SchemePrimitive.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/nlp/wsd/ParseRank.h>
+
+using namespace opencog;
+
+namespace opencog {
+
+class ParseRankSCM
+{
+	private:
+		static void* init_in_guile(void*);
+		static void init_in_module(void*);
+		void init(void);
+
+		int write_table(const std::string&, const std::string&);
+		int load_table(const std::string&);
+		HandleSeq score(const Handle&);
+		Handle top(const Handle&);
+
+		const ParseRank& ranker(const char*);
+
+		ParseRank parse_ranker;
+
+	public:
+		ParseRankSCM(void);
+};
+
+}
+
+ParseRankSCM::ParseRankSCM(void)
+{
+	static bool is_init = false;
+	if (is_init) return;
+	is_init = true;
+	scm_with_guile(init_in_guile, this);
+}
+
+void* ParseRankSCM::init_in_guile(void* self)
+{
+	scm_c_define_module("opencog nlp parse-rank", init_in_module, self);
+	scm_c_use_module("opencog nlp parse-rank");
+	return NULL;
+}
+
+void ParseRankSCM::init_in_module(void* data)
+{
+	ParseRankSCM* self = (ParseRankSCM*) data;
+	self->init();
+}
+
+void ParseRankSCM::init(void)
+{
+	define_scheme_primitive("parse-rank-write-mi-table",
+		&ParseRankSCM::write_table, this, "nlp parse-rank");
+	define_scheme_primitive("parse-rank-load-mi-table",
+		&ParseRankSCM::load_table, this, "nlp parse-rank");
+	define_scheme_primitive("parse-rank-score",
+		&ParseRankSCM::score, this, "nlp parse-rank");
+	define_scheme_primitive("parse-rank-top",
+		&ParseRankSCM::top, this, "nlp parse-rank");
+}
+
+const ParseRank& ParseRankSCM::ranker(const char* fn)
+{
+	if (nullptr == parse_ranker.get_mi_table())
+		throw InvalidParamException(TRACE_INFO,
+			"%s: no word-pair MI table; load one with "
+			"parse-rank-load-mi-table", fn);
+	return parse_ranker;
+}
+
+/**
+ * Implement the "parse-rank-write-mi-table" scheme primitive.
+ *
+ * @return  the no. of pairs written
+ */
+int ParseRankSCM::write_table(const std::string& dump,
+                              const std::string& path)
+{
+	return WordPairMITable::write_from_dump(dump, path);
+}
+
+/**
+ * Implement the "parse-rank-load-mi-table" scheme primitive.
+ *
+ * @return  the no. of pairs in the table
+ */
+int ParseRankSCM::load_table(const std::string& path)
+{
+	auto table = std::make_shared<const WordPairMITable>(path);
+	parse_ranker.set_mi_table(table);
+	return table->num_pairs();
+}
+
+/**
+ * Implement the "parse-rank-score" scheme primitive.
+ *
+ * Each parse of the sentence gets its total mutual information as a
+ * FloatValue, under (PredicateNode "*-parse-mi-*").
+ *
+ * @return  the parses, best first
+ */
+HandleSeq ParseRankSCM::score(const Handle& sentence)
+{
+	static const Handle key(createNode(PREDICATE_NODE, "*-parse-mi-*"));
+
+	ParseRank::ParseScores scores =
+		ranker("parse-rank-score").score_parses(sentence);
+	std::stable_sort(scores.begin(), scores.end(),
+		[](const std::pair<Handle, double>& a,
+		   const std::pair<Handle, double>& b)
+		{ return a.second > b.second; });
+
+	HandleSeq parses;
+	for (const auto& ps : scores)
+	{
+		ps.first->setValue(key, createFloatValue(std::vector<double>({ps.second})));
+		parses.push_back(ps.first);
+	}
+	return parses;
+}
+
+/**
+ * Implement the "parse-rank-top" scheme primitive.
+ */
+Handle ParseRankSCM::top(const Handle& sentence)
+{
+	ranker("parse-rank-top");
+	return parse_ranker.get_top_ranked_parse(sentence);
+}
+
+extern "C" {
+void opencog_nlp_parse_rank_init(void);
+};
+
+void opencog_nlp_parse_rank_init(void)
+{
+	static ParseRankSCM parse_rank;
+}
+
+/* ============================== END OF FILE ====================== */
@@ -8,11 +8,7 @@
 
 #include "SenseCache.h"
 
-#include <stdio.h>
-#include <math.h>
-
 #include <opencog/util/platform.h>
-#include <opencog/neighbors/ForeachChaseLink.h>
 #include <opencog/atoms/base/Node.h>
 
 using namespace opencog;
@@ -20,6 +16,7 @@ using namespace opencog;
 SenseCache::SenseCache(void)
 {
 	atom_space = NULL;
+	write_through = false;
 }
 
 SenseCache::~SenseCache()
@@ -29,16 +26,44 @@ SenseCache::~SenseCache()
 
 void SenseCache::set_atom_space(AtomSpace *as)
 {
+	std::lock_guard<std::mutex> lck(mtx);
 	atom_space = as;
+	sims.clear();
+}
+
+/**
+ * set_write_through -- keep the similarities in the atomspace too.
+ *
+ * Off by default, so that the atomspace does not fill up with
+ * SimilarityLinks that are only needed while disambiguating.
+ */
+void SenseCache::set_write_through(bool on)
+{
+	write_through = on;
+}
+
+void SenseCache::clear(void)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	sims.clear();
+}
+
+/// The similarity does not depend on the order of the senses.
+SenseCache::Key SenseCache::make_key(const Handle& sense_a,
+                                     const Handle& sense_b)
+{
+	if (sense_b < sense_a) return Key(sense_b, sense_a);
+	return Key(sense_a, sense_b);
 }
 
 /**
  * similarity -- return the similarity measure between two word senses.
  *
  * Return the cached word-sense similarity measure between two word
- * senses. If no cached value found, return NULL_TV.
+ * senses. If no cached value found, return DEFAULT_TV.
  *
- * Sense similarity is stored via similarity links:
+ * With write-through, sense similarity is also looked for among the
+ * similarity links of the atomspace:
  *
  *    SimilarityLink strength=0.8 confidence=0.9
  *       WordSenseNode "bark_sense_23"
@@ -47,34 +72,42 @@ void SenseCache::set_atom_space(AtomSpace *as)
 TruthValuePtr SenseCache::similarity(const Handle& sense_a,
                                      const Handle& sense_b)
 {
-	match_sense = sense_b;
+	Key key(make_key(sense_a, sense_b));
+	{
+		std::lock_guard<std::mutex> lck(mtx);
+		auto it = sims.find(key);
+		if (it != sims.end()) return it->second;
+	}
 
-	bool found = foreach_unordered_binary_link(sense_a, SIMILARITY_LINK,
-	                         &SenseCache::find_sense, this);
+	if (not write_through or NULL == atom_space)
+		return TruthValue::DEFAULT_TV();
 
-	if (!found) return TruthValue::DEFAULT_TV();
-	return found_link->getTruthValue();
-}
+	Handle link(atom_space->get_link(SIMILARITY_LINK, sense_a, sense_b));
+	if (nullptr == link)
+		return TruthValue::DEFAULT_TV();
 
-bool SenseCache::find_sense(const Handle& sense, const Handle& link)
-{
-	if (sense != match_sense) return false;
-	found_link = link;
-	return true;
+	TruthValuePtr tv(link->getTruthValue());
+	std::lock_guard<std::mutex> lck(mtx);
+	sims.emplace(key, tv);
+	return tv;
 }
 
 /**
- * set_similarity -- create link, holding a similarity measure
+ * set_similarity -- remember a similarity measure
  *
- * Create a new link, holding the similarity measure between two word
- * senses.  This link is *not* a part of any atom space; it must be
- * aded to an atom space if desired.
+ * With write-through, a link holding the similarity measure between
+ * the two word senses is added to the atomspace as well.
  */
 void SenseCache::set_similarity(const Handle& sense_a,
                                 const Handle& sense_b, TruthValuePtr tv)
 {
-	// Create a link connecting the two senses.
-	atom_space->add_link(SIMILARITY_LINK, sense_a, sense_b)->setTruthValue(tv);
+	{
+		std::lock_guard<std::mutex> lck(mtx);
+		sims[make_key(sense_a, sense_b)] = tv;
+	}
+
+	if (write_through and atom_space)
+		atom_space->add_link(SIMILARITY_LINK, sense_a, sense_b)->setTruthValue(tv);
 }
 
 /* ============================== END OF FILE ====================== */
@@ -11,25 +11,51 @@
 #ifndef _OPENCOG_SENSE_CACHE_H
 #define _OPENCOG_SENSE_CACHE_H
 
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/truthvalue/TruthValue.h>
 
 namespace opencog {
 
+/**
+ * The similarities are kept in a hash table, keyed by the pair of
+ * senses, in either order. With write-through, each similarity is
+ * also kept in the atomspace, as a SimilarityLink, and those found
+ * there are used as well. The cache may be used from many threads.
+ */
 class SenseCache
 {
 	private:
+		typedef std::pair<Handle, Handle> Key;
+		struct KeyHash
+		{
+			size_t operator()(const Key& k) const
+			{
+				size_t h = std::hash<Handle>()(k.first);
+				return h ^ (std::hash<Handle>()(k.second) + 0x9e3779b9 +
+				            (h << 6) + (h >> 2));
+			}
+		};
+		static Key make_key(const Handle&, const Handle&);
+
 		AtomSpace *atom_space;
-		Handle match_sense;
-		Handle found_link;
-		bool find_sense(const Handle&, const Handle&);
+		bool write_through;
+
+		std::mutex mtx;
+		std::unordered_map<Key, TruthValuePtr, KeyHash> sims;
 
 	public:
 		SenseCache(void);
 		~SenseCache();
 
 		void set_atom_space(AtomSpace *);
+		void set_write_through(bool);
+		void clear(void);
+
 		TruthValuePtr similarity(const Handle&, const Handle&);
 		void set_similarity(const Handle&, const Handle&, TruthValuePtr);
 };
@@ -0,0 +1,166 @@
+/*
+ * SenseHierarchy.cc
+ *
+ * Finds the ancestors of word senses, in the wordnet hypernym and
+ * holonym hierarchies, once, and keeps them for the distance lookups.
+ *
+ * Copyright (c) 2026 OpenCog Foundation
+ */
+
+#include <algorithm>
+#include <climits>
+#include <map>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/nlp/types/atom_types.h>
+#include <opencog/nlp/wsd/SenseHierarchy.h>
+
+using namespace opencog;
+
+SenseHierarchy::SenseHierarchy(AtomSpace *as, int holo)
+	: atom_space(as), max_holo(std::max(0, holo))
+{
+	add_conn = atom_space->atomAddedSignal().connect(
+		[this](const Handle& h) { changed(h); });
+
+	remove_conn = atom_space->atomRemovedSignal().connect(
+		[this](const AtomPtr& a) { changed(Handle(a)); });
+}
+
+SenseHierarchy::~SenseHierarchy()
+{
+	atom_space->atomAddedSignal().disconnect(add_conn);
+	atom_space->atomRemovedSignal().disconnect(remove_conn);
+}
+
+void SenseHierarchy::clear(void)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	index.clear();
+}
+
+/**
+ * A new hypernym or holonym of a sense may give any sense below it a
+ * shorter path to its ancestors, so the whole index is dropped.
+ */
+void SenseHierarchy::changed(const Handle& h)
+{
+	Type t = h->get_type();
+	if (INHERITANCE_LINK != t and HOLONYM_LINK != t) return;
+	if (2 != h->get_arity()) return;
+	if (WORD_SENSE_NODE != h->getOutgoingAtom(0)->get_type()) return;
+
+	clear();
+}
+
+/** The senses directly above this sense, by the type of link. */
+static HandleSeq up(const Handle& sense, Type ltype)
+{
+	HandleSeq ups;
+	for (const Handle& l : sense->getIncomingSet())
+	{
+		if (l->get_type() != ltype or 2 != l->get_arity()) continue;
+		if (l->getOutgoingAtom(0) != sense) continue;
+		const Handle& h = l->getOutgoingAtom(1);
+		if (WORD_SENSE_NODE == h->get_type()) ups.push_back(h);
+	}
+	return ups;
+}
+
+/**
+ * Breadth-first, up from the sense. A sense is visited once for each
+ * number of holonym links gone through to get there, so that a longer
+ * path, with fewer holonyms, is not lost to a shorter one.
+ */
+SenseHierarchy::Ancestors SenseHierarchy::find_ancestors(const Handle& sense) const
+{
+	// The shortest path to each sense, by the exact number of holonyms.
+	std::map<Handle, std::vector<int>> best;
+	auto visit = [&](const Handle& h, int holo, int d,
+	                 std::vector<std::pair<Handle, int>>& next)
+	{
+		std::vector<int>& dist = best[h];
+		if (dist.empty()) dist.resize(max_holo + 1, INT_MAX);
+		if (dist[holo] <= d) return;
+		dist[holo] = d;
+		next.push_back(std::make_pair(h, holo));
+	};
+
+	std::vector<std::pair<Handle, int>> level, next;
+	visit(sense, 0, 0, level);
+	for (int d = 1; not level.empty(); d++)
+	{
+		next.clear();
+		for (const auto& st : level)
+		{
+			for (const Handle& h : up(st.first, INHERITANCE_LINK))
+				visit(h, st.second, d, next);
+			if (st.second < max_holo)
+				for (const Handle& h : up(st.first, HOLONYM_LINK))
+					visit(h, st.second + 1, d, next);
+		}
+		level.swap(next);
+	}
+
+	// Handles in order, and at most so many holonyms, for distance().
+	Ancestors ancs;
+	ancs.reserve(best.size());
+	for (auto& b : best)
+	{
+		for (int i = 1; i <= max_holo; i++)
+			b.second[i] = std::min(b.second[i], b.second[i-1]);
+		ancs.push_back(Ancestor{b.first, std::move(b.second)});
+	}
+	return ancs;
+}
+
+std::shared_ptr<const SenseHierarchy::Ancestors>
+SenseHierarchy::ancestors(const Handle& sense)
+{
+	{
+		std::lock_guard<std::mutex> lck(mtx);
+		auto it = index.find(sense);
+		if (it != index.end()) return it->second;
+	}
+
+	// Found outside of the lock; two threads may both do it, which
+	// is harmless.
+	auto ancs = std::make_shared<const Ancestors>(find_ancestors(sense));
+
+	std::lock_guard<std::mutex> lck(mtx);
+	index[sense] = ancs;
+	return ancs;
+}
+
+/**
+ * Merge the two lists of ancestors; a common one is a subsumer, and
+ * the path through it goes through at most max_holo holonyms in all.
+ */
+int SenseHierarchy::distance(const Handle& first, const Handle& second)
+{
+	std::shared_ptr<const Ancestors> fa(ancestors(first));
+	std::shared_ptr<const Ancestors> sa(ancestors(second));
+
+	int min_dist = INT_MAX;
+	auto f = fa->begin();
+	auto s = sa->begin();
+	while (f != fa->end() and s != sa->end())
+	{
+		if (f->sense < s->sense) { f++; continue; }
+		if (s->sense < f->sense) { s++; continue; }
+
+		for (int i = 0; i <= max_holo; i++)
+		{
+			int fd = f->dist[i];
+			int sd = s->dist[max_holo - i];
+			if (INT_MAX == fd or INT_MAX == sd) continue;
+			min_dist = std::min(min_dist, fd + sd);
+		}
+		f++;
+		s++;
+	}
+
+	return (INT_MAX == min_dist) ? -1 : min_dist;
+}
+
+/* ============================== END OF FILE ====================== */
@@ -0,0 +1,79 @@
+/*
+ * SenseHierarchy.h
+ *
+ * An index over the wordnet hypernym and holonym hierarchies, giving
+ * the distance between two word senses through their least common
+ * subsumer, without walking the hierarchy for each pair.
+ *
+ * Copyright (c) 2026 OpenCog Foundation
+ */
+
+#ifndef _OPENCOG_SENSE_HIERARCHY_H
+#define _OPENCOG_SENSE_HIERARCHY_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog {
+
+/**
+ * For each word sense, the index holds all of the senses above it, in
+ * the hypernym (is-a) and holonym (has-a) hierarchies, each with the
+ * length of the shortest path up to it. At most max_holo holonym links
+ * are followed along a path, as SenseSimilarityLCH does.
+ *
+ * Wordnet senses may have more than one hypernym, so the hierarchy is
+ * not a tree; the ancestors are kept as a list, ordered by their
+ * handles, and the two lists are merged to find the least common
+ * subsumer. A sense has a few dozen ancestors at most, so this is
+ * about as fast as a lookup.
+ *
+ * The ancestors of a sense are found the first time they are asked
+ * for. They are all dropped whenever a hypernym or holonym link is
+ * added to, or removed from the atomspace, and found again as needed.
+ * The index may be used from many threads.
+ */
+class SenseHierarchy
+{
+	private:
+		struct Ancestor
+		{
+			Handle sense;
+			// The length of the shortest path up to the sense, going
+			// through at most as many holonym links as the index.
+			std::vector<int> dist;
+		};
+		typedef std::vector<Ancestor> Ancestors;
+
+		AtomSpace *atom_space;
+		int max_holo;
+		int add_conn;
+		int remove_conn;
+		void changed(const Handle&);
+
+		std::mutex mtx;
+		std::unordered_map<Handle, std::shared_ptr<const Ancestors>> index;
+		std::shared_ptr<const Ancestors> ancestors(const Handle&);
+		Ancestors find_ancestors(const Handle&) const;
+
+	public:
+		SenseHierarchy(AtomSpace *, int max_holo);
+		SenseHierarchy(const SenseHierarchy&) = delete;
+		SenseHierarchy& operator=(const SenseHierarchy&) = delete;
+		~SenseHierarchy();
+
+		/// The number of links between the two senses, through their
+		/// least common subsumer, or -1 if they have none.
+		int distance(const Handle&, const Handle&);
+
+		/// Drop the index; it is built again as needed.
+		void clear(void);
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_SENSE_HIERARCHY_H
@@ -12,6 +12,8 @@
 #include <stdlib.h>
 #include <math.h>
 
+#include <algorithm>
+
 #include <opencog/util/platform.h>
 #include <opencog/atoms/base/Node.h>
 #include <opencog/atoms/truthvalue/CountTruthValue.h>
@@ -42,6 +44,35 @@ SenseRank::SenseRank(void)
 	// smaller than the damper, since even large swings in page rank
 	// are damped by the damper. 
 	convergence_limit = 0.3 * convergence_damper;
+
+	// The power iteration stops when no rank changes by more than
+	// this, or after so many iterations.
+	power_limit = 1.0e-6;
+	max_iterations = 200;
+
+	engine = RANDOM_WALK;
+	incremental = false;
+}
+
+void SenseRank::set_engine(Engine e)
+{
+	engine = e;
+}
+
+void SenseRank::set_incremental(bool on)
+{
+	incremental = on;
+	reset();
+}
+
+/**
+ * Forget the ranks of the last document; the next one is ranked from
+ * scratch.
+ */
+void SenseRank::reset(void)
+{
+	ranked_parses.clear();
+	last_rank.clear();
 }
 
 SenseRank::~SenseRank()
@@ -63,11 +94,25 @@ void SenseRank::rank_sentence(const Handle& h)
 
 void SenseRank::rank_document(const std::deque<Handle> &parse_list)
 {
+	if (POWER_ITERATION == engine)
+	{
+		power_rank(parse_list);
+		return;
+	}
+
 	// Iterate over list of parses making up a "document"
 	std::deque<Handle>::const_iterator i;
 	for (i = parse_list.begin(); i != parse_list.end(); ++i)
 	{
-		init_parse(*i);
+		if (not incremental or 0 == ranked_parses.count(*i))
+			init_parse(*i);
+	}
+
+	// The parses that were ranked before start from their old ranks.
+	if (incremental)
+	{
+		converge = 1.0;
+		ranked_parses = HandleSet(parse_list.begin(), parse_list.end());
 	}
 	for (i = parse_list.begin(); i != parse_list.end(); ++i)
 	{
@@ -117,6 +162,11 @@ void SenseRank::rank_parse(const Handle& h)
 #ifdef DEBUG
 	printf ("; SenseRank rank parse %x\n", h); 
 #endif
+	if (POWER_ITERATION == engine)
+	{
+		power_rank(std::deque<Handle>(1, h));
+		return;
+	}
 	foreach_word_instance(h, &SenseRank::start_word, this);
 }
 
@@ -335,4 +385,134 @@ Handle SenseRank::pick_random_edge(const Handle& h)
 	return next_sense;
 }
 
+/* ======================================================= */
+
+/**
+ * Copy the sense graph of the parses into a sparse matrix, with an
+ * entry t_ab = w_ab / (sum_c w_cb) for each edge joining b to a, as
+ * described at rank_sense(). The sum over c runs over all the edges
+ * of b, as the random walk has it, while only the senses of the parses
+ * get a row and a column.
+ */
+void SenseRank::snapshot(const std::deque<Handle> &parse_list)
+{
+	nodes.clear();
+	node_index.clear();
+	for (const Handle& parse : parse_list)
+		foreach_word_instance(parse, &SenseRank::snap_word, this);
+
+	// The rows, with the bare edge weights for now.
+	row_start.assign(1, 0);
+	columns.clear();
+	weights.clear();
+	edge_sums.assign(nodes.size(), 0.0);
+	for (size_t a = 0; a < nodes.size(); a++)
+	{
+		edge_sum = 0.0;
+		foreach_sense_edge(nodes[a], &SenseRank::snap_edge, this);
+		edge_sums[a] = edge_sum;
+		row_start.push_back(columns.size());
+	}
+
+	for (size_t k = 0; k < columns.size(); k++)
+		weights[k] /= edge_sums[columns[k]];
+}
+
+bool SenseRank::snap_word(const Handle& h)
+{
+	foreach_word_sense_of_inst(h, &SenseRank::snap_sense, this);
+	return false;
+}
+
+bool SenseRank::snap_sense(const Handle& word_sense_h,
+                           const Handle& sense_link_h)
+{
+	if (node_index.emplace(sense_link_h, nodes.size()).second)
+		nodes.push_back(sense_link_h);
+	return false;
+}
+
+bool SenseRank::snap_edge(const Handle& sense_b_h, const Handle& hedge)
+{
+	double weight_ab = hedge->getTruthValue()->get_mean();
+	edge_sum += weight_ab;
+
+	auto it = node_index.find(sense_b_h);
+	if (it != node_index.end())
+	{
+		columns.push_back(it->second);
+		weights.push_back(weight_ab);
+	}
+	return false;
+}
+
+/**
+ * Solve the page-rank equations of rank_sense() for all the senses of
+ * the parses at once, by power iteration. Unlike the random walk, the
+ * result does not depend on the order of the visits, nor on rand().
+ * The ranks are written back to the sense links at the end.
+ *
+ * Senses with no edges at all keep the rank of one, as they do with
+ * the random walk, which never visits them.
+ */
+void SenseRank::power_rank(const std::deque<Handle> &parse_list)
+{
+	snapshot(parse_list);
+
+	size_t n = nodes.size();
+	std::vector<double> rank(n, 1.0);
+	std::vector<double> next(n);
+
+	// Warm start, from the ranks of the senses ranked last time.
+	if (incremental)
+	{
+		for (size_t a = 0; a < n; a++)
+		{
+			auto it = last_rank.find(nodes[a]);
+			if (it != last_rank.end()) rank[a] = it->second;
+		}
+	}
+
+	for (size_t iter = 0; iter < max_iterations; iter++)
+	{
+		double delta = 0.0;
+		for (size_t a = 0; a < n; a++)
+		{
+			size_t begin = row_start[a];
+			size_t end = row_start[a+1];
+			if (begin == end and 0.0 == edge_sums[a])
+			{
+				next[a] = rank[a];
+				continue;
+			}
+
+			double sum = 0.0;
+			for (size_t k = begin; k < end; k++)
+				sum += weights[k] * rank[columns[k]];
+
+			next[a] = (1.0-damping_factor) + damping_factor * sum;
+			delta = std::max(delta, fabs(next[a] - rank[a]));
+		}
+		rank.swap(next);
+
+#ifdef DEBUG
+		printf ("; SenseRank power iteration %zu delta=%g\n", iter, delta);
+#endif
+		if (delta < power_limit) break;
+	}
+
+	for (size_t a = 0; a < n; a++)
+	{
+		TruthValuePtr ctv(CountTruthValue::createTV(1.0, 0.0, (float) rank[a]));
+		nodes[a]->setTruthValue(ctv);
+	}
+
+	if (incremental)
+	{
+		last_rank.clear();
+		for (size_t a = 0; a < n; a++)
+			last_rank[nodes[a]] = rank[a];
+	}
+}
+
 /* ============================== END OF FILE ====================== */
@@ -11,6 +11,9 @@
 #define _OPENCOG_SENSE_RANK_H
 
 #include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <opencog/atoms/base/Handle.h>
 
@@ -47,6 +50,47 @@ class SenseRank
 
 		void log_bad_sense(const Handle&, const std::string&, bool);
 
+		// The sense graph of the parses being ranked, for the power
+		// iteration: the sense links, and the transition weights
+		// between them, as a sparse matrix in compressed-row form.
+		std::vector<Handle> nodes;
+		std::unordered_map<Handle, size_t> node_index;
+		std::vector<size_t> row_start;
+		std::vector<size_t> columns;
+		std::vector<double> weights;
+		std::vector<double> edge_sums;
+		bool snap_word(const Handle&);
+		bool snap_sense(const Handle&, const Handle&);
+		bool snap_edge(const Handle&, const Handle&);
+		void snapshot(const std::deque<Handle> &);
+		void power_rank(const std::deque<Handle> &);
+
+		double power_limit;
+		size_t max_iterations;
+
+		// For the warm start: the parses ranked last time, and the
+		// ranks that the power iteration found for their senses.
+		bool incremental;
+		HandleSet ranked_parses;
+		std::unordered_map<Handle, double> last_rank;
+
+	public:
+		/// How the page-rank equations are solved: by a random walk
+		/// over the atomspace, or by power iteration, over a copy of
+		/// the sense graph taken for the purpose.
+		enum Engine { RANDOM_WALK, POWER_ITERATION };
+		void set_engine(Engine);
+
+		/// Rank each document starting from the ranks found for the
+		/// parses of the last one, rather than from scratch; only the
+		/// new parses get equal probabilities. This suits the sliding
+		/// window of Mihalcea, which ranks most parses more than once.
+		void set_incremental(bool);
+		void reset(void);
+
+	private:
+		Engine engine;
+
 	public:
 		SenseRank();
 		~SenseRank();
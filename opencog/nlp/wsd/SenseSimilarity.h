@@ -9,6 +9,9 @@
 #ifndef _OPENCOG_SENSE_SIMILARITY_H
 #define _OPENCOG_SENSE_SIMILARITY_H
 
+#include <utility>
+#include <vector>
+
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atoms/truthvalue/SimpleTruthValue.h>
 
@@ -21,6 +24,23 @@ class SenseSimilarity
 		virtual ~SenseSimilarity() {};
 
 		virtual SimpleTruthValuePtr similarity(const Handle&, const Handle&) = 0;
+
+		/// True if similarity() may be called from many threads at once.
+		virtual bool is_thread_safe(void) const { return false; }
+
+		/// The similarities of many pairs of senses, in the same order.
+		/// Implementations that can fetch them all at once, such as
+		/// from a database, should do so.
+		typedef std::pair<Handle, Handle> SensePair;
+		virtual std::vector<SimpleTruthValuePtr>
+		similarities(const std::vector<SensePair>& pairs)
+		{
+			std::vector<SimpleTruthValuePtr> sims;
+			sims.reserve(pairs.size());
+			for (const SensePair& p : pairs)
+				sims.push_back(similarity(p.first, p.second));
+			return sims;
+		}
 };
 
 } // namespace opencog
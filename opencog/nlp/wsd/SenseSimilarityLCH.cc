@@ -23,7 +23,7 @@ using namespace opencog;
 
 #define DEBUG
 
-SenseSimilarityLCH::SenseSimilarityLCH()
+SenseSimilarityLCH::SenseSimilarityLCH(AtomSpace *as)
 {
 	// Set 'max_follow_holo' to a small number to limit the total number
 	// of holonym relations to be followed. Setting this to a large number
@@ -32,10 +32,14 @@ SenseSimilarityLCH::SenseSimilarityLCH()
 	// to hours of cpu time per sentence, since cpu time usage is
 	// proportional to 2^(n-factorial). Wow.
 	max_follow_holo = 1;
+
+	hierarchy = NULL;
+	if (as) hierarchy = new SenseHierarchy(as, max_follow_holo);
 }
 
 SenseSimilarityLCH::~SenseSimilarityLCH()
 {
+	delete hierarchy;
 }
 
 /**
@@ -73,14 +77,11 @@ SenseSimilarityLCH::~SenseSimilarityLCH()
 SimpleTruthValuePtr SenseSimilarityLCH::similarity(const Handle& fs,
                                                    const Handle& ss)
 {
-	first_sense = fs;
-	second_sense = ss;
-
 	// If the parts-of-speech don't match, the similarity is zero.
 	// If either one is an adjective or adverb, they're unrelated.
 	// (Although we are not very confident of that!)
-	std::string first_pos = get_part_of_speech(first_sense);
-	std::string second_pos = get_part_of_speech(second_sense);
+	std::string first_pos = get_part_of_speech(fs);
+	std::string second_pos = get_part_of_speech(ss);
 	if ((0 != first_pos.compare(second_pos)) ||
 	    (0 == first_pos.compare("adj")) ||
 	    (0 == first_pos.compare("adv")))
@@ -97,6 +98,37 @@ SimpleTruthValuePtr SenseSimilarityLCH::similarity(const Handle& fs,
 		norm = -3.6889;
 	}
 
+	int dist = -1;
+	if (hierarchy) dist = hierarchy->distance(fs, ss);
+	else dist = walk_distance(fs, ss);
+	if (dist < 0) dist = 1<<28;
+
+	// At this point, dist will contain the shortest distance between
+	// the two word senses. Divide by depth, compute the measure.
+	double sim = ((double) dist+1) / (2.0*depth);
+	sim = log(sim) / norm;
+	if (sim < 0.0) sim = 0.0;
+
+#ifdef DEBUG
+	printf("(%s, %s) dist=%d sim=%g\n",
+	       fs->get_name().c_str(),
+	       ss->get_name().c_str(),
+	       dist, sim);
+	// printf("----\n");
+#endif
+
+	return SimpleTruthValue::createSTV((float) sim, 0.9f);
+}
+
+/**
+ * The shortest distance between the two senses, found by walking up
+ * the hierarchy from both of them, or -1 if there is no path.
+ */
+int SenseSimilarityLCH::walk_distance(const Handle& fs, const Handle& ss)
+{
+	first_sense = fs;
+	second_sense = ss;
+
 	first_cnt = 0;
 	min_cnt = 1<<28;
 
@@ -124,21 +156,8 @@ SimpleTruthValuePtr SenseSimilarityLCH::similarity(const Handle& fs,
 	                         &SenseSimilarityLCH::up_first, this);
 	follow_holo_cnt = 0;
 
-	// At this point, min_cnt will contain the shortest distance between
-	// the two word senses. Divide by depth, compute the measure.
-	double sim = ((double) min_cnt+1) / (2.0*depth);
-	sim = log(sim) / norm;
-	if (sim < 0.0) sim = 0.0;
-
-#ifdef DEBUG
-	printf("(%s, %s) dist=%d sim=%g\n",
-	       first_sense->get_name().c_str(),
-	       second_sense->get_name().c_str(),
-	       min_cnt, sim);
-	// printf("----\n");
-#endif
-
-	return SimpleTruthValue::createSTV((float) sim, 0.9f);
+	if (min_cnt == 1<<28) return -1;
+	return min_cnt;
 }
 
 bool SenseSimilarityLCH::up_first(const Handle& up)
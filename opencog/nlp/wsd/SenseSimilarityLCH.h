@@ -11,7 +11,9 @@
 #ifndef _OPENCOG_SENSE_SIMILARITY_LCH_H
 #define _OPENCOG_SENSE_SIMILARITY_LCH_H
 
+#include <opencog/atomspace/AtomSpace.h>
 #include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/nlp/wsd/SenseHierarchy.h>
 #include <opencog/nlp/wsd/SenseSimilarity.h>
 
 namespace opencog {
@@ -31,12 +33,18 @@ class SenseSimilarityLCH :
 		Handle join_candidate; // aka least common subsumer
 		bool up_first(const Handle&);
 		bool up_second(const Handle&);
+		int walk_distance(const Handle&, const Handle&);
+
+		// Given an atomspace, the distances come from an index of the
+		// hierarchy, rather than from walking it for each pair.
+		SenseHierarchy *hierarchy;
 
 	public:
-		SenseSimilarityLCH();
+		SenseSimilarityLCH(AtomSpace * = NULL);
 		virtual ~SenseSimilarityLCH();
 
 		virtual SimpleTruthValuePtr similarity(const Handle&, const Handle&);
+		virtual bool is_thread_safe(void) const { return NULL != hierarchy; }
 };
 
 } // namespace opencog
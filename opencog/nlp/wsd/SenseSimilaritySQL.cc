@@ -17,6 +17,11 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
+
+#include <map>
+#include <set>
+#include <string>
 
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/atoms/base/Node.h>
@@ -24,6 +29,7 @@
 #include <opencog/persist/sql/odbcxx.h>
 #include <opencog/nlp/wsd/ForeachWord.h>
 #include <opencog/nlp/wsd/SenseSimilaritySQL.h>
+#include <opencog/nlp/wsd/SenseSimilarityTable.h>
 #include <opencog/util/Config.h>
 #include <opencog/util/Logger.h>
 #include <opencog/util/platform.h>
@@ -32,76 +38,91 @@ using namespace opencog;
 
 // #define DEBUG
 
+/// The scores of a pair of senses.  These names exactly mirror those
+/// of the WordNet::Similarity package (and were computed by that
+/// package, and stuffed into DB).  They are also used in the
+/// literature, in e.g. Mihalcea papers.
+struct SenseSimilaritySQL::Scores
+{
+	double hso;
+	double jcn;
+	double lch;
+	double lesk;
+	double lin;
+	double path;
+	double res;
+	double vector;
+	double wup;
+};
+
+/// The rows of a query, by their pair of senses.
 class SenseSimilaritySQL::Response
 {
 	public:
 		ODBCRecordSet *rs;
+		std::map<std::pair<std::string, std::string>, Scores> rows;
 
-		// These names exactly mirror those of the WordNet::Similarity
-		// package (and were computed by that package, and stuffed into DB)
-		// They are also used in the literature, in e.g. Mihalcea papers.
-		double hso;
-		double jcn;
-		double lch;
-		double lesk;
-		double lin;
-		double path;
-		double res;
-		double vector;
-		double wup;
-
-		bool have_data;
-
-		Response(void)
-		{
-			have_data = false;
-		}
+		Response(void) : have_columns(false) {}
 
 		bool row_cb(void)
 		{
-			rs->foreach_column(&Response::column_cb, this);
-			have_data = true;
-			return false;
-		}
+			std::string sense_a, sense_b;
+			Scores sc = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+			double* score[] = {&sc.hso, &sc.jcn, &sc.lch, &sc.lesk,
+			                   &sc.lin, &sc.path, &sc.res, &sc.vector,
+			                   &sc.wup};
 
-		bool column_cb(const char *colname, const char * colvalue)
-		{
-			if (!strcmp(colname, "hso"))
-			{
-				hso = atof(colvalue);
-			}
-			else if (!strcmp(colname, "jcn"))
-			{
-				jcn = atof(colvalue);
-			}
-			else if (!strcmp(colname, "lch"))
-			{
-				lch = atof(colvalue);
-			}
-			else if (!strcmp(colname, "lesk"))
+			// The columns come in the same order in every row, so that
+			// their names only need to be looked at in the first one.
+			if (not have_columns)
 			{
-				lesk = atof(colvalue);
+				rs->foreach_column(&Response::name_cb, this);
+				have_columns = true;
 			}
-			else if (!strcmp(colname, "lin"))
-			{
-				lin = atof(colvalue);
-			}
-			else if (!strcmp(colname, "path"))
-			{
-				path = atof(colvalue);
-			}
-			else if (!strcmp(colname, "res"))
-			{
-				res = atof(colvalue);
-			}
-			else if (!strcmp(colname, "vector"))
-			{
-				vector = atof(colvalue);
-			}
-			else if (!strcmp(colname, "wup"))
+
+			col = 0;
+			values.clear();
+			rs->foreach_column(&Response::column_cb, this);
+
+			for (size_t i = 0; i < values.size(); i++)
 			{
-				wup = atof(colvalue);
+				int slot = slots[i];
+				if (SENSE_A == slot) sense_a = values[i];
+				else if (SENSE_B == slot) sense_b = values[i];
+				else if (0 <= slot) *score[slot] = atof(values[i]);
 			}
+			rows[std::make_pair(sense_a, sense_b)] = sc;
+			return false;
+		}
+
+	private:
+		enum { OTHER = -3, SENSE_A = -2, SENSE_B = -1 };
+
+		// For each column, the score it holds, in the order of the
+		// Scores, or else one of the above.
+		std::vector<int> slots;
+		bool have_columns;
+		size_t col;
+		std::vector<const char*> values;
+
+		bool name_cb(const char *colname, const char *)
+		{
+			static const char* names[] = {"hso", "jcn", "lch", "lesk",
+				"lin", "path", "res", "vector", "wup"};
+
+			int slot = OTHER;
+			if (!strcmp(colname, "sense_idx_a")) slot = SENSE_A;
+			else if (!strcmp(colname, "sense_idx_b")) slot = SENSE_B;
+			for (int i = 0; i < 9; i++)
+				if (!strcmp(colname, names[i])) slot = i;
+			slots.push_back(slot);
+			return false;
+		}
+
+		bool column_cb(const char *, const char * colvalue)
+		{
+			if (col++ < slots.size())
+				values.push_back(colvalue);
 			return false;
 		}
 };
@@ -130,31 +151,81 @@ SenseSimilaritySQL::~SenseSimilaritySQL()
 SimpleTruthValuePtr SenseSimilaritySQL::similarity(const Handle& first_sense,
         const Handle& second_sense)
 {
-	std::string fk = as->get_name(first_sense);
-	std::string sk = as->get_name(second_sense);
-
-	escape_single_quotes(fk);
-	escape_single_quotes(sk);
+	return similarities({SensePair(first_sense, second_sense)})[0];
+}
 
-#define BUFSZ 500
-	char qry[BUFSZ];
-	snprintf(qry, BUFSZ, "SELECT * FROM SensePairScores WHERE "
-		"sense_idx_a = \'%s\' AND sense_idx_b = \'%s\';",
-		fk.c_str(), sk.c_str());
+/**
+ * Fetch the scores of all the pairs of senses with a few queries,
+ * each for many pairs, rather than one query per pair.
+ */
+std::vector<SimpleTruthValuePtr>
+SenseSimilaritySQL::similarities(const std::vector<SensePair>& pairs)
+{
+	// The number of pairs asked for by one query.
+	static const size_t BATCH = 500;
 
 	Response rp;
-	rp.rs = db_conn->exec(qry);
-	rp.rs->foreach_row(&Response::row_cb, &rp);
-	rp.rs->release();
+	std::set<std::pair<std::string, std::string>> asked;
+	std::string qry;
+	size_t nqry = 0;
+
+	auto run_query = [&]()
+	{
+		qry += ");";
+		rp.rs = db_conn->exec(qry.c_str());
+		rp.rs->foreach_row(&Response::row_cb, &rp);
+		rp.rs->release();
+		qry.clear();
+		nqry = 0;
+	};
+
+	for (const SensePair& p : pairs)
+	{
+		std::pair<std::string, std::string> key(p.first->get_name(),
+		                                        p.second->get_name());
+		if (not asked.insert(key).second) continue;
+
+		std::string fk = key.first;
+		std::string sk = key.second;
+		escape_single_quotes(fk);
+		escape_single_quotes(sk);
 
-	// If no data, return similarity of zero!
-	// XXX however, what we should really do is to not that we have no
-	// data, and maybe try to gather some.
-	if (!rp.have_data)
+		if (0 == nqry)
+			qry = "SELECT sense_idx_a, sense_idx_b, jcn, lch, lesk "
+			      "FROM SensePairScores WHERE "
+			      "(sense_idx_a, sense_idx_b) IN (";
+		else
+			qry += ", ";
+		qry += "(\'" + fk + "\', \'" + sk + "\')";
+
+		if (BATCH == ++nqry) run_query();
+	}
+	if (0 < nqry) run_query();
+
+	std::vector<SimpleTruthValuePtr> sims;
+	sims.reserve(pairs.size());
+	for (const SensePair& p : pairs)
 	{
-		return SimpleTruthValue::createSTV(0.0f, 0.9f);
+		auto it = rp.rows.find(std::make_pair(p.first->get_name(),
+		                                      p.second->get_name()));
+
+		// If no data, return similarity of zero!
+		// XXX however, what we should really do is to not that we have no
+		// data, and maybe try to gather some.
+		if (it == rp.rows.end())
+			sims.push_back(SimpleTruthValue::createSTV(0.0f, 0.9f));
+		else
+			sims.push_back(score(it->second, p.first, p.second));
 	}
+	return sims;
+}
 
+/**
+ * Turn the scores of a pair of senses into their similarity.
+ */
+SimpleTruthValuePtr SenseSimilaritySQL::score(const Scores& sc,
+        const Handle& first_sense, const Handle& second_sense)
+{
 	std::string first_pos = get_part_of_speech(first_sense);
 	std::string second_pos = get_part_of_speech(second_sense);
 
@@ -165,32 +236,57 @@ SimpleTruthValuePtr SenseSimilaritySQL::similarity(const Handle& first_sense,
 		{
 			// for nouns, jcn is best, per Sinha & Mihalcea
 			// Also .. use their normalization, section 5.2
-			sim = (rp.jcn - 0.04) / (0.2-0.04);
+			sim = SenseSimilarityTable::jcn_similarity(sc.jcn);
 		}
 		else if (0 == first_pos.compare("verb"))
 		{
 			// for verbs, lch is best, per Sinha & Mihalcea
-			sim = (rp.lch - 0.34) / (3.33 - 0.34);
+			sim = SenseSimilarityTable::lch_similarity(sc.lch);
 		}
 	}
 	else
 	{
 		// For all else, use lesk
-		sim = rp.lesk / 240.0;
+		sim = SenseSimilarityTable::lesk_similarity(sc.lesk);
 	}
-	if (sim < 0.0) sim = 0.0;
-	if (1.0 < sim) sim = 1.0;
 
 #ifdef DEBUG
 	if (0.0 < sim) {
-		printf ("%s\n", qry);
-		printf ("sim=%g\n", sim);
+		printf ("%s %s sim=%g\n", first_sense->get_name().c_str(),
+		        second_sense->get_name().c_str(), sim);
 	}
 #endif
 
 	return SimpleTruthValue::createSTV((float) sim, 0.9f);
 }
 
+/**
+ * Copy the whole SensePairScores table into a file that the
+ * SenseSimilarityTable can use in place of the database.
+ */
+size_t SenseSimilaritySQL::export_table(const std::string& path)
+{
+	Response rp;
+	rp.rs = db_conn->exec("SELECT sense_idx_a, sense_idx_b, jcn, lch, lesk "
+	                      "FROM SensePairScores;");
+	rp.rs->foreach_row(&Response::row_cb, &rp);
+	rp.rs->release();
+
+	auto it = rp.rows.begin();
+	return SenseSimilarityTable::write(
+		[&](SenseSimilarityTable::Record& rec)
+		{
+			if (it == rp.rows.end()) return false;
+			rec.sense_a = it->first.first;
+			rec.sense_b = it->first.second;
+			rec.jcn = it->second.jcn;
+			rec.lch = it->second.lch;
+			rec.lesk = it->second.lesk;
+			++it;
+			return true;
+		}, path);
+}
+
 #endif /* HAVE_SQL_STORAGE */
 
 /* ============================== END OF FILE ====================== */
@@ -30,13 +30,23 @@ private:
     AtomSpace *as;
     ODBCConnection *db_conn;
 
+    struct Scores;
     class Response;
 
+    static SimpleTruthValuePtr score(const Scores&, const Handle&,
+                                     const Handle&);
+
 public:
     SenseSimilaritySQL(AtomSpace* _as);
     virtual ~SenseSimilaritySQL();
     
     virtual SimpleTruthValuePtr similarity(const Handle&, const Handle&);
+    virtual std::vector<SimpleTruthValuePtr>
+    similarities(const std::vector<SensePair>&);
+
+    // Copy the table into a file for the SenseSimilarityTable.
+    // Returns the number of sense pairs written.
+    size_t export_table(const std::string&);
 };
 
 } // namespace opencog
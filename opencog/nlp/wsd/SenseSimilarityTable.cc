@@ -0,0 +1,357 @@
+/*
+ * SenseSimilarityTable.cc
+ *
+ * Looks up wordnet-based sense-similarity measures in a file mapped
+ * into memory.  The file is written from the same SensePairScores
+ * table that SenseSimilaritySQL reads, either through the database,
+ * or from a dump of it.
+ *
+ * Copyright (c) 2026 OpenCog Foundation
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <opencog/atoms/base/Node.h>
+#include <opencog/nlp/wsd/ForeachWord.h>
+#include <opencog/nlp/wsd/SenseSimilarityTable.h>
+#include <opencog/util/exceptions.h>
+
+using namespace opencog;
+
+static const char MAGIC[8] = {'W', 'S', 'D', 'S', 'I', 'M', 'T', 'B'};
+
+struct SenseSimilarityTable::Header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t n_senses;
+	uint32_t n_pairs;
+	uint32_t strings_size;
+};
+
+struct SenseSimilarityTable::Pair
+{
+	uint32_t sense_a;
+	uint32_t sense_b;
+	uint16_t jcn;
+	uint16_t lch;
+	uint16_t lesk;
+	uint16_t unused;
+};
+
+static double clamp(double sim)
+{
+	if (sim < 0.0) return 0.0;
+	if (1.0 < sim) return 1.0;
+	return sim;
+}
+
+double SenseSimilarityTable::jcn_similarity(double jcn)
+{
+	return clamp((jcn - 0.04) / (0.2-0.04));
+}
+
+double SenseSimilarityTable::lch_similarity(double lch)
+{
+	return clamp((lch - 0.34) / (3.33 - 0.34));
+}
+
+double SenseSimilarityTable::lesk_similarity(double lesk)
+{
+	return clamp(lesk / 240.0);
+}
+
+static uint16_t quantize(double sim)
+{
+	return (uint16_t) (sim * 65535.0 + 0.5);
+}
+
+static double unquantize(uint16_t q)
+{
+	return q / 65535.0;
+}
+
+/* ======================================================= */
+
+size_t SenseSimilarityTable::write(const std::function<bool(Record&)>& next,
+                                   const std::string& path)
+{
+	// The names get their indexes once all of them are known.
+	std::map<std::string, uint32_t> names;
+	std::vector<std::pair<std::map<std::string, uint32_t>::iterator,
+	                      std::map<std::string, uint32_t>::iterator>> keys;
+	std::vector<Pair> pairs;
+
+	Record rec;
+	while (next(rec))
+	{
+		Pair p;
+		memset(&p, 0, sizeof(p));
+		p.jcn = quantize(jcn_similarity(rec.jcn));
+		p.lch = quantize(lch_similarity(rec.lch));
+		p.lesk = quantize(lesk_similarity(rec.lesk));
+		pairs.push_back(p);
+
+		keys.push_back(std::make_pair(names.emplace(rec.sense_a, 0).first,
+		                              names.emplace(rec.sense_b, 0).first));
+	}
+
+	if (std::numeric_limits<uint32_t>::max() < pairs.size())
+		throw RuntimeException(TRACE_INFO,
+			"Too many sense pairs for the table %s", path.c_str());
+
+	std::string strings;
+	std::vector<uint32_t> senses;
+	uint32_t idx = 0;
+	for (auto& nm : names)
+	{
+		nm.second = idx++;
+		senses.push_back(strings.size());
+		strings += nm.first;
+		strings += '\0';
+	}
+	if (std::numeric_limits<uint32_t>::max() < strings.size())
+		throw RuntimeException(TRACE_INFO,
+			"Too many sense names for the table %s", path.c_str());
+
+	for (size_t i = 0; i < pairs.size(); i++)
+	{
+		pairs[i].sense_a = keys[i].first->second;
+		pairs[i].sense_b = keys[i].second->second;
+	}
+	keys.clear();
+
+	// In order, and with the repeats left out; the first one is kept.
+	auto less = [](const Pair& a, const Pair& b)
+	{
+		if (a.sense_a != b.sense_a) return a.sense_a < b.sense_a;
+		return a.sense_b < b.sense_b;
+	};
+	std::stable_sort(pairs.begin(), pairs.end(), less);
+	pairs.erase(std::unique(pairs.begin(), pairs.end(),
+		[](const Pair& a, const Pair& b)
+		{ return a.sense_a == b.sense_a and a.sense_b == b.sense_b; }),
+		pairs.end());
+
+	Header hdr;
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, MAGIC, sizeof(MAGIC));
+	hdr.version = VERSION;
+	hdr.n_senses = senses.size();
+	hdr.n_pairs = pairs.size();
+	hdr.strings_size = strings.size();
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (not out)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot create the sense similarity table %s", path.c_str());
+
+	out.write((const char*) &hdr, sizeof(hdr));
+	out.write((const char*) senses.data(), senses.size() * sizeof(uint32_t));
+	out.write((const char*) pairs.data(), pairs.size() * sizeof(Pair));
+	out.write(strings.data(), strings.size());
+	out.close();
+
+	if (not out)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot write the sense similarity table %s", path.c_str());
+
+	return pairs.size();
+}
+
+size_t SenseSimilarityTable::write_from_dump(const std::string& dump,
+                                             const std::string& path)
+{
+	std::ifstream in(dump);
+	if (not in)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot open the dump %s", dump.c_str());
+
+	std::string line;
+	return write([&](Record& rec)
+	{
+		while (std::getline(in, line))
+		{
+			std::vector<std::string> cols;
+			size_t start = 0;
+			for (size_t tab; std::string::npos != (tab = line.find('\t', start));
+			     start = tab + 1)
+				cols.push_back(line.substr(start, tab - start));
+			cols.push_back(line.substr(start));
+
+			// Skip blank lines and the like.
+			if (cols.size() < 5) continue;
+
+			rec.sense_a = cols[0];
+			rec.sense_b = cols[1];
+			rec.jcn = atof(cols[2].c_str());
+			rec.lch = atof(cols[3].c_str());
+			rec.lesk = atof(cols[4].c_str());
+			return true;
+		}
+		return false;
+	}, path);
+}
+
+/* ======================================================= */
+
+/**
+ * Map the file into memory.  It is checked through, so that a bad
+ * file is refused here, rather than crashing the lookups.
+ */
+SenseSimilarityTable::SenseSimilarityTable(const std::string& path)
+	: _path(path), _map(nullptr), _map_size(0)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot open the sense similarity table %s", path.c_str());
+
+	struct stat st;
+	if (0 == fstat(fd, &st) and sizeof(Header) <= (size_t) st.st_size)
+	{
+		_map_size = st.st_size;
+		_map = mmap(nullptr, _map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (MAP_FAILED == _map) _map = nullptr;
+	}
+	close(fd);
+
+	auto fail = [&](const char* why)
+	{
+		if (_map) munmap(_map, _map_size);
+		throw RuntimeException(TRACE_INFO,
+			"Bad sense similarity table %s: %s", path.c_str(), why);
+	};
+
+	if (nullptr == _map) fail("cannot map it");
+
+	const char* base = (const char*) _map;
+	_header = (const Header*) base;
+	if (memcmp(_header->magic, MAGIC, sizeof(MAGIC)))
+		fail("not a sense similarity table");
+	if (VERSION != _header->version)
+		fail("wrong version; write it again");
+
+	uint64_t size = sizeof(Header);
+	size += (uint64_t) _header->n_senses * sizeof(uint32_t);
+	size += (uint64_t) _header->n_pairs * sizeof(Pair);
+	size += _header->strings_size;
+	if (size != _map_size) fail("truncated");
+
+	_senses = (const uint32_t*) (base + sizeof(Header));
+	_pairs = (const Pair*) (_senses + _header->n_senses);
+	_strings = (const char*) (_pairs + _header->n_pairs);
+
+	uint32_t ssz = _header->strings_size;
+	if (0 < ssz and '\0' != _strings[ssz - 1]) fail("bad strings");
+
+	for (uint32_t i = 0; i < _header->n_senses; i++)
+	{
+		if (_senses[i] >= ssz) fail("bad sense");
+		if (0 < i and strcmp(_strings + _senses[i-1],
+		                     _strings + _senses[i]) >= 0)
+			fail("senses out of order");
+	}
+
+	for (uint32_t i = 0; i < _header->n_pairs; i++)
+	{
+		const Pair& p = _pairs[i];
+		if (p.sense_a >= _header->n_senses or p.sense_b >= _header->n_senses)
+			fail("bad pair");
+		if (0 < i and (_pairs[i-1].sense_a > p.sense_a or
+		               (_pairs[i-1].sense_a == p.sense_a and
+		                _pairs[i-1].sense_b >= p.sense_b)))
+			fail("pairs out of order");
+	}
+}
+
+SenseSimilarityTable::~SenseSimilarityTable()
+{
+	munmap(_map, _map_size);
+}
+
+size_t SenseSimilarityTable::num_pairs(void) const
+{
+	return _header->n_pairs;
+}
+
+bool SenseSimilarityTable::find_sense(const std::string& name,
+                                      uint32_t& idx) const
+{
+	const uint32_t* end = _senses + _header->n_senses;
+	const uint32_t* s = std::lower_bound(_senses, end, name.c_str(),
+		[this](uint32_t off, const char* nm)
+		{ return strcmp(_strings + off, nm) < 0; });
+
+	if (s == end or strcmp(_strings + *s, name.c_str())) return false;
+	idx = s - _senses;
+	return true;
+}
+
+const SenseSimilarityTable::Pair*
+SenseSimilarityTable::find_pair(const std::string& first,
+                                const std::string& second) const
+{
+	uint32_t a, b;
+	if (not find_sense(first, a) or not find_sense(second, b))
+		return nullptr;
+
+	const Pair* end = _pairs + _header->n_pairs;
+	const Pair* p = std::lower_bound(_pairs, end, std::make_pair(a, b),
+		[](const Pair& pr, const std::pair<uint32_t, uint32_t>& key)
+		{
+			if (pr.sense_a != key.first) return pr.sense_a < key.first;
+			return pr.sense_b < key.second;
+		});
+
+	if (p == end or p->sense_a != a or p->sense_b != b) return nullptr;
+	return p;
+}
+
+/**
+ * The same similarity as SenseSimilaritySQL gives, but for the
+ * quantization of the scores.
+ */
+SimpleTruthValuePtr SenseSimilarityTable::similarity(const Handle& first_sense,
+                                                     const Handle& second_sense)
+{
+	const Pair* p = find_pair(first_sense->get_name(),
+	                          second_sense->get_name());
+
+	// If no data, return similarity of zero, as SenseSimilaritySQL does.
+	if (nullptr == p)
+		return SimpleTruthValue::createSTV(0.0f, 0.9f);
+
+	const std::string first_pos = get_part_of_speech(first_sense);
+	const std::string second_pos = get_part_of_speech(second_sense);
+
+	double sim = 0.0;
+	if (0 == first_pos.compare(second_pos))
+	{
+		if (0 == first_pos.compare("noun"))
+			sim = unquantize(p->jcn);
+		else if (0 == first_pos.compare("verb"))
+			sim = unquantize(p->lch);
+	}
+	else
+	{
+		sim = unquantize(p->lesk);
+	}
+
+	return SimpleTruthValue::createSTV((float) sim, 0.9f);
+}
+
+/* ============================== END OF FILE ====================== */
@@ -0,0 +1,98 @@
+/*
+ * SenseSimilarityTable.h
+ *
+ * Looks up word-sense similarity measures in a file, mapped into
+ * memory, holding the pre-computed scores of the SensePairScores
+ * table.  No database is needed once the file has been written.
+ *
+ * Copyright (c) 2026 OpenCog Foundation
+ */
+
+#ifndef _OPENCOG_SENSE_SIMILARITY_TABLE_H
+#define _OPENCOG_SENSE_SIMILARITY_TABLE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/nlp/wsd/SenseSimilarity.h>
+
+namespace opencog {
+
+/**
+ * The file holds, in the native byte order:
+ *
+ *    a header, with the format version and the counts;
+ *    the offsets of the sense names, in strcmp() order;
+ *    the sense pairs, by the indexes of their names, in order;
+ *    the sense names, each ending with a nul.
+ *
+ * Each pair holds its jcn, lch and lesk similarities, normalized as
+ * SenseSimilaritySQL does, and quantized to 16 bits.  A lookup is a
+ * binary search for each of the two names, and one for the pair; it
+ * allocates nothing.
+ */
+class SenseSimilarityTable :
+	public SenseSimilarity
+{
+	public:
+		static const uint32_t VERSION = 1;
+
+		/// A row of the SensePairScores table.
+		struct Record
+		{
+			std::string sense_a;
+			std::string sense_b;
+			double jcn;
+			double lch;
+			double lesk;
+		};
+
+		/// Write the file, from the rows handed out by the callback,
+		/// until it returns false.  Returns the number of pairs written.
+		static size_t write(const std::function<bool(Record&)>&,
+		                    const std::string& path);
+
+		/// Write the file from a dump of the table, one row per line,
+		/// holding sense_idx_a, sense_idx_b, jcn, lch and lesk,
+		/// separated by tabs.
+		static size_t write_from_dump(const std::string& dump,
+		                              const std::string& path);
+
+		/// The normalizations of Sinha & Mihalcea, section 5.2,
+		/// clamped to [0,1].
+		static double jcn_similarity(double jcn);
+		static double lch_similarity(double lch);
+		static double lesk_similarity(double lesk);
+
+		SenseSimilarityTable(const std::string& path);
+		SenseSimilarityTable(const SenseSimilarityTable&) = delete;
+		SenseSimilarityTable& operator=(const SenseSimilarityTable&) = delete;
+		virtual ~SenseSimilarityTable();
+
+		size_t num_pairs(void) const;
+
+		virtual SimpleTruthValuePtr similarity(const Handle&, const Handle&);
+		virtual bool is_thread_safe(void) const { return true; }
+
+	private:
+		struct Header;
+		struct Pair;
+
+		const Pair* find_pair(const std::string&, const std::string&) const;
+		bool find_sense(const std::string&, uint32_t&) const;
+
+		std::string _path;
+		void* _map;
+		size_t _map_size;
+
+		const Header* _header;
+		const uint32_t* _senses;
+		const Pair* _pairs;
+		const char* _strings;
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_SENSE_SIMILARITY_TABLE_H
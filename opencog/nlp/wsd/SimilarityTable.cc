@@ -0,0 +1,57 @@
+/*
+ * SimilarityTable.cc
+ *
+ * Writes the sense similarity table used by SenseSimilarityTable,
+ * either from a dump of the SensePairScores table, or, when built
+ * with SQL support, straight from the database.
+ *
+ * Copyright (c) 2026 OpenCog Foundation
+ */
+
+#include <iostream>
+#include <string>
+
+#include <opencog/nlp/wsd/SenseSimilaritySQL.h>
+#include <opencog/nlp/wsd/SenseSimilarityTable.h>
+#include <opencog/util/Config.h>
+#include <opencog/util/exceptions.h>
+
+using namespace opencog;
+
+int main(int argc, char *argv[])
+{
+	if (argc != 3 and not (argc == 4 and std::string("--db") == argv[1]))
+	{
+		std::cerr << "Usage: " << argv[0] << " DUMP-FILE TABLE-FILE\n"
+		          << "       " << argv[0] << " --db CONFIG-FILE TABLE-FILE\n"
+		          << "The dump holds sense_idx_a, sense_idx_b, jcn, lch and\n"
+		          << "lesk of each row, separated by tabs." << std::endl;
+		return 1;
+	}
+
+	try
+	{
+		size_t n;
+		if (argc == 3)
+			n = SenseSimilarityTable::write_from_dump(argv[1], argv[2]);
+		else
+		{
+#ifdef HAVE_SQL_STORAGE
+			config().load(argv[2]);
+			SenseSimilaritySQL sql(nullptr);
+			n = sql.export_table(argv[3]);
+#else
+			std::cerr << "Built without SQL support; use a dump." << std::endl;
+			return 1;
+#endif /* HAVE_SQL_STORAGE */
+		}
+		std::cout << "Wrote " << n << " sense pairs to "
+		          << argv[argc - 1] << std::endl;
+	}
+	catch (const StandardException& ex)
+	{
+		std::cerr << ex.get_message() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -1,4 +1,3 @@
-
 /*
  * Sweep.cc
  *
@@ -8,6 +7,8 @@
  * Copyright(c) 2009 Linas Vepstas <linasvepstas@gmail.com>
  */
 
+#include <opencog/nlp/types/atom_types.h>
+
 #include "ForeachWord.h"
 #include "Sweep.h"
 
@@ -26,88 +27,110 @@ void Sweep::set_atom_space(AtomSpace *as)
  */
 void Sweep::sweep_parse(const Handle& h)
 {
-	maxgraph.clear();
-	maxedges.clear();
-	foreach_word_instance(h, &Sweep::mark_word, this);
+	snapshot(h);
+
+	// Union-find, with path halving and union by size.
+	size_t n = nodes.size();
+	parent.resize(n);
+	std::vector<size_t> size(n, 1);
+	for (size_t i = 0; i < n; i++) parent[i] = i;
+
+	for (const Edge& e : edges)
+	{
+		int ra = find(e.a);
+		int rb = find(e.b);
+		if (ra == rb) continue;
+		if (size[ra] < size[rb]) std::swap(ra, rb);
+		parent[rb] = ra;
+		size[ra] += size[rb];
+	}
+
+	// The largest component; of equal ones, the first one found,
+	// in the order of the words of the parse.
+	int maxroot = -1;
+	for (size_t i = 0; i < n; i++)
+	{
+		int r = find(i);
+		if (maxroot < 0 or size[maxroot] < size[r]) maxroot = r;
+	}
+
+	HandleSeq doomed;
+	for (const Edge& e : edges)
+		if (find(e.a) != maxroot) doomed.push_back(e.link);
+
+	delete_edges(doomed);
+
+	node_index.clear();
+	nodes.clear();
+	edges.clear();
+	parent.clear();
 }
 
-/**
- * Walk over the entire connected graph for this word.
- */
-bool Sweep::mark_word(const Handle& wordinst)
+int Sweep::find(int i)
 {
-	curgraph.clear();
-	curedges.clear();
-	foreach_word_sense_of_inst(wordinst, 
-	                        &Sweep::start_mark_sense, this);
-	return false;
+	while (parent[i] != i)
+	{
+		parent[i] = parent[parent[i]];
+		i = parent[i];
+	}
+	return i;
 }
 
-/**
- * Starting at this sense, walk all edges and find all connected
- * senses. Compare it to the largest known graph, and keep the
- * larger of the two, deleting the smaller one.
- *
- * This algorithm is not efficient, because we can't set a "mark"
- * bit on an sense atom. Instead, we have to add it to a bag of atoms
- * we've previously visited, and then search that bag for each new
- * sense that we encounter. Bummer.
- */
-bool Sweep::start_mark_sense(const Handle& sense, const Handle& slink)
+// ----------------------------------------------------------------
+
+int Sweep::node_id(const Handle& sense_link)
 {
-	// Have we already visited this node? If so, try the next sense.
-	if (maxgraph.end() != maxgraph.find(sense)) return false;
+	auto it = node_index.find(sense_link);
+	if (it != node_index.end()) return it->second;
 
-	// Hmm. We've never seen this sense before. Find the graph that
-	// its connected to.
-	curgraph.clear();
-	curedges.clear();
+	int id = nodes.size();
+	node_index.emplace(sense_link, id);
+	nodes.push_back(sense_link);
+	return id;
+}
 
-	// Walk the entire connected component
-	curgraph.insert(sense);
-	foreach_sense_edge(sense, &Sweep::mark_sense, this);
+/**
+ * Copy out the graph connected to the senses of the words of this
+ * parse. The edges may lead to the senses of words of other parses,
+ * in the sliding window; those are copied out too.
+ */
+void Sweep::snapshot(const Handle& h)
+{
+	foreach_word_instance(h, &Sweep::mark_word, this);
 
-	// At this point, "curgraph" holds an entire connected component.
-	// If we found a small graph, delete it.
-	if (curgraph.size() <= maxgraph.size())
-	{
-		// delete all edges in curgraph
-		delete_edges(curedges);
-	}
-	else
+	// The edges of each sense link, as it is reached; the new sense
+	// links at the far end of the edges are added to the end.
+	for (size_t i = 0; i < nodes.size(); i++)
 	{
-		// Delete all edges in maxgraph (we'll delete sensdes later)
-		delete_edges(maxedges);
+		Handle sense_link(nodes[i]);
+		for (const Handle& edge : sense_link->getIncomingSet())
+		{
+			if (COSENSE_LINK != edge->get_type()) continue;
+			const HandleSeq& oset = edge->getOutgoingSet();
+			const Handle& far = (oset[0] == sense_link) ? oset[1] : oset[0];
 
-		// Save the new maxgraph
-		maxgraph = curgraph;
-		maxedges = curedges;
+			// Each edge is seen from both ends; keep it once.
+			int j = node_id(far);
+			if (j < (int) i) continue;
+			edges.push_back(Edge{(int) i, j, edge});
+		}
 	}
-	curgraph.clear();
-	curedges.clear();
-	
+}
+
+bool Sweep::mark_word(const Handle& wordinst)
+{
+	foreach_word_sense_of_inst(wordinst, &Sweep::mark_sense, this);
 	return false;
 }
 
-/**
- * Recursive walk to all attached senses
- */
-bool Sweep::mark_sense(const Handle& sense, const Handle& edge)
+bool Sweep::mark_sense(const Handle& sense, const Handle& slink)
 {
-	curedges.insert(edge);
-	if (curgraph.end() != curgraph.find(sense)) return false;
-	curgraph.insert(sense);
-	foreach_sense_edge(sense, &Sweep::mark_sense, this);
+	node_id(slink);
 	return false;
 }
- 
-void Sweep::delete_edges(HandleSet &edges)
+
+void Sweep::delete_edges(const HandleSeq& doomed)
 {
-	// Remove all of the senses
-	HandleSet::iterator it;
-	for (it=edges.begin(); it != edges.end(); ++it)
-	{
-		Handle edge_h = *it;
+	for (const Handle& edge_h : doomed)
 		atom_space->remove_atom(edge_h, false);
-	}
 }
@@ -1,4 +1,3 @@
-
 /*
  * Sweep.h
  *
@@ -11,25 +10,45 @@
 #ifndef _OPENCOG_WSD_SWEEP_H
 #define _OPENCOG_WSD_SWEEP_H
 
-#include <set>
+#include <unordered_map>
+#include <vector>
 
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/atoms/atom_types/types.h>
 
 namespace opencog {
 
+/**
+ * The graph is copied out of the atomspace first: the sense links
+ * (word-instance, word-sense pairs) are numbered, and the edges kept
+ * as pairs of numbers. The connected components are then found with
+ * a union-find over the numbers, and the edges of all but the largest
+ * one are removed from the atomspace, all together, at the end.
+ */
 class Sweep
 {
 	private:
 		AtomSpace *atom_space;
-		HandleSet maxgraph;
-		HandleSet curgraph;
-		HandleSet maxedges;
-		HandleSet curedges;
+
+		// The snapshot of the graph.
+		struct Edge
+		{
+			int a;
+			int b;
+			Handle link;
+		};
+		std::unordered_map<Handle, int> node_index;
+		HandleSeq nodes;
+		std::vector<Edge> edges;
+		int node_id(const Handle&);
 		bool mark_word(const Handle&);
-		bool start_mark_sense(const Handle&, const Handle&);
 		bool mark_sense(const Handle&, const Handle&);
-		void delete_edges(HandleSet &);
+		void snapshot(const Handle&);
+
+		std::vector<int> parent;
+		int find(int);
+
+		void delete_edges(const HandleSeq&);
 	public:
 		void set_atom_space(AtomSpace *);
 		void sweep_parse(const Handle&);
@@ -38,4 +57,3 @@ class Sweep
 };
 
 #endif /* _OPENCOG_WSD_SWEEP_H */
-
@@ -0,0 +1,187 @@
+/*
+ * WSDProfile.cc
+ *
+ * Adds up, and writes out, the times and counts of the stages of the
+ * word-sense disambiguation.
+ *
+ * Copyright (c) 2026 OpenCog Foundation
+ */
+
+#include <string.h>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/nlp/wsd/WSDProfile.h>
+
+using namespace opencog;
+
+const char * WSDProfile::stage_name(Stage s)
+{
+	static const char * names[NUM_STAGES] = {
+		"label", "edge", "thin", "sweep", "prune", "rank", "report"
+	};
+	return names[s];
+}
+
+WSDProfile::Record::Record(void)
+{
+	clear();
+}
+
+void WSDProfile::Record::clear(void)
+{
+	document.clear();
+	sentence.clear();
+	sentences = 0;
+	memset(stages, 0, sizeof(stages));
+}
+
+void WSDProfile::Record::add(const Record& r)
+{
+	sentences += r.sentences;
+	for (int i = 0; i < NUM_STAGES; i++)
+	{
+		stages[i].calls += r.stages[i].calls;
+		stages[i].seconds += r.stages[i].seconds;
+		stages[i].senses += r.stages[i].senses;
+		stages[i].edges += r.stages[i].edges;
+		stages[i].lookups += r.stages[i].lookups;
+	}
+}
+
+/**
+ * For example,
+ * {"document":"doc@2","sentence":"sentence@7","sentences":1,
+ *  "stages":{"label":{"calls":1,"ms":0.8,"senses":31,"edges":0,
+ *  "lookups":0},...}}
+ * all on one line. The stages that were not run are left out.
+ */
+std::string WSDProfile::Record::to_json(void) const
+{
+	// The atom names are plain enough not to need escapes beyond these.
+	auto quote = [](const std::string& s)
+	{
+		std::string q = "\"";
+		for (char c : s)
+		{
+			if ('"' == c or '\\' == c) q += '\\';
+			q += c;
+		}
+		return q + "\"";
+	};
+
+	std::string json = "{\"document\":" + quote(document);
+	if (not sentence.empty())
+		json += ",\"sentence\":" + quote(sentence);
+	json += ",\"sentences\":" + std::to_string(sentences);
+	json += ",\"stages\":{";
+
+	bool first = true;
+	for (int i = 0; i < NUM_STAGES; i++)
+	{
+		const Counts& c = stages[i];
+		if (0 == c.calls) continue;
+		if (not first) json += ",";
+		first = false;
+
+		json += quote(stage_name((Stage) i)) + ":{" +
+			"\"calls\":" + std::to_string(c.calls) +
+			",\"ms\":" + std::to_string(1000.0 * c.seconds) +
+			",\"senses\":" + std::to_string(c.senses) +
+			",\"edges\":" + std::to_string(c.edges) +
+			",\"lookups\":" + std::to_string(c.lookups) + "}";
+	}
+	return json + "}}";
+}
+
+// ----------------------------------------
+
+WSDProfile& WSDProfile::instance(void)
+{
+	static WSDProfile profile;
+	return profile;
+}
+
+/**
+ * Profiling is on if WSD_PROFILE is true, or if WSD_PROFILE_LOG names
+ * a file for the records.
+ */
+WSDProfile::WSDProfile(void)
+{
+	documents = 0;
+	is_enabled = config().has("WSD_PROFILE") and config().get_bool("WSD_PROFILE");
+	if (config().has("WSD_PROFILE_LOG"))
+		set_log(config()["WSD_PROFILE_LOG"]);
+}
+
+void WSDProfile::set_enabled(bool on)
+{
+	is_enabled = on;
+}
+
+void WSDProfile::set_log(const std::string& path)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	if (log.is_open()) log.close();
+	if (path.empty()) return;
+
+	log.open(path, std::ios::app);
+	if (not log)
+		throw RuntimeException(TRACE_INFO,
+			"WSDProfile: Cannot open %s", path.c_str());
+	is_enabled = true;
+}
+
+void WSDProfile::record_sentence(const Record& r)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	totals.add(r);
+	if (log.is_open()) log << r.to_json() << std::endl;
+}
+
+/// The record of the stages run for the document as a whole; not the
+/// sum of its sentences, which have been recorded already.
+void WSDProfile::record_document(const Record& r)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	documents++;
+	Record part(r);
+	part.sentences = 0;
+	totals.add(part);
+	if (log.is_open()) log << r.to_json() << std::endl;
+}
+
+void WSDProfile::reset(void)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	documents = 0;
+	totals.clear();
+}
+
+/**
+ * For example,
+ * "((documents . 2) (sentences . 17) (label (calls . 17) (ms . 12.5)
+ *   (senses . 530) (edges . 0) (lookups . 0)) ...)"
+ * The senses and edges are summed over the calls; divided by the
+ * calls, they give the average size of the graph after the stage.
+ */
+std::string WSDProfile::to_string(void)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+
+	std::string str = "((documents . " + std::to_string(documents) + ")"
+		" (sentences . " + std::to_string(totals.sentences) + ")";
+	for (int i = 0; i < NUM_STAGES; i++)
+	{
+		const Counts& c = totals.stages[i];
+		str += std::string(" (") + stage_name((Stage) i) +
+			" (calls . " + std::to_string(c.calls) + ")"
+			" (ms . " + std::to_string(1000.0 * c.seconds) + ")"
+			" (senses . " + std::to_string(c.senses) + ")"
+			" (edges . " + std::to_string(c.edges) + ")"
+			" (lookups . " + std::to_string(c.lookups) + "))";
+	}
+	return str + ")";
+}
+
+/* ============================== END OF FILE ====================== */
@@ -0,0 +1,89 @@
+/*
+ * WSDProfile.h
+ *
+ * Times and counts for each stage of the word-sense disambiguation,
+ * for each sentence and document.
+ *
+ * Copyright (c) 2026 OpenCog Foundation
+ */
+
+#ifndef _OPENCOG_WSD_PROFILE_H
+#define _OPENCOG_WSD_PROFILE_H
+
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace opencog {
+
+/**
+ * The stages are those of Mihalcea::process_sentence(), and the final
+ * report on the document. For each stage, the senses and edges are
+ * those of the sliding window of parses once the stage is done; the
+ * lookups are the sense pairs whose similarities were asked for.
+ *
+ * The records of all the Mihalcea instances are added up here; they
+ * may also be written to a file, one JSON object per line, for each
+ * sentence and for each document.
+ */
+class WSDProfile
+{
+	public:
+		enum Stage {
+			LABEL, EDGE, THIN, SWEEP, PRUNE, RANK, REPORT,
+			NUM_STAGES
+		};
+		static const char * stage_name(Stage);
+
+		struct Counts
+		{
+			size_t calls;
+			double seconds;
+			size_t senses;
+			size_t edges;
+			size_t lookups;
+		};
+
+		/// The stages of a sentence, or of all of a document.
+		struct Record
+		{
+			std::string document;
+			std::string sentence;   // empty for the whole document
+			size_t sentences;
+			Counts stages[NUM_STAGES];
+
+			Record(void);
+			void clear(void);
+			void add(const Record&);
+			std::string to_json(void) const;
+		};
+
+		static WSDProfile& instance(void);
+
+		bool enabled(void) const { return is_enabled; }
+		void set_enabled(bool);
+
+		/// Write the records to this file, as well; an empty path
+		/// stops writing them.
+		void set_log(const std::string&);
+
+		void record_sentence(const Record&);
+		void record_document(const Record&);
+		void reset(void);
+
+		/// As a scheme association list
+		std::string to_string(void);
+
+	private:
+		WSDProfile(void);
+
+		bool is_enabled;
+		std::mutex mtx;
+		std::ofstream log;
+		size_t documents;
+		Record totals;
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_WSD_PROFILE_H
@@ -0,0 +1,285 @@
+/*
+ * WordPairMITable.cc
+ *
+ * Looks up word-pair mutual information in a file mapped into memory.
+ * The file is written from a dump of the pairs table of the word-pair
+ * database.
+ *
+ * Copyright (c) 2026 OpenCog Foundation
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <opencog/nlp/wsd/WordPairMITable.h>
+#include <opencog/util/exceptions.h>
+
+using namespace opencog;
+
+static const char MAGIC[8] = {'W', 'O', 'R', 'D', 'P', 'M', 'I', 'T'};
+
+struct WordPairMITable::Header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t n_words;
+	uint32_t n_pairs;
+	uint32_t strings_size;
+};
+
+struct WordPairMITable::Pair
+{
+	uint32_t left;
+	uint32_t right;
+	double mi;
+};
+
+/* ======================================================= */
+
+size_t WordPairMITable::write(const std::function<bool(Record&)>& next,
+                              const std::string& path)
+{
+	// The words get their indexes once all of them are known.
+	std::map<std::string, uint32_t> names;
+	std::vector<std::pair<std::map<std::string, uint32_t>::iterator,
+	                      std::map<std::string, uint32_t>::iterator>> keys;
+	std::vector<Pair> pairs;
+
+	Record rec;
+	while (next(rec))
+	{
+		Pair p;
+		memset(&p, 0, sizeof(p));
+		p.mi = rec.mutual_info;
+		pairs.push_back(p);
+
+		keys.push_back(std::make_pair(names.emplace(rec.left_word, 0).first,
+		                              names.emplace(rec.right_word, 0).first));
+	}
+
+	if (std::numeric_limits<uint32_t>::max() < pairs.size())
+		throw RuntimeException(TRACE_INFO,
+			"Too many word pairs for the table %s", path.c_str());
+
+	std::string strings;
+	std::vector<uint32_t> words;
+	uint32_t idx = 0;
+	for (auto& nm : names)
+	{
+		nm.second = idx++;
+		words.push_back(strings.size());
+		strings += nm.first;
+		strings += '\0';
+	}
+	if (std::numeric_limits<uint32_t>::max() < strings.size())
+		throw RuntimeException(TRACE_INFO,
+			"Too many words for the table %s", path.c_str());
+
+	for (size_t i = 0; i < pairs.size(); i++)
+	{
+		pairs[i].left = keys[i].first->second;
+		pairs[i].right = keys[i].second->second;
+	}
+	keys.clear();
+
+	// In order, and with the repeats left out; the first one is kept.
+	auto less = [](const Pair& a, const Pair& b)
+	{
+		if (a.left != b.left) return a.left < b.left;
+		return a.right < b.right;
+	};
+	std::stable_sort(pairs.begin(), pairs.end(), less);
+	pairs.erase(std::unique(pairs.begin(), pairs.end(),
+		[](const Pair& a, const Pair& b)
+		{ return a.left == b.left and a.right == b.right; }),
+		pairs.end());
+
+	Header hdr;
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, MAGIC, sizeof(MAGIC));
+	hdr.version = VERSION;
+	hdr.n_words = words.size();
+	hdr.n_pairs = pairs.size();
+	hdr.strings_size = strings.size();
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (not out)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot create the word-pair MI table %s", path.c_str());
+
+	// The words are padded out, so that the pairs, with their double,
+	// are aligned in the map.
+	out.write((const char*) &hdr, sizeof(hdr));
+	out.write((const char*) words.data(), words.size() * sizeof(uint32_t));
+	if (words.size() % 2) out.write("\0\0\0\0", sizeof(uint32_t));
+	out.write((const char*) pairs.data(), pairs.size() * sizeof(Pair));
+	out.write(strings.data(), strings.size());
+	out.close();
+
+	if (not out)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot write the word-pair MI table %s", path.c_str());
+
+	return pairs.size();
+}
+
+size_t WordPairMITable::write_from_dump(const std::string& dump,
+                                        const std::string& path)
+{
+	std::ifstream in(dump);
+	if (not in)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot open the dump %s", dump.c_str());
+
+	std::string line;
+	return write([&](Record& rec)
+	{
+		while (std::getline(in, line))
+		{
+			std::vector<std::string> cols;
+			size_t start = 0;
+			for (size_t tab; std::string::npos != (tab = line.find('\t', start));
+			     start = tab + 1)
+				cols.push_back(line.substr(start, tab - start));
+			cols.push_back(line.substr(start));
+
+			// Skip blank lines and the like.
+			if (cols.size() < 3) continue;
+
+			rec.left_word = cols[0];
+			rec.right_word = cols[1];
+			rec.mutual_info = atof(cols[2].c_str());
+			return true;
+		}
+		return false;
+	}, path);
+}
+
+/* ======================================================= */
+
+/**
+ * Map the file into memory.  It is checked through, so that a bad
+ * file is refused here, rather than crashing the lookups.
+ */
+WordPairMITable::WordPairMITable(const std::string& path)
+	: _path(path), _map(nullptr), _map_size(0)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot open the word-pair MI table %s", path.c_str());
+
+	struct stat st;
+	if (0 == fstat(fd, &st) and sizeof(Header) <= (size_t) st.st_size)
+	{
+		_map_size = st.st_size;
+		_map = mmap(nullptr, _map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (MAP_FAILED == _map) _map = nullptr;
+	}
+	close(fd);
+
+	auto fail = [&](const char* why)
+	{
+		if (_map) munmap(_map, _map_size);
+		throw RuntimeException(TRACE_INFO,
+			"Bad word-pair MI table %s: %s", path.c_str(), why);
+	};
+
+	if (nullptr == _map) fail("cannot map it");
+
+	const char* base = (const char*) _map;
+	_header = (const Header*) base;
+	if (memcmp(_header->magic, MAGIC, sizeof(MAGIC)))
+		fail("not a word-pair MI table");
+	if (VERSION != _header->version)
+		fail("wrong version; write it again");
+
+	uint64_t n_offsets = _header->n_words + _header->n_words % 2;
+	uint64_t size = sizeof(Header);
+	size += n_offsets * sizeof(uint32_t);
+	size += (uint64_t) _header->n_pairs * sizeof(Pair);
+	size += _header->strings_size;
+	if (size != _map_size) fail("truncated");
+
+	_words = (const uint32_t*) (base + sizeof(Header));
+	_pairs = (const Pair*) (_words + n_offsets);
+	_strings = (const char*) (_pairs + _header->n_pairs);
+
+	uint32_t ssz = _header->strings_size;
+	if (0 < ssz and '\0' != _strings[ssz - 1]) fail("bad strings");
+
+	for (uint32_t i = 0; i < _header->n_words; i++)
+	{
+		if (_words[i] >= ssz) fail("bad word");
+		if (0 < i and strcmp(_strings + _words[i-1],
+		                     _strings + _words[i]) >= 0)
+			fail("words out of order");
+	}
+
+	for (uint32_t i = 0; i < _header->n_pairs; i++)
+	{
+		const Pair& p = _pairs[i];
+		if (p.left >= _header->n_words or p.right >= _header->n_words)
+			fail("bad pair");
+		if (0 < i and (_pairs[i-1].left > p.left or
+		               (_pairs[i-1].left == p.left and
+		                _pairs[i-1].right >= p.right)))
+			fail("pairs out of order");
+	}
+}
+
+WordPairMITable::~WordPairMITable()
+{
+	munmap(_map, _map_size);
+}
+
+size_t WordPairMITable::num_pairs(void) const
+{
+	return _header->n_pairs;
+}
+
+bool WordPairMITable::find_word(const std::string& name, uint32_t& idx) const
+{
+	const uint32_t* end = _words + _header->n_words;
+	const uint32_t* w = std::lower_bound(_words, end, name.c_str(),
+		[this](uint32_t off, const char* nm)
+		{ return strcmp(_strings + off, nm) < 0; });
+
+	if (w == end or strcmp(_strings + *w, name.c_str())) return false;
+	idx = w - _words;
+	return true;
+}
+
+bool WordPairMITable::find(const std::string& left,
+                           const std::string& right, double& mi) const
+{
+	uint32_t l, r;
+	if (not find_word(left, l) or not find_word(right, r))
+		return false;
+
+	const Pair* end = _pairs + _header->n_pairs;
+	const Pair* p = std::lower_bound(_pairs, end, std::make_pair(l, r),
+		[](const Pair& pr, const std::pair<uint32_t, uint32_t>& key)
+		{
+			if (pr.left != key.first) return pr.left < key.first;
+			return pr.right < key.second;
+		});
+
+	if (p == end or p->left != l or p->right != r) return false;
+	mi = p->mi;
+	return true;
+}
+
+/* ============================== END OF FILE ====================== */
@@ -0,0 +1,88 @@
+/*
+ * WordPairMITable.h
+ *
+ * Looks up word-pair mutual information in a file, mapped into memory,
+ * holding the pre-computed scores of the pairs table that
+ * nlp/scm/parse-rank.scm used to query one pair at a time.
+ *
+ * Copyright (c) 2026 OpenCog Foundation
+ */
+
+#ifndef _OPENCOG_WORD_PAIR_MI_TABLE_H
+#define _OPENCOG_WORD_PAIR_MI_TABLE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace opencog {
+
+/**
+ * The file holds, in the native byte order:
+ *
+ *    a header, with the format version and the counts;
+ *    the offsets of the words, in strcmp() order;
+ *    the word pairs, by the indexes of their words, in order;
+ *    the words, each ending with a nul.
+ *
+ * The pairs are ordered: the left word is the one that comes first in
+ * the sentence.  A lookup is a binary search for each of the two
+ * words, and one for the pair; it allocates nothing, and any number of
+ * threads may do it at once.
+ */
+class WordPairMITable
+{
+	public:
+		static const uint32_t VERSION = 1;
+
+		/// A row of the pairs table.
+		struct Record
+		{
+			std::string left_word;
+			std::string right_word;
+			double mutual_info;
+		};
+
+		/// Write the file, from the rows handed out by the callback,
+		/// until it returns false.  Returns the number of pairs written.
+		static size_t write(const std::function<bool(Record&)>&,
+		                    const std::string& path);
+
+		/// Write the file from a dump of the table, one row per line,
+		/// holding left_word, right_word and mutual_info, separated by
+		/// tabs, as (COPY pairs (left_word, right_word, mutual_info)
+		/// TO 'dump') writes it.
+		static size_t write_from_dump(const std::string& dump,
+		                              const std::string& path);
+
+		WordPairMITable(const std::string& path);
+		WordPairMITable(const WordPairMITable&) = delete;
+		WordPairMITable& operator=(const WordPairMITable&) = delete;
+		~WordPairMITable();
+
+		size_t num_pairs(void) const;
+		const std::string& path(void) const { return _path; }
+
+		/// The mutual information of the pair, if the table has it.
+		bool find(const std::string& left, const std::string& right,
+		          double& mi) const;
+
+	private:
+		struct Header;
+		struct Pair;
+
+		bool find_word(const std::string&, uint32_t&) const;
+
+		std::string _path;
+		void* _map;
+		size_t _map_size;
+
+		const Header* _header;
+		const uint32_t* _words;
+		const Pair* _pairs;
+		const char* _strings;
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_WORD_PAIR_MI_TABLE_H
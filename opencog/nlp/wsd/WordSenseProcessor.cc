@@ -11,16 +11,20 @@
  */
 
 #include <stdio.h>
-#include <pthread.h>
+
+#include <algorithm>
+#include <thread>
 
 #include <opencog/atomspace/AtomSpace.h>
-#include <opencog/neighbors/ForeachChaseLink.h>
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
 #include <opencog/guile/SchemePrimitive.h>
 #include <opencog/nlp/types/atom_types.h>
 #include <opencog/nlp/wsd/MihalceaLabel.h>
+#include <opencog/nlp/wsd/WSDProfile.h>
 #include <opencog/cogserver/server/CogServer.h>
+#include <opencog/executor/Executor.h>
+#include <opencog/util/Config.h>
 
 #include "WordSenseProcessor.h"
 
@@ -30,96 +34,297 @@ DECLARE_MODULE(WordSenseProcessor);
 
 void WordSenseProcessor::init(void)
 {
+	// Documents added before the module was loaded are not signalled.
+	run_no_delay();
 }
 
 // ----------------------------------------
 
 WordSenseProcessor::WordSenseProcessor(CogServer& cs) : Module(cs)
 {
-	pthread_mutex_init(&queue_lock, NULL);
-	thread_running = false;
 	do_use_threads = true;
+	stopping = false;
+	active = 0;
 	cnt = 0;
-	wsd = new Mihalcea();
 	atom_space = &_cogserver.getAtomSpace();
-	wsd->set_atom_space(atom_space);
+
+	num_workers = 1;
+	if (config().has("WSD_WORKERS"))
+		num_workers = std::max(0, config().get_int("WSD_WORKERS"));
+	if (0 == num_workers) num_workers = std::thread::hardware_concurrency();
+	if (0 == num_workers) num_workers = 1;
+
+	max_queue = 64;
+	if (config().has("WSD_QUEUE_SIZE"))
+		max_queue = std::max(1, config().get_int("WSD_QUEUE_SIZE"));
+
+	// The markers of the documents.
+	start_handle = atom_space->add_node(ANCHOR_NODE, "#WSD_started");
+	completion_handle = atom_space->add_node(ANCHOR_NODE, "#WSD_completed");
+
+	start_workers();
+
+	// A DocumentNode is added before the ReferenceLink to its sentences,
+	// so it is the link that says there is a document to work on.
+	add_conn = atom_space->atomAddedSignal().connect(
+		[this](const Handle& h) {
+			if (REFERENCE_LINK == h->get_type() and 0 < h->get_arity() and
+			    DOCUMENT_NODE == h->getOutgoingAtom(0)->get_type())
+				atom_added(h->getOutgoingAtom(0)); });
 
 #ifdef HAVE_GUILE
 	define_scheme_primitive("run-wsd", &WordSenseProcessor::run_wsd, this);
+	define_scheme_primitive("wsd-profile-string",
+		&WordSenseProcessor::profile_string, this);
+	define_scheme_primitive("wsd-profile-reset",
+		&WordSenseProcessor::profile_reset, this);
+	define_scheme_primitive("wsd-profile-log",
+		&WordSenseProcessor::profile_log, this);
+	define_scheme_primitive("wsd-profile-enable",
+		&WordSenseProcessor::profile_enable, this);
 #endif
 }
 
 WordSenseProcessor::~WordSenseProcessor()
 {
+	atom_space->atomAddedSignal().disconnect(add_conn);
+	stop_workers();
+
+	for (Mihalcea *wsd : wsds)
+		delete wsd;
+	wsds.clear();
 	atom_space = NULL;
-	delete wsd;
-	wsd = NULL;
 }
 
 void WordSenseProcessor::use_threads(bool use)
 {
+	if (use == do_use_threads) return;
 	do_use_threads = use;
+	if (use) start_workers();
+	else stop_workers();
+}
+
+/**
+ * Use this many workers; 0 for one per core.
+ */
+void WordSenseProcessor::set_workers(size_t n)
+{
+	if (0 == n) n = std::thread::hardware_concurrency();
+	if (0 == n) n = 1;
+
+	stop_workers();
+	num_workers = n;
+	if (do_use_threads) start_workers();
+}
+
+void WordSenseProcessor::add_completion_callback(const Callback& cb)
+{
+	std::lock_guard<std::mutex> lck(queue_lock);
+	completion_callbacks.push_back(cb);
 }
 
 void WordSenseProcessor::run_wsd(void)
 {
-	do_use_threads = false;
+	use_threads(false);
 	run_no_delay();
 }
+
+/**
+ * The times and counts of the stages, so far, as an association list.
+ */
+std::string WordSenseProcessor::profile_string(void)
+{
+	return WSDProfile::instance().to_string();
+}
+
+void WordSenseProcessor::profile_reset(void)
+{
+	WSDProfile::instance().reset();
+}
+
+/**
+ * Write a JSON record of each sentence and document to the file, and
+ * turn profiling on; an empty path stops the writing.
+ */
+void WordSenseProcessor::profile_log(const std::string& path)
+{
+	WSDProfile::instance().set_log(path);
+}
+
+void WordSenseProcessor::profile_enable(bool on)
+{
+	WSDProfile::instance().set_enabled(on);
+}
+
 // ----------------------------------------
 
-void * WordSenseProcessor::thread_start(void *data)
+void WordSenseProcessor::start_workers(void)
+{
+	std::unique_lock<std::mutex> lck(queue_lock);
+	while (wsds.size() < num_workers)
+	{
+		Mihalcea *wsd = new Mihalcea();
+		wsd->set_atom_space(atom_space);
+		wsds.push_back(wsd);
+		idle_wsds.push_back(wsd);
+	}
+
+	stopping = false;
+	start_drains(lck);
+}
+
+/**
+ * The tasks finish the documents already queued, and then stop.
+ */
+void WordSenseProcessor::stop_workers(void)
 {
-	WordSenseProcessor *wsp = (WordSenseProcessor *) data;
-	wsp->work_thread();
-	return NULL;
+	std::unique_lock<std::mutex> lck(queue_lock);
+	stopping = true;
+	not_full.notify_all();
+
+	start_drains(lck);
+	drained.wait(lck, [this] { return 0 == active; });
+	stopping = false;
 }
 
-void WordSenseProcessor::work_thread(void)
+/**
+ * Queue tasks on the Executor to work through the queue, one for each
+ * idle Mihalcea, up to num_workers at once. This is called with the
+ * queue locked; the lock is let go while the tasks are queued.
+ */
+void WordSenseProcessor::start_drains(std::unique_lock<std::mutex>& lck)
 {
-	completion_handle = atom_space->add_node(ANCHOR_NODE, "#WSD_completed");
+	std::vector<Mihalcea *> starting;
+	while (active < num_workers and not work_queue.empty() and
+	       not idle_wsds.empty())
+	{
+		starting.push_back(idle_wsds.back());
+		idle_wsds.pop_back();
+		active++;
+	}
+	if (starting.empty()) return;
+
+	lck.unlock();
+	for (Mihalcea *wsd : starting)
+		Executor::instance().submit([this, wsd] { drain(wsd); });
+	lck.lock();
+}
 
-	while (1)
+void WordSenseProcessor::drain(Mihalcea *wsd)
+{
+	std::unique_lock<std::mutex> lck(queue_lock);
+	while (not work_queue.empty())
+	{
+		Job job(std::move(work_queue.front()));
+		work_queue.pop_front();
+		not_full.notify_one();
+		lck.unlock();
+
+		finish_document(wsd, job);
+		lck.lock();
+	}
+
+	idle_wsds.push_back(wsd);
+	if (0 == --active) drained.notify_all();
+}
+
+void WordSenseProcessor::finish_document(Mihalcea *wsd, const Job& job)
+{
+	wsd->process_document(job.doc);
+
+	// Mark this document as being completed.
+	atom_space->add_link(INHERITANCE_LINK, job.doc, completion_handle);
+
+	if (job.done) job.done(job.doc);
+
+	std::vector<Callback> cbs;
+	{
+		std::lock_guard<std::mutex> lck(queue_lock);
+		cbs = completion_callbacks;
+	}
+	for (const Callback& cb : cbs)
+		cb(job.doc);
+}
+
+/**
+ * Queue the job, if there is room for it.  This never waits, as it
+ * is called from the atom-added signal, in the thread adding atoms.
+ */
+bool WordSenseProcessor::try_queue(Job&& job)
+{
+	std::unique_lock<std::mutex> lck(queue_lock);
+	if (max_queue <= work_queue.size())
 	{
-		pthread_mutex_lock(&queue_lock);
-		if (work_queue.empty())
-		{
-			thread_running = false;
-			pthread_mutex_unlock(&queue_lock);
-			return;
-		}
-		Handle h = work_queue.front();
-		work_queue.pop();
-		pthread_mutex_unlock(&queue_lock);
-
-		wsd->process_document(h);
-
-		// Mark this document as being completed.
-		HandleSeq out;
-		out.push_back(h);
-		out.push_back(completion_handle);
-		atom_space->add_link(INHERITANCE_LINK, out);
+		overflow.push_back(std::move(job));
+		return false;
 	}
+	work_queue.push_back(std::move(job));
+	start_drains(lck);
+	return true;
 }
 
 // ----------------------------------------
 
+/**
+ * Whether the ReferenceLink from the document to its sentences, that
+ * Mihalcea::process_document() follows, is there.
+ */
+bool WordSenseProcessor::has_sentences(const Handle& h)
+{
+	for (const Handle& l : h->getIncomingSetByType(REFERENCE_LINK))
+		if (l->getOutgoingAtom(0) == h) return true;
+	return false;
+}
+
+void WordSenseProcessor::atom_added(const Handle& h)
+{
+	do_document(h, Callback());
+}
+
+/**
+ * Look for documents entered before the module was loaded, or while
+ * the workers were not running.
+ */
 void WordSenseProcessor::run_no_delay()
 {
-	// Look for recently entered text
 	HandleSet handle_set;
 	atom_space->get_handleset_by_type(handle_set, DOCUMENT_NODE);
 	for (const Handle& h: handle_set)
-		do_document(h);
+		do_document(h, Callback());
 }
 
+/**
+ * Queue the documents that did not fit into the queue when they came.
+ * There is no need to look through the atomspace; the new documents
+ * are signalled.
+ */
 void WordSenseProcessor::run()
 {
-	run_no_delay();
+	std::unique_lock<std::mutex> lck(queue_lock);
+	while (not overflow.empty() and work_queue.size() < max_queue)
+	{
+		work_queue.push_back(std::move(overflow.front()));
+		overflow.pop_front();
+	}
+	start_drains(lck);
+}
+
+void WordSenseProcessor::submit(const Handle& h, const Callback& done)
+{
+	atom_space->add_link(INHERITANCE_LINK, h, start_handle);
+
+	Job job{h, done};
+	if (not do_use_threads)
+	{
+		finish_document(wsds[0], job);
+		return;
+	}
 
-	// XXX we are being called too often. this needs to be fixed.
-	// in truth, should only poll on new input.
-	usleep(50*1000);
+	// Unlike the signalled documents, wait for room in the queue.
+	std::unique_lock<std::mutex> lck(queue_lock);
+	not_full.wait(lck, [this] { return stopping or work_queue.size() < max_queue; });
+	work_queue.push_back(std::move(job));
+	start_drains(lck);
 }
 
 /**
@@ -128,51 +333,38 @@ void WordSenseProcessor::run()
  * connected ideas.  The sentences composing the document are handled
  * in order.
  */
-bool WordSenseProcessor::do_document(const Handle& h)
+bool WordSenseProcessor::do_document(const Handle& h, const Callback& done)
 {
-	// Obtain the handle which indicates that the WSD processing of a
- 	// document has started.
-	start_handle = atom_space->add_node(ANCHOR_NODE, "#WSD_started");
-
 	// Look to see if the document is associated with the
 	// start indicator.
-	bool rc = foreach_binary_link(h, INHERITANCE_LINK, &WordSenseProcessor::check_start, this);
+	if (atom_space->get_link(INHERITANCE_LINK, h, start_handle))
+		return false;
 
-	if (rc) return false;
+	// A document with no sentences yet is not marked, so that it is
+	// picked up once they are linked to it.
+	if (not has_sentences(h))
+		return false;
 
 	// If we are here, then there's a fresh document to work on.
-	cnt++;
-	printf ("WordSenseProcessor found document %d handle=%lx\n", cnt, h.value());
-
-	// Mark this document as being started.
-	HandleSeq out;
-	out.push_back(h);
-	out.push_back(start_handle);
-	atom_space->add_link(INHERITANCE_LINK, out);
-
-	// Now queue the document for actual processing.
-	pthread_mutex_lock(&queue_lock);
-	work_queue.push(h);
-
-	if (do_use_threads && (false == thread_running))
 	{
-		thread_running = true;
-		pthread_create (&worker, NULL, &WordSenseProcessor::thread_start, this);
+		std::lock_guard<std::mutex> lck(cnt_lock);
+		cnt++;
+		printf ("WordSenseProcessor found document %d handle=%lx\n", cnt, h.value());
 	}
 
-	pthread_mutex_unlock(&queue_lock);
+	// Mark this document as being started.
+	atom_space->add_link(INHERITANCE_LINK, h, start_handle);
 
 	// If not using threads, then process it now.
-	if (false == do_use_threads)
+	Job job{h, done};
+	if (not do_use_threads)
 	{
-		work_thread();
+		finish_document(wsds[0], job);
+		return false;
 	}
-	return false;
-}
 
-bool WordSenseProcessor::check_start(const Handle& h)
-{
-	if (h == start_handle) return true;
+	// Now queue the document for actual processing.
+	try_queue(std::move(job));
 	return false;
 }
 
@@ -2,8 +2,8 @@
  * WordSenseProcessor.h
  *
  * Main entry point for word-sense disambiguation. This class inherits
- * from Module; it scans for new input sentences, and then invokes
- * the disambiguation algorithms on it.
+ * from Module; it picks up new input documents, and then invokes
+ * the disambiguation algorithms on them.
  *
  * Copyright (c) 2008 Linas Vepstas <linas@linas.org>
  */
@@ -11,37 +11,80 @@
 #ifndef _OPENCOG_WORD_SENSE_PROCESSOR_H
 #define _OPENCOG_WORD_SENSE_PROCESSOR_H
 
-#include <pthread.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include <opencog/nlp/wsd/Mihalcea.h>
 #include <opencog/cogserver/server/CogServer.h>
 #include <opencog/cogserver/server/Module.h>
 
 namespace opencog {
 
+/**
+ * New documents are picked up once they are complete, i.e. when the
+ * ReferenceLink from the DocumentNode to its list of sentences is
+ * added to the atomspace, and queued; up to num_workers tasks on the
+ * Executor work through the queue, each with a Mihalcea of its own.
+ * The queue is bounded; documents that do not fit are kept aside, and
+ * queued by run() once there is room.
+ */
 class WordSenseProcessor : public Module
 {
+	public:
+		typedef std::function<void(const Handle&)> Callback;
+
 	private:
+		struct Job
+		{
+			Handle doc;
+			Callback done;
+		};
 
 		bool do_use_threads;
-		pthread_t worker;
-		static void * thread_start(void *);
-		std::queue<Handle> work_queue;
-		pthread_mutex_t queue_lock;
-		bool thread_running;
-		void work_thread(void);
+		size_t num_workers;
+		size_t max_queue;
+		std::vector<Mihalcea *> wsds;
+		std::vector<Mihalcea *> idle_wsds;   // those no task has
+		size_t active;                       // the tasks working
+		void drain(Mihalcea *);
+		void start_drains(std::unique_lock<std::mutex>&);
+		void start_workers(void);
+		void stop_workers(void);
+
+		std::mutex queue_lock;
+		std::condition_variable not_full;
+		std::condition_variable drained;
+		std::deque<Job> work_queue;
+		std::deque<Job> overflow;
+		bool stopping;
+		bool try_queue(Job&&);
 
+		int add_conn;
+		void atom_added(const Handle&);
+		static bool has_sentences(const Handle&);
+
+		std::mutex cnt_lock;
 		int cnt;
 		AtomSpace *atom_space;
-		bool do_document(const Handle& h);
+		bool do_document(const Handle& h, const Callback&);
+		void finish_document(Mihalcea *, const Job&);
 
 		Handle start_handle;
 		Handle completion_handle;
-		bool check_start(const Handle& h);
-
-		Mihalcea *wsd;
+		std::vector<Callback> completion_callbacks;
 
 		void run_wsd(void);
 
+		// The scheme interface to the WSDProfile.
+		std::string profile_string(void);
+		void profile_reset(void);
+		void profile_log(const std::string&);
+		void profile_enable(bool);
+
 	public:
 
 		WordSenseProcessor(CogServer&);
@@ -51,6 +94,14 @@ class WordSenseProcessor : public Module
 		virtual void run();
 		virtual void run_no_delay();
 		void use_threads(bool);
+		void set_workers(size_t);
+
+		/// Disambiguate the document, whether or not it was seen
+		/// before, and call the callback, if any, once it is done.
+		void submit(const Handle&, const Callback& = Callback());
+
+		/// Call the callback for every document done.
+		void add_completion_callback(const Callback&);
 };
 
 } // namespace opencog
@@ -0,0 +1,291 @@
+/*
+ * OpenPsiDynamics.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include <opencog/atoms/core/NumberNode.h>
+#include <opencog/util/RandGen.h>
+#include <opencog/util/exceptions.h>
+
+#include "OpenPsiDynamics.h"
+#include "PerAtomSpace.h"
+
+using namespace opencog;
+
+// The parameters of the same names in updater.scm
+static const double dynamics_sensitivity = 1.0;
+static const double psi_max_strength_multiplier = 5.0;
+static const double decay_factor = 1.0 - 0.001;
+static const double slope = 10000.0;
+
+static const double no_value = std::numeric_limits<double>::quiet_NaN();
+
+OpenPsiDynamics::OpenPsiDynamics(AtomSpace* as) :
+  _as(as), _loop_count(0), _running(false)
+{
+}
+
+OpenPsiDynamics::~OpenPsiDynamics()
+{
+  halt();
+}
+
+size_t OpenPsiDynamics::index(const Handle& var)
+{
+  auto it = _index.find(var);
+  if (it != _index.end()) return it->second;
+
+  size_t i = _vars.size();
+  double value = read(var);
+  _index[var] = i;
+  _vars.push_back(var);
+  _values.push_back(value);
+  _previous.push_back(value);
+  _at_start.push_back(value);
+  _baselines.push_back(no_value);
+  _is_event.push_back(false);
+  return i;
+}
+
+void OpenPsiDynamics::add_variable(const Handle& var, double baseline)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  size_t i = index(var);
+  if (std::isnan(_baselines[i])) _decaying.push_back(i);
+  _baselines[i] = baseline;
+}
+
+void OpenPsiDynamics::add_event(const Handle& event)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  size_t i = index(event);
+  _is_event[i] = true;
+  _previous[i] = 0.0;
+}
+
+void OpenPsiDynamics::add_rule(const Handle& trigger, const Handle& change,
+  const Handle& target, double strength)
+{
+  Change c;
+  const std::string& name = change->get_name();
+  if ("psi-changed" == name) c = CHANGED;
+  else if ("psi-increased" == name) c = INCREASED;
+  else if ("psi-decreased" == name) c = DECREASED;
+  else
+    throw InvalidParamException(TRACE_INFO,
+      "Expecting psi-changed, psi-increased or psi-decreased, got %s",
+      change->to_short_string().c_str());
+
+  // Map the strength to a multiplier, so that .5 is 1 and 1 is the
+  // maximum, as adjust-psi-var-level does.
+  strength = std::max(std::min(strength, 1.0), -1.0);
+  double multiplier = (strength <= 0.5) ? 2 * strength :
+    (2 * psi_max_strength_multiplier - 2) * strength + 2
+      - psi_max_strength_multiplier;
+
+  std::lock_guard<std::mutex> lck(_mtx);
+  _rules.push_back({index(trigger), c, index(target), multiplier});
+}
+
+void OpenPsiDynamics::add_rhythm(const Handle& var, double amplitude,
+  double frequency, double offset)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  _rhythms.push_back({index(var), amplitude, frequency, offset});
+}
+
+void OpenPsiDynamics::add_noise(const Handle& var, double width)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  _noises.push_back({index(var), width});
+}
+
+void OpenPsiDynamics::clear()
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  _loop_count = 0;
+  _vars.clear();
+  _index.clear();
+  _values.clear();
+  _previous.clear();
+  _at_start.clear();
+  _baselines.clear();
+  _is_event.clear();
+  _decaying.clear();
+  _rules.clear();
+  _rhythms.clear();
+  _noises.clear();
+}
+
+double OpenPsiDynamics::read(const Handle& var)
+{
+  // The value is held as (State var (Number value)).
+  for (const Handle& link : var->getIncomingSetByType(STATE_LINK)) {
+    if (link->getOutgoingAtom(0) != var) continue;
+    const Handle& value = link->getOutgoingAtom(1);
+    if (NUMBER_NODE != value->get_type()) return no_value;
+    return NumberNodeCast(value)->get_value();
+  }
+  return no_value;
+}
+
+void OpenPsiDynamics::write(const Handle& var, double value)
+{
+  _as->add_link(STATE_LINK, var, _as->add_atom(createNumberNode(value)));
+}
+
+double OpenPsiDynamics::adjust(double value, double trigger_change,
+  double multiplier)
+{
+  if (std::isnan(value)) value = 0.5;
+
+  double alpha = trigger_change * multiplier * dynamics_sensitivity;
+  alpha = std::max(std::min(alpha, 1.0), -1.0);
+
+  // The curve is not quite right at the ends.
+  if (alpha > 0)
+    value = std::max(value, (alpha >= 0.5) ? 0.2 : 0.1);
+  else if (alpha < 0)
+    value = std::min(value, (alpha <= -0.5) ? 0.8 : 0.9);
+  else
+    return value;
+
+  // (slope^(a*x) - 1) / (slope^a - 1), where a is negative for
+  // increases.
+  alpha = -alpha;
+  return (std::pow(slope, alpha * value) - 1) / (std::pow(slope, alpha) - 1);
+}
+
+unsigned OpenPsiDynamics::step()
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  _loop_count++;
+
+  const size_t n = _vars.size();
+  for (size_t i = 0; i < n; i++)
+    _values[i] = _at_start[i] = read(_vars[i]);
+
+  // The direction each variable changed in since the last step it
+  // changed in. A variable that had no value is taken not to change,
+  // the first time it has one.
+  std::vector<signed char> direction(n, 0);
+  for (size_t i = 0; i < n; i++) {
+    if (std::isnan(_previous[i])) {
+      _previous[i] = _values[i];
+      continue;
+    }
+    if (std::isnan(_values[i]) or _values[i] == _previous[i]) continue;
+    direction[i] = (_values[i] > _previous[i]) ? 1 : -1;
+  }
+
+  // The rules read the change of the trigger as it was at the start of
+  // the step, and the target as the rules before them left it.
+  for (const Rule& r : _rules) {
+    signed char d = direction[r.trigger];
+    if (0 == d) continue;
+    if ((INCREASED == r.change and d < 0) or (DECREASED == r.change and d > 0))
+      continue;
+
+    double change = _is_event[r.trigger] ? 0.5 :
+      _at_start[r.trigger] - _previous[r.trigger];
+    _values[r.target] = adjust(_values[r.target], change, r.multiplier);
+  }
+
+  for (const Rhythm& r : _rhythms) {
+    double& v = _values[r.var];
+    if (std::isnan(v)) continue;
+    v += r.amplitude * r.frequency *
+      std::cos(r.frequency * (_loop_count + r.offset));
+    v = std::max(std::min(v, 1.0), 0.0);
+  }
+
+  for (const Noise& r : _noises) {
+    double& v = _values[r.var];
+    if (std::isnan(v)) continue;
+    v += r.width * randGen().randdouble() - r.width / 2;
+    v = std::max(std::min(v, 1.0), 0.0);
+  }
+
+  for (size_t i : _decaying) {
+    if (std::isnan(_values[i])) continue;
+    _values[i] = _baselines[i] + decay_factor * (_values[i] - _baselines[i]);
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    if (0 != direction[i]) _previous[i] = _at_start[i];
+
+    // Each occurrence of an event fires the rules once.
+    if (_is_event[i] and not std::isnan(_at_start[i]) and 0 != _at_start[i]) {
+      _values[i] = 0.0;
+      _previous[i] = 0.0;
+    }
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    if (std::isnan(_values[i]) or _values[i] == _at_start[i]) continue;
+    write(_vars[i], _values[i]);
+  }
+
+  return _loop_count;
+}
+
+void OpenPsiDynamics::run(unsigned period)
+{
+  if (_running.exchange(true)) return;
+  if (_loop.joinable()) _loop.join();
+
+  _loop = std::thread([this, period]() {
+    while (_running) {
+      step();
+      std::this_thread::sleep_for(std::chrono::milliseconds(period));
+    }
+  });
+}
+
+void OpenPsiDynamics::halt()
+{
+  _running = false;
+  if (_loop.joinable() and _loop.get_id() != std::this_thread::get_id())
+    _loop.join();
+}
+
+bool OpenPsiDynamics::is_running() const
+{
+  return _running;
+}
+
+static PerAtomSpace<OpenPsiDynamics>& openpsi_dynamics_instances()
+{
+  static PerAtomSpace<OpenPsiDynamics> instances;
+  return instances;
+}
+
+OpenPsiDynamics& opencog::openpsi_dynamics(AtomSpace* as)
+{
+  return openpsi_dynamics_instances().get(as);
+}
+
+void opencog::openpsi_dynamics_release(AtomSpace* as)
+{
+  openpsi_dynamics_instances().release(as);
+}
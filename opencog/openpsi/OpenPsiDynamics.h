@@ -0,0 +1,165 @@
+/*
+ * OpenPsiDynamics.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_OPENPSI_DYNAMICS_H
+#define _OPENCOG_OPENPSI_DYNAMICS_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+
+/**
+ * The updater of openpsi/dynamics/updater.scm, for the interaction
+ * rules, rhythms and noise that it knows the form of. The variables are
+ * registered once; on each step their values are read from their
+ * StateLinks into an array, all the rules are applied to the array, the
+ * modulators decay toward their baselines, and the values that changed
+ * are written back.
+ *
+ * The event detection, the expression callback and any other kind of
+ * rule are left to updater.scm, which calls step() when all the rules
+ * it has are of the kinds here.
+ */
+class OpenPsiDynamics
+{
+public:
+  // As (Predicate "psi-changed"), "psi-increased" and "psi-decreased"
+  enum Change { CHANGED, INCREASED, DECREASED };
+
+  OpenPsiDynamics(AtomSpace* as);
+  ~OpenPsiDynamics();
+
+  /**
+   * Register a modulator or an SEC, that decays toward its baseline
+   * on each step.
+   */
+  void add_variable(const Handle& var, double baseline);
+
+  /**
+   * Register a monitored event. Its value is set to 1 when it occurs,
+   * and back to 0 by the step after; a rule triggered by it changes
+   * its target as though the event changed by 0.5.
+   */
+  void add_event(const Handle& event);
+
+  /**
+   * Add the rule made by psi-create-interaction-rule. The trigger and
+   * the target are registered if they aren't yet; they don't decay.
+   *
+   * @param change One of the psi-changed, psi-increased or
+   *  psi-decreased PredicateNodes.
+   */
+  void add_rule(const Handle& trigger, const Handle& change,
+    const Handle& target, double strength);
+
+  /**
+   * Add the rules of psi-ultradian-update and psi-noise-update.
+   */
+  void add_rhythm(const Handle& var, double amplitude, double frequency,
+    double offset);
+  void add_noise(const Handle& var, double width);
+
+  // Forget all that was registered.
+  void clear();
+
+  /**
+   * Apply all the rules once. Returns the number of steps done.
+   */
+  unsigned step();
+
+  /**
+   * Call step() every period milliseconds in a thread of its own,
+   * until halt() is called.
+   */
+  void run(unsigned period);
+  void halt();
+  bool is_running() const;
+
+private:
+  struct Rule
+  {
+    size_t trigger;
+    Change change;
+    size_t target;
+    double multiplier;
+  };
+
+  struct Rhythm
+  {
+    size_t var;
+    double amplitude;
+    double frequency;
+    double offset;
+  };
+
+  struct Noise
+  {
+    size_t var;
+    double width;
+  };
+
+  size_t index(const Handle& var);
+  double read(const Handle& var);
+  void write(const Handle& var, double value);
+
+  // The change of the target made by a rule, as adjust-psi-var-level
+  double adjust(double value, double trigger_change, double multiplier);
+
+  AtomSpace* _as;
+
+  std::mutex _mtx;
+  unsigned _loop_count;
+
+  // The variables, and their values; NaN is for no value.
+  HandleSeq _vars;
+  std::unordered_map<Handle, size_t> _index;
+  std::vector<double> _values;
+  std::vector<double> _previous;
+  std::vector<double> _at_start;
+  std::vector<double> _baselines;
+  std::vector<char> _is_event;
+
+  // The variables that decay; a subset of _vars.
+  std::vector<size_t> _decaying;
+
+  std::vector<Rule> _rules;
+  std::vector<Rhythm> _rhythms;
+  std::vector<Noise> _noises;
+
+  std::atomic<bool> _running;
+  std::thread _loop;
+};
+
+// These are used to get the instance for the AtomSpace, and to delete
+// it, which has to be done before the AtomSpace is deleted.
+OpenPsiDynamics& openpsi_dynamics(AtomSpace* as);
+void openpsi_dynamics_release(AtomSpace* as);
+
+} // namespace opencog
+
+#endif // _OPENCOG_OPENPSI_DYNAMICS_H
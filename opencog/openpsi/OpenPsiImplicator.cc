@@ -19,69 +19,361 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/execution/Instantiator.h>
+#include <opencog/executor/Executor.h>
+#include <opencog/tracing/Tracer.h>
+#include <opencog/util/exceptions.h>
 
 #include "OpenPsiImplicator.h"
 #include "OpenPsiSatisfier.h"
 #include "OpenPsiRules.h"
+#include "PerAtomSpace.h"
 
 using namespace opencog;
 
-OpenPsiImplicator::OpenPsiImplicator(AtomSpace* as)
+OpenPsiImplicator::OpenPsiImplicator(AtomSpace* as) :
+  _epoch(0), _num_searches(0)
 {
   _as = as;
   _action_executed = _as->add_node(PREDICATE_NODE, "action-executed");
+
+  _add_conn = _as->atomAddedSignal().connect(
+    [this](const Handle& h) { changed(h); });
+  _remove_conn = _as->atomRemovedSignal().connect(
+    [this](const AtomPtr& a) { changed(Handle(a)); });
+  _tv_conn = _as->TVChangedSignal().connect(
+    [this](const Handle& h, const TruthValuePtr&, const TruthValuePtr&)
+    { changed(h); });
 }
 
-TruthValuePtr OpenPsiImplicator::check_satisfiability(const Handle& rule,
-    OpenPsiRules& opr)
+OpenPsiImplicator::~OpenPsiImplicator()
+{
+  _as->atomAddedSignal().disconnect(_add_conn);
+  _as->atomRemovedSignal().disconnect(_remove_conn);
+  _as->TVChangedSignal().disconnect(_tv_conn);
+}
+
+/**
+ * Nodes only matter as constants of contexts; a node being added or
+ * removed can't change a grounding without a link of it being added or
+ * removed too.
+ */
+void OpenPsiImplicator::changed(const Handle& h)
+{
+  std::lock_guard<std::mutex> lck(_epoch_mtx);
+  if (h->is_link()) {
+    _type_epoch[h->get_type()] = ++_epoch;
+    return;
+  }
+
+  auto it = _constant_epoch.find(h);
+  if (it != _constant_epoch.end()) it->second = ++_epoch;
+}
+
+static bool is_evaluatable(Type t)
+{
+  return GROUNDED_PREDICATE_NODE == t or GROUNDED_SCHEMA_NODE == t or
+    DEFINED_PREDICATE_NODE == t or DEFINED_SCHEMA_NODE == t or
+    nameserver().isA(t, VIRTUAL_LINK);
+}
+
+OpenPsiImplicator::Dependencies
+OpenPsiImplicator::find_dependencies(const Handle& body)
+{
+  Dependencies deps;
+  deps.is_volatile = false;
+  deps.checked = 0;
+  deps.generation = 0;
+
+  // A clause that is a lone variable may be grounded by anything.
+  if (nameserver().isA(body->get_type(), VARIABLE_NODE))
+    deps.is_volatile = true;
+  if (body->is_link())
+    for (const Handle& clause : body->getOutgoingSet())
+      if (nameserver().isA(clause->get_type(), VARIABLE_NODE))
+        deps.is_volatile = true;
+
+  HandleSeq todo({body});
+  while (not todo.empty()) {
+    Handle h(todo.back());
+    todo.pop_back();
+
+    Type t = h->get_type();
+    if (is_evaluatable(t)) deps.is_volatile = true;
+
+    if (h->is_link()) {
+      deps.link_types.insert(t);
+      for (const Handle& out : h->getOutgoingSet())
+        todo.push_back(out);
+    } else if (not nameserver().isA(t, VARIABLE_NODE) and
+               not nameserver().isA(t, GLOB_NODE)) {
+      deps.constants.insert(h);
+    }
+  }
+
+  std::lock_guard<std::mutex> lck(_epoch_mtx);
+  for (const Handle& c : deps.constants)
+    _constant_epoch.emplace(c, 0);
+
+  return deps;
+}
+
+bool OpenPsiImplicator::is_stale(const Dependencies& deps)
+{
+  if (deps.is_volatile) return true;
+
+  std::lock_guard<std::mutex> lck(_epoch_mtx);
+  for (Type t : deps.link_types) {
+    auto it = _type_epoch.find(t);
+    if (it != _type_epoch.end() and deps.checked < it->second) return true;
+  }
+  for (const Handle& c : deps.constants) {
+    auto it = _constant_epoch.find(c);
+    if (it != _constant_epoch.end() and deps.checked < it->second) return true;
+  }
+  return false;
+}
+
+bool OpenPsiImplicator::start_search(const Handle& query_body,
+                                     unsigned long& generation)
 {
-  // TODO:
-  // Solve for multithreaded access. Create a rule class and lock
-  // the rule when updating the cache.
+  std::lock_guard<std::mutex> lck(_cache_mtx);
 
-  PatternLinkPtr query = opr.get_query(rule);
-  Handle query_body = query->get_pattern().body;
+  auto dit = _dependencies.find(query_body);
+  if (dit == _dependencies.end())
+    dit = _dependencies.emplace(query_body,
+                                find_dependencies(query_body)).first;
+  Dependencies& deps = dit->second;
 
-  // Always update cache to clear any previous result.
+  // Search again only if something it depends on has changed since the
+  // last search; else the cache has the result already. Changes made
+  // during the search, e.g. by GroundedPredicates, count as made after
+  // it, so that the next check searches again.
   // TODO: Add cache per atomspace.
+  if (_pattern_seen.count(query_body) and not is_stale(deps))
+    return false;
+
+  {
+    std::lock_guard<std::mutex> elck(_epoch_mtx);
+    deps.checked = _epoch;
+  }
+
+  // Update cache to clear any previous result.
   _satisfiability_cache.erase(query_body);
   _pattern_seen.insert(query_body);
+  _num_searches++;
+  generation = ++deps.generation;
+  return true;
+}
 
-  OpenPsiSatisfier sater(_as, this);
+void OpenPsiImplicator::search(const PatternLinkPtr& query,
+                               unsigned long generation)
+{
+  OpenPsiSatisfier sater(_as, this, generation);
   sater.satisfy(query);
+}
+
+bool OpenPsiImplicator::is_cached(const Handle& query_body)
+{
+  std::lock_guard<std::mutex> lck(_cache_mtx);
+  return _satisfiability_cache.find(query_body) !=
+    _satisfiability_cache.end();
+}
 
-  // The boolean returned by query->satisfy isn't used because all
-  // type of contexts haven't been handled by this callback yet.
-  if (_satisfiability_cache.find(query_body) != _satisfiability_cache.end()) {
+/**
+ * Two threads checking rules that share a context may both search it,
+ * the one that started first finishing last; the groundings it found
+ * would then replace those of the later search.
+ */
+void OpenPsiImplicator::cache_grounding(const Handle& query_body,
+  const HandleMap& groundings, unsigned long generation)
+{
+  std::lock_guard<std::mutex> lck(_cache_mtx);
+  auto dit = _dependencies.find(query_body);
+  if (dit != _dependencies.end() and dit->second.generation != generation)
+    return;
+  _satisfiability_cache[query_body] = groundings;
+}
+
+const std::vector<PatternLinkPtr>&
+OpenPsiImplicator::get_components(const Handle& rule, OpenPsiRules& opr)
+{
+  const std::vector<PatternLinkPtr>& queries = opr.get_components(rule);
+  if (queries.empty())
+    throw InvalidParamException(TRACE_INFO,
+      "Not an openpsi rule: %s", rule->to_string().c_str());
+  return queries;
+}
+
+TruthValuePtr OpenPsiImplicator::check_satisfiability(const Handle& rule,
+    OpenPsiRules& opr)
+{
+  TraceSpan span("psi-check-satisfiability", "openpsi");
+  bool profiling = _profiler.is_enabled();
+  OpenPsiProfiler::Clock::time_point start;
+  if (profiling) start = OpenPsiProfiler::Clock::now();
+
+  // The rule is satisfiable if each part of its context is. All of the
+  // parts are checked, so that imply() knows they have been.
+  bool satisfiable = true;
+  for (const PatternLinkPtr& query : get_components(rule, opr)) {
+    Handle query_body = query->get_pattern().body;
+
+    unsigned long generation;
+    if (start_search(query_body, generation)) search(query, generation);
+
+    // The boolean returned by query->satisfy isn't used because all
+    // type of contexts haven't been handled by this callback yet.
+    if (not is_cached(query_body)) satisfiable = false;
+  }
+
+  if (profiling)
+    _profiler.record_check(rule, satisfiable, OpenPsiProfiler::since(start));
+  span.arg("satisfiable", satisfiable);
+
+  if (satisfiable) {
     return TruthValue::TRUE_TV();
   } else {
     return TruthValue::FALSE_TV();
   }
 }
 
-Handle OpenPsiImplicator::imply(const Handle& rule, OpenPsiRules& opr)
+std::vector<TruthValuePtr> OpenPsiImplicator::check_satisfiability(
+  const HandleSeq& rules, OpenPsiRules& opr, unsigned num_threads)
 {
-  PatternLinkPtr query = opr.get_query(rule);
-  Handle query_body = query->get_pattern().body;
+  TraceSpan span("psi-check-satisfiability", "openpsi");
+  span.arg("rules", rules.size());
+
+  // The rules are looked up here, as OpenPsiRules isn't safe to use
+  // from many threads; and the parts of contexts shared by several
+  // rules are only searched once.
+  std::vector<Handle> bodies;
+  std::vector<PatternLinkPtr> queries;
+  std::unordered_map<Handle, size_t> body_index;
+  std::vector<std::vector<size_t>> slots;
+  for (const Handle& rule : rules) {
+    slots.emplace_back();
+    for (const PatternLinkPtr& query : get_components(rule, opr)) {
+      const Handle& body = query->get_pattern().body;
+      if (body_index.emplace(body, bodies.size()).second) {
+        bodies.push_back(body);
+        queries.push_back(query);
+      }
+      slots.back().push_back(body_index[body]);
+    }
+  }
+
+  std::vector<size_t> todo;
+  std::vector<unsigned long> generations(bodies.size(), 0);
+  for (size_t i = 0; i < bodies.size(); i++)
+    if (start_search(bodies[i], generations[i])) todo.push_back(i);
+
+  if (0 == num_threads) num_threads = std::thread::hardware_concurrency();
+  num_threads = std::max(1u, std::min(num_threads, (unsigned) todo.size()));
+  span.arg("searches", todo.size()).arg("threads", num_threads);
 
-  if (_pattern_seen.find(query_body) == _pattern_seen.end())
+  // The time each context took to search, when profiling.
+  bool profiling = _profiler.is_enabled();
+  std::vector<double> search_time(profiling ? bodies.size() : 0, 0.0);
+
+  // Each thread takes the next context to search until none is left.
+  // A failed search is passed on to the caller once all are done.
+  std::atomic<size_t> next(0);
+  std::mutex err_mtx;
+  std::exception_ptr err;
+  auto work = [&]()
+  {
+    for (size_t i = next++; i < todo.size(); i = next++) {
+      TraceSpan search_span("psi-search", "openpsi");
+      try {
+        if (profiling) {
+          OpenPsiProfiler::Clock::time_point start =
+            OpenPsiProfiler::Clock::now();
+          search(queries[todo[i]], generations[todo[i]]);
+          search_time[todo[i]] = OpenPsiProfiler::since(start);
+        } else {
+          search(queries[todo[i]], generations[todo[i]]);
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lck(err_mtx);
+        if (not err) err = std::current_exception();
+      }
+    }
+  };
+
+  Executor::instance().parallel_for(num_threads,
+    [&](size_t) { work(); }, num_threads);
+  if (err) std::rethrow_exception(err);
+
+  std::vector<bool> found;
+  for (const Handle& body : bodies)
+    found.push_back(is_cached(body));
+
+  std::vector<TruthValuePtr> results;
+  for (size_t r = 0; r < rules.size(); r++) {
+    const std::vector<size_t>& rule_slots = slots[r];
+    bool satisfiable = std::all_of(rule_slots.begin(), rule_slots.end(),
+      [&](size_t slot) { return found[slot]; });
+    results.push_back(satisfiable ?
+      TruthValue::TRUE_TV() : TruthValue::FALSE_TV());
+
+    if (profiling) {
+      double secs = 0.0;
+      for (size_t slot : rule_slots) secs += search_time[slot];
+      _profiler.record_check(rules[r], satisfiable, secs);
+    }
+  }
+  return results;
+}
+
+Handle OpenPsiImplicator::imply(const Handle& rule, OpenPsiRules& opr)
+{
+  // The groundings of the parts of the context, which share no
+  // variables, are put together. They are copied, so that the lock
+  // isn't held while instantiating.
+  bool found = true;
+  HandleMap groundings;
   {
-    throw RuntimeException(TRACE_INFO, "The openpsi rule should be checked "
-      "for satisfiablity first." );
+    std::lock_guard<std::mutex> lck(_cache_mtx);
+    for (const PatternLinkPtr& query : get_components(rule, opr)) {
+      Handle query_body = query->get_pattern().body;
+      if (_pattern_seen.find(query_body) == _pattern_seen.end())
+      {
+        throw RuntimeException(TRACE_INFO, "The openpsi rule should be "
+          "checked for satisfiablity first." );
+      }
+
+      auto it = _satisfiability_cache.find(query_body);
+      if (it != _satisfiability_cache.end())
+        groundings.insert(it->second.begin(), it->second.end());
+      else
+        found = false;
+    }
   }
 
-  auto it = _satisfiability_cache.find(query_body);
-  if (it != _satisfiability_cache.end())
+  if (found)
   {
+    TraceSpan span("psi-imply", "openpsi");
+    bool profiling = _profiler.is_enabled();
+    OpenPsiProfiler::Clock::time_point start;
+    if (profiling) start = OpenPsiProfiler::Clock::now();
+
     Instantiator inst(_as);
 
     Handle result =
-      HandleCast(inst.instantiate(opr.get_action(rule), it->second, true));
+      HandleCast(inst.instantiate(opr.get_action(rule), groundings, true));
     rule->setValue(_action_executed, ValueCast(TruthValue::TRUE_TV()));
 
+    if (profiling)
+      _profiler.record_imply(rule, OpenPsiProfiler::since(start));
+
     return result;
   } else {
     // NOTE: Trying to check for satisfiablity isn't done because it
@@ -97,8 +389,18 @@ TruthValuePtr OpenPsiImplicator::was_action_executed(const Handle rule)
   return TruthValueCast(rule->getValue(_action_executed));
 }
 
+static PerAtomSpace<OpenPsiImplicator>& openpsi_implicators()
+{
+  static PerAtomSpace<OpenPsiImplicator> instances;
+  return instances;
+}
+
 OpenPsiImplicator& opencog::openpsi_implicator(AtomSpace* as)
 {
-  static OpenPsiImplicator implicator(as);
-  return implicator;
+  return openpsi_implicators().get(as);
+}
+
+void opencog::openpsi_implicator_release(AtomSpace* as)
+{
+  openpsi_implicators().release(as);
 }
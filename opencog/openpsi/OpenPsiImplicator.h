@@ -23,8 +23,14 @@
 #ifndef _OPENCOG_OPENPSI_IMPLICATOR_H
 #define _OPENCOG_OPENPSI_IMPLICATOR_H
 
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <unordered_set>
+
 #include <opencog/atoms/pattern/PatternLink.h>
 #include <opencog/atomspace/AtomSpace.h>
+#include <opencog/openpsi/OpenPsiProfiler.h>
 #include <opencog/openpsi/OpenPsiRules.h>
 #include <opencog/openpsi/OpenPsiSatisfier.h>
 
@@ -46,15 +52,35 @@ class OpenPsiImplicator
 
 public:
   OpenPsiImplicator(AtomSpace* as);
+  ~OpenPsiImplicator();
 
   /**
    * Returns TRUE_TV if there is grounding else returns FALSE_TV. If the
-   * cache has entry for the context then TRUE_TV is returned.
+   * cache has entry for the context then TRUE_TV is returned. A context
+   * made of parts that share no variables is satisfiable if each part
+   * is; see OpenPsiRules::get_components.
+   *
+   * The context is only searched again if the atomspace has changed in
+   * a way that may change the result since it was last searched; else
+   * the last result is returned. See Dependencies.
    *
    * @param rule An openpsi rule.
    */
   TruthValuePtr check_satisfiability(const Handle& rule, OpenPsiRules& opr);
 
+  /**
+   * The same as check_satisfiability, for many rules at once. The
+   * contexts that need searching are searched concurrently, each only
+   * once however many of the rules share it.
+   *
+   * @param rules Openpsi rules.
+   * @param num_threads The most threads to search with; 0 for one per
+   *  core.
+   * @return The result for each rule, in the same order.
+   */
+  std::vector<TruthValuePtr> check_satisfiability(const HandleSeq& rules,
+    OpenPsiRules& opr, unsigned num_threads = 0);
+
   /**
    * Instantiate the action of the given openpsi rule.
    *
@@ -73,7 +99,22 @@ public:
    */
   TruthValuePtr was_action_executed(const Handle rule);
 
+  /**
+   * What check_satisfiability and imply spent on each rule, when
+   * enabled.
+   */
+  OpenPsiProfiler& profiler() { return _profiler; }
+
 private:
+  OpenPsiProfiler _profiler;
+
+  /**
+   * Guards _satisfiability_cache, _pattern_seen, _dependencies and
+   * _num_searches, which may be used by several searches at once. It is
+   * not held while searching.
+   */
+  std::mutex _cache_mtx;
+
   /**
    * Cache used to store context with the variable groundings. Values
    * are not used to associate the variable groundings(the HandleMap) with
@@ -96,10 +137,77 @@ private:
   // Predicate used to set a value on whether an action was executed or not
   Handle _action_executed;
 
+  /**
+   * What the result of searching for a context depends on. A grounding
+   * can only come or go with a link of one of the types of the links in
+   * the context, being added, removed, or having its TV changed; and
+   * the TV of the nodes in the context may matter too. Contexts with
+   * evaluatable or executable terms, such as GroundedPredicateNodes,
+   * may depend on anything, and are searched every time.
+   */
+  struct Dependencies
+  {
+    std::unordered_set<Type> link_types;
+    HandleSet constants;
+    bool is_volatile;
+
+    // The _epoch at which the context was last searched.
+    unsigned long checked;
+
+    // Counts the searches started; only the groundings of the latest
+    // one are cached, see cache_grounding.
+    unsigned long generation;
+  };
+  std::unordered_map<Handle, Dependencies> _dependencies;
+  Dependencies find_dependencies(const Handle& body);
+  bool is_stale(const Dependencies& deps);
+
+  /**
+   * Returns true, having cleared the cached result, if the context has
+   * to be searched; search() then does it, with the generation set
+   * here, and the result is read with is_cached().
+   */
+  bool start_search(const Handle& query_body, unsigned long& generation);
+
+  // The queries of the parts of the context of the rule; see
+  // OpenPsiRules::get_components.
+  const std::vector<PatternLinkPtr>& get_components(const Handle& rule,
+    OpenPsiRules& opr);
+  void search(const PatternLinkPtr& query, unsigned long generation);
+  bool is_cached(const Handle& query_body);
+
+  // Called by OpenPsiSatisfier for the grounding found by the search of
+  // the given generation. It is dropped if another search of the same
+  // context has started since, as it may be out of date.
+  void cache_grounding(const Handle& query_body, const HandleMap& groundings,
+                       unsigned long generation);
+
+  /**
+   * Every change that may matter gets the next _epoch, and the type of
+   * link or the constant node changed keeps it; a context is stale if
+   * any of its dependencies have changed since it was last searched.
+   * These are updated from the atomspace signals, which may come from
+   * any thread, or from scheme code run while searching; so they have
+   * a lock of their own.
+   */
+  std::mutex _epoch_mtx;
+  unsigned long _epoch;
+  std::unordered_map<Type, unsigned long> _type_epoch;
+  std::unordered_map<Handle, unsigned long> _constant_epoch;
+  void changed(const Handle& h);
+
+  int _add_conn;
+  int _remove_conn;
+  int _tv_conn;
+
+  // The number of times a context was actually searched.
+  size_t _num_searches;
 };
 
-// This function is used to create a single static instance
+// These are used to get the instance for the AtomSpace, and to delete
+// it, which has to be done before the AtomSpace is deleted.
 OpenPsiImplicator& openpsi_implicator(AtomSpace* as);
+void openpsi_implicator_release(AtomSpace* as);
 
 }; // namespace opencog
 
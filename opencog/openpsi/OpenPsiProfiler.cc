@@ -0,0 +1,91 @@
+/*
+ * OpenPsiProfiler.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include "OpenPsiProfiler.h"
+
+using namespace opencog;
+
+OpenPsiProfiler::OpenPsiProfiler() : _enabled(false), _steps({0, 0.0, 0.0})
+{
+}
+
+void OpenPsiProfiler::reset()
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  _rules.clear();
+  _steps = {0, 0.0, 0.0};
+}
+
+void OpenPsiProfiler::record_check(const Handle& rule, bool satisfied,
+  double secs)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  RuleStats& stats = _rules.emplace(rule, RuleStats{0, 0, 0.0, 0.0})
+    .first->second;
+  stats.checked++;
+  if (satisfied) stats.satisfied++;
+  stats.match_time += secs;
+}
+
+void OpenPsiProfiler::record_imply(const Handle& rule, double secs)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  RuleStats& stats = _rules.emplace(rule, RuleStats{0, 0, 0.0, 0.0})
+    .first->second;
+  stats.imply_time += secs;
+}
+
+void OpenPsiProfiler::record_step(double secs)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  _steps.steps++;
+  _steps.total_time += secs;
+  _steps.max_time = std::max(_steps.max_time, secs);
+}
+
+std::vector<std::pair<Handle, OpenPsiProfiler::RuleStats>>
+OpenPsiProfiler::top(size_t n)
+{
+  std::vector<std::pair<Handle, RuleStats>> result;
+  {
+    std::lock_guard<std::mutex> lck(_mtx);
+    result.assign(_rules.begin(), _rules.end());
+  }
+
+  n = std::min(n, result.size());
+  std::partial_sort(result.begin(), result.begin() + n, result.end(),
+    [](const std::pair<Handle, RuleStats>& a,
+       const std::pair<Handle, RuleStats>& b)
+    {
+      return a.second.match_time + a.second.imply_time >
+        b.second.match_time + b.second.imply_time;
+    });
+  result.resize(n);
+  return result;
+}
+
+OpenPsiProfiler::StepStats OpenPsiProfiler::steps()
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  return _steps;
+}
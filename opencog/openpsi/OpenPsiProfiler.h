@@ -0,0 +1,101 @@
+/*
+ * OpenPsiProfiler.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_OPENPSI_PROFILER_H
+#define _OPENCOG_OPENPSI_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+
+/**
+ * Counts, for each psi-rule, how often its context was checked and found
+ * satisfiable, and the time spent checking it and implying it; and the
+ * time taken by each psi-step. Nothing is recorded until it is enabled,
+ * so that it costs no more than a test of a flag otherwise.
+ *
+ * The parts of contexts shared by rules are searched once, though the
+ * time taken is counted for each of the rules.
+ */
+class OpenPsiProfiler
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  struct RuleStats
+  {
+    size_t checked;
+    size_t satisfied;
+    double match_time; // secs
+    double imply_time; // secs
+  };
+
+  struct StepStats
+  {
+    size_t steps;
+    double total_time; // secs
+    double max_time; // secs
+  };
+
+  OpenPsiProfiler();
+
+  void enable(bool on) { _enabled = on; }
+  bool is_enabled() const { return _enabled; }
+
+  // Forget all that was recorded.
+  void reset();
+
+  void record_check(const Handle& rule, bool satisfied, double secs);
+  void record_imply(const Handle& rule, double secs);
+  void record_step(double secs);
+
+  /**
+   * The n rules that took the most time checking and implying, the
+   * costliest first.
+   */
+  std::vector<std::pair<Handle, RuleStats>> top(size_t n);
+
+  StepStats steps();
+
+  static double since(const Clock::time_point& start)
+  {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+private:
+  std::atomic<bool> _enabled;
+
+  std::mutex _mtx;
+  std::unordered_map<Handle, RuleStats> _rules;
+  StepStats _steps;
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_OPENPSI_PROFILER_H
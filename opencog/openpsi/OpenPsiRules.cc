@@ -19,15 +19,20 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/pattern/SatisfactionLink.h>
 
 #include "OpenPsiRules.h"
+#include "PerAtomSpace.h"
 
 using namespace opencog;
 
-OpenPsiRules::OpenPsiRules(AtomSpace* as): _as(as)
+OpenPsiRules::OpenPsiRules(AtomSpace* as):
+  _categories_valid(true), _as(as)
 {
   _action_executed = _as->add_node(PREDICATE_NODE, "action-executed");
 }
@@ -56,40 +61,359 @@ Handle OpenPsiRules::add_rule(const HandleSeq& context, const Handle& action,
   // SatisfactionLink(e.g. a ghost context) then it cast it because the
   // cast will be valid; else construct a PatternLink wrapping the context
   // in an AndLink.
+  PatternLinkPtr query;
   if ((1 == context.size()) and
     nameserver().isA(SATISFACTION_LINK, context[0]->get_type())) {
       // This is for ghost.
-
-      // Add to the index of rules.
-      PatternLinkPtr query = PatternLinkCast(context[0]);
-      _psi_rules[rule] = std::make_tuple(context, action, goal, query);
+      query = PatternLinkCast(context[0]);
   } else {
     // This is for backward compatability.
     // TODO: Test thoroughly, or develop an alternative. See discussion
     // @ https://github.com/opencog/opencog/pull/2899 for what the
     // alternative might be.
-
-    // Add to the index of rules.
-    PatternLinkPtr query_body = \
-      createPatternLink(std::move(Handle(createLink(std::move(context), AND_LINK))));
-    _psi_rules[rule] = std::make_tuple(context, action, goal, query_body);
+    query = createPatternLink(
+      std::move(Handle(createLink(std::move(context), AND_LINK))));
   }
 
+  // Add to the index of rules. A context that is the same as that of
+  // another rule, or isn't split, shares the query of the other rule.
+  std::vector<PatternLinkPtr> components = split_context(context, query);
+  if (1 == components.size()) query = components[0];
+  _psi_rules[rule] = std::make_tuple(context, action, goal, query);
+  _components[rule] = std::move(components);
+
+  index_context(rule, context);
+
   return rule;
 }
 
+HandleSeq OpenPsiRules::add_rules(const std::vector<RuleDecl>& decls)
+{
+  HandleSeq rules;
+  rules.reserve(decls.size());
+
+  for (const RuleDecl& d : decls) {
+    Handle rule = add_rule(d.context, d.action, d.goal, d.stv);
+
+    for (const Handle& category : d.categories) {
+      _as->add_link(MEMBER_LINK, rule, category);
+      if (_category_index.find(category) == _category_index.end())
+        _categories_valid = false;
+      _category_index[category].insert(rule);
+    }
+
+    if (d.has_terms) {
+      if (d.term_groups.empty())
+        add_rule_terms(rule, HandleSeq());
+      for (const HandleSeq& terms : d.term_groups)
+        add_rule_terms(rule, terms);
+    }
+
+    rules.push_back(rule);
+  }
+
+  return rules;
+}
+
+void OpenPsiRules::index_context(const Handle& rule, const HandleSeq& context)
+{
+  std::unordered_set<Type>& types = _context_types[rule];
+
+  HandleSeq todo(context);
+  while (not todo.empty()) {
+    Handle h(todo.back());
+    todo.pop_back();
+    Type t = h->get_type();
+
+    if (h->is_link()) {
+      // Constants that must be absent, and variable declarations.
+      if (NOT_LINK == t or ABSENT_LINK == t or VARIABLE_LIST == t or
+          TYPED_VARIABLE_LINK == t)
+        continue;
+
+      for (const Handle& out : h->getOutgoingSet())
+        todo.push_back(out);
+      continue;
+    }
+
+    if (nameserver().isA(t, VARIABLE_NODE) or
+        nameserver().isA(t, GLOB_NODE))
+      continue;
+
+    _context_index[h].insert(rule);
+    types.insert(t);
+  }
+}
+
+PatternLinkPtr OpenPsiRules::share_query(HandleSeq clauses, HandleSeq decls,
+  const std::function<PatternLinkPtr(void)>& create)
+{
+  std::sort(clauses.begin(), clauses.end());
+  std::sort(decls.begin(), decls.end());
+  clauses.insert(clauses.end(), decls.begin(), decls.end());
+
+  auto it = _shared_queries.find(clauses);
+  if (it == _shared_queries.end())
+    it = _shared_queries.emplace(std::move(clauses), create()).first;
+  return it->second;
+}
+
+// Clauses that can't be searched for on their own, but only tell
+// whether the groundings of the other clauses are acceptable.
+static bool is_plain(const Handle& clause)
+{
+  Type t = clause->get_type();
+  if (ABSENT_LINK == t or NOT_LINK == t or
+      nameserver().isA(t, VIRTUAL_LINK))
+    return false;
+
+  if (EVALUATION_LINK == t) {
+    Type pred = clause->getOutgoingAtom(0)->get_type();
+    return GROUNDED_PREDICATE_NODE != pred and
+      DEFINED_PREDICATE_NODE != pred;
+  }
+
+  return not nameserver().isA(t, EVALUATABLE_LINK);
+}
+
+std::vector<PatternLinkPtr> OpenPsiRules::split_context(
+  const HandleSeq& context, const PatternLinkPtr& query)
+{
+  // The clauses, and the variable declarations if any.
+  bool is_ghost = (1 == context.size()) and
+    nameserver().isA(SATISFACTION_LINK, context[0]->get_type());
+  bool has_decls = is_ghost and 2 == context[0]->get_arity();
+  HandleSeq clauses(context);
+  HandleSeq decls;
+  if (is_ghost) {
+    const HandleSeq& oset = context[0]->getOutgoingSet();
+    const Handle& body = oset.back();
+    if (AND_LINK == body->get_type())
+      clauses = body->getOutgoingSet();
+    else
+      clauses = {body};
+
+    if (has_decls) {
+      if (VARIABLE_LIST == oset[0]->get_type())
+        decls = oset[0]->getOutgoingSet();
+      else
+        decls = {oset[0]};
+    }
+  }
+
+  auto declared_var = [](const Handle& decl)
+  {
+    return (TYPED_VARIABLE_LINK == decl->get_type()) ?
+      decl->getOutgoingAtom(0) : decl;
+  };
+  HandleSet declared;
+  for (const Handle& decl : decls) declared.insert(declared_var(decl));
+
+  auto whole = [&]()
+  {
+    return std::vector<PatternLinkPtr>(
+      {share_query(clauses, decls, [&]() { return query; })});
+  };
+
+  // The variables of each clause. Contexts with quoted or scoped terms
+  // aren't split, as their variables are not all free.
+  std::vector<HandleSet> clause_vars;
+  for (const Handle& clause : clauses) {
+    HandleSet vars;
+    HandleSeq todo({clause});
+    while (not todo.empty()) {
+      Handle h(todo.back());
+      todo.pop_back();
+      Type t = h->get_type();
+
+      if (h->is_link()) {
+        if (QUOTE_LINK == t or UNQUOTE_LINK == t or
+            LOCAL_QUOTE_LINK == t or nameserver().isA(t, SCOPE_LINK))
+          return whole();
+        for (const Handle& out : h->getOutgoingSet())
+          todo.push_back(out);
+      } else if (has_decls ? 0 < declared.count(h) :
+                 (nameserver().isA(t, VARIABLE_NODE) or
+                  nameserver().isA(t, GLOB_NODE))) {
+        vars.insert(h);
+      }
+    }
+    clause_vars.push_back(std::move(vars));
+  }
+
+  // Group the clauses that share variables.
+  std::vector<size_t> group(clauses.size());
+  for (size_t i = 0; i < group.size(); i++) group[i] = i;
+  auto find = [&](size_t i)
+  {
+    while (group[i] != i) i = group[i] = group[group[i]];
+    return i;
+  };
+  std::unordered_map<Handle, size_t> first_with;
+  for (size_t i = 0; i < clauses.size(); i++) {
+    for (const Handle& var : clause_vars[i]) {
+      auto it = first_with.emplace(var, i).first;
+      group[find(i)] = find(it->second);
+    }
+  }
+
+  // Groups with nothing to search for go with the first group that has.
+  std::map<size_t, HandleSeq> parts;
+  std::map<size_t, HandleSet> part_vars;
+  std::vector<bool> plain(clauses.size(), false);
+  for (size_t i = 0; i < clauses.size(); i++)
+    if (not clause_vars[i].empty() and is_plain(clauses[i]))
+      plain[find(i)] = true;
+
+  size_t first_plain = clauses.size();
+  for (size_t i = 0; i < clauses.size(); i++)
+    if (plain[find(i)]) {
+      first_plain = find(i);
+      break;
+    }
+  if (first_plain == clauses.size()) return whole();
+
+  for (size_t i = 0; i < clauses.size(); i++) {
+    size_t g = plain[find(i)] ? find(i) : first_plain;
+    parts[g].push_back(clauses[i]);
+    part_vars[g].insert(clause_vars[i].begin(), clause_vars[i].end());
+  }
+  if (parts.size() < 2) return whole();
+
+  std::vector<PatternLinkPtr> components;
+  for (const auto& part : parts) {
+    const HandleSeq& part_clauses = part.second;
+    const HandleSet& vars = part_vars[part.first];
+
+    HandleSeq part_decls;
+    for (const Handle& decl : decls)
+      if (vars.count(declared_var(decl))) part_decls.push_back(decl);
+
+    components.push_back(share_query(part_clauses, part_decls, [&]()
+    {
+      Handle body(createLink(part_clauses, AND_LINK));
+      if (not is_ghost) return createPatternLink(body);
+
+      HandleSeq oset;
+      if (has_decls)
+        oset.push_back(createLink(part_decls, VARIABLE_LIST));
+      oset.push_back(body);
+      return PatternLinkPtr(createSatisfactionLink(std::move(oset)));
+    }));
+  }
+  return components;
+}
+
+HandleSeq OpenPsiRules::get_triggered_rules(const HandleSeq& input)
+{
+  UnorderedHandleSet triggered;
+  std::unordered_set<Type> input_types;
+  for (const Handle& h : input) {
+    input_types.insert(h->get_type());
+
+    auto it = _context_index.find(h);
+    if (it != _context_index.end())
+      triggered.insert(it->second.begin(), it->second.end());
+  }
+
+  // The rules that don't depend on atoms like those of the input.
+  for (const auto& ct : _context_types) {
+    bool constrained = false;
+    for (Type t : ct.second) {
+      if (input_types.count(t)) {
+        constrained = true;
+        break;
+      }
+    }
+    if (not constrained) triggered.insert(ct.first);
+  }
+
+  return HandleSeq(triggered.begin(), triggered.end());
+}
+
 bool OpenPsiRules::is_rule(const Handle& rule)
 {
   return _psi_rules.count(rule);
 }
 
+void OpenPsiRules::add_rule_terms(const Handle& rule, const HandleSeq& terms)
+{
+  std::vector<HandleSeq>& groups = _rule_terms[rule];
+  if (terms.empty()) {
+    if (groups.empty()) _termless_rules.insert(rule);
+    return;
+  }
+
+  HandleSeq group(terms);
+  std::sort(group.begin(), group.end());
+  group.erase(std::unique(group.begin(), group.end()), group.end());
+  if (std::find(groups.begin(), groups.end(), group) != groups.end())
+    return;
+
+  for (const Handle& term : group)
+    _term_index[term].emplace_back(rule, groups.size());
+  groups.push_back(group);
+  _termless_rules.erase(rule);
+}
+
+HandleSeq OpenPsiRules::get_rules_by_terms(const HandleSeq& input,
+  size_t max)
+{
+  // For each rule with a term in the input, the groups that have one,
+  // and the number of terms it shares with the input.
+  struct Hits
+  {
+    std::vector<bool> groups;
+    size_t num_groups;
+    size_t num_terms;
+  };
+  std::unordered_map<Handle, Hits> hits;
+
+  UnorderedHandleSet seen;
+  for (const Handle& term : input) {
+    if (not seen.insert(term).second) continue;
+    auto it = _term_index.find(term);
+    if (it == _term_index.end()) continue;
+
+    for (const auto& rg : it->second) {
+      Hits& h = hits[rg.first];
+      if (h.groups.empty()) {
+        h.groups.resize(_rule_terms[rg.first].size(), false);
+        h.num_groups = 0;
+        h.num_terms = 0;
+      }
+      h.num_terms++;
+      if (not h.groups[rg.second]) {
+        h.groups[rg.second] = true;
+        h.num_groups++;
+      }
+    }
+  }
+
+  std::vector<std::pair<size_t, Handle>> ranked;
+  for (const auto& rh : hits)
+    if (rh.second.num_groups == rh.second.groups.size())
+      ranked.emplace_back(rh.second.num_terms, rh.first);
+  std::sort(ranked.begin(), ranked.end(),
+    [](const std::pair<size_t, Handle>& a, const std::pair<size_t, Handle>& b)
+    { return a.first > b.first or (a.first == b.first and a.second < b.second); });
+
+  HandleSeq result;
+  for (const auto& sr : ranked) result.push_back(sr.second);
+  HandleSeq termless(_termless_rules.begin(), _termless_rules.end());
+  std::sort(termless.begin(), termless.end());
+  result.insert(result.end(), termless.begin(), termless.end());
+
+  if (0 < max and max < result.size()) result.resize(max);
+  return result;
+}
+
 Handle OpenPsiRules::add_category(const Handle& new_category)
 {
   // _psi_category is a null pointer; its never set.
   // _as->add_link(INHERITANCE_LINK, new_category, _psi_category);
-  if(not(_category_index.count(new_category))) {
-    _category_index[new_category] = {};
-  }
+  if (_category_index.emplace(new_category, UnorderedHandleSet()).second)
+    _categories_valid = false;
 
   return new_category;
 }
@@ -105,59 +429,67 @@ Handle OpenPsiRules::add_to_category(const Handle& rule, const Handle& category)
   return rule;
 }
 
-HandleSeq& OpenPsiRules::get_categories()
+const HandleSeq& OpenPsiRules::get_categories()
 {
-  HandleSeq* categories = new HandleSeq();
-  for(auto i : _category_index) {
-    categories->emplace_back(i.first);
+  // Rebuilt only after a category has been added.
+  if (not _categories_valid) {
+    _categories.clear();
+    for(const auto& i : _category_index) {
+      _categories.emplace_back(i.first);
+    }
+    _categories_valid = true;
   }
 
-  // TODO: Should this be a shared ptr to avoid memory leak?
-  return *categories;
+  return _categories;
 }
 
-HandleSeq& OpenPsiRules::get_context(const Handle rule)
+const HandleSeq& OpenPsiRules::get_context(const Handle& rule)
 {
-  if(_psi_rules.count(rule)) {
-    return std::get<0>(_psi_rules[rule]);
-  } else {
-    // TODO: Should this be a shared ptr to avoid memory leak?
-    HandleSeq* hs = new HandleSeq();
-    return *hs;
-  }
+  static const HandleSeq none;
+  auto it = _psi_rules.find(rule);
+  return (it == _psi_rules.end()) ? none : std::get<0>(it->second);
 }
 
-Handle OpenPsiRules::get_action(const Handle rule)
+Handle OpenPsiRules::get_action(const Handle& rule)
 {
-  if(_psi_rules.count(rule)) {
-    return std::get<1>(_psi_rules[rule]);
-  } else {
-    return Handle::UNDEFINED;
-  }
+  auto it = _psi_rules.find(rule);
+  return (it == _psi_rules.end()) ?
+    Handle::UNDEFINED : std::get<1>(it->second);
 }
 
-Handle OpenPsiRules::get_goal(const Handle rule)
+Handle OpenPsiRules::get_goal(const Handle& rule)
 {
-  if(_psi_rules.count(rule)) {
-    return std::get<2>(_psi_rules[rule]);
-  } else {
-    return Handle::UNDEFINED;
-  }
+  auto it = _psi_rules.find(rule);
+  return (it == _psi_rules.end()) ?
+    Handle::UNDEFINED : std::get<2>(it->second);
 }
 
-PatternLinkPtr OpenPsiRules::get_query(const Handle rule)
+PatternLinkPtr OpenPsiRules::get_query(const Handle& rule)
 {
-  if(_psi_rules.count(rule)) {
-    return std::get<3>(_psi_rules[rule]);
-  } else {
-    return PatternLinkCast(Handle::UNDEFINED);
-  }
+  auto it = _psi_rules.find(rule);
+  return (it == _psi_rules.end()) ? nullptr : std::get<3>(it->second);
+}
+
+const std::vector<PatternLinkPtr>& OpenPsiRules::get_components(
+  const Handle& rule)
+{
+  static const std::vector<PatternLinkPtr> none;
+  auto it = _components.find(rule);
+  return (it == _components.end()) ? none : it->second;
+}
+
+static PerAtomSpace<OpenPsiRules>& openpsi_caches()
+{
+  static PerAtomSpace<OpenPsiRules> instances;
+  return instances;
 }
 
 OpenPsiRules& opencog::openpsi_cache(AtomSpace* as)
 {
-  // To handle multiple atomspaces maybe a static vector of OpenPsiRules
-  //  maybe used.
-  static OpenPsiRules cache(as);
-  return cache;
+  return openpsi_caches().get(as);
+}
+
+void opencog::openpsi_cache_release(AtomSpace* as)
+{
+  openpsi_caches().release(as);
 }
@@ -22,6 +22,12 @@
 #ifndef _OPENCOG_OPENPSI_RULES_H
 #define _OPENCOG_OPENPSI_RULES_H
 
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include <opencog/atoms/pattern/PatternLink.h>
 #include <opencog/atomspace/AtomSpace.h>
 
@@ -46,6 +52,33 @@ public:
   Handle add_rule(const HandleSeq& context, const Handle& action,
     const Handle& goal, const TruthValuePtr stv);
 
+  /**
+   * A rule to be added by add_rules: what add_rule takes, the
+   * categories to add it to, and, if has_terms is set, the groups of
+   * terms to declare it with, as add_rule_terms does for each group; no
+   * group at all declares that it needs none.
+   */
+  struct RuleDecl
+  {
+    HandleSeq context;
+    Handle action;
+    Handle goal;
+    TruthValuePtr stv;
+    HandleSeq categories;
+    bool has_terms = false;
+    std::vector<HandleSeq> term_groups;
+  };
+
+  /**
+   * Add many rules at once, e.g. all those of a GHOST rule file, in
+   * the order given. This does for each what add_rule, add_to_category
+   * and add_rule_terms would, but the list of categories is made again
+   * only once.
+   *
+   * @return The rules, in the same order.
+   */
+  HandleSeq add_rules(const std::vector<RuleDecl>& decls);
+
   /**
    * It checks if the rule passed is cached in the index. A valid
    * structured rule declared in the atomspace but not indexed will
@@ -62,35 +95,51 @@ public:
 
   /**
    * Returns all the categories that were added using add_to_category.
+   * The list is kept, and only made again after a category is added;
+   * the reference stays valid, but the list may change then.
    *
    * @return A vector of Handles that represent the categories.
    */
-  HandleSeq& get_categories();
+  const HandleSeq& get_categories();
 
   /**
    * @param rule A psi-rule.
-   * @return Context of the given psi-rule.
+   * @return Context of the given psi-rule, or an empty one if it isn't
+   *  in the index.
    */
-  HandleSeq& get_context(const Handle rule);
+  const HandleSeq& get_context(const Handle& rule);
 
   /**
    * @param rule A psi-rule.
    * @return Action of the given psi-rule.
    */
-  Handle get_action(const Handle rule);
+  Handle get_action(const Handle& rule);
 
   /**
    * @param rule A psi-rule.
    * @return Goal of the given psi-rule.
    */
-  Handle get_goal(const Handle rule);
+  Handle get_goal(const Handle& rule);
 
   /**
    * @param rule A psi-rule.
    * @return Query atom used to check if the context of the given psi-rule is
    *  satisfiable or not.
    */
-  PatternLinkPtr get_query(const Handle rule);
+  PatternLinkPtr get_query(const Handle& rule);
+
+  /**
+   * The context of a rule is split into parts that share no variables,
+   * and so can be satisfied independently; each has a query of its own,
+   * and the rule is satisfiable if all of them are. A part that is the
+   * same in several rules has the same query in all of them, so that it
+   * is only searched once. A context that isn't split has only the
+   * query returned by get_query.
+   *
+   * @param rule A psi-rule.
+   * @return The queries of the parts of the context of the rule.
+   */
+  const std::vector<PatternLinkPtr>& get_components(const Handle& rule);
 
   /**
    * Declare a new category by adding the following structured atom into the
@@ -117,6 +166,68 @@ public:
    */
   Handle add_to_category(const Handle& rule, const Handle& category);
 
+  /**
+   * Returns the rules whose context could be satisfied given the atoms
+   * of the current input, e.g. the WordNodes of a sentence. A rule is
+   * returned if its context has one of the given atoms as a constant,
+   * or if it has no constants of the types of the given atoms at all.
+   * Constants that need not be present, as under a NotLink or an
+   * AbsentLink, are left out.
+   *
+   * @param input The atoms of the current input.
+   * @return The rules that could be triggered by the input.
+   */
+  HandleSeq get_triggered_rules(const HandleSeq& input);
+
+  /**
+   * Declare that the context of the rule can only be satisfied if the
+   * input has one of the given terms, e.g. a word, its lemma, one of a
+   * set of words to choose from, or a concept that one of the words
+   * is a member of. Each call adds a group of terms; a group that the
+   * rule has already is ignored. A rule declared with no terms needs
+   * none. This is meant for GHOST, whose rules say what terms their
+   * contexts need more plainly than the contexts themselves do.
+   *
+   * @param rule A psi-rule.
+   * @param terms The terms of which the input must have at least one.
+   */
+  void add_rule_terms(const Handle& rule, const HandleSeq& terms);
+
+  /**
+   * Returns the rules declared with add_rule_terms that have a term
+   * from each of their groups in the input. Those sharing the most terms
+   * with the input come first, and those that need no terms last.
+   *
+   * @param input The terms of the current input.
+   * @param max The most rules to return; 0 for all of them.
+   */
+  HandleSeq get_rules_by_terms(const HandleSeq& input, size_t max);
+
+  /**
+   * Write the rules, their categories and the terms declared for them
+   * to a file, so that restore can index them again without whoever
+   * declared them, e.g. without parsing the GHOST rule files again. The
+   * atoms they are made of are written too, with the names of their
+   * types, so the file can be restored into an empty atomspace, or one
+   * where the rules were loaded from storage.
+   *
+   * @param path The file to write.
+   * @return The number of rules written.
+   */
+  size_t save(const std::string& path);
+
+  /**
+   * Map a file written by save, add its atoms to the atomspace, and
+   * add its rules, categories and terms to those already here, as
+   * add_rule, add_to_category and add_rule_terms would. The queries of
+   * the rules are made again, as they are not atoms. A file that is
+   * not well-formed is refused as a whole, before anything is added.
+   *
+   * @param path The file to read.
+   * @return The number of rules restored.
+   */
+  size_t restore(const std::string& path);
+
 private:
   /**
    * The structure of the tuple is (context, action, goal, query),
@@ -131,7 +242,7 @@ private:
    * value being a tuple of its three components. The intention is to minimize
    * the computing required for getting the different component of a rule.
    */
-  std::map<Handle, PsiTuple> _psi_rules;
+  std::unordered_map<Handle, PsiTuple> _psi_rules;
 
   // TODO: Using names that are prefixed with "OpenPsi: " might be a bad idea,
   // because it might hinder interoperability with other components that
@@ -146,7 +257,41 @@ private:
    * doesn't happen dynamically, for now, i.e., when there is no learning
    * taking place.
    */
-  std::map<Handle, HandleSet> _category_index;
+  std::unordered_map<Handle, UnorderedHandleSet> _category_index;
+
+  // The categories, as returned by get_categories.
+  HandleSeq _categories;
+  bool _categories_valid;
+
+  /**
+   * Maps from the constant atoms of the contexts to the rules they are
+   * in, and from each rule to the types of those constants; used by
+   * get_triggered_rules.
+   */
+  std::unordered_map<Handle, UnorderedHandleSet> _context_index;
+  std::unordered_map<Handle, std::unordered_set<Type>> _context_types;
+  void index_context(const Handle& rule, const HandleSeq& context);
+
+  /**
+   * The groups of terms of each rule, sorted; the groups each term is
+   * in; and the rules that need no term. See add_rule_terms.
+   */
+  std::unordered_map<Handle, std::vector<HandleSeq>> _rule_terms;
+  std::unordered_map<Handle, std::vector<std::pair<Handle, size_t>>>
+    _term_index;
+  UnorderedHandleSet _termless_rules;
+
+  /**
+   * The queries of the parts of the contexts, keyed by their sorted
+   * clauses followed by their sorted variable declarations, and the
+   * parts of each rule; see get_components.
+   */
+  std::map<HandleSeq, PatternLinkPtr> _shared_queries;
+  std::unordered_map<Handle, std::vector<PatternLinkPtr>> _components;
+  std::vector<PatternLinkPtr> split_context(const HandleSeq& context,
+    const PatternLinkPtr& query);
+  PatternLinkPtr share_query(HandleSeq clauses, HandleSeq decls,
+    const std::function<PatternLinkPtr(void)>& create);
 
   /**
    * Node used to declare a category.
@@ -159,8 +304,10 @@ private:
   AtomSpace* _as;
 };
 
-// This function is used to create a single static instance
+// These are used to get the instance for the AtomSpace, and to delete
+// it, which has to be done before the AtomSpace is deleted.
 OpenPsiRules& openpsi_cache(AtomSpace* as);
+void openpsi_cache_release(AtomSpace* as);
 
 } // namespace opencog
 
@@ -0,0 +1,406 @@
+/*
+ * OpenPsiRulesSnapshot.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// OpenPsiRules::save and OpenPsiRules::restore, and the file they use.
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+
+#include "OpenPsiRules.h"
+
+using namespace opencog;
+
+// The file is a header followed by these arrays, in this order. Atoms
+// refer to their types, and come after the atoms they are made of; all
+// lists of atoms are ranges of the refs.
+namespace {
+
+const char MAGIC[8] = {'P', 'S', 'I', 'R', 'U', 'L', 'E', 'S'};
+const uint32_t VERSION = 1;
+
+struct Header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t n_types;
+  uint32_t n_atoms;
+  uint32_t n_refs;
+  uint32_t n_rules;
+  uint32_t n_categories;
+  uint32_t n_terms;
+  uint32_t n_groups;
+  uint32_t strings_size;
+  uint32_t unused;
+};
+
+// A type name, or the name of a node, in the strings
+struct NameRec
+{
+  uint32_t first;
+  uint32_t size;
+};
+
+// A node's name, or a link's outgoing set
+struct AtomRec
+{
+  uint32_t type;
+  uint32_t is_node;
+  uint32_t first;
+  uint32_t count;
+};
+
+// The context is a range of the refs
+struct RuleRec
+{
+  uint32_t action;
+  uint32_t goal;
+  uint32_t first;
+  uint32_t count;
+  float strength;
+  float confidence;
+};
+
+// A category and its rules, or a rule and its groups of terms, which
+// are a range of the groups; no group means it needs no term
+struct MembersRec
+{
+  uint32_t atom;
+  uint32_t first;
+  uint32_t count;
+};
+
+struct GroupRec
+{
+  uint32_t first;
+  uint32_t count;
+};
+
+}
+
+static uint32_t count32(size_t n, const std::string& path)
+{
+  if (n > std::numeric_limits<uint32_t>::max())
+    throw RuntimeException(TRACE_INFO,
+      "Too many rules for the rule file %s", path.c_str());
+  return (uint32_t) n;
+}
+
+template<typename T>
+static void write_all(std::ofstream& out, const std::vector<T>& v)
+{
+  out.write((const char*) v.data(), v.size() * sizeof(T));
+}
+
+size_t OpenPsiRules::save(const std::string& path)
+{
+  std::string strings;
+  auto add_string = [&](const std::string& s)
+  {
+    NameRec n = {count32(strings.size(), path), count32(s.size(), path)};
+    strings += s;
+    return n;
+  };
+
+  std::vector<NameRec> types;
+  std::unordered_map<Type, uint32_t> type_ids;
+  std::vector<AtomRec> atoms;
+  std::vector<uint32_t> refs;
+  std::unordered_map<Handle, uint32_t> atom_ids;
+
+  // The atoms an atom is made of come before it.
+  std::function<uint32_t(const Handle&)> atom_id = [&](const Handle& h)
+  {
+    auto it = atom_ids.find(h);
+    if (it != atom_ids.end()) return it->second;
+
+    Type t = h->get_type();
+    auto tt = type_ids.find(t);
+    if (tt == type_ids.end()) {
+      tt = type_ids.emplace(t, count32(types.size(), path)).first;
+      types.push_back(add_string(nameserver().getTypeName(t)));
+    }
+
+    AtomRec a = {tt->second, h->is_node(), 0, 0};
+    if (h->is_node()) {
+      NameRec n = add_string(h->get_name());
+      a.first = n.first;
+      a.count = n.size;
+    } else {
+      std::vector<uint32_t> out;
+      for (const Handle& o : h->getOutgoingSet())
+        out.push_back(atom_id(o));
+      a.first = count32(refs.size(), path);
+      a.count = count32(out.size(), path);
+      refs.insert(refs.end(), out.begin(), out.end());
+    }
+
+    uint32_t id = count32(atoms.size(), path);
+    atoms.push_back(a);
+    atom_ids[h] = id;
+    return id;
+  };
+
+  auto add_refs = [&](const HandleSeq& hs, uint32_t& first, uint32_t& count)
+  {
+    std::vector<uint32_t> ids;
+    for (const Handle& h : hs) ids.push_back(atom_id(h));
+    first = count32(refs.size(), path);
+    count = count32(ids.size(), path);
+    refs.insert(refs.end(), ids.begin(), ids.end());
+  };
+
+  std::vector<RuleRec> rules;
+  for (const auto& r : _psi_rules) {
+    RuleRec rule;
+    add_refs(std::get<0>(r.second), rule.first, rule.count);
+    rule.action = atom_id(std::get<1>(r.second));
+    rule.goal = atom_id(std::get<2>(r.second));
+    TruthValuePtr tv = r.first->getTruthValue();
+    rule.strength = tv->get_mean();
+    rule.confidence = tv->get_confidence();
+    rules.push_back(rule);
+  }
+
+  std::vector<MembersRec> categories;
+  for (const auto& c : _category_index) {
+    MembersRec m;
+    m.atom = atom_id(c.first);
+    add_refs(HandleSeq(c.second.begin(), c.second.end()), m.first, m.count);
+    categories.push_back(m);
+  }
+
+  std::vector<MembersRec> terms;
+  std::vector<GroupRec> groups;
+  for (const auto& rt : _rule_terms) {
+    MembersRec m;
+    m.atom = atom_id(rt.first);
+    m.first = count32(groups.size(), path);
+    m.count = count32(rt.second.size(), path);
+    for (const HandleSeq& g : rt.second) {
+      GroupRec group;
+      add_refs(g, group.first, group.count);
+      groups.push_back(group);
+    }
+    terms.push_back(m);
+  }
+
+  Header hdr;
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, MAGIC, sizeof(MAGIC));
+  hdr.version = VERSION;
+  hdr.n_types = count32(types.size(), path);
+  hdr.n_atoms = count32(atoms.size(), path);
+  hdr.n_refs = count32(refs.size(), path);
+  hdr.n_rules = count32(rules.size(), path);
+  hdr.n_categories = count32(categories.size(), path);
+  hdr.n_terms = count32(terms.size(), path);
+  hdr.n_groups = count32(groups.size(), path);
+  hdr.strings_size = count32(strings.size(), path);
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (not out)
+    throw RuntimeException(TRACE_INFO,
+      "Cannot create the rule file %s", path.c_str());
+
+  out.write((const char*) &hdr, sizeof(hdr));
+  write_all(out, types);
+  write_all(out, atoms);
+  write_all(out, refs);
+  write_all(out, rules);
+  write_all(out, categories);
+  write_all(out, terms);
+  write_all(out, groups);
+  out.write(strings.data(), strings.size());
+  out.close();
+
+  if (not out)
+    throw RuntimeException(TRACE_INFO,
+      "Cannot write the rule file %s", path.c_str());
+
+  return rules.size();
+}
+
+size_t OpenPsiRules::restore(const std::string& path)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw RuntimeException(TRACE_INFO,
+      "Cannot open the rule file %s", path.c_str());
+
+  void* map = nullptr;
+  size_t map_size = 0;
+  struct stat st;
+  if (0 == fstat(fd, &st) and sizeof(Header) <= (size_t) st.st_size) {
+    map_size = st.st_size;
+    map = mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED == map) map = nullptr;
+  }
+  close(fd);
+
+  auto fail = [&](const char* why)
+  {
+    if (map) munmap(map, map_size);
+    throw RuntimeException(TRACE_INFO,
+      "Bad rule file %s: %s", path.c_str(), why);
+  };
+
+  if (nullptr == map) fail("cannot map it");
+
+  // Check it all through before adding anything.
+  const char* base = (const char*) map;
+  const Header* hdr = (const Header*) base;
+  if (memcmp(hdr->magic, MAGIC, sizeof(MAGIC)))
+    fail("not a rule file");
+  if (VERSION != hdr->version)
+    fail("wrong version; save the rules again");
+
+  uint64_t size = sizeof(Header);
+  size += (uint64_t) hdr->n_types * sizeof(NameRec);
+  size += (uint64_t) hdr->n_atoms * sizeof(AtomRec);
+  size += (uint64_t) hdr->n_refs * sizeof(uint32_t);
+  size += (uint64_t) hdr->n_rules * sizeof(RuleRec);
+  size += (uint64_t) (hdr->n_categories + (uint64_t) hdr->n_terms) *
+    sizeof(MembersRec);
+  size += (uint64_t) hdr->n_groups * sizeof(GroupRec);
+  size += hdr->strings_size;
+  if (size != map_size) fail("truncated");
+
+  const NameRec* names = (const NameRec*) (base + sizeof(Header));
+  const AtomRec* atoms = (const AtomRec*) (names + hdr->n_types);
+  const uint32_t* refs = (const uint32_t*) (atoms + hdr->n_atoms);
+  const RuleRec* rules = (const RuleRec*) (refs + hdr->n_refs);
+  const MembersRec* categories = (const MembersRec*) (rules + hdr->n_rules);
+  const MembersRec* terms = categories + hdr->n_categories;
+  const GroupRec* groups = (const GroupRec*) (terms + hdr->n_terms);
+  const char* strings = (const char*) (groups + hdr->n_groups);
+
+  auto in_strings = [&](const NameRec& n)
+  {
+    return (uint64_t) n.first + n.size <= hdr->strings_size;
+  };
+  // The range holds atoms, before the given one if it's for a link.
+  auto check_refs = [&](uint32_t first, uint32_t count, uint32_t before)
+  {
+    if ((uint64_t) first + count > hdr->n_refs) return false;
+    for (uint32_t i = first; i < first + count; i++)
+      if (refs[i] >= before) return false;
+    return true;
+  };
+
+  std::vector<Type> types;
+  for (uint32_t i = 0; i < hdr->n_types; i++) {
+    if (not in_strings(names[i])) fail("bad type name");
+    Type t = nameserver().getType(
+      std::string(strings + names[i].first, names[i].size));
+    if (NOTYPE == t) fail("unknown type");
+    types.push_back(t);
+  }
+
+  for (uint32_t i = 0; i < hdr->n_atoms; i++) {
+    const AtomRec& a = atoms[i];
+    if (a.type >= hdr->n_types) fail("bad atom type");
+    if (a.is_node ? not in_strings({a.first, a.count}) :
+        not check_refs(a.first, a.count, i))
+      fail("bad atom");
+    if ((0 != a.is_node) != nameserver().isNode(types[a.type]))
+      fail("bad atom type");
+  }
+
+  for (uint32_t i = 0; i < hdr->n_rules; i++) {
+    const RuleRec& r = rules[i];
+    if (r.action >= hdr->n_atoms or r.goal >= hdr->n_atoms or
+        not check_refs(r.first, r.count, hdr->n_atoms))
+      fail("bad rule");
+  }
+
+  for (uint32_t i = 0; i < hdr->n_categories; i++) {
+    const MembersRec& m = categories[i];
+    if (m.atom >= hdr->n_atoms or
+        not check_refs(m.first, m.count, hdr->n_atoms))
+      fail("bad category");
+  }
+
+  for (uint32_t i = 0; i < hdr->n_terms; i++) {
+    const MembersRec& m = terms[i];
+    if (m.atom >= hdr->n_atoms or
+        (uint64_t) m.first + m.count > hdr->n_groups)
+      fail("bad terms");
+  }
+
+  for (uint32_t i = 0; i < hdr->n_groups; i++)
+    if (not check_refs(groups[i].first, groups[i].count, hdr->n_atoms))
+      fail("bad group of terms");
+
+  // Add the atoms, then index the rules as they were declared.
+  HandleSeq handles;
+  handles.reserve(hdr->n_atoms);
+  auto range = [&](uint32_t first, uint32_t count)
+  {
+    HandleSeq hs;
+    for (uint32_t i = first; i < first + count; i++)
+      hs.push_back(handles[refs[i]]);
+    return hs;
+  };
+
+  for (uint32_t i = 0; i < hdr->n_atoms; i++) {
+    const AtomRec& a = atoms[i];
+    if (a.is_node)
+      handles.push_back(_as->add_node(types[a.type],
+        std::string(strings + a.first, a.count)));
+    else
+      handles.push_back(_as->add_link(types[a.type],
+        range(a.first, a.count)));
+  }
+
+  for (uint32_t i = 0; i < hdr->n_rules; i++) {
+    const RuleRec& r = rules[i];
+    add_rule(range(r.first, r.count), handles[r.action], handles[r.goal],
+      SimpleTruthValue::createTV(r.strength, r.confidence));
+  }
+
+  for (uint32_t i = 0; i < hdr->n_categories; i++) {
+    const MembersRec& m = categories[i];
+    add_category(handles[m.atom]);
+    for (const Handle& rule : range(m.first, m.count))
+      add_to_category(rule, handles[m.atom]);
+  }
+
+  for (uint32_t i = 0; i < hdr->n_terms; i++) {
+    const MembersRec& m = terms[i];
+    if (0 == m.count)
+      add_rule_terms(handles[m.atom], HandleSeq());
+    for (uint32_t g = m.first; g < m.first + m.count; g++)
+      add_rule_terms(handles[m.atom], range(groups[g].first, groups[g].count));
+  }
+
+  munmap(map, map_size);
+  return hdr->n_rules;
+}
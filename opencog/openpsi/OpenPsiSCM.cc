@@ -19,10 +19,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/LinkValue.h>
 #include <opencog/guile/SchemePrimitive.h>
 
+#include "OpenPsiDynamics.h"
 #include "OpenPsiImplicator.h"
 #include "OpenPsiRules.h"
+#include "OpenPsiScheduler.h"
+#include "OpenPsiSelector.h"
 
 #include "OpenPsiSCM.h"
 
@@ -47,9 +52,45 @@ void OpenPsiSCM::init()
   define_scheme_primitive("psi-add-to-category", &OpenPsiSCM::add_to_category,
     this, "openpsi");
 
+  define_scheme_primitive("psi-add-rule-terms", &OpenPsiSCM::add_rule_terms,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-add-rules", &OpenPsiSCM::add_rules,
+    this, "openpsi");
+
   define_scheme_primitive("psi-categories", &OpenPsiSCM::get_categories,
     this, "openpsi");
 
+  define_scheme_primitive("psi-dynamics-add-event",
+    &OpenPsiSCM::dynamics_add_event, this, "openpsi");
+
+  define_scheme_primitive("psi-dynamics-add-noise",
+    &OpenPsiSCM::dynamics_add_noise, this, "openpsi");
+
+  define_scheme_primitive("psi-dynamics-add-rhythm",
+    &OpenPsiSCM::dynamics_add_rhythm, this, "openpsi");
+
+  define_scheme_primitive("psi-dynamics-add-rule",
+    &OpenPsiSCM::dynamics_add_rule, this, "openpsi");
+
+  define_scheme_primitive("psi-dynamics-add-variable",
+    &OpenPsiSCM::dynamics_add_variable, this, "openpsi");
+
+  define_scheme_primitive("psi-dynamics-clear", &OpenPsiSCM::dynamics_clear,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-dynamics-halt", &OpenPsiSCM::dynamics_halt,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-dynamics-run", &OpenPsiSCM::dynamics_run,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-dynamics-running?",
+    &OpenPsiSCM::dynamics_is_running, this, "openpsi");
+
+  define_scheme_primitive("psi-dynamics-step", &OpenPsiSCM::dynamics_step,
+    this, "openpsi");
+
   define_scheme_primitive("psi-get-action", &OpenPsiSCM::get_action,
     this, "openpsi");
 
@@ -62,14 +103,86 @@ void OpenPsiSCM::init()
   define_scheme_primitive("psi-imply", &OpenPsiSCM::imply,
     this, "openpsi");
 
+  define_scheme_primitive("psi-profile", &OpenPsiSCM::profile,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-profile-enable", &OpenPsiSCM::profile_enable,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-profile-record-step",
+    &OpenPsiSCM::profile_record_step, this, "openpsi");
+
+  define_scheme_primitive("psi-profile-reset", &OpenPsiSCM::profile_reset,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-profile-steps", &OpenPsiSCM::profile_steps,
+    this, "openpsi");
+
   define_scheme_primitive("psi-rule", &OpenPsiSCM::add_rule,
     this, "openpsi");
 
+  define_scheme_primitive("psi-release", &OpenPsiSCM::release,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-restore-rules", &OpenPsiSCM::restore_rules,
+    this, "openpsi");
+
   define_scheme_primitive("psi-rule?", &OpenPsiSCM::is_rule,
     this, "openpsi");
 
+  define_scheme_primitive("psi-rule-weights", &OpenPsiSCM::weigh_rules,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-rules-by-terms",
+    &OpenPsiSCM::get_rules_by_terms, this, "openpsi");
+
+  define_scheme_primitive("psi-rules-triggered-by",
+    &OpenPsiSCM::get_triggered_rules, this, "openpsi");
+
   define_scheme_primitive("psi-satisfiable?", &OpenPsiSCM::is_satisfiable,
     this, "openpsi");
+
+  define_scheme_primitive("psi-satisfiable-batch",
+    &OpenPsiSCM::is_satisfiable_batch, this, "openpsi");
+
+  define_scheme_primitive("psi-sample-by-weight", &OpenPsiSCM::sample_rule,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-save-rules", &OpenPsiSCM::save_rules,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-schedule", &OpenPsiSCM::schedule,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-schedule-dynamics",
+    &OpenPsiSCM::schedule_dynamics, this, "openpsi");
+
+  define_scheme_primitive("psi-schedule-runs", &OpenPsiSCM::schedule_runs,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-schedule-trigger",
+    &OpenPsiSCM::schedule_trigger, this, "openpsi");
+
+  define_scheme_primitive("psi-schedule-triggers",
+    &OpenPsiSCM::schedule_triggers, this, "openpsi");
+
+  define_scheme_primitive("psi-schedule-wake", &OpenPsiSCM::schedule_wake,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-scheduler-halt", &OpenPsiSCM::scheduler_halt,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-scheduler-run", &OpenPsiSCM::scheduler_run,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-scheduler-running?",
+    &OpenPsiSCM::scheduler_is_running, this, "openpsi");
+
+  define_scheme_primitive("psi-scheduler-step", &OpenPsiSCM::scheduler_step,
+    this, "openpsi");
+
+  define_scheme_primitive("psi-unschedule", &OpenPsiSCM::unschedule,
+    this, "openpsi");
 }
 
 TruthValuePtr OpenPsiSCM::was_action_executed(const Handle& rule)
@@ -88,9 +201,6 @@ Handle OpenPsiSCM::add_rule(const HandleSeq& context, const Handle& action,
   const Handle& goal, const TruthValuePtr stv, const Handle& category)
 {
   AtomSpace* as = SchemeSmob::ss_get_env_as("psi-rule");
-  // TODO: Should this be a singleton? What could be the issues that need
-  // to be handled? How to handle multiple atomspace, maybe a singleton per
-  // atomspace?
   Handle rule = openpsi_cache(as).add_rule(context, action, goal, stv);
   // TODO: Add to multiple categories using scheme rest list.
   openpsi_cache(as).add_to_category(rule, category);
@@ -103,19 +213,80 @@ Handle OpenPsiSCM::add_to_category(const Handle& rule, const Handle& category)
   return openpsi_cache(as).add_to_category(rule, category);
 }
 
+static HandleSeq atoms_of(const ValuePtr& v)
+{
+  LinkValuePtr lv(LinkValueCast(v));
+  if (nullptr == lv)
+    throw InvalidParamException(TRACE_INFO,
+      "psi-add-rules: Expecting a LinkValue of atoms");
+
+  HandleSeq atoms;
+  for (const ValuePtr& a : lv->value()) {
+    Handle h(HandleCast(a));
+    if (nullptr == h)
+      throw InvalidParamException(TRACE_INFO,
+        "psi-add-rules: Expecting an atom, got %s", a->to_string().c_str());
+    atoms.push_back(h);
+  }
+  return atoms;
+}
+
+HandleSeq OpenPsiSCM::add_rules(const ValuePtr& rules)
+{
+  AtomSpace* as = SchemeSmob::ss_get_env_as("psi-add-rules");
+  LinkValuePtr lv(LinkValueCast(rules));
+  if (nullptr == lv)
+    throw InvalidParamException(TRACE_INFO,
+      "psi-add-rules: Expecting a LinkValue of rules");
+
+  std::vector<OpenPsiRules::RuleDecl> decls;
+  for (const ValuePtr& r : lv->value()) {
+    LinkValuePtr rv(LinkValueCast(r));
+    if (nullptr == rv or rv->value().size() < 5)
+      throw InvalidParamException(TRACE_INFO,
+        "psi-add-rules: Expecting a LinkValue of the context, action, "
+        "goal, TV and categories of a rule");
+    const std::vector<ValuePtr>& parts = rv->value();
+
+    OpenPsiRules::RuleDecl d;
+    d.context = atoms_of(parts[0]);
+    d.action = HandleCast(parts[1]);
+    d.goal = HandleCast(parts[2]);
+    d.stv = TruthValueCast(parts[3]);
+    if (nullptr == d.action or nullptr == d.goal or nullptr == d.stv)
+      throw InvalidParamException(TRACE_INFO,
+        "psi-add-rules: Expecting an action, a goal and a TV");
+    d.categories = atoms_of(parts[4]);
+
+    if (5 < parts.size()) {
+      LinkValuePtr groups(LinkValueCast(parts[5]));
+      if (nullptr == groups)
+        throw InvalidParamException(TRACE_INFO,
+          "psi-add-rules: Expecting a LinkValue of groups of terms");
+      d.has_terms = true;
+      for (const ValuePtr& g : groups->value())
+        d.term_groups.push_back(atoms_of(g));
+    }
+
+    decls.push_back(std::move(d));
+  }
+
+  return openpsi_cache(as).add_rules(decls);
+}
+
 Handle OpenPsiSCM::get_action(const Handle& rule)
 {
   AtomSpace* as = SchemeSmob::ss_get_env_as("psi-get-action");
   return openpsi_cache(as).get_action(rule);
 }
 
-HandleSeq& OpenPsiSCM::get_categories()
+HandleSeq OpenPsiSCM::get_categories()
 {
   AtomSpace* as = SchemeSmob::ss_get_env_as("psi-categories");
   return openpsi_cache(as).get_categories();
 }
 
-HandleSeq& OpenPsiSCM::get_context(const Handle& rule)
+HandleSeq OpenPsiSCM::get_context(const Handle& rule)
 {
   AtomSpace* as = SchemeSmob::ss_get_env_as("psi-get-context");
   return openpsi_cache(as).get_context(rule);
@@ -139,12 +310,272 @@ bool OpenPsiSCM::is_rule(const Handle& rule)
   return openpsi_cache(as).is_rule(rule);
 }
 
+HandleSeq OpenPsiSCM::get_triggered_rules(const HandleSeq& input)
+{
+  AtomSpace* as = SchemeSmob::ss_get_env_as("psi-rules-triggered-by");
+  return openpsi_cache(as).get_triggered_rules(input);
+}
+
+void OpenPsiSCM::add_rule_terms(const Handle& rule, const HandleSeq& terms)
+{
+  AtomSpace* as = SchemeSmob::ss_get_env_as("psi-add-rule-terms");
+  openpsi_cache(as).add_rule_terms(rule, terms);
+}
+
+HandleSeq OpenPsiSCM::get_rules_by_terms(const HandleSeq& input, int max)
+{
+  AtomSpace* as = SchemeSmob::ss_get_env_as("psi-rules-by-terms");
+  if (max < 0)
+    throw InvalidParamException(TRACE_INFO,
+      "psi-rules-by-terms: Expecting a number of rules, got %d", max);
+  return openpsi_cache(as).get_rules_by_terms(input, max);
+}
+
+int OpenPsiSCM::save_rules(const std::string& path)
+{
+  AtomSpace* as = SchemeSmob::ss_get_env_as("psi-save-rules");
+  return openpsi_cache(as).save(path);
+}
+
+int OpenPsiSCM::restore_rules(const std::string& path)
+{
+  AtomSpace* as = SchemeSmob::ss_get_env_as("psi-restore-rules");
+  return openpsi_cache(as).restore(path);
+}
+
 TruthValuePtr OpenPsiSCM::is_satisfiable(const Handle& rule)
 {
   AtomSpace *as = SchemeSmob::ss_get_env_as("psi-satisfiable?");
   return openpsi_implicator(as).check_satisfiability(rule, openpsi_cache(as));
 }
 
+ValuePtr OpenPsiSCM::is_satisfiable_batch(const HandleSeq& rules)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-satisfiable-batch");
+  std::vector<TruthValuePtr> tvs =
+    openpsi_implicator(as).check_satisfiability(rules, openpsi_cache(as));
+  return createLinkValue(std::vector<ValuePtr>(tvs.begin(), tvs.end()));
+}
+
+ValuePtr OpenPsiSCM::weigh_rules(const HandleSeq& rules,
+  double strength_weight, double context_weight, double sti_weight,
+  double urge_weight)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-rule-weights");
+  OpenPsiSelector::Weights weights =
+    {strength_weight, context_weight, sti_weight, urge_weight};
+  return createFloatValue(openpsi_selector(as).weigh(rules, weights,
+    openpsi_cache(as), openpsi_implicator(as)));
+}
+
+Handle OpenPsiSCM::sample_rule(const HandleSeq& rules,
+  const ValuePtr& weights)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-sample-by-weight");
+  FloatValuePtr fv(FloatValueCast(weights));
+  if (nullptr == fv)
+    throw InvalidParamException(TRACE_INFO,
+      "psi-sample-by-weight: Expecting a FloatValue of weights");
+  return openpsi_selector(as).sample(rules, fv->value());
+}
+
+void OpenPsiSCM::dynamics_add_variable(const Handle& var, double baseline)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-dynamics-add-variable");
+  openpsi_dynamics(as).add_variable(var, baseline);
+}
+
+void OpenPsiSCM::dynamics_add_event(const Handle& event)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-dynamics-add-event");
+  openpsi_dynamics(as).add_event(event);
+}
+
+void OpenPsiSCM::dynamics_add_rule(const Handle& trigger,
+  const Handle& change, const Handle& target, double strength)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-dynamics-add-rule");
+  openpsi_dynamics(as).add_rule(trigger, change, target, strength);
+}
+
+void OpenPsiSCM::dynamics_add_rhythm(const Handle& var, double amplitude,
+  double frequency, double offset)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-dynamics-add-rhythm");
+  openpsi_dynamics(as).add_rhythm(var, amplitude, frequency, offset);
+}
+
+void OpenPsiSCM::dynamics_add_noise(const Handle& var, double width)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-dynamics-add-noise");
+  openpsi_dynamics(as).add_noise(var, width);
+}
+
+void OpenPsiSCM::dynamics_clear()
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-dynamics-clear");
+  openpsi_dynamics(as).clear();
+}
+
+void OpenPsiSCM::dynamics_step()
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-dynamics-step");
+  openpsi_dynamics(as).step();
+}
+
+void OpenPsiSCM::dynamics_run(int period)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-dynamics-run");
+  if (period < 0)
+    throw InvalidParamException(TRACE_INFO,
+      "psi-dynamics-run: Expecting a period of 0 or more msecs, got %d",
+      period);
+  openpsi_dynamics(as).run(period);
+}
+
+void OpenPsiSCM::dynamics_halt()
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-dynamics-halt");
+  openpsi_dynamics(as).halt();
+}
+
+bool OpenPsiSCM::dynamics_is_running()
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-dynamics-running?");
+  return openpsi_dynamics(as).is_running();
+}
+
+void OpenPsiSCM::schedule(const Handle& behavior, int timeout,
+  int min_period)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-schedule");
+  if (timeout < 0 or min_period < 0)
+    throw InvalidParamException(TRACE_INFO,
+      "psi-schedule: Expecting periods of 0 or more msecs, got %d and %d",
+      timeout, min_period);
+  openpsi_scheduler(as).add_task(behavior, timeout, min_period);
+}
+
+void OpenPsiSCM::unschedule(const Handle& behavior)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-unschedule");
+  openpsi_scheduler(as).remove_task(behavior);
+}
+
+void OpenPsiSCM::schedule_trigger(const Handle& behavior,
+  const Handle& trigger)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-schedule-trigger");
+  openpsi_scheduler(as).add_trigger(behavior, trigger);
+}
+
+HandleSeq OpenPsiSCM::schedule_triggers(const Handle& behavior)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-schedule-triggers");
+  return openpsi_scheduler(as).get_triggers(behavior);
+}
+
+void OpenPsiSCM::schedule_wake(const Handle& behavior)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-schedule-wake");
+  openpsi_scheduler(as).wake(behavior);
+}
+
+int OpenPsiSCM::schedule_runs(const Handle& behavior)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-schedule-runs");
+  return openpsi_scheduler(as).get_runs(behavior);
+}
+
+void OpenPsiSCM::schedule_dynamics(int period)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-schedule-dynamics");
+  if (period < 0)
+    throw InvalidParamException(TRACE_INFO,
+      "psi-schedule-dynamics: Expecting a period of 0 or more msecs, "
+      "got %d", period);
+  openpsi_scheduler(as).set_dynamics_period(period);
+}
+
+int OpenPsiSCM::scheduler_step()
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-scheduler-step");
+  return openpsi_scheduler(as).run_pending();
+}
+
+void OpenPsiSCM::scheduler_run()
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-scheduler-run");
+  openpsi_scheduler(as).run();
+}
+
+void OpenPsiSCM::scheduler_halt()
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-scheduler-halt");
+  openpsi_scheduler(as).halt();
+}
+
+bool OpenPsiSCM::scheduler_is_running()
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-scheduler-running?");
+  return openpsi_scheduler(as).is_running();
+}
+
+ValuePtr OpenPsiSCM::profile(int n)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-profile");
+  if (n < 0)
+    throw InvalidParamException(TRACE_INFO,
+      "psi-profile: Expecting a number of rules, got %d", n);
+
+  std::vector<ValuePtr> entries;
+  for (const auto& rs : openpsi_implicator(as).profiler().top(n)) {
+    const OpenPsiProfiler::RuleStats& stats = rs.second;
+    entries.push_back(createLinkValue(std::vector<ValuePtr>({ValueCast(rs.first),
+      createFloatValue(std::vector<double>({(double) stats.checked,
+        (double) stats.satisfied, stats.match_time, stats.imply_time}))})));
+  }
+  return createLinkValue(entries);
+}
+
+void OpenPsiSCM::profile_enable(bool on)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-profile-enable");
+  openpsi_implicator(as).profiler().enable(on);
+}
+
+void OpenPsiSCM::profile_reset()
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-profile-reset");
+  openpsi_implicator(as).profiler().reset();
+}
+
+void OpenPsiSCM::profile_record_step(double secs)
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-profile-record-step");
+  OpenPsiProfiler& profiler = openpsi_implicator(as).profiler();
+  if (profiler.is_enabled()) profiler.record_step(secs);
+}
+
+ValuePtr OpenPsiSCM::profile_steps()
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-profile-steps");
+  OpenPsiProfiler::StepStats stats =
+    openpsi_implicator(as).profiler().steps();
+  return createFloatValue(std::vector<double>({(double) stats.steps,
+    stats.total_time, stats.max_time}));
+}
+
+void OpenPsiSCM::release()
+{
+  AtomSpace *as = SchemeSmob::ss_get_env_as("psi-release");
+  openpsi_scheduler_release(as);
+  openpsi_dynamics_release(as);
+  openpsi_selector_release(as);
+  openpsi_implicator_release(as);
+  openpsi_cache_release(as);
+}
+
 OpenPsiSCM& opencog::get_openpsi_scm() {
   static OpenPsiSCM openpsi;
   return openpsi;
@@ -45,6 +45,17 @@ public:
 
   Handle add_to_category(const Handle& rule, const Handle& category);
 
+  /**
+   * A wrapper around OpenPsiRules::add_rules.
+   *
+   * @param rules A LinkValue of the rules, each a LinkValue of a
+   *  LinkValue of its context, its action, its goal, its TV, a LinkValue
+   *  of its categories and, optionally, a LinkValue of LinkValues of
+   *  its groups of terms.
+   * @return The psi-rules, in the same order.
+   */
+  HandleSeq add_rules(const ValuePtr& rules);
+
   /**
    * Get the action of the given rule.
    *
@@ -58,7 +69,7 @@ public:
    *
    * @return A vector of Handles that represent the categories.
    */
-  HandleSeq& get_categories();
+  HandleSeq get_categories();
 
   /**
    * Get the context of the given rule.
@@ -66,7 +77,7 @@ public:
    * @param rule A psi-rule.
    * @return A vector of atoms that form the context of the given rule.
    */
-  HandleSeq& get_context(const Handle& rule);
+  HandleSeq get_context(const Handle& rule);
 
   /**
    * Get the goal of the given rule.
@@ -99,6 +110,30 @@ public:
    */
   bool is_rule(const Handle& rule);
 
+  /**
+   * A wrapper around OpenPsiRules::get_triggered_rules.
+   *
+   * @param input The atoms of the current input.
+   * @return The rules that could be triggered by the input.
+   */
+  HandleSeq get_triggered_rules(const HandleSeq& input);
+
+  /**
+   * Wrappers around OpenPsiRules::add_rule_terms and
+   * OpenPsiRules::get_rules_by_terms.
+   */
+  void add_rule_terms(const Handle& rule, const HandleSeq& terms);
+  HandleSeq get_rules_by_terms(const HandleSeq& input, int max);
+
+  /**
+   * Wrappers around OpenPsiRules::save and OpenPsiRules::restore.
+   *
+   * @param path The rule file.
+   * @return The number of rules written or restored.
+   */
+  int save_rules(const std::string& path);
+  int restore_rules(const std::string& path);
+
   /**
    * Returns TRUE_TV or FALSE_TV depending on whether the context of the
    * given psi-rule is satisfiable or not.
@@ -107,6 +142,92 @@ public:
    */
   TruthValuePtr is_satisfiable(const Handle& rule);
 
+  /**
+   * The same as is_satisfiable, for many psi-rules at once; their
+   * contexts are searched concurrently.
+   *
+   * @param rules Psi-rules.
+   * @return A LinkValue of the TVs of the rules, in the same order.
+   */
+  ValuePtr is_satisfiable_batch(const HandleSeq& rules);
+
+  /**
+   * A wrapper around OpenPsiSelector::weigh.
+   *
+   * @param rules Psi-rules.
+   * @param strength_weight, context_weight, sti_weight, urge_weight
+   *  The weights of the factors of the weight of a rule.
+   * @return A FloatValue of the weights of the rules, in the same order.
+   */
+  ValuePtr weigh_rules(const HandleSeq& rules, double strength_weight,
+    double context_weight, double sti_weight, double urge_weight);
+
+  /**
+   * A wrapper around OpenPsiSelector::sample.
+   *
+   * @param rules Psi-rules.
+   * @param weights A FloatValue of their weights, as from weigh_rules.
+   * @return The rule picked, or the empty list if none has any weight.
+   */
+  Handle sample_rule(const HandleSeq& rules, const ValuePtr& weights);
+
+  /**
+   * Wrappers around the OpenPsiDynamics of the current atomspace.
+   */
+  void dynamics_add_variable(const Handle& var, double baseline);
+  void dynamics_add_event(const Handle& event);
+  void dynamics_add_rule(const Handle& trigger, const Handle& change,
+    const Handle& target, double strength);
+  void dynamics_add_rhythm(const Handle& var, double amplitude,
+    double frequency, double offset);
+  void dynamics_add_noise(const Handle& var, double width);
+  void dynamics_clear();
+  void dynamics_step();
+  void dynamics_run(int period);
+  void dynamics_halt();
+  bool dynamics_is_running();
+
+  /**
+   * Wrappers around the OpenPsiProfiler of the current atomspace.
+   *
+   * @param n The number of rules to return.
+   * @return A LinkValue of the n costliest rules, each a LinkValue of
+   *  the rule and a FloatValue of the number of times it was checked,
+   *  the number of times it was satisfiable, and the secs spent checking
+   *  and implying it.
+   */
+  ValuePtr profile(int n);
+  void profile_enable(bool on);
+  void profile_reset();
+  void profile_record_step(double secs);
+
+  /**
+   * @return A FloatValue of the number of steps recorded, and the total
+   *  and the most secs they took.
+   */
+  ValuePtr profile_steps();
+
+  /**
+   * Wrappers around the OpenPsiScheduler of the current atomspace.
+   */
+  void schedule(const Handle& behavior, int timeout, int min_period);
+  void unschedule(const Handle& behavior);
+  void schedule_trigger(const Handle& behavior, const Handle& trigger);
+  HandleSeq schedule_triggers(const Handle& behavior);
+  void schedule_wake(const Handle& behavior);
+  int schedule_runs(const Handle& behavior);
+  void schedule_dynamics(int period);
+  int scheduler_step();
+  void scheduler_run();
+  void scheduler_halt();
+  bool scheduler_is_running();
+
+  /**
+   * Delete the rules and caches kept for the current atomspace. This
+   * has to be done before the atomspace is deleted.
+   */
+  void release();
+
   // ========================================================
   // Boilerplate code.
   // ========================================================
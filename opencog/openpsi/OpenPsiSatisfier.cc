@@ -30,10 +30,12 @@
 using namespace opencog;
 
 OpenPsiSatisfier::OpenPsiSatisfier(AtomSpace* as,
-                                   OpenPsiImplicator* implicator) :
+                                   OpenPsiImplicator* implicator,
+                                   unsigned long generation) :
   Satisfier(as)
 {
   _implicator = implicator;
+  _generation = generation;
 }
 
 bool OpenPsiSatisfier::grounding(const HandleMap &var_soln,
@@ -59,7 +61,7 @@ bool OpenPsiSatisfier::grounding(const HandleMap &var_soln,
     // such cases be handled?
 
     // Store the result in cache.
-    _implicator -> _satisfiability_cache[_pattern_body] = var_soln;
+    _implicator->cache_grounding(_pattern_body, var_soln, _generation);
 
     // NOTE: If a single grounding is found then why search for more? If there
     // is an issue with instantiating the implicand then there is an issue with
@@ -70,7 +72,7 @@ bool OpenPsiSatisfier::grounding(const HandleMap &var_soln,
     // This happens when InitiateSearchCB::no_search has groundings -- when
     // there is only constant (probably evaluatable) but no variable in the
     // pattern
-    _implicator -> _satisfiability_cache[_pattern_body] = var_soln;
+    _implicator->cache_grounding(_pattern_body, var_soln, _generation);
     return true;
   } else {
     // TODO: This happens when InitiateSearchCB::no_search has groundings.
@@ -42,7 +42,8 @@ class OpenPsiSatisfier : public Satisfier
 public:
 
 OpenPsiSatisfier(AtomSpace* as,
-                 OpenPsiImplicator* implicator);
+                 OpenPsiImplicator* implicator,
+                 unsigned long generation);
 
   /**
    * Return true if a single grounding has been found.
@@ -54,6 +55,9 @@ OpenPsiSatisfier(AtomSpace* as,
 
   OpenPsiImplicator* _implicator;
 
+  // That of the search, given back with the grounding found
+  unsigned long _generation;
+
   // Because two of the ancestor classes that this class inherites
   // from have _as variable.
   using TermMatchMixin::_as;
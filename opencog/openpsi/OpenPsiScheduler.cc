@@ -0,0 +1,319 @@
+/*
+ * OpenPsiScheduler.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/atoms/core/DefineLink.h>
+#include <opencog/atoms/execution/EvaluationLink.h>
+#include <opencog/util/Logger.h>
+
+#include "OpenPsiDynamics.h"
+#include "OpenPsiScheduler.h"
+#include "PerAtomSpace.h"
+
+using namespace opencog;
+
+OpenPsiScheduler::OpenPsiScheduler(AtomSpace* as) :
+  _as(as), _woken(false), _dynamics_period(Clock::duration::zero()),
+  _running(false)
+{
+  _add_conn = _as->atomAddedSignal().connect(
+    [this](const Handle& h) { changed(h); });
+  _remove_conn = _as->atomRemovedSignal().connect(
+    [this](const AtomPtr& a) { changed(Handle(a)); });
+  _tv_conn = _as->TVChangedSignal().connect(
+    [this](const Handle& h, const TruthValuePtr&, const TruthValuePtr&)
+    { changed(h); });
+}
+
+OpenPsiScheduler::~OpenPsiScheduler()
+{
+  halt();
+  _as->atomAddedSignal().disconnect(_add_conn);
+  _as->atomRemovedSignal().disconnect(_remove_conn);
+  _as->TVChangedSignal().disconnect(_tv_conn);
+}
+
+/**
+ * The Eva models keep their state in StateLinks of AnchorNodes, and
+ * their facts in EvaluationLinks of PredicateNodes. Other nodes, such
+ * as the ConceptNodes that are the values of the states, would wake the
+ * behaviors for changes that have nothing to do with them.
+ */
+void OpenPsiScheduler::find_triggers(const Handle& behavior,
+  HandleSet& triggers)
+{
+  HandleSet defined;
+  HandleSeq todo({behavior});
+  while (not todo.empty()) {
+    Handle h(todo.back());
+    todo.pop_back();
+
+    Type t = h->get_type();
+    if (h->is_link()) {
+      for (const Handle& out : h->getOutgoingSet())
+        todo.push_back(out);
+    } else if (ANCHOR_NODE == t or PREDICATE_NODE == t) {
+      triggers.insert(h);
+    } else if ((DEFINED_PREDICATE_NODE == t or DEFINED_SCHEMA_NODE == t)
+               and defined.insert(h).second) {
+      // The main loop of the behavior tree is defined with itself.
+      try {
+        todo.push_back(DefineLink::get_definition(h));
+      } catch (const std::exception&) {
+        // Not defined yet; it can't be evaluated either.
+      }
+    }
+  }
+}
+
+void OpenPsiScheduler::add_task(const Handle& behavior, unsigned timeout,
+  unsigned min_period)
+{
+  HandleSet triggers;
+  find_triggers(behavior, triggers);
+
+  std::lock_guard<std::mutex> lck(_mtx);
+  auto it = _tasks.find(behavior);
+  if (it == _tasks.end()) {
+    Task task;
+    task.last_run = Clock::time_point();
+    task.changed = true;
+    task.runs = 0;
+    it = _tasks.emplace(behavior, task).first;
+  }
+
+  Task& task = it->second;
+  task.timeout = std::chrono::milliseconds(timeout);
+  task.min_period = std::chrono::milliseconds(min_period);
+  for (const Handle& trigger : triggers) {
+    task.triggers.insert(trigger);
+    _behaviors_of[trigger].insert(behavior);
+  }
+
+  _woken = true;
+  _cv.notify_one();
+}
+
+void OpenPsiScheduler::remove_task(const Handle& behavior)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  auto it = _tasks.find(behavior);
+  if (it == _tasks.end()) return;
+
+  for (const Handle& trigger : it->second.triggers) {
+    HandleSet& behaviors = _behaviors_of[trigger];
+    behaviors.erase(behavior);
+    if (behaviors.empty()) _behaviors_of.erase(trigger);
+  }
+  _tasks.erase(it);
+}
+
+void OpenPsiScheduler::add_trigger(const Handle& behavior,
+  const Handle& trigger)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  auto it = _tasks.find(behavior);
+  if (it == _tasks.end()) return;
+
+  it->second.triggers.insert(trigger);
+  _behaviors_of[trigger].insert(behavior);
+}
+
+HandleSeq OpenPsiScheduler::get_triggers(const Handle& behavior)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  auto it = _tasks.find(behavior);
+  if (it == _tasks.end()) return HandleSeq();
+  return HandleSeq(it->second.triggers.begin(), it->second.triggers.end());
+}
+
+void OpenPsiScheduler::wake(const Handle& behavior)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  for (auto& bt : _tasks)
+    if (nullptr == behavior or bt.first == behavior)
+      bt.second.changed = true;
+
+  _woken = true;
+  _cv.notify_one();
+}
+
+size_t OpenPsiScheduler::get_runs(const Handle& behavior)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  auto it = _tasks.find(behavior);
+  return it == _tasks.end() ? 0 : it->second.runs;
+}
+
+void OpenPsiScheduler::set_dynamics_period(unsigned period)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  _dynamics_period = std::chrono::milliseconds(period);
+  _woken = true;
+  _cv.notify_one();
+}
+
+/**
+ * These come from the thread that made the change, which may be the
+ * one evaluating a behavior; the behavior is then evaluated again, once
+ * its min_period is up, as what it did may have made another of its
+ * conditions true.
+ */
+void OpenPsiScheduler::changed(const Handle& h)
+{
+  std::lock_guard<std::mutex> lck(_mtx);
+  if (_behaviors_of.empty()) return;
+
+  bool any = false;
+  auto mark = [&](const Handle& trigger) {
+    auto it = _behaviors_of.find(trigger);
+    if (it == _behaviors_of.end()) return;
+    for (const Handle& behavior : it->second)
+      _tasks[behavior].changed = true;
+    any = true;
+  };
+
+  mark(h);
+  if (h->is_link())
+    for (const Handle& out : h->getOutgoingSet())
+      mark(out);
+
+  if (any) {
+    _woken = true;
+    _cv.notify_one();
+  }
+}
+
+OpenPsiScheduler::Clock::time_point
+OpenPsiScheduler::due(const Task& task) const
+{
+  if (task.changed) return task.last_run + task.min_period;
+  if (Clock::duration::zero() < task.timeout)
+    return task.last_run + task.timeout;
+  return Clock::time_point::max();
+}
+
+OpenPsiScheduler::Clock::time_point OpenPsiScheduler::next_due() const
+{
+  Clock::time_point next = Clock::time_point::max();
+  for (const auto& bt : _tasks)
+    next = std::min(next, due(bt.second));
+  if (Clock::duration::zero() < _dynamics_period)
+    next = std::min(next, _last_dynamics + _dynamics_period);
+  return next;
+}
+
+void OpenPsiScheduler::evaluate(const Handle& behavior)
+{
+  try {
+    EvaluationLink::do_evaluate(_as, behavior);
+  } catch (const std::exception& ex) {
+    logger().warn("[OpenPsiScheduler] %s failed: %s",
+      behavior->to_short_string().c_str(), ex.what());
+  }
+}
+
+size_t OpenPsiScheduler::run_pending()
+{
+  HandleSeq behaviors;
+  bool step_dynamics = false;
+  {
+    std::lock_guard<std::mutex> lck(_mtx);
+    Clock::time_point now = Clock::now();
+
+    // They are marked as run before they are, so that the changes they
+    // make mark them again.
+    for (auto& bt : _tasks) {
+      Task& task = bt.second;
+      if (now < due(task)) continue;
+      task.changed = false;
+      task.last_run = now;
+      task.runs++;
+      behaviors.push_back(bt.first);
+    }
+
+    if (Clock::duration::zero() < _dynamics_period and
+        _last_dynamics + _dynamics_period <= now) {
+      _last_dynamics = now;
+      step_dynamics = true;
+    }
+  }
+
+  if (step_dynamics) openpsi_dynamics(_as).step();
+  for (const Handle& behavior : behaviors)
+    evaluate(behavior);
+
+  return behaviors.size();
+}
+
+void OpenPsiScheduler::run()
+{
+  if (_running.exchange(true)) return;
+  if (_loop.joinable()) _loop.join();
+
+  _loop = std::thread([this]() {
+    while (_running) {
+      run_pending();
+
+      std::unique_lock<std::mutex> lck(_mtx);
+      Clock::time_point next = next_due();
+      if (not _woken and _running) {
+        if (Clock::time_point::max() == next)
+          _cv.wait(lck, [this]() { return _woken or not _running; });
+        else
+          _cv.wait_until(lck, next,
+            [this]() { return _woken or not _running; });
+      }
+      _woken = false;
+    }
+  });
+}
+
+void OpenPsiScheduler::halt()
+{
+  {
+    std::lock_guard<std::mutex> lck(_mtx);
+    _running = false;
+    _cv.notify_one();
+  }
+  if (_loop.joinable() and _loop.get_id() != std::this_thread::get_id())
+    _loop.join();
+}
+
+bool OpenPsiScheduler::is_running() const
+{
+  return _running;
+}
+
+static PerAtomSpace<OpenPsiScheduler>& openpsi_schedulers()
+{
+  static PerAtomSpace<OpenPsiScheduler> instances;
+  return instances;
+}
+
+OpenPsiScheduler& opencog::openpsi_scheduler(AtomSpace* as)
+{
+  return openpsi_schedulers().get(as);
+}
+
+void opencog::openpsi_scheduler_release(AtomSpace* as)
+{
+  openpsi_schedulers().release(as);
+}
@@ -0,0 +1,159 @@
+/*
+ * OpenPsiScheduler.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_OPENPSI_SCHEDULER_H
+#define _OPENCOG_OPENPSI_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+
+/**
+ * Evaluates behaviors, such as the steps of the Eva behavior tree, only
+ * when something they depend on has changed, or when they have waited
+ * long enough, instead of in a loop that evaluates them all the time.
+ *
+ * A behavior is an evaluatable atom, usually a DefinedPredicate. It
+ * depends on the AnchorNodes and PredicateNodes found in it and in the
+ * definitions of the DefinedPredicates and DefinedSchemas it uses, and
+ * on any atom given to add_trigger; a change is a link with one of them
+ * in its outgoing set being added, removed or getting a new TV, as when
+ * a StateLink of an anchor is changed. What a GroundedPredicate looks
+ * at can't be known; that is what the timeout is for.
+ *
+ * The openpsi dynamics can be stepped from the same thread, so that an
+ * idle robot has one thread waiting on a timer rather than two loops.
+ */
+class OpenPsiScheduler
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  OpenPsiScheduler(AtomSpace* as);
+  ~OpenPsiScheduler();
+
+  /**
+   * Evaluate the behavior after something it depends on has changed,
+   * but no sooner than min_period milliseconds after the last time, and
+   * at least every timeout milliseconds even if nothing has changed; 0
+   * is for no timeout. A behavior is evaluated once when it is added,
+   * and adding it again changes its periods.
+   */
+  void add_task(const Handle& behavior, unsigned timeout,
+    unsigned min_period);
+  void remove_task(const Handle& behavior);
+
+  /**
+   * Also evaluate the behavior when a link with the atom in it changes,
+   * e.g. for an atom that a GroundedPredicate of the behavior reads.
+   */
+  void add_trigger(const Handle& behavior, const Handle& trigger);
+  HandleSeq get_triggers(const Handle& behavior);
+
+  /**
+   * Evaluate the behavior as though something it depends on changed,
+   * e.g. after changing a Value, which the atomspace doesn't tell of;
+   * the undefined handle is for all of them.
+   */
+  void wake(const Handle& behavior);
+
+  // The number of times the behavior was evaluated.
+  size_t get_runs(const Handle& behavior);
+
+  /**
+   * Step the openpsi dynamics of the atomspace every period
+   * milliseconds, from the thread of run(); 0 is for not stepping them.
+   */
+  void set_dynamics_period(unsigned period);
+
+  /**
+   * Evaluate the behaviors that are due, and step the dynamics if
+   * they are, in this thread.
+   *
+   * @return The number of behaviors evaluated.
+   */
+  size_t run_pending();
+
+  /**
+   * Call run_pending() in a thread of its own, whenever something is
+   * due, until halt() is called.
+   */
+  void run();
+  void halt();
+  bool is_running() const;
+
+private:
+  struct Task
+  {
+    Clock::duration timeout;
+    Clock::duration min_period;
+    Clock::time_point last_run;
+    bool changed;
+    size_t runs;
+    HandleSet triggers;
+  };
+
+  // When the task is next due; max() for never.
+  Clock::time_point due(const Task& task) const;
+  Clock::time_point next_due() const;
+
+  void find_triggers(const Handle& behavior, HandleSet& triggers);
+  void changed(const Handle& h);
+  void evaluate(const Handle& behavior);
+
+  AtomSpace* _as;
+
+  // Held while the tasks are looked at, not while they are evaluated,
+  // so that the changes they make can mark them again.
+  std::mutex _mtx;
+  std::condition_variable _cv;
+  bool _woken;
+
+  std::unordered_map<Handle, Task> _tasks;
+  std::unordered_map<Handle, HandleSet> _behaviors_of;
+
+  Clock::duration _dynamics_period;
+  Clock::time_point _last_dynamics;
+
+  int _add_conn;
+  int _remove_conn;
+  int _tv_conn;
+
+  std::atomic<bool> _running;
+  std::thread _loop;
+};
+
+// These are used to get the instance for the AtomSpace, and to delete
+// it, which has to be done before the AtomSpace is deleted.
+OpenPsiScheduler& openpsi_scheduler(AtomSpace* as);
+void openpsi_scheduler_release(AtomSpace* as);
+
+} // namespace opencog
+
+#endif // _OPENCOG_OPENPSI_SCHEDULER_H
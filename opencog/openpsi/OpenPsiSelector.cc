@@ -0,0 +1,139 @@
+/*
+ * OpenPsiSelector.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/util/RandGen.h>
+#include <opencog/util/exceptions.h>
+
+#include "OpenPsiSelector.h"
+#include "PerAtomSpace.h"
+
+using namespace opencog;
+
+OpenPsiSelector::OpenPsiSelector(AtomSpace* as) : _as(as)
+{
+  // The keys used by psi-set-gv! and psi-set-dgv!
+  _gv_key = _as->add_node(PREDICATE_NODE, "value");
+  _dgv_key = _as->add_node(PREDICATE_NODE, "desired-goal-value");
+}
+
+double OpenPsiSelector::urge(const Handle& goal)
+{
+  FloatValuePtr gv(FloatValueCast(goal->getValue(_gv_key)));
+  FloatValuePtr dgv(FloatValueCast(goal->getValue(_dgv_key)));
+  if (nullptr == gv or nullptr == dgv or
+      gv->value().empty() or dgv->value().empty())
+    throw RuntimeException(TRACE_INFO, "Goal \"%s\" has not been created?",
+      goal->get_name().c_str());
+
+  return dgv->value()[0] - gv->value()[0];
+}
+
+std::vector<double> OpenPsiSelector::weigh(const HandleSeq& rules,
+  const Weights& weights, OpenPsiRules& opr, OpenPsiImplicator& opi)
+{
+  std::vector<double> result(rules.size(), 0.0);
+
+  // Skip the rules with no STI or strength, unless these aren't weighed.
+  HandleSeq accepted;
+  std::vector<size_t> slots;
+  std::vector<double> stis;
+  for (size_t i = 0; i < rules.size(); i++) {
+    const Handle& rule = rules[i];
+    double sti = (0 < weights.sti) ? get_sti(rule) : 0.0;
+    if (0 < weights.sti and sti <= 0) continue;
+    if (0 < weights.strength and rule->getTruthValue()->get_mean() <= 0)
+      continue;
+
+    accepted.push_back(rule);
+    slots.push_back(i);
+    stis.push_back(sti);
+  }
+
+  std::vector<TruthValuePtr> sats = opi.check_satisfiability(accepted, opr);
+
+  for (size_t j = 0; j < accepted.size(); j++) {
+    const Handle& rule = accepted[j];
+    double w = 1.0;
+    if (0 < weights.strength)
+      w *= weights.strength * rule->getTruthValue()->get_mean();
+    if (0 < weights.context)
+      w *= weights.context * sats[j]->get_mean();
+    if (0 < weights.sti)
+      w *= weights.sti * stis[j];
+    if (0 < weights.urge)
+      w *= weights.urge * urge(opr.get_goal(rule));
+    result[slots[j]] = w;
+  }
+
+  return result;
+}
+
+Handle OpenPsiSelector::sample(const HandleSeq& rules,
+  const std::vector<double>& weights)
+{
+  if (rules.size() != weights.size())
+    throw InvalidParamException(TRACE_INFO,
+      "Expected a weight for each of the %zu rules, got %zu",
+      rules.size(), weights.size());
+
+  // cumulative[i] is the sum of the weights of the rules up to i.
+  std::vector<double> cumulative;
+  cumulative.reserve(weights.size());
+  double total = 0.0;
+  for (double w : weights) {
+    if (0 < w) total += w;
+    cumulative.push_back(total);
+  }
+  if (total <= 0) return Handle::UNDEFINED;
+
+  // The first rule whose sum is past the cutoff; a rule with no weight
+  // has the same sum as the one before it, so it can't be the first.
+  double cutoff = total * randGen().randdouble();
+  size_t i = std::upper_bound(cumulative.begin(), cumulative.end(), cutoff)
+    - cumulative.begin();
+
+  // Only if randdouble() rounds up to 1.
+  if (i == cumulative.size())
+    i = std::lower_bound(cumulative.begin(), cumulative.end(), total)
+      - cumulative.begin();
+
+  return rules[i];
+}
+
+static PerAtomSpace<OpenPsiSelector>& openpsi_selectors()
+{
+  static PerAtomSpace<OpenPsiSelector> instances;
+  return instances;
+}
+
+OpenPsiSelector& opencog::openpsi_selector(AtomSpace* as)
+{
+  return openpsi_selectors().get(as);
+}
+
+void opencog::openpsi_selector_release(AtomSpace* as)
+{
+  openpsi_selectors().release(as);
+}
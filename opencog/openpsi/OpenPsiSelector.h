@@ -0,0 +1,92 @@
+/*
+ * OpenPsiSelector.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_OPENPSI_SELECTOR_H
+#define _OPENCOG_OPENPSI_SELECTOR_H
+
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/openpsi/OpenPsiImplicator.h>
+#include <opencog/openpsi/OpenPsiRules.h>
+
+namespace opencog
+{
+
+/**
+ * Weighs psi-rules for the goal-driven action selection, and picks one
+ * of them at random by their weights. The weight of a rule is
+ *
+ *    Wr = Scag * Sc * Icag * Ug
+ *
+ * where Scag is the strength of the rule, Sc the satisfiability of its
+ * context, Icag the STI of the rule, and Ug the urge of its goal. Each
+ * factor is multiplied by its own weight; a factor whose weight is 0 is
+ * left out.
+ */
+class OpenPsiSelector
+{
+public:
+  struct Weights
+  {
+    double strength;
+    double context;
+    double sti;
+    double urge;
+  };
+
+  OpenPsiSelector(AtomSpace* as);
+
+  /**
+   * Returns the weight of each rule, in the same order. A rule with no
+   * STI or strength, when these are weighed, gets 0 without having its
+   * context checked. The contexts of the other rules are checked all at
+   * once, so that each is only searched once, and so that the rules can
+   * be implied afterwards.
+   */
+  std::vector<double> weigh(const HandleSeq& rules, const Weights& weights,
+    OpenPsiRules& opr, OpenPsiImplicator& opi);
+
+  /**
+   * Pick one of the rules at random, with the chance of each being its
+   * share of the sum of the weights. Rules with no weight are never
+   * picked; Handle::UNDEFINED is returned if none has any.
+   */
+  Handle sample(const HandleSeq& rules, const std::vector<double>& weights);
+
+private:
+  // The urge of the goal, which is its desired-goal-value less its
+  // goal-value, as psi-urge returns.
+  double urge(const Handle& goal);
+
+  AtomSpace* _as;
+  Handle _gv_key;
+  Handle _dgv_key;
+};
+
+// These are used to get the instance for the AtomSpace, and to delete
+// it, which has to be done before the AtomSpace is deleted.
+OpenPsiSelector& openpsi_selector(AtomSpace* as);
+void openpsi_selector_release(AtomSpace* as);
+
+} // namespace opencog
+
+#endif // _OPENCOG_OPENPSI_SELECTOR_H
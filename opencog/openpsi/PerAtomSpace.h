@@ -0,0 +1,76 @@
+/*
+ * PerAtomSpace.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_OPENPSI_PER_ATOMSPACE_H
+#define _OPENCOG_OPENPSI_PER_ATOMSPACE_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+
+/**
+ * One T for each AtomSpace, made the first time it is asked for. This
+ * can be used from many threads at once; the Ts themselves are used by
+ * one thread at a time, e.g. the one stepping the conversation held by
+ * the AtomSpace.
+ *
+ * The AtomSpace can't tell when it is deleted, so release() has to be
+ * called before deleting it.
+ */
+template<class T>
+class PerAtomSpace
+{
+public:
+  T& get(AtomSpace* as)
+  {
+    std::lock_guard<std::mutex> lck(_mtx);
+    std::unique_ptr<T>& t = _instances[as];
+    if (nullptr == t) t.reset(new T(as));
+    return *t;
+  }
+
+  // The T is deleted after the lock is released, as deleting it may
+  // take a while.
+  void release(AtomSpace* as)
+  {
+    std::unique_ptr<T> t;
+    {
+      std::lock_guard<std::mutex> lck(_mtx);
+      auto it = _instances.find(as);
+      if (it == _instances.end()) return;
+      t = std::move(it->second);
+      _instances.erase(it);
+    }
+  }
+
+private:
+  std::mutex _mtx;
+  std::unordered_map<AtomSpace*, std::unique_ptr<T>> _instances;
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_OPENPSI_PER_ATOMSPACE_H
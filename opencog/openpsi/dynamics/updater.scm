@@ -64,6 +64,12 @@
 (define decay-rate .001)
 (define decay-factor (- 1 decay-rate))
 
+; Apply the interaction rules, and decay the modulators and secs, with the
+; native updater of libopenpsi, when all the rules are of a form it knows.
+; It gives the same results; decay-rate and the other parameters above are
+; compiled into it.
+(define psi-updater-use-native #t)
+
 ; --------------------------------------------------------------
 
 ; Todo: implement these tables in the atomspace
@@ -173,11 +179,83 @@
 	;	(let ((output-port (open-file "psilog.txt" "a")))
 	;		(format output-port "\n\n\n--- New Session ---\n\n")))
 
+	(set! psi-updater-native
+		(and psi-updater-use-native (psi-updater-native-init)))
+
 	;(format #t "psi-evals-with-change-pred: ~a\n" evals-with-change-pred)
 )
 
 ; ----------------------------------------------------------------------
 
+; #t when the native updater applies the rules; set by psi-updater-init.
+(define psi-updater-native #f)
+
+(define (psi-native-registration rule)
+"
+  Return a thunk that adds RULE to the native updater, or #f if RULE is
+  not of a form that the native updater knows.
+"
+	(define antecedent (gdr rule))
+	(define consequent (list-ref (cog-outgoing-set rule) 2))
+	(define (schema? name)
+		(and (equal? (cog-type consequent) 'ExecutionOutputLink)
+			(equal? (gar consequent) (GroundedSchema name))))
+	(define (args) (cog-outgoing-set (gdr consequent)))
+
+	(cond
+		((and (psi-changed-eval? antecedent)
+				(schema? "scm: adjust-psi-var-level"))
+			(let ((target (first (args)))
+			      (strength (cog-number (second (args))))
+			      (trigger (gadr antecedent)))
+				(lambda () (psi-dynamics-add-rule
+					trigger (gar antecedent) target strength))))
+		((and (equal? antecedent (TrueLink))
+				(schema? "scm: psi-ultradian-update"))
+			(let ((params (map cog-number (cdr (args)))))
+				(lambda () (apply psi-dynamics-add-rhythm
+					(car (args)) params))))
+		((and (equal? antecedent (TrueLink))
+				(schema? "scm: psi-noise-update"))
+			(lambda () (psi-dynamics-add-noise
+				(first (args)) (cog-number (second (args))))))
+		(else #f))
+)
+
+(define (psi-updater-native-init)
+"
+  Register the modulators, secs, monitored events and interaction rules
+  with the native updater. Returns #f, leaving it empty, if there is a
+  rule it doesn't know the form of, or if a value it would update isn't
+  kept in a StateLink.
+"
+	(define registrations
+		(map psi-native-registration (psi-get-interaction-rules)))
+	(define entities
+		(append psi-modulators-and-secs psi-monitored-events
+			(filter-map
+				(lambda (atom) (and (psi-changed-eval? atom) (gadr atom)))
+				(cog-filter-hypergraph psi-changed-eval?
+					(Set (psi-get-interaction-rules))))))
+
+	(psi-dynamics-clear)
+	(if (and (every identity registrations)
+			(every
+				(lambda (entity)
+					(equal? statelink (psi-value-representation-type entity)))
+				entities)
+			(every psi-get-baseline-value psi-modulators-and-secs))
+		(begin
+			(for-each
+				(lambda (var)
+					(psi-dynamics-add-variable var (psi-get-baseline-value var)))
+				psi-modulators-and-secs)
+			(for-each psi-dynamics-add-event psi-monitored-events)
+			(for-each (lambda (register) (register)) registrations)
+			#t)
+		#f)
+)
+
 (define (do-psi-updater-step)
 "
   Main function that executes the actions to be taken in every cycle.
@@ -312,8 +390,10 @@
 	(for-each set-new-event-status psi-monitored-events)
 
 	; Evaluate the monitored params and set "changed" predicates accordingly
+	; The native updater keeps the previous values of its own.
 	(set! changed-params '())
-	(for-each set-param-change-status psi-monitored-entities)
+	(if (not psi-updater-native)
+		(for-each set-param-change-status psi-monitored-entities))
 	;(format #t "\nchanged-params: ~a\n\n" changed-params)
 
 	; Check for changed PAUs, just for highlighting in test output
@@ -373,9 +453,11 @@
 
 	; Grab and evaluate the interaction rules
 	; todo: Could optimize by only calling rules containing the changed params
-	(let ((rules (psi-get-interaction-rules)))
-		(map psi-evaluate-interaction-rule rules)
-	)
+	(if psi-updater-native
+		(psi-dynamics-step)
+		(let ((rules (psi-get-interaction-rules)))
+			(map psi-evaluate-interaction-rule rules)
+		))
 
 	; Have OpenPsi trigger emotion expression updates after events are detected
 	; that impact modulator and sec variables
@@ -398,8 +480,9 @@
 						(apply psi-expression-callback '()))
 					(psi-set-value! psi-event-at-loop-num-node 0)))))
 
-	; Decay dynamic variable values toward their baselines
-	(for-each
+	; Decay dynamic variable values toward their baselines; the native
+	; updater has done so already.
+	(if (not psi-updater-native) (for-each
 		(lambda (entity)
 			(define new-value)
 			(define baseline (psi-get-baseline-value entity))
@@ -409,7 +492,7 @@
 			(set! new-value (+ baseline diff))
 			(psi-set-value! entity new-value))
 		psi-modulators-and-secs
-	)
+	))
 
 	; Update prev-value-table entries for the changed (monitored) params
 	(for-each
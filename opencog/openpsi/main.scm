@@ -199,7 +199,8 @@
     (cog-logger-debug opl "In component ~a finished evaluation of ~a"
       component rule))
 
-  (let ((lc (psi-loop-count component)))
+  (let ((lc (psi-loop-count component))
+        (start (get-internal-real-time)))
     (cog-set-value! component (Predicate "loop-count") (FloatValue (+ lc 1)))
 
     (cog-logger-debug opl
@@ -210,6 +211,8 @@
 
     (cog-logger-debug opl
       "In component ~a ending psi-step, loop-count = ~a" component lc)
+    (psi-profile-record-step (exact->inexact
+      (/ (- (get-internal-real-time) start) internal-time-units-per-second)))
     (stv 1 1) ; For continuing psi-run loop.
   )
 )
@@ -44,15 +44,51 @@
     ; C++ bindings from libopenpsi
     psi-action-executed?
     psi-add-category
+    psi-add-rule-terms
+    psi-add-rules
     psi-add-to-category
     psi-categories
+    psi-dynamics-add-event
+    psi-dynamics-add-noise
+    psi-dynamics-add-rhythm
+    psi-dynamics-add-rule
+    psi-dynamics-add-variable
+    psi-dynamics-clear
+    psi-dynamics-halt
+    psi-dynamics-run
+    psi-dynamics-running?
+    psi-dynamics-step
     psi-get-action
     psi-get-context
     psi-get-goal
     psi-imply
+    psi-profile
+    psi-profile-enable
+    psi-profile-record-step
+    psi-profile-reset
+    psi-profile-steps
     psi-rule
     psi-rule?
+    psi-release
+    psi-restore-rules
+    psi-rule-weights
+    psi-rules-by-terms
+    psi-rules-triggered-by
     psi-satisfiable?
+    psi-satisfiable-batch
+    psi-sample-by-weight
+    psi-save-rules
+    psi-schedule
+    psi-schedule-dynamics
+    psi-schedule-runs
+    psi-schedule-trigger
+    psi-schedule-triggers
+    psi-schedule-wake
+    psi-scheduler-halt
+    psi-scheduler-run
+    psi-scheduler-running?
+    psi-scheduler-step
+    psi-unschedule
     )
 )
 
@@ -75,6 +111,170 @@
 "
 )
 
+(set-procedure-property! psi-dynamics-add-variable 'documentation
+"
+  psi-dynamics-add-variable VAR BASELINE - Have the native dynamics
+  updater decay the modulator or SEC VAR toward BASELINE, a number, on
+  each step.
+
+  The value of VAR is read from, and written to, (State VAR (Number x)).
+  See openpsi/dynamics/updater.scm, which registers the modulators, SECs,
+  events and rules it finds, when it can, in psi-updater-init.
+"
+)
+
+(set-procedure-property! psi-dynamics-add-event 'documentation
+"
+  psi-dynamics-add-event EVENT - Register the monitored EVENT; its value
+  is set back to 0 by the step after it is set to 1.
+"
+)
+
+(set-procedure-property! psi-dynamics-add-rule 'documentation
+"
+  psi-dynamics-add-rule TRIGGER CHANGE TARGET STRENGTH - Add the rule
+  that psi-create-interaction-rule makes, to the native updater. CHANGE
+  is (Predicate \"psi-changed\"), \"psi-increased\" or \"psi-decreased\".
+"
+)
+
+(set-procedure-property! psi-dynamics-add-rhythm 'documentation
+"
+  psi-dynamics-add-rhythm VAR AMPLITUDE FREQUENCY OFFSET - Add the rule
+  that psi-ultradian-update applies, to the native updater.
+"
+)
+
+(set-procedure-property! psi-dynamics-add-noise 'documentation
+"
+  psi-dynamics-add-noise VAR WIDTH - Add the rule that psi-noise-update
+  applies, to the native updater.
+"
+)
+
+(set-procedure-property! psi-dynamics-clear 'documentation
+"
+  psi-dynamics-clear - Forget all that was added to the native updater.
+"
+)
+
+(set-procedure-property! psi-dynamics-step 'documentation
+"
+  psi-dynamics-step - Apply all the rules of the native updater once,
+  and decay the variables toward their baselines.
+"
+)
+
+(set-procedure-property! psi-dynamics-run 'documentation
+"
+  psi-dynamics-run MSECS - Call psi-dynamics-step every MSECS in a
+  thread of its own, until psi-dynamics-halt is called. No events are
+  detected by this loop; use psi-updater-run for that.
+"
+)
+
+(set-procedure-property! psi-dynamics-halt 'documentation
+"
+  psi-dynamics-halt - Stop the loop started by psi-dynamics-run.
+"
+)
+
+(set-procedure-property! psi-dynamics-running? 'documentation
+"
+  psi-dynamics-running? - Return #t if the loop started by
+  psi-dynamics-run is running.
+"
+)
+
+(set-procedure-property! psi-schedule 'documentation
+"
+  psi-schedule BEHAVIOR TIMEOUT MIN-PERIOD - Evaluate BEHAVIOR, e.g. a
+  DefinedPredicate, from the scheduler whenever something it depends on
+  changes, but no sooner than MIN-PERIOD msecs after the last time, and
+  at least every TIMEOUT msecs if nothing does; a TIMEOUT of 0 is for
+  none. It is evaluated once after being scheduled.
+
+  BEHAVIOR depends on the AnchorNodes and PredicateNodes in it, and in
+  the definitions of the DefinedPredicates it uses; a change is a link
+  with one of them being added, removed or getting a new TV, such as a
+  new StateLink of an anchor. Use psi-schedule-trigger for the atoms
+  that its GroundedPredicates look at, and psi-schedule-wake after
+  changing a Value. E.g.
+
+    (psi-schedule (DefinedPredicate \"main step\") 1000 100)
+    (psi-scheduler-run)
+"
+)
+
+(set-procedure-property! psi-unschedule 'documentation
+"
+  psi-unschedule BEHAVIOR - Stop evaluating BEHAVIOR from the scheduler.
+"
+)
+
+(set-procedure-property! psi-schedule-trigger 'documentation
+"
+  psi-schedule-trigger BEHAVIOR ATOM - Also evaluate BEHAVIOR when a link
+  with ATOM in it changes.
+"
+)
+
+(set-procedure-property! psi-schedule-triggers 'documentation
+"
+  psi-schedule-triggers BEHAVIOR - Return the atoms whose changes wake
+  BEHAVIOR.
+"
+)
+
+(set-procedure-property! psi-schedule-wake 'documentation
+"
+  psi-schedule-wake BEHAVIOR - Evaluate BEHAVIOR as soon as its
+  MIN-PERIOD allows, as though something it depends on had changed.
+"
+)
+
+(set-procedure-property! psi-schedule-runs 'documentation
+"
+  psi-schedule-runs BEHAVIOR - Return the number of times the scheduler
+  has evaluated BEHAVIOR.
+"
+)
+
+(set-procedure-property! psi-schedule-dynamics 'documentation
+"
+  psi-schedule-dynamics MSECS - Call psi-dynamics-step every MSECS from
+  the scheduler, instead of from a loop of its own; 0 stops it.
+"
+)
+
+(set-procedure-property! psi-scheduler-step 'documentation
+"
+  psi-scheduler-step - Evaluate the scheduled behaviors that are due,
+  in this thread, and return how many were.
+"
+)
+
+(set-procedure-property! psi-scheduler-run 'documentation
+"
+  psi-scheduler-run - Evaluate the scheduled behaviors as they are due,
+  in a thread of its own, until psi-scheduler-halt is called. The
+  thread sleeps while nothing is due.
+"
+)
+
+(set-procedure-property! psi-scheduler-halt 'documentation
+"
+  psi-scheduler-halt - Stop the thread started by psi-scheduler-run.
+"
+)
+
+(set-procedure-property! psi-scheduler-running? 'documentation
+"
+  psi-scheduler-running? - Return #t if the thread started by
+  psi-scheduler-run is running.
+"
+)
+
 (set-procedure-property! psi-get-action 'documentation
 "
   psi-get-action RULE
@@ -142,6 +342,60 @@
 "
 )
 
+(set-procedure-property! psi-profile 'documentation
+"
+  psi-profile N - Return the N psi-rules that took the most time, once
+  profiling is enabled with psi-profile-enable.
+
+  The result is a LinkValue with a LinkValue for each rule, costliest
+  first, of the rule and a FloatValue of the number of times its context
+  was checked, the number of times it was satisfiable, and the seconds
+  spent checking the context and instantiating the action. A part of a
+  context shared by several rules is searched once, but its time is
+  counted for each of them.
+"
+)
+
+(set-procedure-property! psi-profile-enable 'documentation
+"
+  psi-profile-enable BOOL - Start, when BOOL is #t, or stop recording the
+  cost of each psi-rule and psi-step for the current atomspace.
+"
+)
+
+(set-procedure-property! psi-profile-reset 'documentation
+"
+  psi-profile-reset - Forget all that was recorded by the profiler.
+"
+)
+
+(set-procedure-property! psi-profile-record-step 'documentation
+"
+  psi-profile-record-step SECS - Record a psi-step that took SECS, when
+  profiling is enabled. Used by psi-step.
+"
+)
+
+(set-procedure-property! psi-profile-steps 'documentation
+"
+  psi-profile-steps - Return a FloatValue of the number of psi-steps
+  recorded by the profiler, and the total and the most seconds they
+  took.
+"
+)
+
+(set-procedure-property! psi-release 'documentation
+"
+  psi-release - Delete the psi-rule index and the caches kept for the
+  current atomspace.
+
+  Each atomspace has its own, so that conversations held in separate
+  atomspaces can be stepped at the same time. They are made when first
+  used, and have to be deleted before the atomspace is; the rules have
+  to be declared again to be used afterwards.
+"
+)
+
 (set-procedure-property! psi-rule? 'documentation
 "
   psi-rule? ATOM
@@ -154,6 +408,89 @@
 "
 )
 
+(set-procedure-property! psi-add-rule-terms 'documentation
+"
+  psi-add-rule-terms RULE TERMS - Declare that the context of RULE can
+  only be satisfied by an input that has one of the TERMS, a scheme list
+  of atoms such as the WordNodes of the words it may be matched by.
+
+  Each call adds a group of terms, all of which the input must have one
+  of. Calling it with no TERMS declares that RULE needs none. GHOST calls
+  this for each rule it creates; see psi-rules-by-terms.
+"
+)
+
+(set-procedure-property! psi-add-rules 'documentation
+"
+  psi-add-rules RULES - Add many psi-rules at once, and return them as
+  a scheme list, in the same order.
+
+  RULES is a LinkValue with a LinkValue for each rule, of a LinkValue of
+  the atoms of its context, its action, its goal, its TV, a LinkValue of
+  the categories to add it to and, optionally, a LinkValue of LinkValues
+  of its groups of terms, as psi-add-rule-terms takes them; an empty one
+  declares that the rule needs none. E.g.
+
+    (psi-add-rules (LinkValue
+      (LinkValue (LinkValue context) action goal (stv 1 .9)
+        (LinkValue component)
+        (LinkValue (LinkValue (Word \"hi\") (Word \"hello\"))))))
+
+  This is what psi-rule, psi-add-to-category and psi-add-rule-terms do
+  for each rule, but in one call, which is much faster when loading a
+  large rule set, such as that of a GHOST rule file.
+"
+)
+
+(set-procedure-property! psi-rules-by-terms 'documentation
+"
+  psi-rules-by-terms TERMS MAX - Return the rules declared with
+  psi-add-rule-terms that have one of each of their groups of terms in
+  TERMS, those with the most terms in TERMS first, and then the rules
+  that need no terms. At most MAX rules are returned, or all of them if
+  MAX is 0.
+"
+)
+
+(set-procedure-property! psi-save-rules 'documentation
+"
+  psi-save-rules PATH - Write the psi-rules of the current atomspace,
+  their categories and the terms declared for them, to the file PATH,
+  and return the number of rules written.
+
+  The atoms of the rules are written too, so that psi-restore-rules can
+  index them again at startup without loading, e.g., the GHOST rule
+  files they were made from.
+"
+)
+
+(set-procedure-property! psi-restore-rules 'documentation
+"
+  psi-restore-rules PATH - Add the atoms, psi-rules, categories and
+  terms of a file written by psi-save-rules to the current atomspace,
+  and return the number of rules restored. A file that isn't one, or is
+  damaged, is refused before anything is added. E.g.
+
+    (psi-save-rules \"/tmp/rules.psi\")
+    ; and later, in a new process
+    (psi-restore-rules \"/tmp/rules.psi\")
+"
+)
+
+(set-procedure-property! psi-rules-triggered-by 'documentation
+"
+  psi-rules-triggered-by ATOMS - Return the rules that could be
+  satisfied given the ATOMS of the current input.
+
+  ATOMS is a scheme list of atoms, such as the WordNodes of a
+  sentence. The rules returned are those whose context has one of
+  the ATOMS in it, and those whose context has no atom of the types
+  of the ATOMS at all. The other rules need an atom that is not in
+  the input, and so need not be checked with psi-satisfiable?.
+  Atoms that must be absent, as under a NotLink, don't count.
+"
+)
+
 (set-procedure-property! psi-satisfiable? 'documentation
 "
   psi-satisfiable? RULE - Return a TV indicating if the context of
@@ -170,3 +507,42 @@
   is to have a weighted, probabilistic value to be returned.
 "
 )
+
+(set-procedure-property! psi-satisfiable-batch 'documentation
+"
+  psi-satisfiable-batch RULES - Return a LinkValue of the TVs that
+  psi-satisfiable? would return for each of the RULES, in the same
+  order.
+
+  RULES is a scheme list of psi-rules. The contexts that have to be
+  searched are searched concurrently, one per core, and a context
+  shared by several of the rules is searched once.
+"
+)
+
+(set-procedure-property! psi-rule-weights 'documentation
+"
+  psi-rule-weights RULES STRENGTH-WEIGHT CONTEXT-WEIGHT STI-WEIGHT
+    URGE-WEIGHT - Return a FloatValue of the weights of the RULES, in
+  the same order, for the goal-driven action selection.
+
+  The weight of a rule is Wr = Scag * Sc * Icag * Ug, where Scag is
+  the strength of the rule, Sc the satisfiability of its context, Icag
+  its STI, and Ug the urge of its goal. Each factor is multiplied by
+  its own weight; a factor with a weight of 0 is left out. A rule with
+  no STI or strength, when these are weighed, gets 0. The contexts of
+  the other rules are checked with psi-satisfiable-batch, so they can
+  be passed to psi-imply afterwards.
+"
+)
+
+(set-procedure-property! psi-sample-by-weight 'documentation
+"
+  psi-sample-by-weight RULES WEIGHTS - Return one of the RULES, picked
+  at random by their WEIGHTS, a FloatValue such as psi-rule-weights
+  returns.
+
+  Rules with no weight are never picked; the empty list is returned
+  if none has any.
+"
+)
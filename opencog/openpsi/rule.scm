@@ -265,9 +265,13 @@
 "
   psi-get-satisfiable-rules CATEGORY
     Returns a SetLink of all of the psi-rules that are member of CATEGORY
-    and are satisfiable.
+    and are satisfiable. The rules are checked all at once, using
+    psi-satisfiable-batch.
 "
-  (Set (filter is-satisfiable? (psi-get-rules category)))
+  (define rules (psi-get-rules category))
+  (Set (filter-map
+    (lambda (rule tv) (and (equal? (stv 1 1) tv) rule))
+    rules (cog-value->list (psi-satisfiable-batch rules))))
 )
 
 ; --------------------------------------------------------------
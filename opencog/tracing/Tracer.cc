@@ -0,0 +1,315 @@
+/*
+ * Tracer.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <opencog/util/exceptions.h>
+
+#include "Tracer.h"
+
+using namespace opencog;
+
+std::atomic<bool> Tracer::s_enabled(false);
+
+namespace
+{
+
+struct Span
+{
+    std::string name;
+    const char* category;
+    Tracer::Clock::time_point start;
+    Tracer::Clock::time_point end;
+    std::string args;
+};
+
+/**
+ * The spans of one thread. Only its own thread adds to it, but the lock
+ * is needed for clearing and dumping it from another.
+ */
+struct ThreadTrace
+{
+    std::mutex mtx;
+    unsigned long tid;
+    std::string name;
+
+    std::vector<Span> ring;
+    size_t next = 0;          // where the next span goes, once it's full
+
+    // The spans opened with Tracer::begin(), innermost last
+    std::vector<std::pair<std::string, Tracer::Clock::time_point>> open;
+    std::vector<const char*> open_categories;
+};
+
+// The traces of all threads that have traced anything. A trace outlives
+// its thread, so that they show in the dump, until the next clear().
+std::mutex s_threads_mtx;
+std::vector<std::shared_ptr<ThreadTrace>> s_threads;
+unsigned long s_next_tid = 1;
+
+std::atomic<size_t> s_capacity(65536);
+
+// What the timestamps are counted from
+const Tracer::Clock::time_point s_epoch = Tracer::Clock::now();
+
+thread_local std::shared_ptr<ThreadTrace> t_trace;
+
+ThreadTrace& this_thread_trace()
+{
+    if (nullptr == t_trace)
+    {
+        t_trace = std::make_shared<ThreadTrace>();
+        std::lock_guard<std::mutex> lck(s_threads_mtx);
+        t_trace->tid = s_next_tid++;
+        s_threads.push_back(t_trace);
+    }
+    return *t_trace;
+}
+
+void add_span(ThreadTrace& tt, Span&& span)
+{
+    size_t capacity = s_capacity.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lck(tt.mtx);
+    if (tt.ring.size() < capacity)
+        tt.ring.push_back(std::move(span));
+    else
+    {
+        tt.ring[tt.next] = std::move(span);
+        tt.next = (tt.next + 1) % tt.ring.size();
+    }
+}
+
+void json_string(std::ostream& out, const std::string& str)
+{
+    out << '"';
+    for (unsigned char c : str)
+    {
+        if ('"' == c or '\\' == c)
+            out << '\\' << c;
+        else if (c < 0x20)
+        {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out << buf;
+        }
+        else
+            out << c;
+    }
+    out << '"';
+}
+
+// Microseconds since the epoch, as Chrome trace wants them
+double micros(Tracer::Clock::duration d)
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+}
+
+void Tracer::start(size_t per_thread)
+{
+    s_capacity.store(std::max(per_thread, (size_t) 1));
+    clear();
+    s_enabled.store(true);
+}
+
+void Tracer::stop()
+{
+    s_enabled.store(false);
+}
+
+/**
+ * Forget all spans, and the threads that have ended since.
+ */
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> lck(s_threads_mtx);
+    auto ended = [](const std::shared_ptr<ThreadTrace>& tt)
+        { return 1 == tt.use_count(); };
+    s_threads.erase(std::remove_if(s_threads.begin(), s_threads.end(),
+                                   ended), s_threads.end());
+
+    for (const std::shared_ptr<ThreadTrace>& tt : s_threads)
+    {
+        std::lock_guard<std::mutex> tlck(tt->mtx);
+        tt->ring.clear();
+        tt->next = 0;
+    }
+}
+
+size_t Tracer::size()
+{
+    std::lock_guard<std::mutex> lck(s_threads_mtx);
+    size_t n = 0;
+    for (const std::shared_ptr<ThreadTrace>& tt : s_threads)
+    {
+        std::lock_guard<std::mutex> tlck(tt->mtx);
+        n += tt->ring.size();
+    }
+    return n;
+}
+
+void Tracer::set_thread_name(const std::string& name)
+{
+    ThreadTrace& tt = this_thread_trace();
+    std::lock_guard<std::mutex> lck(tt.mtx);
+    tt.name = name;
+}
+
+void Tracer::record(const std::string& name, const char* category,
+                    Clock::time_point start, Clock::time_point end,
+                    std::string&& args)
+{
+    add_span(this_thread_trace(),
+             Span{name, category, start, end, std::move(args)});
+}
+
+void Tracer::begin(const std::string& name, const char* category)
+{
+    if (not enabled()) return;
+    ThreadTrace& tt = this_thread_trace();
+    tt.open.emplace_back(name, Clock::now());
+    tt.open_categories.push_back(category);
+}
+
+void Tracer::end()
+{
+    if (nullptr == t_trace or t_trace->open.empty()) return;
+    ThreadTrace& tt = *t_trace;
+    Span span{std::move(tt.open.back().first), tt.open_categories.back(),
+              tt.open.back().second, Clock::now(), ""};
+    tt.open.pop_back();
+    tt.open_categories.pop_back();
+
+    // Spans begun before tracing was stopped are dropped.
+    if (enabled()) add_span(tt, std::move(span));
+}
+
+/**
+ * The spans as complete ("X") events, oldest first for each thread,
+ * with the names of the threads as metadata ("M") events.
+ */
+std::string Tracer::to_json()
+{
+    long pid = getpid();
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    std::lock_guard<std::mutex> lck(s_threads_mtx);
+    for (const std::shared_ptr<ThreadTrace>& tt : s_threads)
+    {
+        std::lock_guard<std::mutex> tlck(tt->mtx);
+
+        if (not tt->name.empty())
+        {
+            if (not first) out << ',';
+            first = false;
+            out << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+                << ",\"tid\":" << tt->tid << ",\"args\":{\"name\":";
+            json_string(out, tt->name);
+            out << "}}";
+        }
+
+        for (size_t i = 0; i < tt->ring.size(); i++)
+        {
+            const Span& span = tt->ring[(tt->next + i) % tt->ring.size()];
+            if (not first) out << ',';
+            first = false;
+            out << "\n{\"name\":";
+            json_string(out, span.name);
+            out << ",\"cat\":";
+            json_string(out, span.category);
+            out << ",\"ph\":\"X\",\"ts\":" << micros(span.start - s_epoch)
+                << ",\"dur\":" << micros(span.end - span.start)
+                << ",\"pid\":" << pid << ",\"tid\":" << tt->tid;
+            if (not span.args.empty())
+                out << ",\"args\":{" << span.args << '}';
+            out << '}';
+        }
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+void Tracer::dump(const std::string& path)
+{
+    std::ofstream out(path);
+    if (not out)
+        throw RuntimeException(TRACE_INFO,
+            "Can't write the trace to %s", path.c_str());
+    out << to_json();
+    if (not out)
+        throw RuntimeException(TRACE_INFO,
+            "Failed writing the trace to %s", path.c_str());
+}
+
+// ---------------------------------------------------------------
+
+void TraceSpan::add_arg(const char* key, const std::string& json)
+{
+    std::ostringstream out;
+    if (not m_args.empty()) out << ',';
+    json_string(out, key);
+    out << ':' << json;
+    m_args += out.str();
+}
+
+TraceSpan& TraceSpan::arg(const char* key, const std::string& value)
+{
+    if (m_on)
+    {
+        std::ostringstream out;
+        json_string(out, value);
+        add_arg(key, out.str());
+    }
+    return *this;
+}
+
+TraceSpan& TraceSpan::arg(const char* key, const char* value)
+{
+    if (m_on) arg(key, std::string(value));
+    return *this;
+}
+
+TraceSpan& TraceSpan::arg(const char* key, double value)
+{
+    if (m_on)
+    {
+        // JSON has no infinities or NaNs
+        std::ostringstream out;
+        if (std::isfinite(value)) out << value; else out << "null";
+        add_arg(key, out.str());
+    }
+    return *this;
+}
@@ -0,0 +1,153 @@
+/*
+ * Tracer.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_TRACER_H
+#define _OPENCOG_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <type_traits>
+
+namespace opencog
+{
+
+/**
+ * A process-wide trace of spans, i.e. of named stretches of time, such
+ * as a parse or a pattern match, on each thread; it can be written out
+ * as Chrome trace JSON, to be seen in chrome://tracing or Perfetto, so
+ * that the time one request spends in each module, and on which thread,
+ * shows on one time line.
+ *
+ * Tracing is off by default; when it is off, a span costs a single
+ * relaxed atomic load, so they can be left compiled in. Each thread
+ * keeps its spans in a ring buffer of its own, so that a long trace
+ * keeps the most recent ones, and threads don't contend for a lock.
+ */
+class Tracer
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static bool enabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Start tracing, forgetting what was traced so far.
+     *
+     * @param per_thread  the no. of spans kept for each thread
+     */
+    static void start(size_t per_thread = 65536);
+    static void stop();
+    static void clear();
+
+    /// The no. of spans kept.
+    static size_t size();
+
+    /// The spans kept, as Chrome trace JSON.
+    static std::string to_json();
+
+    /// Write to_json() to the file; throws if it can't be written.
+    static void dump(const std::string& path);
+
+    /// Name the calling thread in the trace.
+    static void set_thread_name(const std::string&);
+
+    /**
+     * Add a span of the calling thread. The args, if any, are the
+     * members of a JSON object, without the braces.
+     */
+    static void record(const std::string& name, const char* category,
+                       Clock::time_point start, Clock::time_point end,
+                       std::string&& args);
+
+    /// Open and close spans for the calling thread, for code that can't
+    /// use a TraceSpan, e.g. scheme; an end with no open span is ignored.
+    static void begin(const std::string& name, const char* category);
+    static void end();
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * Traces the time between its construction and destruction, if tracing
+ * was on when it was constructed. The name and category must outlive it,
+ * which string literals do.
+ *
+ *    TraceSpan span("sureal-match", "nlp");
+ *    span.arg("clauses", qClauses.size());
+ *
+ * Arguments that are costly to work out should be guarded with on().
+ */
+class TraceSpan
+{
+public:
+    TraceSpan(const char* name, const char* category = "opencog") :
+        m_name(name), m_category(category), m_on(Tracer::enabled())
+    {
+        if (m_on) m_start = Tracer::Clock::now();
+    }
+
+    ~TraceSpan()
+    {
+        if (m_on)
+            Tracer::record(m_name, m_category, m_start,
+                           Tracer::Clock::now(), std::move(m_args));
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    bool on() const { return m_on; }
+
+    TraceSpan& arg(const char* key, const std::string& value);
+    TraceSpan& arg(const char* key, const char* value);
+    TraceSpan& arg(const char* key, double value);
+    TraceSpan& arg(const char* key, bool value)
+    {
+        if (m_on) add_arg(key, value ? "true" : "false");
+        return *this;
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value, TraceSpan&>::type
+    arg(const char* key, T value)
+    {
+        if (m_on) add_arg(key, std::to_string(value));
+        return *this;
+    }
+
+private:
+    void add_arg(const char* key, const std::string& json);
+
+    const char* m_name;
+    const char* m_category;
+    bool m_on;
+    Tracer::Clock::time_point m_start;
+    std::string m_args;
+};
+
+}
+
+#endif // _OPENCOG_TRACER_H
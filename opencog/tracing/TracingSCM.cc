@@ -0,0 +1,113 @@
+/*
+ * TracingSCM.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/guile/SchemePrimitive.h>
+
+#include "Tracer.h"
+
+namespace opencog
+{
+
+/**
+ * Starting, stopping and dumping the trace from scheme, and spans for
+ * scheme code.
+ */
+class TracingSCM
+{
+private:
+    static void* init_in_guile(void*);
+    static void init_in_module(void*);
+    void init(void);
+
+    void start(int);
+    void stop(void) { Tracer::stop(); }
+    void clear(void) { Tracer::clear(); }
+    bool enabled(void) { return Tracer::enabled(); }
+    int size(void) { return Tracer::size(); }
+    std::string to_json(void) { return Tracer::to_json(); }
+    void dump(const std::string& path) { Tracer::dump(path); }
+    void begin(const std::string& name) { Tracer::begin(name, "scheme"); }
+    void end(void) { Tracer::end(); }
+    void set_thread_name(const std::string& name)
+    {
+        Tracer::set_thread_name(name);
+    }
+
+public:
+    TracingSCM();
+};
+
+}
+
+using namespace opencog;
+
+TracingSCM::TracingSCM()
+{
+    static bool is_init = false;
+    if (is_init) return;
+    is_init = true;
+    scm_with_guile(init_in_guile, this);
+}
+
+void* TracingSCM::init_in_guile(void* self)
+{
+    scm_c_define_module("opencog tracing", init_in_module, self);
+    scm_c_use_module("opencog tracing");
+    return NULL;
+}
+
+void TracingSCM::init_in_module(void* data)
+{
+    TracingSCM* self = (TracingSCM*) data;
+    self->init();
+}
+
+void TracingSCM::init()
+{
+    define_scheme_primitive("trace-start-c", &TracingSCM::start, this, "tracing");
+    define_scheme_primitive("trace-stop", &TracingSCM::stop, this, "tracing");
+    define_scheme_primitive("trace-clear", &TracingSCM::clear, this, "tracing");
+    define_scheme_primitive("trace-enabled?", &TracingSCM::enabled, this, "tracing");
+    define_scheme_primitive("trace-size", &TracingSCM::size, this, "tracing");
+    define_scheme_primitive("trace-json", &TracingSCM::to_json, this, "tracing");
+    define_scheme_primitive("trace-dump", &TracingSCM::dump, this, "tracing");
+    define_scheme_primitive("trace-begin", &TracingSCM::begin, this, "tracing");
+    define_scheme_primitive("trace-end", &TracingSCM::end, this, "tracing");
+    define_scheme_primitive("trace-thread-name", &TracingSCM::set_thread_name, this, "tracing");
+}
+
+void TracingSCM::start(int per_thread)
+{
+    if (per_thread < 1)
+        throw InvalidParamException(TRACE_INFO,
+            "trace-start: Expecting a positive no. of spans, got %d",
+            per_thread);
+    Tracer::start(per_thread);
+}
+
+extern "C" {
+void opencog_tracing_init(void);
+};
+
+void opencog_tracing_init(void)
+{
+    static TracingSCM tracing;
+}
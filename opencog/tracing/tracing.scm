@@ -0,0 +1,48 @@
+;
+; tracing.scm
+;
+; Tracing the time spent in each part of the pipeline, as Chrome trace
+; JSON; see README.md.
+;
+(define-module (opencog tracing))
+
+(use-modules (opencog) (opencog oc-config))
+
+(load-extension (string-append opencog-ext-path-tracing "libtracing-scm") "opencog_tracing_init")
+
+(use-modules (ice-9 optargs))
+
+; ---------------------------------------------------------------------
+
+(define*-public (trace-start #:key (spans 65536))
+"
+  trace-start [#:spans N]
+
+  Start tracing, forgetting what was traced so far. Each thread keeps
+  its last N spans. Stop it with (trace-stop), and write the trace out
+  with (trace-dump FILE); then load FILE in chrome://tracing or
+  https://ui.perfetto.dev
+
+  Example:
+     (trace-start)
+     (nlp-parse \"I saw a cat.\")
+     (trace-stop)
+     (trace-dump \"/tmp/trace.json\")
+"
+	(trace-start-c spans))
+
+(define-syntax-public with-trace-span
+	(syntax-rules ()
+"
+  with-trace-span NAME BODY ...
+
+  Evaluate the BODY, and trace the time it took as a span called NAME,
+  if tracing is on; returns what the BODY returns.
+"
+		((_ NAME BODY ...)
+			(if (trace-enabled?)
+				(dynamic-wind
+					(lambda () (trace-begin NAME))
+					(lambda () BODY ...)
+					trace-end)
+				(begin BODY ...)))))
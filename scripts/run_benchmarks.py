@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+#
+# Run the benchmarks built in the benchmark directory, merge their JSON
+# output into one file, and compare it with a saved baseline, so that a
+# slower or more allocating build shows before release. This is what
+# `make benchmark` and `make benchmark-baseline` run.
+#
+# Usage: run_benchmarks.py --bin-dir DIR [--out FILE] [--baseline FILE]
+#                          [--threshold PCT] [--save-baseline]
+#                          [--only SUITE,...]
+#
+# The exit status is 1 if a result got worse than the baseline by more
+# than the threshold, and 2 if a benchmark failed to run.
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+
+# Each suite: its executable, relative to the benchmark build directory,
+# and the options it is run with; sized to take seconds, not minutes.
+SUITES = [
+    ("neighbors", "neighbors/neighbor-bench", ["--fan-in", "20000"]),
+    ("fuzzy", "fuzzy/fuzzy-bench", ["--sentences", "2000", "--index"]),
+    ("sureal", "sureal/sureal-bench", []),
+    ("lg", "lg/lg-bench", []),
+    ("openpsi", "openpsi/openpsi-bench", []),
+    ("wsd", "wsd/wsd-bench", []),
+    ("lojban", "lojban/lojban-bench", ["--bulk-lines", "1000"]),
+]
+
+# Metrics for which less is better, and those for which more is; the
+# others, such as the no. of atoms found, are shown when they change,
+# but are not counted as regressions.
+HIGHER_IS_BETTER = re.compile(r"_per_s(ec)?$")
+LOWER_IS_BETTER = re.compile(r"(_us|_ns|_kb|_s|^seconds)$|_per_call$|"
+                             r"^allocs_per")
+INFORMATIONAL = re.compile(r"^(atoms|items)_per_call$|^mean_visited$")
+
+
+def run_suite(path, args):
+    """Run one benchmark, and return its JSON, the last line of its
+    output that is a JSON object; the code under test may print too."""
+    out = subprocess.run([path] + args + ["--json"], stdout=subprocess.PIPE,
+                         universal_newlines=True, check=True).stdout
+    for line in reversed(out.splitlines()):
+        line = line.strip()
+        if line.startswith("{"):
+            return json.loads(line)
+    raise ValueError("no JSON in the output of " + path)
+
+
+def metrics(suite):
+    """Flatten the output of a suite into {(result, metric): value}.
+    The results are the objects in its lists, e.g. "results", named by
+    their "name" or "mode", or else by their position."""
+    flat = {}
+    for key, value in suite.items():
+        if not isinstance(value, list):
+            continue
+        for i, entry in enumerate(value):
+            if not isinstance(entry, dict):
+                continue
+            label = entry.get("name", entry.get("mode"))
+            if label is None:
+                label = "%s[%s]" % (key, entry.get("threads", i))
+            for metric, v in entry.items():
+                if isinstance(v, (int, float)) and not isinstance(v, bool):
+                    flat[(label, metric)] = v
+    return flat
+
+
+def direction(metric):
+    if INFORMATIONAL.search(metric):
+        return 0
+    if HIGHER_IS_BETTER.search(metric):
+        return 1
+    if LOWER_IS_BETTER.search(metric):
+        return -1
+    return 0
+
+
+def compare(results, baseline, threshold):
+    """Print what changed by more than the threshold, in percent, and
+    return the no. of regressions."""
+    regressions = 0
+    for name, suite in sorted(results["suites"].items()):
+        if name not in baseline.get("suites", {}):
+            print("%s: not in the baseline" % name)
+            continue
+        new = metrics(suite)
+        old = metrics(baseline["suites"][name])
+        for key in sorted(new):
+            if key not in old:
+                continue
+            a, b = old[key], new[key]
+            d = direction(key[1])
+            # Allocations are counted exactly; less than one more or
+            # fewer a call is no change.
+            if key[1].startswith("allocs") and abs(b - a) < 0.5:
+                continue
+            if a == b or (a == 0 and d == 0):
+                continue
+            change = 100.0 * (b - a) / a if a else float("inf")
+            if abs(change) <= threshold:
+                continue
+
+            if 0 == d:
+                verdict = "changed"
+            elif (b - a) * d < 0:
+                verdict = "REGRESSION"
+                regressions += 1
+            else:
+                verdict = "improved"
+            print("%-10s %-10s %-32s %-16s %12.1f -> %12.1f (%+.0f%%)" %
+                  (verdict, name, key[0], key[1], a, b, change))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--bin-dir", required=True)
+    parser.add_argument("--out")
+    parser.add_argument("--baseline")
+    parser.add_argument("--threshold", type=float, default=10.0)
+    parser.add_argument("--save-baseline", action="store_true")
+    parser.add_argument("--only")
+    opts = parser.parse_args()
+
+    only = set(opts.only.split(",")) if opts.only else None
+    results = {
+        "host": platform.node(),
+        "date": datetime.datetime.now().isoformat(timespec="seconds"),
+        "suites": {},
+    }
+    failed = False
+    for name, exe, args in SUITES:
+        if only and name not in only:
+            continue
+        path = os.path.join(opts.bin_dir, exe)
+        if not os.access(path, os.X_OK):
+            print("%s: not built, skipped" % name)
+            continue
+        print("%s: running %s" % (name, " ".join([exe] + args)))
+        sys.stdout.flush()
+        try:
+            results["suites"][name] = run_suite(path, args)
+        except (subprocess.CalledProcessError, ValueError) as e:
+            print("%s: failed: %s" % (name, e))
+            failed = True
+
+    if opts.out:
+        with open(opts.out, "w") as f:
+            json.dump(results, f, indent=1, sort_keys=True)
+        print("Results written to " + opts.out)
+
+    status = 2 if failed else 0
+    if opts.baseline and opts.save_baseline:
+        with open(opts.baseline, "w") as f:
+            json.dump(results, f, indent=1, sort_keys=True)
+        print("Baseline written to " + opts.baseline)
+    elif opts.baseline and os.path.exists(opts.baseline):
+        with open(opts.baseline) as f:
+            baseline = json.load(f)
+        print("Compared with the baseline of %s, from %s:" %
+              (baseline.get("host", "?"), baseline.get("date", "?")))
+        regressions = compare(results, baseline, opts.threshold)
+        print("%d regression(s) of more than %g%%" %
+              (regressions, opts.threshold))
+        if regressions and not status:
+            status = 1
+    elif opts.baseline:
+        print("No baseline at %s; run `make benchmark-baseline` to save one"
+              % opts.baseline)
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())